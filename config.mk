@@ -12,11 +12,11 @@ ICC_EXIST:=$(shell which icc)
 ifdef ICC_EXIST
     CXX=icc
 #    CFLAGS=-std=c++11 -Wall -Wextra -ansi -pedantic -I. -O3 -fmax-errors=5 -lyaml-cpp
-    CFLAGS=-std=c++11 -Wall -Wextra -ansi -pedantic -I. -O3 -fmax-errors=5# -lyaml-cpp
+    CFLAGS=-std=c++11 -Wall -Wextra -ansi -pedantic -I. -O3 -fmax-errors=5 -pthread# -lyaml-cpp
 else
     CXX=mpicxx
 #    CFLAGS=-std=gnu++11 -Wall -Wextra -ansi -pedantic -I. -O3 -fmax-errors=5 -lyaml-cpp
-    CFLAGS=-std=gnu++11 -Wall -Wextra -ansi -pedantic -I. -O3 -fmax-errors=5# -lyaml-cpp
+    CFLAGS=-std=gnu++11 -Wall -Wextra -ansi -pedantic -I. -O3 -fmax-errors=5 -pthread# -lyaml-cpp
 endif
 
 # Location of the Eigen library
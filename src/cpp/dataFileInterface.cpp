@@ -10,9 +10,24 @@
 
 #include<dataFileInterface.h>
 #include<boost/algorithm/string.hpp>
+#include<mutex>
 
 namespace dataFileInterface{
 
+    //The XDMF and HDF5 libraries are not guaranteed to be thread safe so all access to them through the
+    //XDMFDataFile objects is serialized. The mutex is recursive because the interface functions call each other.
+    static std::recursive_mutex xdmfLibraryMutex;
+
+    std::unique_lock< std::recursive_mutex > lockXDMFLibrary( ){
+        /*!
+         * Lock the XDMF library for the lifetime of the returned lock. Any code which calls the XDMF
+         * library directly rather than through an XDMFDataFile must hold this lock so that it
+         * cannot run at the same time as a background read ( e.g. the solution data prefetcher ).
+         */
+
+        return std::unique_lock< std::recursive_mutex >( xdmfLibraryMutex );
+    }
+
     dataFileBase::dataFileBase( ){
         /*!
          * The base dataFile constructor
@@ -285,6 +300,21 @@ namespace dataFileInterface{
         return new errorNode( "getSolutionData", "The getSolutionData function is not defined" );
     }
 
+    errorOut dataFileBase::getSolutionData( const uIntType increment, const stringVector &dataNames, const std::string &dataCenter,
+                                            floatVector &data ){
+        /*!
+         * Get the values of several solution data in a single call. The values are interleaved in the output
+         * so that the values of all of the data names at a point are stored together.
+         *
+         * :param const uIntType increment: The increment at which to get the data
+         * :param const stringVector &dataNames: The names of the data
+         * :param const std::string &dataCenter: The type of the data. This will either be "Node" or "Cell"
+         * :param floatVector &data: The output data vector
+         */
+
+        return getSolutionVectorDataFromComponents( increment, dataNames, dataCenter, data );
+    }
+
     errorOut dataFileBase::getSolutionVectorDataFromComponents( const uIntType increment,
                                                                 const stringVector &componentNames,
                                                                 const std::string &dataCenter, floatVector &data ){
@@ -532,6 +562,42 @@ namespace dataFileInterface{
         return new errorNode( "writeIncrementMeshData", "Not implemented" );
     }
 
+    errorOut dataFileBase::writeIncrementMeshData( const uIntType increment, const uIntType collectionNumber,
+                                                   uIntVector &&nodeIds, uIntMatrix &&nodeSets,
+                                                   stringVector &&nodeSetNames, floatVector &&nodePositions,
+                                                   uIntVector &&elementIds, uIntMatrix &&elementSets,
+                                                   stringVector &&elementSetNames, uIntVector &&connectivity ){
+        /*!
+         * Write the given increment's mesh data to the file. Data files which can take ownership of the
+         * mesh data ( e.g. buffers ) should overload this. The default writes a copy.
+         *
+         * The parameters are the same as for the overload which takes constant references.
+         */
+
+        return writeIncrementMeshData( increment, collectionNumber,
+                                       static_cast< const uIntVector & >( nodeIds ), static_cast< const uIntMatrix & >( nodeSets ),
+                                       static_cast< const stringVector & >( nodeSetNames ), static_cast< const floatVector & >( nodePositions ),
+                                       static_cast< const uIntVector & >( elementIds ), static_cast< const uIntMatrix & >( elementSets ),
+                                       static_cast< const stringVector & >( elementSetNames ), static_cast< const uIntVector & >( connectivity ) );
+    }
+
+    errorOut dataFileBase::writeScalarSolutionData( const uIntType increment, const uIntType collectionNumber,
+                                                    const std::string &dataName, const std::string &dataType,
+                                                    floatVector &&data ){
+        /*!
+         * Write the given increment's solution data to the file. Data files which can take ownership of the
+         * data ( e.g. buffers ) should overload this. The default writes a copy.
+         *
+         * :param const uIntType increment: The increment to write the solution data to
+         * :param const uInttype collectionNumber: The temporal collection to write the data to
+         * :param const std::string &dataName: The name of the data
+         * :param const std::string &dataType: The type of data ( "Node" or "Cell" )
+         * :param floatVector &&data: The data to write
+         */
+
+        return writeScalarSolutionData( increment, collectionNumber, dataName, dataType, static_cast< const floatVector & >( data ) );
+    }
+
     errorOut dataFileBase::writeScalarSolutionData( const uIntType increment, const uIntType collectionNumber,
                                                     const std::string &dataName, const std::string &dataType,
                                                     const floatVector &data ){
@@ -554,6 +620,15 @@ namespace dataFileInterface{
         return new errorNode( "writeScalarSolutionData", "Not implemented" );
     }
 
+    errorOut dataFileBase::flush( ){
+        /*!
+         * Write any changes which are held in memory to the file. Data files which write
+         * directly to disk do not need to overload this.
+         */
+
+        return NULL;
+    }
+
     errorOut dataFileBase::addRootCollection( const std::string &collectionName, const std::string &collectionDescription,
                                               uIntType &collectionNumber ){
         /*!
@@ -592,11 +667,12 @@ namespace dataFileInterface{
         }
 
         errorOut error;
-        floatVector componentValues( data.size( ) / dataNames.size( ), 0 );
 
         for ( uIntType i = 0; i < dataNames.size( ); i++ ){
 
             //Extract the data values
+            floatVector componentValues( data.size( ) / dataNames.size( ), 0 );
+
             uIntType indx = 0;
             for ( uIntType j = i; j < data.size( ); j += dataNames.size( ), indx++ ){
 
@@ -604,7 +680,7 @@ namespace dataFileInterface{
 
             }
 
-            error = writeScalarSolutionData( increment, collectionNumber, dataNames[ i ], dataType, componentValues );
+            error = writeScalarSolutionData( increment, collectionNumber, dataNames[ i ], dataType, std::move( componentValues ) );
 
             if ( error ){
 
@@ -645,18 +721,21 @@ namespace dataFileInterface{
          * The XDMFDataFile destructor
          */
 
-        if ( ( _mode.compare( "write" ) == 0 ) && ( _domain != nullptr ) ){
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
 
-            //Form the writer
-            shared_ptr< XdmfHDF5Writer > heavyWriter = XdmfHDF5Writer::New( _filename + ".h5", false );
-            heavyWriter->setReleaseData( true );
-            shared_ptr< XdmfWriter > writer = XdmfWriter::New( _filename + ".xdmf", heavyWriter );
-    
-            //Write the data to file
-            _domain->accept( writer );
+        std::unique_ptr< errorNode > error( flush( ) );
+
+        if ( error ){
+
+            error->print( );
 
         }
 
+        //Release the XDMF objects while the library is locked
+        _heavyWriter.reset( );
+        _domain.reset( );
+        _reader.reset( );
+
         return;
 
     }
@@ -668,6 +747,8 @@ namespace dataFileInterface{
          * :param const YAML::Node &configuration: The YAML configuration file for the XDMFDataFile object
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         //Initialize read or write mode if required
         if ( _mode.compare( "read" ) == 0 ){
             _initializeReadMode( );
@@ -675,6 +756,7 @@ namespace dataFileInterface{
         }
         else if ( _mode.compare( "write" ) == 0 ){
             _initializeWriteMode( _config );
+            _unflushedChanges = true;
             return;
         }
         else{
@@ -689,6 +771,25 @@ namespace dataFileInterface{
          * Initialize the read mode for the XDMF file-type
          */
 
+        //Set the memory policy of the heavy data
+        if ( _config[ "heavy_data_policy" ] ){
+
+            std::string policy = _config[ "heavy_data_policy" ].as< std::string >( );
+            boost::algorithm::to_lower( policy );
+
+            if ( policy.compare( "release" ) == 0 ){
+                _releaseHeavyData = true;
+            }
+            else if ( policy.compare( "keep" ) == 0 ){
+                _releaseHeavyData = false;
+            }
+            else{
+                _error.reset( new errorNode( "XDMFDataFile", "The heavy data policy " + policy + " is not recognized. It must be 'release' or 'keep'" ) );
+                return;
+            }
+
+        }
+
         //Initialize the reader
         _reader = XdmfReader::New( );
 
@@ -862,6 +963,8 @@ namespace dataFileInterface{
          * :param uIntType &numIncrements: The number of increments
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         uIntType nGridCollections = _domain->getNumberGridCollections( );
         //Print warning message if the number of root-level grid collections is greater than 1
         if ( nGridCollections > 1 ){
@@ -958,6 +1061,8 @@ namespace dataFileInterface{
          *     in row-major format [ node, coordinates ]
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         //Get the grid
         shared_ptr< XdmfUnstructuredGrid > grid;
         errorOut error = getUnstructuredGrid( increment, grid );
@@ -978,6 +1083,7 @@ namespace dataFileInterface{
         //Get the nodal positions
         nodalPositions.resize( geom->getSize( ) );
         geom->getValues( 0, nodalPositions.data(), geom->getSize( ), 1, 1 );
+        releaseHeavyData( geom );
 
 //        //Get the set names
 //        std::cout << "the number of sets: " << grid->getNumberSets( ) << "\n";
@@ -1007,6 +1113,8 @@ namespace dataFileInterface{
          * :param uIntType &numNodes: The number of nodes
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         shared_ptr< XdmfUnstructuredGrid > grid;
         errorOut error = getUnstructuredGrid( increment, grid );
 
@@ -1035,6 +1143,8 @@ namespace dataFileInterface{
          * :param uIntVector &domainNodes: The nodes located in the domain
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         //Get the grid
         shared_ptr< XdmfUnstructuredGrid > grid;
         errorOut error = getUnstructuredGrid( increment, grid );
@@ -1059,12 +1169,14 @@ namespace dataFileInterface{
 
             domainNodes.resize( set->getSize( ) );
             set->getValues( 0, domainNodes.data(), set->getSize( ), 1, 1 );
+            releaseHeavyData( set );
             return NULL;
 
         }
         //TODO: Add more ability to extract the nodes from non-cell entities
         else{
 
+            releaseHeavyData( set );
             return new errorNode( "getSubDomainNodes", "The set type is not recognized. It must be Node" );
 
         }
@@ -1082,6 +1194,8 @@ namespace dataFileInterface{
          * :param uIntType numSubDomainNodes: The number of nodes in the domain
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         //Get the grid
         shared_ptr< XdmfUnstructuredGrid > grid;
         errorOut error = getUnstructuredGrid( increment, grid );
@@ -1111,6 +1225,8 @@ namespace dataFileInterface{
          * :param stringVector &setNames: The names of the sets
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         //Get the grid
         shared_ptr< XdmfUnstructuredGrid > grid;
         errorOut error = getUnstructuredGrid( increment, grid );
@@ -1132,6 +1248,116 @@ namespace dataFileInterface{
         return NULL;
     }
 
+    errorOut XDMFDataFile::getAttributeIndex( const uIntType increment, shared_ptr< XdmfUnstructuredGrid > &unstructuredGrid,
+                                              const attributeIndex *&index ){
+        /*!
+         * Get the grid of an increment and the index from the names of its attributes to their positions in the grid.
+         * The index of each increment is built the first time its grid is requested and re-used until the
+         * attributes of the grid change. Only the indices of the requested and the previously requested
+         * increments are retained.
+         *
+         * :param const uIntType increment: The increment of the grid
+         * :param shared_ptr< XdmfUnstructuredGrid > &unstructuredGrid: The grid of the increment
+         * :param const attributeIndex *&index: The index of the attributes of the grid
+         */
+
+        errorOut error = getUnstructuredGrid( increment, unstructuredGrid );
+
+        if ( error ){
+            errorOut result = new errorNode( "getAttributeIndex", "Error in the extraction of the grid" );
+            result->addNext( error );
+            return result;
+        }
+
+        //Drop the indices of all but the previously requested increment
+        if ( _attributeIndices.find( increment ) == _attributeIndices.end( ) ){
+
+            for ( auto it = _attributeIndices.begin( ); it != _attributeIndices.end( ); ){
+
+                if ( it->first != _lastIndexedIncrement ){
+
+                    it = _attributeIndices.erase( it );
+
+                }
+                else{
+
+                    it++;
+
+                }
+
+            }
+
+        }
+
+        _lastIndexedIncrement = increment;
+
+        auto emplaced = _attributeIndices.emplace( increment, attributeIndex( ) );
+        attributeIndex &gridIndex = emplaced.first->second;
+
+        //A replaced grid is detected by checking that the first indexed attribute is still at its position
+        bool isStale = emplaced.second || ( gridIndex.numAttributes != unstructuredGrid->getNumberAttributes( ) );
+
+        if ( !isStale && ( gridIndex.nodeAttributes.size( ) > 0 ) ){
+
+            auto first = gridIndex.nodeAttributes.begin( );
+            isStale = unstructuredGrid->getAttribute( first->second )->getName( ).compare( first->first ) != 0;
+
+        }
+        else if ( !isStale && ( gridIndex.cellAttributes.size( ) > 0 ) ){
+
+            auto first = gridIndex.cellAttributes.begin( );
+            isStale = unstructuredGrid->getAttribute( first->second )->getName( ).compare( first->first ) != 0;
+
+        }
+
+        if ( isStale ){
+
+            gridIndex.numAttributes = unstructuredGrid->getNumberAttributes( );
+            gridIndex.nodeAttributes.clear( );
+            gridIndex.cellAttributes.clear( );
+
+            for ( uIntType a = 0; a < gridIndex.numAttributes; a++ ){
+
+                shared_ptr< XdmfAttribute > attribute = unstructuredGrid->getAttribute( a );
+
+                //If a name is repeated the first attribute is used
+                if ( attribute->getCenter( ) == XdmfAttributeCenter::Node( ) ){
+
+                    gridIndex.nodeAttributes.emplace( attribute->getName( ), a );
+
+                }
+                else if ( attribute->getCenter( ) == XdmfAttributeCenter::Cell( ) ){
+
+                    gridIndex.cellAttributes.emplace( attribute->getName( ), a );
+
+                }
+
+            }
+
+        }
+
+        index = &gridIndex;
+
+        return NULL;
+
+    }
+
+    void XDMFDataFile::releaseHeavyData( const shared_ptr< XdmfArray > &array ){
+        /*!
+         * Release the values of an array which have been read from the heavy data file if the memory policy
+         * requires it. Arrays without heavy data controllers hold the only copy of their values and are not released.
+         *
+         * :param const shared_ptr< XdmfArray > &array: The array
+         */
+
+        if ( _releaseHeavyData && ( _mode.compare( "read" ) == 0 ) && ( array->getNumberHeavyDataControllers( ) > 0 ) ){
+
+            array->release( );
+
+        }
+
+    }
+
     errorOut XDMFDataFile::getSolutionData( const uIntType increment, const std::string &dataName, const std::string &dataCenter,
                                             floatVector &data ){
         /*!
@@ -1145,58 +1371,118 @@ namespace dataFileInterface{
          *
          */
 
-        //Get the grid
+        return getSolutionData( increment, stringVector( { dataName } ), dataCenter, data );
+
+    }
+
+    errorOut XDMFDataFile::getSolutionData( const uIntType increment, const stringVector &dataNames, const std::string &dataCenter,
+                                            floatVector &data ){
+        /*!
+         * Get the values of several solution data in a single call. The values are interleaved in the output
+         * so that the values of all of the data names at a point are stored together.
+         *
+         * :param const uIntType increment: The increment at which to get the data
+         * :param const stringVector &dataNames: The names of the data
+         * :param const std::string &dataCenter: The type of the data. This will either be "Node" or "Cell"
+         * :param floatVector &data: The output data vector
+         */
+
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
+        if ( dataNames.size( ) == 0 ){
+
+            data.clear( );
+            return NULL;
+
+        }
+
+        //Set the center
+        std::string centerName = dataCenter;
+        boost::algorithm::to_lower( centerName );
+
+        if ( ( centerName.compare( "node" ) != 0 ) && ( centerName.compare( "cell" ) != 0 ) ){
+            return new errorNode( "getSolutionData", "The dataCenter must either be 'Node' or 'Cell'" ); 
+        }
+
+        //Get the grid and the index of its attributes
         shared_ptr< XdmfUnstructuredGrid > grid;
-        errorOut error = getUnstructuredGrid( increment, grid );
+        const attributeIndex *index;
+        errorOut error = getAttributeIndex( increment, grid, index );
+
         if ( error ){
             errorOut result = new errorNode( "getSolutionData", "Error in the extraction of the grid" );
             result->addNext( error );
             return result;
         }
 
-        //Set the name and center
-        std::string name;
-        shared_ptr< const XdmfAttributeCenter > center;
+        const std::unordered_map< std::string, uIntType > &attributes
+            = ( centerName.compare( "node" ) == 0 ) ? index->nodeAttributes : index->cellAttributes;
 
+        uIntType nComponents = dataNames.size( );
+        uIntType nDataPoints = 0;
 
-        //Set the center
-        std::string centerName = dataCenter;
-        boost::algorithm::to_lower( centerName );
+        for ( auto dataName = dataNames.begin( ); dataName != dataNames.end( ); dataName++ ){
 
-        if ( centerName.compare( "node" ) == 0 ){
-            center = XdmfAttributeCenter::Node( );
-        }
-        else if ( centerName.compare( "cell" ) == 0 ){
-            center = XdmfAttributeCenter::Cell( );
-        }
-        else{
-            return new errorNode( "getSolutionData", "The dataCenter must either be 'Node' or 'Cell'" ); 
-        }
+            auto a = attributes.find( *dataName );
 
+            if ( a == attributes.end( ) ){
 
-        //Find the attribute name and type that matches up with the requested values
-        shared_ptr< XdmfAttribute > attribute;
-        for ( uIntType a = 0; a < grid->getNumberAttributes( ); a++ ){
+                return new errorNode( "getSolutionData",
+                                      "Attribute with dataName '" + *dataName + "' and center '" + dataCenter + "' was not found" );
 
-            //Get the current attribute
-            attribute = grid->getAttribute( a );
+            }
+
+            shared_ptr< XdmfAttribute > attribute = grid->getAttribute( a->second );
+
+            uIntType componentIndex = dataName - dataNames.begin( );
 
-            //Check if the data is right
-            if ( ( dataName.compare( attribute->getName( ) ) == 0 ) &&
-                 ( attribute->getCenter( ) == center ) ){
+            if ( componentIndex == 0 ){
+
+                nDataPoints = attribute->getSize( );
+                data = floatVector( nComponents * nDataPoints );
 
-                data = floatVector( attribute->getSize( ) );
-                attribute->read( );
-                grid->getAttribute( a )->getValues( 0, data.data( ), grid->getAttribute( a )->getSize( ), 1, 1 );
+            }
+            else if ( attribute->getSize( ) != nDataPoints ){
 
-                return NULL;
+                return new errorNode( "getSolutionData",
+                                      "The data " + *dataName + " does not have a consistent size with preceeding data" );
 
             }
 
+            //Write the values directly into their interleaved positions
+            attribute->read( );
+            attribute->getValues( 0, data.data( ) + componentIndex, nDataPoints, 1, nComponents );
+            releaseHeavyData( attribute );
+
         }
 
-        return new errorNode( "getSolutionData",
-                              "Attribute with dataName '" + dataName + "' and center '" + dataCenter + "' was not found" );
+        return NULL;
+
+    }
+
+    errorOut XDMFDataFile::getSolutionVectorDataFromComponents( const uIntType increment,
+                                                                const stringVector &componentNames,
+                                                                const std::string &dataCenter, floatVector &data ){
+        /*!
+         * Extract solution vector ( and tensor ) data from a file where the components are saved individually
+         *
+         * :param const uIntType increment: The increment at which to get the data
+         * :param const stringVector &componentNames: The name of the data's components
+         * :param const std::string &dataCenter: The type of the data. This will either be "Node" or "Cell"
+         * :param floatVector &data: The output data vector
+         */
+
+        errorOut error = getSolutionData( increment, componentNames, dataCenter, data );
+
+        if ( error ){
+
+            errorOut result = new errorNode( "getSolutionVectorDataFromComponents", "Error in the extraction of the components" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        return NULL;
 
     }
 
@@ -1214,6 +1500,8 @@ namespace dataFileInterface{
          * :param uIntType &cellCounts: The number of cells present.
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         //Get the grid
         shared_ptr< XdmfUnstructuredGrid > grid;
         errorOut error = getUnstructuredGrid( increment, grid );
@@ -1233,6 +1521,7 @@ namespace dataFileInterface{
         //Set the node positions
         nodePositions = floatVector( geom->getSize( ) );
         geom->getValues( 0, nodePositions.data( ), geom->getSize( ), 1, 1 );
+        releaseHeavyData( geom );
 
         //Get the topology
         shared_ptr< XdmfTopology > topology = grid->getTopology( );
@@ -1269,6 +1558,8 @@ namespace dataFileInterface{
 
         }
 
+        releaseHeavyData( topology );
+
         if ( !_config[ "cell_id_variable_name" ] ){
             return new errorNode( "getMeshData", "The key 'cell_id_variable_name' is not defined" );
         }
@@ -1304,6 +1595,8 @@ namespace dataFileInterface{
          * :param floatType &time: The time associated with the increment
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         //Check the number of increments
         uIntType numIncrements;
         errorOut error = getNumIncrements( numIncrements );
@@ -1343,6 +1636,8 @@ namespace dataFileInterface{
          * :param uIntType &increment: The initialized increment's number
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         //Initialize the grid
         shared_ptr< XdmfUnstructuredGrid > grid = XdmfUnstructuredGrid::New( );
 
@@ -1359,6 +1654,7 @@ namespace dataFileInterface{
         }
         shared_ptr< XdmfGridCollection > collection = _domain->getGridCollection( collectionNumber ); //TODO: This should be verified to be general enough
         collection->insert( grid );
+        _unflushedChanges = true;
 
 //        //Form the writer
 //        shared_ptr< XdmfHDF5Writer > heavyWriter = XdmfHDF5Writer::New( _filename + ".h5", false );
@@ -1396,6 +1692,10 @@ namespace dataFileInterface{
          * :param const uIntVector &connectivity: The connectivity description in XDMF format [ element_type_1, ..., element_type_2, ..., ]
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
+        _unflushedChanges = true;
+
         if ( _domain->getGridCollection( collectionNumber )->getNumberUnstructuredGrids( ) < increment ){
 
             return new errorNode( "writeIncrementMeshData",
@@ -1537,6 +1837,46 @@ namespace dataFileInterface{
 
     }
 
+    errorOut XDMFDataFile::flush( ){
+        /*!
+         * Write the light data of the domain and any heavy data which has not yet been written to the file.
+         * The heavy data writer releases the data of the arrays once they are written so datasets which
+         * were written by a previous flush are only referenced and not written again.
+         */
+
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
+        if ( ( _mode.compare( "write" ) != 0 ) || ( _domain == nullptr ) || !_unflushedChanges ){
+
+            return NULL;
+
+        }
+
+        try{
+
+            if ( !_heavyWriter ){
+
+                _heavyWriter = XdmfHDF5Writer::New( _filename + ".h5", false );
+                _heavyWriter->setReleaseData( true );
+
+            }
+
+            shared_ptr< XdmfWriter > writer = XdmfWriter::New( _filename + ".xdmf", _heavyWriter );
+
+            _domain->accept( writer );
+
+        }
+        catch( XdmfError &e ){
+
+            return new errorNode( "flush", e.what( ) );
+
+        }
+
+        _unflushedChanges = false;
+
+        return NULL;
+    }
+
     errorOut XDMFDataFile::addRootCollection( const std::string &collectionName, const std::string &collectionDescription,
                                               uIntType &collectionNumber ){
         /*!
@@ -1547,6 +1887,8 @@ namespace dataFileInterface{
          * :param uIntType &collectionNumber: The number of the new collection
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         //Create the main temporal collection
         shared_ptr< XdmfGridCollection > _gridHolder = XdmfGridCollection::New( );
         _gridHolder->setType( XdmfGridCollectionType::Temporal( ) );
@@ -1554,6 +1896,7 @@ namespace dataFileInterface{
             = XdmfInformation::New( collectionName, collectionDescription );
         _gridHolder->insert( _holderInfo );
         _domain->insert( _gridHolder );
+        _unflushedChanges = true;
 
 //        //Build the writer
 //        shared_ptr< XdmfHDF5Writer > heavyWriter = XdmfHDF5Writer::New( _filename + ".h5", false );
@@ -1578,6 +1921,8 @@ namespace dataFileInterface{
          * :param uIntVector &domainNodes: The nodes in the domain
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         shared_ptr< XdmfUnstructuredGrid > grid;
         errorOut error = getUnstructuredGrid( increment, grid );
 
@@ -1595,6 +1940,7 @@ namespace dataFileInterface{
             _attribute->read( );
             domainNodes.resize( _attribute->getSize( ) );
             _attribute->getValues( 0, domainNodes.data(), _attribute->getSize( ), 1, 1 );
+            releaseHeavyData( _attribute );
 
         }
         catch( XdmfError &e ){
@@ -1620,6 +1966,8 @@ namespace dataFileInterface{
          * :param uIntVector &domainNodes: The nodes in the domain
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
         shared_ptr< XdmfUnstructuredGrid > grid;
         errorOut error = getUnstructuredGrid( increment, grid );
 
@@ -1637,6 +1985,7 @@ namespace dataFileInterface{
             _attribute->read( );
             domainCells.resize( _attribute->getSize( ) );
             _attribute->getValues( 0, domainCells.data(), _attribute->getSize( ), 1, 1 );
+            releaseHeavyData( _attribute );
 
         }
         catch( XdmfError &e ){
@@ -1663,6 +2012,10 @@ namespace dataFileInterface{
          * :param const floatVector &data: The data to write
          */
 
+        std::lock_guard< std::recursive_mutex > lock( xdmfLibraryMutex );
+
+        _unflushedChanges = true;
+
         if ( _domain->getNumberGridCollections( ) <= collectionNumber ){
 
             return new errorNode( "writeScalarSolutionData",
@@ -1728,4 +2081,223 @@ namespace dataFileInterface{
 
     }
 
+    /*=========================================================================
+    |                             bufferedDataFile                            |
+    =========================================================================*/
+
+    bufferedDataFile::bufferedDataFile( ) : dataFileBase( ){
+        /*!
+         * The bufferedDataFile constructor. The buffer is always in write mode.
+         */
+
+        _mode = "write";
+
+        return;
+    }
+
+    errorOut bufferedDataFile::initializeIncrement( const floatType time, const uIntType &reference_increment,
+                                                    const uIntType &collectionNumber, uIntType &increment ){
+        /*!
+         * Record the initialization of a new increment
+         *
+         * :param const floatType time: The time of the increment
+         * :param const uIntType &reference_increment: The reference increment in the target file
+         * :param const uIntType &collectionNumber: The collection number the increment belongs to
+         * :param uIntType &increment: The buffer-local increment number
+         */
+
+        operation op;
+        op.type = INITIALIZE_INCREMENT;
+        op.time = time;
+        op.referenceIncrement = reference_increment;
+        op.collectionNumber = collectionNumber;
+        op.increment = _numIncrements;
+
+        increment = _numIncrements;
+        _numIncrements++;
+
+        _operations.push_back( std::move( op ) );
+
+        return NULL;
+
+    }
+
+    errorOut bufferedDataFile::writeIncrementMeshData( const uIntType increment, const uIntType collectionNumber,
+                                                       const uIntVector &nodeIds, const uIntMatrix &nodeSets,
+                                                       const stringVector &nodeSetNames, const floatVector &nodePositions,
+                                                       const uIntVector &elementIds, const uIntMatrix &elementSets,
+                                                       const stringVector &elementSetNames, const uIntVector &connectivity ){
+        /*!
+         * Record a copy of the mesh data of an increment
+         *
+         * :param const uIntType increment: The buffer-local increment number
+         * :param const uIntType collectionNumber: The collection number
+         * :param const uIntVector &nodeIds: The global node ids
+         * :param const uIntMatrix &nodeSets: The node sets
+         * :param const stringVector &nodeSetNames: The names of the node sets
+         * :param const floatVector &nodePositions: The positions of the nodes
+         * :param const uIntVector &elementIds: The global element ids
+         * :param const uIntMatrix &elementSets: The element sets
+         * :param const stringVector &elementSetNames: The names of the element sets
+         * :param const uIntVector &connectivity: The XDMF connectivity vector
+         */
+
+        return writeIncrementMeshData( increment, collectionNumber, uIntVector( nodeIds ), uIntMatrix( nodeSets ),
+                                       stringVector( nodeSetNames ), floatVector( nodePositions ),
+                                       uIntVector( elementIds ), uIntMatrix( elementSets ),
+                                       stringVector( elementSetNames ), uIntVector( connectivity ) );
+
+    }
+
+    errorOut bufferedDataFile::writeIncrementMeshData( const uIntType increment, const uIntType collectionNumber,
+                                                       uIntVector &&nodeIds, uIntMatrix &&nodeSets,
+                                                       stringVector &&nodeSetNames, floatVector &&nodePositions,
+                                                       uIntVector &&elementIds, uIntMatrix &&elementSets,
+                                                       stringVector &&elementSetNames, uIntVector &&connectivity ){
+        /*!
+         * Record the mesh data of an increment. The data is moved into the buffer.
+         *
+         * :param const uIntType increment: The buffer-local increment number
+         * :param const uIntType collectionNumber: The collection number
+         * :param uIntVector &&nodeIds: The global node ids
+         * :param uIntMatrix &&nodeSets: The node sets
+         * :param stringVector &&nodeSetNames: The names of the node sets
+         * :param floatVector &&nodePositions: The positions of the nodes
+         * :param uIntVector &&elementIds: The global element ids
+         * :param uIntMatrix &&elementSets: The element sets
+         * :param stringVector &&elementSetNames: The names of the element sets
+         * :param uIntVector &&connectivity: The XDMF connectivity vector
+         */
+
+        if ( increment >= _numIncrements ){
+
+            return new errorNode( "writeIncrementMeshData", "Increment " + std::to_string( increment ) + " has not been initialized in the buffer" );
+
+        }
+
+        operation op;
+        op.type = WRITE_INCREMENT_MESH_DATA;
+        op.increment = increment;
+        op.collectionNumber = collectionNumber;
+        op.nodeIds = std::move( nodeIds );
+        op.nodeSets = std::move( nodeSets );
+        op.nodeSetNames = std::move( nodeSetNames );
+        op.nodePositions = std::move( nodePositions );
+        op.elementIds = std::move( elementIds );
+        op.elementSets = std::move( elementSets );
+        op.elementSetNames = std::move( elementSetNames );
+        op.connectivity = std::move( connectivity );
+
+        _operations.push_back( std::move( op ) );
+
+        return NULL;
+
+    }
+
+    errorOut bufferedDataFile::writeScalarSolutionData( const uIntType increment, const uIntType collectionNumber,
+                                                        const std::string &dataName, const std::string &dataType,
+                                                        const floatVector &data ){
+        /*!
+         * Record a copy of scalar solution data of an increment
+         *
+         * :param const uIntType increment: The buffer-local increment number
+         * :param const uIntType collectionNumber: The collection number
+         * :param const std::string &dataName: The name of the data
+         * :param const std::string &dataType: The type of the data ( Node or Cell )
+         * :param const floatVector &data: The data
+         */
+
+        return writeScalarSolutionData( increment, collectionNumber, dataName, dataType, floatVector( data ) );
+
+    }
+
+    errorOut bufferedDataFile::writeScalarSolutionData( const uIntType increment, const uIntType collectionNumber,
+                                                        const std::string &dataName, const std::string &dataType,
+                                                        floatVector &&data ){
+        /*!
+         * Record scalar solution data of an increment. The data is moved into the buffer.
+         *
+         * :param const uIntType increment: The buffer-local increment number
+         * :param const uIntType collectionNumber: The collection number
+         * :param const std::string &dataName: The name of the data
+         * :param const std::string &dataType: The type of the data ( Node or Cell )
+         * :param floatVector &&data: The data
+         */
+
+        if ( increment >= _numIncrements ){
+
+            return new errorNode( "writeScalarSolutionData", "Increment " + std::to_string( increment ) + " has not been initialized in the buffer" );
+
+        }
+
+        operation op;
+        op.type = WRITE_SCALAR_SOLUTION_DATA;
+        op.increment = increment;
+        op.collectionNumber = collectionNumber;
+        op.dataName = dataName;
+        op.dataType = dataType;
+        op.data = std::move( data );
+
+        _operations.push_back( std::move( op ) );
+
+        return NULL;
+
+    }
+
+    errorOut bufferedDataFile::replay( dataFileBase &target ){
+        /*!
+         * Perform the recorded operations on the target data file in the order they were recorded
+         *
+         * :param dataFileBase &target: The data file to write to
+         */
+
+        uIntVector targetIncrements( _numIncrements );
+
+        for ( auto op = _operations.begin( ); op != _operations.end( ); op++ ){
+
+            errorOut error = NULL;
+
+            if ( op->type == INITIALIZE_INCREMENT ){
+
+                error = target.initializeIncrement( op->time, op->referenceIncrement, op->collectionNumber,
+                                                    targetIncrements[ op->increment ] );
+
+            }
+            else if ( op->type == WRITE_INCREMENT_MESH_DATA ){
+
+                error = target.writeIncrementMeshData( targetIncrements[ op->increment ], op->collectionNumber,
+                                                       op->nodeIds, op->nodeSets, op->nodeSetNames, op->nodePositions,
+                                                       op->elementIds, op->elementSets, op->elementSetNames, op->connectivity );
+
+            }
+            else{
+
+                error = target.writeScalarSolutionData( targetIncrements[ op->increment ], op->collectionNumber,
+                                                        op->dataName, op->dataType, op->data );
+
+            }
+
+            if ( error ){
+
+                errorOut result = new errorNode( "replay", "Error in replaying operation " + std::to_string( op - _operations.begin( ) ) );
+                result->addNext( error );
+                return result;
+
+            }
+
+        }
+
+        return NULL;
+
+    }
+
+    uIntType bufferedDataFile::getNumOperations( ) const{
+        /*!
+         * Get the number of recorded operations
+         */
+
+        return _operations.size( );
+
+    }
+
 }
@@ -14,7 +14,9 @@
 #include<error_tools.h>
 #include<yaml-cpp/yaml.h>
 #include<map>
+#include<unordered_map>
 #include<memory>
+#include<mutex>
 
 //XDMF headers
 #include "XdmfDomain.hpp"
@@ -103,6 +105,8 @@ namespace dataFileInterface{
             virtual errorOut getSetNames( const uIntType increment, stringVector &setNames ); //Required overload
             virtual errorOut getSolutionData( const uIntType increment, const std::string &dataName, const std::string &dataType,
                                               floatVector &data ); //Required overload
+            virtual errorOut getSolutionData( const uIntType increment, const stringVector &dataNames, const std::string &dataType,
+                                              floatVector &data ); //Probably doesn't need to be overloaded
             virtual errorOut getSolutionVectorDataFromComponents( const uIntType increment,
                                                                   const stringVector &componentNames,
                                                                   const std::string &dataType, floatVector &data ); //Probably doesn't need to be overloaded
@@ -122,14 +126,24 @@ namespace dataFileInterface{
                                                      const stringVector &nodeSetNames, const floatVector &nodePositions,
                                                      const uIntVector &elementIds, const uIntMatrix &elementSets,
                                                      const stringVector &elementSetNames, const uIntVector &connectivity ); //Required overload
+            virtual errorOut writeIncrementMeshData( const uIntType increment, const uIntType collectionNumber,
+                                                     uIntVector &&nodeIds, uIntMatrix &&nodeSets,
+                                                     stringVector &&nodeSetNames, floatVector &&nodePositions,
+                                                     uIntVector &&elementIds, uIntMatrix &&elementSets,
+                                                     stringVector &&elementSetNames, uIntVector &&connectivity );
             virtual errorOut writeScalarSolutionData( const uIntType increment, const uIntType collectionNumber,
                                                       const std::string &dataName, const std::string &dataType,
                                                       const floatVector &data );
+            virtual errorOut writeScalarSolutionData( const uIntType increment, const uIntType collectionNumber,
+                                                      const std::string &dataName, const std::string &dataType,
+                                                      floatVector &&data );
 
             virtual errorOut writeSolutionData( const uIntType increment, const uIntType collectionNumber,
                                                 const stringVector &dataNames, const std::string &dataType,
                                                 const floatVector &data ); //Probably doesn't need to be overloaded
 
+            virtual errorOut flush( );
+
             std::unique_ptr< errorNode > _error;
             std::string _filename;
             std::string _mode;
@@ -148,6 +162,12 @@ namespace dataFileInterface{
         /*!
          * The XDMF data file interface definition
          *
+         * In read mode the optional configuration key heavy_data_policy sets what happens to the heavy data
+         * of an array once its values have been copied out:
+         *
+         * heavy_data_policy: ( "release" ) The values are released. Reading the array again re-reads them.
+         *                    "keep" The values stay in memory for the life of the data file.
+         *
          * TODO: Consider moving this to its own header at some point.
          *       At this time, there is only one IO file type so it isn't
          *       a big deal.
@@ -175,6 +195,11 @@ namespace dataFileInterface{
             errorOut getSetNames( const uIntType increment, stringVector &setNames );
             errorOut getSolutionData( const uIntType increment, const std::string &dataName, const std::string &dataType,
                                       floatVector &data );
+            errorOut getSolutionData( const uIntType increment, const stringVector &dataNames, const std::string &dataType,
+                                      floatVector &data );
+            errorOut getSolutionVectorDataFromComponents( const uIntType increment,
+                                                          const stringVector &componentNames,
+                                                          const std::string &dataType, floatVector &data );
             errorOut getMeshData( const uIntType increment,
                                   floatVector &nodePositions, uIntVector &connectivity, uIntVector &connectivityCellIndices,
                                   uIntType &cellCounts );
@@ -183,6 +208,8 @@ namespace dataFileInterface{
                                           const uIntType &collectionNumber, uIntType &increment );
             errorOut addRootCollection( const std::string &collectionName, const std::string &collectionDescription,
                                         uIntType &collectionNumber );
+            using dataFileBase::writeIncrementMeshData;
+            using dataFileBase::writeScalarSolutionData;
             errorOut writeIncrementMeshData( const uIntType increment, const uIntType collectionNumber, 
                                              const uIntVector &nodeIds, const uIntMatrix &nodeSets,
                                              const stringVector &nodeSetNames, const floatVector &nodePositions,
@@ -192,13 +219,38 @@ namespace dataFileInterface{
                                               const std::string &dataName, const std::string &dataType,
                                               const floatVector &data );
 
+            errorOut flush( );
+
         private:
             //Interface Attributes
             shared_ptr< XdmfReader > _reader;
             shared_ptr< XdmfDomain > _domain;
 
+            //The heavy data writer is kept for the life of the file so that only new datasets are written
+            //to the HDF5 file when the domain is flushed
+            shared_ptr< XdmfHDF5Writer > _heavyWriter;
+            bool _unflushedChanges = false;
+
+            //The memory policy of the reader. If true the heavy data of an array is released once it has been copied
+            //so that only the light data of the increments which have been read is kept in memory.
+            bool _releaseHeavyData = true;
+
             uIntVector _increment_reference_grids;
 
+            //The index from the name of an attribute to its position in the grid of an increment. Only the
+            //positions are stored so the grids, which are owned by _domain, are not kept alive by the index. An
+            //index is rebuilt if attributes are added to its grid or if the grid has been replaced. Only the
+            //indices of the two most recently requested increments are kept so that the current increment and
+            //the one being read ahead do not evict each other while the number of indices stays bounded.
+            struct attributeIndex{
+                uIntType numAttributes = 0;
+                std::unordered_map< std::string, uIntType > nodeAttributes;
+                std::unordered_map< std::string, uIntType > cellAttributes;
+            };
+
+            std::unordered_map< uIntType, attributeIndex > _attributeIndices;
+            uIntType _lastIndexedIncrement = 0;
+
             //Functions
             void _initializeReadMode( );
             void _initializeWriteMode( YAML::Node &configuration );
@@ -208,7 +260,84 @@ namespace dataFileInterface{
 
             errorOut getUnstructuredGrid( const uIntType increment,
                                           shared_ptr< XdmfUnstructuredGrid > &unstructuredGrid );
+
+            errorOut getAttributeIndex( const uIntType increment, shared_ptr< XdmfUnstructuredGrid > &unstructuredGrid,
+                                        const attributeIndex *&index );
+
+            void releaseHeavyData( const shared_ptr< XdmfArray > &array );
+    };
+
+    class bufferedDataFile : public dataFileBase{
+        /*!
+         * A write-only data file which records the write operations in memory so that they can be
+         * replayed into another data file later ( e.g. by a background writer ).
+         *
+         * The increment numbers returned by initializeIncrement are local to the buffer and are
+         * mapped to the increment numbers of the target file when the buffer is replayed.
+         */
+
+        public:
+            //Constructors
+            bufferedDataFile( );
+
+            //Overloads
+            errorOut initializeIncrement( const floatType time, const uIntType &reference_increment,
+                                          const uIntType &collectionNumber, uIntType &increment );
+            errorOut writeIncrementMeshData( const uIntType increment, const uIntType collectionNumber,
+                                             const uIntVector &nodeIds, const uIntMatrix &nodeSets,
+                                             const stringVector &nodeSetNames, const floatVector &nodePositions,
+                                             const uIntVector &elementIds, const uIntMatrix &elementSets,
+                                             const stringVector &elementSetNames, const uIntVector &connectivity );
+            errorOut writeIncrementMeshData( const uIntType increment, const uIntType collectionNumber,
+                                             uIntVector &&nodeIds, uIntMatrix &&nodeSets,
+                                             stringVector &&nodeSetNames, floatVector &&nodePositions,
+                                             uIntVector &&elementIds, uIntMatrix &&elementSets,
+                                             stringVector &&elementSetNames, uIntVector &&connectivity );
+            errorOut writeScalarSolutionData( const uIntType increment, const uIntType collectionNumber,
+                                              const std::string &dataName, const std::string &dataType,
+                                              const floatVector &data );
+            errorOut writeScalarSolutionData( const uIntType increment, const uIntType collectionNumber,
+                                              const std::string &dataName, const std::string &dataType,
+                                              floatVector &&data );
+
+            errorOut replay( dataFileBase &target );
+
+            uIntType getNumOperations( ) const;
+
+        private:
+
+            enum operationType { INITIALIZE_INCREMENT, WRITE_INCREMENT_MESH_DATA, WRITE_SCALAR_SOLUTION_DATA };
+
+            struct operation{
+                operationType type;
+                uIntType increment;
+                uIntType collectionNumber;
+
+                //initializeIncrement
+                floatType time;
+                uIntType referenceIncrement;
+
+                //writeIncrementMeshData
+                uIntVector nodeIds;
+                uIntMatrix nodeSets;
+                stringVector nodeSetNames;
+                floatVector nodePositions;
+                uIntVector elementIds;
+                uIntMatrix elementSets;
+                stringVector elementSetNames;
+                uIntVector connectivity;
+
+                //writeScalarSolutionData
+                std::string dataName;
+                std::string dataType;
+                floatVector data;
+            };
+
+            std::vector< operation > _operations;
+            uIntType _numIncrements = 0;
     };
+
+    std::unique_lock< std::recursive_mutex > lockXDMFLibrary( );
 }
 
 #endif
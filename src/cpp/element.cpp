@@ -429,6 +429,7 @@ namespace elib{
                                                 double tolr, double tola, uitype maxiter, uitype maxls){
         /*!
          * Compute the local coordinates given the global coordinates. Does this via Newton iteration.
+         * If the iteration does not converge the local coordinates are set to the last iterate.
          * 
          * :param const vec &global_coordinates: The global coordinates to compute the local coordinates at (ndim, )
          * :param const vec &local_coordinates: The local coordinates (n local dim, )
@@ -583,6 +584,7 @@ namespace elib{
             }
 
             if (nls > maxls){
+                local_coordinates = xi;
                 return new errorNode( "compute_local_coordinates", "Failure in line search" );
             }
 
@@ -590,11 +592,86 @@ namespace elib{
 
             niter += 1;
         }
+        local_coordinates = xi;
         if (Rnorm > tol){
             return new errorNode( "compute_local_coordinates", "Newton-raphson did not converge" );
         }
-        else{
-            local_coordinates = xi;
+        return NULL;
+    }
+
+    errorOut Element::compute_local_coordinates_at_points(const vec &global_points, vec &local_points,
+                                                          std::vector< bool > &inside, vec &shape_functions,
+                                                          double tolr, double tola, uitype maxiter, uitype maxls){
+        /*!
+         * Compute the local coordinates and the shape functions at a collection of points.
+         *
+         * Points for which the local coordinates cannot be computed are assumed to be outside of the element
+         * unless the last iterate of the local coordinates is inside of the element, in which case an error
+         * is returned.
+         *
+         * :param const vec &global_points: The global coordinates of the points (npoints * ndim, )
+         * :param vec &local_points: The local coordinates of the points (npoints * n local dim, )
+         * :param std::vector< bool > &inside: Flags indicating if the points are inside of the element (npoints, )
+         * :param vec &shape_functions: The shape functions at the points (npoints * nnodes, ). Zero for points
+         *     outside of the element.
+         * :param double tolr: The relative tolerance
+         * :param double tola: The absolute tolerance
+         * :param int maxiter: The maximum number of iterations
+         * :param int maxls: The maximum number of line search iterations
+         */
+
+        uitype ndim = nodes[0].size();
+        uitype nlocal = local_node_coordinates[0].size();
+        uitype nnodes = nodes.size();
+
+        if ((global_points.size() % ndim) != 0){
+            return new errorNode( "compute_local_coordinates_at_points",
+                                  "The size of the global points is not a multiple of the dimension" );
+        }
+
+        uitype npoints = global_points.size()/ndim;
+
+        local_points.assign(npoints*nlocal, 0);
+        inside.assign(npoints, false);
+        shape_functions.assign(npoints*nnodes, 0);
+
+        vec x(ndim), xi, N;
+
+        for (uitype p=0; p<npoints; p++){
+            for (uitype i=0; i<ndim; i++){
+                x[i] = global_points[ndim*p + i];
+            }
+
+            xi.clear();
+            std::unique_ptr< errorNode > error( compute_local_coordinates(x, xi, tolr, tola, maxiter, maxls) );
+            if ( error ){
+                if ( !local_point_inside(xi) ){
+                    continue;
+                }
+                errorOut result = new errorNode( "compute_local_coordinates_at_points",
+                                                 "The local coordinates of point " + std::to_string(p) +
+                                                 " could not be computed" );
+                result->addNext( error.release() );
+                return result;
+            }
+
+            for (uitype i=0; i<nlocal; i++){
+                local_points[nlocal*p + i] = xi[i];
+            }
+
+            inside[p] = local_point_inside(xi);
+
+            if (inside[p]){
+                error.reset( get_shape_functions(xi, N) );
+                if ( error ){
+                    errorOut result = new errorNode( "compute_local_coordinates_at_points", "Error in get_shape_functions" );
+                    result->addNext( error.release() );
+                    return result;
+                }
+                for (uitype n=0; n<nnodes; n++){
+                    shape_functions[nnodes*p + n] = N[n];
+                }
+            }
         }
         return NULL;
     }
@@ -708,6 +785,463 @@ namespace elib{
         return &global_node_ids;
     }
 
+    template< class element_type, uitype nnodes, uitype ndim >
+    bool FixedSizeElement< element_type, nnodes, ndim >::has_fixed_size_nodes( ){
+        /*!
+         * Determine if the nodes of the element have the number and dimension of the fixed size kernels
+         */
+
+        if ( nodes.size( ) != nnodes ){
+            return false;
+        }
+
+        for ( auto node = nodes.begin( ); node != nodes.end( ); node++ ){
+            if ( node->size( ) != ndim ){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template< class element_type, uitype nnodes, uitype ndim >
+    void FixedSizeElement< element_type, nnodes, ndim >::get_node_matrix( node_matrix &X ){
+        /*!
+         * Copy the current nodal coordinates into a fixed size matrix
+         *
+         * :param node_matrix &X: The nodal coordinates (nnodes, ndim)
+         */
+
+        for ( uitype n = 0; n < nnodes; n++ ){
+            for ( uitype i = 0; i < ndim; i++ ){
+                X( n, i ) = nodes[ n ][ i ];
+            }
+        }
+    }
+
+    template< class element_type, uitype nnodes, uitype ndim >
+    errorOut FixedSizeElement< element_type, nnodes, ndim >::interpolate(const vec &nodal_values, const vec &local_coordinates,
+                                                                         double &value){
+        /*!
+         * Interpolate the vector of values to the provided local coordinates.
+         * 
+         * :param const vec &nodal_values: The values to be interpolated (nnodes, value at node n)
+         * :param const vec &local_coordinates: The local coordinates at which to interpolate the values. (n local dim, )
+         * :param double &value: The interpolated value
+         */
+
+        if ( local_coordinates.size( ) != ndim ){
+            return Element::interpolate( nodal_values, local_coordinates, value );
+        }
+
+        shape_vector N;
+        element_type::fixed_shape_functions( local_coordinates.data( ), N );
+
+        value = 0;
+        for ( uitype n = 0; n < nnodes; n++ ){
+            value += N( n ) * nodal_values[ n ];
+        }
+        return NULL;
+    }
+
+    template< class element_type, uitype nnodes, uitype ndim >
+    errorOut FixedSizeElement< element_type, nnodes, ndim >::interpolate(const vecOfvec &nodal_values, const vec &local_coordinates,
+                                                                         vec &value){
+        /*!
+         * Interpolate the vector of values to the provided local coordinates.
+         * 
+         * :param const vecOfvec &nodal_values: The values to be interpolated (nnodes, value at node n)
+         * :param const vec &local_coordinates: The local coordinates at which to interpolate the values. (n local dim, )
+         * :param vec &value: The interpolated value
+         */
+
+        if ( local_coordinates.size( ) != ndim ){
+            return Element::interpolate( nodal_values, local_coordinates, value );
+        }
+
+        shape_vector N;
+        element_type::fixed_shape_functions( local_coordinates.data( ), N );
+
+        value.assign( nodal_values[ 0 ].size( ), 0 );
+
+        for ( uitype n = 0; n < nnodes; n++ ){
+            for ( uitype v = 0; v < nodal_values[ n ].size( ); v++ ){
+                value[ v ] += N( n ) * nodal_values[ n ][ v ];
+            }
+        }
+        return NULL;
+    }
+
+    template< class element_type, uitype nnodes, uitype ndim >
+    errorOut FixedSizeElement< element_type, nnodes, ndim >::get_local_gradient(const vec &nodal_values, const vec &local_coordinates,
+                                                                                vec &value){
+        /*!
+         * Compute the gradient of the vector of values at the provided local coordinates.
+         * 
+         * :param const vec &nodal_values: The values to be interpolated (nnodes,)
+         * :param const vec &local_coordinates: The local coordinates at which to interpolate the values. (n local dim, )
+         * :param vec &value: The local gradient of the nodal_values
+         */
+
+        if ( local_coordinates.size( ) != ndim ){
+            return Element::get_local_gradient( nodal_values, local_coordinates, value );
+        }
+
+        shape_gradient_matrix dNdxi;
+        element_type::fixed_local_grad_shape_functions( local_coordinates.data( ), dNdxi );
+
+        value.assign( ndim, 0 );
+
+        for ( uitype n = 0; n < nnodes; n++ ){
+            for ( uitype i = 0; i < ndim; i++ ){
+                value[ i ] += nodal_values[ n ] * dNdxi( n, i );
+            }
+        }
+        return NULL;
+    }
+
+    template< class element_type, uitype nnodes, uitype ndim >
+    errorOut FixedSizeElement< element_type, nnodes, ndim >::get_local_gradient(const vecOfvec &nodal_values, const vec &local_coordinates,
+                                                                                vecOfvec &value){
+        /*!
+         * Compute the gradient of the vector of values at the provided local coordinates.
+         * 
+         * :param const vecOfvec &nodal_values: The values to be interpolated (nnodes, value at node n)
+         * :param const vec &local_coordinates: The local coordinates at which to interpolate the values. (n local dim, )
+         * :param vecOfvec &value: The local gradient of the nodal_values
+         */
+
+        if ( local_coordinates.size( ) != ndim ){
+            return Element::get_local_gradient( nodal_values, local_coordinates, value );
+        }
+
+        shape_gradient_matrix dNdxi;
+        element_type::fixed_local_grad_shape_functions( local_coordinates.data( ), dNdxi );
+
+        value.resize( nodal_values[ 0 ].size( ) );
+        for ( uitype v = 0; v < value.size( ); v++ ){
+            value[ v ].assign( ndim, 0 );
+        }
+
+        for ( uitype n = 0; n < nnodes; n++ ){
+            for ( uitype i = 0; i < nodal_values[ n ].size( ); i++ ){
+                for ( uitype j = 0; j < ndim; j++ ){
+                    value[ i ][ j ] += nodal_values[ n ][ i ] * dNdxi( n, j );
+                }
+            }
+        }
+        return NULL;
+    }
+
+    template< class element_type, uitype nnodes, uitype ndim >
+    void FixedSizeElement< element_type, nnodes, ndim >::estimate_local_coordinates( const node_matrix &X, const local_vector &x,
+                                                                                     local_vector &xi, double tolr, double tola ){
+        /*!
+         * Estimate the local coordinates of a globally defined point using the inverse distance weighting
+         * of the local node coordinates.
+         *
+         * :param const node_matrix &X: The nodal coordinates (nnodes, ndim)
+         * :param const local_vector &x: The global coordinates of the point
+         * :param local_vector &xi: The estimate of the local coordinates
+         * :param double tolr: The relative tolerance
+         * :param double tola: The absolute tolerance
+         */
+
+        shape_vector distance;
+        double sum_distance = 0;
+
+        for ( uitype n = 0; n < nnodes; n++ ){
+            distance( n ) = ( X.row( n ).transpose( ) - x ).norm( );
+            sum_distance += distance( n );
+        }
+
+        double tol = tolr * sum_distance + tola;
+        double sum_inv_distance = 0;
+
+        for ( uitype n = 0; n < nnodes; n++ ){
+            if ( distance( n ) < tol ){
+                for ( uitype i = 0; i < ndim; i++ ){
+                    xi( i ) = element_type::fixed_local_node_coordinates[ n ][ i ];
+                }
+                return;
+            }
+            sum_inv_distance += 1 / distance( n );
+        }
+
+        xi.setZero( );
+        for ( uitype n = 0; n < nnodes; n++ ){
+            for ( uitype i = 0; i < ndim; i++ ){
+                xi( i ) += element_type::fixed_local_node_coordinates[ n ][ i ] * ( 1 / distance( n ) ) / sum_inv_distance;
+            }
+        }
+    }
+
+    template< class element_type, uitype nnodes, uitype ndim >
+    errorOut FixedSizeElement< element_type, nnodes, ndim >::solve_local_coordinates( const node_matrix &X, const local_vector &x,
+                                                                                      local_vector &xi, double tolr, double tola,
+                                                                                      uitype maxiter, uitype maxls ){
+        /*!
+         * Solve for the local coordinates of a global point via Newton iteration using the same algorithm
+         * as Element::compute_local_coordinates on fixed size matrices.
+         *
+         * :param const node_matrix &X: The nodal coordinates (nnodes, ndim)
+         * :param const local_vector &x: The global coordinates of the point
+         * :param local_vector &xi: The initial iterate on input and the local coordinates on output
+         * :param double tolr: The relative tolerance
+         * :param double tola: The absolute tolerance
+         * :param int maxiter: The maximum number of iterations
+         * :param int maxls: The maximum number of line search iterations
+         */
+
+        // Compute the initial residual
+        shape_vector N;
+        shape_gradient_matrix dNdxi;
+
+        element_type::fixed_shape_functions( xi.data( ), N );
+        local_vector R = x - X.transpose( ) * N;
+
+        double R0, Rp, Rnorm;
+        R0 = Rp = Rnorm = R.norm( );
+
+        //Set the tolerance
+        double tol = tolr * R0 + tola;
+
+        //Begin the Newton iteration
+        uitype niter = 0;
+        uitype nls = 0;
+        double lambda = 1.;
+        local_vector dxi;
+        local_matrix J;
+        while ( ( niter < maxiter ) && ( Rnorm > tol ) ){
+
+            element_type::fixed_local_grad_shape_functions( xi.data( ), dNdxi );
+            J = X.transpose( ) * dNdxi;
+
+            dxi = J.fullPivLu( ).solve( R );
+
+            xi += dxi;
+
+            element_type::fixed_shape_functions( xi.data( ), N );
+            R = x - X.transpose( ) * N;
+            Rnorm = R.norm( );
+
+            //Line search
+            nls = 0;
+            lambda = 1.;
+            while ( Rnorm >= Rp ){
+
+                lambda *= 0.5;
+
+                xi -= dxi;
+                dxi *= lambda;
+                xi += dxi;
+
+                element_type::fixed_shape_functions( xi.data( ), N );
+                R = x - X.transpose( ) * N;
+                Rnorm = R.norm( );
+
+                nls += 1;
+                if ( nls > maxls ){
+                    break;
+                }
+            }
+
+            if ( nls > maxls ){
+                return new errorNode( "compute_local_coordinates", "Failure in line search" );
+            }
+
+            Rp = Rnorm;
+
+            niter += 1;
+        }
+        if ( Rnorm > tol ){
+            return new errorNode( "compute_local_coordinates", "Newton-raphson did not converge" );
+        }
+
+        return NULL;
+    }
+
+    template< class element_type, uitype nnodes, uitype ndim >
+    errorOut FixedSizeElement< element_type, nnodes, ndim >::compute_local_coordinates(const vec &global_coordinates, vec &local_coordinates,
+                                                                                       double tolr, double tola, uitype maxiter, uitype maxls){
+        /*!
+         * Compute the local coordinates given the global coordinates. Does this via Newton iteration.
+         * If the iteration does not converge the local coordinates are set to the last iterate.
+         * 
+         * :param const vec &global_coordinates: The global coordinates to compute the local coordinates at (ndim, )
+         * :param const vec &local_coordinates: The local coordinates (n local dim, )
+         * :param double tolr: The relative tolerance
+         * :param double tola: The absolute tolerance
+         * :param int maxiter: The maximum number of iterations
+         * :param int maxls: The maximum number of line search iterations
+         */
+
+        if ( ( global_coordinates.size( ) != ndim ) || !has_fixed_size_nodes( ) ){
+            return Element::compute_local_coordinates( global_coordinates, local_coordinates, tolr, tola, maxiter, maxls );
+        }
+
+        node_matrix X;
+        get_node_matrix( X );
+
+        Eigen::Map< const local_vector > x( global_coordinates.data( ) );
+
+        // Set the initial iterate
+        local_vector xi;
+        estimate_local_coordinates( X, x, xi );
+
+        errorOut error = solve_local_coordinates( X, x, xi, tolr, tola, maxiter, maxls );
+
+        local_coordinates.resize( ndim );
+        for ( uitype i = 0; i < ndim; i++ ){
+            local_coordinates[ i ] = xi( i );
+        }
+        return error;
+    }
+
+    template< class element_type, uitype nnodes, uitype ndim >
+    errorOut FixedSizeElement< element_type, nnodes, ndim >::compute_local_coordinates_at_points(const vec &global_points, vec &local_points,
+                                                                                                 std::vector< bool > &inside, vec &shape_functions,
+                                                                                                 double tolr, double tola, uitype maxiter, uitype maxls){
+        /*!
+         * Compute the local coordinates and the shape functions at a collection of points.
+         *
+         * The Newton iteration for each point is started from the better of the inverse distance estimate
+         * and the local coordinates of the previous point so that spatially ordered points converge in few
+         * iterations.
+         *
+         * Points for which the local coordinates cannot be computed are assumed to be outside of the element
+         * unless the last iterate of the local coordinates is inside of the element, in which case an error
+         * is returned.
+         *
+         * :param const vec &global_points: The global coordinates of the points (npoints * ndim, )
+         * :param vec &local_points: The local coordinates of the points (npoints * ndim, )
+         * :param std::vector< bool > &inside: Flags indicating if the points are inside of the element (npoints, )
+         * :param vec &shape_functions: The shape functions at the points (npoints * nnodes, ). Zero for points
+         *     outside of the element.
+         * :param double tolr: The relative tolerance
+         * :param double tola: The absolute tolerance
+         * :param int maxiter: The maximum number of iterations
+         * :param int maxls: The maximum number of line search iterations
+         */
+
+        if ( !has_fixed_size_nodes( ) ){
+            return Element::compute_local_coordinates_at_points( global_points, local_points, inside, shape_functions,
+                                                                 tolr, tola, maxiter, maxls );
+        }
+
+        if ( ( global_points.size( ) % ndim ) != 0 ){
+            return new errorNode( "compute_local_coordinates_at_points",
+                                  "The size of the global points is not a multiple of the dimension" );
+        }
+
+        uitype npoints = global_points.size( ) / ndim;
+
+        local_points.assign( npoints * ndim, 0 );
+        inside.assign( npoints, false );
+        shape_functions.assign( npoints * nnodes, 0 );
+
+        node_matrix X;
+        get_node_matrix( X );
+
+        shape_vector N;
+        local_vector xi, xi_previous;
+        bool has_previous = false;
+        vec local_coordinates( ndim );
+
+        for ( uitype p = 0; p < npoints; p++ ){
+
+            Eigen::Map< const local_vector > x( global_points.data( ) + ndim * p );
+
+            estimate_local_coordinates( X, x, xi );
+
+            //Warm start from the previous point if it is the better initial iterate
+            if ( has_previous ){
+                element_type::fixed_shape_functions( xi.data( ), N );
+                double R_estimate = ( x - X.transpose( ) * N ).norm( );
+
+                element_type::fixed_shape_functions( xi_previous.data( ), N );
+                double R_previous = ( x - X.transpose( ) * N ).norm( );
+
+                if ( R_previous < R_estimate ){
+                    xi = xi_previous;
+                }
+            }
+
+            std::unique_ptr< errorNode > error( solve_local_coordinates( X, x, xi, tolr, tola, maxiter, maxls ) );
+
+            for ( uitype i = 0; i < ndim; i++ ){
+                local_coordinates[ i ] = xi( i );
+            }
+
+            if ( error ){
+                if ( !local_point_inside( local_coordinates ) ){
+                    continue;
+                }
+                errorOut result = new errorNode( "compute_local_coordinates_at_points",
+                                                 "The local coordinates of point " + std::to_string( p ) +
+                                                 " could not be computed" );
+                result->addNext( error.release( ) );
+                return result;
+            }
+
+            xi_previous = xi;
+            has_previous = true;
+
+            for ( uitype i = 0; i < ndim; i++ ){
+                local_points[ ndim * p + i ] = xi( i );
+            }
+
+            inside[ p ] = local_point_inside( local_coordinates );
+
+            if ( inside[ p ] ){
+                element_type::fixed_shape_functions( xi.data( ), N );
+                for ( uitype n = 0; n < nnodes; n++ ){
+                    shape_functions[ nnodes * p + n ] = N( n );
+                }
+            }
+        }
+
+        return NULL;
+    }
+
+    constexpr double Hex8::fixed_local_node_coordinates[ 8 ][ 3 ];
+
+    void Hex8::fixed_shape_functions( const double *local_coordinates, shape_vector &N ){
+        /*!
+         * Compute the shape functions for a Hex8 element without any memory allocation.
+         *
+         * :param const double *local_coordinates: The local coordinates (3, )
+         * :param shape_vector &N: The shape function values
+         */
+
+        for ( uitype n = 0; n < 8; n++ ){
+            N( n ) = 0.125 * ( 1 + fixed_local_node_coordinates[ n ][ 0 ] * local_coordinates[ 0 ] )
+                           * ( 1 + fixed_local_node_coordinates[ n ][ 1 ] * local_coordinates[ 1 ] )
+                           * ( 1 + fixed_local_node_coordinates[ n ][ 2 ] * local_coordinates[ 2 ] );
+        }
+    }
+
+    void Hex8::fixed_local_grad_shape_functions( const double *local_coordinates, shape_gradient_matrix &dNdxi ){
+        /*!
+         * Compute the local gradients of the shape functions for a Hex8 element without any memory allocation.
+         *
+         * :param const double *local_coordinates: The local coordinates (3, )
+         * :param shape_gradient_matrix &dNdxi: The gradients of the shape functions w.r.t. the local coordinates (8, 3)
+         */
+
+        for ( uitype n = 0; n < 8; n++ ){
+            const double *xi_n = fixed_local_node_coordinates[ n ];
+            double a = 1 + xi_n[ 0 ] * local_coordinates[ 0 ];
+            double b = 1 + xi_n[ 1 ] * local_coordinates[ 1 ];
+            double c = 1 + xi_n[ 2 ] * local_coordinates[ 2 ];
+
+            dNdxi( n, 0 ) = 0.125 * xi_n[ 0 ] * b * c;
+            dNdxi( n, 1 ) = 0.125 * a * xi_n[ 1 ] * c;
+            dNdxi( n, 2 ) = 0.125 * a * b * xi_n[ 2 ];
+        }
+    }
+
+    template class FixedSizeElement< Hex8, 8, 3 >;
+
     errorOut Hex8::get_shape_functions(const vec &local_coordinates, vec &result){
         /*!
          * Compute the shape functions for a Hex8 element.
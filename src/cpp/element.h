@@ -88,17 +88,17 @@ namespace elib{
             Element(const std::vector< uitype > &global_node_ids, const vecOfvec &nodes, const quadrature_rule &qrule);
 	    virtual ~Element() = default;
 
-            errorOut interpolate(const vec &nodal_values, const vec &local_coordinates,
-                                 double &value);
+            virtual errorOut interpolate(const vec &nodal_values, const vec &local_coordinates,
+                                         double &value);
 
-            errorOut interpolate(const vecOfvec &nodal_values, const vec &local_coordinates,
-                                 vec &value);
+            virtual errorOut interpolate(const vecOfvec &nodal_values, const vec &local_coordinates,
+                                         vec &value);
 
-            errorOut get_local_gradient(const vec &nodal_values, const vec &local_coordinates,
-	    	                        vec &value);
+            virtual errorOut get_local_gradient(const vec &nodal_values, const vec &local_coordinates,
+	    	                                vec &value);
 
-            errorOut get_local_gradient(const vecOfvec &nodal_values, const vec &local_coordinates,
-                                        vecOfvec &value);
+            virtual errorOut get_local_gradient(const vecOfvec &nodal_values, const vec &local_coordinates,
+                                                vecOfvec &value);
 
             errorOut get_global_gradient(const vec  &nodal_values, const vec &local_coordinates, const vecOfvec &coords,
                                          vec &value);
@@ -120,8 +120,12 @@ namespace elib{
             errorOut estimate_local_coordinates(const vec &global_coordinates, vec &local_coordinates,
                                                 double tolr=1e-9, double tola=1e-9);
 
-            errorOut compute_local_coordinates(const vec &global_coordinates, vec &local_coordinates,
-                                               double tolr=1e-9, double tola=1e-9, uitype maxiter=20, uitype maxls=5);
+            virtual errorOut compute_local_coordinates(const vec &global_coordinates, vec &local_coordinates,
+                                                       double tolr=1e-9, double tola=1e-9, uitype maxiter=20, uitype maxls=5);
+
+            virtual errorOut compute_local_coordinates_at_points(const vec &global_points, vec &local_points,
+                                                                 std::vector< bool > &inside, vec &shape_functions,
+                                                                 double tolr=1e-9, double tola=1e-9, uitype maxiter=20, uitype maxls=5);
 
             virtual errorOut get_shape_functions(const vec &local_coordinates, vec &result) = 0;
 //            {
@@ -159,6 +163,66 @@ namespace elib{
                                                      const bool &useCurrent = true );
     };
 
+    template< class element_type, uitype nnodes, uitype ndim >
+    class FixedSizeElement : public Element{
+        /*!
+         * A base class for elements with a number of nodes and a local dimension known at compile time.
+         *
+         * The interpolation, local gradient, and local coordinate computations are performed on fixed
+         * size Eigen matrices using the static shape function kernels of the element type i.e.
+         *
+         * static void fixed_shape_functions( const double *local_coordinates, shape_vector &N );
+         * static void fixed_local_grad_shape_functions( const double *local_coordinates, shape_gradient_matrix &dNdxi );
+         *
+         * so that no memory is allocated in the Newton iteration for the local coordinates. Elements whose
+         * global dimension differs from the local dimension fall back to the dynamically sized implementation.
+         */
+
+        public:
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+            typedef Eigen::Matrix< double, nnodes, 1 > shape_vector;
+            typedef Eigen::Matrix< double, nnodes, ndim > shape_gradient_matrix;
+            typedef Eigen::Matrix< double, nnodes, ndim > node_matrix;
+            typedef Eigen::Matrix< double, ndim, 1 > local_vector;
+            typedef Eigen::Matrix< double, ndim, ndim > local_matrix;
+
+            FixedSizeElement(const std::vector< uitype > &global_node_ids,
+                             const vecOfvec &nodes, const quadrature_rule &qrule) : Element(global_node_ids, nodes, qrule){}
+
+            errorOut interpolate(const vec &nodal_values, const vec &local_coordinates,
+                                 double &value);
+
+            errorOut interpolate(const vecOfvec &nodal_values, const vec &local_coordinates,
+                                 vec &value);
+
+            errorOut get_local_gradient(const vec &nodal_values, const vec &local_coordinates,
+                                        vec &value);
+
+            errorOut get_local_gradient(const vecOfvec &nodal_values, const vec &local_coordinates,
+                                        vecOfvec &value);
+
+            errorOut compute_local_coordinates(const vec &global_coordinates, vec &local_coordinates,
+                                               double tolr=1e-9, double tola=1e-9, uitype maxiter=20, uitype maxls=5);
+
+            errorOut compute_local_coordinates_at_points(const vec &global_points, vec &local_points,
+                                                         std::vector< bool > &inside, vec &shape_functions,
+                                                         double tolr=1e-9, double tola=1e-9, uitype maxiter=20, uitype maxls=5);
+
+        protected:
+
+            bool has_fixed_size_nodes( );
+
+            void get_node_matrix( node_matrix &X );
+
+            void estimate_local_coordinates( const node_matrix &X, const local_vector &x, local_vector &xi,
+                                             double tolr=1e-9, double tola=1e-9 );
+
+            errorOut solve_local_coordinates( const node_matrix &X, const local_vector &x, local_vector &xi,
+                                              double tolr, double tola, uitype maxiter, uitype maxls );
+
+    };
+
     const double sqrt3 = std::sqrt( 3. );
     const quadrature_rule Hex8_default_qrule = { { { -1 / sqrt3, -1 / sqrt3, -1 / sqrt3 }, 1. }, 
                                                  { {  1 / sqrt3, -1 / sqrt3, -1 / sqrt3 }, 1. },
@@ -177,7 +241,7 @@ namespace elib{
     const quadrature_rule Bar2_default_qrule = { { { -1 / sqrt3 }, 1. },
                                                  { {  1 / sqrt3 }, 1. } };
 
-    class Hex8 : public Element{
+    class Hex8 : public FixedSizeElement< Hex8, 8, 3 >{
         /*!
         An 8 noded hex element.
         */
@@ -185,8 +249,18 @@ namespace elib{
         public:
             EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
+            //The local coordinates of the nodes used by the fixed size kernels
+            static constexpr double fixed_local_node_coordinates[ 8 ][ 3 ] = { { -1, -1, -1 },
+                                                                              {  1, -1, -1 },
+                                                                              {  1,  1, -1 },
+                                                                              { -1,  1, -1 },
+                                                                              { -1, -1,  1 },
+                                                                              {  1, -1,  1 },
+                                                                              {  1,  1,  1 },
+                                                                              { -1,  1,  1 } };
+
             Hex8(const std::vector< uitype > &global_node_ids, 
-                 const vecOfvec &nodes, const quadrature_rule &qrule) : Element(global_node_ids, nodes, qrule){
+                 const vecOfvec &nodes, const quadrature_rule &qrule) : FixedSizeElement< Hex8, 8, 3 >(global_node_ids, nodes, qrule){
                 name = "Hex8";
                 local_node_coordinates = {{-1, -1, -1},
                                           { 1, -1, -1},
@@ -247,6 +321,9 @@ namespace elib{
             errorOut get_local_grad_shape_functions(const vec &local_coordinates, vecOfvec &result);
             bool local_point_inside(const vec &local_coordinates, const double tol=1e-8);
 
+            static void fixed_shape_functions( const double *local_coordinates, shape_vector &N );
+            static void fixed_local_grad_shape_functions( const double *local_coordinates, shape_gradient_matrix &dNdxi );
+
     };
 
     class Quad4 : public Element{
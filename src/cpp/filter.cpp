@@ -51,6 +51,14 @@ int main( int argc, char *argv[] ){
 
 	    std::cerr << "Error in increment i: " << i << "\n";
             error->print( );
+
+            //Make sure that the output of the completed increments is written
+            std::unique_ptr< errorNode > outputError( oc.flushOutput( ) );
+
+            if ( outputError ){
+                outputError->print( );
+            }
+
 	    return 1;
 
 	}
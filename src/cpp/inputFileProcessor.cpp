@@ -6,6 +6,8 @@
 =============================================================================*/
 
 #include<inputFileProcessor.h>
+#include<thread>
+#include<iomanip>
 
 namespace inputFileProcessor{
 
@@ -110,11 +112,37 @@ namespace inputFileProcessor{
         //Reset whether the increment has been initialized
         _increment_initialized = false;
 
+        //The domain membership belongs to the previous configuration
+        clearMicroDomainMembership( );
+
         initialize( );
 
         return _error;
     }
 
+    errorOut inputFileProcessor::reloadDataFiles( ){
+        /*!
+         * Re-open the macro and micro data files so that increments which have been written since
+         * the files were opened are available. The configuration and the coupling domains are retained
+         * but the next call to initializeIncrement will re-extract the increment's data.
+         */
+
+        _increment_initialized = false;
+
+        errorOut error = initializeFileInterfaces( );
+
+        if ( error ){
+
+            errorOut result = new errorNode( "reloadDataFiles", "Error in re-opening the data files" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        return NULL;
+
+    }
+
     errorOut inputFileProcessor::openConfigurationFile( ){
         /*!
          * Open the configuration file
@@ -181,6 +209,8 @@ namespace inputFileProcessor{
                 return result;
             }
 
+            _macroPrefetcher.setDataFile( _macroscale );
+
         }
         else{
 
@@ -202,8 +232,9 @@ namespace inputFileProcessor{
 
             }
 
-            //Open the micro-scale data file
+            //Open the micro-scale data file. The domain membership is re-read from the new file.
             _microscale = dataFileInterface::dataFileBase( _config[ "microscale_definition" ] ).create( _config[ "microscale_definition" ][ "filetype" ].as< std::string >( ) );
+            clearMicroDomainMembership( );
 
             if ( _microscale->_error ){
                 errorOut result = new errorNode( "initializeFileInterfaces", "Error in construction of the microscale interface" );
@@ -211,6 +242,8 @@ namespace inputFileProcessor{
                 return result;
             }
 
+            _microPrefetcher.setDataFile( _microscale );
+
         }
         else{
 
@@ -246,7 +279,7 @@ namespace inputFileProcessor{
         for ( auto setName = _free_micro_volume_sets.begin(); setName != _free_micro_volume_sets.end(); setName++ ){
 
             //Get the volume set
-            error = _microscale->getSubDomainNodes( increment, *setName, setNodes );
+            error = getMicroDomainNodes( increment, *setName, setNodes );
 
             if ( error ){
                 errorOut result = new errorNode( "setMicroNodeWeights",
@@ -269,7 +302,7 @@ namespace inputFileProcessor{
         for ( auto setName = _ghost_micro_volume_sets.begin(); setName != _ghost_micro_volume_sets.end(); setName++ ){
 
             //Get the volume set
-            error = _microscale->getSubDomainNodes( increment, *setName, setNodes );
+            error = getMicroDomainNodes( increment, *setName, setNodes );
 
             if ( error ){
                 errorOut result = new errorNode( "setMicroNodeWeights",
@@ -297,6 +330,118 @@ namespace inputFileProcessor{
         return NULL;
     }
 
+    errorOut inputFileProcessor::setMicroDomainMembership( const unsigned int &increment ){
+        /*!
+         * Set the index of the nodes which belong to the free and ghost micro domains. The
+         * membership is read from the first increment initialized and is assumed not to change.
+         * If 'revalidate_domain_membership' is true the membership is re-read at every increment
+         * and the index is replaced if any of the domains have changed.
+         *
+         * :param const unsigned int &increment: The micro increment at which to read the domains
+         */
+
+        if ( _microDomainMembershipSet && !_revalidateMicroDomainMembership ){
+
+            return NULL;
+
+        }
+
+        std::unordered_map< std::string, uIntType > membershipIndex;
+        uIntVector membershipOffsets = { 0 };
+        uIntVector membershipNodes;
+
+        uIntVector domainNodes;
+        errorOut error;
+
+        for ( auto domainNames : { &_free_micro_volume_sets, &_ghost_micro_volume_sets } ){
+
+            for ( auto name = domainNames->begin( ); name != domainNames->end( ); name++ ){
+
+                if ( membershipIndex.find( *name ) != membershipIndex.end( ) ){
+
+                    continue;
+
+                }
+
+                error = _microscale->getSubDomainNodes( increment, *name, domainNodes );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Error in the extraction of the micro domain " + *name );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+                membershipIndex.emplace( *name, membershipOffsets.size( ) - 1 );
+                membershipNodes.insert( membershipNodes.end( ), domainNodes.begin( ), domainNodes.end( ) );
+                membershipOffsets.push_back( membershipNodes.size( ) );
+
+            }
+
+        }
+
+        if ( _microDomainMembershipSet &&
+             ( membershipIndex == _microDomainMembershipIndex ) &&
+             ( membershipOffsets == _microDomainMembershipOffsets ) &&
+             ( membershipNodes == _microDomainMembershipNodes ) ){
+
+            //The domains have not changed
+            return NULL;
+
+        }
+
+        _microDomainMembershipIndex = membershipIndex;
+        _microDomainMembershipOffsets = membershipOffsets;
+        _microDomainMembershipNodes = membershipNodes;
+        _microDomainMembershipSet = true;
+
+        return NULL;
+
+    }
+
+    void inputFileProcessor::clearMicroDomainMembership( ){
+        /*!
+         * Clear the index of the nodes which belong to the micro domains so that it is rebuilt from the
+         * micro-scale data file when the next increment is initialized
+         */
+
+        _microDomainMembershipIndex.clear( );
+        _microDomainMembershipOffsets.clear( );
+        _microDomainMembershipNodes.clear( );
+        _microDomainMembershipSet = false;
+
+        return;
+
+    }
+
+    errorOut inputFileProcessor::getMicroDomainNodes( const unsigned int &increment, const std::string &domainName,
+                                                      uIntVector &domainNodes ){
+        /*!
+         * Get the nodes which belong to the given micro domain. Free and ghost micro domains are
+         * returned from the domain membership index. Any other domain is read from the micro-scale
+         * data file.
+         *
+         * :param const unsigned int &increment: The micro increment at which to get the domain's nodes
+         * :param const std::string &domainName: The name of the micro domain
+         * :param uIntVector &domainNodes: The nodes located in the domain
+         */
+
+        auto domain = _microDomainMembershipIndex.find( domainName );
+
+        if ( domain == _microDomainMembershipIndex.end( ) ){
+
+            return _microscale->getSubDomainNodes( increment, domainName, domainNodes );
+
+        }
+
+        domainNodes = uIntVector( _microDomainMembershipNodes.begin( ) + _microDomainMembershipOffsets[ domain->second ],
+                                  _microDomainMembershipNodes.begin( ) + _microDomainMembershipOffsets[ domain->second + 1 ] );
+
+        return NULL;
+
+    }
+
     errorOut inputFileProcessor::initializeIncrement( const unsigned int microIncrement, const unsigned int macroIncrement ){
         /*!
          * Initialize the processor for the indicated increment.
@@ -313,7 +458,23 @@ namespace inputFileProcessor{
             return NULL;
         }
 
+        //Exchange the read-ahead buffers so that the data prefetched for this increment is used. If an
+        //increment is the same as the previously initialized one it is expected to be repeated.
+        bool repeatMicroIncrement = _increment_initialized && ( microIncrement == _current_microIncrement );
+        bool repeatMacroIncrement = _increment_initialized && ( macroIncrement == _current_macroIncrement );
+
+        _microPrefetcher.beginIncrement( );
+        _macroPrefetcher.beginIncrement( );
+
         errorOut error = NULL;
+        error = setMicroDomainMembership( microIncrement );
+
+        if ( error ){
+            errorOut result = new errorNode( "initializeIncrement", "Error in setting the micro domain membership" );
+            result->addNext( error );
+            return result;
+        }
+
         error = setMicroNodeIndexMappings( microIncrement );
 
         if ( error ){
@@ -470,7 +631,7 @@ namespace inputFileProcessor{
             }
 
             //Extract the micro displacements
-            error = extractMicroDisplacements( previousMicroIncrement, tmpFlag, _previousMicroDisplacements );
+            error = extractMicroDisplacements( previousMicroIncrement, tmpFlag, "previous_displacement" );
     
             if ( error ){
                 errorOut result = new errorNode( "initializeIncrement", "Error in the extract of the previous micro velocities" );
@@ -479,7 +640,7 @@ namespace inputFileProcessor{
             }
     
             //Extract the micro velocities
-            error = extractMicroVelocities( previousMicroIncrement, tmpFlag, _previousMicroVelocities );
+            error = extractMicroVelocities( previousMicroIncrement, tmpFlag, "previous_velocity" );
     
             if ( error ){
                 errorOut result = new errorNode( "initializeIncrement", "Error in the extract of the previous micro velocities" );
@@ -488,7 +649,7 @@ namespace inputFileProcessor{
             }
     
             //Extract the micro accelerations
-            error = extractMicroAccelerations( previousMicroIncrement, tmpFlag, _previousMicroAccelerations );
+            error = extractMicroAccelerations( previousMicroIncrement, tmpFlag, "previous_acceleration" );
     
             if ( error ){
                 errorOut result = new errorNode( "initializeIncrement", "Error in the extract of the previous micro accelerations" );
@@ -594,7 +755,7 @@ namespace inputFileProcessor{
             _Dt = _microTime - _previousMicroTime;
     
             //Extract the macro displacements
-            error = extractMacroDispDOFVector( previousMacroIncrement, tmpFlag, _previousMacroDispDOFVector );
+            error = extractMacroDispDOFVector( previousMacroIncrement, tmpFlag, "previous_displacement_dof" );
         
             if ( error ){
                 errorOut result = new errorNode( "initializeIncrement", "Error in the extract of the previous macro displacements" );
@@ -603,7 +764,7 @@ namespace inputFileProcessor{
             }
         
             //Extract the macro velocities
-            error = extractMacroVelocities( previousMacroIncrement, tmpFlag, _previousMacroVelocities );
+            error = extractMacroVelocities( previousMacroIncrement, tmpFlag, "previous_velocity" );
         
             if ( error ){
                 errorOut result = new errorNode( "initializeIncrement", "Error in the extract of the previous macro velocities" );
@@ -612,7 +773,7 @@ namespace inputFileProcessor{
             }
         
             //Extract the macro accelerations
-            error = extractMacroAccelerations( previousMacroIncrement, tmpFlag, _previousMacroAccelerations );
+            error = extractMacroAccelerations( previousMacroIncrement, tmpFlag, "previous_acceleration" );
         
             if ( error ){
                 errorOut result = new errorNode( "initializeIncrement", "Error in the extract of the previous macro accelerations" );
@@ -691,6 +852,10 @@ namespace inputFileProcessor{
     
         }
 
+        //Read the data of the expected next increments while this increment is processed
+        _microPrefetcher.prefetch( microIncrement, repeatMicroIncrement ? microIncrement : microIncrement + 1 );
+        _macroPrefetcher.prefetch( macroIncrement, repeatMacroIncrement ? macroIncrement : macroIncrement + 1 );
+
         //Set the current increment
         _current_macroIncrement = macroIncrement;
         _current_microIncrement = microIncrement;
@@ -1286,14 +1451,12 @@ namespace inputFileProcessor{
         }
 
         //Initialize the size of the micro densities map
-        _microDensities.clear( );
-        _microDensities.reserve( _microGlobalNodeIDOutputIndex.size( ) );
 
         //Get the values of the micro densities from the output file
         floatVector values;
-        errorOut error = _microscale->getSolutionData( increment, 
-                                                       _config[ "microscale_definition" ][ "density_variable_name" ].as< std::string >( ),
-                                                       "Node", values );
+        errorOut error = _microPrefetcher.getSolutionData( increment,
+                                                           { _config[ "microscale_definition" ][ "density_variable_name" ].as< std::string >( ) },
+                                                           "Node", values );
 
         if ( error ){
 
@@ -1303,15 +1466,13 @@ namespace inputFileProcessor{
 
         }
 
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
-
-                return new errorNode( "extractMicroNodeDensities", "The density vector is too short for the required index" );
+        error = _microNodeFields.setField( "density", 1, std::move( values ) );
 
-            }
+        if ( error ){
 
-            _microDensities.emplace( n->first, values[ n->second ] );
+            errorOut result = new errorNode( "extractMicroNodeDensities", "Error in storing the micro density field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -1354,28 +1515,20 @@ namespace inputFileProcessor{
 
         if ( !_microBodyForceFlag ){
 
-            _microBodyForces.clear( );
+            _microNodeFields.clearField( "body_force" );
             return NULL;
 
         }
 
         floatType _sign = _config[ "coupling_initialization" ][ "micro_body_force_sign" ].as< floatType >( );
 
-        _microBodyForces.clear( );
-        _microBodyForces.reserve( _microGlobalNodeIDOutputIndex.size( ) );
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
-
-                return new errorNode( "extractMicroBodyForces", "The micro body force vector is too short for the required index" );
-
-            }
+        error = _microNodeFields.setField( "body_force", variableKeys.size( ), std::move( values ), _sign );
 
-            floatVector bf( values.begin( ) + variableKeys.size( ) * n->second,
-                            values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) );
-            bf *= _sign;
+        if ( error ){
 
-            _microBodyForces.emplace( n->first, bf );
+            errorOut result = new errorNode( "extractMicroBodyForces", "Error in storing the micro body force field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -1418,29 +1571,20 @@ namespace inputFileProcessor{
 
         if ( !_microSurfaceForceFlag ){
 
-            _microSurfaceForces.clear( );
+            _microNodeFields.clearField( "surface_force" );
             return NULL;
 
         }
 
         floatType _sign = _config[ "coupling_initialization" ][ "micro_surface_force_sign" ].as< floatType >( );
 
-        _microSurfaceForces.clear( );
-        _microSurfaceForces.reserve( _microGlobalNodeIDOutputIndex.size( ) );
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
-
-                return new errorNode( "extractMicroSurfaceForces",
-                                      "The micro surface forces vector is too short for the required index" );
-
-            }
+        error = _microNodeFields.setField( "surface_force", variableKeys.size( ), std::move( values ), _sign );
 
-            floatVector st( values.begin( ) + variableKeys.size( ) * n->second,
-                            values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) );
-            st *= _sign;
+        if ( error ){
 
-            _microSurfaceForces.emplace( n->first, st );
+            errorOut result = new errorNode( "extractMicroSurfaceForces", "Error in storing the micro surface force field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -1485,54 +1629,66 @@ namespace inputFileProcessor{
 
             if( _microSurfaceForceFlag && _microBodyForceFlag ){
 
-                _microExternalForces.clear( );
-                _microExternalForces.reserve( _microGlobalNodeIDOutputIndex.size( ) );
-                for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
+                _microExternalForceFlag = true;
+
+                error = _microNodeFields.setFieldFromSum( "external_force", { "surface_force", "body_force" } );
 
-                    _microExternalForces.emplace( n->first, _microSurfaceForces[ n->first ] + _microBodyForces[ n->first ] );
+                if ( error ){
+
+                    errorOut result = new errorNode( "extractMicroExternalForces", "Error in forming the micro external force field" );
+                    result->addNext( error );
+                    return result;
 
                 }
-                _microExternalForceFlag = true;
 
             }
             else if ( _microSurfaceForceFlag ){
 
-                _microExternalForces = _microSurfaceForces;
                 _microExternalForceFlag = true;
 
+                error = _microNodeFields.setFieldFromSum( "external_force", { "surface_force" } );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( "extractMicroExternalForces", "Error in forming the micro external force field" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
             }
             else if ( _microBodyForceFlag ){
 
-                _microExternalForces = _microBodyForces;
                 _microExternalForceFlag = true;
 
+                error = _microNodeFields.setFieldFromSum( "external_force", { "body_force" } );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( "extractMicroExternalForces", "Error in forming the micro external force field" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
             }
             else{
-                _microExternalForces.clear( );
+                _microNodeFields.clearField( "external_force" );
             }
 
         }
         else{
 
-            _microExternalForces.clear( );
-            _microExternalForces.reserve( _microGlobalNodeIDOutputIndex.size( ) );
             floatType _sign = _config[ "coupling_initialization" ][ "micro_external_force_sign" ].as< floatType >( );
 
-            for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-    
-                if ( n->second >= values.size( ) ){
-    
-                    return new errorNode( "extractMicroExternalForces",
-                                          "The micro external force vector is too short for the required index" );
-    
-                }
-    
-                floatVector ef( values.begin( ) + variableKeys.size( ) * n->second,
-                                values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) );
-                ef *= _sign;
-    
-                _microExternalForces.emplace( n->first, ef );
-    
+            error = _microNodeFields.setField( "external_force", variableKeys.size( ), std::move( values ), _sign );
+
+            if ( error ){
+
+                errorOut result = new errorNode( "extractMicroExternalForces", "Error in storing the micro external force field" );
+                result->addNext( error );
+                return result;
+
             }
 
         }
@@ -1548,7 +1704,7 @@ namespace inputFileProcessor{
          * :param const unsigned int &increment: The current increment
          */
 
-        errorOut error = extractMicroAccelerations( increment, _microAccelerationFlag, _microAccelerations );
+        errorOut error = extractMicroAccelerations( increment, _microAccelerationFlag, "acceleration" );
 
         if ( error ){
 
@@ -1564,13 +1720,13 @@ namespace inputFileProcessor{
     }
 
     errorOut inputFileProcessor::extractMicroAccelerations( const unsigned int &increment, bool &flag,
-                                                            std::unordered_map< uIntType, floatVector > &microAccelerations ){
+                                                            const std::string &fieldName ){
         /*!
          * Extract the node micro-accelerations at the indicated increment
          *
          * :param const unsigned int &increment: The increment at which to make the extraction
          * :param floatVector &flag: The flag to indicate if the accelerations were defined in the file
-         * :param std::unordered_map< uIntType, floatVector > &microAccelerations: The map to store the micro-accelerations in
+         * :param const std::string &fieldName: The name of the field in the node field container
          */
 
         stringVector variableKeys =
@@ -1601,24 +1757,19 @@ namespace inputFileProcessor{
 
         if ( !flag ){
 
-            microAccelerations.clear( );
+            _microNodeFields.clearField( fieldName );
+
             return NULL;
 
         }
 
-        microAccelerations.clear( );
-        microAccelerations.reserve( _microGlobalNodeIDOutputIndex.size( ) );
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
-
-                return new errorNode( "extractMicroVelocities",
-                                      "The micro velocity vector is too short for the required index" );
+        error = _microNodeFields.setField( fieldName, variableKeys.size( ), std::move( values ) );
 
-            }
+        if ( error ){
 
-            microAccelerations.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                               values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
+            errorOut result = new errorNode( "extractMicroAccelerations", "Error in storing the micro field '" + fieldName + "'" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -1635,7 +1786,7 @@ namespace inputFileProcessor{
          * :param const unsigned int &increment: The current increment
          */
 
-        errorOut error = extractMicroVelocities( increment, _microVelocityFlag, _microVelocities );
+        errorOut error = extractMicroVelocities( increment, _microVelocityFlag, "velocity" );
 
         if ( error ){
 
@@ -1651,7 +1802,7 @@ namespace inputFileProcessor{
     }
 
     errorOut inputFileProcessor::extractMicroVelocities( const unsigned int &increment, bool &flag,
-                                                         std::unordered_map< uIntType, floatVector > &microVelocities ){
+                                                         const std::string &fieldName ){
         /*!
          * Extract the node micro-velocities at the indicated increment
          *
@@ -1659,7 +1810,7 @@ namespace inputFileProcessor{
          *
          * :param const unsigned int &increment: The current increment
          * :param bool &flag: The flag to indicate if the values are defined in the input file
-         * :param std::unordered_map< uIntType, floatVector > &microVelocities: The map to store the velocities in
+         * :param const std::string &fieldName: The name of the field in the node field container
          */
 
         stringVector variableKeys =
@@ -1690,24 +1841,19 @@ namespace inputFileProcessor{
 
         if ( !flag ){
 
-            microVelocities.clear( );
+            _microNodeFields.clearField( fieldName );
+
             return NULL;
 
         }
 
-        microVelocities.clear( );
-        microVelocities.reserve( _microGlobalNodeIDOutputIndex.size( ) );
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
-
-                return new errorNode( "extractMicroVelocities",
-                                      "The micro velocity vector is too short for the required index" );
+        error = _microNodeFields.setField( fieldName, variableKeys.size( ), std::move( values ) );
 
-            }
+        if ( error ){
 
-            microVelocities.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                            values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
+            errorOut result = new errorNode( "extractMicroVelocities", "Error in storing the micro field '" + fieldName + "'" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -1722,7 +1868,7 @@ namespace inputFileProcessor{
          * :param const unsigned int &increment: The current increment
          */
 
-        errorOut error = extractMacroVelocities( increment, _macroVelocityFlag, _macroVelocities );
+        errorOut error = extractMacroVelocities( increment, _macroVelocityFlag, "velocity" );
 
         if ( error ){
 
@@ -1738,13 +1884,13 @@ namespace inputFileProcessor{
     }
 
     errorOut inputFileProcessor::extractMacroVelocities( const unsigned int &increment, bool &flag,
-                                                         std::unordered_map< uIntType, floatVector > &macroVelocities ){
+                                                         const std::string &fieldName ){
         /*!
          * Extract the node macro-velocities at the indicated increment
          *
          * :param const unsigned int &increment: The current increment
          * :param bool &flag: The flag indicating if the values are defined in the file
-         * :param std::unordered_map< uIntType, floatVector > &macroVelocities: The map to store the values in
+         * :param const std::string &fieldName: The name of the field in the node field container
          */
 
         stringVector variableKeys =
@@ -1778,28 +1924,23 @@ namespace inputFileProcessor{
 
         if ( !flag ){
 
-            _macroVelocities.clear( );
+            _macroNodeFields.clearField( fieldName );
+
             return NULL;
 
         }
         else{
 
-            macroVelocities.clear( );
-            macroVelocities.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
-            for ( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
-
-                if ( n->second > values.size( ) ){
 
-                    return new errorNode( "extractMacroVelocities",
-                                          "The values vector is too small for the index required by micro node " +
-                                          std::to_string( n->first ) );
+        }
 
-                }
+        error = _macroNodeFields.setField( fieldName, variableKeys.size( ), std::move( values ) );
 
-                macroVelocities.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                                values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
+        if ( error ){
 
-            }
+            errorOut result = new errorNode( "extractMacroVelocities", "Error in storing the macro field '" + fieldName + "'" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -1807,7 +1948,6 @@ namespace inputFileProcessor{
 
     }
 
-
     errorOut inputFileProcessor::extractMacroAccelerations( const unsigned int &increment ){
         /*!
          * Extract the node macro-accelerations at the indicated increment
@@ -1815,7 +1955,7 @@ namespace inputFileProcessor{
          * :param const unsigned int &increment: The current increment
          */
 
-        errorOut error = extractMacroAccelerations( increment, _macroAccelerationFlag, _macroAccelerations );
+        errorOut error = extractMacroAccelerations( increment, _macroAccelerationFlag, "acceleration" );
 
         if ( error ){
 
@@ -1831,13 +1971,13 @@ namespace inputFileProcessor{
     }
 
     errorOut inputFileProcessor::extractMacroAccelerations( const unsigned int &increment, bool &flag,
-                                                            std::unordered_map< uIntType, floatVector > &macroAccelerations ){
+                                                            const std::string &fieldName ){
         /*!
          * Extract the node macro-accelerations at the indicated increment
          *
          * :param const unsigned int &increment: The current increment
          * :param bool &flag: The flag indicating if the values are defined in the file
-         * :param std::unordered_map< uIntType, floatVector > &macroAccelerations: The vector to store the values in
+         * :param const std::string &fieldName: The name of the field in the node field container
          */
 
         stringVector variableKeys =
@@ -1871,25 +2011,19 @@ namespace inputFileProcessor{
 
         if ( !flag ){
 
-            macroAccelerations.clear( );
+            _macroNodeFields.clearField( fieldName );
+
             return NULL;
 
         }
 
-        macroAccelerations.clear( );
-        macroAccelerations.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
-        for ( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
-
-                return new errorNode( "extractMacroAccelerations",
-                                      "The values vector is too small for the index required by micro-node " +
-                                      std::to_string( n->first ) );
+        error = _macroNodeFields.setField( fieldName, variableKeys.size( ), std::move( values ) );
 
-            }
+        if ( error ){
 
-            macroAccelerations.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                               values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
+            errorOut result = new errorNode( "extractMacroAccelerations", "Error in storing the macro field '" + fieldName + "'" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -1935,26 +2069,20 @@ namespace inputFileProcessor{
 
         if ( !_macroInternalForceFlag ){
 
-            _macroInternalForces.clear( );
+            _macroNodeFields.clearField( "internal_force" );
             return NULL;
 
         }
 
-        _macroInternalForces.clear( );
-        _macroInternalForces.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
         floatType _sign = _config[ "coupling_initialization" ][ "macro_internal_force_sign" ].as< floatType >( );
-        for( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
 
-                return new errorNode( "extractMacroInternalForces",
-                                      "The index required by macro node " + std::to_string( n->first ) + " is too large for the values vector" );
+        error = _macroNodeFields.setField( "internal_force", variableKeys.size( ), std::move( values ), _sign );
 
-            }
+        if ( error ){
 
-            _macroInternalForces.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                                 values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
-            _macroInternalForces[ n->first ] *= _sign;
+            errorOut result = new errorNode( "extractMacroInternalForces", "Error in storing the macro internal force field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -2000,26 +2128,20 @@ namespace inputFileProcessor{
 
         if ( !_macroBodyForceFlag ){
 
-            _macroBodyForces.clear( );
+            _macroNodeFields.clearField( "body_force" );
             return NULL;
 
         }
 
-        _macroBodyForces.clear( );
-        _macroBodyForces.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
         floatType _sign = _config[ "coupling_initialization" ][ "macro_body_force_sign" ].as< floatType >( );
-        for( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
 
-                return new errorNode( "extractMacroBodyForces",
-                                      "The index required by macro node " + std::to_string( n->first ) + " is too large for the values vector" );
+        error = _macroNodeFields.setField( "body_force", variableKeys.size( ), std::move( values ), _sign );
 
-            }
+        if ( error ){
 
-            _macroBodyForces.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                             values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
-            _macroBodyForces[ n->first ] *= _sign;
+            errorOut result = new errorNode( "extractMacroBodyForces", "Error in storing the macro body force field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -2065,26 +2187,20 @@ namespace inputFileProcessor{
 
         if ( !_macroSurfaceForceFlag ){
 
-            _macroSurfaceForces.clear( );
+            _macroNodeFields.clearField( "surface_force" );
             return NULL;
 
         }
 
-        _macroSurfaceForces.clear( );
-        _macroSurfaceForces.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
         floatType _sign = _config[ "coupling_initialization" ][ "macro_surface_force_sign" ].as< floatType >( );
-        for( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
 
-                return new errorNode( "extractMacroSurfaceForces",
-                                      "The index required by macro node " + std::to_string( n->first ) + " is too large for the values vector" );
+        error = _macroNodeFields.setField( "surface_force", variableKeys.size( ), std::move( values ), _sign );
 
-            }
+        if ( error ){
 
-            _macroSurfaceForces.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                                values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
-            _macroSurfaceForces[ n->first ] *= _sign;
+            errorOut result = new errorNode( "extractMacroSurfaceForces", "Error in storing the macro surface force field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -2132,54 +2248,66 @@ namespace inputFileProcessor{
 
             if( _macroSurfaceForceFlag && _macroBodyForceFlag ){
 
-                _macroExternalForces.clear( );
-                _macroExternalForces.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
-                for ( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
+                _macroExternalForceFlag = true;
+
+                error = _macroNodeFields.setFieldFromSum( "external_force", { "surface_force", "body_force" } );
 
-                    _macroExternalForces.emplace( n->first, _macroSurfaceForces[ n->first ] + _macroBodyForces[ n->first ] );
+                if ( error ){
+
+                    errorOut result = new errorNode( "extractMacroExternalForces", "Error in forming the macro external force field" );
+                    result->addNext( error );
+                    return result;
 
                 }
-                _macroExternalForceFlag = true;
 
             }
             else if ( _macroSurfaceForceFlag ){
 
-                _macroExternalForces = _macroSurfaceForces;
                 _macroExternalForceFlag = true;
 
+                error = _macroNodeFields.setFieldFromSum( "external_force", { "surface_force" } );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( "extractMacroExternalForces", "Error in forming the macro external force field" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
             }
             else if ( _macroBodyForceFlag ){
 
-                _macroExternalForces = _macroBodyForces;
                 _macroExternalForceFlag = true;
 
+                error = _macroNodeFields.setFieldFromSum( "external_force", { "body_force" } );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( "extractMacroExternalForces", "Error in forming the macro external force field" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
             }
             else{
-                _macroExternalForces.clear( );
+                _macroNodeFields.clearField( "external_force" );
             }
 
         }
         else{
 
-            _macroExternalForces.clear( );
-            _macroExternalForces.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
             floatType _sign = _config[ "coupling_initialization" ][ "macro_external_force_sign" ].as< floatType >( );
 
-            for ( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
-    
-                if ( n->second >= values.size( ) ){
-    
-                    return new errorNode( "extractMacroExternalForces",
-                                          "The macro external force vector is too short for the required index" );
-    
-                }
-    
-                floatVector ef( values.begin( ) + variableKeys.size( ) * n->second,
-                                values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) );
-                ef *= _sign;
-    
-                _macroExternalForces.emplace( n->first, ef );
-    
+            error = _macroNodeFields.setField( "external_force", variableKeys.size( ), std::move( values ), _sign );
+
+            if ( error ){
+
+                errorOut result = new errorNode( "extractMacroExternalForces", "Error in storing the macro external force field" );
+                result->addNext( error );
+                return result;
+
             }
 
         }
@@ -2226,27 +2354,20 @@ namespace inputFileProcessor{
 
         if ( !_macroInertialForceFlag ){
 
-            _macroInertialForces.clear( );
+            _macroNodeFields.clearField( "inertial_force" );
             return NULL;
 
         }
 
         floatType _sign = _config[ "coupling_initialization" ][ "macro_inertial_force_sign" ].as< floatType >( );
-        _macroInertialForces.clear( );
-        _macroInertialForces.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
-        for ( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
 
-                return new errorNode( "extractMacroInertialForces",
-                                      "The index required for macro node " + std::to_string( n->first ) +
-                                      " is too large for the values vector" );
+        error = _macroNodeFields.setField( "inertial_force", variableKeys.size( ), std::move( values ), _sign );
 
-            }
+        if ( error ){
 
-            _macroInertialForces.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                                 values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
-            _macroInertialForces[ n->first ] *= _sign;
+            errorOut result = new errorNode( "extractMacroInertialForces", "Error in storing the macro inertial force field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -2457,9 +2578,20 @@ namespace inputFileProcessor{
 
         }
 
-        //Extract the velocity vector
-        errorOut error = dataFile->getSolutionVectorDataFromComponents( increment, variableNames,
-                                                                        dataType, properties );
+        //Extract the velocity vector. The data files of the processor are read through their read-ahead store.
+        errorOut error = NULL;
+        solutionDataPrefetcher *prefetcher = getSolutionDataPrefetcher( dataFile );
+
+        if ( prefetcher ){
+
+            error = prefetcher->getSolutionData( increment, variableNames, dataType, properties );
+
+        }
+        else{
+
+            error = dataFile->getSolutionVectorDataFromComponents( increment, variableNames, dataType, properties );
+
+        }
 
         if ( error ){
 
@@ -2509,19 +2641,13 @@ namespace inputFileProcessor{
 
         }
 
-        _microStresses.clear( );
-        _microStresses.reserve( _microGlobalNodeIDOutputIndex.size( ) );
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
-
-                return new errorNode( "extractMicroVelocities",
-                                      "The micro stress vector is too short for the required index" );
+        error = _microNodeFields.setField( "stress", variableKeys.size( ), std::move( values ) );
 
-            }
+        if ( error ){
 
-            _microStresses.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                           values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
+            errorOut result = new errorNode( "extractMicroStresses", "Error in storing the micro stress field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -2564,27 +2690,20 @@ namespace inputFileProcessor{
 
         if ( !_microInternalForceFlag ){
 
-            _microInternalForces.clear( );
+            _microNodeFields.clearField( "internal_force" );
             return NULL;
 
         }
 
-
-        _microInternalForces.clear( );
-        _microInternalForces.reserve( _microGlobalNodeIDOutputIndex.size( ) );
         floatType _sign = _config[ "coupling_initialization" ][ "micro_internal_force_sign" ].as< floatType >( );
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
 
-                return new errorNode( "extractMicroVelocities",
-                                      "The micro internal force vector is too short for the required index" );
+        error = _microNodeFields.setField( "internal_force", variableKeys.size( ), std::move( values ), _sign );
 
-            }
+        if ( error ){
 
-            _microInternalForces.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                                 values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
-            _microInternalForces[ n->first ] *= _sign;
+            errorOut result = new errorNode( "extractMicroInternalForces", "Error in storing the micro internal force field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -2626,36 +2745,26 @@ namespace inputFileProcessor{
 
         if ( !_microInertialForceFlag ){
 
-            _microInertialForces.clear( );
+            _microNodeFields.clearField( "inertial_force" );
             return NULL;
 
         }
 
-
-        _microInertialForces.clear( );
-        _microInertialForces.reserve( _microGlobalNodeIDOutputIndex.size( ) );
         floatType _sign = _config[ "coupling_initialization" ][ "micro_inertial_force_sign" ].as< floatType >( );
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
 
-                return new errorNode( "extractMicroVelocities",
-                                      "The micro inertial force vector is too short for the required index" );
-
-            }
+        error = _microNodeFields.setField( "inertial_force", variableKeys.size( ), std::move( values ), _sign );
 
+        if ( error ){
 
-            _microInertialForces.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                                 values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
-            _microInertialForces[ n->first ] *= _sign;
+            errorOut result = new errorNode( "extractMicroInertialForces", "Error in storing the micro inertial force field" );
+            result->addNext( error );
+            return result;
 
         }
 
-
         return NULL;
     }
 
-
     errorOut inputFileProcessor::extractMicroNodeVolumes( const unsigned int &increment ){
         /*!
          * Extract the node volumes for the micro domain at the indicated increment
@@ -2671,14 +2780,12 @@ namespace inputFileProcessor{
         }
 
         //Initialize the size of the micro volumes map
-        _microVolumes.clear( );
-        _microVolumes.reserve( _microGlobalNodeIDOutputIndex.size( ) );
 
         //Get the values of the micro volumes from the output file
         floatVector values;
-        errorOut error = _microscale->getSolutionData( increment,
-                                                       _config[ "microscale_definition" ][ "volume_variable_name" ].as< std::string >( ),
-                                                       "Node", values );
+        errorOut error = _microPrefetcher.getSolutionData( increment,
+                                                           { _config[ "microscale_definition" ][ "volume_variable_name" ].as< std::string >( ) },
+                                                           "Node", values );
 
         if ( error ){
 
@@ -2688,15 +2795,13 @@ namespace inputFileProcessor{
 
         }
 
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
-
-                return new errorNode( "extractMicroNodeVolumes", "The volume vector is too short for the required index" );
+        error = _microNodeFields.setField( "volume", 1, std::move( values ) );
 
-            }
+        if ( error ){
 
-            _microVolumes.emplace( n->first, values[ n->second ] );
+            errorOut result = new errorNode( "extractMicroNodeVolumes", "Error in storing the micro volume field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -2727,9 +2832,9 @@ namespace inputFileProcessor{
 
         if ( !_isFiltering ){
 
-            errorOut error = _macroscale->getSolutionData( increment,
-                                                           _config[ "coupling_initialization" ][ "arlequin_weighting_variable_name" ].as< std::string >( ),
-                                                           "Node", values );
+            errorOut error = _macroPrefetcher.getSolutionData( increment,
+                                                               { _config[ "coupling_initialization" ][ "arlequin_weighting_variable_name" ].as< std::string >( ) },
+                                                               "Node", values );
     
             if ( error ){
     
@@ -2777,7 +2882,7 @@ namespace inputFileProcessor{
 
         bool flag;
 
-        errorOut error = extractMicroDisplacements( increment, flag, _microDisplacements );
+        errorOut error = extractMicroDisplacements( increment, flag, "displacement" );
 
         if ( error ){
 
@@ -2793,7 +2898,7 @@ namespace inputFileProcessor{
     }
 
     errorOut inputFileProcessor::extractMicroDisplacements( const unsigned int &increment, bool &flag,
-                                                            std::unordered_map< uIntType, floatVector > &microDisplacements ){
+                                                            const std::string &fieldName ){
         /*!
          * Extract the node micro-displacements at the indicated increment
          *
@@ -2801,7 +2906,7 @@ namespace inputFileProcessor{
          *
          * :param const unsigned int &increment: The current increment
          * :param bool &flag: The flag to indicate if the values are defined in the input file
-         * :param std::unordered_map< uIntType, floatVector > &microDisplacements: The map to store the displacements in
+         * :param const std::string &fieldName: The name of the field in the node field container
          */
 
         stringVector variableKeys =
@@ -2830,20 +2935,13 @@ namespace inputFileProcessor{
 
         }
 
-        microDisplacements.clear( );
-        microDisplacements.reserve( _microGlobalNodeIDOutputIndex.size( ) );
-
-        for ( auto n = _microGlobalNodeIDOutputIndex.begin( ); n != _microGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( n->second >= values.size( ) ){
-
-                return new errorNode( "extractMicroDisplacements",
-                                      "The displacement vector is too short for the required index" );
+        error = _microNodeFields.setField( fieldName, variableKeys.size( ), std::move( values ) );
 
-            }
+        if ( error ){
 
-            microDisplacements.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                               values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
+            errorOut result = new errorNode( "extractMicroDisplacements", "Error in storing the micro field '" + fieldName + "'" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -2889,29 +2987,20 @@ namespace inputFileProcessor{
     
             }
         }
+        else{
 
-        _macroDisplacements.clear( );
-        _macroDisplacements.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
-
-        for ( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( _isFiltering ){
+            //The macro displacements are zero when filtering
+            values = floatVector( variableKeys.size( ) * _macroNodeFields.getNodeCount( ), 0 );
 
-                _macroDisplacements.emplace( n->first, floatVector( variableKeys.size( ), 0 ) );
+        }
 
-            }
-            else{
+        errorOut error = _macroNodeFields.setField( "displacement", variableKeys.size( ), std::move( values ) );
 
-                if ( n->second >= values.size( ) ){
-    
-                    return new errorNode( "extractMacroDisplacements",
-                                          "The outputDOF vector is too short for the required index" );
-    
-                }
+        if ( error ){
 
-                _macroDisplacements.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                                    values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
-            }
+            errorOut result = new errorNode( "extractMacroDisplacements", "Error in storing the macro displacement field" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -2927,7 +3016,7 @@ namespace inputFileProcessor{
          */
 
         bool flag;
-        errorOut error = extractMacroDispDOFVector( increment, flag, _macroDispDOFVector );
+        errorOut error = extractMacroDispDOFVector( increment, flag, "displacement_dof" );
 
         if ( error ){
 
@@ -2942,7 +3031,8 @@ namespace inputFileProcessor{
 
     }
 
-    errorOut inputFileProcessor::extractMacroDispDOFVector( const unsigned int &increment, bool &flag, std::unordered_map< uIntType, floatVector > &macroDispDOFVector ){
+    errorOut inputFileProcessor::extractMacroDispDOFVector( const unsigned int &increment, bool &flag,
+                                                            const std::string &fieldName ){
         /*!
          * Extract the displacement degrees of freedom of the nodes in the macro domain.
          *
@@ -2950,7 +3040,7 @@ namespace inputFileProcessor{
          *
          * :param const unsigned int &increment: The current increment
          * :param bool &flag: The flag to indicate if the values are defined in the input file
-         * :param std::unordered_map< uIntType, floatVector > &microDispDOFVector: The vector to store the displacements DOF vector in
+         * :param const std::string &fieldName: The name of the field in the node field container
          */
         stringVector variableKeys =
             {
@@ -2985,29 +3075,20 @@ namespace inputFileProcessor{
 
         }
 
-        macroDispDOFVector.clear( );
-        macroDispDOFVector.reserve( _macroGlobalNodeIDOutputIndex.size( ) );
-
-        for ( auto n = _macroGlobalNodeIDOutputIndex.begin( ); n != _macroGlobalNodeIDOutputIndex.end( ); n++ ){
-
-            if ( _isFiltering ){
+        if ( _isFiltering ){
 
-                macroDispDOFVector.emplace( n->first, floatVector( variableKeys.size( ), 0 ) );
+            //The macro degrees of freedom are zero when filtering
+            values = floatVector( variableKeys.size( ) * _macroNodeFields.getNodeCount( ), 0 );
 
-            }
-            else{
+        }
 
-                if ( n->second >= values.size( ) ){
-    
-                    return new errorNode( "extractMacroDispDOFVector",
-                                          "The DOF vector is too short for the required index" );
-    
-                }
+        errorOut error = _macroNodeFields.setField( fieldName, variableKeys.size( ), std::move( values ) );
 
-                macroDispDOFVector.emplace( n->first, floatVector( values.begin( ) + variableKeys.size( ) * n->second,
-                                                                   values.begin( ) + variableKeys.size( ) * ( n->second + 1 ) ) );
+        if ( error ){
 
-            }
+            errorOut result = new errorNode( "extractMacroDispDOFVector", "Error in storing the macro field '" + fieldName + "'" );
+            result->addNext( error );
+            return result;
 
         }
 
@@ -3201,67 +3282,140 @@ namespace inputFileProcessor{
 
     }
 
+    const nodeFieldContainer* inputFileProcessor::getMicroNodeFields( ){
+        /*!
+         * Get a pointer to the contiguous storage of the micro node fields
+         */
+
+        return &_microNodeFields;
+    }
+
+    const nodeFieldContainer* inputFileProcessor::getMacroNodeFields( ){
+        /*!
+         * Get a pointer to the contiguous storage of the macro node fields
+         */
+
+        return &_macroNodeFields;
+    }
+
+    std::string inputFileProcessor::getPreviousFieldName( const std::string &fieldName ){
+        /*!
+         * Get the name of the node field which stores the previous values of a degree of freedom field
+         *
+         * If extraction of the previous values was not requested, the name of the current field will be returned
+         *
+         * :param const std::string &fieldName: The name of the current field e.g. displacement_dof
+         */
+
+        if ( _extractPreviousDOFValues ){
+
+            return "previous_" + fieldName;
+
+        }
+
+        return fieldName;
+
+    }
+
+    const std::unordered_map< std::string, uIntType >* inputFileProcessor::getMicroDomainMembershipIndex( ){
+        /*!
+         * Get the map from the micro domain names to their rows in the domain membership offsets
+         */
+
+        return &_microDomainMembershipIndex;
+    }
+
+    const uIntVector* inputFileProcessor::getMicroDomainMembershipOffsets( ){
+        /*!
+         * Get the offsets of each micro domain in the domain membership nodes
+         */
+
+        return &_microDomainMembershipOffsets;
+    }
+
+    const uIntVector* inputFileProcessor::getMicroDomainMembershipNodes( ){
+        /*!
+         * Get the nodes of the micro domains stored in the order of the domain membership offsets
+         */
+
+        return &_microDomainMembershipNodes;
+    }
+
     const std::unordered_map< uIntType, floatType >* inputFileProcessor::getMicroDensities( ){
         /*!
          * Get a pointer to the density
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microDensities;
+        return _microNodeFields.getScalarNodeMap( "density" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroBodyForces( ){
         /*!
          * Get a pointer to the micro body forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microBodyForces;
+        return _microNodeFields.getNodeMap( "body_force" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroSurfaceForces( ){
         /*!
          * Get a pointer to the micro surface forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microSurfaceForces;
+        return _microNodeFields.getNodeMap( "surface_force" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroExternalForces( ){
         /*!
          * Get a pointer to the micro body forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microExternalForces;
+        return _microNodeFields.getNodeMap( "external_force" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroVelocities( ){
         /*!
          * Get a pointer to the micro velocities
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microVelocities;
+        return _microNodeFields.getNodeMap( "velocity" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroAccelerations( ){
         /*!
          * Get a pointer to the micro accelerations
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microAccelerations;
+        return _microNodeFields.getNodeMap( "acceleration" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getPreviousMicroDisplacements( ){
         /*!
          * Get a pointer to the previous micro displacements
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
         if ( _extractPreviousDOFValues ){
 
-            return &_previousMicroDisplacements;
+            return _microNodeFields.getNodeMap( "previous_displacement" );
 
         }
         else{
 
-            return &_microDisplacements;
+            return _microNodeFields.getNodeMap( "displacement" );
 
         }
     }
@@ -3269,16 +3423,18 @@ namespace inputFileProcessor{
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getPreviousMicroVelocities( ){
         /*!
          * Get a pointer to the previous micro velocities
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
         if ( _extractPreviousDOFValues ){
 
-            return &_previousMicroVelocities;
+            return _microNodeFields.getNodeMap( "previous_velocity" );
 
         }
         else{
 
-            return &_microVelocities;
+            return _microNodeFields.getNodeMap( "velocity" );
 
         }
     }
@@ -3286,16 +3442,18 @@ namespace inputFileProcessor{
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getPreviousMicroAccelerations( ){
         /*!
          * Get a pointer to the micro accelerations
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
         if ( _extractPreviousDOFValues ){
 
-            return &_previousMicroAccelerations;
+            return _microNodeFields.getNodeMap( "previous_acceleration" );
 
         }
         else{
 
-            return &_microAccelerations;
+            return _microNodeFields.getNodeMap( "acceleration" );
 
         }
     }
@@ -3303,33 +3461,41 @@ namespace inputFileProcessor{
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroStresses( ){
         /*!
          * Get a pointer to the micro stresses
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microStresses;
+        return _microNodeFields.getNodeMap( "stress" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroInternalForces( ){
         /*!
          * Get a pointer to the micro internal forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microInternalForces;
+        return _microNodeFields.getNodeMap( "internal_force" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroInertialForces( ){
         /*!
          * Get a pointer to the micro inertial forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microInertialForces;
+        return _microNodeFields.getNodeMap( "inertial_force" );
     }
 
     const std::unordered_map< uIntType, floatType >* inputFileProcessor::getMicroVolumes( ){
         /*!
          * Get a pointer to the volumes
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microVolumes;
+        return _microNodeFields.getScalarNodeMap( "volume" );
     }
 
     const std::unordered_map< uIntType, floatType >* inputFileProcessor::getMicroWeights( ){
@@ -3428,6 +3594,51 @@ namespace inputFileProcessor{
          * Check the coupling initialization
          */
 
+        if ( !_config[ "coupling_initialization" ][ "logging" ] ){
+
+            _config[ "coupling_initialization" ][ "logging" ][ "level" ] = "info";
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "logging" ][ "level" ] ){
+
+            _config[ "coupling_initialization" ][ "logging" ][ "level" ] = "info";
+
+        }
+
+        std::string logLevelName = _config[ "coupling_initialization" ][ "logging" ][ "level" ].as< std::string >( );
+        auto level = logLevels.find( logLevelName );
+
+        if ( level == logLevels.end( ) ){
+
+            return new errorNode( "checkCouplingInitialization",
+                                  "'logging' level " + logLevelName + " not recognized. Options are 'none', 'error', 'warning', 'info', and 'debug'" );
+
+        }
+
+        _logger.setLevel( level->second );
+
+        if ( !_config[ "coupling_initialization" ][ "logging" ][ "debug_file_format" ] ){
+
+            _config[ "coupling_initialization" ][ "logging" ][ "debug_file_format" ] = "csv";
+
+        }
+
+        if ( _config[ "coupling_initialization" ][ "logging" ][ "debug_file" ] ){
+
+            errorOut error = _logger.openDebugFile( _config[ "coupling_initialization" ][ "logging" ][ "debug_file" ].as< std::string >( ),
+                                                    _config[ "coupling_initialization" ][ "logging" ][ "debug_file_format" ].as< std::string >( ) );
+
+            if ( error ){
+
+                errorOut result = new errorNode( "checkCouplingInitialization", "Error in opening the logging debug file" );
+                result->addNext( error );
+                return result;
+
+            }
+
+        }
+
         if ( !_config[ "coupling_initialization" ][ "type" ] ){
 
             _config[ "coupling_initialization" ][ "type" ] = "use_first_increment";
@@ -3448,11 +3659,11 @@ namespace inputFileProcessor{
 
         if ( _config[ "coupling_initialization" ][ "projection_type" ].as< std::string >( ).compare( "direct_projection" ) == 0 ){
 
-            std::cerr << "WARNING: direct_projection can give unexpected results.\n";
-            std::cerr << "         It is suggested that either l2_projection or\n"; 
-            std::cerr << "         averaged_l2_projection ( recommended ) are used\n";
-            std::cerr << "         for small problems and arlequin is used for large\n";
-            std::cerr << "         problems.\n";
+            COUPLING_LOG( _logger, LOG_WARNING ) << "WARNING: direct_projection can give unexpected results.\n"
+                                                 << "         It is suggested that either l2_projection or\n"
+                                                 << "         averaged_l2_projection ( recommended ) are used\n"
+                                                 << "         for small problems and arlequin is used for large\n"
+                                                 << "         problems.\n";
 
         }
 
@@ -3499,203 +3710,422 @@ namespace inputFileProcessor{
 
         }
 
-        if ( !_config [ "coupling_initialization" ][ "potential_energy_weighting_factor" ] ){
-
-            _config[ "coupling_initialization" ][ "potential_energy_weighting_factor" ] = 0.5; //Default to 0.5
-
-        }
+        _useReconstructedMassCenters = _config[ "coupling_initialization" ][ "use_reconstructed_mass_centers" ].as< bool >( );
 
-        if ( !_config[ "coupling_initialization" ][ "potential_energy_partitioning_coefficient" ] ){
+        if ( !_config[ "coupling_initialization" ][ "revalidate_domain_membership" ] ){
 
-            _config[ "coupling_initialization" ][ "potential_energy_partitioning_coefficient" ][ "type" ] = "volume_fraction"; //Default to volume fraction
+            _config[ "coupling_initialization" ][ "revalidate_domain_membership" ] = false;
 
         }
 
-        if ( !_config [ "coupling_initialization" ][ "kinetic_energy_weighting_factor" ] ){
+        _revalidateMicroDomainMembership = _config[ "coupling_initialization" ][ "revalidate_domain_membership" ].as< bool >( );
 
-            _config[ "coupling_initialization" ][ "kinetic_energy_weighting_factor" ] = 0.5; //Default to 0.5
+        if ( !_config[ "coupling_initialization" ][ "homogenization_thread_count" ] ){
+
+            _config[ "coupling_initialization" ][ "homogenization_thread_count" ] = 1;
 
         }
 
-        if ( !_config[ "coupling_initialization" ][ "kinetic_energy_partitioning_coefficient" ] ){
+        try{
 
-            _config[ "coupling_initialization" ][ "kinetic_energy_partitioning_coefficient" ][ "type" ] = "volume_fraction"; //Default to volume fraction
+            int threadCount = _config[ "coupling_initialization" ][ "homogenization_thread_count" ].as< int >( );
 
-        }
+            if ( threadCount < 0 ){
 
-        if ( !_config[ "coupling_initialization" ][ "macro_proportionality_coefficient" ] ){
+                return new errorNode( "checkCouplingInitialization", "'homogenization_thread_count' must be zero or a positive integer" );
 
-            _config[ "coupling_initialization" ][ "macro_proportionality_coefficient" ] = 1e-3; //Default to 1e-3
+            }
 
-        }
+            _homogenizationThreadCount = ( uIntType )threadCount;
 
-        if ( !_config[ "coupling_initialization" ][ "micro_proportionality_coefficient" ] ){
+        }
+        catch( ... ){
 
-            _config[ "coupling_initialization" ][ "micro_proportionality_coefficient" ] = 1e-3; //Default to 1e-3
+            return new errorNode( "checkCouplingInitialization", "'homogenization_thread_count' must be an integer" );
 
         }
 
-        if ( !_config[ "coupling_initialization" ][ "macro_internal_force_sign" ] ){
+        if ( _homogenizationThreadCount == 0 ){
 
-            _config[ "coupling_initialization" ][ "macro_internal_force_sign" ] = -1; //Default to -1 to be consistent with the micromorphic implementation
+            //Use all of the available hardware threads
+            _homogenizationThreadCount = std::max( std::thread::hardware_concurrency( ), ( unsigned int )1 );
 
         }
 
-        if ( !_config[ "coupling_initialization" ][ "macro_inertial_force_sign" ] ){
+        if ( !_config[ "coupling_initialization" ][ "output_queue_size" ] ){
 
-            _config[ "coupling_initialization" ][ "macro_inertial_force_sign" ] = 1; //Default to 1
+            _config[ "coupling_initialization" ][ "output_queue_size" ] = 0;
 
         }
 
-        if ( !_config[ "coupling_initialization" ][ "macro_body_force_sign" ] ){
+        try{
 
-            _config[ "coupling_initialization" ][ "macro_body_force_sign" ] = 1; //Default to 1
+            int queueSize = _config[ "coupling_initialization" ][ "output_queue_size" ].as< int >( );
 
-        }
+            if ( queueSize < 0 ){
 
-        if ( !_config[ "coupling_initialization" ][ "macro_surface_force_sign" ] ){
+                return new errorNode( "checkCouplingInitialization", "'output_queue_size' must be zero or a positive integer" );
 
-            _config[ "coupling_initialization" ][ "macro_surface_force_sign" ] = 1; //Default to 1
+            }
 
-        }
+            _outputQueueSize = ( uIntType )queueSize;
 
-        if ( !_config[ "coupling_initialization" ][ "macro_external_force_sign" ] ){
+        }
+        catch( ... ){
 
-            _config[ "coupling_initialization" ][ "macro_external_force_sign" ] = 1; //Default to 1
+            return new errorNode( "checkCouplingInitialization", "'output_queue_size' must be an integer" );
 
         }
 
-        if ( !_config[ "coupling_initialization" ][ "micro_internal_force_sign" ] ){
+        if ( !_config[ "coupling_initialization" ][ "prefetch_next_increment" ] ){
 
-            _config[ "coupling_initialization" ][ "micro_internal_force_sign" ] = 1; //Default to 1
+            _config[ "coupling_initialization" ][ "prefetch_next_increment" ] = false;
 
         }
 
-        if ( !_config[ "coupling_initialization" ][ "micro_inertial_force_sign" ] ){
+        try{
 
-            _config[ "coupling_initialization" ][ "micro_inertial_force_sign" ] = 1; //Default to 1
+            bool prefetch = _config[ "coupling_initialization" ][ "prefetch_next_increment" ].as< bool >( );
 
-        }
+            _microPrefetcher.setEnabled( prefetch );
+            _macroPrefetcher.setEnabled( prefetch );
 
-        if ( !_config[ "coupling_initialization" ][ "micro_body_force_sign" ] ){
+        }
+        catch( ... ){
 
-            _config[ "coupling_initialization" ][ "micro_body_force_sign" ] = 1; //Default to 1
+            return new errorNode( "checkCouplingInitialization", "'prefetch_next_increment' must be a boolean" );
 
         }
 
-        if ( !_config[ "coupling_initialization" ][ "micro_surface_force_sign" ] ){
+        if ( !_config[ "coupling_initialization" ][ "free_dof_solver" ] ){
 
-            _config[ "coupling_initialization" ][ "micro_surface_force_sign" ] = 1; //Default to 1
+            _config[ "coupling_initialization" ][ "free_dof_solver" ][ "type" ] = "qr";
 
         }
 
-        if ( !_config[ "coupling_initialization" ][ "micro_external_force_sign" ] ){
+        if ( !_config[ "coupling_initialization" ][ "free_dof_solver" ][ "type" ] ){
 
-            _config[ "coupling_initialization" ][ "micro_external_force_sign" ] = 1; //Default to 1
+            _config[ "coupling_initialization" ][ "free_dof_solver" ][ "type" ] = "qr";
 
         }
 
-        if ( _config[ "coupling_initialization" ][ "extract_previous_dof_values" ] ){
+        std::string solverType = _config[ "coupling_initialization" ][ "free_dof_solver" ][ "type" ].as< std::string >( );
 
-            if ( !_config[ "coupling_initialization" ][ "extract_previous_dof_values" ].IsScalar( ) ){
+        if ( ( solverType.compare( "qr" ) != 0 ) && ( solverType.compare( "ldlt" ) != 0 ) &&
+             ( solverType.compare( "llt" ) != 0 ) && ( solverType.compare( "cg" ) != 0 ) ){
 
-                return new errorNode( "'extract_previous_dof_values' must be a boolean value" );
+            return new errorNode( "checkCouplingInitialization",
+                                  "'free_dof_solver' type " + solverType + " not recognized. Options are 'qr', 'ldlt', 'llt', and 'cg'" );
 
-            }
-            else if ( _config[ "coupling_initialization" ][ "extract_previous_dof_values" ].as< bool >( ) ){
+        }
 
-                _extractPreviousDOFValues = true;
+        if ( !_config[ "coupling_initialization" ][ "free_dof_solver" ][ "preconditioner" ] ){
 
-            }
+            _config[ "coupling_initialization" ][ "free_dof_solver" ][ "preconditioner" ] = "diagonal";
 
-            if ( _extractPreviousDOFValues ){
+        }
 
-                if ( !_config[ "coupling_initialization" ][ "previous_micro_increment" ] ){
+        std::string preconditioner = _config[ "coupling_initialization" ][ "free_dof_solver" ][ "preconditioner" ].as< std::string >( );
 
-                    return new errorNode( "checkCouplingInitialization",
-                                          "'previous_micro_increment' is not defined in 'coupling_initialization' when the user has requested that the previous values of the degrees of freedom are extracted" );
+        if ( ( preconditioner.compare( "diagonal" ) != 0 ) && ( preconditioner.compare( "incomplete_cholesky" ) != 0 ) ){
 
-                }
-                else if(  !_config[ "coupling_initialization" ][ "previous_micro_increment" ].IsScalar( ) ){
+            return new errorNode( "checkCouplingInitialization",
+                                  "'free_dof_solver' preconditioner " + preconditioner + " not recognized. Options are 'diagonal' and 'incomplete_cholesky'" );
 
-                    return new errorNode( "checkCouplingInitialization",
-                                          "'previous_micro_increment' must be defined as a scalar integer value indicating the increment ( i.e. timestep number ) which defines the previous dof values at the micro scale" );
+        }
 
-                }
+        if ( !_config[ "coupling_initialization" ][ "free_dof_solver" ][ "tolerance" ] ){
 
-                if ( !_config[ "coupling_initialization" ][ "previous_macro_increment" ] ){
+            _config[ "coupling_initialization" ][ "free_dof_solver" ][ "tolerance" ] = 1e-12;
 
-                    return new errorNode( "checkCouplingInitialization",
-                                          "'previous_macro_increment' is not defined in 'coupling_initialization' when the user has requested that the previous dof values are extracted" );
+        }
 
-                }
-                else if(  !_config[ "coupling_initialization" ][ "previous_macro_increment" ].IsScalar( ) ){
+        try{
 
-                    return new errorNode( "checkCouplingInitialization",
-                                          "'previous_macro_increment' must be defined as a scalar integer value indicating the increment ( i.e. timestep number ) which defines the last converged dof values at the macro scale" );
+            if ( _config[ "coupling_initialization" ][ "free_dof_solver" ][ "tolerance" ].as< floatType >( ) <= 0 ){
 
-                }
+                return new errorNode( "checkCouplingInitialization", "The 'free_dof_solver' tolerance must be positive" );
 
             }
 
         }
-        else{
+        catch( ... ){
 
-            _config[ "coupling_initialization" ][ "extract_previous_dof_values" ] = false;
+            return new errorNode( "checkCouplingInitialization", "The 'free_dof_solver' tolerance must be a floating point number" );
 
         }
 
-        if ( _config[ "coupling_initialization" ][ "update_displacement" ] ){
-
-            if ( !_config[ "coupling_initialization" ][ "extract_previous_dof_values" ].as< bool > ( ) ){
+        if ( !_config[ "coupling_initialization" ][ "free_dof_solver" ][ "max_iterations" ] ){
 
-                if ( !_config[ "coupling_initialization" ][ "update_displacement" ][ "Dt" ] ){
+            _config[ "coupling_initialization" ][ "free_dof_solver" ][ "max_iterations" ] = 0; //Use the solver's default
 
-                    return new errorNode( "checkCouplingInitialization",
-                                          "If the previous DOF values are not to be extracted and the displacement is to be updated, 'Dt' must be defined under 'update_displacement'" );
+        }
 
-                }
-                else{
+        try{
 
-                    _Dt = _config[ "coupling_initialization" ][ "update_displacement" ][ "Dt" ].as< floatType >( );
+            if ( _config[ "coupling_initialization" ][ "free_dof_solver" ][ "max_iterations" ].as< int >( ) < 0 ){
 
-                }
+                return new errorNode( "checkCouplingInitialization", "The 'free_dof_solver' max_iterations must be zero or a positive integer" );
 
             }
-            else if ( _config[ "coupling_initialization" ][ "update_displacement" ][ "Dt" ] ){
 
-                std::cerr << "WARNING: Dt is specified when the previous increment has been indicated.\n";
-                std::cerr << "         The Dt in the input file will be ignored\n";
-                _config[ "coupling_initialization" ][ "update_displacement" ][ "Dt" ] = "NULL";
+        }
+        catch( ... ){
 
-            }
+            return new errorNode( "checkCouplingInitialization", "The 'free_dof_solver' max_iterations must be an integer" );
 
-            if ( !_config[ "coupling_initialization" ][ "update_displacement" ][ "Newmark-beta_parameters" ][ "gamma" ] ){
+        }
 
-                _config[ "coupling_initialization" ][ "update_displacement" ][ "Newmark-beta_parameters" ][ "gamma" ] = 0.5;
-                _newmarkGamma = 0.5;
+        //Fall back to the QR decomposition if the LHS matrix is not symmetric positive definite. The direct solvers check
+        //positive definiteness with the Cholesky factorization. The conjugate gradient solvers only check the symmetry
+        //and the positivity of the diagonal.
+        if ( !_config[ "coupling_initialization" ][ "free_dof_solver" ][ "check_spd" ] ){
 
-            }
+            _config[ "coupling_initialization" ][ "free_dof_solver" ][ "check_spd" ] = true;
 
-            if ( !_config[ "coupling_initialization" ][ "update_displacement" ][ "Newmark-beta_parameters" ][ "beta" ] ){
+        }
 
-                _config[ "coupling_initialization" ][ "update_displacement" ][ "Newmark-beta_parameters" ][ "beta" ] = 0.25;
-                _newmarkBeta = 0.25;
+        try{
 
-            }
+            _config[ "coupling_initialization" ][ "free_dof_solver" ][ "check_spd" ].as< bool >( );
 
         }
-        else{
+        catch( ... ){
 
-            _config[ "coupling_initialization" ][ "update_displacement" ] = false;
+            return new errorNode( "checkCouplingInitialization", "The 'free_dof_solver' check_spd must be a boolean" );
 
         }
 
-        if ( _config[ "coupling_initialization" ][ "output_reference_information" ] ){
+        if ( !_config[ "coupling_initialization" ][ "l2_projector" ] ){
 
-            if ( !_config[ "coupling_initialization" ][ "output_reference_information" ][ "filename" ] ){
+            _config[ "coupling_initialization" ][ "l2_projector" ][ "type" ] = "dense";
 
-                _config[ "coupling_initialization" ][ "output_reference_information" ][ "filename" ] = "reference_information";
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "l2_projector" ][ "type" ] ){
+
+            _config[ "coupling_initialization" ][ "l2_projector" ][ "type" ] = "dense";
+
+        }
+
+        std::string l2ProjectorType = _config[ "coupling_initialization" ][ "l2_projector" ][ "type" ].as< std::string >( );
+
+        if ( ( l2ProjectorType.compare( "dense" ) != 0 ) && ( l2ProjectorType.compare( "sparse" ) != 0 ) ){
+
+            return new errorNode( "checkCouplingInitialization",
+                                  "'l2_projector' type " + l2ProjectorType + " not recognized. Options are 'dense' and 'sparse'" );
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "l2_projector" ][ "truncation_tolerance" ] ){
+
+            _config[ "coupling_initialization" ][ "l2_projector" ][ "truncation_tolerance" ] = 1e-4;
+
+        }
+
+        if ( _config[ "coupling_initialization" ][ "l2_projector" ][ "truncation_tolerance" ].as< floatType >( ) < 0 ){
+
+            return new errorNode( "checkCouplingInitialization", "The 'l2_projector' truncation tolerance must be zero or positive" );
+
+        }
+
+        if ( !_config [ "coupling_initialization" ][ "potential_energy_weighting_factor" ] ){
+
+            _config[ "coupling_initialization" ][ "potential_energy_weighting_factor" ] = 0.5; //Default to 0.5
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "potential_energy_partitioning_coefficient" ] ){
+
+            _config[ "coupling_initialization" ][ "potential_energy_partitioning_coefficient" ][ "type" ] = "volume_fraction"; //Default to volume fraction
+
+        }
+
+        if ( !_config [ "coupling_initialization" ][ "kinetic_energy_weighting_factor" ] ){
+
+            _config[ "coupling_initialization" ][ "kinetic_energy_weighting_factor" ] = 0.5; //Default to 0.5
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "kinetic_energy_partitioning_coefficient" ] ){
+
+            _config[ "coupling_initialization" ][ "kinetic_energy_partitioning_coefficient" ][ "type" ] = "volume_fraction"; //Default to volume fraction
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "macro_proportionality_coefficient" ] ){
+
+            _config[ "coupling_initialization" ][ "macro_proportionality_coefficient" ] = 1e-3; //Default to 1e-3
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "micro_proportionality_coefficient" ] ){
+
+            _config[ "coupling_initialization" ][ "micro_proportionality_coefficient" ] = 1e-3; //Default to 1e-3
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "macro_internal_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "macro_internal_force_sign" ] = -1; //Default to -1 to be consistent with the micromorphic implementation
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "macro_inertial_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "macro_inertial_force_sign" ] = 1; //Default to 1
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "macro_body_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "macro_body_force_sign" ] = 1; //Default to 1
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "macro_surface_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "macro_surface_force_sign" ] = 1; //Default to 1
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "macro_external_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "macro_external_force_sign" ] = 1; //Default to 1
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "micro_internal_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "micro_internal_force_sign" ] = 1; //Default to 1
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "micro_inertial_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "micro_inertial_force_sign" ] = 1; //Default to 1
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "micro_body_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "micro_body_force_sign" ] = 1; //Default to 1
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "micro_surface_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "micro_surface_force_sign" ] = 1; //Default to 1
+
+        }
+
+        if ( !_config[ "coupling_initialization" ][ "micro_external_force_sign" ] ){
+
+            _config[ "coupling_initialization" ][ "micro_external_force_sign" ] = 1; //Default to 1
+
+        }
+
+        if ( _config[ "coupling_initialization" ][ "extract_previous_dof_values" ] ){
+
+            if ( !_config[ "coupling_initialization" ][ "extract_previous_dof_values" ].IsScalar( ) ){
+
+                return new errorNode( "'extract_previous_dof_values' must be a boolean value" );
+
+            }
+            else if ( _config[ "coupling_initialization" ][ "extract_previous_dof_values" ].as< bool >( ) ){
+
+                _extractPreviousDOFValues = true;
+
+            }
+
+            if ( _extractPreviousDOFValues ){
+
+                if ( !_config[ "coupling_initialization" ][ "previous_micro_increment" ] ){
+
+                    return new errorNode( "checkCouplingInitialization",
+                                          "'previous_micro_increment' is not defined in 'coupling_initialization' when the user has requested that the previous values of the degrees of freedom are extracted" );
+
+                }
+                else if(  !_config[ "coupling_initialization" ][ "previous_micro_increment" ].IsScalar( ) ){
+
+                    return new errorNode( "checkCouplingInitialization",
+                                          "'previous_micro_increment' must be defined as a scalar integer value indicating the increment ( i.e. timestep number ) which defines the previous dof values at the micro scale" );
+
+                }
+
+                if ( !_config[ "coupling_initialization" ][ "previous_macro_increment" ] ){
+
+                    return new errorNode( "checkCouplingInitialization",
+                                          "'previous_macro_increment' is not defined in 'coupling_initialization' when the user has requested that the previous dof values are extracted" );
+
+                }
+                else if(  !_config[ "coupling_initialization" ][ "previous_macro_increment" ].IsScalar( ) ){
+
+                    return new errorNode( "checkCouplingInitialization",
+                                          "'previous_macro_increment' must be defined as a scalar integer value indicating the increment ( i.e. timestep number ) which defines the last converged dof values at the macro scale" );
+
+                }
+
+            }
+
+        }
+        else{
+
+            _config[ "coupling_initialization" ][ "extract_previous_dof_values" ] = false;
+
+        }
+
+        if ( _config[ "coupling_initialization" ][ "update_displacement" ] ){
+
+            if ( !_config[ "coupling_initialization" ][ "extract_previous_dof_values" ].as< bool > ( ) ){
+
+                if ( !_config[ "coupling_initialization" ][ "update_displacement" ][ "Dt" ] ){
+
+                    return new errorNode( "checkCouplingInitialization",
+                                          "If the previous DOF values are not to be extracted and the displacement is to be updated, 'Dt' must be defined under 'update_displacement'" );
+
+                }
+                else{
+
+                    _Dt = _config[ "coupling_initialization" ][ "update_displacement" ][ "Dt" ].as< floatType >( );
+
+                }
+
+            }
+            else if ( _config[ "coupling_initialization" ][ "update_displacement" ][ "Dt" ] ){
+
+                COUPLING_LOG( _logger, LOG_WARNING ) << "WARNING: Dt is specified when the previous increment has been indicated.\n"
+                                                     << "         The Dt in the input file will be ignored\n";
+                _config[ "coupling_initialization" ][ "update_displacement" ][ "Dt" ] = "NULL";
+
+            }
+
+            if ( !_config[ "coupling_initialization" ][ "update_displacement" ][ "Newmark-beta_parameters" ][ "gamma" ] ){
+
+                _config[ "coupling_initialization" ][ "update_displacement" ][ "Newmark-beta_parameters" ][ "gamma" ] = 0.5;
+                _newmarkGamma = 0.5;
+
+            }
+
+            if ( !_config[ "coupling_initialization" ][ "update_displacement" ][ "Newmark-beta_parameters" ][ "beta" ] ){
+
+                _config[ "coupling_initialization" ][ "update_displacement" ][ "Newmark-beta_parameters" ][ "beta" ] = 0.25;
+                _newmarkBeta = 0.25;
+
+            }
+
+        }
+        else{
+
+            _config[ "coupling_initialization" ][ "update_displacement" ] = false;
+
+        }
+
+        if ( _config[ "coupling_initialization" ][ "output_reference_information" ] ){
+
+            if ( !_config[ "coupling_initialization" ][ "output_reference_information" ][ "filename" ] ){
+
+                _config[ "coupling_initialization" ][ "output_reference_information" ][ "filename" ] = "reference_information";
 
             }
             _outputReferenceInformation = true;
@@ -3755,6 +4185,12 @@ namespace inputFileProcessor{
 
             }
 
+            if ( !_config[ "coupling_initialization" ][ "output_homogenized_response" ][ "flush_each_increment" ] ){
+
+                _config [ "coupling_initialization" ][ "output_homogenized_response" ][ "flush_each_increment" ] = true;
+
+            }
+
         }
         else{
 
@@ -3853,7 +4289,6 @@ namespace inputFileProcessor{
 
             }
 
-
             if ( _config[ "coupling_initialization" ][ "solve_coupling_odes_at_microdomains" ].as< bool >( ) ){
 
                 if ( _config[ "coupling_initialization" ][ "projection_type" ].as< std::string >( ).compare( "averaged_l2_projection" ) != 0 ){
@@ -3926,13 +4361,24 @@ namespace inputFileProcessor{
         uniqueIds.reserve( approximateSize );
 
         uIntVector nodes;
+        boolVector seen;
+        std::unordered_set< uIntType > sparseSeen;
         errorOut error = NULL;
 
         for ( auto domain =  domainNames.begin( );
                    domain != domainNames.end( );
                    domain++ ){
 
-            error = dataFile->getSubDomainNodes( increment, *domain, nodes );
+            if ( dataFile == _microscale ){
+
+                error = getMicroDomainNodes( increment, *domain, nodes );
+
+            }
+            else{
+
+                error = dataFile->getSubDomainNodes( increment, *domain, nodes );
+
+            }
 
             if ( error ){
 
@@ -3942,19 +4388,8 @@ namespace inputFileProcessor{
 
             }
 
-            //Loop through the nodes
-            for ( auto node =  nodes.begin( );
-                       node != nodes.end( );
-                       node++ ){
-                  
-                //If the node is not found add it 
-                if ( std::find( uniqueIds.begin( ), uniqueIds.end( ), *node ) == uniqueIds.end( ) ){
-
-                    uniqueIds.push_back( *node );
-
-                }
-
-            }
+            //Add the nodes which have not been seen before
+            appendUniqueIds( nodes, seen, sparseSeen, uniqueIds );
 
         }
 
@@ -4474,6 +4909,8 @@ namespace inputFileProcessor{
 
         } 
 
+        _microNodeFields.setIndex( &_microGlobalNodeIDOutputIndex );
+
         return NULL;
 
     }
@@ -4544,13 +4981,12 @@ namespace inputFileProcessor{
 
         } 
 
+        _macroNodeFields.setIndex( &_macroGlobalNodeIDOutputIndex );
+
         return NULL;
 
     }
 
-
-
-
     YAML::Node inputFileProcessor::getVolumeReconstructionConfig( ){
         /*!
          * Return the volume reconstruction configuration
@@ -4666,9 +5102,11 @@ namespace inputFileProcessor{
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroDisplacements( ){
         /*!
          * Get the micro-displacements
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_microDisplacements;
+        return _microNodeFields.getNodeMap( "displacement" );
     }
 
     const floatType* inputFileProcessor::getMacroTime( ){
@@ -4682,33 +5120,41 @@ namespace inputFileProcessor{
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMacroDisplacements( ){
         /*!
          * Get the macro-displacements
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_macroDisplacements;
+        return _macroNodeFields.getNodeMap( "displacement" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMacroDispDOFVector( ){
         /*!
          * Get the macro-displacement DOF vector
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_macroDispDOFVector;
+        return _macroNodeFields.getNodeMap( "displacement_dof" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMacroVelocities( ){
         /*!
          * Get a pointer to the macro velocities
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_macroVelocities;
+        return _macroNodeFields.getNodeMap( "velocity" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMacroAccelerations( ){
         /*!
          * Get a pointer to the macro accelerations
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_macroAccelerations;
+        return _macroNodeFields.getNodeMap( "acceleration" );
 
     }
 
@@ -4717,16 +5163,18 @@ namespace inputFileProcessor{
          * Get a pointer to the previous macro values of the displacement degrees of freedom
          *
          * If extraction of those values as not requested, the current macro displacement degrees of freedom will be returned
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
         if ( _extractPreviousDOFValues ){
 
-            return &_previousMacroDispDOFVector;
+            return _macroNodeFields.getNodeMap( "previous_displacement_dof" );
 
         }
         else{
 
-            return &_macroDispDOFVector;
+            return _macroNodeFields.getNodeMap( "displacement_dof" );
 
         }
 
@@ -4737,16 +5185,18 @@ namespace inputFileProcessor{
          * Get a pointer to the previous macro velocities
          *
          * If extraction of those values as not requested, the current macro velocities will be returned
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
         if ( _extractPreviousDOFValues ){
 
-            return &_previousMacroVelocities;
+            return _macroNodeFields.getNodeMap( "previous_velocity" );
 
         }
         else{
 
-            return &_macroVelocities;
+            return _macroNodeFields.getNodeMap( "velocity" );
 
         }
 
@@ -4757,16 +5207,18 @@ namespace inputFileProcessor{
          * Get a pointer to the previous macro accelerations
          *
          * If extraction of those values as not requested, the current macro accelerations will be returned
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
         if ( _extractPreviousDOFValues ){
 
-            return &_previousMacroAccelerations;
+            return _macroNodeFields.getNodeMap( "previous_acceleration" );
 
         }
         else{
 
-            return &_macroAccelerations;
+            return _macroNodeFields.getNodeMap( "acceleration" );
 
         }
 
@@ -4775,41 +5227,51 @@ namespace inputFileProcessor{
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMacroInternalForces( ){
         /*!
          * Get a pointer to the macro internal forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_macroInternalForces;
+        return _macroNodeFields.getNodeMap( "internal_force" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMacroExternalForces( ){
         /*!
          * Get a pointer to the macro internal forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_macroExternalForces;
+        return _macroNodeFields.getNodeMap( "external_force" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMacroInertialForces( ){
         /*!
          * Get a pointer to the macro inertial forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_macroInertialForces;
+        return _macroNodeFields.getNodeMap( "inertial_force" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMacroBodyForces( ){
         /*!
          * Get a pointer to the macro body forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_macroBodyForces;
+        return _macroNodeFields.getNodeMap( "body_force" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMacroSurfaceForces( ){
         /*!
          * Get a pointer to the macro surface forces
+         *
+         * The map keeps its address for the lifetime of the processor and its contents are replaced when the field is updated
          */
 
-        return &_macroSurfaceForces;
+        return _macroNodeFields.getNodeMap( "surface_force" );
     }
 
     const std::unordered_map< uIntType, floatVector >* inputFileProcessor::getMicroNodeReferencePositions( ){
@@ -4966,29 +5428,89 @@ namespace inputFileProcessor{
          * in the homogenization.
          */
 
-        return _config[ "coupling_initialization" ][ "use_reconstructed_mass_centers" ].as< bool >( );
+        return _useReconstructedMassCenters;
 
     }
 
-    const std::unordered_map< unsigned int, floatVector > *inputFileProcessor::getMacroReferenceDensities( ){
+    uIntType inputFileProcessor::getHomogenizationThreadCount( ){
         /*!
-         * Get the macro reference densities for the macro domains
+         * Get the number of threads to use when homogenizing the micro domains
          */
 
-        return &_macroReferenceDensities;
+        return _homogenizationThreadCount;
 
     }
 
-    const std::unordered_map< unsigned int, floatVector > *inputFileProcessor::getMacroReferenceMomentsOfInertia( ){
+    uIntType inputFileProcessor::getOutputQueueSize( ){
         /*!
-         * Get the macro reference moments of inertia
+         * Get the number of increments of output which may be waiting to be written by the background writer.
+         * Zero indicates that the output is written before the increment is completed.
          */
 
-        return &_macroReferenceMomentsOfInertia;
+        return _outputQueueSize;
 
     }
 
-    const std::unordered_map< unsigned int, std::string > *inputFileProcessor::getMacroReferenceDensityTypes( ){
+    bool inputFileProcessor::prefetchesNextIncrement( ){
+        /*!
+         * Whether the solution data of the next increment is read in the background
+         */
+
+        return _microPrefetcher.isEnabled( );
+
+    }
+
+    solutionDataPrefetcher* inputFileProcessor::getSolutionDataPrefetcher( const std::shared_ptr< dataFileInterface::dataFileBase > &dataFile ){
+        /*!
+         * Get the read-ahead store of one of the data files of the processor. NULL is returned if the data file
+         * is not the macro or micro data file.
+         *
+         * :param const std::shared_ptr< dataFileInterface::dataFileBase > &dataFile: The data file
+         */
+
+        if ( dataFile == _microscale ){
+
+            return &_microPrefetcher;
+
+        }
+        else if ( dataFile == _macroscale ){
+
+            return &_macroPrefetcher;
+
+        }
+
+        return NULL;
+
+    }
+
+    couplingLogger &inputFileProcessor::getLogger( ){
+        /*!
+         * Get the logger of the coupling configured by 'logging' in 'coupling_initialization'
+         */
+
+        return _logger;
+
+    }
+
+    const std::unordered_map< unsigned int, floatVector > *inputFileProcessor::getMacroReferenceDensities( ){
+        /*!
+         * Get the macro reference densities for the macro domains
+         */
+
+        return &_macroReferenceDensities;
+
+    }
+
+    const std::unordered_map< unsigned int, floatVector > *inputFileProcessor::getMacroReferenceMomentsOfInertia( ){
+        /*!
+         * Get the macro reference moments of inertia
+         */
+
+        return &_macroReferenceMomentsOfInertia;
+
+    }
+
+    const std::unordered_map< unsigned int, std::string > *inputFileProcessor::getMacroReferenceDensityTypes( ){
         /*!
          * Get the macro reference density types for the macro domains
          */
@@ -5166,4 +5688,1033 @@ namespace inputFileProcessor{
         return _assumeVoidlessBody;
     }
 
+    void appendUniqueIds( const uIntVector &ids, boolVector &seen, std::unordered_set< uIntType > &sparseSeen,
+                          uIntVector &uniqueIds ){
+        /*!
+         * Append the ids which have not been seen before to the unique ids in the order in which
+         * they are first encountered.
+         *
+         * The ids which have been seen are tracked by a bitmap indexed by the id so the cost is linear
+         * in the number of ids. Note that the memory of the bitmap is O( largest id ), i.e. one bit per
+         * id up to the largest id, and not O( number of ids ). If the ids are sparse, so that the bitmap
+         * would need more than 64 bits per unique id, the ids which have been seen are moved into a hash
+         * set which is used for this and all following calls.
+         *
+         * :param const uIntVector &ids: The ids to be added
+         * :param boolVector &seen: The bitmap of the ids which have been seen. This should be empty on the
+         *     first call and is expanded as required.
+         * :param std::unordered_set< uIntType > &sparseSeen: The ids which have been seen if they are sparse.
+         *     This should be empty on the first call.
+         * :param uIntVector &uniqueIds: The unique ids
+         */
+
+        //The bitmap is always used up to this size
+        const std::size_t minimumSparseSize = 1 << 16;
+
+        //The largest number of bits of the bitmap per unique id
+        const std::size_t maximumBitsPerId = 64;
+
+        if ( ids.empty( ) ){
+
+            return;
+
+        }
+
+        bool isSparse = !sparseSeen.empty( );
+
+        if ( !isSparse ){
+
+            std::size_t requiredSize = ( std::size_t )( *std::max_element( ids.begin( ), ids.end( ) ) ) + 1;
+
+            if ( ( requiredSize > seen.size( ) ) && ( requiredSize > minimumSparseSize ) &&
+                 ( requiredSize > maximumBitsPerId * ( uniqueIds.size( ) + ids.size( ) ) ) ){
+
+                //Move the ids which have been seen into the hash set
+                for ( std::size_t i = 0; i < seen.size( ); i++ ){
+
+                    if ( seen[ i ] ){
+
+                        sparseSeen.insert( ( uIntType )i );
+
+                    }
+
+                }
+
+                boolVector( ).swap( seen );
+
+                isSparse = true;
+
+            }
+
+        }
+
+        if ( isSparse ){
+
+            for ( auto id = ids.begin( ); id != ids.end( ); id++ ){
+
+                if ( sparseSeen.insert( *id ).second ){
+
+                    uniqueIds.push_back( *id );
+
+                }
+
+            }
+
+            return;
+
+        }
+
+        for ( auto id = ids.begin( ); id != ids.end( ); id++ ){
+
+            if ( *id >= seen.size( ) ){
+
+                seen.resize( std::max( ( std::size_t )( *id ) + 1, 2 * seen.size( ) ), false );
+
+            }
+
+            if ( !seen[ *id ] ){
+
+                seen[ *id ] = true;
+                uniqueIds.push_back( *id );
+
+            }
+
+        }
+
+    }
+
+    nodeFieldContainer::nodeFieldContainer( ){
+        /*!
+         * The default constructor
+         */
+
+        return;
+
+    }
+
+    nodeFieldContainer::nodeFieldContainer( const nodeFieldContainer &other ){
+        /*!
+         * The copy constructor. The fields and the index are copied. The per-node maps are rebuilt on demand.
+         *
+         * :param const nodeFieldContainer &other: The container to copy
+         */
+
+        _globalToLocalIndex = other._globalToLocalIndex;
+        _fields = other._fields;
+
+    }
+
+    nodeFieldContainer &nodeFieldContainer::operator=( const nodeFieldContainer &other ){
+        /*!
+         * The copy assignment operator. The fields and the index are copied. The per-node maps which have been
+         * requested from this container are rebuilt in place.
+         *
+         * :param const nodeFieldContainer &other: The container to copy
+         */
+
+        if ( this != &other ){
+
+            _globalToLocalIndex = other._globalToLocalIndex;
+            _fields = other._fields;
+            updateNodeMaps( "" );
+
+        }
+
+        return *this;
+
+    }
+
+    void nodeFieldContainer::setIndex( const DOFMap *globalToLocalIndex ){
+        /*!
+         * Set the global-to-local node ID index shared by all of the fields
+         *
+         * :param const DOFMap *globalToLocalIndex: The map from the global node ID to the local index
+         *     of the node in the field arrays. The map must outlive the container.
+         */
+
+        _globalToLocalIndex = globalToLocalIndex;
+
+        updateNodeMaps( "" );
+    }
+
+    const DOFMap *nodeFieldContainer::getIndex( ) const{
+        /*!
+         * Get the global-to-local node ID index
+         */
+
+        return _globalToLocalIndex;
+    }
+
+    uIntType nodeFieldContainer::getNodeCount( ) const{
+        /*!
+         * Get the number of nodes required to store a field i.e. one more than the largest local index
+         */
+
+        uIntType nNodes = 0;
+
+        if ( !_globalToLocalIndex ){
+
+            return nNodes;
+
+        }
+
+        for ( auto n = _globalToLocalIndex->begin( ); n != _globalToLocalIndex->end( ); n++ ){
+
+            nNodes = std::max( nNodes, n->second + 1 );
+
+        }
+
+        return nNodes;
+    }
+
+    errorOut nodeFieldContainer::setField( const std::string &fieldName, const uIntType &stride, floatVector values,
+                                           const floatType &scale ){
+        /*!
+         * Set the values of a field. The values are moved into the container so callers which no longer need
+         * them should pass them with std::move.
+         *
+         * :param const std::string &fieldName: The name of the field
+         * :param const uIntType &stride: The number of values per node
+         * :param floatVector values: The values of the field in the local node ordering
+         * :param const floatType &scale: The scale factor to apply to the values
+         */
+
+        if ( values.size( ) < stride * getNodeCount( ) ){
+
+            return new errorNode( "setField", "The values of the field '" + fieldName + "' are too short for the required index" );
+
+        }
+
+        nodeField &field = _fields[ fieldName ];
+        field.stride = stride;
+        field.values = std::move( values );
+
+        if ( scale != 1 ){
+
+            field.values *= scale;
+
+        }
+
+        updateNodeMaps( fieldName );
+
+        return NULL;
+    }
+
+    errorOut nodeFieldContainer::setFieldFromSum( const std::string &fieldName, const stringVector &sourceFieldNames ){
+        /*!
+         * Set the values of a field to the sum of other fields
+         *
+         * :param const std::string &fieldName: The name of the field
+         * :param const stringVector &sourceFieldNames: The names of the fields to be summed. They must have the same stride and size.
+         */
+
+        if ( sourceFieldNames.size( ) == 0 ){
+
+            return new errorNode( "setFieldFromSum", "At least one source field is required" );
+
+        }
+
+        nodeField sum;
+
+        for ( auto name = sourceFieldNames.begin( ); name != sourceFieldNames.end( ); name++ ){
+
+            auto field = _fields.find( *name );
+
+            if ( field == _fields.end( ) ){
+
+                return new errorNode( "setFieldFromSum", "The field '" + *name + "' is not defined" );
+
+            }
+
+            if ( name == sourceFieldNames.begin( ) ){
+
+                sum = field->second;
+
+            }
+            else if ( ( field->second.stride != sum.stride ) || ( field->second.values.size( ) != sum.values.size( ) ) ){
+
+                return new errorNode( "setFieldFromSum", "The field '" + *name + "' is not the same shape as the field '" + sourceFieldNames[ 0 ] + "'" );
+
+            }
+            else{
+
+                sum.values += field->second.values;
+
+            }
+
+        }
+
+        _fields[ fieldName ] = std::move( sum );
+
+        updateNodeMaps( fieldName );
+
+        return NULL;
+    }
+
+    void nodeFieldContainer::clearField( const std::string &fieldName ){
+        /*!
+         * Remove a field from the container
+         *
+         * :param const std::string &fieldName: The name of the field
+         */
+
+        _fields.erase( fieldName );
+
+        updateNodeMaps( fieldName );
+    }
+
+    void nodeFieldContainer::clear( ){
+        /*!
+         * Remove all of the fields from the container
+         */
+
+        _fields.clear( );
+
+        updateNodeMaps( "" );
+    }
+
+    bool nodeFieldContainer::hasField( const std::string &fieldName ) const{
+        /*!
+         * Check if a field is defined
+         *
+         * :param const std::string &fieldName: The name of the field
+         */
+
+        return _fields.find( fieldName ) != _fields.end( );
+    }
+
+    errorOut nodeFieldContainer::getField( const std::string &fieldName, const floatVector *&values, uIntType &stride ) const{
+        /*!
+         * Get the values of a field
+         *
+         * :param const std::string &fieldName: The name of the field
+         * :param const floatVector *&values: A pointer to the values of the field
+         * :param uIntType &stride: The number of values per node
+         */
+
+        auto field = _fields.find( fieldName );
+
+        if ( field == _fields.end( ) ){
+
+            return new errorNode( "getField", "The field '" + fieldName + "' is not defined" );
+
+        }
+
+        values = &field->second.values;
+        stride = field->second.stride;
+
+        return NULL;
+    }
+
+    errorOut nodeFieldContainer::getLocalIndex( const uIntType &globalNodeID, uIntType &localIndex ) const{
+        /*!
+         * Get the local index of a node
+         *
+         * :param const uIntType &globalNodeID: The global ID of the node
+         * :param uIntType &localIndex: The local index of the node in the field arrays
+         */
+
+        if ( !_globalToLocalIndex ){
+
+            return new errorNode( "getLocalIndex", "The global-to-local node index has not been set" );
+
+        }
+
+        auto index = _globalToLocalIndex->find( globalNodeID );
+
+        if ( index == _globalToLocalIndex->end( ) ){
+
+            return new errorNode( "getLocalIndex", "The node " + std::to_string( globalNodeID ) + " is not in the global-to-local node index" );
+
+        }
+
+        localIndex = index->second;
+
+        return NULL;
+    }
+
+    errorOut nodeFieldContainer::getNodeValues( const std::string &fieldName, const uIntType &globalNodeID,
+                                                const floatType *&values, uIntType &stride ) const{
+        /*!
+         * Get a pointer to the values of a field at a node
+         *
+         * :param const std::string &fieldName: The name of the field
+         * :param const uIntType &globalNodeID: The global ID of the node
+         * :param const floatType *&values: A pointer to the first of the stride values of the node
+         * :param uIntType &stride: The number of values per node
+         */
+
+        auto field = _fields.find( fieldName );
+
+        if ( field == _fields.end( ) ){
+
+            return new errorNode( "getNodeValues", "The field '" + fieldName + "' is not defined" );
+
+        }
+
+        uIntType localIndex;
+        errorOut error = getLocalIndex( globalNodeID, localIndex );
+
+        if ( error ){
+
+            errorOut result = new errorNode( "getNodeValues", "Error in getting the local index of the node" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        if ( field->second.stride * ( localIndex + 1 ) > field->second.values.size( ) ){
+
+            return new errorNode( "getNodeValues", "The field '" + fieldName + "' is too short for the local index of node " + std::to_string( globalNodeID ) );
+
+        }
+
+        values = field->second.values.data( ) + field->second.stride * localIndex;
+        stride = field->second.stride;
+
+        return NULL;
+    }
+
+    const std::unordered_map< uIntType, floatVector > *nodeFieldContainer::getNodeMap( const std::string &fieldName ) const{
+        /*!
+         * Get a map from the global node ID to the values of a field at the node. The map is built when it is
+         * first requested. It is kept at the same address for the lifetime of the container and is rebuilt in
+         * place whenever the field or the index changes. The map is empty if the field is not defined.
+         *
+         * New code should read the fields directly with getNodeValues or getField.
+         *
+         * :param const std::string &fieldName: The name of the field
+         */
+
+        std::lock_guard< std::mutex > lock( _nodeMapMutex );
+
+        auto nodeMap = _nodeMaps.find( fieldName );
+
+        if ( nodeMap != _nodeMaps.end( ) ){
+
+            return &nodeMap->second;
+
+        }
+
+        std::unordered_map< uIntType, floatVector > &result = _nodeMaps[ fieldName ];
+
+        buildNodeMap( fieldName, result );
+
+        return &result;
+    }
+
+    const std::unordered_map< uIntType, floatType > *nodeFieldContainer::getScalarNodeMap( const std::string &fieldName ) const{
+        /*!
+         * Get a map from the global node ID to the value of a scalar field at the node. The map is built when it is
+         * first requested. It is kept at the same address for the lifetime of the container and is rebuilt in
+         * place whenever the field or the index changes. The map is empty if the field is not defined.
+         *
+         * New code should read the fields directly with getNodeValues or getField.
+         *
+         * :param const std::string &fieldName: The name of the field
+         */
+
+        std::lock_guard< std::mutex > lock( _nodeMapMutex );
+
+        auto nodeMap = _scalarNodeMaps.find( fieldName );
+
+        if ( nodeMap != _scalarNodeMaps.end( ) ){
+
+            return &nodeMap->second;
+
+        }
+
+        std::unordered_map< uIntType, floatType > &result = _scalarNodeMaps[ fieldName ];
+
+        buildScalarNodeMap( fieldName, result );
+
+        return &result;
+    }
+
+    void nodeFieldContainer::buildNodeMap( const std::string &fieldName, std::unordered_map< uIntType, floatVector > &nodeMap ) const{
+        /*!
+         * Fill a per-node map with the values of a field
+         *
+         * :param const std::string &fieldName: The name of the field
+         * :param std::unordered_map< uIntType, floatVector > &nodeMap: The map to fill. Any previous contents are removed.
+         */
+
+        nodeMap.clear( );
+
+        auto field = _fields.find( fieldName );
+
+        if ( ( field == _fields.end( ) ) || ( !_globalToLocalIndex ) ){
+
+            return;
+
+        }
+
+        const uIntType stride = field->second.stride;
+        const floatVector &values = field->second.values;
+
+        nodeMap.reserve( _globalToLocalIndex->size( ) );
+
+        for ( auto n = _globalToLocalIndex->begin( ); n != _globalToLocalIndex->end( ); n++ ){
+
+            nodeMap.emplace( n->first, floatVector( values.begin( ) + stride * n->second,
+                                                    values.begin( ) + stride * ( n->second + 1 ) ) );
+
+        }
+
+        return;
+    }
+
+    void nodeFieldContainer::buildScalarNodeMap( const std::string &fieldName, std::unordered_map< uIntType, floatType > &nodeMap ) const{
+        /*!
+         * Fill a per-node map with the values of a scalar field
+         *
+         * :param const std::string &fieldName: The name of the field
+         * :param std::unordered_map< uIntType, floatType > &nodeMap: The map to fill. Any previous contents are removed.
+         */
+
+        nodeMap.clear( );
+
+        auto field = _fields.find( fieldName );
+
+        if ( ( field == _fields.end( ) ) || ( !_globalToLocalIndex ) ){
+
+            return;
+
+        }
+
+        const uIntType stride = field->second.stride;
+        const floatVector &values = field->second.values;
+
+        nodeMap.reserve( _globalToLocalIndex->size( ) );
+
+        for ( auto n = _globalToLocalIndex->begin( ); n != _globalToLocalIndex->end( ); n++ ){
+
+            nodeMap.emplace( n->first, values[ stride * n->second ] );
+
+        }
+
+        return;
+    }
+
+    void nodeFieldContainer::updateNodeMaps( const std::string &fieldName ){
+        /*!
+         * Rebuild the per-node maps of a field which have been requested. The maps are updated in place so
+         * that the pointers returned by getNodeMap and getScalarNodeMap remain valid.
+         *
+         * :param const std::string &fieldName: The name of the field. All of the maps are rebuilt if it is empty.
+         */
+
+        std::lock_guard< std::mutex > lock( _nodeMapMutex );
+
+        for ( auto nodeMap = _nodeMaps.begin( ); nodeMap != _nodeMaps.end( ); nodeMap++ ){
+
+            if ( fieldName.empty( ) || ( nodeMap->first == fieldName ) ){
+
+                buildNodeMap( nodeMap->first, nodeMap->second );
+
+            }
+
+        }
+
+        for ( auto nodeMap = _scalarNodeMaps.begin( ); nodeMap != _scalarNodeMaps.end( ); nodeMap++ ){
+
+            if ( fieldName.empty( ) || ( nodeMap->first == fieldName ) ){
+
+                buildScalarNodeMap( nodeMap->first, nodeMap->second );
+
+            }
+
+        }
+    }
+
+    solutionDataPrefetcher::solutionDataPrefetcher( ){
+        /*!
+         * The default constructor
+         */
+
+        return;
+
+    }
+
+    solutionDataPrefetcher::solutionDataPrefetcher( const solutionDataPrefetcher &other ){
+        /*!
+         * The copy constructor. Only the data file and the prefetching flag are copied. The buffers of the
+         * copy start empty.
+         *
+         * :param const solutionDataPrefetcher &other: The prefetcher to copy
+         */
+
+        _enabled = other._enabled;
+        _dataFile = other._dataFile;
+
+    }
+
+    solutionDataPrefetcher &solutionDataPrefetcher::operator=( const solutionDataPrefetcher &other ){
+        /*!
+         * The copy assignment operator. Only the data file and the prefetching flag are copied. The buffers are
+         * emptied.
+         *
+         * :param const solutionDataPrefetcher &other: The prefetcher to copy
+         */
+
+        if ( this != &other ){
+
+            setDataFile( other._dataFile );
+            _enabled = other._enabled;
+
+        }
+
+        return *this;
+
+    }
+
+    solutionDataPrefetcher::~solutionDataPrefetcher( ){
+        /*!
+         * The destructor. Waits for a running prefetch to finish.
+         */
+
+        wait( );
+
+    }
+
+    void solutionDataPrefetcher::setDataFile( const std::shared_ptr< dataFileInterface::dataFileBase > &dataFile ){
+        /*!
+         * Set the data file which the solution data is read from. Any data read from the previous data file is discarded.
+         *
+         * :param const std::shared_ptr< dataFileInterface::dataFileBase > &dataFile: The data file
+         */
+
+        wait( );
+
+        _dataFile = dataFile;
+        _requests.clear( );
+        _current->clear( );
+        _next->clear( );
+
+    }
+
+    void solutionDataPrefetcher::setEnabled( const bool &enabled ){
+        /*!
+         * Set whether the solution data of the next increment is read in the background
+         *
+         * :param const bool &enabled: The flag for the prefetching
+         */
+
+        wait( );
+
+        _enabled = enabled;
+
+        if ( !_enabled ){
+
+            _requests.clear( );
+            _current->clear( );
+            _next->clear( );
+
+        }
+
+    }
+
+    bool solutionDataPrefetcher::isEnabled( ) const{
+        /*!
+         * Whether the solution data of the next increment is read in the background
+         */
+
+        return _enabled;
+
+    }
+
+    void solutionDataPrefetcher::beginIncrement( ){
+        /*!
+         * Begin the initialization of an increment. The buffers are exchanged so that the prefetched data
+         * becomes the current data and the unused data of the previous increment is released.
+         */
+
+        wait( );
+
+        std::swap( _current, _next );
+        _next->clear( );
+        _requests.clear( );
+
+    }
+
+    void solutionDataPrefetcher::prefetch( const uIntType &currentIncrement, const uIntType &nextIncrement ){
+        /*!
+         * Start reading, in a background thread, the solution data of the next increment. The requests which
+         * were made for the current increment since beginIncrement are repeated for the next increment. Requests
+         * made for any other increment ( e.g. a fixed previous increment ) are not repeated.
+         *
+         * :param const uIntType &currentIncrement: The increment which has been initialized
+         * :param const uIntType &nextIncrement: The increment which is expected to be initialized next
+         */
+
+        if ( !_enabled || !_dataFile || _requests.empty( ) ){
+
+            return;
+
+        }
+
+        wait( );
+
+        //Don't read past the end of the data file
+        uIntType numIncrements;
+        std::unique_ptr< errorNode > error( _dataFile->getNumIncrements( numIncrements ) );
+
+        if ( error || ( nextIncrement >= numIncrements ) ){
+
+            return;
+
+        }
+
+        std::vector< requestKey > requests;
+        requests.reserve( _requests.size( ) );
+
+        for ( auto request = _requests.begin( ); request != _requests.end( ); request++ ){
+
+            if ( std::get< 0 >( *request ) == currentIncrement ){
+
+                requests.push_back( requestKey( nextIncrement, std::get< 1 >( *request ), std::get< 2 >( *request ) ) );
+
+            }
+
+        }
+
+        if ( requests.empty( ) ){
+
+            return;
+
+        }
+
+        //The buffer isn't exchanged until the thread has been joined
+        std::shared_ptr< dataFileInterface::dataFileBase > dataFile = _dataFile;
+        requestStore *next = _next.get( );
+        next->clear( );
+
+        _thread = std::thread( [ dataFile, requests, next ]( ){
+
+            for ( auto request = requests.begin( ); request != requests.end( ); request++ ){
+
+                floatVector data;
+                std::unique_ptr< errorNode > error( dataFile->getSolutionVectorDataFromComponents( std::get< 0 >( *request ),
+                                                                                                   std::get< 2 >( *request ),
+                                                                                                   std::get< 1 >( *request ),
+                                                                                                   data ) );
+
+                //Failed reads are not stored. The read is repeated, and the error reported, when the data is requested.
+                if ( !error ){
+
+                    ( *next )[ *request ] = std::move( data );
+
+                }
+
+            }
+
+        } );
+
+    }
+
+    void solutionDataPrefetcher::wait( ){
+        /*!
+         * Wait for a running prefetch to finish
+         */
+
+        if ( _thread.joinable( ) ){
+
+            _thread.join( );
+
+        }
+
+    }
+
+    errorOut solutionDataPrefetcher::getSolutionData( const uIntType &increment, const stringVector &componentNames,
+                                                      const std::string &dataType, floatVector &data ){
+        /*!
+         * Get solution data from the data file where the components are saved individually. The components
+         * are interleaved in the output as in dataFileBase::getSolutionVectorDataFromComponents. If the data has
+         * been prefetched it is moved out of the store.
+         *
+         * :param const uIntType &increment: The increment at which to get the data
+         * :param const stringVector &componentNames: The names of the data's components
+         * :param const std::string &dataType: The type of the data. This will either be "Node" or "Cell"
+         * :param floatVector &data: The output data vector
+         */
+
+        if ( !_dataFile ){
+
+            return new errorNode( "getSolutionData", "The data file has not been set" );
+
+        }
+
+        if ( !_enabled ){
+
+            return _dataFile->getSolutionVectorDataFromComponents( increment, componentNames, dataType, data );
+
+        }
+
+        requestKey key( increment, dataType, componentNames );
+
+        _requests.push_back( key );
+
+        auto stored = _current->find( key );
+
+        if ( stored != _current->end( ) ){
+
+            data = std::move( stored->second );
+            _current->erase( stored );
+            _numPrefetchedReads++;
+
+            return NULL;
+
+        }
+
+        return _dataFile->getSolutionVectorDataFromComponents( increment, componentNames, dataType, data );
+
+    }
+
+    uIntType solutionDataPrefetcher::getNumPrefetchedReads( ) const{
+        /*!
+         * Get the number of requests which have been served from the prefetched data
+         */
+
+        return _numPrefetchedReads;
+
+    }
+
+    couplingLogger::couplingLogger( ){
+        /*!
+         * The default constructor
+         */
+
+        return;
+
+    }
+
+    couplingLogger::couplingLogger( const couplingLogger &other ){
+        /*!
+         * The copy constructor. The level and the debug file are copied. The thread buffers are not.
+         *
+         * :param const couplingLogger &other: The logger to copy
+         */
+
+        _level = other._level;
+        _binaryDebugFile = other._binaryDebugFile;
+        _debugFile = other._debugFile;
+
+    }
+
+    couplingLogger &couplingLogger::operator=( const couplingLogger &other ){
+        /*!
+         * The copy assignment operator. The level and the debug file are copied. The thread buffers are not.
+         *
+         * :param const couplingLogger &other: The logger to copy
+         */
+
+        if ( this != &other ){
+
+            _level = other._level;
+            _binaryDebugFile = other._binaryDebugFile;
+            _debugFile = other._debugFile;
+
+        }
+
+        return *this;
+
+    }
+
+    void couplingLogger::setLevel( const logLevel &level ){
+        /*!
+         * Set the verbosity level of the log
+         *
+         * :param const logLevel &level: The most verbose level which will be written
+         */
+
+        _level = level;
+    }
+
+    logLevel couplingLogger::getLevel( ) const{
+        /*!
+         * Get the verbosity level of the log
+         */
+
+        return _level;
+    }
+
+    bool couplingLogger::isEnabled( const logLevel &level ) const{
+        /*!
+         * Check if messages of the given level will be written. Levels which are more verbose than
+         * OVERLAP_COUPLING_MAX_LOG_LEVEL are never written.
+         *
+         * :param const logLevel &level: The level of the message
+         */
+
+        return ( level != LOG_NONE ) && ( ( int )level <= OVERLAP_COUPLING_MAX_LOG_LEVEL ) && ( level <= _level );
+    }
+
+    std::ostream &couplingLogger::getStream( ){
+        /*!
+         * Get the stream the log messages are written to. This is the buffer of the calling thread
+         * if its messages are being buffered and standard error otherwise.
+         */
+
+        std::lock_guard< std::mutex > lock( _threadBufferMutex );
+
+        auto buffer = _threadBuffers.find( std::this_thread::get_id( ) );
+
+        if ( buffer != _threadBuffers.end( ) ){
+
+            return *buffer->second;
+
+        }
+
+        return std::cerr;
+    }
+
+    void couplingLogger::bufferThreadMessages( ){
+        /*!
+         * Buffer the messages of the calling thread until releaseThreadMessages is called
+         */
+
+        std::lock_guard< std::mutex > lock( _threadBufferMutex );
+
+        auto buffer = _threadBuffers.find( std::this_thread::get_id( ) );
+
+        if ( buffer == _threadBuffers.end( ) ){
+
+            _threadBuffers.emplace( std::this_thread::get_id( ), std::make_shared< std::ostringstream >( ) );
+
+        }
+    }
+
+    std::string couplingLogger::releaseThreadMessages( ){
+        /*!
+         * Stop buffering the messages of the calling thread and return the buffered messages
+         */
+
+        std::lock_guard< std::mutex > lock( _threadBufferMutex );
+
+        auto buffer = _threadBuffers.find( std::this_thread::get_id( ) );
+
+        if ( buffer == _threadBuffers.end( ) ){
+
+            return "";
+
+        }
+
+        std::string messages = buffer->second->str( );
+
+        _threadBuffers.erase( buffer );
+
+        return messages;
+    }
+
+    errorOut couplingLogger::openDebugFile( const std::string &filename, const std::string &format ){
+        /*!
+         * Open the file the per-node debugging tables are written to. Any previously opened file is closed.
+         *
+         * :param const std::string &filename: The name of the debug file
+         * :param const std::string &format: The format of the file. Either 'csv' or 'binary'
+         */
+
+        closeDebugFile( );
+
+        if ( format.compare( "csv" ) == 0 ){
+
+            _binaryDebugFile = false;
+            _debugFile = std::make_shared< std::ofstream >( filename );
+
+        }
+        else if ( format.compare( "binary" ) == 0 ){
+
+            _binaryDebugFile = true;
+            _debugFile = std::make_shared< std::ofstream >( filename, std::ios::out | std::ios::binary );
+
+        }
+        else{
+
+            return new errorNode( "openDebugFile", "The debug file format '" + format + "' is not recognized. Options are 'csv' and 'binary'" );
+
+        }
+
+        if ( !_debugFile->good( ) ){
+
+            _debugFile.reset( );
+            return new errorNode( "openDebugFile", "The debug file '" + filename + "' could not be opened" );
+
+        }
+
+        if ( !_binaryDebugFile ){
+
+            *_debugFile << std::setprecision( 16 );
+
+        }
+
+        return NULL;
+    }
+
+    void couplingLogger::closeDebugFile( ){
+        /*!
+         * Close the debug file if one is open
+         */
+
+        if ( _debugFile ){
+
+            _debugFile->flush( );
+
+        }
+
+        _debugFile.reset( );
+    }
+
+    bool couplingLogger::writesDebugTables( ) const{
+        /*!
+         * Check if the per-node debugging tables will be written. The tables are only written
+         * when the debug level is enabled and a debug file is open.
+         */
+
+        return isEnabled( LOG_DEBUG ) && _debugFile;
+    }
+
+    void couplingLogger::writeDebugTableRow( const std::string &tableName, const uIntType &globalNodeID,
+                                             const uIntType &localNodeID, const floatVector &values ){
+        /*!
+         * Write a row of a per-node debugging table to the debug file. Nothing is written if the
+         * tables are disabled.
+         *
+         * :param const std::string &tableName: The name of the table
+         * :param const uIntType &globalNodeID: The global ID of the node
+         * :param const uIntType &localNodeID: The local ID of the node
+         * :param const floatVector &values: The values of the row
+         */
+
+        if ( !writesDebugTables( ) ){
+
+            return;
+
+        }
+
+        if ( _binaryDebugFile ){
+
+            uint32_t header[ 4 ] = { ( uint32_t )tableName.size( ), ( uint32_t )globalNodeID, ( uint32_t )localNodeID, ( uint32_t )values.size( ) };
+            _debugFile->write( reinterpret_cast< const char* >( header ), sizeof( uint32_t ) );
+            _debugFile->write( tableName.data( ), tableName.size( ) );
+            _debugFile->write( reinterpret_cast< const char* >( header + 1 ), 3 * sizeof( uint32_t ) );
+            _debugFile->write( reinterpret_cast< const char* >( values.data( ) ), values.size( ) * sizeof( floatType ) );
+
+        }
+        else{
+
+            *_debugFile << tableName << "," << globalNodeID << "," << localNodeID;
+
+            for ( auto v = values.begin( ); v != values.end( ); v++ ){
+
+                *_debugFile << "," << *v;
+
+            }
+
+            *_debugFile << "\n";
+
+        }
+
+        return;
+    }
+
 }
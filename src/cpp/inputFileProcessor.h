@@ -13,10 +13,29 @@
 #include<error_tools.h>
 #include<yaml-cpp/yaml.h>
 #include<unordered_map>
+#include<unordered_set>
+#include<map>
+#include<fstream>
+#include<memory>
+#include<thread>
+#include<mutex>
+#include<sstream>
+#include<tuple>
 #include<exception>
 
 #include<dataFileInterface.h>
 
+//The most verbose log level which is compiled in. Messages above this level are removed at compile time.
+#ifndef OVERLAP_COUPLING_MAX_LOG_LEVEL
+    #define OVERLAP_COUPLING_MAX_LOG_LEVEL 4
+#endif
+
+//Write a message to the coupling log. The message is only formatted if the level is both compiled in
+//and enabled in the logger.
+#define COUPLING_LOG( logger, level ) \
+    if ( ( ( int )( level ) > OVERLAP_COUPLING_MAX_LOG_LEVEL ) || !( logger ).isEnabled( level ) ){ } \
+    else ( logger ).getStream( )
+
 namespace inputFileProcessor{
 
     typedef errorTools::Node errorNode; //!Redefinition for the error node
@@ -33,6 +52,200 @@ namespace inputFileProcessor{
 
     class dataFileReaderBase;
 
+    //!The verbosity levels of the coupling log
+    enum logLevel { LOG_NONE = 0, LOG_ERROR = 1, LOG_WARNING = 2, LOG_INFO = 3, LOG_DEBUG = 4 };
+    const std::map< std::string, logLevel > logLevels =
+        {
+            { "none", LOG_NONE },
+            { "error", LOG_ERROR },
+            { "warning", LOG_WARNING },
+            { "info", LOG_INFO },
+            { "debug", LOG_DEBUG }
+        };
+
+    class couplingLogger {
+        /*!
+         * Level gated logging for the overlap coupling. Messages are written to standard error
+         * and the per-node debugging tables are written to an optional debug file in either a
+         * CSV or a binary format. Nothing is formatted or written for disabled levels.
+         *
+         * A CSV row is
+         *     table_name, global_node_id, local_node_id, value_1, value_2, ...
+         *
+         * and a binary row is
+         *     uint32 name length, name characters, uint32 global node id, uint32 local node id,
+         *     uint32 number of values, double values
+         *
+         * The messages of a worker thread may be buffered so that they are not interleaved with the
+         * messages of other threads and can be written in a deterministic order once the thread is joined.
+         */
+
+        public:
+
+            couplingLogger( );
+
+            couplingLogger( const couplingLogger &other );
+
+            couplingLogger &operator=( const couplingLogger &other );
+
+            void setLevel( const logLevel &level );
+
+            logLevel getLevel( ) const;
+
+            bool isEnabled( const logLevel &level ) const;
+
+            std::ostream &getStream( );
+
+            void bufferThreadMessages( );
+
+            std::string releaseThreadMessages( );
+
+            errorOut openDebugFile( const std::string &filename, const std::string &format );
+
+            void closeDebugFile( );
+
+            bool writesDebugTables( ) const;
+
+            void writeDebugTableRow( const std::string &tableName, const uIntType &globalNodeID,
+                                     const uIntType &localNodeID, const floatVector &values );
+
+        private:
+
+            logLevel _level = LOG_INFO;
+            bool _binaryDebugFile = false;
+            std::shared_ptr< std::ofstream > _debugFile;
+
+            std::mutex _threadBufferMutex;
+            std::map< std::thread::id, std::shared_ptr< std::ostringstream > > _threadBuffers;
+
+    };
+
+    class nodeFieldContainer {
+        /*!
+         * Contiguous storage for the per-node fields of a length-scale. Each field is a single
+         * array of values with a fixed stride per node in the node ordering of the data file
+         * and all of the fields share one global-to-local node ID index.
+         *
+         * The fields are the primary storage of the node data. Per-node maps of a field are only
+         * built when they are requested. Once requested, a map keeps its address for the lifetime of
+         * the container and is rebuilt in place whenever the field or the index changes.
+         */
+
+        public:
+
+            nodeFieldContainer( );
+
+            nodeFieldContainer( const nodeFieldContainer &other );
+
+            nodeFieldContainer &operator=( const nodeFieldContainer &other );
+
+            void setIndex( const DOFMap *globalToLocalIndex );
+
+            const DOFMap *getIndex( ) const;
+
+            uIntType getNodeCount( ) const;
+
+            errorOut setField( const std::string &fieldName, const uIntType &stride, floatVector values,
+                               const floatType &scale = 1 );
+
+            errorOut setFieldFromSum( const std::string &fieldName, const stringVector &sourceFieldNames );
+
+            void clearField( const std::string &fieldName );
+
+            void clear( );
+
+            bool hasField( const std::string &fieldName ) const;
+
+            errorOut getField( const std::string &fieldName, const floatVector *&values, uIntType &stride ) const;
+
+            errorOut getLocalIndex( const uIntType &globalNodeID, uIntType &localIndex ) const;
+
+            errorOut getNodeValues( const std::string &fieldName, const uIntType &globalNodeID,
+                                    const floatType *&values, uIntType &stride ) const;
+
+            const std::unordered_map< uIntType, floatVector > *getNodeMap( const std::string &fieldName ) const;
+
+            const std::unordered_map< uIntType, floatType > *getScalarNodeMap( const std::string &fieldName ) const;
+
+        private:
+
+            struct nodeField {
+                uIntType stride = 0;
+                floatVector values;
+            };
+
+            void buildNodeMap( const std::string &fieldName, std::unordered_map< uIntType, floatVector > &nodeMap ) const;
+
+            void buildScalarNodeMap( const std::string &fieldName, std::unordered_map< uIntType, floatType > &nodeMap ) const;
+
+            void updateNodeMaps( const std::string &fieldName );
+
+            const DOFMap *_globalToLocalIndex = NULL;
+            std::unordered_map< std::string, nodeField > _fields;
+
+            mutable std::mutex _nodeMapMutex;
+            mutable std::unordered_map< std::string, std::unordered_map< uIntType, floatVector > > _nodeMaps;
+            mutable std::unordered_map< std::string, std::unordered_map< uIntType, floatType > > _scalarNodeMaps;
+
+    };
+
+    class solutionDataPrefetcher {
+        /*!
+         * A double-buffered read-ahead store for the solution data of a data file. The solution data
+         * requested while an increment is initialized is recorded and, once the increment has been
+         * initialized, the same requests are read for the next increment by a background thread. When
+         * the next increment is initialized the buffers are exchanged so the data is already in memory.
+         *
+         * When the prefetching is disabled the requests are passed straight to the data file.
+         */
+
+        public:
+
+            solutionDataPrefetcher( );
+
+            solutionDataPrefetcher( const solutionDataPrefetcher &other );
+
+            solutionDataPrefetcher &operator=( const solutionDataPrefetcher &other );
+
+            ~solutionDataPrefetcher( );
+
+            void setDataFile( const std::shared_ptr< dataFileInterface::dataFileBase > &dataFile );
+
+            void setEnabled( const bool &enabled );
+
+            bool isEnabled( ) const;
+
+            void beginIncrement( );
+
+            void prefetch( const uIntType &currentIncrement, const uIntType &nextIncrement );
+
+            void wait( );
+
+            errorOut getSolutionData( const uIntType &increment, const stringVector &componentNames,
+                                      const std::string &dataType, floatVector &data );
+
+            uIntType getNumPrefetchedReads( ) const;
+
+        private:
+
+            typedef std::tuple< uIntType, std::string, stringVector > requestKey;
+            typedef std::map< requestKey, floatVector > requestStore;
+
+            bool _enabled = false;
+
+            std::shared_ptr< dataFileInterface::dataFileBase > _dataFile;
+
+            std::vector< requestKey > _requests;
+
+            std::unique_ptr< requestStore > _current = std::unique_ptr< requestStore >( new requestStore );
+            std::unique_ptr< requestStore > _next = std::unique_ptr< requestStore >( new requestStore );
+
+            uIntType _numPrefetchedReads = 0;
+
+            std::thread _thread;
+
+    };
+
     class inputFileProcessor {
         /*!
          * The class from the file processor which 
@@ -71,6 +284,8 @@ namespace inputFileProcessor{
             errorOut setConfigurationFilename( const std::string &configurationFilename );
             errorOut getError( ){ return _error; }
 
+            errorOut reloadDataFiles( );
+
             const floatType*   getMicroTime( );
             const floatType*   getPreviousMicroTime( );
             const std::unordered_map< uIntType, floatType >* getMicroDensities( );
@@ -105,6 +320,17 @@ namespace inputFileProcessor{
             const std::unordered_map< uIntType, floatType >* getMacroArlequinWeights( );
             const std::unordered_map< uIntType, floatVector >* getMacroLumpedMassMatrix( );
 
+            const nodeFieldContainer* getMicroNodeFields( );
+            const nodeFieldContainer* getMacroNodeFields( );
+
+            std::string getPreviousFieldName( const std::string &fieldName );
+
+            errorOut getMicroDomainNodes( const unsigned int &increment, const std::string &domainName, uIntVector &domainNodes );
+
+            const std::unordered_map< std::string, uIntType >* getMicroDomainMembershipIndex( );
+            const uIntVector* getMicroDomainMembershipOffsets( );
+            const uIntVector* getMicroDomainMembershipNodes( );
+
             const floatType* getDt( );
             const floatType* getNewmarkGamma( );
             const floatType* getNewmarkBeta( );
@@ -182,6 +408,16 @@ namespace inputFileProcessor{
 
             bool useReconstructedMassCenters( );
 
+            uIntType getHomogenizationThreadCount( );
+
+            uIntType getOutputQueueSize( );
+
+            bool prefetchesNextIncrement( );
+
+            solutionDataPrefetcher* getSolutionDataPrefetcher( const std::shared_ptr< dataFileInterface::dataFileBase > &dataFile );
+
+            couplingLogger &getLogger( );
+
             bool outputReferenceInformation( );
             bool outputHomogenizedInformation( );
             bool outputUpdatedDOF( );
@@ -212,6 +448,8 @@ namespace inputFileProcessor{
             errorOut openConfigurationFile( );
             errorOut openConfigurationFile( const std::string &configurationFilename );
             errorOut setMicroNodeWeights( const unsigned int increment );
+            errorOut setMicroDomainMembership( const unsigned int &increment );
+            void clearMicroDomainMembership( );
             errorOut setSurfaceSets( const unsigned int microIncrement );
             errorOut checkCommonDomainConfiguration( YAML::Node domainConfig,
                                                      uIntVector &macroCellIds,
@@ -255,14 +493,14 @@ namespace inputFileProcessor{
             errorOut extractMicroExternalForces( const unsigned int &increment );
             errorOut extractMicroVelocities( const unsigned int &increment );
             errorOut extractMicroVelocities( const unsigned int &increment, bool &flag,
-                                             std::unordered_map< uIntType, floatVector > &microVelocities );
+                                             const std::string &fieldName );
             errorOut extractMicroAccelerations( const unsigned int &increment );
             errorOut extractMicroAccelerations( const unsigned int &increment, bool &flag,
-                                                std::unordered_map< uIntType, floatVector > &microAccelerations );
+                                                const std::string &fieldName );
             errorOut extractMicroNodeVolumes( const unsigned int &increment );
             errorOut extractMicroDisplacements( const unsigned int &increment );
             errorOut extractMicroDisplacements( const unsigned int &increment, bool &flag,
-                                                std::unordered_map< uIntType, floatVector > &microDisplacements );
+                                                const std::string &fieldName );
             errorOut extractMicroStresses( const unsigned int &increment );
             errorOut extractMicroInternalForces( const unsigned int &increment );
             errorOut extractMicroInertialForces( const unsigned int &increment );
@@ -273,13 +511,13 @@ namespace inputFileProcessor{
             errorOut extractMacroDisplacements( const unsigned int &increment );
             errorOut extractMacroDispDOFVector( const unsigned int &increment );
             errorOut extractMacroDispDOFVector( const unsigned int &increment, bool &flag,
-                                                std::unordered_map< uIntType, floatVector > &macroDispDOFVector );
+                                                const std::string &fieldName );
             errorOut extractMacroVelocities( const unsigned int &increment );
             errorOut extractMacroVelocities( const unsigned int &increment, bool &flag,
-                                             std::unordered_map< uIntType, floatVector > &macroVelocities );
+                                             const std::string &fieldName );
             errorOut extractMacroAccelerations( const unsigned int &increment );
             errorOut extractMacroAccelerations( const unsigned int &increment, bool &flag,
-                                                std::unordered_map< uIntType, floatVector > &macroAccelerations );
+                                                const std::string &fieldName );
             errorOut extractMacroInternalForces( const unsigned int &increment );
             errorOut extractMacroBodyForces( const unsigned int &increment );
             errorOut extractMacroSurfaceForces( const unsigned int &increment );
@@ -323,21 +561,10 @@ namespace inputFileProcessor{
             floatType   _previousMicroTime;
             floatType   _microTime;
             std::unordered_map< uIntType, floatType > _microDomainWeights;
-            std::unordered_map< uIntType, floatType > _microDensities;
-            std::unordered_map< uIntType, floatType > _microVolumes;
-            std::unordered_map< uIntType, floatVector > _microDisplacements;
             std::unordered_map< uIntType, floatVector > _microNodeReferencePositions;
 //            uIntVector  _microNodeReferenceConnectivityCellIndices;
 //            unsigned int _microCellCounts;
 
-            std::unordered_map< uIntType, floatVector > _microBodyForces;
-            std::unordered_map< uIntType, floatVector > _microSurfaceForces;
-            std::unordered_map< uIntType, floatVector > _microExternalForces;
-            std::unordered_map< uIntType, floatVector > _microVelocities;
-            std::unordered_map< uIntType, floatVector > _microAccelerations;
-            std::unordered_map< uIntType, floatVector > _microStresses;
-            std::unordered_map< uIntType, floatVector > _microInternalForces;
-            std::unordered_map< uIntType, floatVector > _microInertialForces;
             bool _microBodyForceFlag = false;
             bool _microSurfaceForceFlag = false;
             bool _microExternalForceFlag = false;
@@ -348,15 +575,6 @@ namespace inputFileProcessor{
 
             floatType   _previousMacroTime;
             floatType   _macroTime;
-            std::unordered_map< uIntType, floatVector > _macroDisplacements;
-            std::unordered_map< uIntType, floatVector > _macroDispDOFVector;
-            std::unordered_map< uIntType, floatVector > _macroVelocities;
-            std::unordered_map< uIntType, floatVector > _macroAccelerations;
-            std::unordered_map< uIntType, floatVector > _macroInternalForces;
-            std::unordered_map< uIntType, floatVector > _macroSurfaceForces;
-            std::unordered_map< uIntType, floatVector > _macroBodyForces;
-            std::unordered_map< uIntType, floatVector > _macroExternalForces;
-            std::unordered_map< uIntType, floatVector > _macroInertialForces;
             std::unordered_map< uIntType, floatVector > _macroNodeReferencePositions;
             std::unordered_map< uIntType, uIntVector > _macroNodeReferenceConnectivity;
             std::unordered_map< uIntType, floatType > _macroArlequinWeights;
@@ -415,15 +633,21 @@ namespace inputFileProcessor{
             bool _outputHomogenizedInformation = false;
             bool _outputUpdatedDOF = false;
             bool _useReconstructedVolumeForMassMatrix = false;
+            bool _useReconstructedMassCenters = true;
+
+            uIntType _homogenizationThreadCount = 1;
 
-            std::unordered_map< uIntType, floatVector > _previousMicroDisplacements;
-            std::unordered_map< uIntType, floatVector > _previousMacroDispDOFVector;
+            uIntType _outputQueueSize = 0;
 
-            std::unordered_map< uIntType, floatVector > _previousMicroVelocities;
-            std::unordered_map< uIntType, floatVector > _previousMacroVelocities;
+            couplingLogger _logger;
 
-            std::unordered_map< uIntType, floatVector > _previousMicroAccelerations;
-            std::unordered_map< uIntType, floatVector > _previousMacroAccelerations;
+            //The nodes of the micro domains stored in compressed row format. Domain membership is
+            //read once and re-used for every increment unless revalidation is requested.
+            bool _revalidateMicroDomainMembership = false;
+            bool _microDomainMembershipSet = false;
+            std::unordered_map< std::string, uIntType > _microDomainMembershipIndex;
+            uIntVector _microDomainMembershipOffsets;
+            uIntVector _microDomainMembershipNodes;
 
             std::unordered_map< unsigned int, std::string > _macroReferenceDensityTypes;
             std::unordered_map< unsigned int, std::string > _macroReferenceMomentOfInertiaTypes;
@@ -433,6 +657,13 @@ namespace inputFileProcessor{
             DOFMap _microGlobalNodeIDOutputIndex;
             DOFMap _macroGlobalNodeIDOutputIndex;
 
+            nodeFieldContainer _microNodeFields;
+            nodeFieldContainer _macroNodeFields;
+
+            //The read-ahead of the solution data of the next increments
+            solutionDataPrefetcher _microPrefetcher;
+            solutionDataPrefetcher _macroPrefetcher;
+
             std::unordered_map< unsigned int, stringVector > _macroCellDomainMap;
             std::unordered_map< std::string, uIntType > _microDomainIDMap;
             std::unordered_map< std::string, uIntType > _microDomainSurfaceCount;
@@ -442,6 +673,9 @@ namespace inputFileProcessor{
 
     };
 
+    void appendUniqueIds( const uIntVector &ids, boolVector &seen, std::unordered_set< uIntType > &sparseSeen,
+                          uIntVector &uniqueIds );
+
 }
 
 #endif
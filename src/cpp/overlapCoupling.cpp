@@ -9,7 +9,9 @@
 #include<micromorphic_tools.h>
 #include<balance_equations.h>
 
-#include<boost/format.hpp>
+#include<thread>
+#include<atomic>
+#include<sstream>
 
 namespace overlapCoupling{
 
@@ -47,7 +49,21 @@ namespace overlapCoupling{
 
         _error = NULL;
 
-        errorOut error = _inputProcessor.setConfigurationFilename( configurationFilename );
+        //Complete the output of the previous configuration before its writer is released
+        errorOut error = _outputQueue.flush( );
+
+        if ( error ){
+            //The error has been reported so the queue may be used by the next configuration
+            _outputQueue.resetError( );
+
+            errorOut result = new errorNode( __func__, "Error in the output of the previous configuration" );
+            result->addNext( error );
+            return result;
+        }
+
+        _homogenizedResponseWriter.reset( );
+
+        error = _inputProcessor.setConfigurationFilename( configurationFilename );
 
         if ( error ){
             errorOut result = new errorNode( __func__,
@@ -55,6 +71,15 @@ namespace overlapCoupling{
             result->addNext( error );
             return result;
         }
+
+        error = _outputQueue.setCapacity( _inputProcessor.getOutputQueueSize( ) );
+
+        if ( error ){
+            errorOut result = new errorNode( __func__, "Error in setting the size of the output queue" );
+            result->addNext( error );
+            return result;
+        }
+
         return NULL;
     }
 
@@ -66,6 +91,33 @@ namespace overlapCoupling{
         return _error;
     }
 
+    couplingLogger &overlapCoupling::getLogger( ){
+        /*!
+         * Return the logger of the coupling
+         */
+
+        return _inputProcessor.getLogger( );
+    }
+
+    errorOut overlapCoupling::flushOutput( ){
+        /*!
+         * Wait until all of the queued output has been written to the output files. This should be called at
+         * the end of a run, or when a run is stopped by an error, to make sure that the output files are complete.
+         */
+
+        errorOut error = _outputQueue.flush( );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__, "Error in writing the queued output" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        return NULL;
+    }
+
     errorOut overlapCoupling::processLastIncrements( ){
         /*!
          * Process the final increments of the macro and micro scales
@@ -115,6 +167,26 @@ namespace overlapCoupling{
 
     }
 
+    errorOut overlapCoupling::reloadDataFiles( ){
+        /*!
+         * Re-open the data files of the input processor so that new increments may be processed
+         * without re-initializing the coupling.
+         */
+
+        errorOut error = _inputProcessor.reloadDataFiles( );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__, "Error in reloading the data files of the input processor" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        return NULL;
+
+    }
+
     errorOut overlapCoupling::processIncrement( const unsigned int &microIncrement,
                                                 const unsigned int &macroIncrement ){
         /*!
@@ -125,7 +197,7 @@ namespace overlapCoupling{
          */
 
         //Initialize the input processor
-        std::cerr << "INITIALIZE INCREMENT\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "INITIALIZE INCREMENT\n";
         errorOut error = _inputProcessor.initializeIncrement( microIncrement, macroIncrement );
 
         if ( error ){
@@ -137,7 +209,7 @@ namespace overlapCoupling{
         }
 
         //Compute the centers of mass of the free and ghost domains
-        std::cerr << "COMPUTE CENTERS OF MASS\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "COMPUTE CENTERS OF MASS\n";
         error = computeIncrementCentersOfMass( microIncrement, macroIncrement,
                                                _freeMicroDomainMasses, _ghostMicroDomainMasses,
                                                _freeMicroDomainCentersOfMass, _ghostMicroDomainCentersOfMass );
@@ -151,7 +223,7 @@ namespace overlapCoupling{
         }
 
         //Project the degrees of freedom
-        std::cerr << "PROJECT THE DEGREES OF FREEDOM\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "PROJECT THE DEGREES OF FREEDOM\n";
         YAML::Node couplingConfiguration = _inputProcessor.getCouplingInitialization( );
 
         domainFloatVectorMap centerOfMassDisplacements;
@@ -228,7 +300,7 @@ namespace overlapCoupling{
 
                     //Get the domain node ids
                     uIntVector microDomainNodes;
-                    errorOut error = _inputProcessor._microscale->getSubDomainNodes( microIncrement, domain->first, microDomainNodes );
+                    errorOut error = _inputProcessor.getMicroDomainNodes( microIncrement, domain->first, microDomainNodes );
     
                     if ( error ){
     
@@ -239,38 +311,45 @@ namespace overlapCoupling{
     
                     }
     
-                    const std::unordered_map< uIntType, floatVector > *microDisplacements = _inputProcessor.getMicroDisplacements( );
-                    const std::unordered_map< uIntType, floatType >   *microVolumes       = _inputProcessor.getMicroVolumes( );
-                    const std::unordered_map< uIntType, floatType >   *microDensities     = _inputProcessor.getMicroDensities( );
+                    const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
                     const std::unordered_map< uIntType, floatType >   *microWeights       = _inputProcessor.getMicroWeights( );
+                    const floatType *microDisplacement, *microVolume, *microDensity;
+                    uIntType stride;
                       
                     domainAMatrix = floatVector( _dim * _dim, 0 );
+                    floatVector microDisplacementDifference( _dim );
                     for ( auto it = microDomainNodes.begin( ); it != microDomainNodes.end( ); it++ ){
     
-                        auto microDisplacement = microDisplacements->find( *it );
+                        error = microNodeFields->getNodeValues( "displacement", *it, microDisplacement, stride );
     
-                        if ( microDisplacement == microDisplacements->end( ) ){
+                        if ( error ){
     
-                            return new errorNode( __func__, "Micro node " + std::to_string( *it ) +
-                                                  " was not found in the micro displacement map" );
+                            errorOut result = new errorNode( __func__, "Micro node " + std::to_string( *it ) +
+                                                             " was not found in the micro displacement field" );
+                            result->addNext( error );
+                            return result;
     
                         }
 
-                        auto microVolume = microVolumes->find( *it );
+                        error = microNodeFields->getNodeValues( "volume", *it, microVolume, stride );
 
-                        if ( microVolume == microVolumes->end( ) ){
+                        if ( error ){
 
-                            return new errorNode( __func__, "Micro node " + std::to_string( *it ) +
-                                                                      " was not found in the micro volume map" );
+                            errorOut result = new errorNode( __func__, "Micro node " + std::to_string( *it ) +
+                                                             " was not found in the micro volume field" );
+                            result->addNext( error );
+                            return result;
 
                         }
 
-                        auto microDensity = microDensities->find( *it );
+                        error = microNodeFields->getNodeValues( "density", *it, microDensity, stride );
 
-                        if ( microDensity == microDensities->end( ) ){
+                        if ( error ){
 
-                            return new errorNode( __func__, "Micro node " + std::to_string( *it ) +
-                                                                      " was not found in the micro density map" );
+                            errorOut result = new errorNode( __func__, "Micro node " + std::to_string( *it ) +
+                                                             " was not found in the micro density field" );
+                            result->addNext( error );
+                            return result;
 
                         }
 
@@ -292,9 +371,15 @@ namespace overlapCoupling{
 
                         }
 
-                        domainAMatrix += vectorTools::appendVectors( vectorTools::dyadic( microDisplacement->second - centerOfMassDisplacements[domain->first],
+                        for ( unsigned int i = 0; i < _dim; i++ ){
+
+                            microDisplacementDifference[ i ] = microDisplacement[ i ] - centerOfMassDisplacements[ domain->first ][ i ];
+
+                        }
+
+                        domainAMatrix += vectorTools::appendVectors( vectorTools::dyadic( microDisplacementDifference,
                                                                                           microReferencePosition->second - domain->second ) )
-                                       * microVolume->second * microDensity->second * microWeight->second / domainMass->second;
+                                       * ( *microVolume ) * ( *microDensity ) * microWeight->second / domainMass->second;
 
                     }
 
@@ -511,7 +596,7 @@ namespace overlapCoupling{
 //        }
 
         //Homogenize the material properties at the micro-scale to the macro-scale
-        std::cerr << "HOMOGENIZE THE MICROSCALE\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "HOMOGENIZE THE MICROSCALE\n";
         error = homogenizeMicroScale( microIncrement );
     
         if ( error ){
@@ -609,7 +694,7 @@ namespace overlapCoupling{
 
                 //Get the domain node ids
                 uIntVector microDomainNodes;
-                errorOut error = _inputProcessor._microscale->getSubDomainNodes( microIncrement, *domain, microDomainNodes );
+                errorOut error = _inputProcessor.getMicroDomainNodes( microIncrement, *domain, microDomainNodes );
 
                 if ( error ){
 
@@ -622,7 +707,9 @@ namespace overlapCoupling{
 
                 unsigned int index = 0;
                 const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
-                const std::unordered_map< uIntType, floatVector > *microDisplacements      = _inputProcessor.getMicroDisplacements( );
+                const inputFileProcessor::nodeFieldContainer *microNodeFields              = _inputProcessor.getMicroNodeFields( );
+                const floatType *microDisplacement;
+                uIntType stride;
                 uIntVector interiorNodes;
 
                 for ( auto it = microDomainNodes.begin( ); it != microDomainNodes.end( ); it++, index++ ){
@@ -636,12 +723,14 @@ namespace overlapCoupling{
 
                     }
 
-                    auto microDisplacement = microDisplacements->find( *it );
+                    error = microNodeFields->getNodeValues( "displacement", *it, microDisplacement, stride );
 
-                    if ( microDisplacement == microDisplacements->end( ) ){
+                    if ( error ){
 
-                        return new errorNode( __func__, "Micro node " + std::to_string( *it ) +
-                                              " was not found in the micro displacement map" );
+                        errorOut result = new errorNode( __func__, "Micro node " + std::to_string( *it ) +
+                                                         " was not found in the micro displacement field" );
+                        result->addNext( error );
+                        return result;
 
                     }
 
@@ -657,7 +746,7 @@ namespace overlapCoupling{
                            
                         if ( arlequinMicroWeightingFactors.find( *it ) == arlequinMicroWeightingFactors.end( ) ){
                         
-                            std::cout << "error in local coordinates\n"; 
+                            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_WARNING ) << "error in local coordinates\n"; 
                             arlequinMicroWeightingFactors.emplace( *it, 0.001 ); //The micro-node is free
 
                         }
@@ -748,24 +837,27 @@ namespace overlapCoupling{
 
 //            //Get the degree of freedom values for the free macro-domain element
 //            arlequinWeights = floatVector( element->global_node_ids.size( ), 0 );
-            const std::unordered_map< uIntType, floatVector >* macroDispDOFVector = _inputProcessor.getMacroDispDOFVector( );
+            const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
+            const floatType *macroDisplacement;
+            uIntType stride;
             floatVector elementDOFVector( 0 );
 
             for ( auto nodeID  = element->global_node_ids.begin( );
                        nodeID != element->global_node_ids.end( );
                        nodeID++ ){
 
-                auto macroDisplacement = macroDispDOFVector->find( *nodeID );
+                error = macroNodeFields->getNodeValues( "displacement_dof", *nodeID, macroDisplacement, stride );
 
-                if ( macroDisplacement == macroDispDOFVector->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( *nodeID ) + " was not found in the macro displacement DOF vector map" );
+                    errorOut result = new errorNode( __func__,
+                                                     "Macro node " + std::to_string( *nodeID ) + " was not found in the macro displacement DOF field" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                elementDOFVector
-                    = vectorTools::appendVectors( { elementDOFVector, macroDisplacement->second } );
+                elementDOFVector.insert( elementDOFVector.end( ), macroDisplacement, macroDisplacement + stride );
 
                 auto weight = macroArlequinWeights->find( *nodeID );
 
@@ -930,18 +1022,12 @@ namespace overlapCoupling{
         //Get the macro properties
         const std::unordered_map< uIntType, floatType > *macroArlequinWeights = _inputProcessor.getMacroArlequinWeights( );
 
-        //Get the forces
-        const std::unordered_map< uIntType, floatVector > *microInternalForces = _inputProcessor.getMicroInternalForces( );
-        const std::unordered_map< uIntType, floatVector > *microInertialForces = _inputProcessor.getMicroInertialForces( );
-        const std::unordered_map< uIntType, floatVector > *microExternalForces = _inputProcessor.getMicroExternalForces( );
-
-        //Get the degree of freedom vectors
-        const std::unordered_map< uIntType, floatVector > *microDisplacements = _inputProcessor.getMicroDisplacements( );
-
-        const std::unordered_map< uIntType, floatVector > *macroInternalForces = _inputProcessor.getMacroInternalForces( );
-        const std::unordered_map< uIntType, floatVector > *macroInertialForces = _inputProcessor.getMacroInertialForces( );
-        const std::unordered_map< uIntType, floatVector > *macroExternalForces = _inputProcessor.getMacroExternalForces( );
-        const std::unordered_map< uIntType, floatVector > *macroDispDOFVector = _inputProcessor.getMacroDispDOFVector( );
+        //Get the forces and the degree of freedom vectors
+        const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+        const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
+        const floatType *nodeValues;
+        uIntType stride;
+        errorOut error;
 
         const floatType mu = *_inputProcessor.getArlequinPenaltyParameter( );
 
@@ -961,63 +1047,80 @@ namespace overlapCoupling{
             //Get the external force contribution
             if( _inputProcessor.microExternalForceDefined( ) ){
 
-                auto externalForce = microExternalForces->find( node->first );
-//                std::cerr << "    external force: "; vectorTools::print( externalForce->second );
+                error = microNodeFields->getNodeValues( "external_force", node->first, nodeValues, stride );
     
-                if ( externalForce == microExternalForces->end( ) ){
+                if ( error ){
     
-                    return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                          " not found in external force vector" );
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                     " not found in external force vector" );
+                    result->addNext( error );
+                    return result;
     
                 }
 
-                nodeForce -= externalForce->second;
+                for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
+
+                    nodeForce[ i ] -= nodeValues[ i ];
+
+                }
 
             }
 
             //Get the internal force contribution
             if( _inputProcessor.microInternalForceDefined( ) ){
 
-                auto internalForce = microInternalForces->find( node->first );
-//                std::cerr << "    internal force: "; vectorTools::print( internalForce->second );
+                error = microNodeFields->getNodeValues( "internal_force", node->first, nodeValues, stride );
     
-                if ( internalForce == microInternalForces->end( ) ){
+                if ( error ){
     
-                    return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                          " not found in internal force vector" );
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                     " not found in internal force vector" );
+                    result->addNext( error );
+                    return result;
     
                 }
 
-                nodeForce += internalForce->second;
+                for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
+
+                    nodeForce[ i ] += nodeValues[ i ];
+
+                }
 
             }
 
             if( _inputProcessor.microInertialForceDefined( ) ){
 
-                auto inertialForce = microInertialForces->find( node->first );
+                error = microNodeFields->getNodeValues( "inertial_force", node->first, nodeValues, stride );
 
-                if ( inertialForce == microInertialForces->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                          " not found in inertial force vector" );
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                     " not found in inertial force vector" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                nodeForce += inertialForce->second;
+                for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
+
+                    nodeForce[ i ] += nodeValues[ i ];
+
+                }
 
             }
 
-            auto microDisplacement = microDisplacements->find( node->first );
+            const floatType *microDisplacement;
+            error = microNodeFields->getNodeValues( "displacement", node->first, microDisplacement, stride );
 
-            if ( microDisplacement == microDisplacements->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                      " not found in micro displacement vector" );
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                 " not found in micro displacement vector" );
+                result->addNext( error );
+                return result;
 
             }
 
-//            std::cerr << "    displacement: "; vectorTools::print( microDisplacement->second );
-
             //Get the arlequin weight
             auto arlequinWeight = arlequinMicroWeightingFactors.find( node->first );
             if ( arlequinWeight == arlequinMicroWeightingFactors.end( ) ){
@@ -1029,8 +1132,8 @@ namespace overlapCoupling{
 
             for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
 
-                RHS[ nMicroDispDOF * node->second + i ] += ( 1 - arlequinWeight->second ) * nodeForce[ i ] + mu * microDisplacement->second[i];
-                G[ nMicroDispDOF * node->second + i ] -= microDisplacement->second[ i ];
+                RHS[ nMicroDispDOF * node->second + i ] += ( 1 - arlequinWeight->second ) * nodeForce[ i ] + mu * microDisplacement[ i ];
+                G[ nMicroDispDOF * node->second + i ] -= microDisplacement[ i ];
 
             }
 
@@ -1049,64 +1152,82 @@ namespace overlapCoupling{
             //Add the external force contribution
             if ( _inputProcessor.macroExternalForceDefined( ) ){
 
-                auto externalForce = macroExternalForces->find( node->first );
+                error = macroNodeFields->getNodeValues( "external_force", node->first, nodeValues, stride );
 
-                if ( externalForce == macroExternalForces->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( node->first ) + " not found in external force map" );
+                    errorOut result = new errorNode( __func__,
+                                                     "Macro node " + std::to_string( node->first ) + " not found in external force field" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                nodeForce -= externalForce->second;
+                for ( uIntType i = 0; i < nMacroDispDOF; i++ ){
+
+                    nodeForce[ i ] -= nodeValues[ i ];
+
+                }
 
             }
 
             //Add the internal force contribution
             if ( _inputProcessor.macroInternalForceDefined( ) ){
 
-                auto internalForce = macroInternalForces->find( node->first );
-//                std::cerr << "    internal force: "; vectorTools::print( internalForce->second );
+                error = macroNodeFields->getNodeValues( "internal_force", node->first, nodeValues, stride );
 
-                if ( internalForce == macroInternalForces->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( node->first ) + " not found in internal force map" );
+                    errorOut result = new errorNode( __func__,
+                                                     "Macro node " + std::to_string( node->first ) + " not found in internal force field" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                nodeForce += internalForce->second;
+                for ( uIntType i = 0; i < nMacroDispDOF; i++ ){
+
+                    nodeForce[ i ] += nodeValues[ i ];
+
+                }
 
             }
 
             // Add the inertial force contribution
             if ( _inputProcessor.macroInertialForceDefined( ) ){
 
-                auto inertialForce = macroInertialForces->find( node->first );
+                error = macroNodeFields->getNodeValues( "inertial_force", node->first, nodeValues, stride );
 
-                if ( inertialForce == macroInertialForces->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( node->first ) + " not found in inertial force map" );
+                    errorOut result = new errorNode( __func__,
+                                                     "Macro node " + std::to_string( node->first ) + " not found in inertial force field" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                nodeForce += inertialForce->second;
+                for ( uIntType i = 0; i < nMacroDispDOF; i++ ){
+
+                    nodeForce[ i ] += nodeValues[ i ];
+
+                }
 
             }
 
             // Add the deformation force
-            auto macroDispDOF = macroDispDOFVector->find( node->first );
+            const floatType *macroDispDOF;
+            error = macroNodeFields->getNodeValues( "displacement_dof", node->first, macroDispDOF, stride );
 
-            if ( macroDispDOF == macroDispDOFVector->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
-                                      " not found in macro displacement DOF map" );
+                errorOut result = new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
+                                                 " not found in macro displacement DOF field" );
+                result->addNext( error );
+                return result;
 
             }
 
-//            std::cerr << "    deformation: "; vectorTools::print(macroDispDOF->second);
-
             //Get the Macro Arlequin weight
             auto arlequinWeight =  macroArlequinWeights->find( node->first );
             if ( arlequinWeight == macroArlequinWeights->end( ) ){
@@ -1119,7 +1240,7 @@ namespace overlapCoupling{
             for ( uIntType i = 0; i < nMacroDispDOF; i++ ){
 
                 RHS_D[ nMacroDispDOF * node->second + i ] += arlequinWeight->second * nodeForce[ i ];
-                D[ nMacroDispDOF * node->second + i ] = macroDispDOF->second[ i ];
+                D[ nMacroDispDOF * node->second + i ] = macroDispDOF[ i ];
 
             }
 
@@ -1138,22 +1259,28 @@ namespace overlapCoupling{
         Eigen::Map< Eigen::Matrix< floatType, -1,  1 > > macroCouplingForce( FALD.data(), FALD.size( ), 1 );
         Eigen::Map< Eigen::Matrix< floatType, -1, 1 > > _G( G.data( ), G.size( ), 1 );
         Eigen::Map< Eigen::Matrix< floatType, -1, 1 > > _D( D.data( ), D.size( ), 1 );
-        std::cerr << "forming G\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "forming G\n";
         _G += _N * _D;
 
-        std::cerr << "forming RHS\n";
-        _RHS -= ( _N * _RHS_D + mu * ( _N * _N.transpose( ) * _G + _G ) );
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "forming RHS\n";
+        _RHS -= ( _N * _RHS_D + mu * ( _N * ( _N.transpose( ) * _G ) + _G ) );
 
-        std::cerr << "forming LHS\n";
-        SparseMatrix _LHS = _N * _N.transpose( );
-        _LHS.diagonal( ).array( ) += 1;
+        //The row sums of N N^T + I are computed without forming N N^T
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "diagonalizing LHS\n";
+        Eigen::VectorXd _LHS_vec;
+        error = computeLumpedGramDiagonal( _N, Eigen::VectorXd::Ones( _N.cols( ) ), 1, _LHS_vec );
 
-        std::cerr << "diagonalizing LHS\n";
-        Eigen::Matrix< floatType, -1, 1 > _LHS_vec = _LHS * Eigen::VectorXd::Ones( _LHS.cols( ) );
+        if ( error ){
+
+            errorOut result = new errorNode( __func__, "Error in the computation of the lumped LHS matrix" );
+            result->addNext( error );
+            return result;
 
-        std::cerr << "building micro coupling force\n";
+        }
+
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "building micro coupling force\n";
         microCouplingForce = _RHS.array( ) / _LHS_vec.array( );
-        std::cerr << "building macro coupling force\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "building macro coupling force\n";
         macroCouplingForce = _N.transpose( ) * microCouplingForce;
 
 //        std::cerr << "outputting G\n";
@@ -1266,29 +1393,21 @@ namespace overlapCoupling{
         const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
         const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-        //Get the micro properties
-        const std::unordered_map< uIntType, floatType > *microDensities = _inputProcessor.getMicroDensities( );
-        const std::unordered_map< uIntType, floatType > *microVolumes = _inputProcessor.getMicroVolumes( );
-
         //Get the macro properties
         const std::unordered_map< uIntType, floatType > *macroArlequinWeights = _inputProcessor.getMacroArlequinWeights( );
 
-        //Get the forces
-        const std::unordered_map< uIntType, floatVector > *microInternalForces = _inputProcessor.getMicroInternalForces( );
-        const std::unordered_map< uIntType, floatVector > *microExternalForces = _inputProcessor.getMicroExternalForces( );
+        //Get the node fields which store the properties, forces, and degree of freedom vectors
+        const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+        const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
 
-        const std::unordered_map< uIntType, floatVector > *macroInternalForces = _inputProcessor.getMacroInternalForces( );
-        const std::unordered_map< uIntType, floatVector > *macroExternalForces = _inputProcessor.getMacroExternalForces( );
+        const std::string previousDisplacementName    = _inputProcessor.getPreviousFieldName( "displacement" );
+        const std::string previousDispDOFName         = _inputProcessor.getPreviousFieldName( "displacement_dof" );
+        const std::string previousVelocityName        = _inputProcessor.getPreviousFieldName( "velocity" );
+        const std::string previousAccelerationName    = _inputProcessor.getPreviousFieldName( "acceleration" );
 
-
-        //Get the degree of freedom vectors
-        const std::unordered_map< uIntType, floatVector > *previousMicroDisplacements = _inputProcessor.getPreviousMicroDisplacements( );
-        const std::unordered_map< uIntType, floatVector > *previousMicroVelocities    = _inputProcessor.getPreviousMicroVelocities( );
-        const std::unordered_map< uIntType, floatVector > *previousMicroAccelerations = _inputProcessor.getPreviousMicroAccelerations( );
-
-        const std::unordered_map< uIntType, floatVector > *previousMacroDispDOFVector = _inputProcessor.getPreviousMacroDispDOFVector( );
-        const std::unordered_map< uIntType, floatVector > *previousMacroVelocities    = _inputProcessor.getPreviousMacroVelocities( );
-        const std::unordered_map< uIntType, floatVector > *previousMacroAccelerations = _inputProcessor.getPreviousMacroAccelerations( );
+        const floatType *nodeValues, *microDensity, *microVolume;
+        uIntType stride;
+        errorOut error;
 
         floatType aQ = config[ "micro_proportionality_coefficient" ].as< floatType >( );
         floatType aD = config[ "macro_proportionality_coefficient" ].as< floatType >( );
@@ -1310,100 +1429,127 @@ namespace overlapCoupling{
             //Get the external force contribution
             if( _inputProcessor.microExternalForceDefined( ) ){
 
-                auto externalForce = microExternalForces->find( node->first );
-//                std::cerr << "    external force: "; vectorTools::print( externalForce->second );
-    
-                if ( externalForce == microExternalForces->end( ) ){
-    
-                    return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                          " not found in external force vector" );
-    
+                error = microNodeFields->getNodeValues( "external_force", node->first, nodeValues, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                               " not found in external force vector" );
+                    result->addNext( error );
+                    return result;
+
                 }
 
-                nodeForce += externalForce->second;
+                for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
+
+                    nodeForce[ i ] += nodeValues[ i ];
+
+                }
 
             }
 
             //Get the internal force contribution
             if( _inputProcessor.microInternalForceDefined( ) ){
 
-                auto internalForce = microInternalForces->find( node->first );
-//                std::cerr << "    internal force: "; vectorTools::print( internalForce->second );
-    
-                if ( internalForce == microInternalForces->end( ) ){
-    
-                    return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                          " not found in internal force vector" );
-    
+                error = microNodeFields->getNodeValues( "internal_force", node->first, nodeValues, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                               " not found in internal force vector" );
+                    result->addNext( error );
+                    return result;
+
                 }
 
-                nodeForce -= internalForce->second;
+                for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
+
+                    nodeForce[ i ] -= nodeValues[ i ];
+
+                }
 
             }
 
-            auto microDensity = microDensities->find( node->first );
+            error = microNodeFields->getNodeValues( "density", node->first, microDensity, stride );
 
-            if ( microDensity == microDensities->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                      " not found in micro densities vector" );
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                           " not found in micro densities vector" );
+                result->addNext( error );
+                return result;
 
             }
 
-            auto microVolume = microVolumes->find( node->first );
+            error = microNodeFields->getNodeValues( "volume", node->first, microVolume, stride );
 
-            if ( microVolume == microVolumes->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                      " not found in micro volumes vector" );
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                           " not found in micro volumes vector" );
+                result->addNext( error );
+                return result;
 
             }
 
-            floatVector qe( 3, 0 );
-            auto microDisplacement = previousMicroDisplacements->find( node->first );
+            error = microNodeFields->getNodeValues( previousDisplacementName, node->first, nodeValues, stride );
 
-            if ( microDisplacement == previousMicroDisplacements->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                      " not found in micro displacement vector" );
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                           " not found in micro displacement vector" );
+                result->addNext( error );
+                return result;
 
             }
 
-            qe = microDisplacement->second;
+            floatVector qe( nodeValues, nodeValues + nMicroDispDOF );
 
             //Get the velocity contribution to the damping force and error
             if ( _inputProcessor.microVelocitiesDefined( ) ){
 
-                auto microVelocity = previousMicroVelocities->find( node->first );
+                error = microNodeFields->getNodeValues( previousVelocityName, node->first, nodeValues, stride );
 
-                if ( microVelocity == previousMicroVelocities->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                          " not found in previous micro velocities vector" );
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                               " not found in previous micro velocities vector" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                nodeForce -= aQ * microDensity->second * microVolume->second * microVelocity->second;
+                for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
 
-                qe += ( *dt ) * microVelocity->second;
+                    nodeForce[ i ] -= aQ * ( *microDensity ) * ( *microVolume ) * nodeValues[ i ];
+
+                    qe[ i ] += ( *dt ) * nodeValues[ i ];
+
+                }
 
             }
 
             //Get the acceleration contribution to the damping force
             if ( _inputProcessor.microAccelerationDefined( ) ){
 
-                auto microAcceleration = previousMicroAccelerations->find( node->first );
+                error = microNodeFields->getNodeValues( previousAccelerationName, node->first, nodeValues, stride );
 
-                if ( microAcceleration == previousMicroAccelerations->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                          " not found in previous micro accelerations vector" );
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                               " not found in previous micro accelerations vector" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                nodeForce -= aQ * microDensity->second * microVolume->second * ( 1 - gamma ) * ( *dt ) * microAcceleration->second;
+                for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
+
+                    nodeForce[ i ] -= aQ * ( *microDensity ) * ( *microVolume ) * ( 1 - gamma ) * ( *dt ) * nodeValues[ i ];
+
+                    qe[ i ] += 0.5 * ( *dt ) * ( *dt ) * ( 1 - 2 * beta ) * nodeValues[ i ];
 
-                qe += 0.5 * ( *dt ) * ( *dt ) * ( 1 - 2 * beta ) * microAcceleration->second;
+                }
 
             }
 
@@ -1444,68 +1590,89 @@ namespace overlapCoupling{
             //Add the external force contribution
             if ( _inputProcessor.macroExternalForceDefined( ) ){
 
-                auto externalForce = macroExternalForces->find( node->first );
-                std::cerr << "    external force: "; vectorTools::print( externalForce->second );
+                error = macroNodeFields->getNodeValues( "external_force", node->first, nodeValues, stride );
 
-                if ( externalForce == macroExternalForces->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( node->first ) + " not found in external force map" );
+                    errorOut result = new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
+                                                               " not found in external force field" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+                for ( uIntType i = 0; i < nMacroDispDOF; i++ ){
+
+                    nodeForce[ i ] += nodeValues[ i ];
 
                 }
 
-                nodeForce += externalForce->second;
+                if ( _inputProcessor.getLogger( ).writesDebugTables( ) ){
+
+                    _inputProcessor.getLogger( ).writeDebugTableRow( "macro_external_force", node->first, node->second,
+                                                                     floatVector( nodeValues, nodeValues + stride ) );
+
+                }
 
             }
 
             //Add the internal force contribution
             if ( _inputProcessor.macroInternalForceDefined( ) ){
 
-                auto internalForce = macroInternalForces->find( node->first );
-//                std::cerr << "    internal force: "; vectorTools::print( internalForce->second );
+                error = macroNodeFields->getNodeValues( "internal_force", node->first, nodeValues, stride );
 
-                if ( internalForce == macroInternalForces->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( node->first ) + " not found in internal force map" );
+                    errorOut result = new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
+                                                               " not found in internal force field" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                nodeForce -= internalForce->second;
+                for ( uIntType i = 0; i < nMacroDispDOF; i++ ){
+
+                    nodeForce[ i ] -= nodeValues[ i ];
+
+                }
 
             }
 
-            auto macroDisplacement = previousMacroDispDOFVector->find( node->first );
+            error = macroNodeFields->getNodeValues( previousDispDOFName, node->first, nodeValues, stride );
 
-            if ( macroDisplacement == previousMacroDispDOFVector->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
-                                      " not found in macro displacement vector" );
+                errorOut result = new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
+                                                           " not found in macro displacement vector" );
+                result->addNext( error );
+                return result;
 
             }
 
-            for ( uIntType i = 0; i < macroDisplacement->second.size( ); i++ ){
+            for ( uIntType i = 0; i < stride; i++ ){
 
-                De[ nMacroDispDOF * node->second + i ] += macroDisplacement->second[ i ];
+                De[ nMacroDispDOF * node->second + i ] += nodeValues[ i ];
 
             }
 
             //Add the contribution from the previous velocity term
             if ( _inputProcessor.macroVelocitiesDefined( ) ){
 
-                auto previousVelocity = previousMacroVelocities->find( node->first );
+                error = macroNodeFields->getNodeValues( previousVelocityName, node->first, nodeValues, stride );
 
-                if ( previousVelocity == previousMacroVelocities->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( node->first ) + " not found in previous macro velocity map" );
+                    errorOut result = new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
+                                                               " not found in previous macro velocity field" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                for ( uIntType i = 0; i < previousVelocity->second.size( ); i++ ){
+                for ( uIntType i = 0; i < stride; i++ ){
 
-                    explicitVelocity[ nMacroDispDOF * node->second + i ] += previousVelocity->second[ i ];
-                    De[ nMacroDispDOF * node->second + i ] += ( *dt ) * previousVelocity->second[ i ];
+                    explicitVelocity[ nMacroDispDOF * node->second + i ] += nodeValues[ i ];
+                    De[ nMacroDispDOF * node->second + i ] += ( *dt ) * nodeValues[ i ];
 
                 }
 
@@ -1514,21 +1681,23 @@ namespace overlapCoupling{
             //Add the contribution from the previous acceleration term
             if ( _inputProcessor.macroAccelerationDefined( ) ){
 
-                auto previousAcceleration = previousMacroAccelerations->find( node->first );
+                error = macroNodeFields->getNodeValues( previousAccelerationName, node->first, nodeValues, stride );
 
-                if ( previousAcceleration == previousMacroAccelerations->end( ) ){
+                if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( node->first ) + " not found in previous macro acceleration map" );
+                    errorOut result = new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
+                                                               " not found in previous macro acceleration field" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                for ( uIntType i = 0; i < previousAcceleration->second.size( ); i++ ){
+                for ( uIntType i = 0; i < stride; i++ ){
 
                     explicitVelocity[ nMacroDispDOF * node->second + i ]
-                        += ( 1 - gamma ) * ( *dt ) * previousAcceleration->second[ i ];
+                        += ( 1 - gamma ) * ( *dt ) * nodeValues[ i ];
                     De[ nMacroDispDOF * node->second + i ] += 0.5 * ( *dt ) * ( *dt ) * ( 1 - 2 * beta )
-                                                            * previousAcceleration->second[ i ];
+                                                            * nodeValues[ i ];
 
                 }
 
@@ -1577,6 +1746,49 @@ namespace overlapCoupling{
         return NULL;
     }
 
+    void overlapCoupling::writeArlequinMicroDebugTable( const std::string &tableName, const Eigen::VectorXd &MQ,
+                                                        const Eigen::Ref< const Eigen::VectorXd > &values ){
+        /*!
+         * Write a per micro-node table of the Arlequin deformation update to the debug file. The columns
+         * are the nodal mass, the coupling weight, the reference position, and the nodal values.
+         *
+         * :param const std::string &tableName: The name of the table
+         * :param const Eigen::VectorXd &MQ: The micro mass vector
+         * :param const Eigen::Ref< const Eigen::VectorXd > &values: The micro nodal values
+         */
+
+        couplingLogger &logger = _inputProcessor.getLogger( );
+
+        const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
+        const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
+
+        for ( auto node = microGlobalToLocalDOFMap->begin( ); node != microGlobalToLocalDOFMap->end( ); node++ ){
+
+            floatVector row = { MQ[ _dim * node->second ], 0 };
+
+            auto weight = arlequinMicroWeightingFactors.find( node->first );
+            if ( weight != arlequinMicroWeightingFactors.end( ) ){
+
+                row[ 1 ] = 1 - weight->second;
+
+            }
+
+            auto mnp = microReferencePositions->find( node->first );
+            if ( mnp != microReferencePositions->end( ) ){
+
+                row.insert( row.end( ), mnp->second.begin( ), mnp->second.end( ) );
+
+            }
+
+            row.insert( row.end( ), values.data( ) + _dim * node->second, values.data( ) + _dim * ( node->second + 1 ) );
+
+            logger.writeDebugTableRow( tableName, node->first, node->second, row );
+
+        }
+
+        return;
+    }
+
     errorOut overlapCoupling::computeArlequinDeformationUpdate( ){
         /*!
          * Compute the deformation update using the Arlequin method
@@ -1606,24 +1818,13 @@ namespace overlapCoupling{
         const std::unordered_map< uIntType, uIntType > *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
         const std::unordered_map< uIntType, uIntType > *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-        //Required properties to compute the micro mass vector
-        const std::unordered_map< uIntType, floatType > *microDensities = _inputProcessor.getMicroDensities( );
-        const std::unordered_map< uIntType, floatType > *microVolumes = _inputProcessor.getMicroVolumes( );
-
-        //Get the required DOF values
-        const std::unordered_map< uIntType, floatVector > *microDisplacements         = _inputProcessor.getMicroDisplacements( );
-        const std::unordered_map< uIntType, floatVector > *microVelocities            = _inputProcessor.getMicroVelocities( );
-        const std::unordered_map< uIntType, floatVector > *microAccelerations         = _inputProcessor.getMicroAccelerations( );
-        const std::unordered_map< uIntType, floatVector > *previousMicroDisplacements = _inputProcessor.getPreviousMicroDisplacements( );
-        const std::unordered_map< uIntType, floatVector > *previousMicroVelocities    = _inputProcessor.getPreviousMicroVelocities( );
-        const std::unordered_map< uIntType, floatVector > *previousMicroAccelerations = _inputProcessor.getPreviousMicroAccelerations( );
-
-        const std::unordered_map< uIntType, floatVector > *macroDispDOFVector         = _inputProcessor.getMacroDispDOFVector( );
-        const std::unordered_map< uIntType, floatVector > *macroVelocities            = _inputProcessor.getMacroVelocities( );
-        const std::unordered_map< uIntType, floatVector > *macroAccelerations         = _inputProcessor.getMacroAccelerations( );
-        const std::unordered_map< uIntType, floatVector > *previousMacroDispDOFVector = _inputProcessor.getPreviousMacroDispDOFVector( );
-        const std::unordered_map< uIntType, floatVector > *previousMacroVelocities    = _inputProcessor.getPreviousMacroVelocities( );
-        const std::unordered_map< uIntType, floatVector > *previousMacroAccelerations = _inputProcessor.getPreviousMacroAccelerations( );
+        //Get the node fields which store the properties required to compute the micro mass vector and the DOF values
+        const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+        const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
+        const floatType *nodeValues, *microDensity, *microVolume;
+        uIntType stride;
+        errorOut error;
+
         const std::unordered_map< uIntType, floatType > *macroArlequinWeights = _inputProcessor.getMacroArlequinWeights( );
 
         Eigen::VectorXd Q( nMicroDispDOF * microGlobalToLocalDOFMap->size( ) );
@@ -1632,24 +1833,28 @@ namespace overlapCoupling{
 
         Eigen::VectorXd MQ( nMicroDispDOF * microGlobalToLocalDOFMap->size( ) );
         Eigen::VectorXd WQ( nMicroDispDOF * microGlobalToLocalDOFMap->size( ) );
-        std::cerr << "Building Q and MQ\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "Building Q and MQ\n";
         for( auto node = microGlobalToLocalDOFMap->begin( ); node != microGlobalToLocalDOFMap->end( ); node++ ){
 
-            auto microDensity = microDensities->find( node->first );
+            error = microNodeFields->getNodeValues( "density", node->first, microDensity, stride );
 
-            if ( microDensity == microDensities->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                      " not found in micro densities vector" );
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                           " not found in micro densities vector" );
+                result->addNext( error );
+                return result;
 
             }
 
-            auto microVolume = microVolumes->find( node->first );
+            error = microNodeFields->getNodeValues( "volume", node->first, microVolume, stride );
 
-            if ( microVolume == microVolumes->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                      " not found in micro volumes vector" );
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                           " not found in micro volumes vector" );
+                result->addNext( error );
+                return result;
 
             }
 
@@ -1664,52 +1869,58 @@ namespace overlapCoupling{
 
             for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
 
-                MQ( nMicroDispDOF * node->second + i ) = ( 1 - microWeight->second ) * microDensity->second * microVolume->second;
+                MQ( nMicroDispDOF * node->second + i ) = ( 1 - microWeight->second ) * ( *microDensity ) * ( *microVolume );
 
             }
 
-            auto microDisplacement = microDisplacements->find( node->first );
+            error = microNodeFields->getNodeValues( "displacement", node->first, nodeValues, stride );
 
-            if ( microDisplacement == microDisplacements->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                      " not found in micro displacements vector" );
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                           " not found in micro displacements vector" );
+                result->addNext( error );
+                return result;
 
             }
 
             for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
 
-                Q( nMicroDispDOF * node->second + i ) = microDisplacement->second[ i ];
+                Q( nMicroDispDOF * node->second + i ) = nodeValues[ i ];
 
             }
 
-            auto microVelocity = microVelocities->find( node->first );
+            error = microNodeFields->getNodeValues( "velocity", node->first, nodeValues, stride );
 
-            if ( microVelocity == microVelocities->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                      " not found in micro velocity vector" );
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                           " not found in micro velocity vector" );
+                result->addNext( error );
+                return result;
 
             }
 
             for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
 
-                QDot( nMicroDispDOF * node->second + i ) = microVelocity->second[ i ];
+                QDot( nMicroDispDOF * node->second + i ) = nodeValues[ i ];
 
             }
 
-            auto microAcceleration = microAccelerations->find( node->first );
+            error = microNodeFields->getNodeValues( "acceleration", node->first, nodeValues, stride );
 
-            if ( microAcceleration == microAccelerations->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
-                                      " not found in micro acceleration vector" );
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( node->first ) +
+                                                           " not found in micro acceleration vector" );
+                result->addNext( error );
+                return result;
 
             }
 
             for ( uIntType i = 0; i < nMicroDispDOF; i++ ){
 
-                QDotDot( nMicroDispDOF * node->second + i ) = microAcceleration->second[ i ];
+                QDotDot( nMicroDispDOF * node->second + i ) = nodeValues[ i ];
 
             }
 
@@ -1728,48 +1939,54 @@ namespace overlapCoupling{
         Eigen::VectorXd WD( nMacroDispDOF * macroGlobalToLocalDOFMap->size( ) );
         for ( auto node = macroGlobalToLocalDOFMap->begin( ); node != macroGlobalToLocalDOFMap->end( ); node++ ){
 
-            auto macroDisplacement = macroDispDOFVector->find( node->first );
+            error = macroNodeFields->getNodeValues( "displacement_dof", node->first, nodeValues, stride );
 
-            if ( macroDisplacement == macroDispDOFVector->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
-                                      " not found in macro displacement DOF vector" );
+                errorOut result = new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
+                                                           " not found in macro displacement DOF vector" );
+                result->addNext( error );
+                return result;
 
             }
 
             for ( uIntType i = 0; i < nMacroDispDOF; i++ ){
 
-                D( nMacroDispDOF * node->second + i ) = macroDisplacement->second[ i ];
+                D( nMacroDispDOF * node->second + i ) = nodeValues[ i ];
 
             }
 
-            auto macroVelocity = macroVelocities->find( node->first );
+            error = macroNodeFields->getNodeValues( "velocity", node->first, nodeValues, stride );
 
-            if ( macroVelocity == macroVelocities->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
-                                      " not found in macro velocity DOF vector" );
+                errorOut result = new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
+                                                           " not found in macro velocity DOF vector" );
+                result->addNext( error );
+                return result;
 
             }
 
             for ( uIntType i = 0; i < nMacroDispDOF; i++ ){
 
-                DDot( nMacroDispDOF * node->second + i ) = macroVelocity->second[ i ];
+                DDot( nMacroDispDOF * node->second + i ) = nodeValues[ i ];
 
             }
 
-            auto macroAcceleration = macroAccelerations->find( node->first );
+            error = macroNodeFields->getNodeValues( "acceleration", node->first, nodeValues, stride );
 
-            if ( macroAcceleration == macroAccelerations->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
-                                      " not found in macro acceleration DOF vector" );
+                errorOut result = new errorNode( __func__, "Macro node " + std::to_string( node->first ) +
+                                                           " not found in macro acceleration DOF vector" );
+                result->addNext( error );
+                return result;
 
             }
 
             for ( uIntType i = 0; i < nMacroDispDOF; i++ ){
 
-                DDotDot( nMacroDispDOF * node->second + i ) = macroAcceleration->second[ i ];
+                DDotDot( nMacroDispDOF * node->second + i ) = nodeValues[ i ];
 
             }
 
@@ -1790,32 +2007,23 @@ namespace overlapCoupling{
 
         }
 
-        // Print statements for debugging
-        std::cerr << "Initial micro deformations\n";
-        for ( auto node = microGlobalToLocalDOFMap->begin( ); node != microGlobalToLocalDOFMap->end( ); node++ ){
+        //Write the initial deformations to the debugging tables
+        couplingLogger &logger = _inputProcessor.getLogger( );
+        if ( logger.writesDebugTables( ) ){
 
-            auto mnd = _inputProcessor.getMicroDisplacements( )->find( node->first );
-            std::cerr << boost::format( "%3i, %3i: ") % node->first % node->second;
-            for ( unsigned int i = 0; i < 3; i++ ){
+            for ( auto node = microGlobalToLocalDOFMap->begin( ); node != microGlobalToLocalDOFMap->end( ); node++ ){
 
-                std::cerr << boost::format( "%+1.7f ") % mnd->second[ i ];
+                logger.writeDebugTableRow( "initial_micro_deformation", node->first, node->second,
+                                           floatVector( Q.data( ) + nMicroDispDOF * node->second, Q.data( ) + nMicroDispDOF * ( node->second + 1 ) ) );
 
             }
-            std::cout << "\n";
-
-        }
-
-        std::cout << "\nInitial macro deformations\n";
-        for ( auto node = macroGlobalToLocalDOFMap->begin( ); node != macroGlobalToLocalDOFMap->end( ); node++ ){
 
-            auto mnd = _inputProcessor.getMacroDispDOFVector( )->find( node->first );
-            std::cerr << boost::format( "%3i, %3i: ") % node->first % node->second;
-            for ( unsigned int i = 0; i < 12; i++ ){
+            for ( auto node = macroGlobalToLocalDOFMap->begin( ); node != macroGlobalToLocalDOFMap->end( ); node++ ){
 
-                std::cerr << boost::format( "%+1.7f " ) % mnd->second[ i ];
+                logger.writeDebugTableRow( "initial_macro_deformation", node->first, node->second,
+                                           floatVector( D.data( ) + nMacroDispDOF * node->second, D.data( ) + nMacroDispDOF * ( node->second + 1 ) ) );
 
             }
-            std::cerr << "\n";
 
         }
 
@@ -1894,8 +2102,9 @@ namespace overlapCoupling{
 //        std::cout << "AQ:\n" << AQ << "\n";
 //
 //
+        //The diagonal scalings are applied to vectors before they are multiplied by N so that no scaled copy of N is formed
         Eigen::VectorXd RHS = _N * _De - _Qe
-                            + beta * ( *dt ) * ( *dt ) * ( _N * AD.asDiagonal( ) * ( _FD + mu_update * WD.asDiagonal( ) * ( D - _De ) ) - AQ.asDiagonal( ) * ( _FQ + mu_update * WQ.asDiagonal( ) * ( Q - _Qe ) ) );
+                            + beta * ( *dt ) * ( *dt ) * ( _N * AD.cwiseProduct( _FD + mu_update * WD.cwiseProduct( D - _De ) ) - AQ.cwiseProduct( _FQ + mu_update * WQ.cwiseProduct( Q - _Qe ) ) );
 
 //        std::cout << "RHS:\n" << RHS << "\n";
 
@@ -1908,35 +2117,28 @@ namespace overlapCoupling{
 //        lagrangeSolver.compute( LHS );
 //        Eigen::VectorXd _Lagrange = lagrangeSolver.solve( RHS );
 
-        // Compute the diagonal LHS matrix
-        Eigen::VectorXd LHS = ( beta * ( *dt ) * ( *dt ) * _N * AD.asDiagonal( ) * _N.transpose( ) ) * Eigen::VectorXd::Ones( _N.rows() );
-        LHS += beta * ( *dt ) * ( *dt ) * AQ;
-
-        // Solve for the Lagrange multipliers
-        Eigen::VectorXd _Lagrange = RHS.cwiseProduct( LHS.cwiseInverse( ) );
-
-        std::cout << "LAGRANGE:\n";
-        uIntType _indx = 0;
-        std::cerr << "gid, lid: mass      weight    R_1        R_2        R_3        L_1        L_2        L_3\n";
-        for ( auto node = microGlobalToLocalDOFMap->begin( ); node != microGlobalToLocalDOFMap->end( ); node++, _indx++ ){
+        // Compute the diagonal LHS matrix from the row sums of N diag( AD ) N^T without forming the product
+        Eigen::VectorXd LHS;
+        error = computeLumpedGramDiagonal( _N, AD, 0, LHS );
 
-            std::cerr << boost::format( "%3i, %3i: ") % node->first % node->second;
-            std::cerr << boost::format( "%1.7f " ) % MQ[ _dim * node->second ];
-            std::cerr << boost::format( "%1.7f " ) % (1 - arlequinMicroWeightingFactors.find( node->first )->second );
+        if ( error ){
 
-            auto mnp = _inputProcessor.getMicroNodeReferencePositions( )->find( node->first );
-            for ( unsigned int j = 0; j < _dim; j++ ){
+            errorOut result = new errorNode( __func__, "Error in the computation of the lumped LHS matrix" );
+            result->addNext( error );
+            return result;
 
-                    std::cerr << boost::format( "%+1.7f " ) % mnp->second[ j ];
+        }
 
-            }
+        LHS *= beta * ( *dt ) * ( *dt );
+        LHS += beta * ( *dt ) * ( *dt ) * AQ;
 
-            for ( unsigned int j = 0; j < _dim; j++ ){
+        // Solve for the Lagrange multipliers
+        Eigen::VectorXd _Lagrange = RHS.cwiseProduct( LHS.cwiseInverse( ) );
 
-                    std::cerr << boost::format( "%+1.7f " ) % _Lagrange( _dim * node->second + j );
+        //Write the Lagrange multipliers to the debugging table
+        if ( logger.writesDebugTables( ) ){
 
-            }
-            std::cerr << "\n";
+            writeArlequinMicroDebugTable( "lagrange", MQ, _Lagrange );
 
         }
 
@@ -1950,53 +2152,30 @@ namespace overlapCoupling{
         _FALD = -( _N.transpose( ) * _Lagrange ).cwiseProduct( WD.cwiseInverse( ) );
         _FALQ = _Lagrange.cwiseProduct( WQ.cwiseInverse( ) );
 
-        std::cout << "FALQ:\n";
-        _indx = 0;
-        std::cerr << "gid, lid: mass      weight    R_1        R_2        R_3        L_1        L_2        L_3\n";
-        for ( auto node = microGlobalToLocalDOFMap->begin( ); node != microGlobalToLocalDOFMap->end( ); node++, _indx++ ){
-
-            std::cerr << boost::format( "%3i, %3i: ") % node->first % node->second;
-            std::cerr << boost::format( "%1.7f " ) % MQ[ _dim * node->second ];
-            std::cerr << boost::format( "%1.7f " ) % (1 - arlequinMicroWeightingFactors.find( node->first )->second );
-
-            auto mnp = _inputProcessor.getMicroNodeReferencePositions( )->find( node->first );
-            for ( unsigned int j = 0; j < _dim; j++ ){
-
-                    std::cerr << boost::format( "%+1.7f " ) % mnp->second[ j ];
+        //Write the Lagrangian forces to the debugging tables. The macro columns are the mass, the weight,
+        //the reference position, and the forces
+        if ( logger.writesDebugTables( ) ){
 
-            }
-
-            for ( unsigned int j = 0; j < _dim; j++ ){
-
-                    std::cerr << boost::format( "%+1.7f " ) % _FALQ( _dim * node->second + j );
-
-            }
-            std::cerr << "\n";
+            writeArlequinMicroDebugTable( "FALQ", MQ, _FALQ );
 
-        }
+            const std::unordered_map< uIntType, floatVector > *macroReferencePositions = _inputProcessor.getMacroNodeReferencePositions( );
 
-        std::cout << "FALD:\n";
-        _indx = 0;
-        std::cerr << "gid, lid: mass      weight    R_1        R_2        R_3        L_1        L_2        L_3\n";
-        for ( auto node = macroGlobalToLocalDOFMap->begin( ); node != macroGlobalToLocalDOFMap->end( ); node++, _indx++ ){
+            for ( auto node = macroGlobalToLocalDOFMap->begin( ); node != macroGlobalToLocalDOFMap->end( ); node++ ){
 
-            std::cerr << boost::format( "%3i, %3i: ") % node->first % node->second;
-            std::cerr << boost::format( "%1.7f " ) % _MD_Diag[ ( _dim + _dim * _dim ) * node->second ];
-            std::cerr << boost::format( "%1.7f " ) % WD[ ( _dim + _dim * _dim ) * node->second ];
+                floatVector row = { _MD_Diag[ nMacroDispDOF * node->second ], WD[ nMacroDispDOF * node->second ] };
 
-            auto mnp = _inputProcessor.getMacroNodeReferencePositions( )->find( node->first );
-            for ( unsigned int j = 0; j < _dim; j++ ){
+                auto mnp = macroReferencePositions->find( node->first );
+                if ( mnp != macroReferencePositions->end( ) ){
 
-                    std::cerr << boost::format( "%+1.7f " ) % mnp->second[ j ];
+                    row.insert( row.end( ), mnp->second.begin( ), mnp->second.end( ) );
 
-            }
+                }
 
-            for ( unsigned int j = 0; j < ( _dim + _dim * _dim ); j++ ){
+                row.insert( row.end( ), _FALD.data( ) + nMacroDispDOF * node->second, _FALD.data( ) + nMacroDispDOF * ( node->second + 1 ) );
 
-                    std::cerr << boost::format( "%+1.7f " ) % _FALD( ( _dim + _dim * _dim ) * node->second + j );
+                logger.writeDebugTableRow( "FALD", node->first, node->second, row );
 
             }
-            std::cerr << "\n";
 
         }
 
@@ -2010,51 +2189,52 @@ namespace overlapCoupling{
 
         // Compute the new accelerations
 //        std::cerr << "DDotDot_tp1\n";
-        Eigen::VectorXd DDotDot_tp1 = AD.asDiagonal( ) * ( _FD + mu_update * WD.asDiagonal( ) * ( D - _De ) - _N.transpose( ) * _Lagrange );
+        Eigen::VectorXd DDotDot_tp1 = AD.cwiseProduct( _FD + mu_update * WD.cwiseProduct( D - _De ) - _N.transpose( ) * _Lagrange );
 //        std::cerr << DDotDot_tp1 << "\n";
 //        std::cerr << "QDotDot_tp1\n";
-        Eigen::VectorXd QDotDot_tp1 = AQ.asDiagonal( ) * ( _FQ + mu_update * WQ.asDiagonal( ) * ( Q - _Qe ) + _Lagrange );
+        Eigen::VectorXd QDotDot_tp1 = AQ.cwiseProduct( _FQ + mu_update * WQ.cwiseProduct( Q - _Qe ) + _Lagrange );
 //        std::cerr << QDotDot_tp1 << "\n";
 
-        std::cerr << "\nUpdated micro accelerations\n";
-        std::cerr << "gid, lid: R_1        R_2        R_3        U_1        U_2        U_3\n";
-        for ( auto node = microGlobalToLocalDOFMap->begin( ); node != microGlobalToLocalDOFMap->end( ); node++ ){
+        //Write the updated accelerations to the debugging tables. The columns are the reference position
+        //and the accelerations
+        if ( logger.writesDebugTables( ) ){
+
+            const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
+            const std::unordered_map< uIntType, floatVector > *macroReferencePositions = _inputProcessor.getMacroNodeReferencePositions( );
 
-            std::cerr << boost::format( "%3i, %3i: ") % node->first % node->second;
-            auto mnp = _inputProcessor.getMicroNodeReferencePositions( )->find( node->first );
-            for ( unsigned int j = 0; j < _dim; j++ ){
+            for ( auto node = microGlobalToLocalDOFMap->begin( ); node != microGlobalToLocalDOFMap->end( ); node++ ){
 
-                    std::cerr << boost::format( "%+1.7f " ) % mnp->second[ j ];
+                floatVector row;
 
-            }
+                auto mnp = microReferencePositions->find( node->first );
+                if ( mnp != microReferencePositions->end( ) ){
 
-            for ( unsigned int i = 0; i < 3; i++ ){
+                    row = mnp->second;
 
-                std::cerr << boost::format( "%+1.7f ") % QDotDot_tp1[ 3 * node->second + i ];
+                }
+
+                row.insert( row.end( ), QDotDot_tp1.data( ) + nMicroDispDOF * node->second, QDotDot_tp1.data( ) + nMicroDispDOF * ( node->second + 1 ) );
+
+                logger.writeDebugTableRow( "updated_micro_acceleration", node->first, node->second, row );
 
             }
-            std::cout << "\n";
 
-        }
+            for ( auto node = macroGlobalToLocalDOFMap->begin( ); node != macroGlobalToLocalDOFMap->end( ); node++ ){
 
-        std::cerr << "\nUpdated macro accelerations\n";
-        std::cerr << "gid, gid: R_1        R_2        R_3        U_1        U_2        U_3        PHI_11     PHI_12     PHI_13     PHI_21     PHI_22     PHI_23     PHI_31     PHI_32     PHI_33\n";
-        for ( auto node = macroGlobalToLocalDOFMap->begin( ); node != macroGlobalToLocalDOFMap->end( ); node++ ){
+                floatVector row;
 
-            std::cerr << boost::format( "%3i, %3i: ") % node->first % node->second;
-            auto mnp = _inputProcessor.getMacroNodeReferencePositions( )->find( node->first );
-            for ( unsigned int j = 0; j < _dim; j++ ){
+                auto mnp = macroReferencePositions->find( node->first );
+                if ( mnp != macroReferencePositions->end( ) ){
 
-                    std::cerr << boost::format( "%+1.7f " ) % mnp->second[ j ];
+                    row = mnp->second;
 
-            }
+                }
 
-            for ( unsigned int i = 0; i < 12; i++ ){
+                row.insert( row.end( ), DDotDot_tp1.data( ) + nMacroDispDOF * node->second, DDotDot_tp1.data( ) + nMacroDispDOF * ( node->second + 1 ) );
 
-                std::cerr << boost::format( "%+1.7f " ) % DDotDot_tp1[ 12 * node->second + i ];
+                logger.writeDebugTableRow( "updated_macro_acceleration", node->first, node->second, row );
 
             }
-            std::cerr << "\n";
 
         }
 
@@ -2297,7 +2477,7 @@ namespace overlapCoupling{
 #endif
 
         //Homogenize the material properties at the micro-scale to the macro-scale
-        std::cerr << "HOMOGENIZE THE MICROSCALE\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "HOMOGENIZE THE MICROSCALE\n";
         error = homogenizeMicroScale( microIncrement );
     
         if ( error ){
@@ -2312,7 +2492,7 @@ namespace overlapCoupling{
         if ( !couplingConfiguration[ "update_displacement" ].IsScalar( ) ){
 
             //Assemble the mass matrix for the free micromorphic domians
-            std::cerr << "ASSEMBLING THE FREE MICROMORPHIC MASS MATRIX\n";
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "ASSEMBLING THE FREE MICROMORPHIC MASS MATRIX\n";
             error = assembleFreeMicromorphicMassMatrix( );
     
             if ( error ){
@@ -2324,7 +2504,7 @@ namespace overlapCoupling{
             }
 
             //Assemble the coupling mass and damping matrices
-            std::cerr << "ASSEMBLING THE COUPLING MASS AND DAMPING MATRICES\n";
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "ASSEMBLING THE COUPLING MASS AND DAMPING MATRICES\n";
             error = assembleCouplingMassAndDampingMatrices( );
     
             if ( error ){
@@ -2336,7 +2516,7 @@ namespace overlapCoupling{
             }
 
             //Assemble the coupling force vector
-            std::cerr << "ASSEMBLING THE COUPLING FORCE VECTOR\n";
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "ASSEMBLING THE COUPLING FORCE VECTOR\n";
             error = assembleCouplingForceVector( );
     
             if ( error ){
@@ -2348,7 +2528,7 @@ namespace overlapCoupling{
             }
     
             //Solve for the free displacements
-            std::cout << "SOLVE FOR THE FREE DISPLACEMENT\n";
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "SOLVE FOR THE FREE DISPLACEMENT\n";
             error = solveFreeDisplacement( true );
     
             if ( error ){
@@ -2382,7 +2562,17 @@ namespace overlapCoupling{
             return new errorNode ( __func__, "The coupling initialization configuration is not defined" );
         }
 
-        errorOut error = NULL;
+        //Complete any queued output before the reference information is written
+        errorOut error = flushOutput( );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__, "Error in the output queued before the initialization" );
+            result->addNext( error );
+            return result;
+
+        }
+
         if ( couplingInitialization[ "type" ].as< std::string >( ).compare( "use_first_increment" ) == 0 ){
 
             error = setReferenceStateFromIncrement( 0, 0 );
@@ -2470,7 +2660,7 @@ namespace overlapCoupling{
         //Save the reference state if required
         if ( _inputProcessor.outputReferenceInformation( ) ){
 
-            std::cerr << "OUTPUTTING REFERENCE INFORMATION\n";
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "OUTPUTTING REFERENCE INFORMATION\n";
             error = outputReferenceInformation( );
 
             if ( error ){
@@ -2483,7 +2673,7 @@ namespace overlapCoupling{
 
         }
 
-        std::cerr << "COUPLING INITIALIZATION COMPLETE\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "COUPLING INITIALIZATION COMPLETE\n";
 
         return NULL;
     }
@@ -2901,9 +3091,31 @@ namespace overlapCoupling{
         unsigned int nFreeMacroDOF = nDispMacroDOF * _inputProcessor.getFreeMacroNodeIds( )->size( );
         unsigned int nGhostMacroDOF = nDispMacroDOF * _inputProcessor.getGhostMacroNodeIds( )->size( );
 
+        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
+
+        _useSparseL2Projectors = config[ "l2_projector" ][ "type" ].as< std::string >( ).compare( "sparse" ) == 0;
+
+        if ( _useSparseL2Projectors ){
+
+            errorOut error = formSparseL2Projectors( nFreeMicroDOF, nGhostMicroDOF, nFreeMacroDOF, nGhostMacroDOF );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the formation of the sparse L2 projectors" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            return NULL;
+
+        }
+
+        //The dense projectors are applied explicitly
+        _implicitL2Projectors = false;
+
         //Extract the part of the shapefunction matrix that interpolates between ghost micromorphic DOF and free classical DOF
-        Eigen::SparseQR< SparseMatrix, Eigen::COLAMDOrdering<int> > solver;
-        std::cout << "PERFORMING SVD DECOMPOSITION OF NQDhat\n";
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "PERFORMING SVD DECOMPOSITION OF NQDhat\n";
         SparseMatrix NQDhat = _N.block( 0, nFreeMacroDOF, nFreeMicroDOF, nGhostMacroDOF );
         NQDhat.makeCompressed( );
         errorOut error = DOFProjection::formMoorePenrosePseudoInverse( NQDhat.toDense( ), _dense_BDhatQ );
@@ -2925,1603 +3137,1709 @@ namespace overlapCoupling{
         return NULL;
     }
 
-    errorOut overlapCoupling::formAveragedL2Projectors( ){
+    errorOut overlapCoupling::formSparseL2Projectors( const uIntType &nFreeMicroDOF, const uIntType &nGhostMicroDOF,
+                                                      const uIntType &nFreeMacroDOF, const uIntType &nGhostMacroDOF ){
         /*!
-         * Form the projectors using the averaged micro domain values at the centers of mass.
+         * Form the L2 projectors without forming the dense pseudo-inverse of NQDhat. The pseudo-inverse is kept
+         * implicitly as the sparse QR factorization of NQDhat so that the ghost degrees of freedom and the forces
+         * are projected exactly. Truncated sparse forms of the projectors are also formed for the assembly of the
+         * mass and damping matrices and for output.
          *
-         * This is the currently recommended projection method
+         * The untruncated projectors are dense so they are never formed in full. Their columns are computed in
+         * blocks by applying the factorization. The first pass over the blocks determines the truncation values,
+         * using the same rule as the dense projectors, and the second pass stores the retained values.
+         *
+         * :param const uIntType &nFreeMicroDOF: The number of free micro degrees of freedom
+         * :param const uIntType &nGhostMicroDOF: The number of ghost micro degrees of freedom
+         * :param const uIntType &nFreeMacroDOF: The number of free macro degrees of freedom
+         * :param const uIntType &nGhostMacroDOF: The number of ghost macro degrees of freedom
          */
 
-        //Form the micro to macro projection matrix
-        //Note: This is the FULL matrix not just the part we need for the overlap coupling.
-        //      We will select sub-blocks of it to use in the actual projectors. This may or
-        //      may not be correct.
+        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
 
-        Eigen::MatrixXd microMacroProjector;
-        SparseMatrix S, T;
+        if ( !config[ "l2_projector" ][ "truncation_tolerance" ] ){
 
-        uIntType nMicroDOF = _dim;
-        uIntType nMacroDOF = _dim + _dim * _dim;
+            return new errorNode( __func__, "The 'l2_projector' 'truncation_tolerance' is not defined" );
 
-        errorOut error;
+        }
 
-        std::cerr << "ASSEMBLING MICRO-TO-MACRO PROJECTOR\n";
-        for ( uIntType i = 0; i < nMacroDOF; i++ ){
+        floatType tolerance;
 
-            error = DOFProjection::formDomainSelectionMatrix( i, nMacroDOF, *_inputProcessor.getMicroDomainIDMap( ), S );
+        try{
 
-            if ( error ){
+            tolerance = config[ "l2_projector" ][ "truncation_tolerance" ].as< floatType >( );
 
-                errorOut result = new errorNode( __func__, "Error in the formation of the selection matrix" );
-                result->addNext( error );
-                return result;
+        }
+        catch( std::exception &e ){
 
-            }
+            return new errorNode( __func__, "The 'l2_projector' 'truncation_tolerance' could not be read: " + std::string( e.what( ) ) );
 
-            error = DOFProjection::formMacroNodeExpansionMatrix( i, nMacroDOF, *_inputProcessor.getMacroGlobalToLocalDOFMap( ), T );
+        }
 
-            if ( error ){
+        _implicitL2Projectors = false;
 
-                errorOut result = new errorNode( __func__, "Error in the formation of the expansion matrix" );
-                result->addNext( error );
-                return result;
+        //Extract the blocks of the shapefunction matrix
+        _L2ProjectorNQD        = _N.topLeftCorner( nFreeMicroDOF, nFreeMacroDOF );
+        _L2ProjectorNQDhat     = _N.block( 0, nFreeMacroDOF, nFreeMicroDOF, nGhostMacroDOF );
+        _L2ProjectorNQhatD     = _N.bottomLeftCorner( nGhostMicroDOF, nFreeMacroDOF );
+        _L2ProjectorNQhatDhat  = _N.bottomRightCorner( nGhostMicroDOF, nGhostMacroDOF );
 
-            }
+        _L2ProjectorNQD.makeCompressed( );
+        _L2ProjectorNQDhat.makeCompressed( );
+        _L2ProjectorNQhatD.makeCompressed( );
+        _L2ProjectorNQhatDhat.makeCompressed( );
 
-            if ( i == 0 ){
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "PERFORMING SPARSE QR DECOMPOSITION OF NQDhat\n";
+        _L2ProjectorSolver.compute( _L2ProjectorNQDhat );
 
-                microMacroProjector = T * _centerOfMassProjector * S;
+        if ( _L2ProjectorSolver.info( ) != Eigen::Success ){
 
-            }
-            else{
+            return new errorNode( __func__, "The QR decomposition of NQDhat failed" );
 
-                microMacroProjector += T * _centerOfMassProjector * S;
+        }
 
-            }
+        if ( _L2ProjectorSolver.rank( ) < _L2ProjectorNQDhat.cols( ) ){
+
+            return new errorNode( __func__,
+                                  "NQDhat is rank deficient ( rank " + std::to_string( _L2ProjectorSolver.rank( ) ) +
+                                  " of " + std::to_string( _L2ProjectorNQDhat.cols( ) ) + " ). Use the dense l2_projector instead" );
 
         }
 
-        //Set the DOF type sizes
-        uIntType nFreeMacroDOF  = nMacroDOF * _inputProcessor.getFreeMacroNodeIds( )->size( );        
-        uIntType nGhostMacroDOF = nMacroDOF * _inputProcessor.getGhostMacroNodeIds( )->size( );
+        _L2ProjectorR = _L2ProjectorSolver.matrixR( ).topLeftCorner( nGhostMacroDOF, nGhostMacroDOF );
 
-        uIntType nFreeMicroDOF  = nMicroDOF * _inputProcessor.getFreeMicroNodeIds( )->size( );
-        uIntType nGhostMicroDOF = nMicroDOF * _inputProcessor.getGhostMicroNodeIds( )->size( );
+        //The projectors are stored in the order BQhatQ, BQhatD, BDhatQ, BDhatD
+        const uIntType blockSize = 256;
+        floatVector minCoeffs( 4, 0 ), maxCoeffs( 4, 0 ), truncationValues( 4, 0 );
+        std::vector< tripletVector > coefficients( 4 );
 
-        std::cerr << "ASSEMBLING THE PROJECTORS\n";
-        floatType sparseFactor
-        = 1e-4 * 0.5 * ( std::fabs( microMacroProjector.maxCoeff( ) ) + std::fabs( microMacroProjector.minCoeff( ) ) ); //TODO: Make the 1e-4 settable by the user
-    
-        //Add the homogenization matrix
-        microMacroProjector *= _homogenizationMatrix;
+        auto visitBlock = [ & ]( const uIntType pass, const uIntType projector, const uIntType &firstColumn,
+                                 const Eigen::MatrixXd &block ){
 
-        //Compute the projectors
-        std::cerr << "  BDhatQ\n";
-    
-        _sparse_BDhatQ = microMacroProjector.bottomLeftCorner( nGhostMacroDOF, nFreeMicroDOF ).sparseView( 1, sparseFactor );
-    
-        std::cerr << "  BQhatQ\n";
-        _sparse_BQhatQ = _N.bottomRightCorner( nGhostMicroDOF, nGhostMacroDOF ) * _sparse_BDhatQ;
-    
-        std::cerr << "  BDhatD\n";
-        _sparse_BDhatD = -_sparse_BDhatQ * _N.topLeftCorner( nFreeMicroDOF, nFreeMacroDOF );
+            if ( pass == 0 ){
 
-        std::cerr << "  BQhatD\n";
-        _sparse_BQhatD = _N.bottomLeftCorner( nGhostMicroDOF, nFreeMacroDOF );
-        _sparse_BQhatD += _N.bottomRightCorner( nGhostMicroDOF, nGhostMacroDOF ) * _sparse_BDhatD;
+                if ( block.size( ) > 0 ){
 
-        std::cerr << "PROJECTORS ASSEMBLED\n";
-        return NULL;
-    }
+                    minCoeffs[ projector ] = std::min( minCoeffs[ projector ], block.minCoeff( ) );
+                    maxCoeffs[ projector ] = std::max( maxCoeffs[ projector ], block.maxCoeff( ) );
 
-    errorOut overlapCoupling::formDirectProjectionProjectors( const unsigned int &microIncrement, const unsigned int &macroIncrement ){
-        /*!
-         * Form the projectors if the direct projection is to be used
-         *
-         * :param const unsigned int &microIncrement: The micro increment at which to form the projectors
-         * :param const unsigned int &macroIncrement: The macro increment at which to form the projectors
-         */
+                }
 
-        return new errorNode( __func__,
-                              "This subroutine, and the routines it calls, requires extensive re-working to obtain the expected results. The method is not recommended so this has not been done yet." );
+                return;
 
-        //Get the ghost macro cell IDs
-        const uIntVector *ghostMacroCellIDs = _inputProcessor.getGhostMacroCellIds( );
-        const std::unordered_map< uIntType, stringVector > *macroCellToMicroDomainMap = _inputProcessor.getMacroCellToDomainMap( );
+            }
 
-        const stringVector *ghostMacroDomainNames = _inputProcessor.getGhostMacroDomainNames( );
+            for ( uIntType j = 0; j < ( uIntType )block.cols( ); j++ ){
 
-        unsigned int cellIndex;
+                for ( uIntType i = 0; i < ( uIntType )block.rows( ); i++ ){
 
-        errorOut error = NULL;
+                    if ( std::fabs( block( i, j ) ) > truncationValues[ projector ] ){
 
-        uIntVector macroNodes;
+                        coefficients[ projector ].push_back( DOFProjection::T( i, firstColumn + j, block( i, j ) ) );
 
-        //Form the projector from the free micro-scale to the ghost macro-scale
-        for ( auto cellID  = ghostMacroCellIDs->begin( );
-                   cellID != ghostMacroCellIDs->end( );
-                   cellID++ ){
+                    }
 
-            //Set the index
-            cellIndex = cellID - ghostMacroCellIDs->begin( );
+                }
 
-            //Set the number of micro-domains encompassed by the cell
-            auto microDomains = macroCellToMicroDomainMap->find( *cellID );
+            }
 
-            if ( microDomains == macroCellToMicroDomainMap->end( ) ){
+        };
 
-                return new errorNode( __func__,
-                                      "Macro cell " + std::to_string( *cellID ) + " not found in the macro cell to micro domain map" );
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "FORMING THE TRUNCATED SPARSE L2 PROJECTORS\n";
+        for ( uIntType pass = 0; pass < 2; pass++ ){
 
-            }
+            for ( uIntType freeMacro = 0; freeMacro < 2; freeMacro++ ){
 
-            //Get the macro-node set
-            error = _inputProcessor._macroscale->getSubDomainNodes( macroIncrement, ( *ghostMacroDomainNames )[ cellIndex ], macroNodes );
+                uIntType nColumns = freeMacro ? nFreeMacroDOF : nFreeMicroDOF;
 
-            if ( error ){
+                for ( uIntType firstColumn = 0; firstColumn < nColumns; firstColumn += blockSize ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in extracting the ghost macro-node set" );
-                result->addNext( error );
-                return result;
+                    uIntType nBlockColumns = std::min( blockSize, nColumns - firstColumn );
 
-            }
+                    //Dhat = pinv( NQDhat ) ( Q - NQD D ) and Qhat = NQhatD D + NQhatDhat Dhat
+                    SparseMatrix V;
 
-            //Loop over the free micro-domains
-            for ( auto domain  = microDomains->second.begin( ); domain != microDomains->second.end( ); domain++ ){
+                    if ( freeMacro ){
 
-                error = addDomainContributionToDirectFreeMicroToGhostMacroProjector( cellIndex, *cellID, microIncrement, 
-                                                                                     *domain, macroNodes );
+                        V = -_L2ProjectorNQD.middleCols( firstColumn, nBlockColumns );
 
-                if ( error ){
+                    }
+                    else{
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in processing free micro-scale domain '" + *domain + "' for a ghost macro domain reference state" );
-                    result->addNext( error );
-                    return result;
+                        tripletVector unitCoefficients;
+                        unitCoefficients.reserve( nBlockColumns );
+
+                        for ( uIntType j = 0; j < nBlockColumns; j++ ){
+
+                            unitCoefficients.push_back( DOFProjection::T( firstColumn + j, j, 1 ) );
+
+                        }
+
+                        V = SparseMatrix( nFreeMicroDOF, nBlockColumns );
+                        V.setFromTriplets( unitCoefficients.begin( ), unitCoefficients.end( ) );
+
+                    }
+
+                    Eigen::MatrixXd BDhatBlock, BQhatBlock;
+
+                    errorOut error = applyPseudoInverse( V, BDhatBlock );
+
+                    if ( error ){
+
+                        errorOut result = new errorNode( __func__,
+                                                         "Error in the computation of the projector columns starting at " +
+                                                         std::to_string( firstColumn ) );
+                        result->addNext( error );
+                        return result;
+
+                    }
+
+                    BQhatBlock = _L2ProjectorNQhatDhat * BDhatBlock;
+
+                    if ( freeMacro ){
+
+                        BQhatBlock += _L2ProjectorNQhatD.middleCols( firstColumn, nBlockColumns );
+
+                    }
+
+                    visitBlock( pass, freeMacro, firstColumn, BQhatBlock );
+                    visitBlock( pass, 2 + freeMacro, firstColumn, BDhatBlock );
 
                 }
 
             }
 
-        }
+            if ( pass == 0 ){
 
-        //Set the dimension of the displacement DOF
-        unsigned int nDispMicroDOF = _dim;
+                for ( uIntType projector = 0; projector < 4; projector++ ){
 
-        unsigned int nDispMacroDOF = _dim + _dim * _dim;
+                    truncationValues[ projector ] = tolerance * ( std::fabs( minCoeffs[ projector ] ) + std::fabs( maxCoeffs[ projector ] ) );
 
-        //Get the number of micro degrees of freedom which are free and ghost
-        unsigned int nFreeMicroDOF = nDispMicroDOF * _inputProcessor.getFreeMicroNodeIds( )->size( );
-        unsigned int nGhostMicroDOF = nDispMicroDOF * _inputProcessor.getGhostMicroNodeIds( )->size( );
+                }
 
-        //Get the number of macro degrees of freedom which are free and ghost
-        unsigned int nFreeMacroDOF = nDispMacroDOF * _inputProcessor.getFreeMacroNodeIds( )->size( );
-        unsigned int nGhostMacroDOF = nDispMacroDOF * _inputProcessor.getGhostMacroNodeIds( )->size( );
+            }
 
-        //Assemble the remaining projectors
+        }
 
-        _sparse_BDhatD = -_sparse_BDhatQ * _N.topLeftCorner( nFreeMicroDOF, nFreeMacroDOF );
+        _sparse_BQhatQ = SparseMatrix( nGhostMicroDOF, nFreeMicroDOF );
+        _sparse_BQhatD = SparseMatrix( nGhostMicroDOF, nFreeMacroDOF );
+        _sparse_BDhatQ = SparseMatrix( nGhostMacroDOF, nFreeMicroDOF );
+        _sparse_BDhatD = SparseMatrix( nGhostMacroDOF, nFreeMacroDOF );
 
-        _sparse_BQhatQ = _N.bottomRightCorner( nGhostMicroDOF, nGhostMacroDOF ) * _sparse_BDhatQ;
+        _sparse_BQhatQ.setFromTriplets( coefficients[ 0 ].begin( ), coefficients[ 0 ].end( ) );
+        _sparse_BQhatD.setFromTriplets( coefficients[ 1 ].begin( ), coefficients[ 1 ].end( ) );
+        _sparse_BDhatQ.setFromTriplets( coefficients[ 2 ].begin( ), coefficients[ 2 ].end( ) );
+        _sparse_BDhatD.setFromTriplets( coefficients[ 3 ].begin( ), coefficients[ 3 ].end( ) );
 
-        _sparse_BQhatD = _N.bottomLeftCorner( nGhostMicroDOF, nFreeMacroDOF )
-                   + _N.bottomRightCorner( nGhostMicroDOF, nGhostMacroDOF ) * _sparse_BDhatD;
+        _implicitL2Projectors = true;
 
         return NULL;
     }
 
-    errorOut overlapCoupling::processDomainReference( const unsigned int &microIncrement,
-                                                      const std::string &domainName,
-                                                      const unsigned int cellID, uIntVector &macroNodes,
-                                                      domainFloatMap   &referenceMicroDomainMass,
-                                                      domainFloatVectorMap &referenceMicroDomainCentersOfMass,
-                                                      domainFloatVectorMap &referenceMicroDomainMomentsOfInertia,
-                                                      std::unordered_map< uIntType, floatVector > &domainReferenceXiVectors,
-                                                      floatVector &domainCenterOfMassShapeFunctionValues,
-                                                      std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues ){
+    errorOut overlapCoupling::applyPseudoInverse( const SparseMatrix &v, Eigen::MatrixXd &result ){
         /*!
-         * Process the domain for use with preparing the reference configuration
+         * Apply the pseudo-inverse of NQDhat using its QR factorization.
          *
-         * :param const unsigned int &microIncrement: The micro-scale increment at which to compute the reference
-         * :param const std::string &domainName: The name of the domain
-         * :param const unsigned int cellID: The global cell ID number
-         * :param uIntVector &macroNodes: The nodes of the macro domain
-         * :param domainFloatMap   &referenceMicroDomainMass: The reference mass of the micro domain. This
-         *     should be a reference to the micro-domain mass vector
-         * :param domainFloatVectorMap &referenceMicroDomainCentersOfMass: The reference micro-domain center of mass
-         *     vector for all of the micro domains
-         * :param domainFloatVectorMap &referenceDomainMomentsOfInertia: The reference moment of inertia for all of the micro domains
-         * :param std::unordered_map< uIntType, floatVector > &domainReferenceXiVectors: The reference Xi vectors for the domain.
-         * :param floatVector &domainCenterOfMassShapeFunctionValues: The shape function values at the 
-         *     center of mass
-         * :param std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues: The shape function values at the
-         *     micro node positions inside of the domain. This is only computed if indicated by the 
-         *     configuration file.
+         * NQDhat has full column rank so pinv( NQDhat ) = ( NQDhat^T NQDhat )^{-1} NQDhat^T where,
+         * with NQDhat P = Q R, ( NQDhat^T NQDhat )^{-1} = P R^{-1} R^{-T} P^T
+         *
+         * :param const SparseMatrix &v: The matrix to be multiplied by the pseudo-inverse
+         * :param Eigen::MatrixXd &result: The product
          */
 
-        //Clear the existing Xi and shapefunction maps
-        domainReferenceXiVectors.clear( );
-        domainMicroPositionShapeFunctionValues.clear( );
+        if ( v.rows( ) != _L2ProjectorNQDhat.rows( ) ){
 
-        //Process the domain mass data
-        floatVector domainCenterOfMass;
+            return new errorNode( __func__,
+                                  "The matrix has " + std::to_string( v.rows( ) ) + " rows but " +
+                                  std::to_string( _L2ProjectorNQDhat.rows( ) ) + " are required" );
 
-        //Form the macro element if required
-        std::unique_ptr< elib::Element > element;
-        element.reset(NULL);
+        }
 
-        if ( _inputProcessor.isFiltering( ) && _inputProcessor.useReconstructedVolumeForMassMatrix( ) ){
+        Eigen::MatrixXd u = _L2ProjectorSolver.colsPermutation( ).transpose( ) * SparseMatrix( _L2ProjectorNQDhat.transpose( ) * v ).toDense( );
 
-            std::cerr << "#########################################################\n"
-                      << "###                      Warning                      ###\n"
-                      << "#########################################################\n"
-                      << "# Using the reconstructed volume for the center of mass #\n"
-                      << "# can result in drastically inconsistent deformation    #\n"
-                      << "# when filtering. Overriding to use direct computation  #\n"
-                      << "#########################################################\n";
+        u = _L2ProjectorR.transpose( ).triangularView< Eigen::Lower >( ).solve( u );
 
-        }
-        else if ( _inputProcessor.useReconstructedVolumeForMassMatrix( ) ){
+        _L2ProjectorR.triangularView< Eigen::Upper >( ).solveInPlace( u );
 
-            errorOut error = buildMacroDomainElement( cellID,
-                                                      *_inputProcessor.getMacroNodeReferencePositions( ),
-                                                      *_inputProcessor.getMacroDisplacements( ),
-                                                      *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                                      element );
+        result = _L2ProjectorSolver.colsPermutation( ) * u;
 
-            if ( error ){
+        return NULL;
+    }
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the construction of the macro-scale element " + std::to_string( cellID ) );
-                result->addNext( error );
-                return result;
+    errorOut overlapCoupling::applyPseudoInverseTranspose( const Eigen::MatrixXd &w, Eigen::MatrixXd &result ){
+        /*!
+         * Apply the transpose of the pseudo-inverse of NQDhat using its QR factorization.
+         *
+         * NQDhat has full column rank so pinv( NQDhat )^T = NQDhat ( NQDhat^T NQDhat )^{-1} where,
+         * with NQDhat P = Q R, ( NQDhat^T NQDhat )^{-1} = P R^{-1} R^{-T} P^T
+         *
+         * :param const Eigen::MatrixXd &w: The matrix to be multiplied by the transpose of the pseudo-inverse
+         * :param Eigen::MatrixXd &result: The product
+         */
 
-            }
+        if ( w.rows( ) != _L2ProjectorR.rows( ) ){
+
+            return new errorNode( __func__,
+                                  "The matrix has " + std::to_string( w.rows( ) ) + " rows but " +
+                                  std::to_string( _L2ProjectorR.rows( ) ) + " are required" );
 
         }
 
-        errorOut error = processDomainMassData( microIncrement, domainName, referenceMicroDomainMass,
-                                                referenceMicroDomainCentersOfMass, referenceMicroDomainMomentsOfInertia,
-                                                domainReferenceXiVectors, element );
-#ifdef TESTACCESS
-        _test_domainMass[ cellID ].emplace( domainName, referenceMicroDomainMass[ domainName ] );
-        _test_domainCOM[ cellID ].emplace( domainName, referenceMicroDomainCentersOfMass[ domainName ] );
-        _test_domainXi[ cellID ].emplace( domainName, domainReferenceXiVectors );
-#endif
+        Eigen::MatrixXd u = _L2ProjectorSolver.colsPermutation( ).transpose( ) * w;
 
-        if ( error ){
-            
-            errorOut result = new errorNode( __func__,
-                                             "Error in processing the mass data for the micro domain '" + domainName + "'" );
-            result->addNext( error );
-            return result;
+        u = _L2ProjectorR.transpose( ).triangularView< Eigen::Lower >( ).solve( u );
 
-        }
+        _L2ProjectorR.triangularView< Eigen::Upper >( ).solveInPlace( u );
 
-        //Compute the domain's shape function information
-        error = computeDomainShapeFunctionInformation( cellID, domainName, microIncrement,
-                                                       referenceMicroDomainCentersOfMass[ domainName ],
-                                                       macroNodes,
-                                                       domainCenterOfMassShapeFunctionValues,
-                                                       domainMicroPositionShapeFunctionValues );
+        result = _L2ProjectorNQDhat * ( _L2ProjectorSolver.colsPermutation( ) * u );
 
-        _referenceCellDomainCenterOfMassShapefunctions[ cellID ].emplace( domainName, domainCenterOfMassShapeFunctionValues );
+        return NULL;
+    }
 
-#ifdef TESTACCESS
-        if ( _inputProcessor.getCouplingInitialization( )[ "projection_type" ].as< std::string >( ).compare( "direct_projection" ) == 0 ){
-            _test_domainMUP[ cellID ].emplace( domainName, domainMicroPositionShapeFunctionValues );
-        }
-#endif
+    errorOut overlapCoupling::applyL2ProjectorsImplicitly( const Eigen::MatrixXd &Q, const Eigen::MatrixXd &D,
+                                                          Eigen::MatrixXd &Qhat, Eigen::MatrixXd &Dhat ){
+        /*!
+         * Project the free degrees of freedom to the ghost degrees of freedom using the implicit L2 projectors
+         *
+         * Dhat = BDhatQ Q + BDhatD D = pinv( NQDhat ) ( Q - NQD D )
+         * Qhat = BQhatQ Q + BQhatD D = NQhatD D + NQhatDhat Dhat
+         *
+         * :param const Eigen::MatrixXd &Q: The free micro degrees of freedom
+         * :param const Eigen::MatrixXd &D: The free macro degrees of freedom
+         * :param Eigen::MatrixXd &Qhat: The projected ghost micro degrees of freedom
+         * :param Eigen::MatrixXd &Dhat: The projected ghost macro degrees of freedom
+         */
 
-        if ( error ){
-            errorOut result = new errorNode( __func__,
-                                             "Error in computing the shape function values for the domain center of mass or the domainMicroPositionShapeFunctionValues" );
-            result->addNext( error );
-            return result;
-        }
+        if ( ( Q.rows( ) != _L2ProjectorNQD.rows( ) ) || ( D.rows( ) != _L2ProjectorNQD.cols( ) ) ){
 
-        //Get the domain node ids
-        uIntVector domainNodes;
-        error = _inputProcessor._microscale->getSubDomainNodes( microIncrement, domainName, domainNodes );
+            return new errorNode( __func__, "The free degrees of freedom are not consistent with the interpolation matrix" );
 
-        if ( error ){
-            errorOut result = new errorNode( __func__,
-                                             "Error in extracting the micro-node set" );
-            result->addNext( error );
-            return result;
         }
 
-        //Add the domain's contribution to the shape function matrix
-        error = addDomainContributionToInterpolationMatrix( domainNodes, macroNodes, domainReferenceXiVectors,
-                                                            domainCenterOfMassShapeFunctionValues );
+        Eigen::MatrixXd RHS = Q - _L2ProjectorNQD * D;
 
-        if ( error ){
-            errorOut result = new errorNode( __func__,
-                                             "Error in adding part of the shapefunction matrix determined from '" + domainName + "'" );
-            result->addNext( error );
-            return result;
-        }
+        Dhat = _L2ProjectorSolver.solve( RHS );
 
-        //If the projection time is the direct projection method, we need to save some values
-        if ( _inputProcessor.getCouplingInitialization( )[ "projection_type" ].as< std::string >( ).compare( "direct_projection" ) == 0 ){
+        if ( _L2ProjectorSolver.info( ) != Eigen::Success ){
 
-            //Save the contributions of the domain to the direct projection values
-            error = addDomainToDirectProjectionReferenceValues( domainNodes, macroNodes, domainReferenceXiVectors,
-                                                                domainMicroPositionShapeFunctionValues );
+            return new errorNode( __func__, "The solution of the L2 projection failed" );
 
-            if ( error ){
+        }
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in saving the direct projection reference values" );
-                result->addNext( error );
-                return result;
+        Qhat = _L2ProjectorNQhatD * D + _L2ProjectorNQhatDhat * Dhat;
 
-            }
+        return NULL;
+    }
 
-        }
-        if ( _inputProcessor.getCouplingInitialization( )[ "projection_type" ].as< std::string >( ).compare( "averaged_l2_projection" ) == 0 ){
+    errorOut overlapCoupling::applyL2ProjectorTransposesImplicitly( const Eigen::MatrixXd &FQhat, const Eigen::MatrixXd &FDhat,
+                                                                   Eigen::MatrixXd &FQ, Eigen::MatrixXd &FD ){
+        /*!
+         * Apply the transposes of the implicit L2 projectors to ghost force vectors
+         *
+         * FQ = BQhatQ^T FQhat + BDhatQ^T FDhat = pinv( NQDhat )^T ( NQhatDhat^T FQhat + FDhat )
+         * FD = BQhatD^T FQhat + BDhatD^T FDhat = NQhatD^T FQhat - NQD^T FQ
+         *
+         * :param const Eigen::MatrixXd &FQhat: The ghost micro force vector
+         * :param const Eigen::MatrixXd &FDhat: The ghost macro force vector
+         * :param Eigen::MatrixXd &FQ: The contribution to the free micro force vector
+         * :param Eigen::MatrixXd &FD: The contribution to the free macro force vector
+         */
 
-            SparseMatrix domainE;
-            error = DOFProjection::assembleMicroDomainHomogenizationMatrixContribution( domainName, domainNodes,
-                                                                                        *_inputProcessor.getMicroDensities( ),
-                                                                                        *_inputProcessor.getMicroVolumes( ),
-                                                                                        *_inputProcessor.getMicroWeights( ),
-                                                                                        domainReferenceXiVectors,
-                                                                                        *_inputProcessor.getMicroGlobalToLocalDOFMap( ),
-                                                                                        referenceMicroDomainMass, referenceMicroDomainMomentsOfInertia,
-                                                                                        *_inputProcessor.getMicroDomainIDMap( ),
-                                                                                        domainE );
+        if ( ( FQhat.rows( ) != _L2ProjectorNQhatDhat.rows( ) ) || ( FDhat.rows( ) != _L2ProjectorNQhatDhat.cols( ) ) ){
 
-            if ( _homogenizationMatrix_initialized ){
+            return new errorNode( __func__, "The ghost force vectors are not consistent with the interpolation matrix" );
 
-                _homogenizationMatrix += domainE;
+        }
 
-            }
-            else{
+        Eigen::MatrixXd w = FDhat;
+        w += _L2ProjectorNQhatDhat.transpose( ) * FQhat;
 
-                _homogenizationMatrix = domainE;
-                _homogenizationMatrix_initialized = true;
+        errorOut error = applyPseudoInverseTranspose( w, FQ );
 
-            }
+        if ( error ){
+
+            errorOut result = new errorNode( __func__, "Error in the application of the transpose of the pseudo-inverse" );
+            result->addNext( error );
+            return result;
 
         }
 
-        return NULL;
+        FD = _L2ProjectorNQhatD.transpose( ) * FQhat;
+        FD -= _L2ProjectorNQD.transpose( ) * FQ;
 
+        return NULL;
     }
 
-    errorOut overlapCoupling::processDomainMassData( const unsigned int &microIncrement, const std::string &domainName,
-                                                     domainFloatMap &domainMass, domainFloatVectorMap &domainCenterOfMass,
-                                                     domainFloatVectorMap &domainMomentOfInertia,
-                                                     std::unordered_map< uIntType, floatVector > &domainXiVectors,
-                                                     std::unique_ptr< elib::Element > &element ){
+    errorOut overlapCoupling::formAveragedL2Projectors( ){
         /*!
-         * Process a micro-scale domain
+         * Form the projectors using the averaged micro domain values at the centers of mass.
          *
-         * :param const unsigned int microIncrement: The micro increment to process
-         * :param const std::string &domainName: The name of the domain
-         * :param domainFloatMap &domainMass: The mass of the domain
-         * :param domainFloatVectorMap &domainCenterOfMass: The center of mass of the domain
-         * :param domainFloatVectorMap &domainMomentOfInertia: The moment of inertia of the domain
-         * :param std::unordered_map< uIntType, floatVector > &domainXiVectors: The Xi vectors of the domain
-         * :param std::unique_ptr< elib::Element > &element: The macroscale element. Defualts to NULL;
+         * This is the currently recommended projection method
          */
 
-        //Get the domain's nodes
-        uIntVector domainNodes;
-
-        errorOut error = _inputProcessor._microscale->getSubDomainNodes( microIncrement, domainName, domainNodes );
-
-        if ( error ){
-
-            errorOut result = new errorNode( __func__,
-                                             "Error in getting the nodes from the micro domain '" + domainName + "'" );
-            result->addNext( error );
-            return result;
+        //Form the micro to macro projection matrix
+        //Note: This is the FULL matrix not just the part we need for the overlap coupling.
+        //      We will select sub-blocks of it to use in the actual projectors. This may or
+        //      may not be correct.
 
-        }
+        Eigen::MatrixXd microMacroProjector;
+        SparseMatrix S, T;
 
-        floatType   mass;
-        floatVector centerOfMass;
+        uIntType nMicroDOF = _dim;
+        uIntType nMacroDOF = _dim + _dim * _dim;
 
-        if ( element ){
+        errorOut error;
 
-            std::shared_ptr< volumeReconstruction::volumeReconstructionBase > reconstructedVolume;
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "ASSEMBLING MICRO-TO-MACRO PROJECTOR\n";
+        for ( uIntType i = 0; i < nMacroDOF; i++ ){
 
-            //Reconstruct the domain
-            floatVector microNodePositions;
-            error = reconstructDomain( microIncrement, domainName, domainNodes, microNodePositions,
-                                       element, reconstructedVolume );
+            error = DOFProjection::formDomainSelectionMatrix( i, nMacroDOF, *_inputProcessor.getMicroDomainIDMap( ), S );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the reconstruction of the microscale domain" );
+                errorOut result = new errorNode( __func__, "Error in the formation of the selection matrix" );
                 result->addNext( error );
                 return result;
 
             }
 
-            const std::unordered_map< uIntType, floatType > *microDensities = _inputProcessor.getMicroDensities( );
-            const std::unordered_map< uIntType, floatType > *microVolumes = _inputProcessor.getMicroVolumes( );
-            const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
-            const std::unordered_map< uIntType, floatVector > *microDisplacements = _inputProcessor.getMicroDisplacements( );
+            error = DOFProjection::formMacroNodeExpansionMatrix( i, nMacroDOF, *_inputProcessor.getMacroGlobalToLocalDOFMap( ), T );
 
-            //Compute the domain mass properties
-            uIntType dataCountAtPoint = 2 + _dim;
-            uIntType index = 0;
-            floatVector dataAtMicroPoints( dataCountAtPoint * domainNodes.size( ), 0 );
-            for ( auto node = domainNodes.begin( ); node != domainNodes.end( ); node++, index++ ){
+            if ( error ){
 
-                dataAtMicroPoints[ dataCountAtPoint * index + 0 ] = 1.; //Integrate the volume of the domain
-    
-                auto microDensity = microDensities->find( *node );
-                if ( microDensity == microDensities->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) + " was not found in the micro density map" );
-                }
-    
-                dataAtMicroPoints[ dataCountAtPoint * index + 1 ] = microDensity->second; //Integrate the density of the domain
-    
-                auto microReferencePosition = microReferencePositions->find( *node );
-                if ( microReferencePosition == microReferencePositions->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) +
-                                          " was not found in the micro reference position map" );
-                }
-    
-                auto microDisplacement = microDisplacements->find( *node );
-                if ( microDisplacement == microDisplacements->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) +
-                                          " was not found in the micro displacement map" );
-                }
-    
-                //Integrate for the domain's center of mass
-                for ( unsigned int i = 0; i < _dim; i++ ){
-        
-                    dataAtMicroPoints[ dataCountAtPoint * index + 2 + i ] =
-                        microDensity->second * ( microReferencePosition->second[ i ] + microDisplacement->second[ i ] );
-        
-                }
+                errorOut result = new errorNode( __func__, "Error in the formation of the expansion matrix" );
+                result->addNext( error );
+                return result;
 
             }
 
-            floatVector integratedValues;
-            error = reconstructedVolume->performVolumeIntegration( dataAtMicroPoints, dataCountAtPoint, integratedValues );
+            if ( i == 0 ){
 
-            if ( error ){
+                microMacroProjector = T * _centerOfMassProjector * S;
 
-                errorOut result = new errorNode( __func__, "Error in performing volume integration" );
-                result->addNext( error );
-                return result;
             }
+            else{
 
-            mass = integratedValues[ 1 ];
-            centerOfMass = floatVector( integratedValues.begin( ) + 2, integratedValues.end( ) ) / mass;
-
-        }
-        else{
+                microMacroProjector += T * _centerOfMassProjector * S;
 
-            //Compute the center of mass of the domain
-            error = DOFProjection::computeDomainCenterOfMass( _dim, domainNodes, *_inputProcessor.getMicroVolumes( ),
-                                                              *_inputProcessor.getMicroDensities( ),
-                                                              *_inputProcessor.getMicroNodeReferencePositions( ),
-                                                              *_inputProcessor.getMicroDisplacements( ),
-                                                              *_inputProcessor.getMicroWeights( ),
-                                                              mass, centerOfMass );
-    
-            if ( error ){
-    
-                errorOut result = new errorNode( __func__, "Error in calculation of '" + domainName + "' center of mass" );
-                result->addNext( error );
-                return result;
-    
             }
 
         }
 
-        domainMass.emplace( domainName, mass );
-        domainCenterOfMass.emplace( domainName, centerOfMass );
+        //Set the DOF type sizes
+        uIntType nFreeMacroDOF  = nMacroDOF * _inputProcessor.getFreeMacroNodeIds( )->size( );        
+        uIntType nGhostMacroDOF = nMacroDOF * _inputProcessor.getGhostMacroNodeIds( )->size( );
 
-        //Compute the relative position vectors
-        floatVector momentOfInertia;
-        error = DOFProjection::computeDomainXis( _dim, domainNodes,
-                                                 *_inputProcessor.getMicroNodeReferencePositions( ),
-                                                 *_inputProcessor.getMicroDisplacements( ),
-                                                 *_inputProcessor.getMicroVolumes( ),
-                                                 *_inputProcessor.getMicroDensities( ),
-                                                 *_inputProcessor.getMicroWeights( ),
-                                                 domainCenterOfMass[ domainName ], domainXiVectors, momentOfInertia );
+        uIntType nFreeMicroDOF  = nMicroDOF * _inputProcessor.getFreeMicroNodeIds( )->size( );
+        uIntType nGhostMicroDOF = nMicroDOF * _inputProcessor.getGhostMicroNodeIds( )->size( );
 
-        if ( error ){
-            
-            errorOut result = new errorNode( __func__, "Error in calculation of '" + domainName + "' xi vectors" );
-            result->addNext( error );
-            return result;
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "ASSEMBLING THE PROJECTORS\n";
+        floatType sparseFactor
+        = 1e-4 * 0.5 * ( std::fabs( microMacroProjector.maxCoeff( ) ) + std::fabs( microMacroProjector.minCoeff( ) ) ); //TODO: Make the 1e-4 settable by the user
+    
+        //Add the homogenization matrix
+        microMacroProjector *= _homogenizationMatrix;
 
-        }
+        //Compute the projectors
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  BDhatQ\n";
+    
+        _sparse_BDhatQ = microMacroProjector.bottomLeftCorner( nGhostMacroDOF, nFreeMicroDOF ).sparseView( 1, sparseFactor );
+    
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  BQhatQ\n";
+        _sparse_BQhatQ = _N.bottomRightCorner( nGhostMicroDOF, nGhostMacroDOF ) * _sparse_BDhatQ;
+    
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  BDhatD\n";
+        _sparse_BDhatD = -_sparse_BDhatQ * _N.topLeftCorner( nFreeMicroDOF, nFreeMacroDOF );
 
-        domainMomentOfInertia.emplace( domainName, momentOfInertia );
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  BQhatD\n";
+        _sparse_BQhatD = _N.bottomLeftCorner( nGhostMicroDOF, nFreeMacroDOF );
+        _sparse_BQhatD += _N.bottomRightCorner( nGhostMicroDOF, nGhostMacroDOF ) * _sparse_BDhatD;
 
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "PROJECTORS ASSEMBLED\n";
         return NULL;
-
     }
 
-    errorOut overlapCoupling::computeDomainShapeFunctionInformation( const unsigned int &cellID,
-                                                                     const std::string &domainName,
-                                                                     const unsigned int &microIncrement,
-                                                                     const floatVector &domainCenterOfMass,
-                                                                     uIntVector &macroNodes,
-                                                                     floatVector &domainCenterOfMassShapeFunctionValues,
-                                                                     std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues ){
+    errorOut overlapCoupling::formDirectProjectionProjectors( const unsigned int &microIncrement, const unsigned int &macroIncrement ){
         /*!
-         * Compute the shape function values at the required locations
+         * Form the projectors if the direct projection is to be used
          *
-         * :param const unsigned int &cellID: The ID number of the cell which contains the domain
-         * :param const std::string &domainName: The name of the nodeset which defines the micro-scale domain
-         * :param const unsigned int &microIncrement: The micro-scale increment to analyze
-         * :param const floatVector &domainCenterOfMass: The center of mass of the domain
-         * :param uIntVector &macroNodes: The IDs of the macro nodes corresponding with the shape functions
-         * :param floatVector &domainCenterOfMassShapeFunctionValues: The shapefunction values at the center of mass
-         * :param std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues:
-         *     The shapefunction values at all of the micro nodes contained within the domain.
+         * :param const unsigned int &microIncrement: The micro increment at which to form the projectors
+         * :param const unsigned int &macroIncrement: The macro increment at which to form the projectors
          */
 
-        //Compute the shape functions of the domain's center of mass
-        errorOut error = computeShapeFunctionsAtPoint( cellID,
-                                                       *_inputProcessor.getMacroNodeReferencePositions( ),
-                                                       *_inputProcessor.getMacroDisplacements( ),
-                                                       *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                                       domainCenterOfMass, macroNodes, domainCenterOfMassShapeFunctionValues );
+        return new errorNode( __func__,
+                              "This subroutine, and the routines it calls, requires extensive re-working to obtain the expected results. The method is not recommended so this has not been done yet." );
 
-        if ( error ){
+        //Get the ghost macro cell IDs
+        const uIntVector *ghostMacroCellIDs = _inputProcessor.getGhostMacroCellIds( );
+        const std::unordered_map< uIntType, stringVector > *macroCellToMicroDomainMap = _inputProcessor.getMacroCellToDomainMap( );
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the computation of the shape function at the center of mass for a micro domain" );
-            result->addNext( error );
-            return result;
+        const stringVector *ghostMacroDomainNames = _inputProcessor.getGhostMacroDomainNames( );
 
-        }
+        unsigned int cellIndex;
 
-        //Get the domain's nodes
-        uIntVector domainNodes;
+        errorOut error = NULL;
 
-        error = _inputProcessor._microscale->getSubDomainNodes( microIncrement, domainName, domainNodes );
+        uIntVector macroNodes;
 
-        if ( error ){
+        //Form the projector from the free micro-scale to the ghost macro-scale
+        for ( auto cellID  = ghostMacroCellIDs->begin( );
+                   cellID != ghostMacroCellIDs->end( );
+                   cellID++ ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the extraction of the nodes in the micro domain" );
-            result->addNext( error );
-            return result;
+            //Set the index
+            cellIndex = cellID - ghostMacroCellIDs->begin( );
 
-        }
+            //Set the number of micro-domains encompassed by the cell
+            auto microDomains = macroCellToMicroDomainMap->find( *cellID );
 
-        if ( _inputProcessor.computeMicroShapeFunctions( ) ){
+            if ( microDomains == macroCellToMicroDomainMap->end( ) ){
 
-            //Get the micro-node positions
-            std::unordered_map< uIntType, floatVector > microNodePositions;
-    
-            const std::unordered_map< uIntType, floatVector > *microReferencePositions
-                = _inputProcessor.getMicroNodeReferencePositions( );
-            const std::unordered_map< uIntType, floatVector > *microDisplacements
-                = _inputProcessor.getMicroDisplacements( );
+                return new errorNode( __func__,
+                                      "Macro cell " + std::to_string( *cellID ) + " not found in the macro cell to micro domain map" );
 
-            microNodePositions.reserve( microReferencePositions->size( ) );
-            for ( auto it = domainNodes.begin( ); it != domainNodes.end( ); it++ ){
-  
-                auto microReferencePosition = microReferencePositions->find( *it );
+            }
 
-                if ( microReferencePosition == microReferencePositions->end( ) ){
+            //Get the macro-node set
+            error = _inputProcessor._macroscale->getSubDomainNodes( macroIncrement, ( *ghostMacroDomainNames )[ cellIndex ], macroNodes );
 
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *it ) + " was not found in the reference position map" );
+            if ( error ){
 
-                }
+                errorOut result = new errorNode( __func__,
+                                                 "Error in extracting the ghost macro-node set" );
+                result->addNext( error );
+                return result;
 
-                auto microDisplacement = microDisplacements->find( *it );
-                if ( microDisplacement == microDisplacements->end( ) ){
+            }
 
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *it ) + " was not found in the displacement map" );
+            //Loop over the free micro-domains
+            for ( auto domain  = microDomains->second.begin( ); domain != microDomains->second.end( ); domain++ ){
 
-                }
+                error = addDomainContributionToDirectFreeMicroToGhostMacroProjector( cellIndex, *cellID, microIncrement, 
+                                                                                     *domain, macroNodes );
 
-                microNodePositions.emplace( *it, microReferencePosition->second + microDisplacement->second );
-    
-            }
-    
-            //Compute the shape function values at the micro positions
-            error = computeShapeFunctionsAtPoints( cellID,
-                                                   *_inputProcessor.getMacroNodeReferencePositions( ),
-                                                   *_inputProcessor.getMacroDisplacements( ),
-                                                   *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                                   microNodePositions, macroNodes,
-                                                   domainMicroPositionShapeFunctionValues );
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in processing free micro-scale domain '" + *domain + "' for a ghost macro domain reference state" );
+                    result->addNext( error );
+                    return result;
+
+                }
 
-            if ( error ){
-    
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the shape function at the center of mass for a micro domain" );
-                result->addNext( error );
-                return result;
-    
             }
 
         }
 
-        return NULL;
+        //Set the dimension of the displacement DOF
+        unsigned int nDispMicroDOF = _dim;
+
+        unsigned int nDispMacroDOF = _dim + _dim * _dim;
+
+        //Get the number of micro degrees of freedom which are free and ghost
+        unsigned int nFreeMicroDOF = nDispMicroDOF * _inputProcessor.getFreeMicroNodeIds( )->size( );
+        unsigned int nGhostMicroDOF = nDispMicroDOF * _inputProcessor.getGhostMicroNodeIds( )->size( );
+
+        //Get the number of macro degrees of freedom which are free and ghost
+        unsigned int nFreeMacroDOF = nDispMacroDOF * _inputProcessor.getFreeMacroNodeIds( )->size( );
+        unsigned int nGhostMacroDOF = nDispMacroDOF * _inputProcessor.getGhostMacroNodeIds( )->size( );
 
+        //Assemble the remaining projectors
+
+        _sparse_BDhatD = -_sparse_BDhatQ * _N.topLeftCorner( nFreeMicroDOF, nFreeMacroDOF );
+
+        _sparse_BQhatQ = _N.bottomRightCorner( nGhostMicroDOF, nGhostMacroDOF ) * _sparse_BDhatQ;
+
+        _sparse_BQhatD = _N.bottomLeftCorner( nGhostMicroDOF, nFreeMacroDOF )
+                   + _N.bottomRightCorner( nGhostMicroDOF, nGhostMacroDOF ) * _sparse_BDhatD;
+
+        return NULL;
     }
 
-    errorOut overlapCoupling::computeIncrementCentersOfMass( const unsigned int microIncrement, const unsigned int macroIncrement,
-                                                             domainFloatMap &freeDomainMass, domainFloatMap &ghostDomainMass,
-                                                             domainFloatVectorMap &freeDomainCM,
-                                                             domainFloatVectorMap &ghostDomainCM ){
+    errorOut overlapCoupling::processDomainReference( const unsigned int &microIncrement,
+                                                      const std::string &domainName,
+                                                      const unsigned int cellID, uIntVector &macroNodes,
+                                                      domainFloatMap   &referenceMicroDomainMass,
+                                                      domainFloatVectorMap &referenceMicroDomainCentersOfMass,
+                                                      domainFloatVectorMap &referenceMicroDomainMomentsOfInertia,
+                                                      std::unordered_map< uIntType, floatVector > &domainReferenceXiVectors,
+                                                      floatVector &domainCenterOfMassShapeFunctionValues,
+                                                      std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues ){
         /*!
-         * Compute the centers of mass for a micro increment. Also computes the mass of the micro-scale domains
+         * Process the domain for use with preparing the reference configuration
          *
-         * :param const unsigned int microIncrement: The micro increment at which to compute the centers of mass
-         * :param const unsigned int macroIncrement: The macro increment at which to compute the centers of mass
-         * :param domainFloatMap &freeDomainMass: The mass of the free domains
-         * :param domainFloatMap &ghostDomainMass: The mass of the ghost domains
-         * :param domainFloatVectorMap &freeDomainCM: The center of mass of the free domains
-         * :param domainFloatVectorMap &ghostDomainCM: The center of mass of the ghost domains
+         * :param const unsigned int &microIncrement: The micro-scale increment at which to compute the reference
+         * :param const std::string &domainName: The name of the domain
+         * :param const unsigned int cellID: The global cell ID number
+         * :param uIntVector &macroNodes: The nodes of the macro domain
+         * :param domainFloatMap   &referenceMicroDomainMass: The reference mass of the micro domain. This
+         *     should be a reference to the micro-domain mass vector
+         * :param domainFloatVectorMap &referenceMicroDomainCentersOfMass: The reference micro-domain center of mass
+         *     vector for all of the micro domains
+         * :param domainFloatVectorMap &referenceDomainMomentsOfInertia: The reference moment of inertia for all of the micro domains
+         * :param std::unordered_map< uIntType, floatVector > &domainReferenceXiVectors: The reference Xi vectors for the domain.
+         * :param floatVector &domainCenterOfMassShapeFunctionValues: The shape function values at the 
+         *     center of mass
+         * :param std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues: The shape function values at the
+         *     micro node positions inside of the domain. This is only computed if indicated by the 
+         *     configuration file.
          */
 
-        //Compute the centers of mass of each domain
-        errorOut error = _inputProcessor.initializeIncrement( microIncrement, macroIncrement );
-        if ( error ){
-            errorOut result = new errorNode( __func__, "Error in initialization of the initial increment" );
-            result->addNext( error );
-            return result;
-        }
+        //Clear the existing Xi and shapefunction maps
+        domainReferenceXiVectors.clear( );
+        domainMicroPositionShapeFunctionValues.clear( );
 
-        //Loop over the free micro-domains
-        const stringVector* freeDomains = _inputProcessor.getFreeMicroDomainNames( );
-        uIntVector domainNodes;
+        //Process the domain mass data
+        floatVector domainCenterOfMass;
 
-        floatVector domainCM( _dim );
+        //Form the macro element if required
+        std::unique_ptr< elib::Element > element;
+        element.reset(NULL);
 
-        freeDomainMass.clear( );
-        freeDomainCM.clear( );
+        if ( _inputProcessor.isFiltering( ) && _inputProcessor.useReconstructedVolumeForMassMatrix( ) ){
 
-        unsigned int indx = 0;
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_WARNING ) << "#########################################################\n"
+                                                                      << "###                      Warning                      ###\n"
+                                                                      << "#########################################################\n"
+                                                                      << "# Using the reconstructed volume for the center of mass #\n"
+                                                                      << "# can result in drastically inconsistent deformation    #\n"
+                                                                      << "# when filtering. Overriding to use direct computation  #\n"
+                                                                      << "#########################################################\n";
 
-        for ( auto name = freeDomains->begin( ); name != freeDomains->end( ); name++ ){
+        }
+        else if ( _inputProcessor.useReconstructedVolumeForMassMatrix( ) ){
 
-            error = _inputProcessor._microscale->getSubDomainNodes( microIncrement, *name, domainNodes );
+            errorOut error = buildMacroDomainElement( cellID,
+                                                      *_inputProcessor.getMacroNodeReferencePositions( ),
+                                                      *_inputProcessor.getMacroDisplacements( ),
+                                                      *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                                      element );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__, "Error in extraction of the free domain's nodes" );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the construction of the macro-scale element " + std::to_string( cellID ) );
                 result->addNext( error );
                 return result;
 
             }
 
-            floatType mass;
-            floatVector centerOfMass;
-            error = DOFProjection::computeDomainCenterOfMass( _dim, domainNodes, *_inputProcessor.getMicroVolumes( ),
-                                                              *_inputProcessor.getMicroDensities( ),
-                                                              *_inputProcessor.getMicroNodeReferencePositions( ),
-                                                              *_inputProcessor.getMicroDisplacements( ),
-                                                              *_inputProcessor.getMicroWeights( ),
-                                                              mass, centerOfMass );
-            if ( error ){
-
-                errorOut result = new errorNode( __func__, "Error in calculation of '" + *name + "' center of mass" );
-                result->addNext( error );
-                return result;
+        }
 
-            }
-            
-            freeDomainMass.emplace( *name, mass );
-            freeDomainCM.emplace( *name, centerOfMass );
+        errorOut error = processDomainMassData( microIncrement, domainName, referenceMicroDomainMass,
+                                                referenceMicroDomainCentersOfMass, referenceMicroDomainMomentsOfInertia,
+                                                domainReferenceXiVectors, element );
+#ifdef TESTACCESS
+        _test_domainMass[ cellID ].emplace( domainName, referenceMicroDomainMass[ domainName ] );
+        _test_domainCOM[ cellID ].emplace( domainName, referenceMicroDomainCentersOfMass[ domainName ] );
+        _test_domainXi[ cellID ].emplace( domainName, domainReferenceXiVectors );
+#endif
 
-            indx++;
+        if ( error ){
+            
+            errorOut result = new errorNode( __func__,
+                                             "Error in processing the mass data for the micro domain '" + domainName + "'" );
+            result->addNext( error );
+            return result;
 
         }
 
-        //Loop over the ghost micro-domains
-        const stringVector* ghostDomains = _inputProcessor.getGhostMicroDomainNames( );
+        //Compute the domain's shape function information
+        error = computeDomainShapeFunctionInformation( cellID, domainName, microIncrement,
+                                                       referenceMicroDomainCentersOfMass[ domainName ],
+                                                       macroNodes,
+                                                       domainCenterOfMassShapeFunctionValues,
+                                                       domainMicroPositionShapeFunctionValues );
 
-        ghostDomainMass.clear( );
-        ghostDomainCM.clear( );
+        _referenceCellDomainCenterOfMassShapefunctions[ cellID ].emplace( domainName, domainCenterOfMassShapeFunctionValues );
 
-        indx = 0;
+#ifdef TESTACCESS
+        if ( _inputProcessor.getCouplingInitialization( )[ "projection_type" ].as< std::string >( ).compare( "direct_projection" ) == 0 ){
+            _test_domainMUP[ cellID ].emplace( domainName, domainMicroPositionShapeFunctionValues );
+        }
+#endif
 
-        for ( auto name = ghostDomains->begin( ); name != ghostDomains->end( ); name++ ){
+        if ( error ){
+            errorOut result = new errorNode( __func__,
+                                             "Error in computing the shape function values for the domain center of mass or the domainMicroPositionShapeFunctionValues" );
+            result->addNext( error );
+            return result;
+        }
+
+        //Get the domain node ids
+        uIntVector domainNodes;
+        error = _inputProcessor.getMicroDomainNodes( microIncrement, domainName, domainNodes );
+
+        if ( error ){
+            errorOut result = new errorNode( __func__,
+                                             "Error in extracting the micro-node set" );
+            result->addNext( error );
+            return result;
+        }
+
+        //Add the domain's contribution to the shape function matrix
+        error = addDomainContributionToInterpolationMatrix( domainNodes, macroNodes, domainReferenceXiVectors,
+                                                            domainCenterOfMassShapeFunctionValues );
+
+        if ( error ){
+            errorOut result = new errorNode( __func__,
+                                             "Error in adding part of the shapefunction matrix determined from '" + domainName + "'" );
+            result->addNext( error );
+            return result;
+        }
+
+        //If the projection time is the direct projection method, we need to save some values
+        if ( _inputProcessor.getCouplingInitialization( )[ "projection_type" ].as< std::string >( ).compare( "direct_projection" ) == 0 ){
 
-            error = _inputProcessor._microscale->getSubDomainNodes( microIncrement, *name, domainNodes );
+            //Save the contributions of the domain to the direct projection values
+            error = addDomainToDirectProjectionReferenceValues( domainNodes, macroNodes, domainReferenceXiVectors,
+                                                                domainMicroPositionShapeFunctionValues );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__, "Error in extraction of the ghost domain's nodes" );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in saving the direct projection reference values" );
                 result->addNext( error );
                 return result;
 
             }
 
-            floatType mass;
-            floatVector centerOfMass;
-            error = DOFProjection::computeDomainCenterOfMass( _dim, domainNodes, *_inputProcessor.getMicroVolumes( ),
-                                                              *_inputProcessor.getMicroDensities( ),
-                                                              *_inputProcessor.getMicroNodeReferencePositions( ),
-                                                              *_inputProcessor.getMicroDisplacements( ),
-                                                              *_inputProcessor.getMicroWeights( ),
-                                                              mass, centerOfMass );
+        }
+        if ( _inputProcessor.getCouplingInitialization( )[ "projection_type" ].as< std::string >( ).compare( "averaged_l2_projection" ) == 0 ){
 
-            if ( error ){
+            SparseMatrix domainE;
+            error = DOFProjection::assembleMicroDomainHomogenizationMatrixContribution( domainName, domainNodes,
+                                                                                        *_inputProcessor.getMicroDensities( ),
+                                                                                        *_inputProcessor.getMicroVolumes( ),
+                                                                                        *_inputProcessor.getMicroWeights( ),
+                                                                                        domainReferenceXiVectors,
+                                                                                        *_inputProcessor.getMicroGlobalToLocalDOFMap( ),
+                                                                                        referenceMicroDomainMass, referenceMicroDomainMomentsOfInertia,
+                                                                                        *_inputProcessor.getMicroDomainIDMap( ),
+                                                                                        domainE );
 
-                errorOut result = new errorNode( __func__, "Error in calculation of '" + *name + "' center of mass" );
-                result->addNext( error );
-                return result;
+            if ( _homogenizationMatrix_initialized ){
+
+                _homogenizationMatrix += domainE;
 
             }
+            else{
 
-            ghostDomainMass.emplace( *name, mass );
-            ghostDomainCM.emplace( *name, centerOfMass );
+                _homogenizationMatrix = domainE;
+                _homogenizationMatrix_initialized = true;
 
-            indx++;
+            }
 
         }
 
         return NULL;
+
     }
 
-    errorOut overlapCoupling::buildMacroDomainElement( const unsigned int cellID,
-                                                       const std::unordered_map< uIntType, floatVector > &nodeLocations,
-                                                       const std::unordered_map< uIntType, uIntVector > &connectivity,
-                                                       std::unique_ptr< elib::Element > &element ){
+    errorOut overlapCoupling::processDomainMassData( const unsigned int &microIncrement, const std::string &domainName,
+                                                     domainFloatMap &domainMass, domainFloatVectorMap &domainCenterOfMass,
+                                                     domainFloatVectorMap &domainMomentOfInertia,
+                                                     std::unordered_map< uIntType, floatVector > &domainXiVectors,
+                                                     std::unique_ptr< elib::Element > &element ){
         /*!
-         * Construct a finite element representation of the macro domain
+         * Process a micro-scale domain
          *
-         * :param const unsigned int cellID: The macro cell ID number
-         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal location vector
-         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity vector
-         * :param std::unique_ptr< elib::Element > &element: The element representation of the macro domain
+         * :param const unsigned int microIncrement: The micro increment to process
+         * :param const std::string &domainName: The name of the domain
+         * :param domainFloatMap &domainMass: The mass of the domain
+         * :param domainFloatVectorMap &domainCenterOfMass: The center of mass of the domain
+         * :param domainFloatVectorMap &domainMomentOfInertia: The moment of inertia of the domain
+         * :param std::unordered_map< uIntType, floatVector > &domainXiVectors: The Xi vectors of the domain
+         * :param std::unique_ptr< elib::Element > &element: The macroscale element. Defualts to NULL;
          */
 
-        //Get the XDMF cell type
-        auto connectivityCellIndices = connectivity.find( cellID );
-        if ( connectivityCellIndices == connectivity.end( ) ){
-
-            return new errorNode( __func__,
-                                  "Cell ID " + std::to_string( cellID ) + " was not found in the connectivity map" );
-
-        }
-        unsigned int cellType = connectivityCellIndices->second[ 0 ];
+        //Get the domain's nodes
+        uIntVector domainNodes;
 
-        //Get the element name
-        auto it = elib::XDMFTypeToElementName.find( cellType );
+        errorOut error = _inputProcessor.getMicroDomainNodes( microIncrement, domainName, domainNodes );
 
-        if ( it == elib::XDMFTypeToElementName.end( ) ){
+        if ( error ){
 
-            return new errorNode( __func__,
-                                  "The cell type " + std::to_string(cellType) + " is not supported" );
+            errorOut result = new errorNode( __func__,
+                                             "Error in getting the nodes from the micro domain '" + domainName + "'" );
+            result->addNext( error );
+            return result;
 
         }
-        
-        //Get the nodes from the file
-        elib::vecOfvec nodes( connectivityCellIndices->second.size( ) - 1, elib::vec( _dim, 0 ) );
-        uIntVector globalNodeIds( connectivityCellIndices->second.begin( ) + 1,
-                                  connectivityCellIndices->second.end( ) );
-        for ( auto nodeId = globalNodeIds.begin( ); nodeId != globalNodeIds.end( ); nodeId++ ){
 
-            auto nodeLocation = nodeLocations.find( *nodeId );
+        floatType   mass;
+        floatVector centerOfMass;
 
-            if ( nodeLocation == nodeLocations.end( ) ){
+        if ( element ){
 
-                return new errorNode( __func__, "Node " + std::to_string( *nodeId ) + " was not found in the node locations map" );
+            std::shared_ptr< volumeReconstruction::volumeReconstructionBase > reconstructedVolume;
 
-            }
+            //Reconstruct the domain
+            floatVector microNodePositions;
+            error = reconstructDomain( microIncrement, domainName, domainNodes, microNodePositions,
+                                       element, reconstructedVolume );
 
-            uIntType index = nodeId - globalNodeIds.begin( );
+            if ( error ){
 
-            nodes[ index ] = nodeLocation->second;
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the reconstruction of the microscale domain" );
+                result->addNext( error );
+                return result;
 
-        }
-        
-        //Get the element
-        auto qrule = elib::default_qrules.find( it->second );
-        if ( qrule == elib::default_qrules.end( ) ){
+            }
 
-            return new errorNode( __func__,
-                                  "The element type " + it->second + " is not found in the default quadrature rules map" );
+            const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+            const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
+            const floatType *microDensity, *microDisplacement;
+            uIntType stride;
 
-        }
+            //Compute the domain mass properties
+            uIntType dataCountAtPoint = 2 + _dim;
+            uIntType index = 0;
+            floatVector dataAtMicroPoints( dataCountAtPoint * domainNodes.size( ), 0 );
+            for ( auto node = domainNodes.begin( ); node != domainNodes.end( ); node++, index++ ){
 
-        element = elib::build_element_from_string( it->second, globalNodeIds, nodes, qrule->second );
+                dataAtMicroPoints[ dataCountAtPoint * index + 0 ] = 1.; //Integrate the volume of the domain
+    
+                error = microNodeFields->getNodeValues( "density", *node, microDensity, stride );
+                if ( error ){
+                    errorOut result = new errorNode( __func__,
+                                                     "Micro node " + std::to_string( *node ) + " was not found in the micro density field" );
+                    result->addNext( error );
+                    return result;
+                }
+    
+                dataAtMicroPoints[ dataCountAtPoint * index + 1 ] = *microDensity; //Integrate the density of the domain
+    
+                auto microReferencePosition = microReferencePositions->find( *node );
+                if ( microReferencePosition == microReferencePositions->end( ) ){
+                    return new errorNode( __func__,
+                                          "Micro node " + std::to_string( *node ) +
+                                          " was not found in the micro reference position map" );
+                }
+    
+                error = microNodeFields->getNodeValues( "displacement", *node, microDisplacement, stride );
+                if ( error ){
+                    errorOut result = new errorNode( __func__,
+                                                     "Micro node " + std::to_string( *node ) +
+                                                     " was not found in the micro displacement field" );
+                    result->addNext( error );
+                    return result;
+                }
+    
+                //Integrate for the domain's center of mass
+                for ( unsigned int i = 0; i < _dim; i++ ){
+        
+                    dataAtMicroPoints[ dataCountAtPoint * index + 2 + i ] =
+                        ( *microDensity ) * ( microReferencePosition->second[ i ] + microDisplacement[ i ] );
+        
+                }
 
-        return NULL;
-    }
+            }
 
-    errorOut overlapCoupling::buildMacroDomainElement( const unsigned int cellID,
-                                                       const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
-                                                       const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
-                                                       const std::unordered_map< uIntType, uIntVector > &connectivity,
-                                                       std::unique_ptr< elib::Element > &element ){
-        /*!
-         * Construct a finite element representation of the macro domain
-         *
-         * :param const unsigned int cellID: The macro cell ID number
-         * :param const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations: The nodal reference location vector
-         * :param const std::unordered_map< uIntType, floatVector > &nodeDisplacements: The nodal displacement vector
-         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity vector
-         * :param std::unique_ptr< elib::Element > &element: The element representation of the macro domain
-         */
+            floatVector integratedValues;
+            error = reconstructedVolume->performVolumeIntegration( dataAtMicroPoints, dataCountAtPoint, integratedValues );
 
-        //Make sure the cellID is allowable
-        auto connectivityCellIndices = connectivity.find( cellID );
+            if ( error ){
 
-        if ( connectivityCellIndices == connectivity.end( ) ){
+                errorOut result = new errorNode( __func__, "Error in performing volume integration" );
+                result->addNext( error );
+                return result;
+            }
 
-            return new errorNode( __func__, 
-                                  "Cell " + std::to_string( cellID ) + " was not found in the connectivity map" );
+            mass = integratedValues[ 1 ];
+            centerOfMass = floatVector( integratedValues.begin( ) + 2, integratedValues.end( ) ) / mass;
 
         }
+        else{
 
-        //Get the XDMF cell type
-        unsigned int cellType = connectivityCellIndices->second[ 0 ];
-
-        //Get the element name
-        auto it = elib::XDMFTypeToElementName.find( cellType );
-
-        if ( it == elib::XDMFTypeToElementName.end( ) ){
-
-            return new errorNode( __func__,
-                                  "The cell type " + std::to_string(cellType) + " is not supported" );
-
-        }
-
-        //Get the nodes from the file
-        elib::vecOfvec referenceNodes( connectivityCellIndices->second.size( ) - 1, elib::vec( _dim, 0 ) );
-        elib::vecOfvec displacements( connectivityCellIndices->second.size( ) - 1, elib::vec( _dim, 0 ) );
-        uIntVector globalNodeIds( connectivityCellIndices->second.begin( ) + 1,
-                                  connectivityCellIndices->second.end( ) );
-        for ( auto nodeId = globalNodeIds.begin( ); nodeId != globalNodeIds.end( ); nodeId++ ){
-
-            uIntType index = nodeId - globalNodeIds.begin( );
-
-            auto nodeReferenceLocation = nodeReferenceLocations.find( *nodeId );
-
-            if ( nodeReferenceLocation == nodeReferenceLocations.end( ) ){
-
-                return new errorNode( __func__,
-                                      "The node " + std::to_string( *nodeId ) + " was not found in the node reference location map" );
-
+            //Compute the center of mass of the domain
+            error = DOFProjection::computeDomainCenterOfMass( _dim, domainNodes, *_inputProcessor.getMicroVolumes( ),
+                                                              *_inputProcessor.getMicroDensities( ),
+                                                              *_inputProcessor.getMicroNodeReferencePositions( ),
+                                                              *_inputProcessor.getMicroDisplacements( ),
+                                                              *_inputProcessor.getMicroWeights( ),
+                                                              mass, centerOfMass );
+    
+            if ( error ){
+    
+                errorOut result = new errorNode( __func__, "Error in calculation of '" + domainName + "' center of mass" );
+                result->addNext( error );
+                return result;
+    
             }
 
-            auto nodeDisplacement = nodeDisplacements.find( *nodeId );
-
-            if ( nodeDisplacement == nodeDisplacements.end( ) ){
-
-                return new errorNode( __func__,
-                                      "The node " + std::to_string( *nodeId ) + " was not found in the node displacement map" );
-
-            }
+        }
 
-            referenceNodes[ index ] = nodeReferenceLocation->second;
-            displacements[ index ]  = nodeDisplacement->second;
+        domainMass.emplace( domainName, mass );
+        domainCenterOfMass.emplace( domainName, centerOfMass );
 
-        }
-        
-        //Get the element
-        auto qrule = elib::default_qrules.find( it->second );
-        if ( qrule == elib::default_qrules.end( ) ){
+        //Compute the relative position vectors
+        floatVector momentOfInertia;
+        error = DOFProjection::computeDomainXis( _dim, domainNodes,
+                                                 *_inputProcessor.getMicroNodeReferencePositions( ),
+                                                 *_inputProcessor.getMicroDisplacements( ),
+                                                 *_inputProcessor.getMicroVolumes( ),
+                                                 *_inputProcessor.getMicroDensities( ),
+                                                 *_inputProcessor.getMicroWeights( ),
+                                                 domainCenterOfMass[ domainName ], domainXiVectors, momentOfInertia );
 
-            return new errorNode( __func__,
-                                  "The element type " + it->second + " is not found in the default quadrature rules map" );
+        if ( error ){
+            
+            errorOut result = new errorNode( __func__, "Error in calculation of '" + domainName + "' xi vectors" );
+            result->addNext( error );
+            return result;
 
         }
 
-        element = elib::build_element_from_string( it->second, globalNodeIds, referenceNodes, qrule->second );
-        element->update_node_positions( displacements );
+        domainMomentOfInertia.emplace( domainName, momentOfInertia );
 
         return NULL;
 
     }
 
-    errorOut overlapCoupling::computeShapeFunctionsAtPoint( const unsigned int cellID,
-                                                            const std::unordered_map< uIntType, floatVector > &nodeLocations,
-                                                            const std::unordered_map< uIntType, uIntVector > &connectivity,
-                                                            const floatVector &point, uIntVector &macroNodes,
-                                                            floatVector &shapeFunctions ){
+    errorOut overlapCoupling::computeDomainShapeFunctionInformation( const unsigned int &cellID,
+                                                                     const std::string &domainName,
+                                                                     const unsigned int &microIncrement,
+                                                                     const floatVector &domainCenterOfMass,
+                                                                     uIntVector &macroNodes,
+                                                                     floatVector &domainCenterOfMassShapeFunctionValues,
+                                                                     std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues ){
         /*!
-         * Compute the shape functions of a given macro-scale domain at a single point
+         * Compute the shape function values at the required locations
          *
-         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
-         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal location map
-         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity map
-         * :param const floatVector &point: The point at which to compute the shape functions
-         * :param uIntVector &macroNodes: The macro node ids
-         * :param floatVector &shapeFunctions: The shapefunctions at the point
+         * :param const unsigned int &cellID: The ID number of the cell which contains the domain
+         * :param const std::string &domainName: The name of the nodeset which defines the micro-scale domain
+         * :param const unsigned int &microIncrement: The micro-scale increment to analyze
+         * :param const floatVector &domainCenterOfMass: The center of mass of the domain
+         * :param uIntVector &macroNodes: The IDs of the macro nodes corresponding with the shape functions
+         * :param floatVector &domainCenterOfMassShapeFunctionValues: The shapefunction values at the center of mass
+         * :param std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues:
+         *     The shapefunction values at all of the micro nodes contained within the domain.
          */
 
-        if ( point.size( ) != _dim ){
+        //Compute the shape functions of the domain's center of mass
+        errorOut error = computeShapeFunctionsAtPoint( cellID,
+                                                       *_inputProcessor.getMacroNodeReferencePositions( ),
+                                                       *_inputProcessor.getMacroDisplacements( ),
+                                                       *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                                       domainCenterOfMass, macroNodes, domainCenterOfMassShapeFunctionValues );
 
-            return new errorNode( __func__,
-                                  "This function only works for a single point of dimension " + std::to_string( _dim ) );
+        if ( error ){
 
-        }
+            errorOut result = new errorNode( __func__,
+                                             "Error in the computation of the shape function at the center of mass for a micro domain" );
+            result->addNext( error );
+            return result;
 
-        std::unordered_map< uIntType, floatVector > pointMap;
-        pointMap.emplace( 0, point );
+        }
 
-        std::unordered_map< uIntType, floatVector > shapefunctionMap;
+        //Get the domain's nodes
+        uIntVector domainNodes;
 
-        errorOut error = computeShapeFunctionsAtPoints( cellID, nodeLocations, connectivity, pointMap, macroNodes, shapefunctionMap );
+        error = _inputProcessor.getMicroDomainNodes( microIncrement, domainName, domainNodes );
 
         if ( error ){
 
             errorOut result = new errorNode( __func__,
-                                             "Error when computing shape functions" );
+                                             "Error in the extraction of the nodes in the micro domain" );
             result->addNext( error );
             return result;
 
         }
 
-        shapeFunctions = shapefunctionMap[ 0 ];
+        if ( _inputProcessor.computeMicroShapeFunctions( ) ){
 
-        return NULL;
+            //Get the micro-node positions
+            std::unordered_map< uIntType, floatVector > microNodePositions;
+    
+            const std::unordered_map< uIntType, floatVector > *microReferencePositions
+                = _inputProcessor.getMicroNodeReferencePositions( );
+            const inputFileProcessor::nodeFieldContainer *microNodeFields
+                = _inputProcessor.getMicroNodeFields( );
+            const floatType *microDisplacement;
+            uIntType stride;
 
-    }
+            microNodePositions.reserve( microReferencePositions->size( ) );
+            for ( auto it = domainNodes.begin( ); it != domainNodes.end( ); it++ ){
+  
+                auto microReferencePosition = microReferencePositions->find( *it );
 
-    errorOut overlapCoupling::computeShapeFunctionsAtPoint( const unsigned int cellID,
-                                                            const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
-                                                            const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
-                                                            const std::unordered_map< uIntType, uIntVector > &connectivity,
-                                                            const floatVector &point, uIntVector &macroNodes,
-                                                            floatVector &shapeFunctions ){
-        /*!
-         * Compute the shape functions of a given macro-scale domain at a single point
-         *
-         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
-         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal location map
-         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal displacement map
-         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity map
-         * :param const floatVector &point: The point at which to compute the shape functions
-         * :param uIntVector &macroNodes: The macro node ids
-         * :param floatVector &shapeFunctions: The shapefunctions at the point
-         */
+                if ( microReferencePosition == microReferencePositions->end( ) ){
 
-        if ( point.size( ) != _dim ){
+                    return new errorNode( __func__,
+                                          "Micro node " + std::to_string( *it ) + " was not found in the reference position map" );
 
-            return new errorNode( __func__,
-                                  "This function only works for a single point of dimension " + std::to_string( _dim ) );
+                }
 
-        }
+                error = microNodeFields->getNodeValues( "displacement", *it, microDisplacement, stride );
+                if ( error ){
 
-        std::unordered_map< uIntType, floatVector > pointMap;
-        pointMap.emplace( 0, point );
+                    errorOut result = new errorNode( __func__,
+                                                     "Micro node " + std::to_string( *it ) + " was not found in the displacement field" );
+                    result->addNext( error );
+                    return result;
 
-        std::unordered_map< uIntType, floatVector > shapefunctionMap;
+                }
 
-        errorOut error = computeShapeFunctionsAtPoints( cellID, nodeReferenceLocations, nodeDisplacements, 
-                                                        connectivity, pointMap, macroNodes, shapefunctionMap );
+                floatVector microNodePosition = microReferencePosition->second;
 
-        if ( error ){
+                for ( unsigned int i = 0; i < _dim; i++ ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error when computing shape functions" );
-            result->addNext( error );
-            return result;
+                    microNodePosition[ i ] += microDisplacement[ i ];
 
-        }
+                }
 
-        shapeFunctions = shapefunctionMap[ 0 ];
+                microNodePositions.emplace( *it, microNodePosition );
+    
+            }
+    
+            //Compute the shape function values at the micro positions
+            error = computeShapeFunctionsAtPoints( cellID,
+                                                   *_inputProcessor.getMacroNodeReferencePositions( ),
+                                                   *_inputProcessor.getMacroDisplacements( ),
+                                                   *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                                   microNodePositions, macroNodes,
+                                                   domainMicroPositionShapeFunctionValues );
+
+            if ( error ){
+    
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the computation of the shape function at the center of mass for a micro domain" );
+                result->addNext( error );
+                return result;
+    
+            }
+
+        }
 
         return NULL;
 
     }
 
-    errorOut overlapCoupling::computeShapeFunctionsAtPoints( const unsigned int cellID,
-                                                             const std::unordered_map< uIntType, floatVector > &nodeLocations,
-                                                             const std::unordered_map< uIntType, uIntVector > &connectivity,
-                                                             const std::unordered_map< uIntType, floatVector > &points,
-                                                             uIntVector &macroNodes,
-                                                             std::unordered_map< uIntType, floatVector > &shapeFunctions ){
+    errorOut overlapCoupling::computeIncrementCentersOfMass( const unsigned int microIncrement, const unsigned int macroIncrement,
+                                                             domainFloatMap &freeDomainMass, domainFloatMap &ghostDomainMass,
+                                                             domainFloatVectorMap &freeDomainCM,
+                                                             domainFloatVectorMap &ghostDomainCM ){
         /*!
-         * Compute the shape functions of a given macro-scale domain at the given points
+         * Compute the centers of mass for a micro increment. Also computes the mass of the micro-scale domains
          *
-         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
-         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal location map
-         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity map
-         * :param const std::unordered_map< uIntType, floatVector > &points: The points at which to compute the shape functions
-         * :param uIntVector &macroNodes: The macro node ids
-         * :param std::unordered_map< uIntType, floatVector > &shapeFunctions: The shapefunctions at the points
+         * :param const unsigned int microIncrement: The micro increment at which to compute the centers of mass
+         * :param const unsigned int macroIncrement: The macro increment at which to compute the centers of mass
+         * :param domainFloatMap &freeDomainMass: The mass of the free domains
+         * :param domainFloatMap &ghostDomainMass: The mass of the ghost domains
+         * :param domainFloatVectorMap &freeDomainCM: The center of mass of the free domains
+         * :param domainFloatVectorMap &ghostDomainCM: The center of mass of the ghost domains
          */
 
-        //Build the element representing the macro-scale domain
-        std::unique_ptr< elib::Element > element;
-        errorOut error = overlapCoupling::buildMacroDomainElement( cellID, nodeLocations,
-                                                                   connectivity, element );
-
+        //Compute the centers of mass of each domain
+        errorOut error = _inputProcessor.initializeIncrement( microIncrement, macroIncrement );
         if ( error ){
-
-            errorOut result = new errorNode( __func__, "Error in element formulation" );
+            errorOut result = new errorNode( __func__, "Error in initialization of the initial increment" );
             result->addNext( error );
             return result;
-
         }
 
-        macroNodes = element->global_node_ids;
-
-        //Make sure the number of points and the size of the output are consistent
-        unsigned nPoints = points.size( );
+        //Loop over the free micro-domains
+        const stringVector* freeDomains = _inputProcessor.getFreeMicroDomainNames( );
+        uIntVector domainNodes;
 
-        shapeFunctions.clear();
-        shapeFunctions.reserve( nPoints );
+        floatVector domainCM( _dim );
 
-        //Compute the shape functions at each point
-        floatVector point;
-        floatVector localPosition, pointShapeFunctions;
+        freeDomainMass.clear( );
+        freeDomainCM.clear( );
 
-        //Loop over the output vector
-        for ( auto p = points.begin( ); p != points.end( ); p++ ){
+        unsigned int indx = 0;
 
-            error = element->compute_local_coordinates( p->second, localPosition );
+        for ( auto name = freeDomains->begin( ); name != freeDomains->end( ); name++ ){
 
-            if ( !element->local_point_inside( localPosition ) ){
+            error = _inputProcessor.getMicroDomainNodes( microIncrement, *name, domainNodes );
 
-                pointShapeFunctions = { 0 };
-                shapeFunctions.emplace( p->first, pointShapeFunctions );
-                continue;
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in extraction of the free domain's nodes" );
+                result->addNext( error );
+                return result;
 
             }
 
-            if ( error ) {
+            floatType mass;
+            floatVector centerOfMass;
+            error = DOFProjection::computeDomainCenterOfMass( _dim, domainNodes, *_inputProcessor.getMicroVolumes( ),
+                                                              *_inputProcessor.getMicroDensities( ),
+                                                              *_inputProcessor.getMicroNodeReferencePositions( ),
+                                                              *_inputProcessor.getMicroDisplacements( ),
+                                                              *_inputProcessor.getMicroWeights( ),
+                                                              mass, centerOfMass );
+            if ( error ){
 
-                return new errorNode( __func__,
-                                      "Error in computing the local coordinates for point " + std::to_string( p->first ) );
+                errorOut result = new errorNode( __func__, "Error in calculation of '" + *name + "' center of mass" );
+                result->addNext( error );
+                return result;
 
             }
+            
+            freeDomainMass.emplace( *name, mass );
+            freeDomainCM.emplace( *name, centerOfMass );
 
-            error = element->get_shape_functions( localPosition, pointShapeFunctions );
+            indx++;
 
-            if ( error ) {
+        }
 
-                return new errorNode( __func__,
-                                      "Error in the computation of the shape functions for point " + std::to_string( p->first ) );
+        //Loop over the ghost micro-domains
+        const stringVector* ghostDomains = _inputProcessor.getGhostMicroDomainNames( );
+
+        ghostDomainMass.clear( );
+        ghostDomainCM.clear( );
+
+        indx = 0;
+
+        for ( auto name = ghostDomains->begin( ); name != ghostDomains->end( ); name++ ){
+
+            error = _inputProcessor.getMicroDomainNodes( microIncrement, *name, domainNodes );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in extraction of the ghost domain's nodes" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            floatType mass;
+            floatVector centerOfMass;
+            error = DOFProjection::computeDomainCenterOfMass( _dim, domainNodes, *_inputProcessor.getMicroVolumes( ),
+                                                              *_inputProcessor.getMicroDensities( ),
+                                                              *_inputProcessor.getMicroNodeReferencePositions( ),
+                                                              *_inputProcessor.getMicroDisplacements( ),
+                                                              *_inputProcessor.getMicroWeights( ),
+                                                              mass, centerOfMass );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in calculation of '" + *name + "' center of mass" );
+                result->addNext( error );
+                return result;
 
             }
 
-            shapeFunctions.emplace( p->first, pointShapeFunctions );
+            ghostDomainMass.emplace( *name, mass );
+            ghostDomainCM.emplace( *name, centerOfMass );
+
+            indx++;
 
         }
 
         return NULL;
     }
 
-    errorOut overlapCoupling::computeShapeFunctionsAtPoints( const unsigned int cellID,
-                                                             const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
-                                                             const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
-                                                             const std::unordered_map< uIntType, uIntVector > &connectivity,
-                                                             const std::unordered_map< uIntType, floatVector > &points,
-                                                             uIntVector &macroNodes,
-                                                             std::unordered_map< uIntType, floatVector > &shapeFunctions ){
+    errorOut overlapCoupling::buildMacroDomainElement( const unsigned int cellID,
+                                                       const std::unordered_map< uIntType, floatVector > &nodeLocations,
+                                                       const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                                       std::unique_ptr< elib::Element > &element ){
         /*!
-         * Compute the shape functions of a given macro-scale domain at the given points
+         * Construct a finite element representation of the macro domain
          *
-         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
-         * :param const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations: The nodal reference location map
-         * :param const std::unordered_map< uIntType, floatVector > &nodeDisplacements: The nodal displacement map
-         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity map
-         * :param const std::unordered_map< uIntType, floatVector > &points: The points at which to compute the shape functions
-         * :param uIntVector &macroNodes: The macro node ids
-         * :param std::unordered_map< uIntType, floatVector > &shapeFunctions: The shapefunctions at the points
+         * :param const unsigned int cellID: The macro cell ID number
+         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal location vector
+         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity vector
+         * :param std::unique_ptr< elib::Element > &element: The element representation of the macro domain
          */
 
-        //Build the element representing the macro-scale domain
-        std::unique_ptr< elib::Element > element;
-        errorOut error = overlapCoupling::buildMacroDomainElement( cellID, nodeReferenceLocations, nodeDisplacements,
-                                                                   connectivity, element );
-
-        if ( error ){
+        //Get the XDMF cell type
+        auto connectivityCellIndices = connectivity.find( cellID );
+        if ( connectivityCellIndices == connectivity.end( ) ){
 
-            errorOut result = new errorNode( __func__, "Error in element formulation" );
-            result->addNext( error );
-            return result;
+            return new errorNode( __func__,
+                                  "Cell ID " + std::to_string( cellID ) + " was not found in the connectivity map" );
 
         }
+        unsigned int cellType = connectivityCellIndices->second[ 0 ];
 
-        macroNodes = element->global_node_ids;
-
-        //Make sure the number of points and the size of the output are consistent
-        unsigned nPoints = points.size( );
-
-        shapeFunctions.clear();
-        shapeFunctions.reserve( nPoints );
-
-        //Compute the shape functions at each point
-        floatVector point;
-        floatVector localPosition, pointShapeFunctions;
-
-        //Loop over the output vector
-        for ( auto p = points.begin( ); p != points.end( ); p++ ){
+        //Get the element name
+        auto it = elib::XDMFTypeToElementName.find( cellType );
 
-            error = element->compute_local_coordinates( p->second, localPosition );
+        if ( it == elib::XDMFTypeToElementName.end( ) ){
 
-            if ( !element->local_point_inside( localPosition ) ){
+            return new errorNode( __func__,
+                                  "The cell type " + std::to_string(cellType) + " is not supported" );
 
-                pointShapeFunctions = { 0 };
-                shapeFunctions.emplace( p->first, pointShapeFunctions );
-                continue;
+        }
+        
+        //Get the nodes from the file
+        elib::vecOfvec nodes( connectivityCellIndices->second.size( ) - 1, elib::vec( _dim, 0 ) );
+        uIntVector globalNodeIds( connectivityCellIndices->second.begin( ) + 1,
+                                  connectivityCellIndices->second.end( ) );
+        for ( auto nodeId = globalNodeIds.begin( ); nodeId != globalNodeIds.end( ); nodeId++ ){
 
-            }
+            auto nodeLocation = nodeLocations.find( *nodeId );
 
-            if ( error ) {
+            if ( nodeLocation == nodeLocations.end( ) ){
 
-                return new errorNode( __func__,
-                                      "Error in computing the local coordinates for point " + std::to_string( p->first ) );
+                return new errorNode( __func__, "Node " + std::to_string( *nodeId ) + " was not found in the node locations map" );
 
             }
 
-            error = element->get_shape_functions( localPosition, pointShapeFunctions );
-
-            if ( error ) {
+            uIntType index = nodeId - globalNodeIds.begin( );
 
-                return new errorNode( __func__,
-                                      "Error in the computation of the shape functions for point " + std::to_string( p->first ) );
+            nodes[ index ] = nodeLocation->second;
 
-            }
+        }
+        
+        //Get the element
+        auto qrule = elib::default_qrules.find( it->second );
+        if ( qrule == elib::default_qrules.end( ) ){
 
-            shapeFunctions.emplace( p->first, pointShapeFunctions );
+            return new errorNode( __func__,
+                                  "The element type " + it->second + " is not found in the default quadrature rules map" );
 
         }
 
+        element = elib::build_element_from_string( it->second, globalNodeIds, nodes, qrule->second );
+
         return NULL;
-            
     }
 
-    errorOut overlapCoupling::computeShapeFunctionGradientsAtPoints( const unsigned int cellID,
+    errorOut overlapCoupling::buildMacroDomainElement( const unsigned int cellID,
                                                        const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
                                                        const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
                                                        const std::unordered_map< uIntType, uIntVector > &connectivity,
-                                                       const std::unordered_map< uIntType, floatVector > points,
-                                                       uIntVector &macroNodes,
-                                                       std::unordered_map< uIntType, floatVector > &shapeFunctionGradients ){
+                                                       std::unique_ptr< elib::Element > &element ){
         /*!
-         * Compute the shape functions of a given macro-scale domain at the given points
+         * Construct a finite element representation of the macro domain
          *
-         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
+         * :param const unsigned int cellID: The macro cell ID number
          * :param const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations: The nodal reference location vector
-         * :param const std::unordered_map< uIntType, floatVector > &nodeDisplacements: The nodal reference location vector
+         * :param const std::unordered_map< uIntType, floatVector > &nodeDisplacements: The nodal displacement vector
          * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity vector
-         * :param const std::unordered_map< uIntType, floatVector > &points: The points at which to compute the shape functions
-         * :param uIntVector &macroNodes: The macro node ids
-         * :param std::unordered_map< uIntType, floatVector > &shapeFunctionGradients: The gradients of the shapefunctions
-         *     at the points. The output vector is organized [ N11_x, N11_y, N11_z, N12_x, ... ] where the first index is the
-         *     point number, the second index is the node number, and the _ indicates a gradient w.r.t. the
-         *     third index.
+         * :param std::unique_ptr< elib::Element > &element: The element representation of the macro domain
          */
 
-        //Build the element representing the macro-scale domain
-        std::unique_ptr< elib::Element > element;
-        errorOut error = overlapCoupling::buildMacroDomainElement( cellID, nodeReferenceLocations, nodeDisplacements,
-                                                                   connectivity, element );
+        //Make sure the cellID is allowable
+        auto connectivityCellIndices = connectivity.find( cellID );
 
-        if ( error ){
+        if ( connectivityCellIndices == connectivity.end( ) ){
 
-            errorOut result = new errorNode( __func__, "Error in element formulation" );
-            result->addNext( error );
-            return result;
+            return new errorNode( __func__, 
+                                  "Cell " + std::to_string( cellID ) + " was not found in the connectivity map" );
 
         }
 
-        macroNodes = element->global_node_ids;
+        //Get the XDMF cell type
+        unsigned int cellType = connectivityCellIndices->second[ 0 ];
 
-        //Make sure the number of points and the size of the output are consistent
-        unsigned nPoints = points.size( ) / _dim;
-        if ( ( points.size( ) % _dim ) > 0 ){
+        //Get the element name
+        auto it = elib::XDMFTypeToElementName.find( cellType );
+
+        if ( it == elib::XDMFTypeToElementName.end( ) ){
 
             return new errorNode( __func__,
-                                  "The points vector is inconsistent with the dimension\n"
-                                  "    points.size( ): " + std::to_string( points.size( ) ) + "\n" +
-                                  "    nPoints: " + std::to_string( nPoints ) );
+                                  "The cell type " + std::to_string(cellType) + " is not supported" );
 
         }
 
-        shapeFunctionGradients.clear();
-        shapeFunctionGradients.reserve( element->reference_nodes.size( ) );
-
-        //Compute the shape functions at each point
-        floatVector point;
-        floatMatrix dNdx;
-        floatVector localPosition, pointShapeFunctionGradientsVec;
-
-        //Loop over the output vector
-        for ( auto p = points.begin( ); p != points.end( ); p++ ){
-
-            error = element->compute_local_coordinates( p->second, localPosition );
-
-            if ( !element->local_point_inside( localPosition ) ){
+        //Get the nodes from the file
+        elib::vecOfvec referenceNodes( connectivityCellIndices->second.size( ) - 1, elib::vec( _dim, 0 ) );
+        elib::vecOfvec displacements( connectivityCellIndices->second.size( ) - 1, elib::vec( _dim, 0 ) );
+        uIntVector globalNodeIds( connectivityCellIndices->second.begin( ) + 1,
+                                  connectivityCellIndices->second.end( ) );
+        for ( auto nodeId = globalNodeIds.begin( ); nodeId != globalNodeIds.end( ); nodeId++ ){
 
-                pointShapeFunctionGradientsVec = { 0 };
-                shapeFunctionGradients.emplace( p->first, pointShapeFunctionGradientsVec );
-                continue;
+            uIntType index = nodeId - globalNodeIds.begin( );
 
-            }
+            auto nodeReferenceLocation = nodeReferenceLocations.find( *nodeId );
 
-            if ( error ) {
+            if ( nodeReferenceLocation == nodeReferenceLocations.end( ) ){
 
                 return new errorNode( __func__,
-                                      "Error in computing the local coordinates for point " + std::to_string( p->first ) );
+                                      "The node " + std::to_string( *nodeId ) + " was not found in the node reference location map" );
 
             }
 
-            error = element->get_global_shapefunction_gradients( localPosition, dNdx );
+            auto nodeDisplacement = nodeDisplacements.find( *nodeId );
 
-            if ( error ) {
+            if ( nodeDisplacement == nodeDisplacements.end( ) ){
 
                 return new errorNode( __func__,
-                                      "Error in the computation of the shape functions for point " + std::to_string( p->first ) );
+                                      "The node " + std::to_string( *nodeId ) + " was not found in the node displacement map" );
 
             }
 
-            pointShapeFunctionGradientsVec = vectorTools::appendVectors( dNdx );
-            shapeFunctionGradients.emplace( p->first, pointShapeFunctionGradientsVec );
+            referenceNodes[ index ] = nodeReferenceLocation->second;
+            displacements[ index ]  = nodeDisplacement->second;
+
+        }
+        
+        //Get the element
+        auto qrule = elib::default_qrules.find( it->second );
+        if ( qrule == elib::default_qrules.end( ) ){
+
+            return new errorNode( __func__,
+                                  "The element type " + it->second + " is not found in the default quadrature rules map" );
 
         }
 
+        element = elib::build_element_from_string( it->second, globalNodeIds, referenceNodes, qrule->second );
+        element->update_node_positions( displacements );
+
         return NULL;
-            
+
     }
 
-    errorOut overlapCoupling::computeShapeFunctionsAtReferenceCentersOfMass( ){
+    bool cachedMacroElementMatchesConnectivity( const std::unique_ptr< elib::Element > &element, const uIntVector &cellConnectivity ){
         /*!
-         * Compute the shape functions at the reference centers of mass
+         * Determine if a cached macro element was built from the provided cell connectivity
+         *
+         * :param const std::unique_ptr< elib::Element > &element: The cached element
+         * :param const uIntVector &cellConnectivity: The connectivity of the cell i.e. the XDMF cell type followed by the node ids
          */
 
-        //Loop over the free domains
-        stringVector domainNames;
-        std::unordered_map< uIntType, floatVector > domainCOMs;
+        if ( ( !element ) || ( element->global_node_ids.size( ) + 1 != cellConnectivity.size( ) ) ){
 
-        std::unordered_map< uIntType, floatVector > macroDomainShapeFunctions;
-        errorOut error = NULL;
+            return false;
 
-        const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
+        }
 
-        _referenceGhostMicroDomainCenterOfMassShapeFunctions.clear( );
+        auto elementName = elib::XDMFTypeToElementName.find( cellConnectivity[ 0 ] );
 
-        for ( auto cellID = freeMacroCellIds->begin( ); cellID != freeMacroCellIds->end( ); cellID++ ){
+        if ( ( elementName == elib::XDMFTypeToElementName.end( ) ) || ( elementName->second != element->name ) ){
 
-            //Get the centers of mass of the macro-domain
-            domainCOMs.clear( );
-            auto cellCentersOfMass = _referenceGhostMicroDomainCentersOfMass.find( *cellID );
+            return false;
 
-            if ( cellCentersOfMass == _referenceGhostMicroDomainCentersOfMass.end( ) ){
+        }
 
-                return new errorNode( __func__,
-                                      "The macro cell " + std::to_string( *cellID ) +
-                                      " was not found in the reference ghost micro domain centers of mass" );
+        return std::equal( element->global_node_ids.begin( ), element->global_node_ids.end( ), cellConnectivity.begin( ) + 1 );
 
-            }
+    }
 
-            stringVector domainNames( cellCentersOfMass->second.size( ) );
-            domainCOMs.clear( );
+    errorOut overlapCoupling::getMacroDomainElement( const unsigned int cellID,
+                                                     const std::unordered_map< uIntType, floatVector > &nodeLocations,
+                                                     const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                                     elib::Element *&element ){
+        /*!
+         * Get the finite element representation of the macro domain. The element is owned by overlapCoupling
+         * and is only re-built when the connectivity or the nodal locations of the cell change so it must
+         * not be modified by the caller.
+         *
+         * :param const unsigned int cellID: The macro cell ID number
+         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal location vector
+         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity vector
+         * :param elib::Element *&element: The element representation of the macro domain
+         */
 
-            uIntType dindex = 0;
-            for ( auto domain = cellCentersOfMass->second.begin( ); domain != cellCentersOfMass->second.end( ); domain++, dindex++ ){
+        auto connectivityCellIndices = connectivity.find( cellID );
+        if ( connectivityCellIndices == connectivity.end( ) ){
 
-                domainNames[ dindex ] = domain->first;
-                domainCOMs.emplace( dindex, domain->second );
+            return new errorNode( __func__,
+                                  "Cell ID " + std::to_string( cellID ) + " was not found in the connectivity map" );
 
-            }
+        }
 
-            uIntVector macroNodes;
-            error = computeShapeFunctionsAtPoints( *cellID,
-                                                   *_inputProcessor.getMacroNodeReferencePositions( ),
-                                                   *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                                   domainCOMs, macroNodes, macroDomainShapeFunctions );
+        auto cached = _macroReferenceElementCache.find( cellID );
 
-            if ( error ){
+        if ( ( cached != _macroReferenceElementCache.end( ) ) &&
+             cachedMacroElementMatchesConnectivity( cached->second, connectivityCellIndices->second ) ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in computation of the shape functions at the reference ghost micro centers of mass" );
-                result->addNext( error );
-                return result;
+            bool isCurrent = true;
 
-            }
+            for ( uIntType n = 0; n < cached->second->global_node_ids.size( ); n++ ){
 
-            //Append the shape functions to the storage vector
-            domainFloatVectorMap temp;
-            temp.reserve( macroDomainShapeFunctions.size( ) );
-            for ( auto domainName = domainNames.begin( ); domainName != domainNames.end( ); domainName++ ){
+                auto nodeLocation = nodeLocations.find( cached->second->global_node_ids[ n ] );
 
-                uIntType index = domainName - domainNames.begin( );
+                if ( ( nodeLocation == nodeLocations.end( ) ) ||
+                     ( cached->second->reference_nodes[ n ] != nodeLocation->second ) ||
+                     ( cached->second->nodes[ n ] != nodeLocation->second ) ){
 
-                temp.emplace( *domainName, macroDomainShapeFunctions[ index ] ); 
+                    isCurrent = false;
+                    break;
+
+                }
 
             }
 
-            _referenceGhostMicroDomainCenterOfMassShapeFunctions.emplace( *cellID, temp );
+            if ( isCurrent ){
+
+                element = cached->second.get( );
+                return NULL;
+
+            }
 
         }
 
-        //Loop over the ghost domains
+        std::unique_ptr< elib::Element > newElement;
+        errorOut error = buildMacroDomainElement( cellID, nodeLocations, connectivity, newElement );
 
-        const uIntVector *ghostMacroCellIds = _inputProcessor.getGhostMacroCellIds( );
+        if ( error ){
 
-        _referenceFreeMicroDomainCenterOfMassShapeFunctions.clear( );
+            errorOut result = new errorNode( __func__, "Error in the construction of the macro element" );
+            result->addNext( error );
+            return result;
 
-        for ( auto cellID = ghostMacroCellIds->begin( ); cellID != ghostMacroCellIds->end( ); cellID++ ){
+        }
 
-            //Get the centers of mass of the macro-domain
-            auto cellCentersOfMass = _referenceFreeMicroDomainCentersOfMass.find( *cellID );
+        element = newElement.get( );
+        _macroReferenceElementCache[ cellID ] = std::move( newElement );
 
-            if ( cellCentersOfMass == _referenceFreeMicroDomainCentersOfMass.end( ) ){
+        return NULL;
 
-                return new errorNode( __func__,
-                                      "The macro cell " + std::to_string( *cellID ) +
-                                      " was not found in the reference free micro domain centers of mass" );
+    }
 
-            }
+    errorOut overlapCoupling::getMacroDomainElement( const unsigned int cellID,
+                                                     const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
+                                                     const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
+                                                     const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                                     elib::Element *&element ){
+        /*!
+         * Get the finite element representation of the macro domain in the current configuration. The element
+         * is owned by overlapCoupling and must not be modified by the caller. It is re-built when the connectivity
+         * or the reference locations of the cell change and its nodes are moved in place when the displacements
+         * change.
+         *
+         * :param const unsigned int cellID: The macro cell ID number
+         * :param const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations: The nodal reference location vector
+         * :param const std::unordered_map< uIntType, floatVector > &nodeDisplacements: The nodal displacement vector
+         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity vector
+         * :param elib::Element *&element: The element representation of the macro domain
+         */
 
-            stringVector domainNames( cellCentersOfMass->second.size( ) );
-            domainCOMs.clear( );
+        auto connectivityCellIndices = connectivity.find( cellID );
 
-            uIntType dindex = 0;
-            for ( auto domain = cellCentersOfMass->second.begin( ); domain != cellCentersOfMass->second.end( ); domain++, dindex++ ){
+        if ( connectivityCellIndices == connectivity.end( ) ){
 
-                domainNames[ dindex ] = domain->first;
-                domainCOMs.emplace( dindex, domain->second );
+            return new errorNode( __func__, 
+                                  "Cell " + std::to_string( cellID ) + " was not found in the connectivity map" );
 
-            }
+        }
 
-            uIntVector macroNodes;
-            error = computeShapeFunctionsAtPoints( *cellID,
-                                                   *_inputProcessor.getMacroNodeReferencePositions( ),
-                                                   *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                                   domainCOMs, macroNodes, macroDomainShapeFunctions );
+        auto cached = _macroElementCache.find( cellID );
 
-            if ( error ){
+        if ( ( cached != _macroElementCache.end( ) ) &&
+             cachedMacroElementMatchesConnectivity( cached->second, connectivityCellIndices->second ) ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in computation of the shape functions at the reference free micro centers of mass" );
-                result->addNext( error );
-                return result;
+            std::unique_ptr< elib::Element > &cachedElement = cached->second;
+
+            bool isValid = true;
+            bool hasMoved = false;
+
+            for ( uIntType n = 0; n < cachedElement->global_node_ids.size( ); n++ ){
+
+                auto nodeReferenceLocation = nodeReferenceLocations.find( cachedElement->global_node_ids[ n ] );
+                auto nodeDisplacement = nodeDisplacements.find( cachedElement->global_node_ids[ n ] );
+
+                if ( ( nodeReferenceLocation == nodeReferenceLocations.end( ) ) ||
+                     ( nodeDisplacement == nodeDisplacements.end( ) ) ||
+                     ( nodeDisplacement->second.size( ) != _dim ) ||
+                     ( cachedElement->reference_nodes[ n ] != nodeReferenceLocation->second ) ){
+
+                    isValid = false;
+                    break;
+
+                }
+
+                for ( unsigned int i = 0; i < _dim; i++ ){
+
+                    if ( cachedElement->nodes[ n ][ i ] != cachedElement->reference_nodes[ n ][ i ] + nodeDisplacement->second[ i ] ){
+
+                        hasMoved = true;
+
+                    }
+
+                }
 
             }
 
-            //Append the shape functions to the storage vector
-            domainFloatVectorMap temp;
-            temp.reserve( macroDomainShapeFunctions.size( ) );
-            for ( auto domainName = domainNames.begin( ); domainName != domainNames.end( ); domainName++ ){
+            if ( isValid ){
 
-                uIntType index = domainName - domainNames.begin( );
+                if ( hasMoved ){
 
-                temp.emplace( *domainName, macroDomainShapeFunctions[ index ] ); 
+                    for ( uIntType n = 0; n < cachedElement->global_node_ids.size( ); n++ ){
+
+                        cachedElement->update_node_position( n, nodeDisplacements.find( cachedElement->global_node_ids[ n ] )->second, false );
+
+                    }
+
+                    cachedElement->update_bounding_box( );
+
+                }
+
+                element = cachedElement.get( );
+                return NULL;
 
             }
 
-            _referenceFreeMicroDomainCenterOfMassShapeFunctions.emplace( *cellID, temp );
+        }
+
+        std::unique_ptr< elib::Element > newElement;
+        errorOut error = buildMacroDomainElement( cellID, nodeReferenceLocations, nodeDisplacements, connectivity, newElement );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__, "Error in the construction of the macro element" );
+            result->addNext( error );
+            return result;
 
         }
 
+        element = newElement.get( );
+        _macroElementCache[ cellID ] = std::move( newElement );
+
         return NULL;
-        
+
     }
 
-    errorOut overlapCoupling::addDomainContributionToInterpolationMatrix( const uIntVector  &domainNodes,
-                                                                          const uIntVector  &macroNodes,
-                                                                          const std::unordered_map< uIntType, floatVector > &domainReferenceXis,
-                                                                          const floatVector &domainCenterOfMassShapeFunctionValues ){
+    errorOut overlapCoupling::computeShapeFunctionsAtPoint( const unsigned int cellID,
+                                                            const std::unordered_map< uIntType, floatVector > &nodeLocations,
+                                                            const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                                            const floatVector &point, uIntVector &macroNodes,
+                                                            floatVector &shapeFunctions ){
         /*!
-         * Add the contribution of a domain to the interpolation matrices
+         * Compute the shape functions of a given macro-scale domain at a single point
          *
-         * :param const std::string &domainName: The name of the domain
-         * :param const std::unordered_map< uIntType, floatVector > &domainReferenceXis: The micro-position vectors of 
-         *     the nodes within the domain
-         * :param const floatVector &domainCenterOfMassShapeFunctionValues: The shape function values at the centers of 
-         *     mass of the micro-domains.
+         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
+         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal location map
+         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity map
+         * :param const floatVector &point: The point at which to compute the shape functions
+         * :param uIntVector &macroNodes: The macro node ids
+         * :param floatVector &shapeFunctions: The shapefunctions at the point
          */
 
-        //Initialize the sparse matrix
-        SparseMatrix domainN;
+        if ( point.size( ) != _dim ){
 
-        //Extract the DOF maps
-        const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
-        const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+            return new errorNode( __func__,
+                                  "This function only works for a single point of dimension " + std::to_string( _dim ) );
 
-        //Form the interpolation matrix contributions from the current domain
-        errorOut error = DOFProjection::formMacroDomainToMicroInterpolationMatrix( _dim,
-                                                                                   microGlobalToLocalDOFMap->size( ),
-                                                                                   macroGlobalToLocalDOFMap->size( ),
-                                                                                   domainNodes, macroNodes, domainReferenceXis,
-                                                                                   domainCenterOfMassShapeFunctionValues,
-                                                                                   *_inputProcessor.getMicroWeights( ),
-                                                                                   domainN,
-                                                                                   microGlobalToLocalDOFMap,
-                                                                                   macroGlobalToLocalDOFMap );
+        }
+
+        std::unordered_map< uIntType, floatVector > pointMap;
+        pointMap.emplace( 0, point );
+
+        std::unordered_map< uIntType, floatVector > shapefunctionMap;
+
+        errorOut error = computeShapeFunctionsAtPoints( cellID, nodeLocations, connectivity, pointMap, macroNodes, shapefunctionMap );
 
         if ( error ){
 
             errorOut result = new errorNode( __func__,
-                                             "Error in computation of the contribution of the domain to the interpolation matrix" );
+                                             "Error when computing shape functions" );
             result->addNext( error );
             return result;
 
         }
 
-        //Add the contribution to the total shapefunction matrix
-        if ( _N.nonZeros( ) > 0 ){
-            _N += domainN;
-        }
-        else{
-            _N = domainN;
-        }
+        shapeFunctions = shapefunctionMap[ 0 ];
 
         return NULL;
 
     }
 
-    errorOut overlapCoupling::projectDegreesOfFreedom( const bool useUpdatedFreeDOF ){
+    errorOut overlapCoupling::computeShapeFunctionsAtPoint( const unsigned int cellID,
+                                                            const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
+                                                            const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
+                                                            const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                                            const floatVector &point, uIntVector &macroNodes,
+                                                            floatVector &shapeFunctions ){
         /*!
-         * Project the degrees of freedom of the ghost nodes
-         * for the current increment
+         * Compute the shape functions of a given macro-scale domain at a single point
          *
-         * :const bool useUpdatedFreeDOF: A flag indicating if the free displacements vectors to be
-         *     used should be the updated values or the values from the input file
+         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
+         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal location map
+         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal displacement map
+         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity map
+         * :param const floatVector &point: The point at which to compute the shape functions
+         * :param uIntVector &macroNodes: The macro node ids
+         * :param floatVector &shapeFunctions: The shapefunctions at the point
          */
 
-        //Get the displacement vectors
-        const std::unordered_map< uIntType, floatVector > *macroDispDOFVector = _inputProcessor.getMacroDispDOFVector( );
-        const std::unordered_map< uIntType, floatVector > *microDisplacements = _inputProcessor.getMicroDisplacements( );
+        if ( point.size( ) != _dim ){
 
-        //Get the free and ghost node ids
-        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
-        const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
+            return new errorNode( __func__,
+                                  "This function only works for a single point of dimension " + std::to_string( _dim ) );
 
-        const uIntVector *freeMicroNodeIds = _inputProcessor.getFreeMicroNodeIds( );
-        const uIntVector *ghostMicroNodeIds = _inputProcessor.getGhostMicroNodeIds( );
+        }
 
-        //Set the number of displacement degrees of freedom
-        unsigned int nMacroDispDOF = _dim + _dim * _dim;
-        unsigned int nMicroDispDOF = _dim;
+        std::unordered_map< uIntType, floatVector > pointMap;
+        pointMap.emplace( 0, point );
 
-        //Assemble the free displacements
-        floatVector *freeMacroDisplacements;
-        floatVector *freeMicroDisplacements;
+        std::unordered_map< uIntType, floatVector > shapefunctionMap;
 
-        floatVector store1, store2;
+        errorOut error = computeShapeFunctionsAtPoints( cellID, nodeReferenceLocations, nodeDisplacements, 
+                                                        connectivity, pointMap, macroNodes, shapefunctionMap );
 
-        if ( useUpdatedFreeDOF ){
+        if ( error ){
 
-            freeMicroDisplacements = &_updatedFreeMicroDispDOFValues;
-            freeMacroDisplacements = &_updatedFreeMacroDispDOFValues;
+            errorOut result = new errorNode( __func__,
+                                             "Error when computing shape functions" );
+            result->addNext( error );
+            return result;
 
         }
-        else{
 
-            store1.resize( nMacroDispDOF * freeMacroNodeIds->size( ) );
-            store2.resize( nMicroDispDOF * freeMicroNodeIds->size( ) );
+        shapeFunctions = shapefunctionMap[ 0 ];
 
-            freeMacroDisplacements = &store1;
-            freeMicroDisplacements = &store2;
+        return NULL;
 
-            const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
-            const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
-   
-            for ( auto it = freeMacroNodeIds->begin( ); it != freeMacroNodeIds->end( ); it++ ){
-
-                auto macroDispDOF = macroDispDOFVector->find( *it );
+    }
 
-                if ( macroDispDOF == macroDispDOFVector->end( ) ){
+    errorOut overlapCoupling::computeShapeFunctionsAtPoints( const unsigned int cellID,
+                                                             const std::unordered_map< uIntType, floatVector > &nodeLocations,
+                                                             const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                                             const std::unordered_map< uIntType, floatVector > &points,
+                                                             uIntVector &macroNodes,
+                                                             std::unordered_map< uIntType, floatVector > &shapeFunctions ){
+        /*!
+         * Compute the shape functions of a given macro-scale domain at the given points
+         *
+         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
+         * :param const std::unordered_map< uIntType, floatVector > &nodeLocations: The nodal location map
+         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity map
+         * :param const std::unordered_map< uIntType, floatVector > &points: The points at which to compute the shape functions
+         * :param uIntVector &macroNodes: The macro node ids
+         * :param std::unordered_map< uIntType, floatVector > &shapeFunctions: The shapefunctions at the points
+         */
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( *it ) +
-                                          " was not found in the macro displacement dof vector map" );
+        //Get the element representing the macro-scale domain
+        elib::Element *element;
+        errorOut error = overlapCoupling::getMacroDomainElement( cellID, nodeLocations,
+                                                                 connectivity, element );
 
-                }
+        if ( error ){
 
-                if ( macroDispDOF->second.size( ) != nMacroDispDOF ){
+            errorOut result = new errorNode( __func__, "Error in element formulation" );
+            result->addNext( error );
+            return result;
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( *it ) +
-                                          " does not have a dimensionally consistent number of degrees of freedom" );
+        }
 
-                }
+        macroNodes = element->global_node_ids;
 
-                auto map = macroGlobalToLocalDOFMap->find( *it );
+        error = computeElementShapeFunctionsAtPoints( element, points, shapeFunctions );
 
-                if ( map == macroGlobalToLocalDOFMap->end( ) ){
+        if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( *it ) +
-                                          " was not found in the macro global-to-local node map" );
+            errorOut result = new errorNode( __func__, "Error in the computation of the shape functions at the points" );
+            result->addNext( error );
+            return result;
 
-                }
-    
-                //Set the macro displacements
-                for ( unsigned int i = 0; i < nMacroDispDOF; i++ ){
-    
-                    ( *freeMacroDisplacements )[ nMacroDispDOF * ( map->second ) + i ] = macroDispDOF->second[ i ];
-    
-                }
-    
-            }
-    
-            for ( auto it = freeMicroNodeIds->begin( ); it != freeMicroNodeIds->end( ); it++ ){
-   
-                auto microDispDOF = microDisplacements->find( *it );
+        }
 
-                if ( microDispDOF == microDisplacements->end(  ) ){
+        return NULL;
+    }
 
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *it ) +
-                                          " was not found in the micro displacement dof vector map" );
+    errorOut overlapCoupling::computeShapeFunctionsAtPoints( const unsigned int cellID,
+                                                             const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
+                                                             const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
+                                                             const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                                             const std::unordered_map< uIntType, floatVector > &points,
+                                                             uIntVector &macroNodes,
+                                                             std::unordered_map< uIntType, floatVector > &shapeFunctions ){
+        /*!
+         * Compute the shape functions of a given macro-scale domain at the given points
+         *
+         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
+         * :param const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations: The nodal reference location map
+         * :param const std::unordered_map< uIntType, floatVector > &nodeDisplacements: The nodal displacement map
+         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity map
+         * :param const std::unordered_map< uIntType, floatVector > &points: The points at which to compute the shape functions
+         * :param uIntVector &macroNodes: The macro node ids
+         * :param std::unordered_map< uIntType, floatVector > &shapeFunctions: The shapefunctions at the points
+         */
 
-                }
+        //Get the element representing the macro-scale domain
+        elib::Element *element;
+        errorOut error = overlapCoupling::getMacroDomainElement( cellID, nodeReferenceLocations, nodeDisplacements,
+                                                                 connectivity, element );
 
-                if ( microDispDOF->second.size( ) != nMicroDispDOF ){
+        if ( error ){
 
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *it ) +
-                                          " does not have a dimensionally consistent number of degrees of freedom" );
+            errorOut result = new errorNode( __func__, "Error in element formulation" );
+            result->addNext( error );
+            return result;
 
-                }
+        }
 
-                auto map = microGlobalToLocalDOFMap->find( *it );
+        macroNodes = element->global_node_ids;
 
-                if ( map == microGlobalToLocalDOFMap->end( ) ){
+        error = computeElementShapeFunctionsAtPoints( element, points, shapeFunctions );
 
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *it ) +
-                                          " was not found in the micro global-to-local node map" );
+        if ( error ){
 
-                }
-    
-                //Set the micro displacements
-                for ( unsigned int i = 0; i < nMicroDispDOF; i++ ){
-    
-                    ( *freeMicroDisplacements )[ nMicroDispDOF * ( map->second ) + i ] = microDispDOF->second[ i ];
-    
-                }
-    
-            }
+            errorOut result = new errorNode( __func__, "Error in the computation of the shape functions at the points" );
+            result->addNext( error );
+            return result;
 
         }
 
-        //Map the macro and micro free displacements to Eigen matrices
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > Q( freeMicroDisplacements->data(), freeMicroDisplacements->size( ), 1 );
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > D( freeMacroDisplacements->data(), freeMacroDisplacements->size( ), 1 );
+        return NULL;
+            
+    }
 
-        //Map the output vectors to Eigen matrices
-        _projected_ghost_macro_displacement.clear( );
-        _projected_ghost_macro_displacement.resize( nMacroDispDOF * ghostMacroNodeIds->size( ) );
+    errorOut overlapCoupling::computeElementShapeFunctionsAtPoints( elib::Element *element,
+                                                                    const std::unordered_map< uIntType, floatVector > &points,
+                                                                    std::unordered_map< uIntType, floatVector > &shapeFunctions ){
+        /*!
+         * Compute the shape functions of an element at the given points. The points are located in the
+         * element in a single batched call. Points outside of the element have a shape function vector of { 0 }.
+         * An error is returned if a point cannot be located and the last iterate of its local coordinates is
+         * inside of the element.
+         *
+         * :param elib::Element *element: The element
+         * :param const std::unordered_map< uIntType, floatVector > &points: The points at which to compute the shape functions
+         * :param std::unordered_map< uIntType, floatVector > &shapeFunctions: The shapefunctions at the points
+         */
 
-        _projected_ghost_micro_displacement.clear( );
-        _projected_ghost_micro_displacement.resize( nMicroDispDOF * ghostMicroNodeIds->size( ) );
+        uIntType nPoints = points.size( );
+        uIntType nNodes = element->nodes.size( );
 
-        Eigen::Map< Eigen::Matrix< floatType, -1,  1 > > Qhat( _projected_ghost_micro_displacement.data(),
-                                                               _projected_ghost_micro_displacement.size( ), 1 );
+        shapeFunctions.clear( );
+        shapeFunctions.reserve( nPoints );
 
-        Eigen::Map< Eigen::Matrix< floatType, -1,  1 > > Dhat( _projected_ghost_macro_displacement.data(),
-                                                               _projected_ghost_macro_displacement.size( ), 1 );
+        //Collect the points into contiguous storage
+        uIntVector pointIDs;
+        pointIDs.reserve( nPoints );
 
-        YAML::Node config = _inputProcessor.getCouplingInitialization( );
+        floatVector globalPoints;
+        globalPoints.reserve( _dim * nPoints );
 
-        if ( ( config[ "projection_type" ].as< std::string >( ).compare( "l2_projection" ) == 0 ) ){
+        for ( auto p = points.begin( ); p != points.end( ); p++ ){
 
-            Dhat = _dense_BDhatQ * Q + _dense_BDhatD * D;
-            Qhat = _dense_BQhatQ * Q + _dense_BQhatD * D;
+            if ( p->second.size( ) != _dim ){
+
+                return new errorNode( __func__,
+                                      "Point " + std::to_string( p->first ) + " does not have a dimension of " + std::to_string( _dim ) );
+
+            }
+
+            pointIDs.push_back( p->first );
+            globalPoints.insert( globalPoints.end( ), p->second.begin( ), p->second.end( ) );
 
         }
-        else if ( ( config[ "projection_type" ].as< std::string >( ).compare( "direct_projection" ) == 0 ) ||
-                  ( config[ "projection_type" ].as< std::string >( ).compare( "averaged_l2_projection" ) == 0 ) ){
 
-            Dhat = _sparse_BDhatQ * Q + _sparse_BDhatD * D;
-            Qhat = _sparse_BQhatQ * Q + _sparse_BQhatD * D;
+        floatVector localPoints, pointShapeFunctions;
+        std::vector< bool > inside;
+
+        errorOut error = element->compute_local_coordinates_at_points( globalPoints, localPoints, inside, pointShapeFunctions );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__, "Error in computing the local coordinates of the points" );
+            result->addNext( error );
+            return result;
 
         }
-        else{
 
-            return new errorNode( __func__,
-                                  "'projection_type' '" + config[ "projection_type" ].as< std::string >( ) + "' is not recognized" );
+        for ( uIntType p = 0; p < nPoints; p++ ){
+
+            if ( inside[ p ] ){
+
+                shapeFunctions.emplace( pointIDs[ p ], floatVector( pointShapeFunctions.begin( ) + nNodes * p,
+                                                                    pointShapeFunctions.begin( ) + nNodes * ( p + 1 ) ) );
+
+            }
+            else{
+
+                shapeFunctions.emplace( pointIDs[ p ], floatVector( 1, 0 ) );
+
+            }
 
         }
 
@@ -4529,784 +4847,814 @@ namespace overlapCoupling{
 
     }
 
-    errorOut overlapCoupling::addDomainToDirectProjectionReferenceValues( const uIntVector &domainNodes,
-                                                                          const uIntVector &macroNodes,
-                                                                          const std::unordered_map< uIntType, floatVector > &domainReferenceXiVectors,
-                                                                          const std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues ){
+    errorOut overlapCoupling::computeShapeFunctionGradientsAtPoints( const unsigned int cellID,
+                                                       const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
+                                                       const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
+                                                       const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                                       const std::unordered_map< uIntType, floatVector > points,
+                                                       uIntVector &macroNodes,
+                                                       std::unordered_map< uIntType, floatVector > &shapeFunctionGradients ){
         /*!
-         * Add the current domain information to the direct projection reference values
+         * Compute the shape functions of a given macro-scale domain at the given points
          *
-         * :param const uIntVector &domainNodes: The nodes associated with the current domain
-         * :param const uIntVector &macroNodes: The macro nodes associated with the current domain
-         * :param const std::unordered_map< uIntType, floatVector > &domainReferenceXiVectors: The relative position
-         *     vectors of the domain
-         * :param const std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues: The shape function values at the micro
-         *     node positions.
+         * :param const unsigned int &cellID: The cell ID at which to compute the shape functions
+         * :param const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations: The nodal reference location vector
+         * :param const std::unordered_map< uIntType, floatVector > &nodeDisplacements: The nodal reference location vector
+         * :param const std::unordered_map< uIntType, uIntVector > &connectivity: The connectivity vector
+         * :param const std::unordered_map< uIntType, floatVector > &points: The points at which to compute the shape functions
+         * :param uIntVector &macroNodes: The macro node ids
+         * :param std::unordered_map< uIntType, floatVector > &shapeFunctionGradients: The gradients of the shapefunctions
+         *     at the points. The output vector is organized [ N11_x, N11_y, N11_z, N12_x, ... ] where the first index is the
+         *     point number, the second index is the node number, and the _ indicates a gradient w.r.t. the
+         *     third index.
          */
 
-        const std::unordered_map< uIntType, floatType > *microDensities = _inputProcessor.getMicroDensities( );
-        const std::unordered_map< uIntType, floatType > *microVolumes   = _inputProcessor.getMicroVolumes( );
-        const std::unordered_map< uIntType, floatType > *microWeights   = _inputProcessor.getMicroWeights( );
-
-        //Additional values
-        unsigned int n;
+        //Get the element representing the macro-scale domain
+        elib::Element *element;
+        errorOut error = overlapCoupling::getMacroDomainElement( cellID, nodeReferenceLocations, nodeDisplacements,
+                                                                 connectivity, element );
 
-        floatType microMass, weight, sf;
-        floatVector Xi;
+        if ( error ){
 
-        //Loop through the micro nodes
-        for ( auto microNode  = domainNodes.begin( );
-                   microNode != domainNodes.end( );
-                   microNode++ ){
+            errorOut result = new errorNode( __func__, "Error in element formulation" );
+            result->addNext( error );
+            return result;
 
-            auto microDensity = microDensities->find( *microNode );
+        }
 
-            if ( microDensity == microDensities->end( ) ){
+        macroNodes = element->global_node_ids;
 
-                return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *microNode ) + " was not found in the micro density map" );
+        //Make sure the number of points and the size of the output are consistent
+        unsigned nPoints = points.size( ) / _dim;
+        if ( ( points.size( ) % _dim ) > 0 ){
 
-            }
+            return new errorNode( __func__,
+                                  "The points vector is inconsistent with the dimension\n"
+                                  "    points.size( ): " + std::to_string( points.size( ) ) + "\n" +
+                                  "    nPoints: " + std::to_string( nPoints ) );
 
-            auto microVolume = microVolumes->find( *microNode );
+        }
 
-            if ( microVolume == microVolumes->end( ) ){
+        shapeFunctionGradients.clear();
+        shapeFunctionGradients.reserve( element->reference_nodes.size( ) );
 
-                return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *microNode ) + " was not found in the micro volume map" );
+        //Compute the shape functions at each point
+        floatVector point;
+        floatMatrix dNdx;
+        floatVector localPosition, pointShapeFunctionGradientsVec;
 
-            }
+        //Loop over the output vector
+        for ( auto p = points.begin( ); p != points.end( ); p++ ){
 
-            auto microWeight = microWeights->find( *microNode );
+            error = element->compute_local_coordinates( p->second, localPosition );
 
-            if ( microWeight == microWeights->end( ) ){
+            if ( !element->local_point_inside( localPosition ) ){
 
-                return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *microNode ) + " was not found in the micro weight map" );
+                pointShapeFunctionGradientsVec = { 0 };
+                shapeFunctionGradients.emplace( p->first, pointShapeFunctionGradientsVec );
+                continue;
 
             }
 
-            auto referenceXi = domainReferenceXiVectors.find( *microNode );
-
-            if ( referenceXi == domainReferenceXiVectors.end( ) ){
+            if ( error ) {
 
                 return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *microNode ) + " was not found in the reference Xi map" );
+                                      "Error in computing the local coordinates for point " + std::to_string( p->first ) );
 
             }
 
-            auto shapefunctions = domainMicroPositionShapeFunctionValues.find( *microNode );
+            error = element->get_global_shapefunction_gradients( localPosition, dNdx );
 
-            if ( shapefunctions == domainMicroPositionShapeFunctionValues.end( ) ){
+            if ( error ) {
 
                 return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *microNode ) + " was not found in the shape function values map" );
+                                      "Error in the computation of the shape functions for point " + std::to_string( p->first ) );
 
             }
 
-            //Compute the micro-mass
-            microMass = microDensity->second * microVolume->second;
-
-            //Extract the micro Xi vector
-            Xi = referenceXi->second;
+            pointShapeFunctionGradientsVec = vectorTools::appendVectors( dNdx );
+            shapeFunctionGradients.emplace( p->first, pointShapeFunctionGradientsVec );
 
-            //Extract the weighting value
-            weight = microWeight->second;
+        }
 
-            //Loop through the macro nodes
-            for ( auto macroNode  = macroNodes.begin( );
-                       macroNode != macroNodes.end( );
-                       macroNode++ ){
-
-                //Set the index
-                n = macroNode - macroNodes.begin( );
-
-                auto indx = _inputProcessor.getMacroGlobalToLocalDOFMap( )->find( *macroNode );
+        return NULL;
+            
+    }
 
-                if ( indx == _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( ) ){
+    errorOut overlapCoupling::computeShapeFunctionsAtReferenceCentersOfMass( ){
+        /*!
+         * Compute the shape functions at the reference centers of mass
+         */
 
-                    return new errorNode( __func__,
-                                          "Macro node '" + std::to_string( *macroNode ) + "' not found in global to local macro node map" );
+        //Loop over the free domains
+        stringVector domainNames;
+        std::unordered_map< uIntType, floatVector > domainCOMs;
 
-                }
+        std::unordered_map< uIntType, floatVector > macroDomainShapeFunctions;
+        errorOut error = NULL;
 
-                //Get the shape function
-                sf = shapefunctions->second[ n ];
+        const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
 
-                //Add the contribution to the nodal mass
-                if ( _macroNodeProjectedMass.find( *macroNode ) == _macroNodeProjectedMass.end( ) ){
+        _referenceGhostMicroDomainCenterOfMassShapeFunctions.clear( );
 
-                    _macroNodeProjectedMass.emplace( *macroNode, 0. );
-                    _macroNodeProjectedMassMomentOfInertia.emplace( *macroNode, floatVector( _dim * _dim, 0 ) );
-                    _macroNodeMassRelativePositionConstant.emplace( *macroNode, floatVector( _dim, 0 ) );
+        for ( auto cellID = freeMacroCellIds->begin( ); cellID != freeMacroCellIds->end( ); cellID++ ){
 
-                }
+            //Get the centers of mass of the macro-domain
+            domainCOMs.clear( );
+            auto cellCentersOfMass = _referenceGhostMicroDomainCentersOfMass.find( *cellID );
 
-                _macroNodeProjectedMass[ *macroNode ] += microMass * sf * weight;
-                _macroNodeMassRelativePositionConstant[ *macroNode ] += microMass * sf * weight * Xi;
+            if ( cellCentersOfMass == _referenceGhostMicroDomainCentersOfMass.end( ) ){
 
-                for ( unsigned int I = 0; I < _dim; I++ ){
+                return new errorNode( __func__,
+                                      "The macro cell " + std::to_string( *cellID ) +
+                                      " was not found in the reference ghost micro domain centers of mass" );
 
-                    for ( unsigned int J = 0; J < _dim; J++ ){
+            }
 
-                        _macroNodeProjectedMassMomentOfInertia[ *macroNode ][ _dim * I + J ] += microMass * sf * weight * Xi[ I ] * Xi[ J ];
+            stringVector domainNames( cellCentersOfMass->second.size( ) );
+            domainCOMs.clear( );
 
-                    }
+            uIntType dindex = 0;
+            for ( auto domain = cellCentersOfMass->second.begin( ); domain != cellCentersOfMass->second.end( ); domain++, dindex++ ){
 
-                }
+                domainNames[ dindex ] = domain->first;
+                domainCOMs.emplace( dindex, domain->second );
 
             }
 
-        }
-
-        return NULL;
-    }
-
-    errorOut overlapCoupling::addDomainContributionToDirectFreeMicroToGhostMacroProjector( const unsigned int &cellIndex,
-                                                                                           const unsigned int &cellID,
-                                                                                           const unsigned int &microIncrement,
-                                                                                           const std::string &domainName,
-                                                                                           uIntVector &macroNodes ){
-        /*!
-         * Compute the current domain's contribution to the direct free micro to ghost macro
-         * projection matrix
-         */
+            uIntVector macroNodes;
+            error = computeShapeFunctionsAtPoints( *cellID,
+                                                   *_inputProcessor.getMacroNodeReferencePositions( ),
+                                                   *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                                   domainCOMs, macroNodes, macroDomainShapeFunctions );
 
-        //Compute the shape functions at the micro-nodes for the domain
+            if ( error ){
 
-        //Get the domain node ids
-        uIntVector domainNodes;
-        errorOut error = _inputProcessor._microscale->getSubDomainNodes( microIncrement, domainName, domainNodes );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in computation of the shape functions at the reference ghost micro centers of mass" );
+                result->addNext( error );
+                return result;
 
-        if ( error ){
+            }
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in extracting the domain ( " + domainName + " ) nodes" );
-            result->addNext( error );
-            return result;
+            //Append the shape functions to the storage vector
+            domainFloatVectorMap temp;
+            temp.reserve( macroDomainShapeFunctions.size( ) );
+            for ( auto domainName = domainNames.begin( ); domainName != domainNames.end( ); domainName++ ){
 
-        }
+                uIntType index = domainName - domainNames.begin( );
 
-        //Get the micro-node positions and relative position vectors
-        std::unordered_map< uIntType, floatVector > microNodePositions;
- 
-        const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
-        const std::unordered_map< uIntType, floatVector > *microDisplacements      = _inputProcessor.getMicroDisplacements( );
-        std::unordered_map< uIntType, floatVector > domainReferenceXiVectors;
+                temp.emplace( *domainName, macroDomainShapeFunctions[ index ] ); 
 
-        auto cellDomainCentersOfMass = _referenceFreeMicroDomainCentersOfMass.find( cellID );
-        if ( cellDomainCentersOfMass == _referenceFreeMicroDomainCentersOfMass.end( ) ){
+            }
 
-            return new errorNode( __func__,
-                                  "Macro cell " + std::to_string( cellID ) + " not found in reference domain centers of mass map" );
+            _referenceGhostMicroDomainCenterOfMassShapeFunctions.emplace( *cellID, temp );
 
         }
 
-        auto domainCenterOfMass = cellDomainCentersOfMass->second.find( domainName );
+        //Loop over the ghost domains
 
-        if ( domainCenterOfMass == cellDomainCentersOfMass->second.end( ) ){
+        const uIntVector *ghostMacroCellIds = _inputProcessor.getGhostMacroCellIds( );
 
-            std::string outstr = "Micro domain ";
-            outstr += domainName;
-            outstr += " not found in the micro domain centers of mass";
-            return new errorNode( __func__, outstr );
+        _referenceFreeMicroDomainCenterOfMassShapeFunctions.clear( );
 
-        }
- 
-        for ( auto it = domainNodes.begin( ); it != domainNodes.end( ); it++ ){
+        for ( auto cellID = ghostMacroCellIds->begin( ); cellID != ghostMacroCellIds->end( ); cellID++ ){
 
-            auto microReferencePosition = microReferencePositions->find( *it );
+            //Get the centers of mass of the macro-domain
+            auto cellCentersOfMass = _referenceFreeMicroDomainCentersOfMass.find( *cellID );
 
-            if ( microReferencePosition == microReferencePositions->end( ) ){
+            if ( cellCentersOfMass == _referenceFreeMicroDomainCentersOfMass.end( ) ){
 
                 return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *it ) + " was not found in the micro reference position map" );
+                                      "The macro cell " + std::to_string( *cellID ) +
+                                      " was not found in the reference free micro domain centers of mass" );
 
             }
 
-            auto microDisplacement = microDisplacements->find( *it );
+            stringVector domainNames( cellCentersOfMass->second.size( ) );
+            domainCOMs.clear( );
 
-            if ( microDisplacement == microDisplacements->end( ) ){
+            uIntType dindex = 0;
+            for ( auto domain = cellCentersOfMass->second.begin( ); domain != cellCentersOfMass->second.end( ); domain++, dindex++ ){
 
-                return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *it ) + " was not found in the micro displacement map" );
+                domainNames[ dindex ] = domain->first;
+                domainCOMs.emplace( dindex, domain->second );
 
             }
 
-            microNodePositions.emplace( *it, microReferencePosition->second + microDisplacement->second );
+            uIntVector macroNodes;
+            error = computeShapeFunctionsAtPoints( *cellID,
+                                                   *_inputProcessor.getMacroNodeReferencePositions( ),
+                                                   *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                                   domainCOMs, macroNodes, macroDomainShapeFunctions );
 
-            domainReferenceXiVectors.emplace( *it, microNodePositions[ *it ] - domainCenterOfMass->second );
+            if ( error ){
 
-        }
- 
-        //Compute the shape function values at the micro positions
-        std::unordered_map< uIntType, floatVector > domainMicroPositionShapeFunctionValues;
-        error = computeShapeFunctionsAtPoints( cellID,
-                                               *_inputProcessor.getMacroNodeReferencePositions( ),
-                                               *_inputProcessor.getMacroDisplacements( ),
-                                               *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                               microNodePositions, macroNodes,
-                                               domainMicroPositionShapeFunctionValues );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in computation of the shape functions at the reference free micro centers of mass" );
+                result->addNext( error );
+                return result;
 
-        if ( error ){
- 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the computation of the shape functions at the center of mass for a micro domain" );
-            result->addNext( error );
-            return result;
- 
-        }
+            }
 
-        //Construct the contribution of the domain
-        
-        //Get the domain's mass properties
-        floatVector domainMacroNodeProjectedMass( macroNodes.size( ) );
-        floatVector domainMacroNodeProjectedMassMomentOfInertia( _dim * _dim * macroNodes.size( ) );
-        floatVector domainMacroNodeProjectedMassRelativePositionConstant( _dim * macroNodes.size( ) );
-        
-        auto microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
-        auto macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+            //Append the shape functions to the storage vector
+            domainFloatVectorMap temp;
+            temp.reserve( macroDomainShapeFunctions.size( ) );
+            for ( auto domainName = domainNames.begin( ); domainName != domainNames.end( ); domainName++ ){
 
-        //We also specify the global to local map for the projector.
-        //This is not the same as the existing global map for the macro nodes
-        //because we store the free nodes first, so we have to shift them by 
-        //the number of free macro-scale nodes
-        DOFMap projectorMacroGlobalToLocalDOFMap;
-        projectorMacroGlobalToLocalDOFMap.reserve( _inputProcessor.getGhostMacroNodeIds( )->size( ) );
+                uIntType index = domainName - domainNames.begin( );
 
-        for ( auto md  = macroNodes.begin( );
-                   md != macroNodes.end( );
-                   md++ ){
+                temp.emplace( *domainName, macroDomainShapeFunctions[ index ] ); 
 
-            auto indx = macroGlobalToLocalDOFMap->find( *md );
+            }
 
-            if ( indx == macroGlobalToLocalDOFMap->end( ) ){
+            _referenceFreeMicroDomainCenterOfMassShapeFunctions.emplace( *cellID, temp );
 
-                return new errorNode( __func__,
-                                      "'" + std::to_string( *md ) + "' not found in the DOF map" );
+        }
 
-            }
+        return NULL;
+        
+    }
 
-            projectorMacroGlobalToLocalDOFMap.emplace( indx->first, indx->second - _inputProcessor.getFreeMacroNodeIds( )->size( ) );
+    errorOut overlapCoupling::addDomainContributionToInterpolationMatrix( const uIntVector  &domainNodes,
+                                                                          const uIntVector  &macroNodes,
+                                                                          const std::unordered_map< uIntType, floatVector > &domainReferenceXis,
+                                                                          const floatVector &domainCenterOfMassShapeFunctionValues ){
+        /*!
+         * Add the contribution of a domain to the interpolation matrices
+         *
+         * :param const std::string &domainName: The name of the domain
+         * :param const std::unordered_map< uIntType, floatVector > &domainReferenceXis: The micro-position vectors of 
+         *     the nodes within the domain
+         * :param const floatVector &domainCenterOfMassShapeFunctionValues: The shape function values at the centers of 
+         *     mass of the micro-domains.
+         */
 
-        }
+        //Initialize the sparse matrix
+        SparseMatrix domainN;
 
-        //Construct the projector contribution for this domain
-        SparseMatrix domainProjector;
+        //Extract the DOF maps
+        const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
+        const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-        error = DOFProjection::formMicroDomainToMacroProjectionMatrix( _dim,
-                                                                       _inputProcessor.getFreeMicroNodeIds( )->size( ),
-                                                                       _inputProcessor.getGhostMacroNodeIds( )->size( ),
-                                                                       domainNodes, macroNodes,
-                                                                       *_inputProcessor.getMicroVolumes( ),
-                                                                       *_inputProcessor.getMicroDensities( ),
-                                                                       *_inputProcessor.getMicroWeights( ),
-                                                                       domainReferenceXiVectors,
-                                                                       domainMicroPositionShapeFunctionValues,
-                                                                       _macroNodeProjectedMass,
-                                                                       _macroNodeProjectedMassMomentOfInertia,
-                                                                       _macroNodeMassRelativePositionConstant,
-                                                                       domainProjector,
-                                                                       microGlobalToLocalDOFMap,
-                                                                       &projectorMacroGlobalToLocalDOFMap );
+        //Form the interpolation matrix contributions from the current domain
+        errorOut error = DOFProjection::formMacroDomainToMicroInterpolationMatrix( _dim,
+                                                                                   microGlobalToLocalDOFMap->size( ),
+                                                                                   macroGlobalToLocalDOFMap->size( ),
+                                                                                   domainNodes, macroNodes, domainReferenceXis,
+                                                                                   domainCenterOfMassShapeFunctionValues,
+                                                                                   *_inputProcessor.getMicroWeights( ),
+                                                                                   domainN,
+                                                                                   microGlobalToLocalDOFMap,
+                                                                                   macroGlobalToLocalDOFMap );
 
         if ( error ){
+
             errorOut result = new errorNode( __func__,
-                                             "Error in the computation of the domain's contribution to the micro to macro projection matrix" );
+                                             "Error in computation of the contribution of the domain to the interpolation matrix" );
             result->addNext( error );
             return result;
-        }
-
-        if ( _sparse_BQhatQ.nonZeros( ) == 0 ){
-
-            _sparse_BDhatQ = domainProjector;
 
         }
-        else{
-
-            _sparse_BDhatQ += domainProjector;
 
+        //Add the contribution to the total shapefunction matrix
+        if ( _N.nonZeros( ) > 0 ){
+            _N += domainN;
+        }
+        else{
+            _N = domainN;
         }
 
         return NULL;
 
     }
 
-    errorOut overlapCoupling::homogenizeMicroScale( const unsigned int &microIncrement ){
+    errorOut overlapCoupling::projectDegreesOfFreedom( const bool useUpdatedFreeDOF ){
         /*!
-         * Homogenize the micro-scale properties to the macro scale.
+         * Project the degrees of freedom of the ghost nodes
+         * for the current increment
          *
-         * :param const unsigned int &microIncrement: The increment at the micro-scale to homogenize
+         * :const bool useUpdatedFreeDOF: A flag indicating if the free displacements vectors to be
+         *     used should be the updated values or the values from the input file
          */
 
-        //Clear all of the previous values at the micro domains
-        homogenizedVolumes.clear( );
-        homogenizedSurfaceAreas.clear( );
-        homogenizedDensities.clear( );
-        homogenizedMicroInertias.clear( );
-        homogenizedCentersOfMass.clear( );
-        homogenizedBodyForces.clear( );
-        homogenizedBodyForceCouples.clear( );
-        homogenizedAccelerations.clear( );
-        homogenizedMicroSpinInertias.clear( );
-        homogenizedSymmetricMicroStresses.clear( );
-        cellDomainMacroSurfaces.clear( );
-        homogenizedSurfaceRegionAreas.clear( );
-//        homogenizedSurfaceRegionDensities.clear( );
-        homogenizedSurfaceRegionCentersOfMass.clear( );
-        homogenizedSurfaceRegionProjectedLocalCentersOfMass.clear( );
-        homogenizedSurfaceRegionProjectedCentersOfMass.clear( );
-        homogenizedSurfaceRegionTractions.clear( );
-        homogenizedSurfaceRegionCouples.clear( );
+        //Get the free and ghost node ids
+        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
+        const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
 
-        //Clear all of the previous values at the quadrature points
-        quadraturePointDensities.clear( );
-        quadraturePointBodyForce.clear( );
-        quadraturePointAccelerations.clear( );
-        quadraturePointMicroInertias.clear( );
-        quadraturePointBodyCouples.clear( );
-        quadraturePointMicroSpinInertias.clear( );
-        quadraturePointSymmetricMicroStress.clear( );
-        quadraturePointCauchyStress.clear( );
-        quadraturePointHigherOrderStress.clear( );
+        const uIntVector *freeMicroNodeIds = _inputProcessor.getFreeMicroNodeIds( );
+        const uIntVector *ghostMicroNodeIds = _inputProcessor.getGhostMicroNodeIds( );
 
-        //Clear the external forces at the nodes
-        externalForcesAtNodes.clear( );
-        externalCouplesAtNodes.clear( );
+        //Set the number of displacement degrees of freedom
+        unsigned int nMacroDispDOF = _dim + _dim * _dim;
+        unsigned int nMicroDispDOF = _dim;
 
-        //Loop through the free macro-scale cells
-        errorOut error = NULL;
+        //Assemble the free displacements
+        floatVector *freeMacroDisplacements;
+        floatVector *freeMicroDisplacements;
 
-        uIntVector microDomainNodeIds;
-        floatVector microNodePositions;
-        std::shared_ptr< volumeReconstruction::volumeReconstructionBase > reconstructedVolume;
+        floatVector store1, store2;
 
-        const std::unordered_map< uIntType, stringVector > *macroCellToMicroDomainMap = _inputProcessor.getMacroCellToDomainMap( );
-        const std::unordered_map< std::string, uIntType > *microDomainSurfaceSplitCount = _inputProcessor.getMicroDomainSurfaceApproximateSplitCount( );
+        if ( useUpdatedFreeDOF ){
 
-        const std::unordered_map< uIntType, floatVector > *macroNodeReferenceLocations
-            = _inputProcessor.getMacroNodeReferencePositions( );
-        const std::unordered_map< uIntType, floatVector > *macroDisplacements
-            = _inputProcessor.getMacroDisplacements( );
-        const std::unordered_map< uIntType, uIntVector > *macroConnectivity
-            = _inputProcessor.getMacroNodeReferenceConnectivity( );
+            freeMicroDisplacements = &_updatedFreeMicroDispDOFValues;
+            freeMacroDisplacements = &_updatedFreeMacroDispDOFValues;
 
-        std::unique_ptr< elib::Element > element;
+        }
+        else{
 
-        std::cerr << "HOMOGENIZING THE FREE MACRO CELLS\n";
-        for ( auto macroCell  = _inputProcessor.getFreeMacroCellIds( )->begin( );
-                   macroCell != _inputProcessor.getFreeMacroCellIds( )->end( );
-                   macroCell++ ){
+            store1.resize( nMacroDispDOF * freeMacroNodeIds->size( ) );
+            store2.resize( nMicroDispDOF * freeMicroNodeIds->size( ) );
 
-            //Build the macro element
-            error = overlapCoupling::buildMacroDomainElement( *macroCell, *macroNodeReferenceLocations,
-                                                              *macroDisplacements, *macroConnectivity,
-                                                              element );
+            freeMacroDisplacements = &store1;
+            freeMicroDisplacements = &store2;
+
+            const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+            const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
+
+            //Get the displacement fields
+            const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
+            const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+
+            const floatVector *macroDispDOFVector, *microDisplacements;
+            uIntType macroStride, microStride, localIndex;
+
+            errorOut error = macroNodeFields->getField( "displacement_dof", macroDispDOFVector, macroStride );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error constructing the macro element" );
+                errorOut result = new errorNode( __func__, "Error in getting the macro displacement DOF field" );
                 result->addNext( error );
                 return result;
 
             }
 
-            //Get the micro domain names within this cell
-            auto microDomains = macroCellToMicroDomainMap->find( *macroCell );
-            if ( microDomains == macroCellToMicroDomainMap->end( ) ){
+            if ( macroStride != nMacroDispDOF ){
 
                 return new errorNode( __func__,
-                                      "Macro cell " + std::to_string( *macroCell ) + " not found in the macro cell to micro domain map" ) ;
+                                      "The macro displacement DOF field does not have a dimensionally consistent number of degrees of freedom" );
 
             }
 
-            for ( auto microDomain  = microDomains->second.begin( ); microDomain != microDomains->second.end( ); microDomain++ ){
-
-                microNodePositions.clear( );
-                reconstructedVolume.reset( );
-
-                //Reconstruct the micro-domain's volume
-                std::cerr << "  RECONSTRUCTING THE DOMAIN\n";
-                error = reconstructDomain( microIncrement, *microDomain, microDomainNodeIds, microNodePositions,
-                                           element, reconstructedVolume );
+            error = microNodeFields->getField( "displacement", microDisplacements, microStride );
 
-                if ( error ){
+            if ( error ){
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the reconstruction of the microscale domain" );
-                    result->addNext( error );
-                    return result;
+                errorOut result = new errorNode( __func__, "Error in getting the micro displacement field" );
+                result->addNext( error );
+                return result;
 
-                }
+            }
 
-                //Compute the volume averages
-                auto domainCenterOfMass = _ghostMicroDomainCentersOfMass.find( *microDomain );
-                if ( domainCenterOfMass == _ghostMicroDomainCentersOfMass.end( ) ){
+            if ( microStride != nMicroDispDOF ){
 
-                    std::string outstr = "Ghost micro domain ";
-                    outstr += *microDomain;
-                    outstr += " not found in the center of mass map";
-                    return new errorNode( __func__, outstr );
+                return new errorNode( __func__,
+                                      "The micro displacement field does not have a dimensionally consistent number of degrees of freedom" );
 
-                }
+            }
+   
+            for ( auto it = freeMacroNodeIds->begin( ); it != freeMacroNodeIds->end( ); it++ ){
 
-                std::cerr << "  COMPUTING THE VOLUME AVERAGES\n";
-                error = computeDomainVolumeAverages( *macroCell, *microDomain, microDomainNodeIds,
-                                                     reconstructedVolume, &domainCenterOfMass->second );
+                error = macroNodeFields->getLocalIndex( *it, localIndex );
 
                 if ( error ){
 
                     errorOut result = new errorNode( __func__,
-                                                     "Error in the computation of the volume averages of the microscale domain" );
+                                                     "Macro node " + std::to_string( *it ) +
+                                                     " was not found in the macro displacement dof field" );
                     result->addNext( error );
                     return result;
 
                 }
 
-                auto domainSurfaceCount = microDomainSurfaceSplitCount->find( *microDomain );
-                if ( domainSurfaceCount == microDomainSurfaceSplitCount->end( ) ){
+                const floatType *macroDispDOF = macroDispDOFVector->data( ) + nMacroDispDOF * localIndex;
+
+                auto map = macroGlobalToLocalDOFMap->find( *it );
+
+                if ( map == macroGlobalToLocalDOFMap->end( ) ){
 
                     return new errorNode( __func__,
-                                          "The micro domain " + *microDomain + " was not found in the domain surface split count map" );
+                                          "Macro node " + std::to_string( *it ) +
+                                          " was not found in the macro global-to-local node map" );
 
                 }
-                
-                //Compute the surface averages
-                std::cerr << "  COMPUTING THE SURFACE AVERAGES\n";
-                error = computeDomainSurfaceAverages( *macroCell, *microDomain, microDomainNodeIds,
-                                                      domainSurfaceCount->second,
-                                                      reconstructedVolume, element );
+    
+                //Set the macro displacements
+                for ( unsigned int i = 0; i < nMacroDispDOF; i++ ){
+    
+                    ( *freeMacroDisplacements )[ nMacroDispDOF * ( map->second ) + i ] = macroDispDOF[ i ];
+    
+                }
+    
+            }
+    
+            for ( auto it = freeMicroNodeIds->begin( ); it != freeMicroNodeIds->end( ); it++ ){
+   
+                error = microNodeFields->getLocalIndex( *it, localIndex );
 
                 if ( error ){
 
                     errorOut result = new errorNode( __func__,
-                                                     "Error in the computation of the surface averages of the microscale domain" );
+                                                     "Micro node " + std::to_string( *it ) +
+                                                     " was not found in the micro displacement dof field" );
                     result->addNext( error );
                     return result;
 
                 }
-                
-            }
-
-            //Compute the approximate stresses
-            std::cerr << "COMPUTING THE HOMOGENIZED STRESSES\n";
-            error = computeHomogenizedStresses( *macroCell );
-
-            if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the homogenized stresses" );
-                result->addNext( error );
-                return result;
+                const floatType *microDispDOF = microDisplacements->data( ) + nMicroDispDOF * localIndex;
 
-            }
+                auto map = microGlobalToLocalDOFMap->find( *it );
 
-        }
+                if ( map == microGlobalToLocalDOFMap->end( ) ){
 
-        //Loop through the ghost macro-scale cells
-        std::cerr << "HOMOGENIZING THE GHOST MACRO CELLS\n";
-        for ( auto macroCell  = _inputProcessor.getGhostMacroCellIds( )->begin( );
-                   macroCell != _inputProcessor.getGhostMacroCellIds( )->end( );
-                   macroCell++ ){
+                    return new errorNode( __func__,
+                                          "Micro node " + std::to_string( *it ) +
+                                          " was not found in the micro global-to-local node map" );
 
+                }
     
-            if ( _inputProcessor.isFiltering( ) ){
-    
-                std::unordered_map< uIntType, floatVector > projectedMacroDisplacements;
-    
-                auto cellConnectivity = macroConnectivity->find( *macroCell );
-    
-                if ( cellConnectivity == macroConnectivity->end( ) ){
+                //Set the micro displacements
+                for ( unsigned int i = 0; i < nMicroDispDOF; i++ ){
     
-                    return new errorNode( __func__, "Macro cell " + std::to_string( *macroCell ) + " not found in connectivity map" );
+                    ( *freeMicroDisplacements )[ nMicroDispDOF * ( map->second ) + i ] = microDispDOF[ i ];
     
                 }
+    
+            }
 
-                auto macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
-
-                unsigned int nMacroFreeNodes = _inputProcessor.getFreeMacroNodeIds( )->size( ); // I anticipate this should always be zero
-
-                unsigned int nMacroDOF = _dim + _dim * _dim;
+        }
 
-                for ( auto node = cellConnectivity->second.begin( ) + 1; node != cellConnectivity->second.end( ); node++ ){
+        //Map the macro and micro free displacements to Eigen matrices
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > Q( freeMicroDisplacements->data(), freeMicroDisplacements->size( ), 1 );
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > D( freeMacroDisplacements->data(), freeMacroDisplacements->size( ), 1 );
 
-                    auto local_node = macroGlobalToLocalDOFMap->find( *node );
+        //Map the output vectors to Eigen matrices
+        _projected_ghost_macro_displacement.clear( );
+        _projected_ghost_macro_displacement.resize( nMacroDispDOF * ghostMacroNodeIds->size( ) );
 
-                    if ( local_node == macroGlobalToLocalDOFMap->end( ) ){
+        _projected_ghost_micro_displacement.clear( );
+        _projected_ghost_micro_displacement.resize( nMicroDispDOF * ghostMicroNodeIds->size( ) );
 
-                        return new errorNode( __func__, "Micro node " + std::to_string( *node) + " not found in the global to local map" );
+        Eigen::Map< Eigen::Matrix< floatType, -1,  1 > > Qhat( _projected_ghost_micro_displacement.data(),
+                                                               _projected_ghost_micro_displacement.size( ), 1 );
 
-                    }
+        Eigen::Map< Eigen::Matrix< floatType, -1,  1 > > Dhat( _projected_ghost_macro_displacement.data(),
+                                                               _projected_ghost_macro_displacement.size( ), 1 );
 
-                    projectedMacroDisplacements.emplace( *node, floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second,
-                                                                             _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second + 3 ) );
+        YAML::Node config = _inputProcessor.getCouplingInitialization( );
 
-                }
+        if ( ( config[ "projection_type" ].as< std::string >( ).compare( "l2_projection" ) == 0 ) && _implicitL2Projectors ){
 
-                //Build the macro element
-                error = overlapCoupling::buildMacroDomainElement( *macroCell, *macroNodeReferenceLocations,
-                                                                  projectedMacroDisplacements, *macroConnectivity,
-                                                                  element );
- 
-            }
-            else{
-    
-                //Build the macro element
-                error = overlapCoupling::buildMacroDomainElement( *macroCell, *macroNodeReferenceLocations,
-                                                                  *macroDisplacements, *macroConnectivity,
-                                                                  element );
+            Eigen::MatrixXd projectedQhat, projectedDhat;
 
-            }
+            errorOut error = applyL2ProjectorsImplicitly( Q, D, projectedQhat, projectedDhat );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error constructing the macro element" );
+                errorOut result = new errorNode( __func__, "Error in the implicit L2 projection of the ghost degrees of freedom" );
                 result->addNext( error );
                 return result;
 
             }
 
-            //Get the micro domain names within this cell
-            auto microDomains = macroCellToMicroDomainMap->find( *macroCell );
-            if ( microDomains == macroCellToMicroDomainMap->end( ) ){
-
-                return new errorNode( __func__,
-                                      "Macro cell " + std::to_string( *macroCell ) + " not found in the macro cell to micro domain map" ) ;
-            }
-
-            for ( auto microDomain = microDomains->second.begin( ); microDomain != microDomains->second.end( ); microDomain++ ){
+            Dhat = projectedDhat;
+            Qhat = projectedQhat;
 
-                microNodePositions.clear( );
-                reconstructedVolume.reset( );
+        }
+        else if ( ( config[ "projection_type" ].as< std::string >( ).compare( "l2_projection" ) == 0 ) && !_useSparseL2Projectors ){
 
-                //Reconstruct the micro-domain's volume
-                std::cerr << "  RECONSTRUCTING THE DOMAIN\n";
-                error = reconstructDomain( microIncrement, *microDomain, microDomainNodeIds, microNodePositions,
-                                           element, reconstructedVolume );
+            Dhat = _dense_BDhatQ * Q + _dense_BDhatD * D;
+            Qhat = _dense_BQhatQ * Q + _dense_BQhatD * D;
 
-                if ( error ){
+        }
+        else if ( ( config[ "projection_type" ].as< std::string >( ).compare( "direct_projection" ) == 0 ) ||
+                  ( config[ "projection_type" ].as< std::string >( ).compare( "averaged_l2_projection" ) == 0 ) ||
+                  ( config[ "projection_type" ].as< std::string >( ).compare( "l2_projection" ) == 0 ) ){
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the reconstruction of the microscale domain" );
-                    result->addNext( error );
-                    return result;
+            Dhat = _sparse_BDhatQ * Q + _sparse_BDhatD * D;
+            Qhat = _sparse_BQhatQ * Q + _sparse_BQhatD * D;
 
-                }
+        }
+        else{
 
-                //Compute the volume averages
-                auto domainCenterOfMass = _freeMicroDomainCentersOfMass.find( *microDomain );
-                if ( domainCenterOfMass == _freeMicroDomainCentersOfMass.end( ) ){
+            return new errorNode( __func__,
+                                  "'projection_type' '" + config[ "projection_type" ].as< std::string >( ) + "' is not recognized" );
 
-                    std::string outstr = "Free micro domain ";
-                    outstr += *microDomain;
-                    outstr += " not found in the center of mass map";
-                    return new errorNode( __func__, outstr );
+        }
 
-                }
+        return NULL;
 
-                std::cerr << "  COMPUTING THE VOLUME AVERAGES\n";
-                error = computeDomainVolumeAverages( *macroCell, *microDomain, microDomainNodeIds,
-                                                     reconstructedVolume, &domainCenterOfMass->second );
+    }
 
-                if ( error ){
+    errorOut overlapCoupling::addDomainToDirectProjectionReferenceValues( const uIntVector &domainNodes,
+                                                                          const uIntVector &macroNodes,
+                                                                          const std::unordered_map< uIntType, floatVector > &domainReferenceXiVectors,
+                                                                          const std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues ){
+        /*!
+         * Add the current domain information to the direct projection reference values
+         *
+         * :param const uIntVector &domainNodes: The nodes associated with the current domain
+         * :param const uIntVector &macroNodes: The macro nodes associated with the current domain
+         * :param const std::unordered_map< uIntType, floatVector > &domainReferenceXiVectors: The relative position
+         *     vectors of the domain
+         * :param const std::unordered_map< uIntType, floatVector > &domainMicroPositionShapeFunctionValues: The shape function values at the micro
+         *     node positions.
+         */
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the computation of the volume averages of the microscale domain" );
-                    result->addNext( error );
-                    return result;
+        const std::unordered_map< uIntType, floatType > *microDensities = _inputProcessor.getMicroDensities( );
+        const std::unordered_map< uIntType, floatType > *microVolumes   = _inputProcessor.getMicroVolumes( );
+        const std::unordered_map< uIntType, floatType > *microWeights   = _inputProcessor.getMicroWeights( );
 
-                }
-                
-                auto domainSurfaceCount = microDomainSurfaceSplitCount->find( *microDomain );
-                if ( domainSurfaceCount == microDomainSurfaceSplitCount->end( ) ){
+        //Additional values
+        unsigned int n;
 
-                    return new errorNode( __func__,
-                                          "The micro domain " + *microDomain + " was not found in the domain surface split count map" );
+        floatType microMass, weight, sf;
+        floatVector Xi;
 
-                }
+        //Loop through the micro nodes
+        for ( auto microNode  = domainNodes.begin( );
+                   microNode != domainNodes.end( );
+                   microNode++ ){
 
-                //Compute the surface averages
-                std::cerr << "  COMPUTING THE SURFACE AVERAGES\n";
-                error = computeDomainSurfaceAverages( *macroCell, *microDomain, microDomainNodeIds,
-                                                      domainSurfaceCount->second,
-                                                      reconstructedVolume, element );
+            auto microDensity = microDensities->find( *microNode );
 
-                if ( error ){
+            if ( microDensity == microDensities->end( ) ){
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the computation of the surface averages of the microscale domain" );
-                    result->addNext( error );
-                    return result;
+                return new errorNode( __func__,
+                                      "Micro node " + std::to_string( *microNode ) + " was not found in the micro density map" );
 
-                }
-                
             }
 
-            //Compute the approximate stresses
-            std::cerr << "COMPUTING THE HOMOGENIZED STRESSES\n";
-            error = computeHomogenizedStresses( *macroCell );
+            auto microVolume = microVolumes->find( *microNode );
 
-            if ( error ){
+            if ( microVolume == microVolumes->end( ) ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the homogenized stresses" );
-                result->addNext( error );
-                return result;
+                return new errorNode( __func__,
+                                      "Micro node " + std::to_string( *microNode ) + " was not found in the micro volume map" );
 
             }
 
-        }
+            auto microWeight = microWeights->find( *microNode );
 
-        //Compute the homogenized force vectors and mass matrices
-        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
+            if ( microWeight == microWeights->end( ) ){
 
-        if ( config[ "projection_type" ].as< std::string >( ).compare( "arlequin" ) != 0 ){
+                return new errorNode( __func__,
+                                      "Micro node " + std::to_string( *microNode ) + " was not found in the micro weight map" );
 
-            std::cerr << "ASSEMBLE HOMOGENIZED MATRICES AND VECTORS\n";
-            error = assembleHomogenizedMatricesAndVectors( );
+            }
 
-            if ( error ){
+            auto referenceXi = domainReferenceXiVectors.find( *microNode );
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the homogenized forces and mass matrix" );
-                result->addNext( error );
-                return result;
+            if ( referenceXi == domainReferenceXiVectors.end( ) ){
+
+                return new errorNode( __func__,
+                                      "Micro node " + std::to_string( *microNode ) + " was not found in the reference Xi map" );
 
             }
 
-        }
+            auto shapefunctions = domainMicroPositionShapeFunctionValues.find( *microNode );
+
+            if ( shapefunctions == domainMicroPositionShapeFunctionValues.end( ) ){
+
+                return new errorNode( __func__,
+                                      "Micro node " + std::to_string( *microNode ) + " was not found in the shape function values map" );
+
+            }
+
+            //Compute the micro-mass
+            microMass = microDensity->second * microVolume->second;
+
+            //Extract the micro Xi vector
+            Xi = referenceXi->second;
+
+            //Extract the weighting value
+            weight = microWeight->second;
+
+            //Loop through the macro nodes
+            for ( auto macroNode  = macroNodes.begin( );
+                       macroNode != macroNodes.end( );
+                       macroNode++ ){
+
+                //Set the index
+                n = macroNode - macroNodes.begin( );
+
+                auto indx = _inputProcessor.getMacroGlobalToLocalDOFMap( )->find( *macroNode );
+
+                if ( indx == _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( ) ){
+
+                    return new errorNode( __func__,
+                                          "Macro node '" + std::to_string( *macroNode ) + "' not found in global to local macro node map" );
+
+                }
+
+                //Get the shape function
+                sf = shapefunctions->second[ n ];
+
+                //Add the contribution to the nodal mass
+                if ( _macroNodeProjectedMass.find( *macroNode ) == _macroNodeProjectedMass.end( ) ){
+
+                    _macroNodeProjectedMass.emplace( *macroNode, 0. );
+                    _macroNodeProjectedMassMomentOfInertia.emplace( *macroNode, floatVector( _dim * _dim, 0 ) );
+                    _macroNodeMassRelativePositionConstant.emplace( *macroNode, floatVector( _dim, 0 ) );
+
+                }
+
+                _macroNodeProjectedMass[ *macroNode ] += microMass * sf * weight;
+                _macroNodeMassRelativePositionConstant[ *macroNode ] += microMass * sf * weight * Xi;
+
+                for ( unsigned int I = 0; I < _dim; I++ ){
 
-        std::cerr << "MICROSCALE HOMOGENIZATION COMPLETED\n";
+                    for ( unsigned int J = 0; J < _dim; J++ ){
+
+                        _macroNodeProjectedMassMomentOfInertia[ *macroNode ][ _dim * I + J ] += microMass * sf * weight * Xi[ I ] * Xi[ J ];
+
+                    }
+
+                }
+
+            }
+
+        }
 
         return NULL;
     }
 
-    errorOut overlapCoupling::reconstructDomain( const unsigned int &microIncrement, const std::string &microDomainName,
-                                                 uIntVector &microDomainNodes, floatVector &microNodePositions,
-                                                 const std::unique_ptr< elib::Element > &element,
-                                                 std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume ){
+    errorOut overlapCoupling::addDomainContributionToDirectFreeMicroToGhostMacroProjector( const unsigned int &cellIndex,
+                                                                                           const unsigned int &cellID,
+                                                                                           const unsigned int &microIncrement,
+                                                                                           const std::string &domainName,
+                                                                                           uIntVector &macroNodes ){
         /*!
-         * Reconstruct the micro-domain's volume to perform volume and surface integrals over that
-         * domain.
-         *
-         * :param const unsigned int &microIncrement: The increment at which to extract the micro-positions
-         * :param const std::string &microDomainName: The name of the micro-domain to be re-constructed.
-         * :param uIntVector &microDomainNodes: The nodes associated with the micro domain
-         * :param floatVector &microNodePositions: The positions of the micro nodes for the current domain
-         * :param const std::unique_ptr< elib::element > &element: The macro-scale element that contains the domain.
-         * :param std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume: The reconstructed
-         *     volume ready for additional processing.
+         * Compute the current domain's contribution to the direct free micro to ghost macro
+         * projection matrix
          */
 
-        //Get the volume reconstruction configuration
-        YAML::Node volumeReconstructionConfig = _inputProcessor.getVolumeReconstructionConfig( );
+        //Compute the shape functions at the micro-nodes for the domain
 
         //Get the domain node ids
-        errorOut error = _inputProcessor._microscale->getSubDomainNodes( microIncrement, microDomainName, microDomainNodes );
+        uIntVector domainNodes;
+        errorOut error = _inputProcessor.getMicroDomainNodes( microIncrement, domainName, domainNodes );
 
         if ( error ){
 
             errorOut result = new errorNode( __func__,
-                                             "Error in getting the node ids for the domain ( " + microDomainName + " )" );
+                                             "Error in extracting the domain ( " + domainName + " ) nodes" );
             result->addNext( error );
             return result;
 
         }
 
-        //Get the micro-node positions
-        microNodePositions.clear( );
-        microNodePositions.reserve( _dim * microDomainNodes.size( ) );
+        //Get the micro-node positions and relative position vectors
+        std::unordered_map< uIntType, floatVector > microNodePositions;
  
-        unsigned int index = 0;
         const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
-        const std::unordered_map< uIntType, floatVector > *microDisplacements      = _inputProcessor.getMicroDisplacements( );
-        uIntVector interiorNodes;
- 
-        for ( auto it = microDomainNodes.begin( ); it != microDomainNodes.end( ); it++, index++ ){
+        const inputFileProcessor::nodeFieldContainer *microNodeFields              = _inputProcessor.getMicroNodeFields( );
+        const floatType *microDisplacement;
+        uIntType stride;
+        std::unordered_map< uIntType, floatVector > domainReferenceXiVectors;
 
-            auto microReferencePosition = microReferencePositions->find( *it );
+        auto cellDomainCentersOfMass = _referenceFreeMicroDomainCentersOfMass.find( cellID );
+        if ( cellDomainCentersOfMass == _referenceFreeMicroDomainCentersOfMass.end( ) ){
 
-            if ( microReferencePosition == microReferencePositions->end( ) ){
+            return new errorNode( __func__,
+                                  "Macro cell " + std::to_string( cellID ) + " not found in reference domain centers of mass map" );
 
-                return new errorNode( __func__, "Micro node " + std::to_string( *it ) +
-                                      " was not found in the micro reference position map" );
+        }
 
-            }
+        auto domainCenterOfMass = cellDomainCentersOfMass->second.find( domainName );
+
+        if ( domainCenterOfMass == cellDomainCentersOfMass->second.end( ) ){
+
+            std::string outstr = "Micro domain ";
+            outstr += domainName;
+            outstr += " not found in the micro domain centers of mass";
+            return new errorNode( __func__, outstr );
 
-            auto microDisplacement = microDisplacements->find( *it );
+        }
+ 
+        for ( auto it = domainNodes.begin( ); it != domainNodes.end( ); it++ ){
 
-            if ( microDisplacement == microDisplacements->end( ) ){
+            auto microReferencePosition = microReferencePositions->find( *it );
 
-                return new errorNode( __func__, "Micro node " + std::to_string( *it ) +
-                                      " was not found in the micro displacement map" );
+            if ( microReferencePosition == microReferencePositions->end( ) ){
+
+                return new errorNode( __func__,
+                                      "Micro node " + std::to_string( *it ) + " was not found in the micro reference position map" );
 
             }
 
-            //Check that the given micro-node is located inside of the macro-scale element.
-            //If not, we will ignore the micro node
-            floatVector cp = microDisplacement->second + microReferencePosition->second;
-            if ( element->contains_point( cp, volumeReconstructionConfig[ "element_contain_tolerance" ].as< floatType >( ) ) ){
-            
-                interiorNodes.push_back( *it );
+            error = microNodeFields->getNodeValues( "displacement", *it, microDisplacement, stride );
 
-                for ( unsigned int i = 0; i < _dim; i++ ){
-    
-                    microNodePositions.push_back( microReferencePosition->second[ i ] + microDisplacement->second[ i ] );
-    
-                }
+            if ( error ){
 
-            }
- 
-        }
+                errorOut result = new errorNode( __func__,
+                                                 "Micro node " + std::to_string( *it ) + " was not found in the micro displacement field" );
+                result->addNext( error );
+                return result;
 
-        //Reset micro domain nodes
-        microDomainNodes = interiorNodes;
+            }
 
-        //Pass the base name of the output file to the volume reconstruction configuration to be used if output has been requested
-        volumeReconstructionConfig[ "baseOutputFilename" ] = microDomainName + "_" + std::to_string( microIncrement );
+            floatVector microNodePosition = microReferencePosition->second;
 
-        //Get the volume reconstruction object
-        reconstructedVolume
-            = volumeReconstruction::volumeReconstructionBase( volumeReconstructionConfig ).create( );
+            for ( unsigned int i = 0; i < _dim; i++ ){
 
-        if ( reconstructedVolume->getError( ) ){
+                microNodePosition[ i ] += microDisplacement[ i ];
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in creating the volume reconstruction object for " + microDomainName );
+            }
 
-            result->addNext( reconstructedVolume->getError( ) );
+            microNodePositions.emplace( *it, microNodePosition );
 
-            return result;
+            domainReferenceXiVectors.emplace( *it, microNodePositions[ *it ] - domainCenterOfMass->second );
 
         }
-
-        //Load the micro points
-        error = reconstructedVolume->loadPoints( &microNodePositions );
+ 
+        //Compute the shape function values at the micro positions
+        std::unordered_map< uIntType, floatVector > domainMicroPositionShapeFunctionValues;
+        error = computeShapeFunctionsAtPoints( cellID,
+                                               *_inputProcessor.getMacroNodeReferencePositions( ),
+                                               *_inputProcessor.getMacroDisplacements( ),
+                                               *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                               microNodePositions, macroNodes,
+                                               domainMicroPositionShapeFunctionValues );
 
         if ( error ){
-
+ 
             errorOut result = new errorNode( __func__,
-                                             "Error in loading the micro-scale points for " + microDomainName );
+                                             "Error in the computation of the shape functions at the center of mass for a micro domain" );
             result->addNext( error );
-
             return result;
-
+ 
         }
 
-        //Add the filter's domain
-        error = reconstructedVolume->reconstructInLocalDomain( element );
-
-        //Reconstruct the volume
-        error = reconstructedVolume->evaluate( );
+        //Construct the contribution of the domain
+        
+        //Get the domain's mass properties
+        floatVector domainMacroNodeProjectedMass( macroNodes.size( ) );
+        floatVector domainMacroNodeProjectedMassMomentOfInertia( _dim * _dim * macroNodes.size( ) );
+        floatVector domainMacroNodeProjectedMassRelativePositionConstant( _dim * macroNodes.size( ) );
+        
+        auto microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
+        auto macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-        if ( error ){
+        //We also specify the global to local map for the projector.
+        //This is not the same as the existing global map for the macro nodes
+        //because we store the free nodes first, so we have to shift them by 
+        //the number of free macro-scale nodes
+        DOFMap projectorMacroGlobalToLocalDOFMap;
+        projectorMacroGlobalToLocalDOFMap.reserve( _inputProcessor.getGhostMacroNodeIds( )->size( ) );
+
+        for ( auto md  = macroNodes.begin( );
+                   md != macroNodes.end( );
+                   md++ ){
+
+            auto indx = macroGlobalToLocalDOFMap->find( *md );
+
+            if ( indx == macroGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "'" + std::to_string( *md ) + "' not found in the DOF map" );
+
+            }
+
+            projectorMacroGlobalToLocalDOFMap.emplace( indx->first, indx->second - _inputProcessor.getFreeMacroNodeIds( )->size( ) );
+
+        }
+
+        //Construct the projector contribution for this domain
+        SparseMatrix domainProjector;
+
+        error = DOFProjection::formMicroDomainToMacroProjectionMatrix( _dim,
+                                                                       _inputProcessor.getFreeMicroNodeIds( )->size( ),
+                                                                       _inputProcessor.getGhostMacroNodeIds( )->size( ),
+                                                                       domainNodes, macroNodes,
+                                                                       *_inputProcessor.getMicroVolumes( ),
+                                                                       *_inputProcessor.getMicroDensities( ),
+                                                                       *_inputProcessor.getMicroWeights( ),
+                                                                       domainReferenceXiVectors,
+                                                                       domainMicroPositionShapeFunctionValues,
+                                                                       _macroNodeProjectedMass,
+                                                                       _macroNodeProjectedMassMomentOfInertia,
+                                                                       _macroNodeMassRelativePositionConstant,
+                                                                       domainProjector,
+                                                                       microGlobalToLocalDOFMap,
+                                                                       &projectorMacroGlobalToLocalDOFMap );
 
+        if ( error ){
             errorOut result = new errorNode( __func__,
-                                             "Error in loading the micro-scale points for " + microDomainName );
+                                             "Error in the computation of the domain's contribution to the micro to macro projection matrix" );
             result->addNext( error );
             return result;
+        }
+
+        if ( _sparse_BQhatQ.nonZeros( ) == 0 ){
+
+            _sparse_BDhatQ = domainProjector;
+
+        }
+        else{
+
+            _sparse_BDhatQ += domainProjector;
 
         }
 
@@ -5314,357 +5662,304 @@ namespace overlapCoupling{
 
     }
 
-    errorOut overlapCoupling::computeDomainVolumeAverages( const uIntType &macroCellID, const std::string &microDomainName,
-                                                           const uIntVector &microDomainNodeIDs,
-                                                           std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume,
-                                                           const floatVector *microDomainCenterOfMass ){
+    errorOut overlapCoupling::homogenizeMicroScale( const unsigned int &microIncrement ){
         /*!
-         * Compute the required volume averages over the micro-domain.
+         * Homogenize the micro-scale properties to the macro scale.
          *
-         * :param const uIntType &macroCellID: The ID number of the macro-cell associated with the micro domain.
-         * :param const std::string &microDomainName: The name of the micro domain
-         * :param const uIntVector &microDomainNodeIDs: The micro domain's node ids
-         * :param volumeReconstruction::volumeReconstructionBase &reconstructedVolume: The reconstructed volume
-         *     ready to have volume integrals computed over.
-         * :param const floatVector *microDomainCenterOfMass: The center of mass for the micro-domain computed
-         *     directly from the particles.
+         * :param const unsigned int &microIncrement: The increment at the micro-scale to homogenize
          */
 
-        //Assemble the averaging vector at the nodes for non-volume weighted averaging quantities
-        unsigned int dataCountAtPoint = 1  //Volume calculation
-                                      + 1  //Density
-                                      + 9; //Stress
-
-        unsigned int initialOffset = 11;
-
-        if ( _inputProcessor.useReconstructedMassCenters( ) ){
-            dataCountAtPoint += _dim; //Domain center of mass
-        }
-
-        //Add the micro body force if it is defined
-        if ( _inputProcessor.microBodyForceDefined( ) ){
-
-            dataCountAtPoint += _dim; //Add the micro body force
+        //Clear all of the previous values at the micro domains
+        homogenizedVolumes.clear( );
+        homogenizedSurfaceAreas.clear( );
+        homogenizedDensities.clear( );
+        homogenizedMicroInertias.clear( );
+        homogenizedCentersOfMass.clear( );
+        homogenizedBodyForces.clear( );
+        homogenizedBodyForceCouples.clear( );
+        homogenizedAccelerations.clear( );
+        homogenizedMicroSpinInertias.clear( );
+        homogenizedSymmetricMicroStresses.clear( );
+        cellDomainMacroSurfaces.clear( );
+        homogenizedSurfaceRegionAreas.clear( );
+//        homogenizedSurfaceRegionDensities.clear( );
+        homogenizedSurfaceRegionCentersOfMass.clear( );
+        homogenizedSurfaceRegionProjectedLocalCentersOfMass.clear( );
+        homogenizedSurfaceRegionProjectedCentersOfMass.clear( );
+        homogenizedSurfaceRegionTractions.clear( );
+        homogenizedSurfaceRegionCouples.clear( );
 
-        }
+        //Clear all of the previous values at the quadrature points
+        quadraturePointDensities.clear( );
+        quadraturePointBodyForce.clear( );
+        quadraturePointAccelerations.clear( );
+        quadraturePointMicroInertias.clear( );
+        quadraturePointBodyCouples.clear( );
+        quadraturePointMicroSpinInertias.clear( );
+        quadraturePointSymmetricMicroStress.clear( );
+        quadraturePointCauchyStress.clear( );
+        quadraturePointHigherOrderStress.clear( );
 
-        //Add the micro spin inertia term if the acceleration is defined
-        if ( _inputProcessor.microAccelerationDefined( ) ){
+        //Clear the external forces at the nodes
+        externalForcesAtNodes.clear( );
+        externalCouplesAtNodes.clear( );
 
-            dataCountAtPoint += _dim; //Add the micro spin inertia term
+        errorOut error = NULL;
 
-        }
+        const std::unordered_map< uIntType, stringVector > *macroCellToMicroDomainMap = _inputProcessor.getMacroCellToDomainMap( );
+        const std::unordered_map< std::string, uIntType > *microDomainSurfaceSplitCount = _inputProcessor.getMicroDomainSurfaceApproximateSplitCount( );
 
-        floatVector dataAtMicroPoints( dataCountAtPoint * microDomainNodeIDs.size( ), 0 );
+        const std::unordered_map< uIntType, floatVector > *macroNodeReferenceLocations
+            = _inputProcessor.getMacroNodeReferencePositions( );
+        const std::unordered_map< uIntType, floatVector > *macroDisplacements
+            = _inputProcessor.getMacroDisplacements( );
+        const std::unordered_map< uIntType, uIntVector > *macroConnectivity
+            = _inputProcessor.getMacroNodeReferenceConnectivity( );
 
-        const std::unordered_map< uIntType, floatType > *microDensities = _inputProcessor.getMicroDensities( );
+        //Get the volume reconstruction configuration
+        const YAML::Node volumeReconstructionConfig = _inputProcessor.getVolumeReconstructionConfig( );
 
-        const std::unordered_map< uIntType, floatVector > *microBodyForces = _inputProcessor.getMicroBodyForces( );
+        //Collect the homogenization tasks. The macro elements are constructed and the micro domain
+        //node ids are extracted here as the data files may not be accessed concurrently.
+        std::unique_ptr< elib::Element > element;
+        std::vector< std::unique_ptr< elib::Element > > elements;
+        std::vector< homogenizationTask > tasks;
+        uIntVector homogenizedCells;
 
-        const std::unordered_map< uIntType, floatVector > *microAccelerations = _inputProcessor.getMicroAccelerations( );
+        //Loop through the free macro-scale cells
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "COLLECTING THE FREE MACRO CELLS\n";
+        for ( auto macroCell  = _inputProcessor.getFreeMacroCellIds( )->begin( );
+                   macroCell != _inputProcessor.getFreeMacroCellIds( )->end( );
+                   macroCell++ ){
 
-        const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
+            //Build the macro element
+            error = overlapCoupling::buildMacroDomainElement( *macroCell, *macroNodeReferenceLocations,
+                                                              *macroDisplacements, *macroConnectivity,
+                                                              element );
 
-        const std::unordered_map< uIntType, floatVector > *microDisplacements = _inputProcessor.getMicroDisplacements( );
+            if ( error ){
 
-        const std::unordered_map< uIntType, floatVector > *microStresses = _inputProcessor.getMicroStresses( );
+                errorOut result = new errorNode( __func__,
+                                                 "Error constructing the macro element" );
+                result->addNext( error );
+                return result;
 
-        unsigned int index = 0;
-        unsigned int localIndex = 0;
+            }
 
-        for ( auto node = microDomainNodeIDs.begin( ); node != microDomainNodeIDs.end( ); node++, index++ ){
+            elements.push_back( std::move( element ) );
+            homogenizedCells.push_back( *macroCell );
 
-            dataAtMicroPoints[ dataCountAtPoint * index + 0 ] = 1.;                           //Integrate the volume of the domain
+            //Get the micro domain names within this cell
+            auto microDomains = macroCellToMicroDomainMap->find( *macroCell );
+            if ( microDomains == macroCellToMicroDomainMap->end( ) ){
 
-            auto microDensity = microDensities->find( *node );
-            if ( microDensity == microDensities->end( ) ){
                 return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *node ) + " was not found in the micro density map" );
-            }
-
-            dataAtMicroPoints[ dataCountAtPoint * index + 1 ] = microDensity->second; //Integrate the density of the domain
+                                      "Macro cell " + std::to_string( *macroCell ) + " not found in the macro cell to micro domain map" ) ;
 
-            //Integrate the micro stresses
-            auto microStress = microStresses->find( *node );
-            if ( microStress == microStresses->end( ) ){
-                return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *node ) + " was not found in the micro stress map" );
-            }
-            for ( unsigned int i = 0; i < _dim * _dim; i++ ){
-                dataAtMicroPoints[ dataCountAtPoint * index + 2 + i ] = microStress->second[ i ];
             }
 
-            localIndex = initialOffset;
+            for ( auto microDomain  = microDomains->second.begin( ); microDomain != microDomains->second.end( ); microDomain++ ){
 
-            if ( _inputProcessor.useReconstructedMassCenters( ) ){
+                auto domainCenterOfMass = _ghostMicroDomainCentersOfMass.find( *microDomain );
+                if ( domainCenterOfMass == _ghostMicroDomainCentersOfMass.end( ) ){
 
-                auto microReferencePosition = microReferencePositions->find( *node );
-                if ( microReferencePosition == microReferencePositions->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) + " was not found in the micro reference position map" );
-                }
+                    std::string outstr = "Ghost micro domain ";
+                    outstr += *microDomain;
+                    outstr += " not found in the center of mass map";
+                    return new errorNode( __func__, outstr );
 
-                auto microDisplacement = microDisplacements->find( *node );
-                if ( microDisplacement == microDisplacements->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) + " was not found in the micro displacement map" );
                 }
 
-                //Integrate for the domain's center of mass
-                for ( unsigned int i = 0; i < _dim; i++ ){
-    
-                    dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ] =
-                        microDensity->second * ( microReferencePosition->second[ i ] + microDisplacement->second[ i ] );
-    
-                }
+                auto domainSurfaceCount = microDomainSurfaceSplitCount->find( *microDomain );
+                if ( domainSurfaceCount == microDomainSurfaceSplitCount->end( ) ){
 
-                //Local index
-                localIndex += _dim;
+                    return new errorNode( __func__,
+                                          "The micro domain " + *microDomain + " was not found in the domain surface split count map" );
 
-            }
+                }
 
-            //Add the micro body forces
-            if ( _inputProcessor.microBodyForceDefined( ) ){
+                homogenizationTask task;
+                task.macroCellID = *macroCell;
+                task.elementIndex = elements.size( ) - 1;
+                task.microDomainName = *microDomain;
+                task.microDomainCenterOfMass = &domainCenterOfMass->second;
+                task.microDomainSurfaceDecompositionCount = domainSurfaceCount->second;
 
-                auto microBodyForce = microBodyForces->find( *node );
-                if ( microBodyForce == microBodyForces->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) + " was not found in the micro body force map" );
-                }
+                //Get the domain node ids
+                error = _inputProcessor.getMicroDomainNodes( microIncrement, *microDomain, task.microDomainNodeIDs );
 
-                for ( unsigned int i = 0; i < _dim; i++ ){
+                if ( error ){
 
-                    dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ]
-                        = microDensity->second * microBodyForce->second[ i ]; //Integrate the body forces of the domain
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in getting the node ids for the domain ( " + *microDomain + " )" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-                localIndex += _dim;
+                //Each task gets its own copy of the configuration as the volume reconstruction modifies it
+                task.volumeReconstructionConfig = YAML::Clone( volumeReconstructionConfig );
+
+                tasks.push_back( task );
 
             }
 
-            //Add the micro acclerations
-            if ( _inputProcessor.microAccelerationDefined( ) ){
+        }
 
-                auto microAcceleration = microAccelerations->find( *node );
-                if ( microAcceleration == microAccelerations->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) + " was not found in the micro acceleration map" );
+        //Loop through the ghost macro-scale cells
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "COLLECTING THE GHOST MACRO CELLS\n";
+        for ( auto macroCell  = _inputProcessor.getGhostMacroCellIds( )->begin( );
+                   macroCell != _inputProcessor.getGhostMacroCellIds( )->end( );
+                   macroCell++ ){
+
+    
+            if ( _inputProcessor.isFiltering( ) ){
+    
+                std::unordered_map< uIntType, floatVector > projectedMacroDisplacements;
+    
+                auto cellConnectivity = macroConnectivity->find( *macroCell );
+    
+                if ( cellConnectivity == macroConnectivity->end( ) ){
+    
+                    return new errorNode( __func__, "Macro cell " + std::to_string( *macroCell ) + " not found in connectivity map" );
+    
                 }
 
-                for ( unsigned int i = 0; i < _dim; i++ ){
+                auto macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-                    dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ]
-                        = microDensity->second * microAcceleration->second[ i ]; //Integrate the accelerations of the domain
+                unsigned int nMacroFreeNodes = _inputProcessor.getFreeMacroNodeIds( )->size( ); // I anticipate this should always be zero
 
-                }
+                unsigned int nMacroDOF = _dim + _dim * _dim;
 
-                localIndex += _dim;
+                for ( auto node = cellConnectivity->second.begin( ) + 1; node != cellConnectivity->second.end( ); node++ ){
 
-            }
+                    auto local_node = macroGlobalToLocalDOFMap->find( *node );
 
-        }
+                    if ( local_node == macroGlobalToLocalDOFMap->end( ) ){
 
-        //Compute the initial volume averages
-        floatVector integratedValues;
-        errorOut error = reconstructedVolume->performVolumeIntegration( dataAtMicroPoints, dataCountAtPoint, integratedValues );
+                        return new errorNode( __func__, "Micro node " + std::to_string( *node) + " not found in the global to local map" );
 
-        if ( error ){
+                    }
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in computing the initial volume averages" );
-            result->addNext( error );
-            return result;
-
-        }
-
-        //Splice in the micro domain's center of mass if required
-        if ( !_inputProcessor.useReconstructedMassCenters( ) ){
-
-            integratedValues
-                = vectorTools::appendVectors( { floatVector( integratedValues.begin( ), integratedValues.begin( ) + initialOffset ),
-                                                integratedValues[ 1 ] * ( *microDomainCenterOfMass ),
-                                                floatVector( integratedValues.begin( ) + 11, integratedValues.end( ) ) } );
-
-        }
-
-        //Splice in the micro-body force if required
-        if ( !_inputProcessor.microBodyForceDefined( ) ){
-
-            integratedValues
-                = vectorTools::appendVectors( { floatVector( integratedValues.begin( ),
-                                                             integratedValues.begin( ) + initialOffset + _dim ),
-                                                floatVector( _dim, 0 ),
-                                                floatVector( integratedValues.begin( ) + initialOffset + _dim,
-                                                             integratedValues.end( ) ) } );
-
-        }
-
-        //Splice in the micro acceleration if required
-        if ( !_inputProcessor.microAccelerationDefined( ) ){
-
-            integratedValues
-                = vectorTools::appendVectors( { integratedValues, floatVector( _dim, 0 ) } );
-
-        }
+                    projectedMacroDisplacements.emplace( *node, floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second,
+                                                                             _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second + 3 ) );
 
-        //Initialize
-        if ( homogenizedVolumes.find( macroCellID ) == homogenizedVolumes.end( ) ){
+                }
 
-            domainFloatMap tmpFloat;
-            domainFloatVectorMap tmpFloatVector;
+                //Build the macro element
+                error = overlapCoupling::buildMacroDomainElement( *macroCell, *macroNodeReferenceLocations,
+                                                                  projectedMacroDisplacements, *macroConnectivity,
+                                                                  element );
+ 
+            }
+            else{
+    
+                //Build the macro element
+                error = overlapCoupling::buildMacroDomainElement( *macroCell, *macroNodeReferenceLocations,
+                                                                  *macroDisplacements, *macroConnectivity,
+                                                                  element );
 
-            homogenizedVolumes.emplace( macroCellID, tmpFloat );
-            homogenizedDensities.emplace( macroCellID, tmpFloat );
-            homogenizedSymmetricMicroStresses.emplace( macroCellID, tmpFloatVector );
-            homogenizedCentersOfMass.emplace( macroCellID, tmpFloatVector );
-            homogenizedBodyForces.emplace( macroCellID, tmpFloatVector );
-            homogenizedAccelerations.emplace( macroCellID, tmpFloatVector );
-            homogenizedMicroInertias.emplace( macroCellID, tmpFloatVector );
-            homogenizedBodyForceCouples.emplace( macroCellID, tmpFloatVector );
-            homogenizedMicroSpinInertias.emplace( macroCellID, tmpFloatVector );
+            }
 
-        }
+            if ( error ){
 
-        homogenizedVolumes[ macroCellID ].emplace( microDomainName, integratedValues[ 0 ] );
-        homogenizedDensities[ macroCellID ].emplace( microDomainName, integratedValues[ 1 ] / integratedValues[ 0 ] );
-        homogenizedSymmetricMicroStresses[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + 2,
-                                                                                   integratedValues.begin( ) + 2 + _dim * _dim ) / integratedValues[ 0 ] );
-        homogenizedCentersOfMass[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset,
-                                                                                       integratedValues.begin( ) + initialOffset + _dim ) / integratedValues[ 1 ] );
-        homogenizedBodyForces[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset + _dim,
-                                                                                    integratedValues.begin( ) + initialOffset + 2 * _dim ) / integratedValues[ 1 ] );
-        homogenizedAccelerations[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset + 2 * _dim,
-                                                                                       integratedValues.end( ) ) / integratedValues[ 1 ] );
+                errorOut result = new errorNode( __func__,
+                                                 "Error constructing the macro element" );
+                result->addNext( error );
+                return result;
 
+            }
 
-        //Perform the relative position volume integrations
-        dataCountAtPoint = _dim * _dim; //The micro inertia
+            elements.push_back( std::move( element ) );
+            homogenizedCells.push_back( *macroCell );
 
-        initialOffset = dataCountAtPoint; //Set the initial offset
+            //Get the micro domain names within this cell
+            auto microDomains = macroCellToMicroDomainMap->find( *macroCell );
+            if ( microDomains == macroCellToMicroDomainMap->end( ) ){
 
-        //Add the micro body force couple if it is defined
-        if ( _inputProcessor.microBodyForceDefined( ) ){
+                return new errorNode( __func__,
+                                      "Macro cell " + std::to_string( *macroCell ) + " not found in the macro cell to micro domain map" ) ;
+            }
 
-            dataCountAtPoint += _dim * _dim; //Add the micro body force couple
+            for ( auto microDomain = microDomains->second.begin( ); microDomain != microDomains->second.end( ); microDomain++ ){
 
-        }
+                auto domainCenterOfMass = _freeMicroDomainCentersOfMass.find( *microDomain );
+                if ( domainCenterOfMass == _freeMicroDomainCentersOfMass.end( ) ){
 
-        //Add the micro spin inertia term if the acceleration is defined
-        if ( _inputProcessor.microAccelerationDefined( ) ){
+                    std::string outstr = "Free micro domain ";
+                    outstr += *microDomain;
+                    outstr += " not found in the center of mass map";
+                    return new errorNode( __func__, outstr );
 
-            dataCountAtPoint += _dim * _dim; //Add the micro spin inertia term
+                }
 
-        }
+                auto domainSurfaceCount = microDomainSurfaceSplitCount->find( *microDomain );
+                if ( domainSurfaceCount == microDomainSurfaceSplitCount->end( ) ){
 
-        integratedValues.clear( );
-        integratedValues.resize( 0 );
-        floatVector microRelativePosition( _dim );
+                    return new errorNode( __func__,
+                                          "The micro domain " + *microDomain + " was not found in the domain surface split count map" );
 
-        if ( dataCountAtPoint > 0 ){
+                }
 
-            index = 0;
-            floatVector dataAtMicroPoints( dataCountAtPoint * microDomainNodeIDs.size( ), 0 );
+                homogenizationTask task;
+                task.macroCellID = *macroCell;
+                task.elementIndex = elements.size( ) - 1;
+                task.microDomainName = *microDomain;
+                task.microDomainCenterOfMass = &domainCenterOfMass->second;
+                task.microDomainSurfaceDecompositionCount = domainSurfaceCount->second;
 
-            //Set the center of mass
-            floatVector centerOfMass = homogenizedCentersOfMass[ macroCellID ][ microDomainName ];
-    
-            for ( auto node = microDomainNodeIDs.begin( ); node != microDomainNodeIDs.end( ); node++, index++ ){
+                //Get the domain node ids
+                error = _inputProcessor.getMicroDomainNodes( microIncrement, *microDomain, task.microDomainNodeIDs );
 
-                auto microDensity = microDensities->find( *node );
-                if ( microDensity == microDensities->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) + " was not found in the micro density map" );
-                }
+                if ( error ){
 
-                auto microReferencePosition = microReferencePositions->find( *node );
-                if ( microReferencePosition == microReferencePositions->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) + " was not found in the micro reference position map" );
-                }
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in getting the node ids for the domain ( " + *microDomain + " )" );
+                    result->addNext( error );
+                    return result;
 
-                auto microDisplacement = microDisplacements->find( *node );
-                if ( microDisplacement == microDisplacements->end( ) ){
-                    return new errorNode( __func__,
-                                          "Micro node " + std::to_string( *node ) + " was not found in the micro displacement map" );
                 }
 
-                //Extract the micro relative position
-                microRelativePosition = microReferencePosition->second + microDisplacement->second - centerOfMass;
-
-                floatVector integrand
-                    = microDensity->second
-                    * vectorTools::appendVectors( vectorTools::dyadic( microRelativePosition, microRelativePosition ) );
+                //Each task gets its own copy of the configuration as the volume reconstruction modifies it
+                task.volumeReconstructionConfig = YAML::Clone( volumeReconstructionConfig );
 
-                //Add the contributions to the micro inertia
-                for ( unsigned int i = 0; i < _dim * _dim; i++ ){
+                tasks.push_back( task );
 
-                    dataAtMicroPoints[ dataCountAtPoint * index + i ]
-                        = integrand[ i ];
+            }
 
-                }
+        }
 
-                localIndex = initialOffset;
+        //Homogenize the micro domains
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "HOMOGENIZING THE MICRO DOMAINS\n";
+        std::vector< homogenizedDomainValues > taskValues;
+        error = homogenizeMicroDomains( microIncrement, tasks, elements, taskValues );
 
-                //Add the contributions to the micro body couple
-                if ( _inputProcessor.microBodyForceDefined( ) ){
+        if ( error ){
 
-                    auto microBodyForce = microBodyForces->find( *node );
-                    if ( microBodyForce == microBodyForces->end( ) ){
-                        return new errorNode( __func__,
-                                              "Micro node " + std::to_string( *node ) + " was not found in the micro body force map" );
-                    }
+            errorOut result = new errorNode( __func__,
+                                             "Error in the homogenization of the micro domains" );
+            result->addNext( error );
+            return result;
 
-                    floatVector integrand
-                        = microDensity->second
-                        * vectorTools::appendVectors( vectorTools::dyadic( microBodyForce->second, microRelativePosition ) );
-    
-                    for ( unsigned int i = 0; i < _dim * _dim; i++ ){
-    
-                        dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ]
-                            = integrand[ i ]; //Integrate the body force couple over the domain
-    
-                    }
-    
-                    localIndex += _dim * _dim;
-    
-                }
-    
-                //Add the contributions to the micro spin inertia
-                if ( _inputProcessor.microAccelerationDefined( ) ){
+        }
 
-                    auto microAcceleration = microAccelerations->find( *node );
-                    if ( microAcceleration == microAccelerations->end( ) ){
-                        return new errorNode( __func__,
-                                              "Micro node " + std::to_string( *node ) + " was not found in the micro acceleration map" );
-                    }
+        //Merge the homogenized values in the order the tasks were collected
+        for ( auto values = taskValues.begin( ); values != taskValues.end( ); values++ ){
 
-                    floatVector microRelativeAcceleration = microAcceleration->second
-                                                          - homogenizedAccelerations[ macroCellID ][ microDomainName ];
+            mergeHomogenizedDomainValues( *values );
 
-                    floatVector integrand
-                        = microDensity->second
-                        * vectorTools::appendVectors( vectorTools::dyadic( microRelativeAcceleration, microRelativePosition ) );
-    
-                    for ( unsigned int i = 0; i < _dim * _dim; i++ ){
-    
-                        dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ]
-                            = integrand[ i ]; //Integrate the accelerations of the domain
-    
-                    }
-    
-                    localIndex += _dim * _dim;
-    
-                }
+        }
 
-            }
+        //Compute the approximate stresses
+        for ( auto macroCell = homogenizedCells.begin( ); macroCell != homogenizedCells.end( ); macroCell++ ){
 
-            error = reconstructedVolume->performVolumeIntegration( dataAtMicroPoints, dataCountAtPoint, integratedValues );
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "COMPUTING THE HOMOGENIZED STRESSES\n";
+            error = computeHomogenizedStresses( *macroCell );
 
             if ( error ){
 
                 errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the relative position volume integrals" );
+                                                 "Error in the computation of the homogenized stresses" );
                 result->addNext( error );
                 return result;
 
@@ -5672,1537 +5967,1566 @@ namespace overlapCoupling{
 
         }
 
-        if ( !_inputProcessor.microBodyForceDefined( ) ){
+        //Compute the homogenized force vectors and mass matrices
+        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
 
-            integratedValues = vectorTools::appendVectors( { floatVector( integratedValues.begin( ),
-                                                                          integratedValues.begin( ) + initialOffset ),
-                                                             floatVector( _dim * _dim, 0 ),
-                                                             floatVector( integratedValues.begin( ) + initialOffset,
-                                                                          integratedValues.end( ) ) } );
+        if ( config[ "projection_type" ].as< std::string >( ).compare( "arlequin" ) != 0 ){
 
-        }
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "ASSEMBLE HOMOGENIZED MATRICES AND VECTORS\n";
+            error = assembleHomogenizedMatricesAndVectors( );
 
-        if ( !_inputProcessor.microAccelerationDefined( ) ){
+            if ( error ){
 
-            integratedValues = vectorTools::appendVectors( { integratedValues, floatVector( _dim * _dim, 0 ) } );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the computation of the homogenized forces and mass matrix" );
+                result->addNext( error );
+                return result;
+
+            }
 
         }
 
-        floatType domainMass = homogenizedDensities[ macroCellID ][ microDomainName ]
-                             * homogenizedVolumes[ macroCellID ][ microDomainName ];
-        homogenizedMicroInertias[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ),
-                                                                                       integratedValues.begin( ) + initialOffset ) / domainMass );
-        homogenizedBodyForceCouples[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset,
-                                                                                          integratedValues.begin( ) + initialOffset + _dim * _dim ) / domainMass );
-        homogenizedMicroSpinInertias[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset + _dim * _dim,
-                                                                                           integratedValues.begin( ) + initialOffset + 2 * _dim * _dim ) / domainMass );
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "MICROSCALE HOMOGENIZATION COMPLETED\n";
 
         return NULL;
-
     }
 
-    errorOut overlapCoupling::computeDomainSurfaceAverages( const uIntType &macroCellID, const std::string &microDomainName,
-                                                            const uIntVector &microDomainNodeIDs,
-                                                            const uIntType &microDomainSurfaceDecompositionCount,
-                                                            std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume,
-                                                            std::unique_ptr< elib::Element > &element ){
+    errorOut overlapCoupling::homogenizeMicroDomains( const unsigned int &microIncrement, const std::vector< homogenizationTask > &tasks,
+                                                      const std::vector< std::unique_ptr< elib::Element > > &elements,
+                                                      std::vector< homogenizedDomainValues > &taskValues ){
         /*!
-         * Compute the required surface averages over the micro-domain.
+         * Homogenize a collection of micro domains. The tasks are distributed over the number of threads
+         * defined by 'homogenization_thread_count' in the coupling initialization. Each task writes to its
+         * own storage so the homogenized values do not depend on the number of threads. The log messages
+         * of each task are buffered and written in the order of the tasks once all of the threads are joined.
          *
-         * :param const uIntType &macroCellID: The ID of the macro-cell associated with the micro domain.
-         * :param const std::string &microDomainName: The name of the micro domain
-         * :param const std::string &microDomainNodeIDs: The IDs of the nodes in the micro-domain to have the surface averages
-         *     computed over.
-         * :param const uIntType &microDomainSurfaceDecompositionCount: The approximate number of regions to split the surface
-         *     of the micro surface into.
-         * :param volumeReconstruction::volumeReconstructionBase &reconstructedVolume: The reconstructed volume
-         *     ready to have surface integrals computed over.
-         * :param std::unique_ptr< elib::Element > &element: The enclosing macro element
+         * :param const unsigned int &microIncrement: The increment at the micro-scale to homogenize
+         * :param const std::vector< homogenizationTask > &tasks: The micro domains to be homogenized
+         * :param const std::vector< std::unique_ptr< elib::Element > > &elements: The macro elements referenced
+         *     by the tasks
+         * :param std::vector< homogenizedDomainValues > &taskValues: The homogenized values of each of the tasks
          */
 
-        //Get the volume reconstruction configuration
-        YAML::Node volumeReconstructionConfig = _inputProcessor.getVolumeReconstructionConfig( );
+        taskValues.clear( );
+        taskValues.resize( tasks.size( ) );
 
-        //Extract the required micro-scale values
-        const std::unordered_map< uIntType, floatType > *microDensities = _inputProcessor.getMicroDensities( );
-        const std::unordered_map< uIntType, floatVector > *microDisplacements = _inputProcessor.getMicroDisplacements( );
-        const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
-        const std::unordered_map< uIntType, floatVector > *microStresses = _inputProcessor.getMicroStresses( );
+        std::vector< std::unique_ptr< errorNode > > taskErrors( tasks.size( ) );
+        stringVector taskMessages( tasks.size( ) );
 
-        /*=====================================================================
-        |           Compute the reconstructed domain's surface area           |
-        =====================================================================*/
+        inputFileProcessor::couplingLogger &logger = _inputProcessor.getLogger( );
 
-        uIntType dataCountAtPoint = 1; //Total surface area
+        std::atomic< uIntType > nextTask( 0 );
+        std::atomic< bool > stop( false );
 
-        floatVector dataAtMicroPoints( microDomainNodeIDs.size( ), 1 );
+        auto processTasks = [ & ]( ){
 
-        floatVector integratedValue;
+            for ( uIntType index = nextTask++; ( index < tasks.size( ) ) && !stop; index = nextTask++ ){
 
-        errorOut error = reconstructedVolume->performSurfaceIntegration( dataAtMicroPoints, 1, integratedValue );
+                logger.bufferThreadMessages( );
 
-        if ( error ){
+                try{
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the computation of the domain's surface area" );
-            result->addNext( error );
-            return result;
+                    taskErrors[ index ].reset( homogenizeMicroDomain( microIncrement, tasks[ index ],
+                                                                      elements[ tasks[ index ].elementIndex ],
+                                                                      taskValues[ index ] ) );
 
-        }
+                }
+                catch( std::exception &e ){
 
-        if ( homogenizedSurfaceAreas.find( macroCellID ) == homogenizedSurfaceAreas.end( ) ){
+                    taskErrors[ index ].reset( new errorNode( "homogenizeMicroDomains", e.what( ) ) );
 
-            domainFloatMap tmpFloatMap;
-            domainFloatVectorMap tmpFloatVectorMap;
-            homogenizedSurfaceAreas.emplace( macroCellID, tmpFloatMap );
-            homogenizedSurfaceRegionAreas.emplace( macroCellID, tmpFloatVectorMap );
-            homogenizedSurfaceRegionCentersOfMass.emplace( macroCellID, tmpFloatVectorMap );
-            homogenizedSurfaceRegionProjectedLocalCentersOfMass.emplace( macroCellID, tmpFloatVectorMap );
-            homogenizedSurfaceRegionProjectedCentersOfMass.emplace( macroCellID, tmpFloatVectorMap );
-            homogenizedSurfaceRegionTractions.emplace( macroCellID, tmpFloatVectorMap );
-            homogenizedSurfaceRegionCouples.emplace( macroCellID, tmpFloatVectorMap );
+                }
 
-        }
+                taskMessages[ index ] = logger.releaseThreadMessages( );
 
-        homogenizedSurfaceAreas[ macroCellID ].emplace( microDomainName, integratedValue[ 0 ] );
+                if ( taskErrors[ index ] ){
 
-        /*=====================================================================
-        |           Compute the properties of the surface subdomains          |
-        =====================================================================*/
+                    stop = true;
 
-        //Get the boundary points from the reconstructed domain
-        const floatVector *boundaryPoints = reconstructedVolume->getBoundaryPoints( );
+                }
 
-        //Determine which element surface each point belongs to ( if any )
-        floatType tol = volumeReconstructionConfig[ "element_contain_tolerance" ].as< floatType >( );
-        bool useMacroNormals = volumeReconstructionConfig[ "use_macro_normals" ].as< bool >( );
+            }
 
-        uIntVector surf;
-        uIntVector tmp( 0 );
-        floatVector ftmp( 0 );
-        uIntMatrix subdomainNodeIDs( element->local_surface_points.size( ), tmp );
-        floatMatrix subdomainNodeNormals( element->local_surface_points.size( ), ftmp );
+        };
 
-        auto sIndex = 0;
-        for ( auto s = subdomainNodeIDs.begin( ); s != subdomainNodeIDs.end( ); s++, sIndex++ ){
+        uIntType threadCount = std::min( _inputProcessor.getHomogenizationThreadCount( ), ( uIntType )tasks.size( ) );
 
-            ( *s ).reserve( boundaryPoints->size( ) / ( _dim * subdomainNodeIDs.size( ) ) );
-            subdomainNodeNormals[ sIndex ].reserve( boundaryPoints->size( ) / subdomainNodeIDs.size( ) );
+        if ( threadCount > 1 ){
 
-        }
+            std::vector< std::thread > threads;
+            threads.reserve( threadCount - 1 );
 
-        for ( uIntType bpIndex = 0; bpIndex != ( boundaryPoints->size( ) / _dim ); bpIndex++ ){
+            for ( uIntType i = 1; i < threadCount; i++ ){
 
-            floatVector p( boundaryPoints->begin( ) + _dim * bpIndex,
-                           boundaryPoints->begin( ) + _dim * ( bpIndex + 1 ) );
+                threads.push_back( std::thread( processTasks ) );
 
-            floatVector xi;
+            }
 
-            //Compute the local coordinates of the point
-            std::unique_ptr< errorNode > tmpError;
-            tmpError.reset( element->compute_local_coordinates( p, xi ) );
+            processTasks( );
 
-            if ( tmpError ){
+            for ( auto thread = threads.begin( ); thread != threads.end( ); thread++ ){
 
-                continue;
+                thread->join( );
 
             }
 
-            //Determine if the point is on any of the element's surfaces
-            if ( element->local_point_on_surface( xi, surf, tol ) ){
+        }
+        else{
 
-                for ( auto s = surf.begin( ); s != surf.end( ); s++ ){
+            processTasks( );
 
-                    subdomainNodeIDs[ *s ].push_back( bpIndex );
+        }
 
-                    floatVector n;
+        for ( auto messages = taskMessages.begin( ); messages != taskMessages.end( ); messages++ ){
 
-                    floatMatrix dxdxi;
+            if ( !messages->empty( ) ){
 
-                    floatVector dxidx;
+                logger.getStream( ) << *messages;
 
-                    element->get_local_gradient( element->nodes, xi, dxdxi );
+            }
 
-                    dxidx = vectorTools::inverse( vectorTools::appendVectors( dxdxi ), _dim, _dim );
+        }
 
-                    n = vectorTools::matrixMultiply( dxidx, element->local_surface_normals[ *s ], _dim, _dim, _dim, 1, true, false );
+        //Report the first error encountered in the order of the tasks
+        for ( uIntType index = 0; index < tasks.size( ); index++ ){
 
-                    n /= vectorTools::l2norm( n );
+            if ( taskErrors[ index ] ){
 
-                    for ( uIntType i = 0; i < _dim; i++ ){
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the homogenization of the micro domain " + tasks[ index ].microDomainName );
+                result->addNext( taskErrors[ index ].release( ) );
+                return result;
 
-                        subdomainNodeNormals[ *s ].push_back( n[ i ] );
+            }
 
-                    }
+        }
 
-                }
+        return NULL;
 
-            }
+    }
 
-        }
+    errorOut overlapCoupling::homogenizeMicroDomain( const unsigned int &microIncrement, const homogenizationTask &task,
+                                                     const std::unique_ptr< elib::Element > &element,
+                                                     homogenizedDomainValues &values ){
+        /*!
+         * Homogenize a single micro domain. Only the task's data and the read-only values of the input
+         * processor are accessed so this may be called concurrently for different tasks.
+         *
+         * :param const unsigned int &microIncrement: The increment at the micro-scale to homogenize
+         * :param const homogenizationTask &task: The micro domain to be homogenized
+         * :param const std::unique_ptr< elib::Element > &element: The macro-scale element that contains the domain
+         * :param homogenizedDomainValues &values: The storage for the homogenized values of the micro domain
+         */
 
-        uIntVector macroSurfaces;
-        for ( uIntType i = 0; i < subdomainNodeIDs.size( ); i++ ){
+        uIntVector microDomainNodeIds = task.microDomainNodeIDs;
+        floatVector microNodePositions;
+        YAML::Node volumeReconstructionConfig = task.volumeReconstructionConfig;
+        std::shared_ptr< volumeReconstruction::volumeReconstructionBase > reconstructedVolume;
 
-            if ( subdomainNodeIDs[ i ].size( ) > 0 ){
+        //Reconstruct the micro-domain's volume
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  RECONSTRUCTING THE DOMAIN\n";
+        errorOut error = reconstructDomain( microIncrement, task.microDomainName, volumeReconstructionConfig,
+                                            microDomainNodeIds, microNodePositions, element, reconstructedVolume );
 
-                macroSurfaces.push_back( i );
+        if ( error ){
 
-            }
+            errorOut result = new errorNode( __func__,
+                                             "Error in the reconstruction of the microscale domain" );
+            result->addNext( error );
+            return result;
 
         }
 
-        cellDomainMacroSurfaces[ macroCellID ].emplace( microDomainName, macroSurfaces );
+        //Compute the volume averages
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  COMPUTING THE VOLUME AVERAGES\n";
+        error = computeDomainVolumeAverages( task.macroCellID, task.microDomainName, microDomainNodeIds,
+                                             reconstructedVolume, values, task.microDomainCenterOfMass );
 
-        //Get the centers of mass of the surface regions
+        if ( error ){
 
-        dataCountAtPoint = 1     //Surface area of region
-                         + 1;    //Mass of region
-//                         + _dim; //Micro point position
+            errorOut result = new errorNode( __func__,
+                                             "Error in the computation of the volume averages of the microscale domain" );
+            result->addNext( error );
+            return result;
 
-        dataAtMicroPoints.clear( );
-        dataAtMicroPoints.reserve( dataCountAtPoint * microDomainNodeIDs.size( ) );
+        }
 
-        for ( auto node = microDomainNodeIDs.begin( ); node != microDomainNodeIDs.end( ); node++ ){
+        //Compute the surface averages
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  COMPUTING THE SURFACE AVERAGES\n";
+        error = computeDomainSurfaceAverages( task.macroCellID, task.microDomainName, microDomainNodeIds,
+                                              task.microDomainSurfaceDecompositionCount,
+                                              reconstructedVolume, element, volumeReconstructionConfig, values );
 
-            auto microDensity = microDensities->find( *node );
-            if ( microDensity == microDensities->end( ) ){
-                return new errorNode( __func__,
-                                      "The micro node " + std::to_string( *node ) + " was not found in the micro density map" );
-            }
+        if ( error ){
 
-            dataAtMicroPoints.push_back( 1 );
-            dataAtMicroPoints.push_back( microDensity->second );
+            errorOut result = new errorNode( __func__,
+                                             "Error in the computation of the surface averages of the microscale domain" );
+            result->addNext( error );
+            return result;
 
-            auto microReferencePosition = microReferencePositions->find( *node );
-            if ( microReferencePosition == microReferencePositions->end( ) ){
-                return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *node ) + " was not found in the micro reference position map" );
-            }
+        }
 
-//            auto microDisplacement = microDisplacements->find( *node );
-//            if ( microDisplacement == microDisplacements->end( ) ){
-//                return new errorNode( __func__,
-//                                      "Micro node " + std::to_string( *node ) + " was not found in the micro displacement map" );
-//            }
-//
-//            floatVector microPoint = microReferencePosition->second + microDisplacement->second;
-//
-//            for ( unsigned int i = 0; i < microPoint.size( ); i++ ){
-//
-//                dataAtMicroPoints.push_back( microDensity->second * microPoint[ i ] );
-//
-//            }
+        return NULL;
 
-        }
+    }
 
-        //Initialize storage values for homogenization
-        homogenizedSurfaceRegionAreas[ macroCellID ].emplace( microDomainName, floatVector( subdomainNodeIDs.size( ), 0 ) );
-        floatVector regionDensities( subdomainNodeIDs.size( ) );
-        homogenizedSurfaceRegionCentersOfMass[ macroCellID ].emplace( microDomainName, floatVector( _dim * subdomainNodeIDs.size( ), 0 ) );
-        homogenizedSurfaceRegionProjectedLocalCentersOfMass[ macroCellID ].emplace( microDomainName, floatVector( _dim * subdomainNodeIDs.size( ), 0 ) );
-        homogenizedSurfaceRegionProjectedCentersOfMass[ macroCellID ].emplace( microDomainName, floatVector( _dim * subdomainNodeIDs.size( ), 0 ) );
+    template< typename T >
+    void mergeCellDomainMap( std::unordered_map< uIntType, T > &source, std::unordered_map< uIntType, T > &target ){
+        /*!
+         * Move the domain values of a cell-domain map into another cell-domain map
+         *
+         * :param std::unordered_map< uIntType, T > &source: The map to move the values from
+         * :param std::unordered_map< uIntType, T > &target: The map to move the values to
+         */
 
-        //Initialize the homogenized values
-        homogenizedSurfaceRegionTractions[ macroCellID ].emplace( microDomainName, floatVector( _dim * subdomainNodeIDs.size( ), 0 ) );
-        homogenizedSurfaceRegionCouples[ macroCellID ].emplace( microDomainName, floatVector( _dim * _dim * subdomainNodeIDs.size( ), 0 ) );
+        for ( auto cell = source.begin( ); cell != source.end( ); cell++ ){
 
-        uIntType index = 0;
-        for ( auto sN = subdomainNodeIDs.begin( ); sN != subdomainNodeIDs.end( ); sN++, index++ ){
+            T &targetCell = target[ cell->first ];
 
-            if ( ( *sN ).size( ) > 0 ){
+            for ( auto domain = cell->second.begin( ); domain != cell->second.end( ); domain++ ){
 
-                // Perform the surface integration
-                uIntVector *nodesOnSurface = &( *sN );
-                error = reconstructedVolume->performSurfaceIntegration( dataAtMicroPoints, dataCountAtPoint,
-                                                                        integratedValue, nodesOnSurface,
-                                                                        NULL,
-                                                                        &subdomainNodeNormals[ index ],
-                                                                        useMacroNormals );
-    
-                if ( error ){
-    
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the integration of the macro surface ( "
-                                                     + std::to_string( sN - subdomainNodeIDs.begin( ) ) + " )" );
-                    result->addNext( error );
-                    return result;
-    
-                }
+                targetCell.emplace( domain->first, std::move( domain->second ) );
 
-                // Extract the region surface areas and the region surface densities
-                homogenizedSurfaceRegionAreas[ macroCellID ][ microDomainName ][ index ] = integratedValue[ 0 ];
-                regionDensities[ index ] = integratedValue[ 1 ] / integratedValue[ 0 ];
+            }
 
-                // Perform the position weighted surface integration
-                error = reconstructedVolume->performPositionWeightedSurfaceIntegration( dataAtMicroPoints, dataCountAtPoint,
-                                                                                        integratedValue, nodesOnSurface,
-                                                                                        NULL,
-                                                                                        &subdomainNodeNormals[ index ],
-                                                                                        useMacroNormals );
+        }
 
-                if ( error ){
-    
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the integration of the position weighted macro surface ( "
-                                                     + std::to_string( sN - subdomainNodeIDs.begin( ) ) + " )" );
-                    result->addNext( error );
-                    return result;
-    
-                }
+        source.clear( );
 
-                floatVector centerOfMass( integratedValue.begin( ) + _dim,
-                                          integratedValue.begin( ) + 2 * _dim );
-                centerOfMass /= ( homogenizedSurfaceRegionAreas[ macroCellID ][ microDomainName ][ index ] * regionDensities[ index ] );
+    }
 
-                for ( uIntType i = 0; i < _dim; i++ ){
+    void overlapCoupling::mergeHomogenizedDomainValues( homogenizedDomainValues &values ){
+        /*!
+         * Move the homogenized values of a collection of micro domains into the homogenized values
+         * of the overlap coupling object.
+         *
+         * :param homogenizedDomainValues &values: The homogenized values to be merged. These are
+         *     emptied by the merge.
+         */
+
+        mergeCellDomainMap( values.homogenizedVolumes, homogenizedVolumes );
+        mergeCellDomainMap( values.homogenizedSurfaceAreas, homogenizedSurfaceAreas );
+        mergeCellDomainMap( values.homogenizedDensities, homogenizedDensities );
+        mergeCellDomainMap( values.homogenizedMicroInertias, homogenizedMicroInertias );
+        mergeCellDomainMap( values.homogenizedCentersOfMass, homogenizedCentersOfMass );
+        mergeCellDomainMap( values.homogenizedBodyForces, homogenizedBodyForces );
+        mergeCellDomainMap( values.homogenizedBodyForceCouples, homogenizedBodyForceCouples );
+        mergeCellDomainMap( values.homogenizedAccelerations, homogenizedAccelerations );
+        mergeCellDomainMap( values.homogenizedMicroSpinInertias, homogenizedMicroSpinInertias );
+        mergeCellDomainMap( values.homogenizedSymmetricMicroStresses, homogenizedSymmetricMicroStresses );
+        mergeCellDomainMap( values.homogenizedSurfaceRegionAreas, homogenizedSurfaceRegionAreas );
+        mergeCellDomainMap( values.homogenizedSurfaceRegionCentersOfMass, homogenizedSurfaceRegionCentersOfMass );
+        mergeCellDomainMap( values.homogenizedSurfaceRegionProjectedLocalCentersOfMass, homogenizedSurfaceRegionProjectedLocalCentersOfMass );
+        mergeCellDomainMap( values.homogenizedSurfaceRegionProjectedCentersOfMass, homogenizedSurfaceRegionProjectedCentersOfMass );
+        mergeCellDomainMap( values.homogenizedSurfaceRegionTractions, homogenizedSurfaceRegionTractions );
+        mergeCellDomainMap( values.homogenizedSurfaceRegionCouples, homogenizedSurfaceRegionCouples );
+        mergeCellDomainMap( values.cellDomainMacroSurfaces, cellDomainMacroSurfaces );
 
-                    homogenizedSurfaceRegionCentersOfMass[ macroCellID ][ microDomainName ][ index * _dim + i ] = centerOfMass[ i ];
+    }
 
-                }
+    errorOut overlapCoupling::reconstructDomain( const unsigned int &microIncrement, const std::string &microDomainName,
+                                                 uIntVector &microDomainNodes, floatVector &microNodePositions,
+                                                 const std::unique_ptr< elib::Element > &element,
+                                                 std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume ){
+        /*!
+         * Reconstruct the micro-domain's volume to perform volume and surface integrals over that
+         * domain.
+         *
+         * :param const unsigned int &microIncrement: The increment at which to extract the micro-positions
+         * :param const std::string &microDomainName: The name of the micro-domain to be re-constructed.
+         * :param uIntVector &microDomainNodes: The nodes associated with the micro domain
+         * :param floatVector &microNodePositions: The positions of the micro nodes for the current domain
+         * :param const std::unique_ptr< elib::element > &element: The macro-scale element that contains the domain.
+         * :param std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume: The reconstructed
+         *     volume ready for additional processing.
+         */
 
-                //Compute the local coordinates of the center of mass
-                floatVector localCenterOfMass; 
-                error = element->compute_local_coordinates( centerOfMass, localCenterOfMass );
+        //Get the volume reconstruction configuration
+        YAML::Node volumeReconstructionConfig = _inputProcessor.getVolumeReconstructionConfig( );
 
-                if ( error ){
+        //Get the domain node ids
+        errorOut error = _inputProcessor.getMicroDomainNodes( microIncrement, microDomainName, microDomainNodes );
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the computation of the local surface center of mass" );
-                    result->addNext( error );
-                    return result;
+        if ( error ){
 
-                }
+            errorOut result = new errorNode( __func__,
+                                             "Error in getting the node ids for the domain ( " + microDomainName + " )" );
+            result->addNext( error );
+            return result;
 
-                //Find the closest point on the surface of the element in local coordinates
-                floatType distance = vectorTools::dot( element->local_surface_normals[ index ],
-                                                       localCenterOfMass - element->local_surface_points[ index ] );
+        }
 
-                floatVector projectedLocalCenterOfMass = localCenterOfMass - distance * element->local_surface_normals[ index ];
+        return reconstructDomain( microIncrement, microDomainName, volumeReconstructionConfig, microDomainNodes, microNodePositions,
+                                  element, reconstructedVolume );
 
-                for ( unsigned int i = 0; i < _dim; i++ ){
-                    homogenizedSurfaceRegionProjectedLocalCentersOfMass[ macroCellID ][ microDomainName ][ index * _dim + i ]
-                        = projectedLocalCenterOfMass[ i ];
-                }
+    }
 
-                //Interpolate this point back to global coordinates
-                floatVector projectedCenterOfMass;
-                error = element->interpolate( element->nodes, projectedLocalCenterOfMass, projectedCenterOfMass );
+    errorOut overlapCoupling::reconstructDomain( const unsigned int &microIncrement, const std::string &microDomainName,
+                                                 YAML::Node &volumeReconstructionConfig,
+                                                 uIntVector &microDomainNodes, floatVector &microNodePositions,
+                                                 const std::unique_ptr< elib::Element > &element,
+                                                 std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume ){
+        /*!
+         * Reconstruct the micro-domain's volume to perform volume and surface integrals over that
+         * domain using previously extracted domain node ids.
+         *
+         * :param const unsigned int &microIncrement: The increment at which to extract the micro-positions
+         * :param const std::string &microDomainName: The name of the micro-domain to be re-constructed.
+         * :param YAML::Node &volumeReconstructionConfig: The configuration of the volume reconstruction
+         * :param uIntVector &microDomainNodes: The nodes associated with the micro domain. These are reduced to
+         *     the nodes located inside of the macro-scale element.
+         * :param floatVector &microNodePositions: The positions of the micro nodes for the current domain
+         * :param const std::unique_ptr< elib::element > &element: The macro-scale element that contains the domain.
+         * :param std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume: The reconstructed
+         *     volume ready for additional processing.
+         */
 
-                if ( error ){
+        errorOut error = NULL;
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the interpolation of the local projected surface center of mass to global coordinates" );
-                    result->addNext( error );
-                    return result;
+        //Get the micro-node positions
+        microNodePositions.clear( );
+        microNodePositions.reserve( _dim * microDomainNodes.size( ) );
+ 
+        unsigned int index = 0;
+        const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
+        const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+        const floatType elementContainTolerance = volumeReconstructionConfig[ "element_contain_tolerance" ].as< floatType >( );
+        uIntVector interiorNodes;
+        floatVector cp( _dim );
+ 
+        for ( auto it = microDomainNodes.begin( ); it != microDomainNodes.end( ); it++, index++ ){
 
-                }
+            auto microReferencePosition = microReferencePositions->find( *it );
 
-                for ( unsigned int i = 0; i < _dim; i++ ){
-                    homogenizedSurfaceRegionProjectedCentersOfMass[ macroCellID ][ microDomainName ][ index * _dim + i ]
-                        = projectedCenterOfMass[ i ];
-                }
+            if ( microReferencePosition == microReferencePositions->end( ) ){
+
+                return new errorNode( __func__, "Micro node " + std::to_string( *it ) +
+                                      " was not found in the micro reference position map" );
 
             }
 
-        }
+            const floatType *microDisplacement;
+            uIntType stride;
+            error = microNodeFields->getNodeValues( "displacement", *it, microDisplacement, stride );
 
-        /*===================================================================================
-        | Compute the surface tractions and couples over the micro domain's surface regions |
-        ===================================================================================*/
+            if ( error ){
 
-        dataCountAtPoint = _dim * _dim;
+                errorOut result = new errorNode( __func__, "Micro node " + std::to_string( *it ) +
+                                                 " was not found in the micro displacement field" );
+                result->addNext( error );
+                return result;
 
-        dataAtMicroPoints.clear( );
-        dataAtMicroPoints.reserve( dataCountAtPoint * microDomainNodeIDs.size( ) );
+            }
 
-        for ( auto node = microDomainNodeIDs.begin( ); node != microDomainNodeIDs.end( ); node++ ){
+            //Check that the given micro-node is located inside of the macro-scale element.
+            //If not, we will ignore the micro node
+            for ( unsigned int i = 0; i < _dim; i++ ){
+
+                cp[ i ] = microReferencePosition->second[ i ] + microDisplacement[ i ];
 
-            auto microStress = microStresses->find( *node );
-            if ( microStress == microStresses->end( ) ){
-                return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *node ) + " was not found in the micro stress map" );
             }
 
-            for ( unsigned int i = 0; i < _dim * _dim; i++ ){
+            if ( element->contains_point( cp, elementContainTolerance ) ){
+            
+                interiorNodes.push_back( *it );
 
-                dataAtMicroPoints.push_back( microStress->second[ i ] );
+                microNodePositions.insert( microNodePositions.end( ), cp.begin( ), cp.end( ) );
 
             }
-
+ 
         }
 
-        index = 0;
-        for ( auto sN = subdomainNodeIDs.begin( ); sN != subdomainNodeIDs.end( ); sN++, index++ ){
-
-            if ( ( *sN ).size( ) > 0 ){
-
-                //Compute the tractions
-                uIntVector *nodesOnSurface = &( *sN );
+        //Reset micro domain nodes
+        microDomainNodes = interiorNodes;
 
-                error = reconstructedVolume->performSurfaceFluxIntegration( dataAtMicroPoints, dataCountAtPoint,
-                                                                            integratedValue, nodesOnSurface,
-                                                                            NULL,
-                                                                            &subdomainNodeNormals[ index ], useMacroNormals );
+        //Pass the base name of the output file to the volume reconstruction configuration to be used if output has been requested
+        volumeReconstructionConfig[ "baseOutputFilename" ] = microDomainName + "_" + std::to_string( microIncrement );
 
-                if ( error ){
-    
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the computation of the surface traction of the the macro surface ( "
-                                                     + std::to_string( sN - subdomainNodeIDs.begin( ) ) + " )" );
-                    result->addNext( error );
-                    return result;
-    
-                }
+        //Get the volume reconstruction object
+        reconstructedVolume
+            = volumeReconstruction::volumeReconstructionBase( volumeReconstructionConfig ).create( );
 
-                for ( uIntType i = 0; i < _dim; i++ ){
-                    homogenizedSurfaceRegionTractions[ macroCellID ][ microDomainName ][ _dim * index + i ]
-                        = integratedValue[ i ] / homogenizedSurfaceRegionAreas[ macroCellID ][ microDomainName ][ index ];
-                }
+        if ( reconstructedVolume->getError( ) ){
 
-                //Compute the couples
-                floatVector regionCenterOfMass( homogenizedSurfaceRegionCentersOfMass[ macroCellID ][ microDomainName ].begin( ) + _dim * index,
-                                                homogenizedSurfaceRegionCentersOfMass[ macroCellID ][ microDomainName ].begin( ) + _dim * ( index + 1 ) );
+            errorOut result = new errorNode( __func__,
+                                             "Error in creating the volume reconstruction object for " + microDomainName );
 
-                error = reconstructedVolume->performRelativePositionSurfaceFluxIntegration( dataAtMicroPoints, dataCountAtPoint,
-                                                                                            regionCenterOfMass, integratedValue,
-                                                                                            nodesOnSurface,
-                                                                                            NULL,
-                                                                                            &subdomainNodeNormals[ index ], useMacroNormals );
-    
-                if ( error ){
-    
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the computation of the surface couple of the micro region ( "
-                                                     + std::to_string( sN - subdomainNodeIDs.begin( ) ) + " )" );
-                    result->addNext( error );
-                    return result;
-    
-                }
-    
-    //            integratedValue /= regionSurfaceArea;
-    //
-    //            homogenizedSurfaceRegionCouples[ macroCellID ]
-    //                = vectorTools::appendVectors( { homogenizedSurfaceRegionCouples[ macroCellID ],
-    //                                                integratedValue } );
-                for ( uIntType i = 0; i < _dim * _dim; i++ ){
-    
-                    homogenizedSurfaceRegionCouples[ macroCellID ][ microDomainName ][ _dim * _dim * index + i ]
-                        = integratedValue[ i ] / homogenizedSurfaceRegionAreas[ macroCellID ][ microDomainName ][ index ];
-    
-                }
+            result->addNext( reconstructedVolume->getError( ) );
 
-            }
+            return result;
 
         }
 
-        return NULL;
-    }
-
-    errorOut overlapCoupling::computeHomogenizedStresses( const uIntType &macroCellID ){
-        /*!
-         * Compute the homogenized stresses for the macro cell
-         *
-         * :param const uIntType &macroCellID: The ID of the macro cell to have the 
-         *     homogenized stresses computed at the quadrature points.
-         */
-
-        //Get the pointers to the values
-        const std::unordered_map< uIntType, floatVector > *macroNodeReferenceLocations
-            = _inputProcessor.getMacroNodeReferencePositions( );
-        const std::unordered_map< uIntType, floatVector > *macroDisplacements
-            = _inputProcessor.getMacroDisplacements( );
-        const std::unordered_map< uIntType, uIntVector > *macroConnectivity
-            = _inputProcessor.getMacroNodeReferenceConnectivity( );
-
-        //Form the finite element representation of the macro-scale
-        std::unique_ptr< elib::Element > element;
-        errorOut error;
-
-        std::unordered_map< uIntType, floatVector > projectedMacroDisplacements;
-    
-        if ( _inputProcessor.isFiltering( ) ){
-    
-            auto cellConnectivity = macroConnectivity->find( macroCellID );
-    
-            if ( cellConnectivity == macroConnectivity->end( ) ){
-    
-                return new errorNode( __func__, "Macro cell " + std::to_string( macroCellID ) + " not found in connectivity map" );
-    
-            }
-
-            auto macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
-
-            unsigned int nMacroFreeNodes = _inputProcessor.getFreeMacroNodeIds( )->size( ); // I anticipate this should always be zero
-
-            unsigned int nMacroDOF = _dim + _dim * _dim;
-
-            for ( auto node = cellConnectivity->second.begin( ) + 1; node != cellConnectivity->second.end( ); node++ ){
-
-                auto local_node = macroGlobalToLocalDOFMap->find( *node );
-
-                if ( local_node == macroGlobalToLocalDOFMap->end( ) ){
-
-                    return new errorNode( __func__, "Micro node " + std::to_string( *node) + " not found in the global to local map" );
+        //Load the micro points
+        error = reconstructedVolume->loadPoints( &microNodePositions );
 
-                }
+        if ( error ){
 
-                projectedMacroDisplacements.emplace( *node, floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second,
-                                                                         _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second + 3 ) );
+            errorOut result = new errorNode( __func__,
+                                             "Error in loading the micro-scale points for " + microDomainName );
+            result->addNext( error );
 
-            }
+            return result;
 
-            //Build the macro element
-            error = overlapCoupling::buildMacroDomainElement( macroCellID, *macroNodeReferenceLocations,
-                                                              projectedMacroDisplacements, *macroConnectivity,
-                                                              element );
- 
         }
-        else{
-    
-            //Build the macro element
-            error = overlapCoupling::buildMacroDomainElement(  macroCellID, *macroNodeReferenceLocations,
-                                                              *macroDisplacements, *macroConnectivity,
-                                                              element );
 
-        }
+        //Add the filter's domain
+        error = reconstructedVolume->reconstructInLocalDomain( element );
+
+        //Reconstruct the volume
+        error = reconstructedVolume->evaluate( );
 
         if ( error ){
 
             errorOut result = new errorNode( __func__,
-                                             "Error in the formation of the finite element representation of the macro-scale" );
+                                             "Error in loading the micro-scale points for " + microDomainName );
             result->addNext( error );
             return result;
 
         }
 
-        //Get the shape functions at the micro-domain centroids
-        std::unordered_map< uIntType, floatVector > centerOfMassMap;
-        stringVector domainNames;
-        centerOfMassMap.reserve( homogenizedCentersOfMass[ macroCellID ].size( ) );
-
-        uIntType index = 0;
-        for ( auto name  = homogenizedCentersOfMass[ macroCellID ].begin( );
-                   name != homogenizedCentersOfMass[ macroCellID ].end( ); name++, index++ ){
-
-            domainNames.push_back( name->first );
-            centerOfMassMap.emplace( index, name->second );
-
-        }
-        
+        return NULL;
 
-        std::unordered_map< uIntType, floatVector > shapefunctionsAtCentersOfMassByID;
+    }
 
-        uIntVector macroNodes;
+    errorOut overlapCoupling::computeDomainVolumeAverages( const uIntType &macroCellID, const std::string &microDomainName,
+                                                           const uIntVector &microDomainNodeIDs,
+                                                           std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume,
+                                                           homogenizedDomainValues &values,
+                                                           const floatVector *microDomainCenterOfMass ){
+        /*!
+         * Compute the required volume averages over the micro-domain.
+         *
+         * :param const uIntType &macroCellID: The ID number of the macro-cell associated with the micro domain.
+         * :param const std::string &microDomainName: The name of the micro domain
+         * :param const uIntVector &microDomainNodeIDs: The micro domain's node ids
+         * :param volumeReconstruction::volumeReconstructionBase &reconstructedVolume: The reconstructed volume
+         *     ready to have volume integrals computed over.
+         * :param homogenizedDomainValues &values: The storage for the homogenized values of the micro domain
+         * :param const floatVector *microDomainCenterOfMass: The center of mass for the micro-domain computed
+         *     directly from the particles.
+         */
 
-        if ( _inputProcessor.isFiltering( ) ){
+        //Assemble the averaging vector at the nodes for non-volume weighted averaging quantities
+        unsigned int dataCountAtPoint = 1  //Volume calculation
+                                      + 1  //Density
+                                      + 9; //Stress
 
-            error = overlapCoupling::computeShapeFunctionsAtPoints( macroCellID, *macroNodeReferenceLocations,
-                                                                    projectedMacroDisplacements, *macroConnectivity,
-                                                                    centerOfMassMap, macroNodes, shapefunctionsAtCentersOfMassByID );
+        unsigned int initialOffset = 11;
 
+        if ( _inputProcessor.useReconstructedMassCenters( ) ){
+            dataCountAtPoint += _dim; //Domain center of mass
         }
-        else{
 
-            error = overlapCoupling::computeShapeFunctionsAtPoints( macroCellID, *macroNodeReferenceLocations, *macroDisplacements,
-                                                                    *macroConnectivity,
-                                                                    centerOfMassMap, macroNodes,
-                                                                    shapefunctionsAtCentersOfMassByID );
+        //Add the micro body force if it is defined
+        if ( _inputProcessor.microBodyForceDefined( ) ){
+
+            dataCountAtPoint += _dim; //Add the micro body force
 
         }
 
-        if ( error ){
+        //Add the micro spin inertia term if the acceleration is defined
+        if ( _inputProcessor.microAccelerationDefined( ) ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the computation of the shapefunctions at the micro domain centers of mass for macro cell " + std::to_string( macroCellID ) );
-            result->addNext( error );
-            return result;
+            dataCountAtPoint += _dim; //Add the micro spin inertia term
 
         }
 
-        domainFloatVectorMap shapefunctionsAtCentersOfMass;
-        index = 0;
-        for ( auto name = domainNames.begin( ); name != domainNames.end( ); name++, index++ ){
-
-            shapefunctionsAtCentersOfMass.emplace( *name, shapefunctionsAtCentersOfMassByID[ index ] );
+        floatVector dataAtMicroPoints( dataCountAtPoint * microDomainNodeIDs.size( ), 0 );
 
-            if ( shapefunctionsAtCentersOfMassByID[ index ].size( ) != element->nodes.size( ) ){
+        const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
 
-                std::string output;
-                output += "The number of shape-function defined is not consistent with the number of micro domains\n";
-                output += "and the number of nodes in the macro element for macro-cell " + std::to_string( macroCellID ) + ".\n";
-                output += "This is likely because one of the micro-domains center of mass is located outside of the macro cell";
-    
-                return new errorNode( __func__, output );
+        const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
 
-            }
+        const floatType *microDensity, *microStress, *microDisplacement, *microBodyForce, *microAcceleration;
+        uIntType stride;
+        errorOut error;
 
-        }
+        unsigned int index = 0;
+        unsigned int localIndex = 0;
 
-        //Compute element nodal volumes
-        floatVector elementNodalVolumes( element->nodes.size( ), 0 );
-        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
+        for ( auto node = microDomainNodeIDs.begin( ); node != microDomainNodeIDs.end( ); node++, index++ ){
 
-            //Get the values of the shape function and the gradients
-            floatVector shapeFunctions;
-            error = element->get_shape_functions( qpt->first, shapeFunctions );
+            dataAtMicroPoints[ dataCountAtPoint * index + 0 ] = 1.;                           //Integrate the volume of the domain
 
+            error = microNodeFields->getNodeValues( "density", *node, microDensity, stride );
             if ( error ){
-
                 errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the shape functions\n" );
+                                                 "Micro node " + std::to_string( *node ) + " was not found in the micro density field" );
                 result->addNext( error );
                 return result;
-
             }
 
-            //Get the Jacobian of transformation
-            elib::vecOfvec jacobian;
-            error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
+            dataAtMicroPoints[ dataCountAtPoint * index + 1 ] = *microDensity; //Integrate the density of the domain
 
+            //Integrate the micro stresses
+            error = microNodeFields->getNodeValues( "stress", *node, microStress, stride );
             if ( error ){
-
                 errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the local gradient\n" );
+                                                 "Micro node " + std::to_string( *node ) + " was not found in the micro stress field" );
                 result->addNext( error );
                 return result;
-
             }
-
-            floatType Jxw = vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
-
-            for ( uIntType n = 0; n < shapeFunctions.size( ); n++ ){
-
-                elementNodalVolumes[ n ] += shapeFunctions[ n ] * Jxw;
-
+            for ( unsigned int i = 0; i < _dim * _dim; i++ ){
+                dataAtMicroPoints[ dataCountAtPoint * index + 2 + i ] = microStress[ i ];
             }
 
-        }
+            localIndex = initialOffset;
 
-        //Compute element nodal surface areas
-        floatMatrix elementNodalSurfaceAreas( element->nodes.size( ), floatVector( element->local_surface_points.size( ), 0 ) );
-        uIntType surfaceNum = 0;
-        for ( auto element_surface = element->surface_quadrature_rules.begin( ); element_surface != element->surface_quadrature_rules.end( ); element_surface++, surfaceNum++ ){
+            if ( _inputProcessor.useReconstructedMassCenters( ) ){
 
-            for ( auto s_qpt = element_surface->begin( ); s_qpt != element_surface->end( ); s_qpt++ ){
-
-                floatMatrix surface_jacobian;
-                error = element->get_local_gradient( element->nodes, s_qpt->first, surface_jacobian );
+                auto microReferencePosition = microReferencePositions->find( *node );
+                if ( microReferencePosition == microReferencePositions->end( ) ){
+                    return new errorNode( __func__,
+                                          "Micro node " + std::to_string( *node ) + " was not found in the micro reference position map" );
+                }
 
+                error = microNodeFields->getNodeValues( "displacement", *node, microDisplacement, stride );
                 if ( error ){
-
-                    std::string message = "Error in computing the local gradient of the shape functions for quadrature point " + std::to_string( ( unsigned int )( s_qpt - element_surface->begin( ) ) )
-                                        + " on surface " + std::to_string( surfaceNum ) + " for element " + std::to_string( macroCellID );
-                    return new errorNode( __func__, message );
-
+                    errorOut result = new errorNode( __func__,
+                                                     "Micro node " + std::to_string( *node ) + " was not found in the micro displacement field" );
+                    result->addNext( error );
+                    return result;
                 }
 
-                floatVector inv_jacobian = vectorTools::inverse( vectorTools::appendVectors( surface_jacobian ), _dim, _dim );
-                floatType Jxw = vectorTools::determinant( vectorTools::appendVectors( surface_jacobian ), _dim, _dim ) * s_qpt->second;
-                floatType surfaceAreaContribution = vectorTools::l2norm( vectorTools::Tdot( vectorTools::inflate( inv_jacobian, _dim, _dim ), element->local_surface_normals[ surfaceNum ] ) * Jxw );
+                //Integrate for the domain's center of mass
+                for ( unsigned int i = 0; i < _dim; i++ ){
+    
+                    dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ] =
+                        ( *microDensity ) * ( microReferencePosition->second[ i ] + microDisplacement[ i ] );
+    
+                }
 
-                floatVector shapeFunctions;
-                element->get_shape_functions( s_qpt->first, shapeFunctions );
+                //Local index
+                localIndex += _dim;
 
-                for ( uIntType n = 0; n < shapeFunctions.size( ); n++ ){
-                
-                    elementNodalSurfaceAreas[ n ][ surfaceNum ] += shapeFunctions[ n ] * surfaceAreaContribution;
-                
-                }
-                
             }
 
-        }
+            //Add the micro body forces
+            if ( _inputProcessor.microBodyForceDefined( ) ){
 
-#ifdef TESTACCESS
+                error = microNodeFields->getNodeValues( "body_force", *node, microBodyForce, stride );
+                if ( error ){
+                    errorOut result = new errorNode( __func__,
+                                                     "Micro node " + std::to_string( *node ) + " was not found in the micro body force field" );
+                    result->addNext( error );
+                    return result;
+                }
 
-        _test_elementNodalVolumes.emplace( macroCellID, elementNodalVolumes );
+                for ( unsigned int i = 0; i < _dim; i++ ){
 
-#endif
+                    dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ]
+                        = ( *microDensity ) * microBodyForce[ i ]; //Integrate the body forces of the domain
 
-        uIntType nMacroCellNodes = element->nodes.size( );
+                }
 
-        floatVector linearMomentumRHS( _dim * nMacroCellNodes, 0 );
-        floatVector firstMomentRHS( _dim * _dim * nMacroCellNodes, 0 );
+                localIndex += _dim;
 
-        //Project values to the nodes
-        floatVector volumeAtNodes( nMacroCellNodes, 0 );
-        floatVector densityAtNodes( nMacroCellNodes, 0 );
-        floatMatrix bodyForceAtNodes( nMacroCellNodes, floatVector( _dim, 0 ) );
-        floatMatrix accelerationAtNodes( nMacroCellNodes, floatVector( _dim, 0 ) );
-        floatMatrix microInertiaAtNodes( nMacroCellNodes, floatVector( _dim * _dim, 0 ) );
-        floatMatrix bodyCoupleAtNodes( nMacroCellNodes, floatVector( _dim * _dim, 0 ) );
-        floatMatrix microSpinInertiaAtNodes( nMacroCellNodes, floatVector( _dim * _dim, 0 ) );
-        floatMatrix symmetricMicroStressAtNodes( nMacroCellNodes, floatVector( _dim * _dim, 0 ) );
+            }
 
-        std::vector< floatVector > areaAtNodes( nMacroCellNodes, floatVector( element->local_surface_normals.size( ), 0 ) );
-        std::vector< floatMatrix > tractionAtNodes( nMacroCellNodes, floatMatrix( element->local_surface_normals.size( ), floatVector( _dim, 0 ) ) );
-        std::vector< floatMatrix > coupleAtNodes( nMacroCellNodes, floatMatrix( element->local_surface_normals.size( ), floatVector( _dim * _dim, 0 ) ) );
+            //Add the micro acclerations
+            if ( _inputProcessor.microAccelerationDefined( ) ){
 
-        //TODO: Consider doing a least-squares projection rather than a nodal averaging
+                error = microNodeFields->getNodeValues( "acceleration", *node, microAcceleration, stride );
+                if ( error ){
+                    errorOut result = new errorNode( __func__,
+                                                     "Micro node " + std::to_string( *node ) + " was not found in the micro acceleration field" );
+                    result->addNext( error );
+                    return result;
+                }
 
-        //Add the volume integral components of the right hand side vectors
-        //Also project the integral components to the nodes
-        for ( auto microDomainName = domainNames.begin( ); microDomainName != domainNames.end( ); microDomainName++ ){
+                for ( unsigned int i = 0; i < _dim; i++ ){
 
-            floatType density = homogenizedDensities[ macroCellID ][ *microDomainName ];
+                    dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ]
+                        = ( *microDensity ) * microAcceleration[ i ]; //Integrate the accelerations of the domain
 
-            floatType volume = homogenizedVolumes[ macroCellID ][ *microDomainName ];
+                }
 
-            floatVector bodyForce = homogenizedBodyForces[ macroCellID ][ *microDomainName ];
+                localIndex += _dim;
 
-            floatVector acceleration = homogenizedAccelerations[ macroCellID ][ *microDomainName ];
+            }
 
-            floatVector microInertia = homogenizedMicroInertias[ macroCellID ][ *microDomainName ];
+        }
 
-            floatVector bodyCouple = homogenizedBodyForceCouples[ macroCellID ][ *microDomainName ];
+        //Compute the initial volume averages
+        floatVector integratedValues;
+        error = reconstructedVolume->performVolumeIntegration( dataAtMicroPoints, dataCountAtPoint, integratedValues );
 
-            floatVector microSpinInertia = homogenizedMicroSpinInertias[ macroCellID ][ *microDomainName ];
+        if ( error ){
 
-            floatVector symmetricMicroStress = homogenizedSymmetricMicroStresses[ macroCellID ][ *microDomainName ];
+            errorOut result = new errorNode( __func__,
+                                             "Error in computing the initial volume averages" );
+            result->addNext( error );
+            return result;
 
-            //Don't need to do this because it is symmetric. We do it for testing purposes
-            //since to ring out the code we sometimes pass in non-symmetric tensors for the
-            //micro-stresses just to check.
-            floatVector symmetricMicroStress_T( _dim * _dim );
+        }
 
-            for ( unsigned int _i = 0; _i < _dim; _i++ ){
+        //Splice in the micro domain's center of mass if required
+        if ( !_inputProcessor.useReconstructedMassCenters( ) ){
 
-                for ( unsigned int _j = 0; _j < _dim; _j++ ){
+            integratedValues
+                = vectorTools::appendVectors( { floatVector( integratedValues.begin( ), integratedValues.begin( ) + initialOffset ),
+                                                integratedValues[ 1 ] * ( *microDomainCenterOfMass ),
+                                                floatVector( integratedValues.begin( ) + 11, integratedValues.end( ) ) } );
 
-                    symmetricMicroStress_T[ _dim * _j + _i ] = symmetricMicroStress[ _dim * _i + _j ];
+        }
 
-                }
+        //Splice in the micro-body force if required
+        if ( !_inputProcessor.microBodyForceDefined( ) ){
 
-            }
+            integratedValues
+                = vectorTools::appendVectors( { floatVector( integratedValues.begin( ),
+                                                             integratedValues.begin( ) + initialOffset + _dim ),
+                                                floatVector( _dim, 0 ),
+                                                floatVector( integratedValues.begin( ) + initialOffset + _dim,
+                                                             integratedValues.end( ) ) } );
 
-            for ( unsigned int j = 0; j < nMacroCellNodes; j++ ){
+        }
 
-                //Get the shapefunction value for the node
-                floatType N = shapefunctionsAtCentersOfMass[ *microDomainName ][ j ];
+        //Splice in the micro acceleration if required
+        if ( !_inputProcessor.microAccelerationDefined( ) ){
 
-                //Project values to the nodes
-                volumeAtNodes[ j ]               += N * volume;
-                densityAtNodes[ j ]              += N * density * volume;
-                bodyForceAtNodes[ j ]            += N * density * bodyForce * volume;
-                accelerationAtNodes[ j ]         += N * density * acceleration * volume;
-                microInertiaAtNodes[ j ]         += N * density * microInertia * volume;
-                bodyCoupleAtNodes[ j ]           += N * density * bodyCouple * volume;
-                microSpinInertiaAtNodes[ j ]     += N * density * microSpinInertia * volume;
-                symmetricMicroStressAtNodes[ j ] += N * symmetricMicroStress * volume;
+            integratedValues
+                = vectorTools::appendVectors( { integratedValues, floatVector( _dim, 0 ) } );
 
-            }
+        }
 
-            // Project the traction and couples
-            uIntVector domainMacroSurfaces = cellDomainMacroSurfaces[ macroCellID ][ *microDomainName ];
-            for ( auto face = domainMacroSurfaces.begin( ); face != domainMacroSurfaces.end( ); face++ ){
+        //Initialize
+        if ( values.homogenizedVolumes.find( macroCellID ) == values.homogenizedVolumes.end( ) ){
 
-                floatVector lcom( homogenizedSurfaceRegionProjectedLocalCentersOfMass[ macroCellID ][ *microDomainName ].begin( ) +
-                                                                                                                _dim * ( *face ),
-                                  homogenizedSurfaceRegionProjectedLocalCentersOfMass[ macroCellID ][ *microDomainName ].begin( ) +
-                                                                                                                _dim * ( ( *face ) + 1 ) );
-                floatVector sfs;
+            domainFloatMap tmpFloat;
+            domainFloatVectorMap tmpFloatVector;
 
-                error = element->get_shape_functions( lcom, sfs );
+            values.homogenizedVolumes.emplace( macroCellID, tmpFloat );
+            values.homogenizedDensities.emplace( macroCellID, tmpFloat );
+            values.homogenizedSymmetricMicroStresses.emplace( macroCellID, tmpFloatVector );
+            values.homogenizedCentersOfMass.emplace( macroCellID, tmpFloatVector );
+            values.homogenizedBodyForces.emplace( macroCellID, tmpFloatVector );
+            values.homogenizedAccelerations.emplace( macroCellID, tmpFloatVector );
+            values.homogenizedMicroInertias.emplace( macroCellID, tmpFloatVector );
+            values.homogenizedBodyForceCouples.emplace( macroCellID, tmpFloatVector );
+            values.homogenizedMicroSpinInertias.emplace( macroCellID, tmpFloatVector );
 
-                if ( error ){
+        }
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the computation of the shapefunctions at the micro-domain surface center of mass for macro cell " + std::to_string( macroCellID ) + " on face " + std::to_string( *face ) );
-                    result->addNext( error );
-                    return result;
+        values.homogenizedVolumes[ macroCellID ].emplace( microDomainName, integratedValues[ 0 ] );
+        values.homogenizedDensities[ macroCellID ].emplace( microDomainName, integratedValues[ 1 ] / integratedValues[ 0 ] );
+        values.homogenizedSymmetricMicroStresses[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + 2,
+                                                                                   integratedValues.begin( ) + 2 + _dim * _dim ) / integratedValues[ 0 ] );
+        values.homogenizedCentersOfMass[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset,
+                                                                                       integratedValues.begin( ) + initialOffset + _dim ) / integratedValues[ 1 ] );
+        values.homogenizedBodyForces[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset + _dim,
+                                                                                    integratedValues.begin( ) + initialOffset + 2 * _dim ) / integratedValues[ 1 ] );
+        values.homogenizedAccelerations[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset + 2 * _dim,
+                                                                                       integratedValues.end( ) ) / integratedValues[ 1 ] );
 
-                }
 
-                floatType area = homogenizedSurfaceRegionAreas[ macroCellID ][ *microDomainName ][ ( *face ) ];
+        //Perform the relative position volume integrations
+        dataCountAtPoint = _dim * _dim; //The micro inertia
 
-                floatVector traction( homogenizedSurfaceRegionTractions[ macroCellID ][ *microDomainName ].begin( ) + _dim * ( *face ),
-                                      homogenizedSurfaceRegionTractions[ macroCellID ][ *microDomainName ].begin( ) + _dim * ( ( *face ) + 1 ) );
+        initialOffset = dataCountAtPoint; //Set the initial offset
 
-                floatVector couple( homogenizedSurfaceRegionCouples[ macroCellID ][ *microDomainName ].begin( ) + _dim * _dim * ( *face ),
-                                    homogenizedSurfaceRegionCouples[ macroCellID ][ *microDomainName ].begin( ) + _dim * _dim * ( ( *face ) + 1 ) );
+        //Add the micro body force couple if it is defined
+        if ( _inputProcessor.microBodyForceDefined( ) ){
 
-                for ( unsigned int j = 0; j < nMacroCellNodes; j++ ){
+            dataCountAtPoint += _dim * _dim; //Add the micro body force couple
 
-                    areaAtNodes[ j ][ *face ] += sfs[ j ] * area;
-                    tractionAtNodes[ j ][ *face ] += sfs[ j ] * traction * area;
-                    coupleAtNodes[ j ][ *face ] += sfs[ j ] * couple * area;
+        }
 
-                }
+        //Add the micro spin inertia term if the acceleration is defined
+        if ( _inputProcessor.microAccelerationDefined( ) ){
 
-            }
+            dataCountAtPoint += _dim * _dim; //Add the micro spin inertia term
 
         }
 
-        //Save the contributions of the body forces and couples to the external force at the nodes
-        externalForcesAtNodes.emplace( macroCellID, vectorTools::appendVectors( bodyForceAtNodes ) );
-        externalCouplesAtNodes.emplace( macroCellID, vectorTools::appendVectors( bodyCoupleAtNodes ) );
+        integratedValues.clear( );
+        integratedValues.resize( 0 );
+        floatVector microRelativePosition( _dim );
 
-        //De-weight the projected values at the nodes
-        for ( unsigned int n = 0; n < nMacroCellNodes; n++ ){
+        if ( dataCountAtPoint > 0 ){
 
-            floatType volume;
-            if ( _inputProcessor.assumeVoidlessBody( ) ){
-                volume = std::fmax( _absoluteTolerance, volumeAtNodes[ n ] );
-            }
-            else{
-                volume = std::fmax( elementNodalVolumes[ n ], volumeAtNodes[ n ] );
-            }
+            index = 0;
+            floatVector dataAtMicroPoints( dataCountAtPoint * microDomainNodeIDs.size( ), 0 );
 
-            densityAtNodes[ n ]              /= volume;
-            bodyForceAtNodes[ n ]            /= ( densityAtNodes[ n ] * volume );
-            accelerationAtNodes[ n ]         /= ( densityAtNodes[ n ] * volume );
-            microInertiaAtNodes[ n ]         /= ( densityAtNodes[ n ] * volume );
-            bodyCoupleAtNodes[ n ]           /= ( densityAtNodes[ n ] * volume );
-            microSpinInertiaAtNodes[ n ]     /= ( densityAtNodes[ n ] * volume );
-            symmetricMicroStressAtNodes[ n ] /= volume;
+            //Set the center of mass
+            floatVector centerOfMass = values.homogenizedCentersOfMass[ macroCellID ][ microDomainName ];
+    
+            for ( auto node = microDomainNodeIDs.begin( ); node != microDomainNodeIDs.end( ); node++, index++ ){
 
-            for ( unsigned int face = 0; face < element->local_surface_normals.size( ); face++ ){
+                error = microNodeFields->getNodeValues( "density", *node, microDensity, stride );
+                if ( error ){
+                    errorOut result = new errorNode( __func__,
+                                                     "Micro node " + std::to_string( *node ) + " was not found in the micro density field" );
+                    result->addNext( error );
+                    return result;
+                }
 
-                floatType area;
-                if ( _inputProcessor.assumeVoidlessBody( ) ){
-                    area = std::fmax( _absoluteTolerance, areaAtNodes[ n ][ face ] );
+                auto microReferencePosition = microReferencePositions->find( *node );
+                if ( microReferencePosition == microReferencePositions->end( ) ){
+                    return new errorNode( __func__,
+                                          "Micro node " + std::to_string( *node ) + " was not found in the micro reference position map" );
                 }
-                else{
-                    area = std::fmax( elementNodalSurfaceAreas[ n ][ face ], areaAtNodes[ n ][ face ] );
+
+                error = microNodeFields->getNodeValues( "displacement", *node, microDisplacement, stride );
+                if ( error ){
+                    errorOut result = new errorNode( __func__,
+                                                     "Micro node " + std::to_string( *node ) + " was not found in the micro displacement field" );
+                    result->addNext( error );
+                    return result;
                 }
 
-                tractionAtNodes[ n ][ face ] /= area;
-                coupleAtNodes[ n ][ face ]   /= area;
+                //Extract the micro relative position
+                for ( unsigned int i = 0; i < _dim; i++ ){
 
-            }
+                    microRelativePosition[ i ] = microReferencePosition->second[ i ] + microDisplacement[ i ] - centerOfMass[ i ];
 
-        }
+                }
 
-#ifdef TESTACCESS
+                floatVector integrand
+                    = ( *microDensity )
+                    * vectorTools::appendVectors( vectorTools::dyadic( microRelativePosition, microRelativePosition ) );
 
-        _test_volumeAtNodes.emplace( macroCellID, volumeAtNodes );
-        _test_densityAtNodes.emplace( macroCellID, densityAtNodes );
-        _test_bodyForceAtNodes.emplace( macroCellID, bodyForceAtNodes );
-        _test_accelerationAtNodes.emplace( macroCellID, accelerationAtNodes );
-        _test_microInertiaAtNodes.emplace( macroCellID, microInertiaAtNodes );
-        _test_bodyCoupleAtNodes.emplace( macroCellID, bodyCoupleAtNodes );
-        _test_microSpinInertiaAtNodes.emplace( macroCellID, microSpinInertiaAtNodes );
-        _test_symmetricMicroStressAtNodes.emplace( macroCellID, symmetricMicroStressAtNodes );
+                //Add the contributions to the micro inertia
+                for ( unsigned int i = 0; i < _dim * _dim; i++ ){
 
-#endif
+                    dataAtMicroPoints[ dataCountAtPoint * index + i ]
+                        = integrand[ i ];
 
-        //Add the volume integral components of the right hand side vectors
-        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
+                }
 
-            // Compute the shapefunction values
-            floatVector shapefunctions;
-            element->get_shape_functions( qpt->first, shapefunctions );
+                localIndex = initialOffset;
 
-            // Compute the weighting factor
-            floatMatrix jacobian;
-            error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
+                //Add the contributions to the micro body couple
+                if ( _inputProcessor.microBodyForceDefined( ) ){
+
+                    error = microNodeFields->getNodeValues( "body_force", *node, microBodyForce, stride );
+                    if ( error ){
+                        errorOut result = new errorNode( __func__,
+                                                         "Micro node " + std::to_string( *node ) + " was not found in the micro body force field" );
+                        result->addNext( error );
+                        return result;
+                    }
+
+                    floatVector integrand
+                        = ( *microDensity )
+                        * vectorTools::appendVectors( vectorTools::dyadic( floatVector( microBodyForce, microBodyForce + _dim ), microRelativePosition ) );
+    
+                    for ( unsigned int i = 0; i < _dim * _dim; i++ ){
+    
+                        dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ]
+                            = integrand[ i ]; //Integrate the body force couple over the domain
+    
+                    }
+    
+                    localIndex += _dim * _dim;
+    
+                }
+    
+                //Add the contributions to the micro spin inertia
+                if ( _inputProcessor.microAccelerationDefined( ) ){
+
+                    error = microNodeFields->getNodeValues( "acceleration", *node, microAcceleration, stride );
+                    if ( error ){
+                        errorOut result = new errorNode( __func__,
+                                                         "Micro node " + std::to_string( *node ) + " was not found in the micro acceleration field" );
+                        result->addNext( error );
+                        return result;
+                    }
+
+                    floatVector microRelativeAcceleration = floatVector( microAcceleration, microAcceleration + _dim )
+                                                          - values.homogenizedAccelerations[ macroCellID ][ microDomainName ];
+
+                    floatVector integrand
+                        = ( *microDensity )
+                        * vectorTools::appendVectors( vectorTools::dyadic( microRelativeAcceleration, microRelativePosition ) );
+    
+                    for ( unsigned int i = 0; i < _dim * _dim; i++ ){
+    
+                        dataAtMicroPoints[ dataCountAtPoint * index + localIndex + i ]
+                            = integrand[ i ]; //Integrate the accelerations of the domain
+    
+                    }
+    
+                    localIndex += _dim * _dim;
+    
+                }
+
+            }
+
+            error = reconstructedVolume->performVolumeIntegration( dataAtMicroPoints, dataCountAtPoint, integratedValues );
 
             if ( error ){
 
-                std::string message = "Error in the computation of the local gradient of the shape functions for volume quadrature point " + std::to_string( qpt - element->qrule.begin( ) );
-                return new errorNode( __func__, message );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the computation of the relative position volume integrals" );
+                result->addNext( error );
+                return result;
 
             }
 
-            floatVector inv_jacobian = vectorTools::inverse( vectorTools::appendVectors( jacobian ), _dim, _dim );
-            floatType Jxw = vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
+        }
 
-            // Interpolate the nodal values
-            floatType   density;
-            floatVector bodyForce;
-            floatVector acceleration;
+        if ( !_inputProcessor.microBodyForceDefined( ) ){
 
-            floatVector bodyCouple;
-            floatVector microSpinInertia;
-            floatVector symmetricMicroStress;
+            integratedValues = vectorTools::appendVectors( { floatVector( integratedValues.begin( ),
+                                                                          integratedValues.begin( ) + initialOffset ),
+                                                             floatVector( _dim * _dim, 0 ),
+                                                             floatVector( integratedValues.begin( ) + initialOffset,
+                                                                          integratedValues.end( ) ) } );
 
-            element->interpolate( densityAtNodes,      qpt->first, density );
-            element->interpolate( bodyForceAtNodes,    qpt->first, bodyForce );
-            element->interpolate( accelerationAtNodes, qpt->first, acceleration );
+        }
 
-            element->interpolate( bodyCoupleAtNodes,           qpt->first, bodyCouple );
-            element->interpolate( microSpinInertiaAtNodes,     qpt->first, microSpinInertia );
-            element->interpolate( symmetricMicroStressAtNodes, qpt->first, symmetricMicroStress );
+        if ( !_inputProcessor.microAccelerationDefined( ) ){
 
-            for ( unsigned int j = 0; j < nMacroCellNodes; j++ ){
+            integratedValues = vectorTools::appendVectors( { integratedValues, floatVector( _dim * _dim, 0 ) } );
 
-                //Get the shapefunction value for the node
-                floatType N = shapefunctions[ j ];
+        }
 
-                //Compute the contribution to the node
-                floatVector nLinearMomentumRHS = N * density * ( bodyForce - acceleration ) * Jxw;
+        floatType domainMass = values.homogenizedDensities[ macroCellID ][ microDomainName ]
+                             * values.homogenizedVolumes[ macroCellID ][ microDomainName ];
+        values.homogenizedMicroInertias[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ),
+                                                                                       integratedValues.begin( ) + initialOffset ) / domainMass );
+        values.homogenizedBodyForceCouples[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset,
+                                                                                          integratedValues.begin( ) + initialOffset + _dim * _dim ) / domainMass );
+        values.homogenizedMicroSpinInertias[ macroCellID ].emplace( microDomainName, floatVector( integratedValues.begin( ) + initialOffset + _dim * _dim,
+                                                                                           integratedValues.begin( ) + initialOffset + 2 * _dim * _dim ) / domainMass );
 
-                floatVector nFirstMomentRHS = N * ( density * ( bodyCouple - microSpinInertia ) - symmetricMicroStress ) * Jxw;
+        return NULL;
 
-                //Add the contribution to the overall RHS vectors
-                for ( auto it = nLinearMomentumRHS.begin( ); it != nLinearMomentumRHS.end( ); it++ ){
+    }
 
-                    uIntType index = _dim * j + ( it - nLinearMomentumRHS.begin( ) );
+    errorOut overlapCoupling::computeDomainSurfaceAverages( const uIntType &macroCellID, const std::string &microDomainName,
+                                                            const uIntVector &microDomainNodeIDs,
+                                                            const uIntType &microDomainSurfaceDecompositionCount,
+                                                            std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume,
+                                                            const std::unique_ptr< elib::Element > &element,
+                                                            const YAML::Node &volumeReconstructionConfig,
+                                                            homogenizedDomainValues &values ){
+        /*!
+         * Compute the required surface averages over the micro-domain.
+         *
+         * :param const uIntType &macroCellID: The ID of the macro-cell associated with the micro domain.
+         * :param const std::string &microDomainName: The name of the micro domain
+         * :param const std::string &microDomainNodeIDs: The IDs of the nodes in the micro-domain to have the surface averages
+         *     computed over.
+         * :param const uIntType &microDomainSurfaceDecompositionCount: The approximate number of regions to split the surface
+         *     of the micro surface into.
+         * :param volumeReconstruction::volumeReconstructionBase &reconstructedVolume: The reconstructed volume
+         *     ready to have surface integrals computed over.
+         * :param const std::unique_ptr< elib::Element > &element: The enclosing macro element
+         * :param const YAML::Node &volumeReconstructionConfig: The configuration of the volume reconstruction
+         * :param homogenizedDomainValues &values: The storage for the homogenized values of the micro domain
+         */
 
-                    linearMomentumRHS[ index ] += *it;
+        //Extract the required micro-scale values
+        const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+        const std::unordered_map< uIntType, floatVector > *microReferencePositions = _inputProcessor.getMicroNodeReferencePositions( );
+        const floatType *microDensity, *microStress;
+        uIntType stride;
 
-                }
+        /*=====================================================================
+        |           Compute the reconstructed domain's surface area           |
+        =====================================================================*/
 
-                for ( auto it = nFirstMomentRHS.begin( ); it != nFirstMomentRHS.end( ); it++ ){
+        uIntType dataCountAtPoint = 1; //Total surface area
 
-                    uIntType index = _dim * _dim * j + ( it - nFirstMomentRHS.begin( ) );
+        floatVector dataAtMicroPoints( microDomainNodeIDs.size( ), 1 );
 
-                    firstMomentRHS[ index ] += *it;
+        floatVector integratedValue;
 
-                }
+        errorOut error = reconstructedVolume->performSurfaceIntegration( dataAtMicroPoints, 1, integratedValue );
 
-            }
+        if ( error ){
+
+            errorOut result = new errorNode( __func__,
+                                             "Error in the computation of the domain's surface area" );
+            result->addNext( error );
+            return result;
 
         }
 
-        //Add the surface integral components of the right hand side vectors
-        uIntType surface_index = 0;
-        for ( auto face_nodes = element->local_surface_node_ids.begin( ); face_nodes != element->local_surface_node_ids.end( ); face_nodes++, surface_index++ ){
-            
-            floatMatrix tractions( element->nodes.size( ), floatVector( _dim, 0 ) );
-            floatMatrix couples( element->nodes.size( ), floatVector( _dim * _dim, 0 ) );
+        if ( values.homogenizedSurfaceAreas.find( macroCellID ) == values.homogenizedSurfaceAreas.end( ) ){
 
-            // Initialize the nodes
-            for ( auto fn = face_nodes->begin( ); fn != face_nodes->end( ); fn++ ){
+            domainFloatMap tmpFloatMap;
+            domainFloatVectorMap tmpFloatVectorMap;
+            values.homogenizedSurfaceAreas.emplace( macroCellID, tmpFloatMap );
+            values.homogenizedSurfaceRegionAreas.emplace( macroCellID, tmpFloatVectorMap );
+            values.homogenizedSurfaceRegionCentersOfMass.emplace( macroCellID, tmpFloatVectorMap );
+            values.homogenizedSurfaceRegionProjectedLocalCentersOfMass.emplace( macroCellID, tmpFloatVectorMap );
+            values.homogenizedSurfaceRegionProjectedCentersOfMass.emplace( macroCellID, tmpFloatVectorMap );
+            values.homogenizedSurfaceRegionTractions.emplace( macroCellID, tmpFloatVectorMap );
+            values.homogenizedSurfaceRegionCouples.emplace( macroCellID, tmpFloatVectorMap );
 
-                tractions[ *fn ] = tractionAtNodes[ *fn ][ surface_index ];
-                couples[ *fn ] = coupleAtNodes[ *fn ][ surface_index ];
+        }
 
-            }
+        values.homogenizedSurfaceAreas[ macroCellID ].emplace( microDomainName, integratedValue[ 0 ] );
 
-            std::cerr << "surface: " << surface_index << "\n";
-            // Begin the surface integration
-            for ( auto s_qpt = element->surface_quadrature_rules[ surface_index ].begin( ); s_qpt != element->surface_quadrature_rules[ surface_index ].end( ); s_qpt++ ){
+        /*=====================================================================
+        |           Compute the properties of the surface subdomains          |
+        =====================================================================*/
 
-                // Interpolate the traction and couple
-                floatVector traction;
-                floatVector couple;
+        //Get the boundary points from the reconstructed domain
+        const floatVector *boundaryPoints = reconstructedVolume->getBoundaryPoints( );
 
-                element->interpolate( tractions, s_qpt->first, traction );
-                element->interpolate( couples, s_qpt->first, couple );
+        //Determine which element surface each point belongs to ( if any )
+        floatType tol = volumeReconstructionConfig[ "element_contain_tolerance" ].as< floatType >( );
+        bool useMacroNormals = volumeReconstructionConfig[ "use_macro_normals" ].as< bool >( );
 
-                std::cerr << "    traction: "; vectorTools::print( traction );
-                std::cerr << "    couple:   "; vectorTools::print( couple );
+        uIntVector surf;
+        uIntVector tmp( 0 );
+        floatVector ftmp( 0 );
+        uIntMatrix subdomainNodeIDs( element->local_surface_points.size( ), tmp );
+        floatMatrix subdomainNodeNormals( element->local_surface_points.size( ), ftmp );
 
-                // Compute the shapefunction values
-                floatVector shapefunctions;
-                element->get_shape_functions( s_qpt->first, shapefunctions );
+        auto sIndex = 0;
+        for ( auto s = subdomainNodeIDs.begin( ); s != subdomainNodeIDs.end( ); s++, sIndex++ ){
 
-                // Compute the weighting factor
-                floatMatrix surface_jacobian;
-                error = element->get_local_gradient( element->nodes, s_qpt->first, surface_jacobian );
-                std::cerr << "    surface_jacobian: "; vectorTools::print( vectorTools::appendVectors( surface_jacobian ) );
+            ( *s ).reserve( boundaryPoints->size( ) / ( _dim * subdomainNodeIDs.size( ) ) );
+            subdomainNodeNormals[ sIndex ].reserve( boundaryPoints->size( ) / subdomainNodeIDs.size( ) );
 
-                if ( error ){
+        }
 
-                    std::string message = "Error in computing the local gradient of the shape functions for quadrature point "
-                                        + std::to_string( ( unsigned int )( s_qpt - element->surface_quadrature_rules[ surface_index ].begin( ) ) )
-                                        + " on surface " + std::to_string( surfaceNum ) + " for element " + std::to_string( macroCellID );
-                    return new errorNode( __func__, message );
+        for ( uIntType bpIndex = 0; bpIndex != ( boundaryPoints->size( ) / _dim ); bpIndex++ ){
 
-                }
+            floatVector p( boundaryPoints->begin( ) + _dim * bpIndex,
+                           boundaryPoints->begin( ) + _dim * ( bpIndex + 1 ) );
 
-                floatVector inv_jacobian = vectorTools::inverse( vectorTools::appendVectors( surface_jacobian ), _dim, _dim );
-                std::cerr << "    inv_jacobian: "; vectorTools::print( inv_jacobian ); 
-                floatType Jxw = vectorTools::determinant( vectorTools::appendVectors( surface_jacobian ), _dim, _dim ) * s_qpt->second;
-                std::cerr << "    Jxw: " << Jxw << "\n";
-                floatType da = vectorTools::l2norm( vectorTools::Tdot( vectorTools::inflate( inv_jacobian, _dim, _dim ), element->local_surface_normals[ surface_index ] ) * Jxw );
-                std::cerr << "    da:  " << da << "\n";
+            floatVector xi;
 
-                for ( unsigned int j = 0; j < element->nodes.size( ); j++ ){
+            //Compute the local coordinates of the point
+            std::unique_ptr< errorNode > tmpError;
+            tmpError.reset( element->compute_local_coordinates( p, xi ) );
 
-                    // Compute the contribution to the node
-                    floatVector nLinearMomentumRHS = shapefunctions[ j ] * traction * da;
+            if ( tmpError ){
 
-                    floatVector nFirstMomentRHS = shapefunctions[ j ] * couple * da;
+                continue;
 
-                    //Add the contribution to the overall RHS vectors
-                    for ( auto it = nLinearMomentumRHS.begin( ); it != nLinearMomentumRHS.end( ); it++ ){
-    
-                        uIntType index = _dim * j + ( it - nLinearMomentumRHS.begin( ) );
-    
-                        linearMomentumRHS[ index ] += *it;
-                        externalForcesAtNodes[ macroCellID ][ index ] += *it;
-    
-                    }
-    
-                    for ( auto it = nFirstMomentRHS.begin( ); it != nFirstMomentRHS.end( ); it++ ){
-    
-                        uIntType index = _dim * _dim * j + ( it - nFirstMomentRHS.begin( ) );
-    
-                        firstMomentRHS[ index ] += *it;
-                        externalCouplesAtNodes[ macroCellID ][ index ] += *it;
-    
-                    }
+            }
 
-                }
+            //Determine if the point is on any of the element's surfaces
+            if ( element->local_point_on_surface( xi, surf, tol ) ){
 
-            }
+                for ( auto s = surf.begin( ); s != surf.end( ); s++ ){
 
-        }
+                    subdomainNodeIDs[ *s ].push_back( bpIndex );
 
-#ifdef TESTACCESS
+                    floatVector n;
 
-        _test_cellLinearMomentumRHS.emplace( macroCellID, linearMomentumRHS );
-        _test_cellFirstMomentRHS.emplace( macroCellID, firstMomentRHS );
+                    floatMatrix dxdxi;
 
-#endif
+                    floatVector dxidx;
 
-        //Assemble the LHS matrix
+                    element->get_local_gradient( element->nodes, xi, dxdxi );
 
-        //Loop over the quadrature points adding the contribution of each to the LHS matrix
-        //This formulation does not construct the stresses at each of the micro domains but 
-        //rather computes the stresses at the macro domain's Gauss points which enables the
-        //solution of the macro balance equations.
+                    dxidx = vectorTools::inverse( vectorTools::appendVectors( dxdxi ), _dim, _dim );
 
-        floatType Jxw;
-        floatVector shapeFunctions;
-        floatMatrix dNdx, jacobian;
+                    n = vectorTools::matrixMultiply( dxidx, element->local_surface_normals[ *s ], _dim, _dim, _dim, 1, true, false );
 
-        tripletVector coefficients;
-        coefficients.reserve( ( 2 * _dim * _dim + 3 * _dim * _dim ) * element->nodes.size( ) * element->qrule.size( ) );
+                    n /= vectorTools::l2norm( n );
 
-        //Quadrature point interpolated values
-        floatVector densities( element->qrule.size( ), 0 );
-        floatMatrix bodyForces( element->qrule.size( ), floatVector( _dim, 0 ) );
-        floatMatrix accelerations( element->qrule.size( ), floatVector( _dim, 0 ) );
-        floatMatrix microInertias( element->qrule.size( ), floatVector( _dim * _dim, 0 ) );
-        floatMatrix bodyCouples( element->qrule.size( ), floatVector( _dim * _dim, 0 ) );
-        floatMatrix microSpinInertias( element->qrule.size( ), floatVector( _dim * _dim, 0 ) );
-        floatMatrix symmetricMicroStress( element->qrule.size( ), floatVector( _dim * _dim, 0 ) );
-        floatMatrix nodalDOFValues( element->nodes.size( ), floatVector( _dim + _dim * _dim, 0 ) );
+                    for ( uIntType i = 0; i < _dim; i++ ){
 
-        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
+                        subdomainNodeNormals[ *s ].push_back( n[ i ] );
 
-            //Set the index
-            uIntType qptIndex = qpt - element->qrule.begin( );
+                    }
 
-            //Set the column
-            uIntType col0lm = _dim * _dim * qptIndex;
-            uIntType col0fm = _dim * _dim * element->nodes.size( ) + _dim * _dim * _dim * qptIndex;
+                }
 
-            //Get the values of the shape function and the gradients
-            error = element->get_shape_functions( qpt->first, shapeFunctions );
+            }
 
-            if ( error ){
+        }
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the shape functions\n" );
-                result->addNext( error );
-                return result;
+        uIntVector macroSurfaces;
+        for ( uIntType i = 0; i < subdomainNodeIDs.size( ); i++ ){
+
+            if ( subdomainNodeIDs[ i ].size( ) > 0 ){
+
+                macroSurfaces.push_back( i );
 
             }
 
-            //Get the values of the shape function gradients
-            error = element->get_global_shapefunction_gradients( qpt->first, dNdx );
+        }
 
-            if ( error ){
+        values.cellDomainMacroSurfaces[ macroCellID ].emplace( microDomainName, macroSurfaces );
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the shape function gradients\n" );
-                result->addNext( error );
-                return result;
+        //Get the centers of mass of the surface regions
 
-            }
+        dataCountAtPoint = 1     //Surface area of region
+                         + 1;    //Mass of region
+//                         + _dim; //Micro point position
 
-            //Get the Jacobian of transformation
-            error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
+        dataAtMicroPoints.clear( );
+        dataAtMicroPoints.reserve( dataCountAtPoint * microDomainNodeIDs.size( ) );
 
-            if ( error ){
+        for ( auto node = microDomainNodeIDs.begin( ); node != microDomainNodeIDs.end( ); node++ ){
 
+            error = microNodeFields->getNodeValues( "density", *node, microDensity, stride );
+            if ( error ){
                 errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the local gradient\n" );
+                                                 "The micro node " + std::to_string( *node ) + " was not found in the micro density field" );
                 result->addNext( error );
                 return result;
-
             }
 
-            Jxw = vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
-
-            for ( unsigned int n = 0; n < element->nodes.size( ); n++ ){
-
-                //Set the row
-                uIntType row0 = _dim * n;
+            dataAtMicroPoints.push_back( 1 );
+            dataAtMicroPoints.push_back( *microDensity );
 
-                //Add the balance of linear momentum contributions
-                for ( unsigned int i = 0; i < _dim; i++ ){
+            auto microReferencePosition = microReferencePositions->find( *node );
+            if ( microReferencePosition == microReferencePositions->end( ) ){
+                return new errorNode( __func__,
+                                      "Micro node " + std::to_string( *node ) + " was not found in the micro reference position map" );
+            }
 
-                    for ( unsigned int j = 0; j < _dim; j++ ){
+//            auto microDisplacement = microDisplacements->find( *node );
+//            if ( microDisplacement == microDisplacements->end( ) ){
+//                return new errorNode( __func__,
+//                                      "Micro node " + std::to_string( *node ) + " was not found in the micro displacement map" );
+//            }
+//
+//            floatVector microPoint = microReferencePosition->second + microDisplacement->second;
+//
+//            for ( unsigned int i = 0; i < microPoint.size( ); i++ ){
+//
+//                dataAtMicroPoints.push_back( microDensity->second * microPoint[ i ] );
+//
+//            }
 
-                        coefficients.push_back( DOFProjection::T( row0 + i, col0lm + i + _dim * j, dNdx[ n ][ j ] * Jxw ) );
+        }
 
-                    }
+        //Initialize storage values for homogenization
+        values.homogenizedSurfaceRegionAreas[ macroCellID ].emplace( microDomainName, floatVector( subdomainNodeIDs.size( ), 0 ) );
+        floatVector regionDensities( subdomainNodeIDs.size( ) );
+        values.homogenizedSurfaceRegionCentersOfMass[ macroCellID ].emplace( microDomainName, floatVector( _dim * subdomainNodeIDs.size( ), 0 ) );
+        values.homogenizedSurfaceRegionProjectedLocalCentersOfMass[ macroCellID ].emplace( microDomainName, floatVector( _dim * subdomainNodeIDs.size( ), 0 ) );
+        values.homogenizedSurfaceRegionProjectedCentersOfMass[ macroCellID ].emplace( microDomainName, floatVector( _dim * subdomainNodeIDs.size( ), 0 ) );
 
-                }
+        //Initialize the homogenized values
+        values.homogenizedSurfaceRegionTractions[ macroCellID ].emplace( microDomainName, floatVector( _dim * subdomainNodeIDs.size( ), 0 ) );
+        values.homogenizedSurfaceRegionCouples[ macroCellID ].emplace( microDomainName, floatVector( _dim * _dim * subdomainNodeIDs.size( ), 0 ) );
 
-                //Add the balance of the first moment of momentum contributions
-                row0 = _dim * element->nodes.size( ) + _dim * _dim * n;
+        uIntType index = 0;
+        for ( auto sN = subdomainNodeIDs.begin( ); sN != subdomainNodeIDs.end( ); sN++, index++ ){
 
-                //Cauchy stress contribution
-                for ( unsigned int i = 0; i < _dim; i++ ){
+            if ( ( *sN ).size( ) > 0 ){
 
-                    for ( unsigned int j = 0; j < _dim; j++ ){
+                // Perform the surface integration
+                uIntVector *nodesOnSurface = &( *sN );
+                error = reconstructedVolume->performSurfaceIntegration( dataAtMicroPoints, dataCountAtPoint,
+                                                                        integratedValue, nodesOnSurface,
+                                                                        NULL,
+                                                                        &subdomainNodeNormals[ index ],
+                                                                        useMacroNormals );
+    
+                if ( error ){
+    
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the integration of the macro surface ( "
+                                                     + std::to_string( sN - subdomainNodeIDs.begin( ) ) + " )" );
+                    result->addNext( error );
+                    return result;
+    
+                }
 
-                        coefficients.push_back( DOFProjection::T( row0 + _dim * i + j, col0lm + _dim * j + i, -shapeFunctions[ n ] * Jxw ) );
+                // Extract the region surface areas and the region surface densities
+                values.homogenizedSurfaceRegionAreas[ macroCellID ][ microDomainName ][ index ] = integratedValue[ 0 ];
+                regionDensities[ index ] = integratedValue[ 1 ] / integratedValue[ 0 ];
 
-                    }
+                // Perform the position weighted surface integration
+                error = reconstructedVolume->performPositionWeightedSurfaceIntegration( dataAtMicroPoints, dataCountAtPoint,
+                                                                                        integratedValue, nodesOnSurface,
+                                                                                        NULL,
+                                                                                        &subdomainNodeNormals[ index ],
+                                                                                        useMacroNormals );
 
+                if ( error ){
+    
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the integration of the position weighted macro surface ( "
+                                                     + std::to_string( sN - subdomainNodeIDs.begin( ) ) + " )" );
+                    result->addNext( error );
+                    return result;
+    
                 }
 
-                //Higher order stress contribution
-                for ( unsigned int i = 0; i < _dim * _dim; i++ ){
-
-                    for ( unsigned int j = 0; j < _dim; j++ ){
+                floatVector centerOfMass( integratedValue.begin( ) + _dim,
+                                          integratedValue.begin( ) + 2 * _dim );
+                centerOfMass /= ( values.homogenizedSurfaceRegionAreas[ macroCellID ][ microDomainName ][ index ] * regionDensities[ index ] );
 
-                        coefficients.push_back( DOFProjection::T( row0 + i, col0fm + _dim * _dim * j + i, dNdx[ n ][ j ] * Jxw ) );
+                for ( uIntType i = 0; i < _dim; i++ ){
 
-                    }
+                    values.homogenizedSurfaceRegionCentersOfMass[ macroCellID ][ microDomainName ][ index * _dim + i ] = centerOfMass[ i ];
 
                 }
 
-                //Interpolate the nodal values to the quadrature points
-                densities[ qptIndex ]            += shapeFunctions[ n ] * densityAtNodes[ n ];
-                bodyForces[ qptIndex ]           += shapeFunctions[ n ] * bodyForceAtNodes[ n ];
-                accelerations[ qptIndex ]        += shapeFunctions[ n ] * accelerationAtNodes[ n ];
-                microInertias[ qptIndex ]        += shapeFunctions[ n ] * microInertiaAtNodes[ n ];
-                bodyCouples[ qptIndex ]          += shapeFunctions[ n ] * bodyCoupleAtNodes[ n ];
-                microSpinInertias[ qptIndex ]    += shapeFunctions[ n ] * microSpinInertiaAtNodes[ n ];
-                symmetricMicroStress[ qptIndex ] += shapeFunctions[ n ] * symmetricMicroStressAtNodes[ n ];
+                //Compute the local coordinates of the center of mass
+                floatVector localCenterOfMass; 
+                error = element->compute_local_coordinates( centerOfMass, localCenterOfMass );
 
-            }
+                if ( error ){
 
-        }
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the computation of the local surface center of mass" );
+                    result->addNext( error );
+                    return result;
 
-        //Form the left-hand side sparse matrix
-        SparseMatrix LHS( ( _dim + _dim * _dim ) * element->nodes.size( ), _dim * _dim * ( 1 + _dim ) * element->qrule.size( ) );
-        LHS.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
+                }
 
-#ifdef TESTACCESS
+                //Find the closest point on the surface of the element in local coordinates
+                floatType distance = vectorTools::dot( element->local_surface_normals[ index ],
+                                                       localCenterOfMass - element->local_surface_points[ index ] );
 
-        _test_stressProjectionLHS.emplace( macroCellID, LHS.toDense( ) );
+                floatVector projectedLocalCenterOfMass = localCenterOfMass - distance * element->local_surface_normals[ index ];
 
-#endif
+                for ( unsigned int i = 0; i < _dim; i++ ){
+                    values.homogenizedSurfaceRegionProjectedLocalCentersOfMass[ macroCellID ][ microDomainName ][ index * _dim + i ]
+                        = projectedLocalCenterOfMass[ i ];
+                }
 
-        //Perform the SVD decomposition
-        Eigen::JacobiSVD< Eigen::MatrixXd > svd( LHS.toDense( ), Eigen::ComputeThinU | Eigen::ComputeThinV );
-       
-        //Compute the threshold for the SVD 
-        floatVector logSVec( LHS.rows( ), 0 );
+                //Interpolate this point back to global coordinates
+                floatVector projectedCenterOfMass;
+                error = element->interpolate( element->nodes, projectedLocalCenterOfMass, projectedCenterOfMass );
 
-        Eigen::Map< Eigen::MatrixXd > logS( logSVec.data(), logSVec.size(), 1 );
+                if ( error ){
 
-        //Compute the singular values
-        logS = svd.singularValues();
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the interpolation of the local projected surface center of mass to global coordinates" );
+                    result->addNext( error );
+                    return result;
 
-        for ( unsigned int i = 0; i < logSVec.size( ); i++ ){
+                }
 
-            logSVec[ i ] = std::log10( logSVec[ i ] + _absoluteTolerance );
+                for ( unsigned int i = 0; i < _dim; i++ ){
+                    values.homogenizedSurfaceRegionProjectedCentersOfMass[ macroCellID ][ microDomainName ][ index * _dim + i ]
+                        = projectedCenterOfMass[ i ];
+                }
 
-        }
+            }
 
-        //Determine where the "shelf" in the singular values occurs
-        uIntVector outliers;
+        }
 
-        MADOutlierDetection( logSVec, outliers, 10 );
+        /*===================================================================================
+        | Compute the surface tractions and couples over the micro domain's surface regions |
+        ===================================================================================*/
 
-        if ( outliers.size( ) > 0 ){
+        dataCountAtPoint = _dim * _dim;
 
-            svd.setThreshold( std::max( pow( 10, logSVec[ outliers[ 0 ] ] ), _absoluteTolerance ) );
+        dataAtMicroPoints.clear( );
+        dataAtMicroPoints.reserve( dataCountAtPoint * microDomainNodeIDs.size( ) );
 
-        }
-        else{
+        for ( auto node = microDomainNodeIDs.begin( ); node != microDomainNodeIDs.end( ); node++ ){
 
-            svd.setThreshold( _absoluteTolerance );
+            error = microNodeFields->getNodeValues( "stress", *node, microStress, stride );
+            if ( error ){
+                errorOut result = new errorNode( __func__,
+                                                 "Micro node " + std::to_string( *node ) + " was not found in the micro stress field" );
+                result->addNext( error );
+                return result;
+            }
 
-        }
+            for ( unsigned int i = 0; i < _dim * _dim; i++ ){
 
-        floatVector rhsVec = vectorTools::appendVectors( { linearMomentumRHS, firstMomentRHS } );
+                dataAtMicroPoints.push_back( microStress[ i ] );
 
-        Eigen::Map< Eigen::MatrixXd > RHS( rhsVec.data( ), rhsVec.size( ), 1 ); 
+            }
 
-        //Solve for the stresses
-        Eigen::MatrixXd x = svd.solve( RHS );
+        }
 
-        //Extract the stresses at the evaluation points
-        uIntType nCauchy = _dim * _dim;
-        uIntType nHigherOrder = _dim * _dim * _dim;
+        index = 0;
+        for ( auto sN = subdomainNodeIDs.begin( ); sN != subdomainNodeIDs.end( ); sN++, index++ ){
 
-        uIntType nEvaluationPoints = x.size( ) / ( nCauchy + nHigherOrder );
+            if ( ( *sN ).size( ) > 0 ){
 
-        floatVector cauchyStresses( _dim * _dim * nEvaluationPoints );
-        floatVector higherOrderStresses( _dim * _dim * _dim * nEvaluationPoints );
+                //Compute the tractions
+                uIntVector *nodesOnSurface = &( *sN );
 
-        for ( unsigned int n = 0; n < nEvaluationPoints; n++ ){
+                error = reconstructedVolume->performSurfaceFluxIntegration( dataAtMicroPoints, dataCountAtPoint,
+                                                                            integratedValue, nodesOnSurface,
+                                                                            NULL,
+                                                                            &subdomainNodeNormals[ index ], useMacroNormals );
 
-            for ( unsigned int i = 0; i < nCauchy; i++ ){
+                if ( error ){
+    
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the computation of the surface traction of the the macro surface ( "
+                                                     + std::to_string( sN - subdomainNodeIDs.begin( ) ) + " )" );
+                    result->addNext( error );
+                    return result;
+    
+                }
 
-                cauchyStresses[ nCauchy * n + i ] = x( nCauchy * n + i );
+                for ( uIntType i = 0; i < _dim; i++ ){
+                    values.homogenizedSurfaceRegionTractions[ macroCellID ][ microDomainName ][ _dim * index + i ]
+                        = integratedValue[ i ] / values.homogenizedSurfaceRegionAreas[ macroCellID ][ microDomainName ][ index ];
+                }
 
-            }
+                //Compute the couples
+                floatVector regionCenterOfMass( values.homogenizedSurfaceRegionCentersOfMass[ macroCellID ][ microDomainName ].begin( ) + _dim * index,
+                                                values.homogenizedSurfaceRegionCentersOfMass[ macroCellID ][ microDomainName ].begin( ) + _dim * ( index + 1 ) );
 
-            for ( unsigned int i = 0; i < nHigherOrder; i++ ){
-
-                higherOrderStresses[ nHigherOrder * n + i ] = x( nEvaluationPoints * nCauchy + nHigherOrder * n + i );
+                error = reconstructedVolume->performRelativePositionSurfaceFluxIntegration( dataAtMicroPoints, dataCountAtPoint,
+                                                                                            regionCenterOfMass, integratedValue,
+                                                                                            nodesOnSurface,
+                                                                                            NULL,
+                                                                                            &subdomainNodeNormals[ index ], useMacroNormals );
+    
+                if ( error ){
+    
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the computation of the surface couple of the micro region ( "
+                                                     + std::to_string( sN - subdomainNodeIDs.begin( ) ) + " )" );
+                    result->addNext( error );
+                    return result;
+    
+                }
+    
+    //            integratedValue /= regionSurfaceArea;
+    //
+    //            homogenizedSurfaceRegionCouples[ macroCellID ]
+    //                = vectorTools::appendVectors( { homogenizedSurfaceRegionCouples[ macroCellID ],
+    //                                                integratedValue } );
+                for ( uIntType i = 0; i < _dim * _dim; i++ ){
+    
+                    values.homogenizedSurfaceRegionCouples[ macroCellID ][ microDomainName ][ _dim * _dim * index + i ]
+                        = integratedValue[ i ] / values.homogenizedSurfaceRegionAreas[ macroCellID ][ microDomainName ][ index ];
+    
+                }
 
             }
 
         }
 
-        quadraturePointCauchyStress.emplace( macroCellID, cauchyStresses );
-        quadraturePointHigherOrderStress.emplace( macroCellID, higherOrderStresses );
-
-        //Emplace the values at the quadrature points
-        quadraturePointDensities.emplace( macroCellID, densities );
-        quadraturePointBodyForce.emplace( macroCellID, vectorTools::appendVectors( bodyForces ) );
-        quadraturePointAccelerations.emplace( macroCellID, vectorTools::appendVectors( accelerations ) );
-        quadraturePointMicroInertias.emplace( macroCellID, vectorTools::appendVectors( microInertias ) );
-        quadraturePointBodyCouples.emplace( macroCellID, vectorTools::appendVectors( bodyCouples ) );
-        quadraturePointMicroSpinInertias.emplace( macroCellID, vectorTools::appendVectors( microSpinInertias ) );
-        quadraturePointSymmetricMicroStress.emplace( macroCellID, vectorTools::appendVectors( symmetricMicroStress ) );
-
         return NULL;
-
     }
 
-    const cellDomainFloatMap* overlapCoupling::getReferenceFreeMicroDomainMasses( ){
+    errorOut overlapCoupling::computeHomogenizedStresses( const uIntType &macroCellID ){
         /*!
-         * Get access to the reference free micro-domain mass
+         * Compute the homogenized stresses for the macro cell
+         *
+         * :param const uIntType &macroCellID: The ID of the macro cell to have the 
+         *     homogenized stresses computed at the quadrature points.
          */
 
-        return &_referenceFreeMicroDomainMasses;
-    }
+        //Get the pointers to the values
+        const std::unordered_map< uIntType, floatVector > *macroNodeReferenceLocations
+            = _inputProcessor.getMacroNodeReferencePositions( );
+        const std::unordered_map< uIntType, floatVector > *macroDisplacements
+            = _inputProcessor.getMacroDisplacements( );
+        const std::unordered_map< uIntType, uIntVector > *macroConnectivity
+            = _inputProcessor.getMacroNodeReferenceConnectivity( );
 
-    const cellDomainFloatMap* overlapCoupling::getReferenceGhostMicroDomainMasses( ){
-        /*!
-         * Get access to the reference ghost micro-domain masses
-         */
+        //Form the finite element representation of the macro-scale
+        std::unique_ptr< elib::Element > element;
+        errorOut error;
 
-        return &_referenceGhostMicroDomainMasses;
-    }
+        std::unordered_map< uIntType, floatVector > projectedMacroDisplacements;
+    
+        if ( _inputProcessor.isFiltering( ) ){
+    
+            auto cellConnectivity = macroConnectivity->find( macroCellID );
+    
+            if ( cellConnectivity == macroConnectivity->end( ) ){
+    
+                return new errorNode( __func__, "Macro cell " + std::to_string( macroCellID ) + " not found in connectivity map" );
+    
+            }
 
-    const cellDomainFloatVectorMap* overlapCoupling::getReferenceFreeMicroDomainCentersOfMass( ){
-        /*!
-         * Get access to the reference free micro-domain centers of mass
-         */
+            auto macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-        return &_referenceFreeMicroDomainCentersOfMass;
-    }
+            unsigned int nMacroFreeNodes = _inputProcessor.getFreeMacroNodeIds( )->size( ); // I anticipate this should always be zero
 
-    const cellDomainFloatVectorMap* overlapCoupling::getReferenceGhostMicroDomainCentersOfMass( ){
-        /*!
-         * Get access to the reference ghost micro-domain centers of mass
-         */
+            unsigned int nMacroDOF = _dim + _dim * _dim;
 
-        return &_referenceGhostMicroDomainCentersOfMass;
-    }
+            for ( auto node = cellConnectivity->second.begin( ) + 1; node != cellConnectivity->second.end( ); node++ ){
 
-    const cellDomainFloatVectorMap* overlapCoupling::getReferenceFreeMicroDomainMomentsOfInertia( ){
-        /*!
-         * Get access to the reference free micro-domain moments of inertia
-         */
+                auto local_node = macroGlobalToLocalDOFMap->find( *node );
 
-        return &_referenceFreeMicroDomainMomentsOfInertia;
-    }
+                if ( local_node == macroGlobalToLocalDOFMap->end( ) ){
 
-    const cellDomainFloatVectorMap* overlapCoupling::getReferenceGhostMicroDomainMomentsOfInertia( ){
-        /*!
-         * Get access to the reference ghost micro-domain moments of inertia
-         */
+                    return new errorNode( __func__, "Micro node " + std::to_string( *node) + " not found in the global to local map" );
 
-        return &_referenceGhostMicroDomainMomentsOfInertia;
-    }
+                }
 
-    const domainFloatMap* overlapCoupling::getFreeMicroDomainMasses( ){
-        /*!
-         * Get access to the free micro-domain mass
-         */
+                projectedMacroDisplacements.emplace( *node, floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second,
+                                                                         _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second + 3 ) );
 
-        return &_freeMicroDomainMasses;
-    }
+            }
 
-    const domainFloatMap* overlapCoupling::getGhostMicroDomainMasses( ){
-        /*!
-         * Get access to the ghost micro-domain masses
-         */
+            //Build the macro element
+            error = overlapCoupling::buildMacroDomainElement( macroCellID, *macroNodeReferenceLocations,
+                                                              projectedMacroDisplacements, *macroConnectivity,
+                                                              element );
+ 
+        }
+        else{
+    
+            //Build the macro element
+            error = overlapCoupling::buildMacroDomainElement(  macroCellID, *macroNodeReferenceLocations,
+                                                              *macroDisplacements, *macroConnectivity,
+                                                              element );
 
-        return &_ghostMicroDomainMasses;
-    }
+        }
 
-    const domainFloatVectorMap* overlapCoupling::getFreeMicroDomainCentersOfMass( ){
-        /*!
-         * Get access to the free micro-domain centers of mass
-         */
+        if ( error ){
 
-        return &_freeMicroDomainCentersOfMass;
-    }
+            errorOut result = new errorNode( __func__,
+                                             "Error in the formation of the finite element representation of the macro-scale" );
+            result->addNext( error );
+            return result;
 
-    const domainFloatVectorMap* overlapCoupling::getGhostMicroDomainCentersOfMass( ){
-        /*!
-         * Get access to the ghost micro-domain centers of mass
-         */
+        }
 
-        return &_ghostMicroDomainCentersOfMass;
-    }
+        //Get the shape functions at the micro-domain centroids
+        std::unordered_map< uIntType, floatVector > centerOfMassMap;
+        stringVector domainNames;
+        centerOfMassMap.reserve( homogenizedCentersOfMass[ macroCellID ].size( ) );
 
-    const cellDomainFloatVectorMap* overlapCoupling::getReferenceFreeMicroDomainCenterOfMassShapeFunctions( ){
-        /*!
-         * Get access to the shapefunction values of the reference free micro domain centers of mass
-         */
+        uIntType index = 0;
+        for ( auto name  = homogenizedCentersOfMass[ macroCellID ].begin( );
+                   name != homogenizedCentersOfMass[ macroCellID ].end( ); name++, index++ ){
 
-        return &_referenceFreeMicroDomainCenterOfMassShapeFunctions;
-    }
+            domainNames.push_back( name->first );
+            centerOfMassMap.emplace( index, name->second );
 
-    const cellDomainFloatVectorMap* overlapCoupling::getReferenceGhostMicroDomainCenterOfMassShapeFunctions( ){
-        /*!
-         * Get access to the shapefunction values of the reference ghost micro domain centers of mass
-         */
+        }
+        
 
-        return &_referenceGhostMicroDomainCenterOfMassShapeFunctions; 
-    }
+        std::unordered_map< uIntType, floatVector > shapefunctionsAtCentersOfMassByID;
 
-    const floatVector* overlapCoupling::getProjectedGhostMacroDisplacement( ){
-        /*!
-         * Get access to the projected ghost macro displacements
-         */
+        uIntVector macroNodes;
 
-        return &_projected_ghost_macro_displacement;
-    }
+        if ( _inputProcessor.isFiltering( ) ){
 
-    const floatVector* overlapCoupling::getProjectedGhostMicroDisplacement( ){
-        /*!
-         * Get access to the projected ghost macro displacements
-         */
+            error = overlapCoupling::computeShapeFunctionsAtPoints( macroCellID, *macroNodeReferenceLocations,
+                                                                    projectedMacroDisplacements, *macroConnectivity,
+                                                                    centerOfMassMap, macroNodes, shapefunctionsAtCentersOfMassByID );
 
-        return &_projected_ghost_micro_displacement;
-    }
+        }
+        else{
 
-    errorOut MADOutlierDetection( const floatVector &x, uIntVector &outliers, const floatType threshold,
-                                  const floatType eps ){
-        /*!
-         * Detect outliers using median absolute deviation
-         * MAD = median ( | X_i - median(X) | )
-         *
-         * :param const floatVector &x: The x vector to search for outliers
-         * :param uIntVector> &outliers: The vector of outliers
-         * :param const floatType threshold: The threshold with which to identify an outlier. Defaults to 10.
-         * :param const floatType eps: The minimum allowable value for MAD
-         */
+            error = overlapCoupling::computeShapeFunctionsAtPoints( macroCellID, *macroNodeReferenceLocations, *macroDisplacements,
+                                                                    *macroConnectivity,
+                                                                    centerOfMassMap, macroNodes,
+                                                                    shapefunctionsAtCentersOfMassByID );
 
-        floatType median = vectorTools::median(x);
+        }
 
-        floatVector absDeviations = vectorTools::abs(x - median);
+        if ( error ){
 
-        floatType MAD = vectorTools::median(absDeviations) + eps;
+            errorOut result = new errorNode( __func__,
+                                             "Error in the computation of the shapefunctions at the micro domain centers of mass for macro cell " + std::to_string( macroCellID ) );
+            result->addNext( error );
+            return result;
 
-        absDeviations /= MAD;
+        }
 
-        outliers.resize(0);
-        outliers.reserve(x.size() / 10);
+        domainFloatVectorMap shapefunctionsAtCentersOfMass;
+        index = 0;
+        for ( auto name = domainNames.begin( ); name != domainNames.end( ); name++, index++ ){
 
-        for ( unsigned int i = 0; i < absDeviations.size( ); i++ ){
+            shapefunctionsAtCentersOfMass.emplace( *name, shapefunctionsAtCentersOfMassByID[ index ] );
 
-            if ( absDeviations[ i ] > threshold ){
+            if ( shapefunctionsAtCentersOfMassByID[ index ].size( ) != element->nodes.size( ) ){
 
-                outliers.push_back(i);
+                std::string output;
+                output += "The number of shape-function defined is not consistent with the number of micro domains\n";
+                output += "and the number of nodes in the macro element for macro-cell " + std::to_string( macroCellID ) + ".\n";
+                output += "This is likely because one of the micro-domains center of mass is located outside of the macro cell";
+    
+                return new errorNode( __func__, output );
 
             }
 
         }
 
-        return NULL;
-    }
+        //Compute element nodal volumes
+        floatVector elementNodalVolumes( element->nodes.size( ), 0 );
+        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
 
-    errorOut formMicromorphicElementMassMatrix( const std::unique_ptr< elib::Element > &element,
-                                                const floatVector &degreeOfFreedomValues,
-                                                const floatVector &momentOfInertia,
-                                                const floatVector &density,
-                                                const DOFMap *nodeIDToIndex,
-                                                tripletVector &coefficients,
-                                                const floatVector *arlequinNodalWeights,
-                                                const bool quantitiesInReference ){
-        /*!
-         * Form the micromorphic mass matrix for an element
-         *
-         * :param const std::unique_ptr< elib::Element > &element: The element to form the mass matrix of
-         * :param const floatVector &degreeOfFreedomValues: The degree of freedom values at the element nodes
-         * :param const floatVector &momentOfInertia: The moment of inertia in the current configuration
-         *     at the quadrature points ordered as [ i1_11, i1_12, i1_13, i1_21, ... , i2_11, i2_12, ... ] 
-         *     where the first index is the quadrature point and the second indices are the indices of the
-         *     moment of inertia tensor.
-         * :param const floatVector &density: The density in the current configuration
-         *     at the quadrature points
-         * :param const DOFMap &nodeIDToIndex: A map from the node id's to the DOF index
-         * :param tripletVector &coefficients: The coefficients of the mass matrix
-         * :param const floatVector *arlequinNodalWeights: The weights of the nodes for the Arlequin method.
-         *     Defaults to NULL.
-         * :param const bool floatVector: Flag for if the density and moments of inerta are actually defined
-         *     in the reference configuration.
-         */
+            //Get the values of the shape function and the gradients
+            floatVector shapeFunctions;
+            error = element->get_shape_functions( qpt->first, shapeFunctions );
 
-        //Get the dimension of the element
-        uIntType dim = element->nodes[ 0 ].size( );
+            if ( error ){
 
-        const uIntType uSize   = dim;
-        const uIntType phiSize = dim * dim;
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the computation of the shape functions\n" );
+                result->addNext( error );
+                return result;
 
-        //Check that the degree of freedom value vector's length is consistent with the element
-        if ( degreeOfFreedomValues.size( ) != ( uSize + phiSize ) * element->nodes.size( ) ){
+            }
 
-            return new errorNode( __func__,
-                                  "The degree of freedom vector size is not consistent with the element dimension" );
+            //Get the Jacobian of transformation
+            elib::vecOfvec jacobian;
+            error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
 
-        }
+            if ( error ){
 
-        if ( momentOfInertia.size( ) != element->qrule.size( ) * phiSize ){
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the computation of the local gradient\n" );
+                result->addNext( error );
+                return result;
 
-            return new errorNode( __func__,
-                                  "The moment of inertia vector size is not consistent with the quadrature rule and element dimension" );
+            }
 
-        }
+            floatType Jxw = vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
 
-        if ( density.size( ) != element->qrule.size( ) ){
+            for ( uIntType n = 0; n < shapeFunctions.size( ); n++ ){
 
-            return new errorNode( __func__,
-                                  "The density vector size is not consistent with the quadrature rule" );
+                elementNodalVolumes[ n ] += shapeFunctions[ n ] * Jxw;
+
+            }
 
         }
 
-        if ( element->global_node_ids.size( ) != element->nodes.size( )  ){
+        //Compute element nodal surface areas
+        floatMatrix elementNodalSurfaceAreas( element->nodes.size( ), floatVector( element->local_surface_points.size( ), 0 ) );
+        uIntType surfaceNum = 0;
+        for ( auto element_surface = element->surface_quadrature_rules.begin( ); element_surface != element->surface_quadrature_rules.end( ); element_surface++, surfaceNum++ ){
 
-            return new errorNode( __func__,
-                                  "The size of the global node id in the element are not the same size as the number of nodes" );
+            for ( auto s_qpt = element_surface->begin( ); s_qpt != element_surface->end( ); s_qpt++ ){
 
-        }
+                floatMatrix surface_jacobian;
+                error = element->get_local_gradient( element->nodes, s_qpt->first, surface_jacobian );
 
-        //Reshape the degree of freedom values to a matrix of values where the rows are the values at the nodes
-        floatMatrix reshapedDOFValues = vectorTools::inflate( degreeOfFreedomValues, element->nodes.size( ), uSize + phiSize );
+                if ( error ){
 
-        //Variable initialize
-        floatVector shapeFunctions;
-        floatVector interpolatedValues, deformationGradient;
-        floatType qptDensity, referenceDensity;
-        floatVector qptMomentOfInertia;
-        floatVector uQpt, XiQpt, invXiQpt, referenceMomentOfInertia, inertiaTerm;
-        floatMatrix gradShapeFunctions;
+                    std::string message = "Error in computing the local gradient of the shape functions for quadrature point " + std::to_string( ( unsigned int )( s_qpt - element_surface->begin( ) ) )
+                                        + " on surface " + std::to_string( surfaceNum ) + " for element " + std::to_string( macroCellID );
+                    return new errorNode( __func__, message );
 
-        floatVector eye( dim * dim );
-        vectorTools::eye( eye );
+                }
 
-        floatType J, Jxw, sFo, sFp;
-        uIntType qptIndex, row0, col0;
-        errorOut error = NULL;
+                floatVector inv_jacobian = vectorTools::inverse( vectorTools::appendVectors( surface_jacobian ), _dim, _dim );
+                floatType Jxw = vectorTools::determinant( vectorTools::appendVectors( surface_jacobian ), _dim, _dim ) * s_qpt->second;
+                floatType surfaceAreaContribution = vectorTools::l2norm( vectorTools::Tdot( vectorTools::inflate( inv_jacobian, _dim, _dim ), element->local_surface_normals[ surfaceNum ] ) * Jxw );
 
-        //Loop over the quadrature points
-        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
+                floatVector shapeFunctions;
+                element->get_shape_functions( s_qpt->first, shapeFunctions );
 
-            //Set the quadrature point index
-            qptIndex = qpt - element->qrule.begin( );
+                for ( uIntType n = 0; n < shapeFunctions.size( ); n++ ){
+                
+                    elementNodalSurfaceAreas[ n ][ surfaceNum ] += shapeFunctions[ n ] * surfaceAreaContribution;
+                
+                }
+                
+            }
 
-            //Compute the base micromorphic element terms
-            error = computeMicromorphicElementRequiredValues( element, qpt, dim, reshapedDOFValues, true,
-                                                              shapeFunctions, gradShapeFunctions,
-                                                              deformationGradient, J, Jxw, uQpt, XiQpt );
+        }
 
-            if ( error ){
+#ifdef TESTACCESS
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the required values for the element" );
-                result->addNext( error );
-                return result;
+        _test_elementNodalVolumes.emplace( macroCellID, elementNodalVolumes );
 
-            }
+#endif
 
-            invXiQpt = vectorTools::inverse( XiQpt, dim, dim );
+        uIntType nMacroCellNodes = element->nodes.size( );
 
-            //Get the current density
-            qptDensity = density[ qptIndex ];
+        floatVector linearMomentumRHS( _dim * nMacroCellNodes, 0 );
+        floatVector firstMomentRHS( _dim * _dim * nMacroCellNodes, 0 );
 
-            //Compute the moment of inertia in the reference configuration
-            qptMomentOfInertia = floatVector( momentOfInertia.begin( ) + dim * dim * qptIndex,
-                                              momentOfInertia.begin( ) + dim * dim * ( qptIndex + 1 ) );
+        //Project values to the nodes
+        floatVector volumeAtNodes( nMacroCellNodes, 0 );
+        floatVector densityAtNodes( nMacroCellNodes, 0 );
+        floatMatrix bodyForceAtNodes( nMacroCellNodes, floatVector( _dim, 0 ) );
+        floatMatrix accelerationAtNodes( nMacroCellNodes, floatVector( _dim, 0 ) );
+        floatMatrix microInertiaAtNodes( nMacroCellNodes, floatVector( _dim * _dim, 0 ) );
+        floatMatrix bodyCoupleAtNodes( nMacroCellNodes, floatVector( _dim * _dim, 0 ) );
+        floatMatrix microSpinInertiaAtNodes( nMacroCellNodes, floatVector( _dim * _dim, 0 ) );
+        floatMatrix symmetricMicroStressAtNodes( nMacroCellNodes, floatVector( _dim * _dim, 0 ) );
 
-            if ( quantitiesInReference ){
+        std::vector< floatVector > areaAtNodes( nMacroCellNodes, floatVector( element->local_surface_normals.size( ), 0 ) );
+        std::vector< floatMatrix > tractionAtNodes( nMacroCellNodes, floatMatrix( element->local_surface_normals.size( ), floatVector( _dim, 0 ) ) );
+        std::vector< floatMatrix > coupleAtNodes( nMacroCellNodes, floatMatrix( element->local_surface_normals.size( ), floatVector( _dim * _dim, 0 ) ) );
 
-                referenceDensity = qptDensity;
-                referenceMomentOfInertia = qptMomentOfInertia;
+        //TODO: Consider doing a least-squares projection rather than a nodal averaging
 
-            }
-            else{
+        //Add the volume integral components of the right hand side vectors
+        //Also project the integral components to the nodes
+        for ( auto microDomainName = domainNames.begin( ); microDomainName != domainNames.end( ); microDomainName++ ){
 
-                referenceDensity = J * qptDensity;
-                referenceMomentOfInertia
-                    = vectorTools::matrixMultiply( vectorTools::matrixMultiply( invXiQpt, qptMomentOfInertia, dim, dim, dim, dim ),
-                                                   invXiQpt, dim, dim, dim, dim, false, true );
+            floatType density = homogenizedDensities[ macroCellID ][ *microDomainName ];
 
-            }
+            floatType volume = homogenizedVolumes[ macroCellID ][ *microDomainName ];
 
-            //Evaluate the integrand term
-            inertiaTerm = referenceDensity * referenceMomentOfInertia * Jxw;
+            floatVector bodyForce = homogenizedBodyForces[ macroCellID ][ *microDomainName ];
 
-            floatType arlequinWeight = 1;
-            if ( arlequinNodalWeights ){
+            floatVector acceleration = homogenizedAccelerations[ macroCellID ][ *microDomainName ];
 
-                element->interpolate( *arlequinNodalWeights, qpt->first, arlequinWeight );
+            floatVector microInertia = homogenizedMicroInertias[ macroCellID ][ *microDomainName ];
 
-            }
+            floatVector bodyCouple = homogenizedBodyForceCouples[ macroCellID ][ *microDomainName ];
 
-            //Add the contrubutions to the mass matrix
-            for ( uIntType o = 0; o < shapeFunctions.size( ); o++ ){
+            floatVector microSpinInertia = homogenizedMicroSpinInertias[ macroCellID ][ *microDomainName ];
 
-                sFo = shapeFunctions[ o ];
+            floatVector symmetricMicroStress = homogenizedSymmetricMicroStresses[ macroCellID ][ *microDomainName ];
 
-                auto gni1 = nodeIDToIndex->find( element->global_node_ids[ o ] );
+            //Don't need to do this because it is symmetric. We do it for testing purposes
+            //since to ring out the code we sometimes pass in non-symmetric tensors for the
+            //micro-stresses just to check.
+            floatVector symmetricMicroStress_T( _dim * _dim );
 
-                if ( gni1 == nodeIDToIndex->end( ) ){
+            for ( unsigned int _i = 0; _i < _dim; _i++ ){
 
-                    return new errorNode( __func__,
-                                          "Node " + std::to_string( element->global_node_ids[ o ] ) + " not found in the ID map" );
-                                          
+                for ( unsigned int _j = 0; _j < _dim; _j++ ){
+
+                    symmetricMicroStress_T[ _dim * _j + _i ] = symmetricMicroStress[ _dim * _i + _j ];
 
                 }
 
-                row0 = ( uSize + phiSize ) * gni1->second;
+            }
 
-                for ( uIntType p = 0; p < shapeFunctions.size( ); p++ ){
+            for ( unsigned int j = 0; j < nMacroCellNodes; j++ ){
 
-                    sFp = shapeFunctions[ p ];
+                //Get the shapefunction value for the node
+                floatType N = shapefunctionsAtCentersOfMass[ *microDomainName ][ j ];
 
-                    auto gni2 = nodeIDToIndex->find( element->global_node_ids[ p ] );
+                //Project values to the nodes
+                volumeAtNodes[ j ]               += N * volume;
+                densityAtNodes[ j ]              += N * density * volume;
+                bodyForceAtNodes[ j ]            += N * density * bodyForce * volume;
+                accelerationAtNodes[ j ]         += N * density * acceleration * volume;
+                microInertiaAtNodes[ j ]         += N * density * microInertia * volume;
+                bodyCoupleAtNodes[ j ]           += N * density * bodyCouple * volume;
+                microSpinInertiaAtNodes[ j ]     += N * density * microSpinInertia * volume;
+                symmetricMicroStressAtNodes[ j ] += N * symmetricMicroStress * volume;
 
-                    if ( gni2 == nodeIDToIndex->end( ) ){
-    
-                        return new errorNode( __func__,
-                                              "Node " + std::to_string( element->global_node_ids[ p ] ) + " not found in the ID map" );
-                                              
-    
-                    }
-    
-                    col0 = ( uSize + phiSize ) * gni2->second;
+            }
 
-                    for ( unsigned int j = 0; j < dim; j++ ){
+            // Project the traction and couples
+            uIntVector domainMacroSurfaces = cellDomainMacroSurfaces[ macroCellID ][ *microDomainName ];
+            for ( auto face = domainMacroSurfaces.begin( ); face != domainMacroSurfaces.end( ); face++ ){
 
-                        for ( unsigned int k = 0; k < dim; k++ ){
+                floatVector lcom( homogenizedSurfaceRegionProjectedLocalCentersOfMass[ macroCellID ][ *microDomainName ].begin( ) +
+                                                                                                                _dim * ( *face ),
+                                  homogenizedSurfaceRegionProjectedLocalCentersOfMass[ macroCellID ][ *microDomainName ].begin( ) +
+                                                                                                                _dim * ( ( *face ) + 1 ) );
+                floatVector sfs;
 
-                            coefficients.push_back( DOFProjection::T( row0 + j,
-                                                                      col0 + k,
-                                                                      arlequinWeight * eye[ dim * j + k ] * referenceDensity * sFo * sFp * Jxw ) );
-    
-                            for ( unsigned int K = 0; K < dim; K++ ){
-    
-                                for ( unsigned int L = 0; L < dim; L++ ){
-    
-                                    coefficients.push_back( DOFProjection::T( row0 + dim + dim * j + K,
-                                                                              col0 + dim + dim * k + L,
-                                                                              arlequinWeight * eye[ dim * j + k ] * sFo * sFp * inertiaTerm[ dim * K + L ] ) );
+                error = element->get_shape_functions( lcom, sfs );
 
-                                }
-    
-                            }
+                if ( error ){
 
-                        }
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the computation of the shapefunctions at the micro-domain surface center of mass for macro cell " + std::to_string( macroCellID ) + " on face " + std::to_string( *face ) );
+                    result->addNext( error );
+                    return result;
 
-                    }
+                }
+
+                floatType area = homogenizedSurfaceRegionAreas[ macroCellID ][ *microDomainName ][ ( *face ) ];
+
+                floatVector traction( homogenizedSurfaceRegionTractions[ macroCellID ][ *microDomainName ].begin( ) + _dim * ( *face ),
+                                      homogenizedSurfaceRegionTractions[ macroCellID ][ *microDomainName ].begin( ) + _dim * ( ( *face ) + 1 ) );
+
+                floatVector couple( homogenizedSurfaceRegionCouples[ macroCellID ][ *microDomainName ].begin( ) + _dim * _dim * ( *face ),
+                                    homogenizedSurfaceRegionCouples[ macroCellID ][ *microDomainName ].begin( ) + _dim * _dim * ( ( *face ) + 1 ) );
+
+                for ( unsigned int j = 0; j < nMacroCellNodes; j++ ){
+
+                    areaAtNodes[ j ][ *face ] += sfs[ j ] * area;
+                    tractionAtNodes[ j ][ *face ] += sfs[ j ] * traction * area;
+                    coupleAtNodes[ j ][ *face ] += sfs[ j ] * couple * area;
 
                 }
 
@@ -7210,2742 +7534,4538 @@ namespace overlapCoupling{
 
         }
 
-        return NULL;
-    }
-
-    errorOut formMicromorphicElementInternalForceVector( const std::unique_ptr< elib::Element > &element,
-                                                         const floatVector &degreeOfFreedomValues,
-                                                         const floatVector &cauchyStress,
-                                                         const floatVector &symmetricMicroStress,
-                                                         const floatVector &higherOrderStress,
-                                                         const DOFMap *nodeIDToIndex,
-                                                         Eigen::MatrixXd &internalForceVector ){
-        /*!
-         * Add the contribution of the micromorphic element to the internal force vector
-         *
-         * TODO: This function is considerably more complicated than it needs to be so that it
-         *       uses the functions in the micromorphic balance equations library. We don't have to
-         *       do this and it would make the function shorter and probably faster.
-         *
-         * :param const std::unique_ptr< elib::Element > &element: The FEA representation of the micromorphic element
-         * :param const floatVector &degreeOfFreedomValues: The values of the degrees of freedom at the nodes of the element
-         * :param const floatVector &cauchyStress: The cauchy stress at the quadrature points of the element
-         *     ( current configuration )
-         * :param const floatVector &symmetricMicroStress: The symmetric micro-stress at the quadrature points of the element
-         *     ( current configuration )
-         * :param const floatVector &higherOrderStress: The higher-order stress at the quadrature points of the element
-         *     ( current configuraiton )
-         * :param const DOFMap *nodeIDToIndex: The map from the global node ids to the ordering in the internal force vector
-         * :param Eigen::MatrixXd &internalForceVector: The internal force vector to be populated.
-         */
-
-        //Get the dimension of the element
-        uIntType dim = element->nodes[ 0 ].size( );
-
-        const uIntType uSize   = dim;
-        const uIntType phiSize = dim * dim;
-
-        if ( dim != 3 ){
+        //Save the contributions of the body forces and couples to the external force at the nodes
+        externalForcesAtNodes.emplace( macroCellID, vectorTools::appendVectors( bodyForceAtNodes ) );
+        externalCouplesAtNodes.emplace( macroCellID, vectorTools::appendVectors( bodyCoupleAtNodes ) );
 
-            std::string output  = "The dimension of the problem is required to be 3. This only matters ( it is believed )\n";
-            output             += "because of dNdX, fint, and cint which are currently consistent with a 3D problem as required\n";
-            output             += "by balance_equations.h";
-            return new errorNode( __func__, output );
+        //De-weight the projected values at the nodes
+        for ( unsigned int n = 0; n < nMacroCellNodes; n++ ){
 
-        }
+            floatType volume;
+            if ( _inputProcessor.assumeVoidlessBody( ) ){
+                volume = std::fmax( _absoluteTolerance, volumeAtNodes[ n ] );
+            }
+            else{
+                volume = std::fmax( elementNodalVolumes[ n ], volumeAtNodes[ n ] );
+            }
 
-        //Check that the degree of freedom value vector's length is consistent with the element
-        if ( degreeOfFreedomValues.size( ) != ( uSize + phiSize ) * element->nodes.size( ) ){
+            densityAtNodes[ n ]              /= volume;
+            bodyForceAtNodes[ n ]            /= ( densityAtNodes[ n ] * volume );
+            accelerationAtNodes[ n ]         /= ( densityAtNodes[ n ] * volume );
+            microInertiaAtNodes[ n ]         /= ( densityAtNodes[ n ] * volume );
+            bodyCoupleAtNodes[ n ]           /= ( densityAtNodes[ n ] * volume );
+            microSpinInertiaAtNodes[ n ]     /= ( densityAtNodes[ n ] * volume );
+            symmetricMicroStressAtNodes[ n ] /= volume;
 
-            return new errorNode( __func__,
-                                  "The degree of freedom vector size is not consistent with the element dimension" );
+            for ( unsigned int face = 0; face < element->local_surface_normals.size( ); face++ ){
 
-        }
+                floatType area;
+                if ( _inputProcessor.assumeVoidlessBody( ) ){
+                    area = std::fmax( _absoluteTolerance, areaAtNodes[ n ][ face ] );
+                }
+                else{
+                    area = std::fmax( elementNodalSurfaceAreas[ n ][ face ], areaAtNodes[ n ][ face ] );
+                }
 
-        if ( cauchyStress.size( ) != element->qrule.size( ) * dim * dim ){
+                tractionAtNodes[ n ][ face ] /= area;
+                coupleAtNodes[ n ][ face ]   /= area;
 
-            return new errorNode( __func__,
-                                  "The Cauchy stress vector size is not consistent with the quadrature rule and element dimension" );
+            }
 
         }
 
-        if ( symmetricMicroStress.size( ) != element->qrule.size( ) * dim * dim ){
-
-            return new errorNode( __func__,
-                                  "The symmetric micro-stress vector size is not consistent with the quadrature rule" );
+#ifdef TESTACCESS
 
-        }
+        _test_volumeAtNodes.emplace( macroCellID, volumeAtNodes );
+        _test_densityAtNodes.emplace( macroCellID, densityAtNodes );
+        _test_bodyForceAtNodes.emplace( macroCellID, bodyForceAtNodes );
+        _test_accelerationAtNodes.emplace( macroCellID, accelerationAtNodes );
+        _test_microInertiaAtNodes.emplace( macroCellID, microInertiaAtNodes );
+        _test_bodyCoupleAtNodes.emplace( macroCellID, bodyCoupleAtNodes );
+        _test_microSpinInertiaAtNodes.emplace( macroCellID, microSpinInertiaAtNodes );
+        _test_symmetricMicroStressAtNodes.emplace( macroCellID, symmetricMicroStressAtNodes );
 
-        if ( higherOrderStress.size( ) != element->qrule.size( ) * dim * dim * dim ){
+#endif
 
-            return new errorNode( __func__,
-                                  "The higher-order stress vector size is not consistent with the quadrature rule" );
+        //Add the volume integral components of the right hand side vectors
+        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
 
-        }
+            // Compute the shapefunction values
+            floatVector shapefunctions;
+            element->get_shape_functions( qpt->first, shapefunctions );
 
-        if ( element->global_node_ids.size( ) != element->nodes.size( )  ){
+            // Compute the weighting factor
+            floatMatrix jacobian;
+            error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
 
-            return new errorNode( __func__,
-                                  "The size of the global node id in the element are not the same size as the number of nodes" );
+            if ( error ){
 
-        }
+                std::string message = "Error in the computation of the local gradient of the shape functions for volume quadrature point " + std::to_string( qpt - element->qrule.begin( ) );
+                return new errorNode( __func__, message );
 
-        //Reshape the degree of freedom values to a matrix of values where the rows are the values at the nodes
-        floatMatrix reshapedDOFValues = vectorTools::inflate( degreeOfFreedomValues, element->nodes.size( ), uSize + phiSize );
+            }
 
-        //Initialize variables
-        floatType N, J, Jxw;
-        floatType dNdX[ 3 ], fint[ 3 ], cint[ 9 ];
-        int errorCode;
+            floatVector inv_jacobian = vectorTools::inverse( vectorTools::appendVectors( jacobian ), _dim, _dim );
+            floatType Jxw = vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
 
-        floatVector shapeFunctions, deformationGradient, uQpt, XiQpt;
-        floatVector cauchyQpt, sQpt, mQpt;
-        floatVector pk2Qpt, referenceMicroStressQpt, referenceHigherOrderStressQpt;
+            // Interpolate the nodal values
+            floatType   density;
+            floatVector bodyForce;
+            floatVector acceleration;
 
-        floatMatrix gradShapeFunctions;
+            floatVector bodyCouple;
+            floatVector microSpinInertia;
+            floatVector symmetricMicroStress;
 
-        uIntType qptIndex, row0;
+            element->interpolate( densityAtNodes,      qpt->first, density );
+            element->interpolate( bodyForceAtNodes,    qpt->first, bodyForce );
+            element->interpolate( accelerationAtNodes, qpt->first, acceleration );
 
-        errorOut error = NULL;
+            element->interpolate( bodyCoupleAtNodes,           qpt->first, bodyCouple );
+            element->interpolate( microSpinInertiaAtNodes,     qpt->first, microSpinInertia );
+            element->interpolate( symmetricMicroStressAtNodes, qpt->first, symmetricMicroStress );
 
-        //Loop over the quadrature points
-        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
+            for ( unsigned int j = 0; j < nMacroCellNodes; j++ ){
 
-            //Set the quadrature point index
-            qptIndex = qpt - element->qrule.begin( );
+                //Get the shapefunction value for the node
+                floatType N = shapefunctions[ j ];
 
-            //Evaluate the properties required for the integration
-            error = computeMicromorphicElementRequiredValues( element, qpt, dim, reshapedDOFValues, true,
-                                                              shapeFunctions, gradShapeFunctions,
-                                                              deformationGradient, J, Jxw, uQpt, XiQpt );
+                //Compute the contribution to the node
+                floatVector nLinearMomentumRHS = N * density * ( bodyForce - acceleration ) * Jxw;
 
-            if ( error ){
+                floatVector nFirstMomentRHS = N * ( density * ( bodyCouple - microSpinInertia ) - symmetricMicroStress ) * Jxw;
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the computation of the required values for the element" );
-                result->addNext( error );
-                return result;
+                //Add the contribution to the overall RHS vectors
+                for ( auto it = nLinearMomentumRHS.begin( ); it != nLinearMomentumRHS.end( ); it++ ){
 
-            }
+                    uIntType index = _dim * j + ( it - nLinearMomentumRHS.begin( ) );
 
-            //Pull back the stresses at the quadrature points to the reference configuration
-            cauchyQpt = floatVector( cauchyStress.begin( ) + dim * dim * qptIndex,
-                                     cauchyStress.begin( ) + dim * dim * ( qptIndex + 1 ) );
+                    linearMomentumRHS[ index ] += *it;
 
-            sQpt = floatVector( symmetricMicroStress.begin( ) + dim * dim * qptIndex,
-                                symmetricMicroStress.begin( ) + dim * dim * ( qptIndex + 1 ) );
+                }
 
-            mQpt = floatVector( higherOrderStress.begin( ) + dim * dim * dim * qptIndex,
-                                higherOrderStress.begin( ) + dim * dim * dim * ( qptIndex + 1 ) );
+                for ( auto it = nFirstMomentRHS.begin( ); it != nFirstMomentRHS.end( ); it++ ){
 
-            //Pull back the Cauchy stress
-            error = micromorphicTools::pullBackCauchyStress( cauchyQpt, deformationGradient, pk2Qpt );
+                    uIntType index = _dim * _dim * j + ( it - nFirstMomentRHS.begin( ) );
 
-            if ( error ){
+                    firstMomentRHS[ index ] += *it;
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the pull-back operation on the Cauchy stress" );
-                result->addNext( error );
-                return result;
+                }
 
             }
 
-            //Pull back the symmetric micro-stress
-            error = micromorphicTools::pullBackMicroStress( sQpt, deformationGradient, referenceMicroStressQpt );
-
-            if ( error ){
-
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the pull-back operation on the symmetric micro-stress" );
-                result->addNext( error );
-                return result;
-
-            }
+        }
 
-            //Pull back the higher order stress
-            error = micromorphicTools::pullBackHigherOrderStress( mQpt, deformationGradient, XiQpt, referenceHigherOrderStressQpt );
+        //Add the surface integral components of the right hand side vectors
+        couplingLogger &logger = _inputProcessor.getLogger( );
+        auto formatVector = []( const floatVector &v ) -> std::string {
+            std::ostringstream out;
+            for ( auto vi = v.begin( ); vi != v.end( ); vi++ ){
+                out << *vi << " ";
+            }
+            return out.str( );
+        };
+        uIntType surface_index = 0;
+        for ( auto face_nodes = element->local_surface_node_ids.begin( ); face_nodes != element->local_surface_node_ids.end( ); face_nodes++, surface_index++ ){
+            
+            floatMatrix tractions( element->nodes.size( ), floatVector( _dim, 0 ) );
+            floatMatrix couples( element->nodes.size( ), floatVector( _dim * _dim, 0 ) );
 
-            if ( error ){
+            // Initialize the nodes
+            for ( auto fn = face_nodes->begin( ); fn != face_nodes->end( ); fn++ ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the pull-back operation on the higher order stress" );
-                result->addNext( error );
-                return result;
+                tractions[ *fn ] = tractionAtNodes[ *fn ][ surface_index ];
+                couples[ *fn ] = coupleAtNodes[ *fn ][ surface_index ];
 
             }
 
-            //Loop over the nodes
-            for ( unsigned int n = 0; n < shapeFunctions.size( ); n++ ){
+            COUPLING_LOG( logger, LOG_DEBUG ) << "surface: " << surface_index << "\n";
 
-                //Set the shape function and gradient of the shape function values
-                N = shapeFunctions[ n ];
+            // Begin the surface integration
+            for ( auto s_qpt = element->surface_quadrature_rules[ surface_index ].begin( ); s_qpt != element->surface_quadrature_rules[ surface_index ].end( ); s_qpt++ ){
 
-                for ( unsigned int i = 0; i < dim; i++ ){
+                // Interpolate the traction and couple
+                floatVector traction;
+                floatVector couple;
 
-                    dNdX[ i ] = gradShapeFunctions[ n ][ i ];
+                element->interpolate( tractions, s_qpt->first, traction );
+                element->interpolate( couples, s_qpt->first, couple );
 
-                }
+                COUPLING_LOG( logger, LOG_DEBUG ) << "    traction: " << formatVector( traction ) << "\n"
+                                                  << "    couple:   " << formatVector( couple ) << "\n";
 
-                //Compute the terms for the balance of linear momentum
-                errorCode = balance_equations::compute_internal_force( dNdX, deformationGradient, pk2Qpt, fint );
+                // Compute the shapefunction values
+                floatVector shapefunctions;
+                element->get_shape_functions( s_qpt->first, shapefunctions );
 
-                if ( errorCode != 0 ){
+                // Compute the weighting factor
+                floatMatrix surface_jacobian;
+                error = element->get_local_gradient( element->nodes, s_qpt->first, surface_jacobian );
 
-                    return new errorNode( __func__,
-                                          "The internal force term returned an error code: " + std::to_string( errorCode ) );
+                if ( error ){
+
+                    std::string message = "Error in computing the local gradient of the shape functions for quadrature point "
+                                        + std::to_string( ( unsigned int )( s_qpt - element->surface_quadrature_rules[ surface_index ].begin( ) ) )
+                                        + " on surface " + std::to_string( surfaceNum ) + " for element " + std::to_string( macroCellID );
+                    return new errorNode( __func__, message );
 
                 }
 
-                //Compute the terms for the balance of first moment of momentum
-                errorCode = balance_equations::compute_internal_couple( N, dNdX, deformationGradient, XiQpt,
-                                                                        pk2Qpt, referenceMicroStressQpt,
-                                                                        referenceHigherOrderStressQpt, cint );
+                floatVector inv_jacobian = vectorTools::inverse( vectorTools::appendVectors( surface_jacobian ), _dim, _dim );
+                floatType Jxw = vectorTools::determinant( vectorTools::appendVectors( surface_jacobian ), _dim, _dim ) * s_qpt->second;
+                floatType da = vectorTools::l2norm( vectorTools::Tdot( vectorTools::inflate( inv_jacobian, _dim, _dim ), element->local_surface_normals[ surface_index ] ) * Jxw );
 
-                if ( errorCode != 0 ){
+                COUPLING_LOG( logger, LOG_DEBUG ) << "    surface_jacobian: " << formatVector( vectorTools::appendVectors( surface_jacobian ) ) << "\n"
+                                                  << "    inv_jacobian: " << formatVector( inv_jacobian ) << "\n"
+                                                  << "    Jxw: " << Jxw << "\n"
+                                                  << "    da:  " << da << "\n";
 
-                    return new errorNode( __func__,
-                                          "The internal couple term returned an error code: " + std::to_string( errorCode ) );
+                for ( unsigned int j = 0; j < element->nodes.size( ); j++ ){
 
-                }
+                    // Compute the contribution to the node
+                    floatVector nLinearMomentumRHS = shapefunctions[ j ] * traction * da;
 
-                //Get the initial index
-                auto it = nodeIDToIndex->find( element->global_node_ids[ n ] );
-                
-                if ( it == nodeIDToIndex->end( ) ){
+                    floatVector nFirstMomentRHS = shapefunctions[ j ] * couple * da;
 
-                    return new errorNode( __func__,
-                                          "The global node id " + std::to_string( element->global_node_ids[ n ] ) +
-                                          " is not found in the id to index map" );
+                    //Add the contribution to the overall RHS vectors
+                    for ( auto it = nLinearMomentumRHS.begin( ); it != nLinearMomentumRHS.end( ); it++ ){
+    
+                        uIntType index = _dim * j + ( it - nLinearMomentumRHS.begin( ) );
+    
+                        linearMomentumRHS[ index ] += *it;
+                        externalForcesAtNodes[ macroCellID ][ index ] += *it;
+    
+                    }
+    
+                    for ( auto it = nFirstMomentRHS.begin( ); it != nFirstMomentRHS.end( ); it++ ){
+    
+                        uIntType index = _dim * _dim * j + ( it - nFirstMomentRHS.begin( ) );
+    
+                        firstMomentRHS[ index ] += *it;
+                        externalCouplesAtNodes[ macroCellID ][ index ] += *it;
+    
+                    }
 
                 }
 
-                //Set the row index
-                row0 = ( uSize + phiSize ) * it->second;
+            }
 
-                if ( ( row0 + uSize + phiSize ) > internalForceVector.rows( ) ){
+        }
 
-                    return new errorNode( __func__,
-                                          "The global node id " + std::to_string( element->global_node_ids[ n ] ) +
-                                          " has an index ( " + std::to_string( it->second ) + " ) which results in a index larger than" +
-                                          " the internal force vector size ( " + std::to_string( internalForceVector.rows( ) ) + ")" );
+#ifdef TESTACCESS
 
-                }
+        _test_cellLinearMomentumRHS.emplace( macroCellID, linearMomentumRHS );
+        _test_cellFirstMomentRHS.emplace( macroCellID, firstMomentRHS );
 
-                for ( unsigned int i = 0; i < dim; i++ ){
+#endif
 
-                    internalForceVector( row0 + i, 0 ) -= fint[ i ] * Jxw;
+        //Assemble the LHS matrix
 
-                }
+        //Loop over the quadrature points adding the contribution of each to the LHS matrix
+        //This formulation does not construct the stresses at each of the micro domains but 
+        //rather computes the stresses at the macro domain's Gauss points which enables the
+        //solution of the macro balance equations.
 
-                for ( unsigned int i = 0; i < ( dim * dim ); i++ ){
+        floatType Jxw;
+        floatVector shapeFunctions;
+        floatMatrix dNdx, jacobian;
 
-                    internalForceVector( row0 + i + dim, 0 ) -= cint[ i ] * Jxw;
+        tripletVector coefficients;
+        coefficients.reserve( ( 2 * _dim * _dim + 3 * _dim * _dim ) * element->nodes.size( ) * element->qrule.size( ) );
 
-                }
+        //Quadrature point interpolated values
+        floatVector densities( element->qrule.size( ), 0 );
+        floatMatrix bodyForces( element->qrule.size( ), floatVector( _dim, 0 ) );
+        floatMatrix accelerations( element->qrule.size( ), floatVector( _dim, 0 ) );
+        floatMatrix microInertias( element->qrule.size( ), floatVector( _dim * _dim, 0 ) );
+        floatMatrix bodyCouples( element->qrule.size( ), floatVector( _dim * _dim, 0 ) );
+        floatMatrix microSpinInertias( element->qrule.size( ), floatVector( _dim * _dim, 0 ) );
+        floatMatrix symmetricMicroStress( element->qrule.size( ), floatVector( _dim * _dim, 0 ) );
+        floatMatrix nodalDOFValues( element->nodes.size( ), floatVector( _dim + _dim * _dim, 0 ) );
 
-            }
+        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
 
-        }
+            //Set the index
+            uIntType qptIndex = qpt - element->qrule.begin( );
 
-        return NULL;
-    }
+            //Set the column
+            uIntType col0lm = _dim * _dim * qptIndex;
+            uIntType col0fm = _dim * _dim * element->nodes.size( ) + _dim * _dim * _dim * qptIndex;
 
-    errorOut computeMicromorphicElementRequiredValues( const std::unique_ptr< elib::Element > &element,
-                                                       const elib::quadrature_rule::iterator &qpt,
-                                                       const uIntType dim,
-                                                       const floatMatrix &reshapedDOFValues,
-                                                       const bool useReference,
-                                                       floatVector &shapeFunctions,
-                                                       floatMatrix &gradShapeFunctions,
-                                                       floatVector &deformationGradient,
-                                                       floatType &J, floatType &Jxw,
-                                                       floatVector &uQpt, floatVector &XiQpt ){
-        /*!
-         * Compute the required values for the integration of a micromorphic element
-         */
+            //Get the values of the shape function and the gradients
+            error = element->get_shape_functions( qpt->first, shapeFunctions );
 
-        //Initialize internal variables
-        floatVector interpolatedValues, eye( dim * dim );
-        vectorTools::eye( eye );
+            if ( error ){
 
-        floatMatrix jacobian;
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the computation of the shape functions\n" );
+                result->addNext( error );
+                return result;
 
-        //Evaluate the shape function values
-        errorOut error = element->get_shape_functions( qpt->first, shapeFunctions );
+            }
 
-        if ( error ){
+            //Get the values of the shape function gradients
+            error = element->get_global_shapefunction_gradients( qpt->first, dNdx );
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the computation of the shape functions" );
-            result->addNext( error );
-            return result;
+            if ( error ){
 
-        }
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the computation of the shape function gradients\n" );
+                result->addNext( error );
+                return result;
 
-        //Evaluate the gradients of the shape functions
-        error = element->get_global_shapefunction_gradients( qpt->first, gradShapeFunctions, useReference );
+            }
 
-        if ( error ){
+            //Get the Jacobian of transformation
+            error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the computation of the shape function gradients" );
-            result->addNext( error );
-            return result;
+            if ( error ){
 
-        }
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the computation of the local gradient\n" );
+                result->addNext( error );
+                return result;
 
-        //Get the deformation gradient between the reference and current configurations
-        error = element->get_jacobian( qpt->first, element->reference_nodes, jacobian );
+            }
 
-        if ( error ){
+            Jxw = vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the computation of the jacobian" );
-            result->addNext( error );
-            return result;
+            for ( unsigned int n = 0; n < element->nodes.size( ); n++ ){
 
-        }
+                //Set the row
+                uIntType row0 = _dim * n;
 
-        deformationGradient = vectorTools::appendVectors( jacobian );
-        J = vectorTools::determinant( vectorTools::appendVectors( jacobian ), dim, dim );
+                //Add the balance of linear momentum contributions
+                for ( unsigned int i = 0; i < _dim; i++ ){
 
-        //Get the Jacobian between the local and reference configurations
-        if ( useReference ){
+                    for ( unsigned int j = 0; j < _dim; j++ ){
 
-            error = element->get_local_gradient( element->reference_nodes, qpt->first, jacobian );
+                        coefficients.push_back( DOFProjection::T( row0 + i, col0lm + i + _dim * j, dNdx[ n ][ j ] * Jxw ) );
 
-        }
-        else{
+                    }
 
-            error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
+                }
 
-        }
+                //Add the balance of the first moment of momentum contributions
+                row0 = _dim * element->nodes.size( ) + _dim * _dim * n;
 
-        if ( error ){
+                //Cauchy stress contribution
+                for ( unsigned int i = 0; i < _dim; i++ ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the computation of the local gradient\n" );
-            result->addNext( error );
-            return result;
+                    for ( unsigned int j = 0; j < _dim; j++ ){
 
-        }
+                        coefficients.push_back( DOFProjection::T( row0 + _dim * i + j, col0lm + _dim * j + i, -shapeFunctions[ n ] * Jxw ) );
 
-        Jxw = vectorTools::determinant( vectorTools::appendVectors( jacobian ), dim, dim ) * qpt->second;
+                    }
 
-        //Interpolate the DOF nodes to the node
-        error = element->interpolate( reshapedDOFValues, qpt->first, interpolatedValues );
+                }
 
-        if ( error ){
+                //Higher order stress contribution
+                for ( unsigned int i = 0; i < _dim * _dim; i++ ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the interpolation of the degree of freedom values" );
-            result->addNext( error );
-            return result;
+                    for ( unsigned int j = 0; j < _dim; j++ ){
 
-        }
+                        coefficients.push_back( DOFProjection::T( row0 + i, col0fm + _dim * _dim * j + i, dNdx[ n ][ j ] * Jxw ) );
 
-        if ( interpolatedValues.size( ) < ( dim + dim * dim ) ){
+                    }
 
-            std::string output = "The interpolated values shape is not consistent with the required dimension for the displacement ";
-            output            += "and micro-displacement interpolation";
-            return new errorNode( __func__, output );
+                }
+
+                //Interpolate the nodal values to the quadrature points
+                densities[ qptIndex ]            += shapeFunctions[ n ] * densityAtNodes[ n ];
+                bodyForces[ qptIndex ]           += shapeFunctions[ n ] * bodyForceAtNodes[ n ];
+                accelerations[ qptIndex ]        += shapeFunctions[ n ] * accelerationAtNodes[ n ];
+                microInertias[ qptIndex ]        += shapeFunctions[ n ] * microInertiaAtNodes[ n ];
+                bodyCouples[ qptIndex ]          += shapeFunctions[ n ] * bodyCoupleAtNodes[ n ];
+                microSpinInertias[ qptIndex ]    += shapeFunctions[ n ] * microSpinInertiaAtNodes[ n ];
+                symmetricMicroStress[ qptIndex ] += shapeFunctions[ n ] * symmetricMicroStressAtNodes[ n ];
+
+            }
 
         }
 
-        uQpt = floatVector( interpolatedValues.begin( ), interpolatedValues.begin( ) + dim );
-        XiQpt = eye + floatVector( interpolatedValues.begin( ) + dim, interpolatedValues.begin( ) + ( dim + dim * dim ) );
+        //Form the left-hand side sparse matrix
+        SparseMatrix LHS( ( _dim + _dim * _dim ) * element->nodes.size( ), _dim * _dim * ( 1 + _dim ) * element->qrule.size( ) );
+        LHS.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
 
-        return NULL;
-    }
+#ifdef TESTACCESS
 
-    errorOut overlapCoupling::assembleHomogenizedExternalForceVector( ){
-        /*!
-         * Assemble the homogenized external force vector. This vector doesn't have
-         * any scaling from the coefficients but is just the raw vector.
-         */
+        _test_stressProjectionLHS.emplace( macroCellID, LHS.toDense( ) );
 
-        //Loop over the elements in the external force container
-        std::unique_ptr< elib::Element > element;
-        errorOut error = NULL;
-        const DOFMap *nodeIDToIndex = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+#endif
 
-        //Resize the output vector
-        homogenizedFEXT = Eigen::MatrixXd::Zero( ( _dim + _dim * _dim ) * nodeIDToIndex->size( ), 1 );
+        //Perform the SVD decomposition
+        Eigen::JacobiSVD< Eigen::MatrixXd > svd( LHS.toDense( ), Eigen::ComputeThinU | Eigen::ComputeThinV );
+       
+        //Compute the threshold for the SVD 
+        floatVector logSVec( LHS.rows( ), 0 );
 
-        //Collect all of the cells in the overlapping domain
-        const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
-        const uIntVector *ghostMacroCellIds = _inputProcessor.getGhostMacroCellIds( );
+        Eigen::Map< Eigen::MatrixXd > logS( logSVec.data(), logSVec.size(), 1 );
 
-        uIntVector macroCellIDVector( freeMacroCellIds->begin( ), freeMacroCellIds->end( ) );
-        macroCellIDVector = vectorTools::appendVectors( { macroCellIDVector, *ghostMacroCellIds } );
+        //Compute the singular values
+        logS = svd.singularValues();
 
-        for ( auto macroCellID = macroCellIDVector.begin( ); macroCellID != macroCellIDVector.end( ); macroCellID++ ){
+        for ( unsigned int i = 0; i < logSVec.size( ); i++ ){
 
-            //Make sure that the macroCellID is stored in the external force vector
-            if ( externalForcesAtNodes.find( *macroCellID ) == externalForcesAtNodes.end( ) ){
+            logSVec[ i ] = std::log10( logSVec[ i ] + _absoluteTolerance );
 
-                return new errorNode( __func__,
-                                      "Macro cell ID " + std::to_string( *macroCellID ) +
-                                      " not found in external forces at nodes." );
+        }
 
-            }
+        //Determine where the "shelf" in the singular values occurs
+        uIntVector outliers;
 
-            //Make sure that the macroCellID is stored in the external couple vector
-            if ( externalCouplesAtNodes.find( *macroCellID ) == externalCouplesAtNodes.end( ) ){
+        MADOutlierDetection( logSVec, outliers, 10 );
 
-                return new errorNode( __func__,
-                                      "Macro cell ID " + std::to_string( *macroCellID ) +
-                                      " not found in external couples at nodes." );
+        if ( outliers.size( ) > 0 ){
 
-            }
+            svd.setThreshold( std::max( pow( 10, logSVec[ outliers[ 0 ] ] ), _absoluteTolerance ) );
 
-            //Form the macro element
-            error = buildMacroDomainElement( *macroCellID,
-                                             *_inputProcessor.getMacroNodeReferencePositions( ),
-                                             *_inputProcessor.getMacroDisplacements( ),
-                                             *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                             element );
-
-            if ( error ){
-
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the construction of the macro domain element for macro cell " +
-                                                 std::to_string( *macroCellID ) );
-                result->addNext( error );
-                return result;
+        }
+        else{
 
-            }
+            svd.setThreshold( _absoluteTolerance );
 
-            //Loop over the external node ids
+        }
 
-            for ( auto globalNodeID = element->global_node_ids.begin( );
-                      globalNodeID != element->global_node_ids.end( );
-                      globalNodeID++ ){
+        floatVector rhsVec = vectorTools::appendVectors( { linearMomentumRHS, firstMomentRHS } );
 
-                //Get the element nodal index
-                uIntType elementNodeIndex = globalNodeID - element->global_node_ids.begin( );
+        Eigen::Map< Eigen::MatrixXd > RHS( rhsVec.data( ), rhsVec.size( ), 1 ); 
 
-                auto index = nodeIDToIndex->find( *globalNodeID );
+        //Solve for the stresses
+        Eigen::MatrixXd x = svd.solve( RHS );
 
-                if ( index == nodeIDToIndex->end( ) ){
+        //Extract the stresses at the evaluation points
+        uIntType nCauchy = _dim * _dim;
+        uIntType nHigherOrder = _dim * _dim * _dim;
 
-                    return new errorNode( __func__,
-                                          "Macro global node " + std::to_string( *globalNodeID ) +
-                                          " not found in the id to index map" );
+        uIntType nEvaluationPoints = x.size( ) / ( nCauchy + nHigherOrder );
 
-                }
+        floatVector cauchyStresses( _dim * _dim * nEvaluationPoints );
+        floatVector higherOrderStresses( _dim * _dim * _dim * nEvaluationPoints );
 
-                for ( unsigned int i = 0; i < _dim; i++ ){
+        for ( unsigned int n = 0; n < nEvaluationPoints; n++ ){
 
-                    homogenizedFEXT( ( _dim + _dim * _dim ) * index->second + i, 0 )
-                        += externalForcesAtNodes[ *macroCellID ][ _dim * elementNodeIndex + i ];
+            for ( unsigned int i = 0; i < nCauchy; i++ ){
 
-                }
+                cauchyStresses[ nCauchy * n + i ] = x( nCauchy * n + i );
 
-                for ( unsigned int i = 0; i < _dim * _dim; i++ ){
+            }
 
-                    homogenizedFEXT( ( _dim + _dim * _dim ) * index->second + i + _dim, 0 )
-                        += externalCouplesAtNodes[ *macroCellID ][ _dim * _dim * elementNodeIndex + i ];
+            for ( unsigned int i = 0; i < nHigherOrder; i++ ){
 
-                }
+                higherOrderStresses[ nHigherOrder * n + i ] = x( nEvaluationPoints * nCauchy + nHigherOrder * n + i );
 
             }
 
         }
 
+        quadraturePointCauchyStress.emplace( macroCellID, cauchyStresses );
+        quadraturePointHigherOrderStress.emplace( macroCellID, higherOrderStresses );
+
+        //Emplace the values at the quadrature points
+        quadraturePointDensities.emplace( macroCellID, densities );
+        quadraturePointBodyForce.emplace( macroCellID, vectorTools::appendVectors( bodyForces ) );
+        quadraturePointAccelerations.emplace( macroCellID, vectorTools::appendVectors( accelerations ) );
+        quadraturePointMicroInertias.emplace( macroCellID, vectorTools::appendVectors( microInertias ) );
+        quadraturePointBodyCouples.emplace( macroCellID, vectorTools::appendVectors( bodyCouples ) );
+        quadraturePointMicroSpinInertias.emplace( macroCellID, vectorTools::appendVectors( microSpinInertias ) );
+        quadraturePointSymmetricMicroStress.emplace( macroCellID, vectorTools::appendVectors( symmetricMicroStress ) );
+
         return NULL;
 
     }
 
-    errorOut overlapCoupling::assembleHomogenizedInternalForceVector( ){
+    const cellDomainFloatMap* overlapCoupling::getReferenceFreeMicroDomainMasses( ){
         /*!
-         * Assemble the homogenized internal force vector.
-         *
+         * Get access to the reference free micro-domain mass
          */
 
-        //Loop over the elements in the external force container
-        std::unique_ptr< elib::Element > element;
-        errorOut error = NULL;
-        const DOFMap *nodeIDToIndex = _inputProcessor.getMacroGlobalToLocalDOFMap( );
-
-        //Set the number of displacement degrees of freedom
-        unsigned int nMacroDispDOF = _dim + _dim * _dim;
-
-        //Get the free and ghost macro node ids
-        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
-        const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
-
-        //Assemble the free macro node degree of freedom vector
-        floatVector freeMacroDisplacements( nMacroDispDOF * freeMacroNodeIds->size( ) );
-
-        const std::unordered_map< uIntType, floatVector > *macroDispDOFVector = _inputProcessor.getMacroDispDOFVector( );
-        for ( auto it = freeMacroNodeIds->begin( ); it != freeMacroNodeIds->end( ); it++ ){
+        return &_referenceFreeMicroDomainMasses;
+    }
 
-            auto map = _inputProcessor.getMacroGlobalToLocalDOFMap( )->find( *it );
+    const cellDomainFloatMap* overlapCoupling::getReferenceGhostMicroDomainMasses( ){
+        /*!
+         * Get access to the reference ghost micro-domain masses
+         */
 
-            if ( map == _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( ) ){
+        return &_referenceGhostMicroDomainMasses;
+    }
 
-                return new errorNode( __func__,
-                                      "Global degree of freedom '" + std::to_string( *it ) + "' not found in degree of freedom map" );
+    const cellDomainFloatVectorMap* overlapCoupling::getReferenceFreeMicroDomainCentersOfMass( ){
+        /*!
+         * Get access to the reference free micro-domain centers of mass
+         */
 
-            }
+        return &_referenceFreeMicroDomainCentersOfMass;
+    }
 
-            auto macroDisplacement = macroDispDOFVector->find( *it );
+    const cellDomainFloatVectorMap* overlapCoupling::getReferenceGhostMicroDomainCentersOfMass( ){
+        /*!
+         * Get access to the reference ghost micro-domain centers of mass
+         */
 
-            if ( macroDisplacement == macroDispDOFVector->end( ) ){
+        return &_referenceGhostMicroDomainCentersOfMass;
+    }
 
-                return new errorNode( __func__,
-                                      "Global macro degree of freedom '" + std::to_string( *it ) + "' not found in the macro displacement dof map" );
+    const cellDomainFloatVectorMap* overlapCoupling::getReferenceFreeMicroDomainMomentsOfInertia( ){
+        /*!
+         * Get access to the reference free micro-domain moments of inertia
+         */
 
-            }
+        return &_referenceFreeMicroDomainMomentsOfInertia;
+    }
 
-            //Set the macro displacements
-            for ( unsigned int i = 0; i < nMacroDispDOF; i++ ){
+    const cellDomainFloatVectorMap* overlapCoupling::getReferenceGhostMicroDomainMomentsOfInertia( ){
+        /*!
+         * Get access to the reference ghost micro-domain moments of inertia
+         */
 
-                freeMacroDisplacements[ nMacroDispDOF * ( map->second ) + i ] = macroDisplacement->second[ i ];
+        return &_referenceGhostMicroDomainMomentsOfInertia;
+    }
 
-            }
+    const domainFloatMap* overlapCoupling::getFreeMicroDomainMasses( ){
+        /*!
+         * Get access to the free micro-domain mass
+         */
 
-        }
+        return &_freeMicroDomainMasses;
+    }
 
-        //Resize the output vector
-        homogenizedFINT = Eigen::MatrixXd::Zero( nMacroDispDOF * nodeIDToIndex->size( ), 1 );
+    const domainFloatMap* overlapCoupling::getGhostMicroDomainMasses( ){
+        /*!
+         * Get access to the ghost micro-domain masses
+         */
 
-        //Loop over the macro cells
-        floatVector elementDOFVector;
+        return &_ghostMicroDomainMasses;
+    }
 
-        //Collect all of the cells in the overlapping domain
-        const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
-        const uIntVector *ghostMacroCellIds = _inputProcessor.getGhostMacroCellIds( );
+    const domainFloatVectorMap* overlapCoupling::getFreeMicroDomainCentersOfMass( ){
+        /*!
+         * Get access to the free micro-domain centers of mass
+         */
 
-        uIntVector macroCellIDVector( freeMacroCellIds->begin( ), freeMacroCellIds->end( ) );
-        macroCellIDVector = vectorTools::appendVectors( { macroCellIDVector, *ghostMacroCellIds } );
+        return &_freeMicroDomainCentersOfMass;
+    }
 
-        for ( auto macroCellID = macroCellIDVector.begin( ); macroCellID != macroCellIDVector.end( ); macroCellID++ ){
+    const domainFloatVectorMap* overlapCoupling::getGhostMicroDomainCentersOfMass( ){
+        /*!
+         * Get access to the ghost micro-domain centers of mass
+         */
 
-            //Form the macro element
-            error = buildMacroDomainElement( *macroCellID,
-                                             *_inputProcessor.getMacroNodeReferencePositions( ),
-                                             *_inputProcessor.getMacroDisplacements( ),
-                                             *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                             element );
+        return &_ghostMicroDomainCentersOfMass;
+    }
 
-            if ( error ){
+    const cellDomainFloatVectorMap* overlapCoupling::getReferenceFreeMicroDomainCenterOfMassShapeFunctions( ){
+        /*!
+         * Get access to the shapefunction values of the reference free micro domain centers of mass
+         */
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the construction of the macro domain element for macro cell " +
-                                                 std::to_string( *macroCellID ) );
-                result->addNext( error );
-                return result;
+        return &_referenceFreeMicroDomainCenterOfMassShapeFunctions;
+    }
 
-            }
-            
-            //Extract the homogenized degrees of freedom for the element
+    const cellDomainFloatVectorMap* overlapCoupling::getReferenceGhostMicroDomainCenterOfMassShapeFunctions( ){
+        /*!
+         * Get access to the shapefunction values of the reference ghost micro domain centers of mass
+         */
 
-            floatVector nodeDOF;
-            elementDOFVector.clear( );
-            elementDOFVector.reserve( nMacroDispDOF * element->nodes.size( ) );
+        return &_referenceGhostMicroDomainCenterOfMassShapeFunctions; 
+    }
 
-            for ( auto nodeID = element->global_node_ids.begin( ); nodeID != element->global_node_ids.end( ); nodeID++ ){
+    const floatVector* overlapCoupling::getProjectedGhostMacroDisplacement( ){
+        /*!
+         * Get access to the projected ghost macro displacements
+         */
 
-                //Find the node in the global to local map
-                auto index = nodeIDToIndex->find( *nodeID );
+        return &_projected_ghost_macro_displacement;
+    }
 
-                if ( index == nodeIDToIndex->end( ) ){
+    const floatVector* overlapCoupling::getProjectedGhostMicroDisplacement( ){
+        /*!
+         * Get access to the projected ghost macro displacements
+         */
 
-                    return new errorNode( __func__,
-                                          "Macro-scale node with global id " + std::to_string( *nodeID ) +
-                                          " is not found in the global ID to the local index" );
+        return &_projected_ghost_micro_displacement;
+    }
 
-                }
+    errorOut MADOutlierDetection( const floatVector &x, uIntVector &outliers, const floatType threshold,
+                                  const floatType eps ){
+        /*!
+         * Detect outliers using median absolute deviation
+         * MAD = median ( | X_i - median(X) | )
+         *
+         * :param const floatVector &x: The x vector to search for outliers
+         * :param uIntVector> &outliers: The vector of outliers
+         * :param const floatType threshold: The threshold with which to identify an outlier. Defaults to 10.
+         * :param const floatType eps: The minimum allowable value for MAD
+         */
 
-                //Check if the macro-node is free
-                auto freeNodeID = std::find( freeMacroNodeIds->begin( ), freeMacroNodeIds->end( ), *nodeID );
+        floatType median = vectorTools::median(x);
 
-                if ( freeNodeID != freeMacroNodeIds->end( ) ){
+        floatVector absDeviations = vectorTools::abs(x - median);
 
-                    //Extract the degrees of freedom from the free node
-                    nodeDOF = floatVector( freeMacroDisplacements.begin( ) + ( nMacroDispDOF ) * ( index->second ),
-                                           freeMacroDisplacements.begin( ) + ( nMacroDispDOF ) * ( index->second + 1 ) );
+        floatType MAD = vectorTools::median(absDeviations) + eps;
 
-                }
-                else{
+        absDeviations /= MAD;
 
-                    auto ghostNodeID = std::find( ghostMacroNodeIds->begin( ), ghostMacroNodeIds->end( ), *nodeID );
+        outliers.resize(0);
+        outliers.reserve(x.size() / 10);
 
-                    if ( ghostNodeID != ghostMacroNodeIds->end( ) ){
+        for ( unsigned int i = 0; i < absDeviations.size( ); i++ ){
 
-                        //Extract the degrees of freedom from the ghost node
-                        nodeDOF = floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDispDOF * ( index->second - _inputProcessor.getFreeMacroNodeIds( )->size( ) ),
-                                               _projected_ghost_macro_displacement.begin( ) + nMacroDispDOF * ( index->second + 1 - _inputProcessor.getFreeMacroNodeIds( )->size( ) ) );
+            if ( absDeviations[ i ] > threshold ){
 
-                    }
-                    else{
+                outliers.push_back(i);
 
-                        return new errorNode( __func__,
-                                              "The macro node " + std::to_string( *nodeID ) +
-                                              " is not found in either the ghost or free macro node IDs" );
+            }
 
-                    }
+        }
 
-                }
+        return NULL;
+    }
 
-                //Save the element DOF vector
-                for ( unsigned int i = 0; i < nodeDOF.size( ); i++ ){
-
-                    elementDOFVector.push_back( nodeDOF[ i ] );
+    errorOut formMicromorphicElementMassMatrix( const std::unique_ptr< elib::Element > &element,
+                                                const floatVector &degreeOfFreedomValues,
+                                                const floatVector &momentOfInertia,
+                                                const floatVector &density,
+                                                const DOFMap *nodeIDToIndex,
+                                                tripletVector &coefficients,
+                                                const floatVector *arlequinNodalWeights,
+                                                const bool quantitiesInReference ){
+        /*!
+         * Form the micromorphic mass matrix for an element owned by the caller
+         *
+         * :param const std::unique_ptr< elib::Element > &element: The element to form the mass matrix of
+         *
+         * The remaining parameters are the same as for the element pointer version
+         */
 
-                }
+        return formMicromorphicElementMassMatrix( element.get( ), degreeOfFreedomValues, momentOfInertia, density,
+                                                  nodeIDToIndex, coefficients, arlequinNodalWeights, quantitiesInReference );
+    }
 
-            }
+    errorOut formMicromorphicElementMassMatrix( elib::Element *element,
+                                                const floatVector &degreeOfFreedomValues,
+                                                const floatVector &momentOfInertia,
+                                                const floatVector &density,
+                                                const DOFMap *nodeIDToIndex,
+                                                tripletVector &coefficients,
+                                                const floatVector *arlequinNodalWeights,
+                                                const bool quantitiesInReference ){
+        /*!
+         * Form the micromorphic mass matrix for an element
+         *
+         * :param elib::Element *element: The element to form the mass matrix of
+         * :param const floatVector &degreeOfFreedomValues: The degree of freedom values at the element nodes
+         * :param const floatVector &momentOfInertia: The moment of inertia in the current configuration
+         *     at the quadrature points ordered as [ i1_11, i1_12, i1_13, i1_21, ... , i2_11, i2_12, ... ] 
+         *     where the first index is the quadrature point and the second indices are the indices of the
+         *     moment of inertia tensor.
+         * :param const floatVector &density: The density in the current configuration
+         *     at the quadrature points
+         * :param const DOFMap &nodeIDToIndex: A map from the node id's to the DOF index
+         * :param tripletVector &coefficients: The coefficients of the mass matrix
+         * :param const floatVector *arlequinNodalWeights: The weights of the nodes for the Arlequin method.
+         *     Defaults to NULL.
+         * :param const bool floatVector: Flag for if the density and moments of inerta are actually defined
+         *     in the reference configuration.
+         */
 
-            error = formMicromorphicElementInternalForceVector( element, elementDOFVector,
-                                                                quadraturePointCauchyStress[ *macroCellID ],
-                                                                quadraturePointSymmetricMicroStress[ *macroCellID ],
-                                                                quadraturePointHigherOrderStress[ *macroCellID ],
-                                                                nodeIDToIndex, homogenizedFINT );
+        //Get the dimension of the element
+        uIntType dim = element->nodes[ 0 ].size( );
 
-            if ( error ){
+        const uIntType uSize   = dim;
+        const uIntType phiSize = dim * dim;
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the assembly of the terms of the internal force vector for element " +
-                                                 std::to_string( *macroCellID ) );
-                result->addNext( error );
-                return result;
+        //Check that the degree of freedom value vector's length is consistent with the element
+        if ( degreeOfFreedomValues.size( ) != ( uSize + phiSize ) * element->nodes.size( ) ){
 
-            }
+            return new errorNode( __func__,
+                                  "The degree of freedom vector size is not consistent with the element dimension" );
 
         }
 
-        return NULL;
+        if ( momentOfInertia.size( ) != element->qrule.size( ) * phiSize ){
 
-    }
+            return new errorNode( __func__,
+                                  "The moment of inertia vector size is not consistent with the quadrature rule and element dimension" );
 
-    errorOut overlapCoupling::assembleHomogenizedMassMatrix( ){
-        /*!
-         * Assemble the homogenized mass matrix.
-         */
+        }
 
-        //Loop over the elements in the external force container
-        std::unique_ptr< elib::Element > element;
-        errorOut error = NULL;
-        const DOFMap *nodeIDToIndex = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+        if ( density.size( ) != element->qrule.size( ) ){
 
-        //Set the number of displacement degrees of freedom
-        unsigned int nMacroDispDOF = _dim + _dim * _dim;
+            return new errorNode( __func__,
+                                  "The density vector size is not consistent with the quadrature rule" );
 
-        //Get the free and ghost macro node ids
-        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
-        const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
+        }
 
-        //Assemble the free macro node degree of freedom vector
-        floatVector freeMacroDisplacements( nMacroDispDOF * freeMacroNodeIds->size( ) );
+        if ( element->global_node_ids.size( ) != element->nodes.size( )  ){
 
-        const std::unordered_map< uIntType, floatVector > *macroDispDOFVector = _inputProcessor.getMacroDispDOFVector( );
-        for ( auto it = freeMacroNodeIds->begin( ); it != freeMacroNodeIds->end( ); it++ ){
+            return new errorNode( __func__,
+                                  "The size of the global node id in the element are not the same size as the number of nodes" );
 
-            auto map = _inputProcessor.getMacroGlobalToLocalDOFMap( )->find( *it );
+        }
 
-            if ( map == _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( ) ){
+        //Reshape the degree of freedom values to a matrix of values where the rows are the values at the nodes
+        floatMatrix reshapedDOFValues = vectorTools::inflate( degreeOfFreedomValues, element->nodes.size( ), uSize + phiSize );
 
-                return new errorNode( __func__,
-                                      "Global degree of freedom '" + std::to_string( *it ) + "' not found in degree of freedom map" );
+        //Variable initialize
+        floatVector shapeFunctions;
+        floatVector interpolatedValues, deformationGradient;
+        floatType qptDensity, referenceDensity;
+        floatVector qptMomentOfInertia;
+        floatVector uQpt, XiQpt, invXiQpt, referenceMomentOfInertia, inertiaTerm;
+        floatMatrix gradShapeFunctions;
 
-            }
+        floatVector eye( dim * dim );
+        vectorTools::eye( eye );
 
-            auto macroDisplacement = macroDispDOFVector->find( *it );
+        floatType J, Jxw, sFo, sFp;
+        uIntType qptIndex, row0, col0;
+        errorOut error = NULL;
 
-            if ( macroDisplacement == macroDispDOFVector->end( ) ){
+        //Loop over the quadrature points
+        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
 
-                return new errorNode( __func__,
-                                      "Global macro degree of freedom '" + std::to_string( *it ) + "' not found in the macro displacement dof map" );
+            //Set the quadrature point index
+            qptIndex = qpt - element->qrule.begin( );
 
-            }
+            //Compute the base micromorphic element terms
+            error = computeMicromorphicElementRequiredValues( element, qpt, dim, reshapedDOFValues, true,
+                                                              shapeFunctions, gradShapeFunctions,
+                                                              deformationGradient, J, Jxw, uQpt, XiQpt );
 
-            //Set the macro displacements
-            for ( unsigned int i = 0; i < nMacroDispDOF; i++ ){
+            if ( error ){
 
-                freeMacroDisplacements[ nMacroDispDOF * ( map->second ) + i ] = macroDisplacement->second[ i ];
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the computation of the required values for the element" );
+                result->addNext( error );
+                return result;
 
             }
 
-        }
-
-        //Loop over the macro cells adding the contributions to the mass matrix
-        floatVector elementDOFVector;
-
-        //Collect all of the cells in the overlapping domain
-        const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
-        const uIntVector *ghostMacroCellIds = _inputProcessor.getGhostMacroCellIds( );
-
-        uIntVector macroCellIDVector( freeMacroCellIds->begin( ), freeMacroCellIds->end( ) );
-        macroCellIDVector = vectorTools::appendVectors( { macroCellIDVector, *ghostMacroCellIds } );
+            invXiQpt = vectorTools::inverse( XiQpt, dim, dim );
 
-        tripletVector coefficients;
+            //Get the current density
+            qptDensity = density[ qptIndex ];
 
-        uIntType numCoefficients = 0;
-        for ( auto it = externalForcesAtNodes.begin( ); it != externalForcesAtNodes.end( ); it++ ){
+            //Compute the moment of inertia in the reference configuration
+            qptMomentOfInertia = floatVector( momentOfInertia.begin( ) + dim * dim * qptIndex,
+                                              momentOfInertia.begin( ) + dim * dim * ( qptIndex + 1 ) );
 
-            //Get the number of quadrature points in the element
-            uIntType elementQuadraturePointCount = quadraturePointDensities[ it->first ].size( );
+            if ( quantitiesInReference ){
 
-            //Get the number of nodes in the element
-            uIntType elementNodeCount = it->second.size( ) / _dim;
-            numCoefficients += elementQuadraturePointCount * elementNodeCount * elementNodeCount * _dim * _dim * ( 1 + _dim * _dim );
+                referenceDensity = qptDensity;
+                referenceMomentOfInertia = qptMomentOfInertia;
 
-        }
+            }
+            else{
 
-        coefficients.reserve( numCoefficients );
+                referenceDensity = J * qptDensity;
+                referenceMomentOfInertia
+                    = vectorTools::matrixMultiply( vectorTools::matrixMultiply( invXiQpt, qptMomentOfInertia, dim, dim, dim, dim ),
+                                                   invXiQpt, dim, dim, dim, dim, false, true );
 
-        for ( auto macroCellID = macroCellIDVector.begin( ); macroCellID != macroCellIDVector.end( ); macroCellID++ ){
+            }
 
-            //Form the macro element
-            error = buildMacroDomainElement( *macroCellID,
-                                             *_inputProcessor.getMacroNodeReferencePositions( ),
-                                             *_inputProcessor.getMacroDisplacements( ),
-                                             *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                             element );
+            //Evaluate the integrand term
+            inertiaTerm = referenceDensity * referenceMomentOfInertia * Jxw;
 
-            if ( error ){
+            floatType arlequinWeight = 1;
+            if ( arlequinNodalWeights ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the construction of the macro domain element for macro cell " +
-                                                 std::to_string( *macroCellID ) );
-                result->addNext( error );
-                return result;
+                element->interpolate( *arlequinNodalWeights, qpt->first, arlequinWeight );
 
             }
 
-            //Extract the homogenized degrees of freedom for the element
-            floatVector nodeDOF;
-            elementDOFVector.clear( );
-            elementDOFVector.reserve( nMacroDispDOF * element->nodes.size( ) );
+            //Add the contrubutions to the mass matrix
+            for ( uIntType o = 0; o < shapeFunctions.size( ); o++ ){
 
-            for ( auto nodeID = element->global_node_ids.begin( ); nodeID != element->global_node_ids.end( ); nodeID++ ){
+                sFo = shapeFunctions[ o ];
 
-                //Find the node in the global to local map
-                auto index = nodeIDToIndex->find( *nodeID );
+                auto gni1 = nodeIDToIndex->find( element->global_node_ids[ o ] );
 
-                if ( index == nodeIDToIndex->end( ) ){
+                if ( gni1 == nodeIDToIndex->end( ) ){
 
                     return new errorNode( __func__,
-                                          "Macro-scale node with global id " + std::to_string( *nodeID ) +
-                                          " is not found in the global ID to the local index" );
+                                          "Node " + std::to_string( element->global_node_ids[ o ] ) + " not found in the ID map" );
+                                          
 
                 }
 
-                //Check if the macro-node is free
-                auto freeNodeID = std::find( freeMacroNodeIds->begin( ), freeMacroNodeIds->end( ), *nodeID );
+                row0 = ( uSize + phiSize ) * gni1->second;
 
-                if ( freeNodeID != freeMacroNodeIds->end( ) ){
+                for ( uIntType p = 0; p < shapeFunctions.size( ); p++ ){
 
-                    //Extract the degrees of freedom from the free node
-                    nodeDOF = floatVector( freeMacroDisplacements.begin( ) + ( nMacroDispDOF ) * ( index->second ),
-                                           freeMacroDisplacements.begin( ) + ( nMacroDispDOF ) * ( index->second + 1 ) );
+                    sFp = shapeFunctions[ p ];
 
-                }
-                else{
+                    auto gni2 = nodeIDToIndex->find( element->global_node_ids[ p ] );
 
-                    auto ghostNodeID = std::find( ghostMacroNodeIds->begin( ), ghostMacroNodeIds->end( ), *nodeID );
+                    if ( gni2 == nodeIDToIndex->end( ) ){
+    
+                        return new errorNode( __func__,
+                                              "Node " + std::to_string( element->global_node_ids[ p ] ) + " not found in the ID map" );
+                                              
+    
+                    }
+    
+                    col0 = ( uSize + phiSize ) * gni2->second;
 
-                    if ( ghostNodeID != ghostMacroNodeIds->end( ) ){
+                    for ( unsigned int j = 0; j < dim; j++ ){
 
-                        //Extract the degrees of freedom from the ghost node
-                        nodeDOF = floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDispDOF * ( index->second - _inputProcessor.getFreeMacroNodeIds( )->size( ) ),
-                                               _projected_ghost_macro_displacement.begin( ) + nMacroDispDOF * ( index->second + 1 - _inputProcessor.getFreeMacroNodeIds( )->size( ) ) );
+                        for ( unsigned int k = 0; k < dim; k++ ){
 
-                    }
-                    else{
+                            coefficients.push_back( DOFProjection::T( row0 + j,
+                                                                      col0 + k,
+                                                                      arlequinWeight * eye[ dim * j + k ] * referenceDensity * sFo * sFp * Jxw ) );
+    
+                            for ( unsigned int K = 0; K < dim; K++ ){
+    
+                                for ( unsigned int L = 0; L < dim; L++ ){
+    
+                                    coefficients.push_back( DOFProjection::T( row0 + dim + dim * j + K,
+                                                                              col0 + dim + dim * k + L,
+                                                                              arlequinWeight * eye[ dim * j + k ] * sFo * sFp * inertiaTerm[ dim * K + L ] ) );
 
-                        return new errorNode( __func__,
-                                              "The macro node " + std::to_string( *nodeID ) +
-                                              " is not found in either the ghost or free macro node IDs" );
+                                }
+    
+                            }
+
+                        }
 
                     }
 
                 }
 
-                //Save the element DOF vector
-                for ( unsigned int i = 0; i < nodeDOF.size( ); i++ ){
+            }
 
-                    elementDOFVector.push_back( nodeDOF[ i ] );
+        }
 
-                }
+        return NULL;
+    }
 
-            }
-
-            //Add the contributions to the mass matrix
-            error = formMicromorphicElementMassMatrix( element, elementDOFVector,
-                                                       quadraturePointMicroInertias[ *macroCellID ],
-                                                       quadraturePointDensities[ *macroCellID ],
-                                                       nodeIDToIndex, coefficients );
-
-        }
-
-        homogenizedMassMatrix = SparseMatrix( ( _dim + _dim * _dim ) * nodeIDToIndex->size( ),
-                                              ( _dim + _dim * _dim ) * nodeIDToIndex->size( ) );
-        homogenizedMassMatrix.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
-
-        return NULL;
+    errorOut formMicromorphicElementInternalForceVector( const std::unique_ptr< elib::Element > &element,
+                                                         const floatVector &degreeOfFreedomValues,
+                                                         const floatVector &cauchyStress,
+                                                         const floatVector &symmetricMicroStress,
+                                                         const floatVector &higherOrderStress,
+                                                         const DOFMap *nodeIDToIndex,
+                                                         Eigen::MatrixXd &internalForceVector ){
+        /*!
+         * Form the micromorphic internal force vector for an element owned by the caller
+         *
+         * :param const std::unique_ptr< elib::Element > &element: The FEA representation of the micromorphic element
+         *
+         * The remaining parameters are the same as for the element pointer version
+         */
 
+        return formMicromorphicElementInternalForceVector( element.get( ), degreeOfFreedomValues, cauchyStress,
+                                                           symmetricMicroStress, higherOrderStress, nodeIDToIndex,
+                                                           internalForceVector );
     }
 
-    errorOut overlapCoupling::assembleHomogenizedMatricesAndVectors( ){
+    errorOut formMicromorphicElementInternalForceVector( elib::Element *element,
+                                                         const floatVector &degreeOfFreedomValues,
+                                                         const floatVector &cauchyStress,
+                                                         const floatVector &symmetricMicroStress,
+                                                         const floatVector &higherOrderStress,
+                                                         const DOFMap *nodeIDToIndex,
+                                                         Eigen::MatrixXd &internalForceVector ){
         /*!
-         * Assemble the homogenized mass matrices and force vectors
+         * Add the contribution of the micromorphic element to the internal force vector
+         *
+         * TODO: This function is considerably more complicated than it needs to be so that it
+         *       uses the functions in the micromorphic balance equations library. We don't have to
+         *       do this and it would make the function shorter and probably faster.
+         *
+         * :param elib::Element *element: The FEA representation of the micromorphic element
+         * :param const floatVector &degreeOfFreedomValues: The values of the degrees of freedom at the nodes of the element
+         * :param const floatVector &cauchyStress: The cauchy stress at the quadrature points of the element
+         *     ( current configuration )
+         * :param const floatVector &symmetricMicroStress: The symmetric micro-stress at the quadrature points of the element
+         *     ( current configuration )
+         * :param const floatVector &higherOrderStress: The higher-order stress at the quadrature points of the element
+         *     ( current configuraiton )
+         * :param const DOFMap *nodeIDToIndex: The map from the global node ids to the ordering in the internal force vector
+         * :param Eigen::MatrixXd &internalForceVector: The internal force vector to be populated.
          */
 
-        errorOut error = assembleHomogenizedExternalForceVector( );
+        //Get the dimension of the element
+        uIntType dim = element->nodes[ 0 ].size( );
 
-        if ( error ){
+        const uIntType uSize   = dim;
+        const uIntType phiSize = dim * dim;
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the construction of the homogenized external force vector" );
-            result->addNext( error );
-            return result;
+        if ( dim != 3 ){
 
-        }
+            std::string output  = "The dimension of the problem is required to be 3. This only matters ( it is believed )\n";
+            output             += "because of dNdX, fint, and cint which are currently consistent with a 3D problem as required\n";
+            output             += "by balance_equations.h";
+            return new errorNode( __func__, output );
 
-        error = assembleHomogenizedInternalForceVector( );
+        }
 
-        if ( error ){
+        //Check that the degree of freedom value vector's length is consistent with the element
+        if ( degreeOfFreedomValues.size( ) != ( uSize + phiSize ) * element->nodes.size( ) ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the construction of the homogenized internal force vector" );
-            result->addNext( error );
-            return result;
+            return new errorNode( __func__,
+                                  "The degree of freedom vector size is not consistent with the element dimension" );
 
         }
 
-        error = assembleHomogenizedMassMatrix( );
+        if ( cauchyStress.size( ) != element->qrule.size( ) * dim * dim ){
 
-        if ( error ){
+            return new errorNode( __func__,
+                                  "The Cauchy stress vector size is not consistent with the quadrature rule and element dimension" );
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the construction of the homogenized mass matrix" );
-            result->addNext( error );
-            return result;
+        }
+
+        if ( symmetricMicroStress.size( ) != element->qrule.size( ) * dim * dim ){
+
+            return new errorNode( __func__,
+                                  "The symmetric micro-stress vector size is not consistent with the quadrature rule" );
 
         }
 
-        return NULL;
+        if ( higherOrderStress.size( ) != element->qrule.size( ) * dim * dim * dim ){
 
-    }
+            return new errorNode( __func__,
+                                  "The higher-order stress vector size is not consistent with the quadrature rule" );
 
-    errorOut overlapCoupling::assembleFreeMicromorphicMassMatrix( ){
-        /*!
-         * Assemble the micromorphic mass matrix for the free micromorphic domains.
-         *
-         * It is noted that while we are only processing the free micromorphic domains,
-         * there WILL be ghost nodes because even though a micromorphic domain may be
-         * marked as free, some of the nodes can ( and will in the current framework )
-         * be ghost.
-         */
+        }
 
-        //Set the displacement degrees of freedom for the element
-        const unsigned int nMacroDOF = _dim + _dim * _dim;
+        if ( element->global_node_ids.size( ) != element->nodes.size( )  ){
 
-        //Get the micromorphic densities in the reference configuration
-        const std::unordered_map< uIntType, std::string > *macroReferenceDensityTypes = _inputProcessor.getMacroReferenceDensityTypes( );
-        const std::unordered_map< uIntType, floatVector > *macroReferenceDensities = _inputProcessor.getMacroReferenceDensities( );
+            return new errorNode( __func__,
+                                  "The size of the global node id in the element are not the same size as the number of nodes" );
 
-        //Get the micromorphic moments of inertia in the reference configuration
-        const std::unordered_map< uIntType, std::string > *macroReferenceMomentOfInertiaTypes
-            = _inputProcessor.getMacroReferenceMomentOfInertiaTypes( );
-        const std::unordered_map< uIntType, floatVector > *macroReferenceMomentsOfInertia
-            = _inputProcessor.getMacroReferenceMomentsOfInertia( );
+        }
 
-        //Initialize the coefficients vector
-        tripletVector coefficients;
+        //Reshape the degree of freedom values to a matrix of values where the rows are the values at the nodes
+        floatMatrix reshapedDOFValues = vectorTools::inflate( degreeOfFreedomValues, element->nodes.size( ), uSize + phiSize );
 
-        uIntType numCoefficients = 0;
-        for ( auto it = externalForcesAtNodes.begin( ); it != externalForcesAtNodes.end( ); it++ ){
+        //Initialize variables
+        floatType N, J, Jxw;
+        floatType dNdX[ 3 ], fint[ 3 ], cint[ 9 ];
+        int errorCode;
 
-            //Get the number of quadrature points in the element
-            uIntType elementQuadraturePointCount = quadraturePointDensities[ it->first ].size( );
+        floatVector shapeFunctions, deformationGradient, uQpt, XiQpt;
+        floatVector cauchyQpt, sQpt, mQpt;
+        floatVector pk2Qpt, referenceMicroStressQpt, referenceHigherOrderStressQpt;
 
-            //Get the number of nodes in the element
-            uIntType elementNodeCount = it->second.size( ) / _dim;
-            numCoefficients += elementQuadraturePointCount * elementNodeCount * elementNodeCount * _dim * _dim * ( 1 + _dim * _dim );
+        floatMatrix gradShapeFunctions;
 
-        }
+        uIntType qptIndex, row0;
 
-        coefficients.reserve( numCoefficients );
+        errorOut error = NULL;
 
-        //Loop over the free micromorphic elements
-        for ( auto macroCellID  = _inputProcessor.getFreeMacroCellIds( )->begin( );
-                   macroCellID != _inputProcessor.getFreeMacroCellIds( )->end( );
-                   macroCellID++ ){
+        //Loop over the quadrature points
+        for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
 
-            //Construct the macro-domain element
-            std::unique_ptr< elib::Element > element;
-            errorOut error = buildMacroDomainElement( *macroCellID,
-                                                      *_inputProcessor.getMacroNodeReferencePositions( ),
-                                                      *_inputProcessor.getMacroDisplacements( ),
-                                                      *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                                      element );
+            //Set the quadrature point index
+            qptIndex = qpt - element->qrule.begin( );
+
+            //Evaluate the properties required for the integration
+            error = computeMicromorphicElementRequiredValues( element, qpt, dim, reshapedDOFValues, true,
+                                                              shapeFunctions, gradShapeFunctions,
+                                                              deformationGradient, J, Jxw, uQpt, XiQpt );
 
             if ( error ){
 
                 errorOut result = new errorNode( __func__,
-                                                 "Error in the construction of the macro element " + std::to_string( *macroCellID ) );
+                                                 "Error in the computation of the required values for the element" );
                 result->addNext( error );
                 return result;
 
             }
 
-            //Get the degree of freedom values for the free macro-domain element
-            const std::unordered_map< uIntType, floatVector >* macroDispDOFVector = _inputProcessor.getMacroDispDOFVector( );
-            floatVector elementDOFVector( 0 );
-
-            for ( auto nodeID  = element->global_node_ids.begin( );
-                       nodeID != element->global_node_ids.end( );
-                       nodeID++ ){
+            //Pull back the stresses at the quadrature points to the reference configuration
+            cauchyQpt = floatVector( cauchyStress.begin( ) + dim * dim * qptIndex,
+                                     cauchyStress.begin( ) + dim * dim * ( qptIndex + 1 ) );
 
-                auto macroDisplacement = macroDispDOFVector->find( *nodeID );
+            sQpt = floatVector( symmetricMicroStress.begin( ) + dim * dim * qptIndex,
+                                symmetricMicroStress.begin( ) + dim * dim * ( qptIndex + 1 ) );
 
-                if ( macroDisplacement == macroDispDOFVector->end( ) ){
+            mQpt = floatVector( higherOrderStress.begin( ) + dim * dim * dim * qptIndex,
+                                higherOrderStress.begin( ) + dim * dim * dim * ( qptIndex + 1 ) );
 
-                    return new errorNode( __func__,
-                                          "Macro node " + std::to_string( *nodeID ) + " was not found in the macro displacement DOF vector map" );
+            //Pull back the Cauchy stress
+            error = micromorphicTools::pullBackCauchyStress( cauchyQpt, deformationGradient, pk2Qpt );
 
-                }
+            if ( error ){
 
-                elementDOFVector
-                    = vectorTools::appendVectors( { elementDOFVector, macroDisplacement->second } );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the pull-back operation on the Cauchy stress" );
+                result->addNext( error );
+                return result;
 
             }
 
-            //Extract the density and moment of inertia in the reference configuration
-            auto densityType = macroReferenceDensityTypes->find( *macroCellID );
+            //Pull back the symmetric micro-stress
+            error = micromorphicTools::pullBackMicroStress( sQpt, deformationGradient, referenceMicroStressQpt );
 
-            if ( densityType == macroReferenceDensityTypes->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__,
-                                      "The macro cell with ID " + std::to_string( *macroCellID ) +
-                                      " was not found in the density type map" );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the pull-back operation on the symmetric micro-stress" );
+                result->addNext( error );
+                return result;
 
             }
 
-            auto momentOfInertiaType = macroReferenceMomentOfInertiaTypes->find( *macroCellID );
+            //Pull back the higher order stress
+            error = micromorphicTools::pullBackHigherOrderStress( mQpt, deformationGradient, XiQpt, referenceHigherOrderStressQpt );
 
-            if ( momentOfInertiaType == macroReferenceMomentOfInertiaTypes->end( ) ){
+            if ( error ){
 
-                return new errorNode( __func__,
-                                      "The macro cell with ID " + std::to_string( *macroCellID ) +
-                                      " was not found in the moment of inertia type map" );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the pull-back operation on the higher order stress" );
+                result->addNext( error );
+                return result;
 
             }
 
-            if ( densityType->second.compare( "constant" ) != 0 ){
-
-                return new errorNode( __func__,
-                                      "Only constant densities for the macro-scale are allowed currently. This is not true for macro cell ID " + std::to_string( *macroCellID ) );
+            //Loop over the nodes
+            for ( unsigned int n = 0; n < shapeFunctions.size( ); n++ ){
 
-            }
+                //Set the shape function and gradient of the shape function values
+                N = shapeFunctions[ n ];
 
-            if ( momentOfInertiaType->second.compare( "constant" ) != 0 ){
+                for ( unsigned int i = 0; i < dim; i++ ){
 
-                return new errorNode( __func__,
-                                      "Only constant moments of inertia for the macro-scale are allowed currently. This is not true for macro cell ID " + std::to_string( *macroCellID ) );
+                    dNdX[ i ] = gradShapeFunctions[ n ][ i ];
 
-            }
+                }
 
-            bool quantitiesInReference = true; //TODO: We currently assume all of the quantities are defined in the reference configuration
+                //Compute the terms for the balance of linear momentum
+                errorCode = balance_equations::compute_internal_force( dNdX, deformationGradient, pk2Qpt, fint );
 
-            auto macroDensities = macroReferenceDensities->find( *macroCellID );
+                if ( errorCode != 0 ){
 
-            if ( macroDensities == macroReferenceDensities->end( ) ){
+                    return new errorNode( __func__,
+                                          "The internal force term returned an error code: " + std::to_string( errorCode ) );
 
-                return new errorNode( __func__,
-                                      "Macro cell ID " + std::to_string( *macroCellID ) +
-                                      " is not in the macro reference density map" );
+                }
 
-            }
+                //Compute the terms for the balance of first moment of momentum
+                errorCode = balance_equations::compute_internal_couple( N, dNdX, deformationGradient, XiQpt,
+                                                                        pk2Qpt, referenceMicroStressQpt,
+                                                                        referenceHigherOrderStressQpt, cint );
 
-            if ( macroDensities->second.size( ) != 1 ){
+                if ( errorCode != 0 ){
 
-                return new errorNode( __func__,
-                                      "The macro densities for macro cell " + std::to_string( *macroCellID ) +
-                                      "Define " + std::to_string( macroDensities->second.size( ) ) +
-                                      " values when only 1 can be defined" );
+                    return new errorNode( __func__,
+                                          "The internal couple term returned an error code: " + std::to_string( errorCode ) );
 
-            }
+                }
 
-            auto macroMomentsOfInertia = macroReferenceMomentsOfInertia->find( *macroCellID );
-
-            if ( macroMomentsOfInertia == macroReferenceMomentsOfInertia->end( ) ){
-
-                return new errorNode( __func__,
-                                      "Macro cell ID " + std::to_string( *macroCellID ) +
-                                      " is not in the macro reference moments of inertia map" );
+                //Get the initial index
+                auto it = nodeIDToIndex->find( element->global_node_ids[ n ] );
+                
+                if ( it == nodeIDToIndex->end( ) ){
 
-            }
+                    return new errorNode( __func__,
+                                          "The global node id " + std::to_string( element->global_node_ids[ n ] ) +
+                                          " is not found in the id to index map" );
 
-            if ( macroMomentsOfInertia->second.size( ) != _dim * _dim ){
+                }
 
-                return new errorNode( __func__,
-                                      "The macro moments of inertia for macro cell " + std::to_string( *macroCellID ) +
-                                      "Define " + std::to_string( macroDensities->second.size( ) ) +
-                                      " values when only " + std::to_string( _dim * _dim ) + " can be defined" );
+                //Set the row index
+                row0 = ( uSize + phiSize ) * it->second;
 
-            }
+                if ( ( row0 + uSize + phiSize ) > internalForceVector.rows( ) ){
 
-            floatVector densities( element->qrule.size( ), macroDensities->second[ 0 ] );
+                    return new errorNode( __func__,
+                                          "The global node id " + std::to_string( element->global_node_ids[ n ] ) +
+                                          " has an index ( " + std::to_string( it->second ) + " ) which results in a index larger than" +
+                                          " the internal force vector size ( " + std::to_string( internalForceVector.rows( ) ) + ")" );
 
-            floatVector momentsOfInertia
-                = vectorTools::appendVectors( floatMatrix( element->qrule.size( ), macroMomentsOfInertia->second ) );
+                }
 
-            //Construct the kinetic energy partitioning coefficient at each quadrature point
-            floatVector res;
-            error = constructKineticEnergyPartitioningCoefficient( *macroCellID, element, res );
+                for ( unsigned int i = 0; i < dim; i++ ){
 
-            if ( error ){
+                    internalForceVector( row0 + i, 0 ) -= fint[ i ] * Jxw;
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the construction of the kinetic energy partitoning coefficient for macro cell " + std::to_string( *macroCellID ) );
-                result->addNext( error );
-                return result;
+                }
 
-            }
+                for ( unsigned int i = 0; i < ( dim * dim ); i++ ){
 
-            for ( auto re = res.begin( ); re != res.end( ); re++ ){
+                    internalForceVector( row0 + i + dim, 0 ) -= cint[ i ] * Jxw;
 
-                unsigned int re_indx = re - res.begin( );
+                }
 
-                densities[ re_indx ] *= *re;
+            }
 
-                for ( auto mOI  = momentsOfInertia.begin( ) + _dim * _dim * re_indx;
-                           mOI != momentsOfInertia.begin( ) + _dim * _dim * ( re_indx + 1 );
-                           mOI++ ){
+        }
 
-                    unsigned int mOI_indx = mOI - momentsOfInertia.begin( );
-                    momentsOfInertia[ mOI_indx ] *= *re;
+        return NULL;
+    }
 
-                }
+    errorOut computeMicromorphicElementRequiredValues( const std::unique_ptr< elib::Element > &element,
+                                                       const elib::quadrature_rule::iterator &qpt,
+                                                       const uIntType dim,
+                                                       const floatMatrix &reshapedDOFValues,
+                                                       const bool useReference,
+                                                       floatVector &shapeFunctions,
+                                                       floatMatrix &gradShapeFunctions,
+                                                       floatVector &deformationGradient,
+                                                       floatType &J, floatType &Jxw,
+                                                       floatVector &uQpt, floatVector &XiQpt ){
+        /*!
+         * Compute the required values for the integration of a micromorphic element owned by the caller
+         */
 
-            }
+        return computeMicromorphicElementRequiredValues( element.get( ), qpt, dim, reshapedDOFValues, useReference,
+                                                         shapeFunctions, gradShapeFunctions, deformationGradient,
+                                                         J, Jxw, uQpt, XiQpt );
+    }
 
-            error = formMicromorphicElementMassMatrix( element, elementDOFVector, momentsOfInertia, densities, 
-                                                       _inputProcessor.getMacroGlobalToLocalDOFMap( ), coefficients,
-                                                       NULL, quantitiesInReference );
+    errorOut computeMicromorphicElementRequiredValues( elib::Element *element,
+                                                       const elib::quadrature_rule::iterator &qpt,
+                                                       const uIntType dim,
+                                                       const floatMatrix &reshapedDOFValues,
+                                                       const bool useReference,
+                                                       floatVector &shapeFunctions,
+                                                       floatMatrix &gradShapeFunctions,
+                                                       floatVector &deformationGradient,
+                                                       floatType &J, floatType &Jxw,
+                                                       floatVector &uQpt, floatVector &XiQpt ){
+        /*!
+         * Compute the required values for the integration of a micromorphic element
+         */
 
-            if ( error ){
+        //Initialize internal variables
+        floatVector interpolatedValues, eye( dim * dim );
+        vectorTools::eye( eye );
 
-                std::string outstr  = "Error in the construction of the contributions of the macro element to ";
-                            outstr += "the free micromorphic mass matrix";
+        floatMatrix jacobian;
 
-                errorOut result = new errorNode( __func__, outstr );
-                result->addNext( error );
-                return result;
+        //Evaluate the shape function values
+        errorOut error = element->get_shape_functions( qpt->first, shapeFunctions );
 
-            }
+        if ( error ){
 
+            errorOut result = new errorNode( __func__,
+                                             "Error in the computation of the shape functions" );
+            result->addNext( error );
+            return result;
 
         }
 
-        const DOFMap *nodeIDToIndex = _inputProcessor.getMacroGlobalToLocalDOFMap( );
-        freeMicromorphicMassMatrix = SparseMatrix( nMacroDOF * nodeIDToIndex->size( ), nMacroDOF * nodeIDToIndex->size( ) );
-        freeMicromorphicMassMatrix.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
-
-        return NULL;
-    }
+        //Evaluate the gradients of the shape functions
+        error = element->get_global_shapefunction_gradients( qpt->first, gradShapeFunctions, useReference );
 
-    errorOut overlapCoupling::assembleCouplingMassAndDampingMatrices( ){
-        /*!
-         * Assemble the mass matrix for the coupling equations
-         *
-         * It is assumed that ghost nodes cannot also be free or non-overlapped.
-         * It is assumed that free nodes cannot also be non-overlapped
-         * If a node is defined in multiple locations ( i.e. it is on the boundary ) then:
-         * For the micro-scale the order of preference is:
-         *     non-overlapped > free > ghost ( we assume the open window DNS is the best representation of the PDE )
-         * For the macro-scale the order of preference is:
-         *     ghost > free > non-overlapped ( we assume the micro-scale is the best representation of the PDE )
-         * It is also assumed that the micro-scale can be represented by a diagonal mass matrix while the 
-         * consistent mass matrix is used at the macro-scale.
-         */
+        if ( error ){
 
-        //Set the number of displacement degrees of freedom
-        uIntType nMacroDispDOF = _dim + _dim * _dim;
+            errorOut result = new errorNode( __func__,
+                                             "Error in the computation of the shape function gradients" );
+            result->addNext( error );
+            return result;
 
-        //Get the configuration of the coupling
-        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
-        floatType rhat = config[ "kinetic_energy_weighting_factor" ].as< floatType >( );
-        floatType aQ = config[ "micro_proportionality_coefficient" ].as< floatType >( );
-        floatType aD = config[ "macro_proportionality_coefficient" ].as< floatType >( );
+        }
 
-        //Get the micro densities and volumes
-        const std::unordered_map< uIntType, floatType > *microVolumes   = _inputProcessor.getMicroVolumes( );
-        const std::unordered_map< uIntType, floatType > *microDensities = _inputProcessor.getMicroDensities( );
+        //Get the deformation gradient between the reference and current configurations
+        error = element->get_jacobian( qpt->first, element->reference_nodes, jacobian );
 
-        //Get the global to local micro node mapping
-        const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
+        if ( error ){
 
-        //Get the IDs of the ghost and free micro nodes
-        const uIntVector *ghostMicroNodeIDs = _inputProcessor.getGhostMicroNodeIds( );
-        const uIntVector *freeMicroNodeIDs = _inputProcessor.getFreeMicroNodeIds( );
+            errorOut result = new errorNode( __func__,
+                                             "Error in the computation of the jacobian" );
+            result->addNext( error );
+            return result;
 
-        //Get the IDs of the ghost and free macro nodes
-        const uIntVector *ghostMacroNodeIDs = _inputProcessor.getGhostMacroNodeIds( );
-        const uIntVector *freeMacroNodeIDs = _inputProcessor.getFreeMacroNodeIds( );
+        }
 
-        //Determine the offset of the free micro nodes
-        const uIntType nFreeMicroNodes = freeMicroNodeIDs->size( );
+        deformationGradient = vectorTools::appendVectors( jacobian );
+        J = vectorTools::determinant( vectorTools::appendVectors( jacobian ), dim, dim );
 
-        //Determine the offset of the free macro nodes
-        const uIntType nFreeMacroNodes = freeMacroNodeIDs->size( );
-        const uIntType nGhostMacroNodes = ghostMacroNodeIDs->size( );
-                
-        //Get the micro mass vectors
-        floatVector ghostMicroMasses( ghostMicroNodeIDs->size( ), 0 );
-        floatVector freeMicroMasses( freeMicroNodeIDs->size( ), 0 );
+        //Get the Jacobian between the local and reference configurations
+        if ( useReference ){
 
-        //Assemble the free micro mass vector
-        for ( auto microID = freeMicroNodeIDs->begin( ); microID != freeMicroNodeIDs->end( ); microID++ ){
+            error = element->get_local_gradient( element->reference_nodes, qpt->first, jacobian );
 
-            auto localMicroNodeIDMap = microGlobalToLocalDOFMap->find( *microID );
+        }
+        else{
 
-            if ( localMicroNodeIDMap == microGlobalToLocalDOFMap->end( ) ){
+            error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
 
-                return new errorNode( __func__,
-                                      "Free micro node: " + std::to_string( *microID ) + " not found in global to local map\n" );
+        }
 
-            }
+        if ( error ){
 
-            auto microDensity = microDensities->find( *microID );
+            errorOut result = new errorNode( __func__,
+                                             "Error in the computation of the local gradient\n" );
+            result->addNext( error );
+            return result;
 
-            if ( microDensity == microDensities->end( ) ){
+        }
 
-                return new errorNode( __func__,
-                                      "Free micro node " + std::to_string( *microID ) + " was not found in the micro density map" );
+        Jxw = vectorTools::determinant( vectorTools::appendVectors( jacobian ), dim, dim ) * qpt->second;
 
-            }
+        //Interpolate the DOF nodes to the node
+        error = element->interpolate( reshapedDOFValues, qpt->first, interpolatedValues );
 
-            auto microVolume = microVolumes->find( *microID );
+        if ( error ){
 
-            if ( microVolume == microVolumes->end( ) ){
+            errorOut result = new errorNode( __func__,
+                                             "Error in the interpolation of the degree of freedom values" );
+            result->addNext( error );
+            return result;
 
-                return new errorNode( __func__,
-                                      "Free micro node " + std::to_string( *microID ) + " was not found in the micro volume map" );
+        }
 
-            }
+        if ( interpolatedValues.size( ) < ( dim + dim * dim ) ){
 
-            freeMicroMasses[ localMicroNodeIDMap->second ] = microVolume->second * microDensity->second;
+            std::string output = "The interpolated values shape is not consistent with the required dimension for the displacement ";
+            output            += "and micro-displacement interpolation";
+            return new errorNode( __func__, output );
 
         }
 
-#ifdef TESTACCESS
-
-        _test_freeMicroMasses = freeMicroMasses;
+        uQpt = floatVector( interpolatedValues.begin( ), interpolatedValues.begin( ) + dim );
+        XiQpt = eye + floatVector( interpolatedValues.begin( ) + dim, interpolatedValues.begin( ) + ( dim + dim * dim ) );
 
-#endif
+        return NULL;
+    }
 
-        //Assemble the ghost micro mass vector
-        for ( auto microID = ghostMicroNodeIDs->begin( ); microID != ghostMicroNodeIDs->end( ); microID++ ){
+    errorOut overlapCoupling::assembleHomogenizedExternalForceVector( ){
+        /*!
+         * Assemble the homogenized external force vector. This vector doesn't have
+         * any scaling from the coefficients but is just the raw vector.
+         */
 
-            auto localMicroNodeIDMap = microGlobalToLocalDOFMap->find( *microID );
+        //Loop over the elements in the external force container
+        elib::Element *element;
+        errorOut error = NULL;
+        const DOFMap *nodeIDToIndex = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-            if ( localMicroNodeIDMap == microGlobalToLocalDOFMap->end( ) ){
+        //Resize the output vector
+        homogenizedFEXT = Eigen::MatrixXd::Zero( ( _dim + _dim * _dim ) * nodeIDToIndex->size( ), 1 );
 
-                return new errorNode( __func__,
-                                      "Ghost micro node: " + std::to_string( *microID ) + " not found in global to local map\n" );
+        //Collect all of the cells in the overlapping domain
+        const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
+        const uIntVector *ghostMacroCellIds = _inputProcessor.getGhostMacroCellIds( );
 
-            }
+        uIntVector macroCellIDVector( freeMacroCellIds->begin( ), freeMacroCellIds->end( ) );
+        macroCellIDVector = vectorTools::appendVectors( { macroCellIDVector, *ghostMacroCellIds } );
 
-            auto microDensity = microDensities->find( *microID );
+        for ( auto macroCellID = macroCellIDVector.begin( ); macroCellID != macroCellIDVector.end( ); macroCellID++ ){
 
-            if ( microDensity == microDensities->end( ) ){
+            //Make sure that the macroCellID is stored in the external force vector
+            if ( externalForcesAtNodes.find( *macroCellID ) == externalForcesAtNodes.end( ) ){
 
                 return new errorNode( __func__,
-                                      "Free micro node " + std::to_string( *microID ) + " was not found in the micro density map" );
+                                      "Macro cell ID " + std::to_string( *macroCellID ) +
+                                      " not found in external forces at nodes." );
 
             }
 
-            auto microVolume = microVolumes->find( *microID );
-
-            if ( microVolume == microVolumes->end( ) ){
+            //Make sure that the macroCellID is stored in the external couple vector
+            if ( externalCouplesAtNodes.find( *macroCellID ) == externalCouplesAtNodes.end( ) ){
 
                 return new errorNode( __func__,
-                                      "Free micro node " + std::to_string( *microID ) + " was not found in the micro volume map" );
+                                      "Macro cell ID " + std::to_string( *macroCellID ) +
+                                      " not found in external couples at nodes." );
 
             }
 
-            ghostMicroMasses[ localMicroNodeIDMap->second - nFreeMicroNodes ] = microVolume->second * microDensity->second;
+            //Form the macro element
+            error = getMacroDomainElement( *macroCellID,
+                                           *_inputProcessor.getMacroNodeReferencePositions( ),
+                                           *_inputProcessor.getMacroDisplacements( ),
+                                           *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                           element );
 
-        }
+            if ( error ){
 
-#ifdef TESTACCESS
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the construction of the macro domain element for macro cell " +
+                                                 std::to_string( *macroCellID ) );
+                result->addNext( error );
+                return result;
 
-        _test_ghostMicroMasses = ghostMicroMasses;
+            }
 
-#endif
+            //Loop over the external node ids
 
-        //Assemble the mass sub-matrices
-//        Eigen::VectorXd mq( 3 * freeMicroMasses.size( ) );
-//        Eigen::VectorXd mqhat( 3 * ghostMicroMasses.size( ) );
-        tripletVector c1;
-        tripletVector c2;
+            for ( auto globalNodeID = element->global_node_ids.begin( );
+                      globalNodeID != element->global_node_ids.end( );
+                      globalNodeID++ ){
 
-        c1.reserve( _dim * ghostMicroMasses.size( ) ); 
-        c2.reserve( _dim * freeMicroMasses.size( ) ); 
+                //Get the element nodal index
+                uIntType elementNodeIndex = globalNodeID - element->global_node_ids.begin( );
 
-        uIntType mIndex = 0;
+                auto index = nodeIDToIndex->find( *globalNodeID );
 
-        for ( auto m = ghostMicroMasses.begin( ); m != ghostMicroMasses.end( ); m++, mIndex++ ){
+                if ( index == nodeIDToIndex->end( ) ){
 
-            for ( unsigned int i = 0; i < _dim; i++ ){
+                    return new errorNode( __func__,
+                                          "Macro global node " + std::to_string( *globalNodeID ) +
+                                          " not found in the id to index map" );
 
-                c1.push_back( DOFProjection::T( _dim * mIndex + i, _dim * mIndex + i, ( 1 - rhat ) * ( *m ) ) );
-//                mqhat( _dim * mIndex + i ) = ( 1 - rhat ) * ( *m );
+                }
 
-            }
+                for ( unsigned int i = 0; i < _dim; i++ ){
 
-        }
+                    homogenizedFEXT( ( _dim + _dim * _dim ) * index->second + i, 0 )
+                        += externalForcesAtNodes[ *macroCellID ][ _dim * elementNodeIndex + i ];
 
-        mIndex = 0;
+                }
 
-        for ( auto m = freeMicroMasses.begin( ); m != freeMicroMasses.end( ); m++, mIndex++ ){
+                for ( unsigned int i = 0; i < _dim * _dim; i++ ){
 
-            for ( unsigned int i = 0; i < _dim; i++ ){
+                    homogenizedFEXT( ( _dim + _dim * _dim ) * index->second + i + _dim, 0 )
+                        += externalCouplesAtNodes[ *macroCellID ][ _dim * _dim * elementNodeIndex + i ];
 
-                c2.push_back( DOFProjection::T( _dim * mIndex + i, _dim * mIndex + i, ( 1 - rhat ) * ( *m ) ) );
-//                mq( _dim * mIndex + i ) = ( 1 - rhat ) * ( *m );
+                }
 
             }
 
         }
 
-        SparseMatrix MQ( _dim * freeMicroMasses.size( ), _dim * freeMicroMasses.size( ) );
-        MQ.setFromTriplets( c2.begin( ), c2.end( ) );
-
-        SparseMatrix MQhat( _dim * ghostMicroMasses.size( ), _dim * ghostMicroMasses.size( ) );
-        MQhat.setFromTriplets( c1.begin( ), c1.end( ) );
-        SparseMatrix MTildeDBreve = rhat * homogenizedMassMatrix + freeMicromorphicMassMatrix;
-        //Note: kinetic partitioning coefficient applied when the matrix was formed
-    
-        SparseMatrix MD    = MTildeDBreve.block( 0, 0, nMacroDispDOF * nFreeMacroNodes, nMacroDispDOF * nFreeMacroNodes );
-        SparseMatrix MDhat = MTildeDBreve.block( nMacroDispDOF * nFreeMacroNodes, nMacroDispDOF * nFreeMacroNodes,
-                                                 nMacroDispDOF * nGhostMacroNodes, nMacroDispDOF * nGhostMacroNodes );
+        return NULL;
 
-#ifdef TESTACCESS
-       
-        _test_MQ = MQ;
-        _test_MQhat = MQhat;
+    }
 
-#endif
-        //Due to the restrictions in listed in the comment at the beginning of the function, MBar from Regueiro 2012
-        //is an empty matrix as we only handle the coupling domain here.
-       
-    
-        //Assemble Mass matrices for the micro projection equation
+    errorOut overlapCoupling::assembleHomogenizedInternalForceVector( ){
+        /*!
+         * Assemble the homogenized internal force vector.
+         *
+         */
 
-        if ( ( config[ "projection_type" ].as< std::string >( ).compare( "l2_projection" ) == 0 ) ){
+        //Loop over the elements in the external force container
+        elib::Element *element;
+        errorOut error = NULL;
+        const DOFMap *nodeIDToIndex = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-            //Determine the coefficients where we cut off the projectors TODO: Expose factor to user
-            floatType BQhatQ_coeff = 1e-4 * ( std::fabs( _dense_BQhatQ.minCoeff( ) ) + std::fabs( _dense_BQhatQ.maxCoeff( ) ) );
-            floatType BQhatD_coeff = 1e-4 * ( std::fabs( _dense_BQhatD.minCoeff( ) ) + std::fabs( _dense_BQhatD.maxCoeff( ) ) );
-            floatType BDhatQ_coeff = 1e-4 * ( std::fabs( _dense_BDhatQ.minCoeff( ) ) + std::fabs( _dense_BDhatQ.maxCoeff( ) ) );
-            floatType BDhatD_coeff = 1e-4 * ( std::fabs( _dense_BDhatD.minCoeff( ) ) + std::fabs( _dense_BDhatD.maxCoeff( ) ) );
+        //Set the number of displacement degrees of freedom
+        unsigned int nMacroDispDOF = _dim + _dim * _dim;
 
-            SparseMatrix _sparse_BQhatQ = _dense_BQhatQ.sparseView( 1, BQhatQ_coeff );
-            SparseMatrix _sparse_BQhatD = _dense_BQhatD.sparseView( 1, BQhatD_coeff );
-            SparseMatrix _sparse_BDhatQ = _dense_BDhatQ.sparseView( 1, BDhatQ_coeff );
-            SparseMatrix _sparse_BDhatD = _dense_BDhatD.sparseView( 1, BDhatD_coeff );
+        //Get the free and ghost macro node ids
+        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
+        const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
 
-            //TODO: Improve efficiency
+        //Assemble the free macro node degree of freedom vector
+        floatVector freeMacroDisplacements( nMacroDispDOF * freeMacroNodeIds->size( ) );
 
-            std::cerr << "  ASSEMBLING MQQ\n";
-//            std::cout << "coeffs:\n" << BQhatQ_coeff << " " << BQhatD_coeff << " " << BDhatQ_coeff << " " << BDhatD_coeff << "\n";
-//
-//            std::cout << "Zero ratios\n";
-//            std::cerr << ( ( floatType )_sparse_BQhatQ.nonZeros( ) ) / ( ( floatType )_sparse_BQhatQ.size( ) ) << "\n";
-//            std::cerr << ( ( floatType )_sparse_BQhatD.nonZeros( ) ) / ( ( floatType )_sparse_BQhatD.size( ) ) << "\n";
-//            std::cerr << ( ( floatType )_sparse_BDhatQ.nonZeros( ) ) / ( ( floatType )_sparse_BDhatQ.size( ) ) << "\n";
-//            std::cerr << ( ( floatType )_sparse_BDhatD.nonZeros( ) ) / ( ( floatType )_sparse_BDhatD.size( ) ) << "\n";
+        const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
+        uIntType macroDispDOFStride;
+        for ( auto it = freeMacroNodeIds->begin( ); it != freeMacroNodeIds->end( ); it++ ){
 
-            SparseMatrix MQQ = MQ;
-//            std::cerr << "mul1\n";
-            MQQ += _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatQ;
-//            std::cerr << "mul2\n";
-            MQQ += _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatQ;
+            auto map = _inputProcessor.getMacroGlobalToLocalDOFMap( )->find( *it );
 
-            std::cerr << "  ASSEMBLING MQD\n";
-            SparseMatrix MQD = _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatD;
-            MQD += _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatD;
-    
-            //Assemble Mass matrices for the macro projection equation
-            
-            std::cerr << "  ASSEMBLING MDQ\n";
-            SparseMatrix MDQ = _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatQ;//MQhat * _dense_BQhatQ;
-            MDQ += _sparse_BDhatD.transpose( ) * MDhat * _sparse_BDhatQ;
+            if ( map == _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( ) ){
 
-            std::cerr << "  ASSEMBLING MDD\n";
-            SparseMatrix MDD = MD;
-            MDD += _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatD;//MQhat * _dense_BQhatD;
-            MDD += _sparse_BDhatD.transpose( ) * MDhat * _sparse_BDhatD;
-    
-            //Assemble the damping matrices for the micro projection equation
-            std::cerr << "  ASSEMBLING CQQ\n";
-            SparseMatrix CQQ = aQ * MQ;
-            CQQ += aQ * _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatQ;//MQhat * _dense_BQhatQ;
-            CQQ += aD * _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatQ;
+                return new errorNode( __func__,
+                                      "Global degree of freedom '" + std::to_string( *it ) + "' not found in degree of freedom map" );
 
-            std::cerr << "  ASSEMBLING CQD\n";
-            SparseMatrix CQD = aQ * _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatD;//MQhat * _dense_BQhatD;
-    
-            //Assemble the damping matrices for the macro projection equation
-            std::cerr << "  ASSEMBLING CDQ\n";
-            SparseMatrix CDQ = aQ * _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatQ;//MQhat * _dense_BQhatQ;
+            }
 
-            std::cerr << "  ASSEMBLING CDD\n";
-            SparseMatrix CDD = aD * MD;
-            CDD += aQ * _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatD;//MQhat * _dense_BQhatD;
+            const floatType *macroDisplacement;
+            error = macroNodeFields->getNodeValues( "displacement_dof", *it, macroDisplacement, macroDispDOFStride );
 
-//            //Assemble the full mass matrix
-//            std::cerr << "  ASSEMBLING THE FULL MASS MATRIX\n";
-//            _dense_MASS = Eigen::MatrixXd( MQQ.rows( ) + MDQ.rows( ), MQQ.cols( ) + MQD.cols( ) );
-//            _dense_MASS.topLeftCorner(     MQQ.rows( ), MQQ.cols( ) ) = MQQ;
-//            _dense_MASS.topRightCorner(    MQD.rows( ), MQD.cols( ) ) = MQD;
-//            _dense_MASS.bottomLeftCorner(  MDQ.rows( ), MDQ.cols( ) ) = MDQ;
-//            _dense_MASS.bottomRightCorner( MDD.rows( ), MDD.cols( ) ) = MDD;
-//
-//            //Assemble the full damping matrix
-//            std::cerr << "  ASSEMBLING THE FULL DAMPING MATRIX\n";
-//            _dense_DAMPING = Eigen::MatrixXd( CQQ.rows( ) + CDQ.rows( ), CQQ.cols( ) + CQD.cols( ) );
-//            _dense_DAMPING.topLeftCorner(     CQQ.rows( ), CQQ.cols( ) ) = CQQ;
-//            _dense_DAMPING.topRightCorner(    CQD.rows( ), CQD.cols( ) ) = CQD;
-//            _dense_DAMPING.bottomLeftCorner(  CDQ.rows( ), CDQ.cols( ) ) = CDQ;
-//            _dense_DAMPING.bottomRightCorner( CDD.rows( ), CDD.cols( ) ) = CDD;
+            if ( error ){
 
-#ifdef TESTACCESS
+                errorOut result = new errorNode( __func__,
+                                                 "Global macro degree of freedom '" + std::to_string( *it ) + "' not found in the macro displacement dof field" );
+                result->addNext( error );
+                return result;
 
-            _test_dense_MQQ = MQQ;
-            _test_dense_MQD = MQD;
-            _test_dense_MDQ = MDQ;
-            _test_dense_MDD = MDD;
+            }
 
-            _test_dense_CQQ = CQQ;
-            _test_dense_CQD = CQD;
-            _test_dense_CDQ = CDQ;
-            _test_dense_CDD = CDD;
+            //Set the macro displacements
+            for ( unsigned int i = 0; i < nMacroDispDOF; i++ ){
 
-#endif
-            //The sparse matrices are in column major format so we loop over the columns to assemble the matrix
-            std::cerr << "  ASSEMBLING FULL MASS AND DAMPING MATRICES\n";
-            _sparse_MASS    = SparseMatrix( MQQ.rows( ) + MDQ.rows( ), MQQ.cols( ) + MQD.cols( ) );
-            _sparse_DAMPING = SparseMatrix( CQQ.rows( ) + CDQ.rows( ), CQQ.cols( ) + CQD.cols( ) );
+                freeMacroDisplacements[ nMacroDispDOF * ( map->second ) + i ] = macroDisplacement[ i ];
 
-            _sparse_MASS.reserve( MQQ.nonZeros( ) + MQD.nonZeros( ) + MDQ.nonZeros( ) + MDD.nonZeros( ) );
-            _sparse_DAMPING.reserve( CQQ.nonZeros( ) + CQD.nonZeros( ) + CDQ.nonZeros( ) + CDD.nonZeros( ) );
-            for ( uIntType c = 0; c < MQQ.cols( ); ++c ){
+            }
 
-                //Add terms to the mass matrix
-                _sparse_MASS.startVec( c );
-                for ( SparseMatrix::InnerIterator itMQQ( MQQ, c ); itMQQ; ++itMQQ )
-                    _sparse_MASS.insertBack( itMQQ.row( ), c ) = itMQQ.value( );
-                for ( SparseMatrix::InnerIterator itMDQ( MDQ, c ); itMDQ; ++itMDQ )
-                    _sparse_MASS.insertBack( itMDQ.row( ) + MQQ.rows( ), c ) = itMDQ.value( );
+        }
 
-                //Add terms to the damping matrix
-                _sparse_DAMPING.startVec( c );
-                for ( SparseMatrix::InnerIterator itCQQ( CQQ, c ); itCQQ; ++itCQQ )
-                    _sparse_DAMPING.insertBack( itCQQ.row( ), c ) = itCQQ.value( );
-                for ( SparseMatrix::InnerIterator itCDQ( CDQ, c ); itCDQ; ++itCDQ )
-                    _sparse_DAMPING.insertBack( itCDQ.row( ) + CQQ.rows( ), c ) = itCDQ.value( );
+        //Resize the output vector
+        homogenizedFINT = Eigen::MatrixXd::Zero( nMacroDispDOF * nodeIDToIndex->size( ), 1 );
 
-            }
+        //Loop over the macro cells
+        floatVector elementDOFVector;
 
-            for ( uIntType c = 0; c < MDD.cols( ); ++c ){
+        //Collect all of the cells in the overlapping domain
+        const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
+        const uIntVector *ghostMacroCellIds = _inputProcessor.getGhostMacroCellIds( );
 
-                //Add terms to the mass matrix
-                _sparse_MASS.startVec( c + MQQ.cols( ) );
-                for ( SparseMatrix::InnerIterator itMQD( MQD, c ); itMQD; ++itMQD )
-                    _sparse_MASS.insertBack( itMQD.row( ), c + MQQ.cols( ) ) = itMQD.value( );
-                for ( SparseMatrix::InnerIterator itMDD( MDD, c ); itMDD; ++itMDD )
-                    _sparse_MASS.insertBack( itMDD.row( ) + MQD.rows( ), c + MDQ.cols( ) ) = itMDD.value( );
+        uIntVector macroCellIDVector( freeMacroCellIds->begin( ), freeMacroCellIds->end( ) );
+        macroCellIDVector = vectorTools::appendVectors( { macroCellIDVector, *ghostMacroCellIds } );
 
-                //Add terms to the damping matrix
-                _sparse_DAMPING.startVec( c + CQQ.cols( ) );
-                for ( SparseMatrix::InnerIterator itCQD( CQD, c ); itCQD; ++itCQD )
-                    _sparse_DAMPING.insertBack( itCQD.row( ), c + CQQ.cols( ) ) = itCQD.value( );
-                for ( SparseMatrix::InnerIterator itCDD( CDD, c ); itCDD; ++itCDD )
-                    _sparse_DAMPING.insertBack( itCDD.row( ) + CQD.rows( ), c + CDQ.cols( ) ) = itCDD.value( );
+        for ( auto macroCellID = macroCellIDVector.begin( ); macroCellID != macroCellIDVector.end( ); macroCellID++ ){
 
-            }
+            //Form the macro element
+            error = getMacroDomainElement( *macroCellID,
+                                           *_inputProcessor.getMacroNodeReferencePositions( ),
+                                           *_inputProcessor.getMacroDisplacements( ),
+                                           *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                           element );
 
-        }
-        else if ( ( config[ "projection_type" ].as< std::string >( ).compare( "direct_projection" ) == 0 ) ||
-                  ( config[ "projection_type" ].as< std::string >( ).compare( "averaged_l2_projection" ) == 0 )
-                ){
+            if ( error ){
 
-            std::cerr << "ASSEMBLING MASS BLOCK MATRICES\n";
-            SparseMatrix MQQ  =  MQ;
-            std::cerr << "  MQQ\n";
-            MQQ += _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatQ;
-            MQQ += _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatQ;
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the construction of the macro domain element for macro cell " +
+                                                 std::to_string( *macroCellID ) );
+                result->addNext( error );
+                return result;
 
-            std::cerr << "  MQD\n";
-            SparseMatrix MQD = _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatD;
-            MQD += _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatD;
-    
-            //Assemble Mass matrices for the macro projection equation
+            }
             
-            std::cerr << "  MDQ\n";
-            SparseMatrix MDQ = _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatQ;
-            MDQ += _sparse_BDhatD.transpose( ) * MDhat * _sparse_BDhatQ;
+            //Extract the homogenized degrees of freedom for the element
 
-            std::cerr << "  MDD\n";
-            SparseMatrix MDD = MD;
-            MDD += _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatD;
-            MDD += _sparse_BDhatD.transpose( ) * MDhat * _sparse_BDhatD;
+            floatVector nodeDOF;
+            elementDOFVector.clear( );
+            elementDOFVector.reserve( nMacroDispDOF * element->nodes.size( ) );
 
-            std::cout << "ASSEMBLING DAMPING BLOCK MATRICES\n";
-    
-            //Assemble the damping matrices for the micro projection equation
-            std::cerr << "  CQQ\n";
-            SparseMatrix CQQ = aQ * MQ;
-            CQQ += aQ * _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatQ;
-            CQQ += aD * _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatQ;
+            for ( auto nodeID = element->global_node_ids.begin( ); nodeID != element->global_node_ids.end( ); nodeID++ ){
 
-            std::cerr << "  CQD\n";
-            SparseMatrix CQD = aQ * _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatD;
-    
-            //Assemble the damping matrices for the macro projection equation
-            std::cerr << "  CDQ\n";
-            SparseMatrix CDQ = aQ * _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatQ;
-            std::cerr << "  CDD\n";
-            SparseMatrix CDD = aD * MD;
-            CDD += aQ * _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatD;
+                //Find the node in the global to local map
+                auto index = nodeIDToIndex->find( *nodeID );
 
-#ifdef TESTACCESS
+                if ( index == nodeIDToIndex->end( ) ){
 
-            _test_dense_MQQ = MQQ;
-            _test_dense_MQD = MQD;
-            _test_dense_MDQ = MDQ;
-            _test_dense_MDD = MDD;
+                    return new errorNode( __func__,
+                                          "Macro-scale node with global id " + std::to_string( *nodeID ) +
+                                          " is not found in the global ID to the local index" );
 
-            _test_dense_CQQ = CQQ;
-            _test_dense_CQD = CQD;
-            _test_dense_CDQ = CDQ;
-            _test_dense_CDD = CDD;
-
-#endif
-
-            //Assemble the full mass and damping matrices
-            std::cout << "ASSEMBLING FULL MASS AND DAMPING MATRICES\n";
-            _sparse_MASS    = SparseMatrix( MQQ.rows( ) + MDQ.rows( ), MQQ.cols( ) + MQD.cols( ) );
-            _sparse_DAMPING = SparseMatrix( CQQ.rows( ) + CDQ.rows( ), CQQ.cols( ) + CQD.cols( ) );
-
-            //The sparse matrices are in column major format so we loop over the columns to assemble the matrix
-            _sparse_MASS.reserve( MQQ.nonZeros( ) + MQD.nonZeros( ) + MDQ.nonZeros( ) + MDD.nonZeros( ) );
-            _sparse_DAMPING.reserve( CQQ.nonZeros( ) + CQD.nonZeros( ) + CDQ.nonZeros( ) + CDD.nonZeros( ) );
-            for ( uIntType c = 0; c < MQQ.cols( ); ++c ){
-
-                //Add terms to the mass matrix
-                _sparse_MASS.startVec( c );
-                for ( SparseMatrix::InnerIterator itMQQ( MQQ, c ); itMQQ; ++itMQQ )
-                    _sparse_MASS.insertBack( itMQQ.row( ), c ) = itMQQ.value( );
-                for ( SparseMatrix::InnerIterator itMDQ( MDQ, c ); itMDQ; ++itMDQ )
-                    _sparse_MASS.insertBack( itMDQ.row( ) + MQQ.rows( ), c ) = itMDQ.value( );
-
-                //Add terms to the damping matrix
-                _sparse_DAMPING.startVec( c );
-                for ( SparseMatrix::InnerIterator itCQQ( CQQ, c ); itCQQ; ++itCQQ )
-                    _sparse_DAMPING.insertBack( itCQQ.row( ), c ) = itCQQ.value( );
-                for ( SparseMatrix::InnerIterator itCDQ( CDQ, c ); itCDQ; ++itCDQ )
-                    _sparse_DAMPING.insertBack( itCDQ.row( ) + CQQ.rows( ), c ) = itCDQ.value( );
-
-            }
-
-            for ( uIntType c = 0; c < MDD.cols( ); ++c ){
-
-                //Add terms to the mass matrix
-                _sparse_MASS.startVec( c + MQQ.cols( ) );
-                for ( SparseMatrix::InnerIterator itMQD( MQD, c ); itMQD; ++itMQD )
-                    _sparse_MASS.insertBack( itMQD.row( ), c + MQQ.cols( ) ) = itMQD.value( );
-                for ( SparseMatrix::InnerIterator itMDD( MDD, c ); itMDD; ++itMDD )
-                    _sparse_MASS.insertBack( itMDD.row( ) + MQD.rows( ), c + MDQ.cols( ) ) = itMDD.value( );
-
-                //Add terms to the damping matrix
-                _sparse_DAMPING.startVec( c + CQQ.cols( ) );
-                for ( SparseMatrix::InnerIterator itCQD( CQD, c ); itCQD; ++itCQD )
-                    _sparse_DAMPING.insertBack( itCQD.row( ), c + CQQ.cols( ) ) = itCQD.value( );
-                for ( SparseMatrix::InnerIterator itCDD( CDD, c ); itCDD; ++itCDD )
-                    _sparse_DAMPING.insertBack( itCDD.row( ) + CQD.rows( ), c + CDQ.cols( ) ) = itCDD.value( );
-
-            }
-
-        }
-        else{
-
-            return new errorNode( __func__,
-                                  "The projection type " + config[ "projection_type" ].as< std::string >( ) +
-                                  " is not recognized" );
-
-        }
+                }
 
-        std::cerr << "MASS AND DAMPING MATRICES ASSEMBLED\n";
+                //Check if the macro-node is free
+                auto freeNodeID = std::find( freeMacroNodeIds->begin( ), freeMacroNodeIds->end( ), *nodeID );
 
-        return NULL;
+                if ( freeNodeID != freeMacroNodeIds->end( ) ){
 
-    }
+                    //Extract the degrees of freedom from the free node
+                    nodeDOF = floatVector( freeMacroDisplacements.begin( ) + ( nMacroDispDOF ) * ( index->second ),
+                                           freeMacroDisplacements.begin( ) + ( nMacroDispDOF ) * ( index->second + 1 ) );
 
-    errorOut overlapCoupling::constructKineticEnergyPartitioningCoefficient( const uIntType &macroCellID,
-                                                                             const std::unique_ptr< elib::Element > &element,
-                                                                             floatVector &res ){
-        /*!
-         * Construct the kinetic energy partitioning coefficient
-         *
-         * :param const uIntType &uIntType: The macro cell's ID number
-         * :param const std::unique_ptr< elib::Element > &element: The FEA representation of the macro-scale element
-         * :param floatVector &res: The collection of re values at each element quadrature point
-         */
+                }
+                else{
 
-        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
+                    auto ghostNodeID = std::find( ghostMacroNodeIds->begin( ), ghostMacroNodeIds->end( ), *nodeID );
 
-        std::string strategy = config[ "kinetic_energy_partitioning_coefficient" ][ "type" ].as< std::string >( );
+                    if ( ghostNodeID != ghostMacroNodeIds->end( ) ){
 
-        if ( strategy.compare( "volume_fraction" ) == 0 ){
+                        //Extract the degrees of freedom from the ghost node
+                        nodeDOF = floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDispDOF * ( index->second - _inputProcessor.getFreeMacroNodeIds( )->size( ) ),
+                                               _projected_ghost_macro_displacement.begin( ) + nMacroDispDOF * ( index->second + 1 - _inputProcessor.getFreeMacroNodeIds( )->size( ) ) );
 
-            //Compute the volume of the element
-            
-            floatType elementVolume = 0;
-            floatMatrix jacobian;
-            
-            for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
+                    }
+                    else{
 
-                //Get the Jacobian of transformation
-                errorOut error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
+                        return new errorNode( __func__,
+                                              "The macro node " + std::to_string( *nodeID ) +
+                                              " is not found in either the ghost or free macro node IDs" );
 
-                if ( error ){
- 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the computation of the local gradient\n" );
-                    result->addNext( error );
-                    return result;
+                    }
 
                 }
 
-                elementVolume += vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
-
-            }
-
-            auto microDomainVolumes = homogenizedVolumes.find( macroCellID );
-            if ( microDomainVolumes == homogenizedVolumes.end( ) ){
-
-                return new errorNode( __func__,
-                                      "The macro cell " + std::to_string( macroCellID ) +
-                                      " is not found in the homogenized volumes map" );
-
-            }
-
-            floatType microDomainVolume = 0;
+                //Save the element DOF vector
+                for ( unsigned int i = 0; i < nodeDOF.size( ); i++ ){
 
-            for ( auto microVolume  = microDomainVolumes->second.begin( );
-                       microVolume != microDomainVolumes->second.end( );
-                       microVolume++ ){
+                    elementDOFVector.push_back( nodeDOF[ i ] );
 
-                microDomainVolume += microVolume->second;
+                }
 
             }
 
-            if ( elementVolume < _absoluteTolerance ){
-
-                res = floatVector( element->qrule.size( ), 0 );
+            error = formMicromorphicElementInternalForceVector( element, elementDOFVector,
+                                                                quadraturePointCauchyStress[ *macroCellID ],
+                                                                quadraturePointSymmetricMicroStress[ *macroCellID ],
+                                                                quadraturePointHigherOrderStress[ *macroCellID ],
+                                                                nodeIDToIndex, homogenizedFINT );
 
-            }
-            else{
+            if ( error ){
 
-                res = floatVector( element->qrule.size( ), std::fmax( ( elementVolume - microDomainVolume ) / elementVolume, 0 ) );
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the assembly of the terms of the internal force vector for element " +
+                                                 std::to_string( *macroCellID ) );
+                result->addNext( error );
+                return result;
 
             }
 
-        }
-        else{
-
-            return new errorNode( __func__, "Configuration strategy " + strategy + " not recognized" );
-
         }
 
         return NULL;
 
     }
 
-    errorOut overlapCoupling::assembleCouplingForceVector( ){
+    errorOut overlapCoupling::assembleHomogenizedMassMatrix( ){
         /*!
-         * Assemble the force vector. In Regueiro 2012, the external forces are on the right hand side
-         * and the internal forces are on the left. I will call the, "force vector," the external forces
-         * minus the internal forces. This is distinct from the LHS vector which will include the inertial
-         * and damping forces from the previous increment.
-         *
-         * I also note that, unless we re-compute the micromorphic internal forces, it is not clear how
-         * to get the element-wise contributions for the assembly of the vector. Consequently, we will do
-         * an approximate scheme to handle the potential energy weighting factor.
-         *
-         * Note: If the signs in either the macro ( or micro ) scales are flipped, this can be accounted
-         * for by using the keywords in the coupling initialization section of the configuration file. The
-         * value in "( )" is the default value.
-         *
-         *     macro_internal_force_sign: ( -1 )
-         *     macro_external_force_sign: ( 1 )
-         *     micro_internal_force_sign: ( 1 )
-         *     micro_external_force_sign: ( 1 )
+         * Assemble the homogenized mass matrix.
          */
 
-        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
-        floatType qhat = config[ "potential_energy_weighting_factor" ].as< floatType >( );
-        std::string projection_type = config[ "projection_type" ].as< std::string >( );
-
-        const uIntType nMacroNodeForces = _dim + _dim * _dim;
+        //Loop over the elements in the external force container
+        elib::Element *element;
+        errorOut error = NULL;
+        const DOFMap *nodeIDToIndex = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-        //Get the maps from the global to the local degrees of freedom
-        const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
-        const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+        //Set the number of displacement degrees of freedom
+        unsigned int nMacroDispDOF = _dim + _dim * _dim;
 
-        //Get the free and ghost node ids
+        //Get the free and ghost macro node ids
         const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
         const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
 
-        const uIntVector *freeMicroNodeIds = _inputProcessor.getFreeMicroNodeIds( );
-        const uIntVector *ghostMicroNodeIds = _inputProcessor.getGhostMicroNodeIds( );
-
-        const uIntType nFreeMicroNodes = freeMicroNodeIds->size( );
-        const uIntType nFreeMacroNodes = freeMacroNodeIds->size( );
-
-        //Extract the internal and external forces
-        const std::unordered_map< uIntType, floatVector > *microInternalForces = _inputProcessor.getMicroInternalForces( );
-        const std::unordered_map< uIntType, floatVector > *macroInternalForces = _inputProcessor.getMacroInternalForces( );
-
-        const std::unordered_map< uIntType, floatVector > *microExternalForces = _inputProcessor.getMicroExternalForces( );
-        const std::unordered_map< uIntType, floatVector > *macroExternalForces = _inputProcessor.getMacroExternalForces( );
+        //Assemble the free macro node degree of freedom vector
+        floatVector freeMacroDisplacements( nMacroDispDOF * freeMacroNodeIds->size( ) );
 
-        //Assemble the micro internal and external forces
-        floatVector FintQhat( _dim * ghostMicroNodeIds->size( ), 0 );
-        floatVector FextQhat( _dim * ghostMicroNodeIds->size( ), 0 );
-        for ( auto microID  = ghostMicroNodeIds->begin( );
-                   microID != ghostMicroNodeIds->end( );
-                   microID++ ){
+        const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
+        uIntType macroDispDOFStride;
+        for ( auto it = freeMacroNodeIds->begin( ); it != freeMacroNodeIds->end( ); it++ ){
 
-            //Get the local ID
-            auto idMap = microGlobalToLocalDOFMap->find( *microID );
+            auto map = _inputProcessor.getMacroGlobalToLocalDOFMap( )->find( *it );
 
-            if ( idMap == microGlobalToLocalDOFMap->end( ) ){
+            if ( map == _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( ) ){
 
                 return new errorNode( __func__,
-                                      "ghost micro node " + std::to_string( *microID ) +
-                                      " is not found in the local to global DOF map" );
+                                      "Global degree of freedom '" + std::to_string( *it ) + "' not found in degree of freedom map" );
 
             }
 
-            if ( idMap->second < nFreeMicroNodes ){
+            const floatType *macroDisplacement;
+            error = macroNodeFields->getNodeValues( "displacement_dof", *it, macroDisplacement, macroDispDOFStride );
 
-                return new errorNode( __func__, "The local index is smaller than the number of free micro nodes" );
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Global macro degree of freedom '" + std::to_string( *it ) + "' not found in the macro displacement dof field" );
+                result->addNext( error );
+                return result;
 
             }
 
-            if ( ( _dim * ( idMap->second - nFreeMicroNodes ) + _dim ) > FintQhat.size( ) ){
+            //Set the macro displacements
+            for ( unsigned int i = 0; i < nMacroDispDOF; i++ ){
 
-                return new errorNode( __func__, "Local index is larger than the force vector" );
+                freeMacroDisplacements[ nMacroDispDOF * ( map->second ) + i ] = macroDisplacement[ i ];
 
             }
 
-            auto internalForce = microInternalForces->find( *microID );
-
-            if ( internalForce == microInternalForces->end( ) ){
-
-                return new errorNode( __func__, "Micro node " + std::to_string( *microID ) + " not found in internal force vector" );
+        }
 
-            }
+        //Loop over the macro cells adding the contributions to the mass matrix
+        floatVector elementDOFVector;
 
-            auto externalForce = microExternalForces->find( *microID );
+        //Collect all of the cells in the overlapping domain
+        const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
+        const uIntVector *ghostMacroCellIds = _inputProcessor.getGhostMacroCellIds( );
 
-            if ( externalForce == microInternalForces->end( ) ){
+        uIntVector macroCellIDVector( freeMacroCellIds->begin( ), freeMacroCellIds->end( ) );
+        macroCellIDVector = vectorTools::appendVectors( { macroCellIDVector, *ghostMacroCellIds } );
 
-                return new errorNode( __func__, "Micro node " + std::to_string( *microID ) + " not found in external force vector" );
+        tripletVector coefficients;
 
-            }
+        uIntType numCoefficients = 0;
+        for ( auto it = externalForcesAtNodes.begin( ); it != externalForcesAtNodes.end( ); it++ ){
 
+            //Get the number of quadrature points in the element
+            uIntType elementQuadraturePointCount = quadraturePointDensities[ it->first ].size( );
 
-            for ( unsigned int i = 0; i < _dim; i++ ){
+            //Get the number of nodes in the element
+            uIntType elementNodeCount = it->second.size( ) / _dim;
+            numCoefficients += elementQuadraturePointCount * elementNodeCount * elementNodeCount * _dim * _dim * ( 1 + _dim * _dim );
 
-                if ( _inputProcessor.microInternalForceDefined( ) ){
+        }
 
-                    FintQhat[ _dim * ( idMap->second - nFreeMicroNodes ) + i ] = ( 1 - qhat ) * internalForce->second[ i ];
+        coefficients.reserve( numCoefficients );
 
-                }
+        for ( auto macroCellID = macroCellIDVector.begin( ); macroCellID != macroCellIDVector.end( ); macroCellID++ ){
 
-                if ( _inputProcessor.microExternalForceDefined( ) ){
+            //Form the macro element
+            error = getMacroDomainElement( *macroCellID,
+                                           *_inputProcessor.getMacroNodeReferencePositions( ),
+                                           *_inputProcessor.getMacroDisplacements( ),
+                                           *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                           element );
 
-                    FextQhat[ _dim * ( idMap->second - nFreeMicroNodes ) + i ] = ( 1 - qhat ) * externalForce->second[ i ];
+            if ( error ){
 
-                }
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the construction of the macro domain element for macro cell " +
+                                                 std::to_string( *macroCellID ) );
+                result->addNext( error );
+                return result;
 
             }
 
-        }
-
-        floatVector FintQ( _dim * freeMicroNodeIds->size( ), 0 );
-        floatVector FextQ( _dim * freeMicroNodeIds->size( ), 0 );
-        for ( auto microID  = freeMicroNodeIds->begin( );
-                   microID != freeMicroNodeIds->end( );
-                   microID++ ){
+            //Extract the homogenized degrees of freedom for the element
+            floatVector nodeDOF;
+            elementDOFVector.clear( );
+            elementDOFVector.reserve( nMacroDispDOF * element->nodes.size( ) );
 
-            //Get the local ID
-            auto idMap = microGlobalToLocalDOFMap->find( *microID );
+            for ( auto nodeID = element->global_node_ids.begin( ); nodeID != element->global_node_ids.end( ); nodeID++ ){
 
-            if ( idMap == microGlobalToLocalDOFMap->end( ) ){
+                //Find the node in the global to local map
+                auto index = nodeIDToIndex->find( *nodeID );
 
-                return new errorNode( __func__,
-                                      "free micro node " + std::to_string( *microID ) +
-                                      " is not found in the local to global DOF map" );
+                if ( index == nodeIDToIndex->end( ) ){
 
-            }
+                    return new errorNode( __func__,
+                                          "Macro-scale node with global id " + std::to_string( *nodeID ) +
+                                          " is not found in the global ID to the local index" );
 
-            auto internalForce = microInternalForces->find( *microID );
+                }
 
-            if ( internalForce == microInternalForces->end( ) ){
+                //Check if the macro-node is free
+                auto freeNodeID = std::find( freeMacroNodeIds->begin( ), freeMacroNodeIds->end( ), *nodeID );
 
-                return new errorNode( __func__, "Micro node " + std::to_string( *microID ) + " not found in internal force vector" );
+                if ( freeNodeID != freeMacroNodeIds->end( ) ){
 
-            }
+                    //Extract the degrees of freedom from the free node
+                    nodeDOF = floatVector( freeMacroDisplacements.begin( ) + ( nMacroDispDOF ) * ( index->second ),
+                                           freeMacroDisplacements.begin( ) + ( nMacroDispDOF ) * ( index->second + 1 ) );
 
-            auto externalForce = microExternalForces->find( *microID );
+                }
+                else{
 
-            if ( externalForce == microInternalForces->end( ) ){
+                    auto ghostNodeID = std::find( ghostMacroNodeIds->begin( ), ghostMacroNodeIds->end( ), *nodeID );
 
-                return new errorNode( __func__, "Micro node " + std::to_string( *microID ) + " not found in external force vector" );
+                    if ( ghostNodeID != ghostMacroNodeIds->end( ) ){
 
-            }
+                        //Extract the degrees of freedom from the ghost node
+                        nodeDOF = floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDispDOF * ( index->second - _inputProcessor.getFreeMacroNodeIds( )->size( ) ),
+                                               _projected_ghost_macro_displacement.begin( ) + nMacroDispDOF * ( index->second + 1 - _inputProcessor.getFreeMacroNodeIds( )->size( ) ) );
 
-            for ( unsigned int i = 0; i < _dim; i++ ){
+                    }
+                    else{
 
-                if ( _inputProcessor.microInternalForceDefined( ) ){
+                        return new errorNode( __func__,
+                                              "The macro node " + std::to_string( *nodeID ) +
+                                              " is not found in either the ghost or free macro node IDs" );
 
-                    FintQ[ _dim * idMap->second + i ] = ( 1 - qhat ) * internalForce->second[ i ];
+                    }
 
                 }
 
-                if ( _inputProcessor.microExternalForceDefined( ) ){
+                //Save the element DOF vector
+                for ( unsigned int i = 0; i < nodeDOF.size( ); i++ ){
 
-                    FextQ[ _dim * idMap->second + i ] = ( 1 - qhat ) * externalForce->second[ i ];
+                    elementDOFVector.push_back( nodeDOF[ i ] );
 
                 }
 
             }
 
+            //Add the contributions to the mass matrix
+            error = formMicromorphicElementMassMatrix( element, elementDOFVector,
+                                                       quadraturePointMicroInertias[ *macroCellID ],
+                                                       quadraturePointDensities[ *macroCellID ],
+                                                       nodeIDToIndex, coefficients );
+
         }
 
-        //Compute the potential energy partitioning coefficients
-        std::unordered_map< uIntType, floatType > qes;
-        errorOut error = constructPotentialEnergyPartitioningCoefficient( qes );
+        homogenizedMassMatrix = SparseMatrix( ( _dim + _dim * _dim ) * nodeIDToIndex->size( ),
+                                              ( _dim + _dim * _dim ) * nodeIDToIndex->size( ) );
+        homogenizedMassMatrix.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
+
+        return NULL;
+
+    }
+
+    errorOut overlapCoupling::assembleHomogenizedMatricesAndVectors( ){
+        /*!
+         * Assemble the homogenized mass matrices and force vectors
+         */
+
+        errorOut error = assembleHomogenizedExternalForceVector( );
 
         if ( error ){
 
             errorOut result = new errorNode( __func__,
-                                             "Error in the construction of the potential energy partitioning coefficients" );
+                                             "Error in the construction of the homogenized external force vector" );
             result->addNext( error );
             return result;
 
         }
 
-        //Assemble the macro internal and external forces
-        floatVector FintDhat( nMacroNodeForces * ghostMacroNodeIds->size( ), 0 );
-        floatVector FextDhat( nMacroNodeForces * ghostMacroNodeIds->size( ), 0 );
-        for ( auto nodeID = ghostMacroNodeIds->begin( ); nodeID != ghostMacroNodeIds->end( ); nodeID++ ){
+        error = assembleHomogenizedInternalForceVector( );
 
-            //Get the local ID
-            auto idMap = macroGlobalToLocalDOFMap->find( *nodeID );
+        if ( error ){
 
-            if ( idMap == macroGlobalToLocalDOFMap->end( ) ){
+            errorOut result = new errorNode( __func__,
+                                             "Error in the construction of the homogenized internal force vector" );
+            result->addNext( error );
+            return result;
 
-                return new errorNode( __func__,
-                                      "ghost macro node " + std::to_string( *nodeID ) +
-                                      " is not found in the local to global DOF map" );
+        }
 
-            }
+        error = assembleHomogenizedMassMatrix( );
 
-            auto nodeQes = qes.find( *nodeID );
+        if ( error ){
 
-            if ( idMap->second < nFreeMacroNodes ){
+            errorOut result = new errorNode( __func__,
+                                             "Error in the construction of the homogenized mass matrix" );
+            result->addNext( error );
+            return result;
 
-                return new errorNode( __func__,
-                                      "ghost macro node " + std::to_string( *nodeID ) +
-                                      " has a local position not consistent with the number of free macro nodes" );
+        }
 
-            }
+        return NULL;
 
-            if ( ( nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + nMacroNodeForces ) > FintDhat.size( ) ){
+    }
 
-                return new errorNode( __func__,
-                                      "ghost macro node " + std::to_string( *nodeID ) +
-                                      " has a local position larger than allocated in the coupling force vector" );
+    errorOut overlapCoupling::assembleFreeMicromorphicMassMatrix( ){
+        /*!
+         * Assemble the micromorphic mass matrix for the free micromorphic domains.
+         *
+         * It is noted that while we are only processing the free micromorphic domains,
+         * there WILL be ghost nodes because even though a micromorphic domain may be
+         * marked as free, some of the nodes can ( and will in the current framework )
+         * be ghost.
+         */
 
-            }
+        //Set the displacement degrees of freedom for the element
+        const unsigned int nMacroDOF = _dim + _dim * _dim;
+
+        //Get the micromorphic densities in the reference configuration
+        const std::unordered_map< uIntType, std::string > *macroReferenceDensityTypes = _inputProcessor.getMacroReferenceDensityTypes( );
+        const std::unordered_map< uIntType, floatVector > *macroReferenceDensities = _inputProcessor.getMacroReferenceDensities( );
 
-            auto internalForce = macroInternalForces->find( *nodeID );
+        //Get the micromorphic moments of inertia in the reference configuration
+        const std::unordered_map< uIntType, std::string > *macroReferenceMomentOfInertiaTypes
+            = _inputProcessor.getMacroReferenceMomentOfInertiaTypes( );
+        const std::unordered_map< uIntType, floatVector > *macroReferenceMomentsOfInertia
+            = _inputProcessor.getMacroReferenceMomentsOfInertia( );
 
-            if ( internalForce == macroInternalForces->end( ) ){
+        //Initialize the coefficients vector
+        tripletVector coefficients;
 
-                return new errorNode( __func__, "Macro node " + std::to_string( *nodeID ) +
-                                      " not found in internal force vector" );
+        uIntType numCoefficients = 0;
+        for ( auto it = externalForcesAtNodes.begin( ); it != externalForcesAtNodes.end( ); it++ ){
 
-            }
+            //Get the number of quadrature points in the element
+            uIntType elementQuadraturePointCount = quadraturePointDensities[ it->first ].size( );
 
-            auto externalForce = macroExternalForces->find( *nodeID );
+            //Get the number of nodes in the element
+            uIntType elementNodeCount = it->second.size( ) / _dim;
+            numCoefficients += elementQuadraturePointCount * elementNodeCount * elementNodeCount * _dim * _dim * ( 1 + _dim * _dim );
 
-            if ( externalForce == macroInternalForces->end( ) ){
+        }
 
-                return new errorNode( __func__, "Macro node " + std::to_string( *nodeID ) +
-                                      " not found in external force vector" );
+        coefficients.reserve( numCoefficients );
 
-            }
+        //Loop over the free micromorphic elements
+        for ( auto macroCellID  = _inputProcessor.getFreeMacroCellIds( )->begin( );
+                   macroCellID != _inputProcessor.getFreeMacroCellIds( )->end( );
+                   macroCellID++ ){
 
-            for ( unsigned int i = 0; i < nMacroNodeForces; i++ ){
+            //Construct the macro-domain element
+            elib::Element *element;
+            errorOut error = getMacroDomainElement( *macroCellID,
+                                                    *_inputProcessor.getMacroNodeReferencePositions( ),
+                                                    *_inputProcessor.getMacroDisplacements( ),
+                                                    *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                                    element );
 
-                FintDhat[ nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + i ]
-                    = qhat * homogenizedFINT( nMacroNodeForces * idMap->second + i );
-                FextDhat[ nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + i ]
-                    = qhat * homogenizedFEXT( nMacroNodeForces * idMap->second + i );
+            if ( error ){
 
-                if ( nodeQes != qes.end( ) ){
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the construction of the macro element " + std::to_string( *macroCellID ) );
+                result->addNext( error );
+                return result;
 
-                    if ( _inputProcessor.macroInternalForceDefined( ) ){
+            }
 
-                        FintDhat[ nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + i ]
-                            += nodeQes->second * internalForce->second[ i ];
+            //Get the degree of freedom values for the free macro-domain element
+            const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
+            const floatType *macroDisplacement;
+            uIntType stride;
+            floatVector elementDOFVector( 0 );
 
-                    }
+            for ( auto nodeID  = element->global_node_ids.begin( );
+                       nodeID != element->global_node_ids.end( );
+                       nodeID++ ){
 
-                    if ( _inputProcessor.macroExternalForceDefined( ) ){
+                error = macroNodeFields->getNodeValues( "displacement_dof", *nodeID, macroDisplacement, stride );
 
-                        FintDhat[ nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + i ]
-                            += nodeQes->second * externalForce->second[ i ];
+                if ( error ){
 
-                    }
+                    errorOut result = new errorNode( __func__,
+                                                     "Macro node " + std::to_string( *nodeID ) + " was not found in the macro displacement DOF field" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-            }
-
-        }
+                elementDOFVector.insert( elementDOFVector.end( ), macroDisplacement, macroDisplacement + stride );
 
-        floatVector FintD( nMacroNodeForces * freeMacroNodeIds->size( ), 0 );
-        floatVector FextD( nMacroNodeForces * freeMacroNodeIds->size( ), 0 );
-        for ( auto nodeID = freeMacroNodeIds->begin( ); nodeID != freeMacroNodeIds->end( ); nodeID++ ){
+            }
 
-            //Get the local ID
-            auto idMap = macroGlobalToLocalDOFMap->find( *nodeID );
+            //Extract the density and moment of inertia in the reference configuration
+            auto densityType = macroReferenceDensityTypes->find( *macroCellID );
 
-            if ( idMap == macroGlobalToLocalDOFMap->end( ) ){
+            if ( densityType == macroReferenceDensityTypes->end( ) ){
 
                 return new errorNode( __func__,
-                                      "free macro node " + std::to_string( *nodeID ) +
-                                      " is not found in the local to global DOF map" );
+                                      "The macro cell with ID " + std::to_string( *macroCellID ) +
+                                      " was not found in the density type map" );
 
             }
 
-            auto nodeQes = qes.find( *nodeID );
-
-            auto internalForce = macroInternalForces->find( *nodeID );
+            auto momentOfInertiaType = macroReferenceMomentOfInertiaTypes->find( *macroCellID );
 
-            if ( internalForce == macroInternalForces->end( ) ){
+            if ( momentOfInertiaType == macroReferenceMomentOfInertiaTypes->end( ) ){
 
-                return new errorNode( __func__, "Macro node " + std::to_string( *nodeID ) +
-                                      " not found in internal force vector" );
+                return new errorNode( __func__,
+                                      "The macro cell with ID " + std::to_string( *macroCellID ) +
+                                      " was not found in the moment of inertia type map" );
 
             }
 
-            auto externalForce = macroExternalForces->find( *nodeID );
-
-            if ( externalForce == macroInternalForces->end( ) ){
+            if ( densityType->second.compare( "constant" ) != 0 ){
 
-                return new errorNode( __func__, "Macro node " + std::to_string( *nodeID ) +
-                                      " not found in external force vector" );
+                return new errorNode( __func__,
+                                      "Only constant densities for the macro-scale are allowed currently. This is not true for macro cell ID " + std::to_string( *macroCellID ) );
 
             }
 
-            for ( unsigned int i = 0; i < nMacroNodeForces; i++ ){
+            if ( momentOfInertiaType->second.compare( "constant" ) != 0 ){
 
-                FintD[ nMacroNodeForces * idMap->second + i ]
-                    = qhat * homogenizedFINT( nMacroNodeForces * idMap->second + i );
-                FextD[ nMacroNodeForces * idMap->second + i ]
-                    = qhat * homogenizedFEXT( nMacroNodeForces * idMap->second + i );
+                return new errorNode( __func__,
+                                      "Only constant moments of inertia for the macro-scale are allowed currently. This is not true for macro cell ID " + std::to_string( *macroCellID ) );
 
-                if ( nodeQes != qes.end( ) ){
+            }
 
-                    if ( _inputProcessor.macroInternalForceDefined( ) ){
+            bool quantitiesInReference = true; //TODO: We currently assume all of the quantities are defined in the reference configuration
 
-                        FintD[ nMacroNodeForces * idMap->second + i ]
-                            += nodeQes->second * internalForce->second[ i ];
+            auto macroDensities = macroReferenceDensities->find( *macroCellID );
 
-                    }
+            if ( macroDensities == macroReferenceDensities->end( ) ){
 
-                    if ( _inputProcessor.macroExternalForceDefined( ) ){
+                return new errorNode( __func__,
+                                      "Macro cell ID " + std::to_string( *macroCellID ) +
+                                      " is not in the macro reference density map" );
 
-                        FextD[ nMacroNodeForces * idMap->second + i ]
-                            += nodeQes->second * externalForce->second[ i ];
+            }
 
-                    }
+            if ( macroDensities->second.size( ) != 1 ){
 
-                }
+                return new errorNode( __func__,
+                                      "The macro densities for macro cell " + std::to_string( *macroCellID ) +
+                                      "Define " + std::to_string( macroDensities->second.size( ) ) +
+                                      " values when only 1 can be defined" );
 
             }
 
-        }
-
-        //Map the forces to Eigen Vectors to allow for easy computation
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FintQ( FintQ.data(), FintQ.size( ), 1 );
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FextQ( FextQ.data(), FextQ.size( ), 1 );
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FintD( FintD.data(), FintD.size( ), 1 );
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FextD( FextD.data(), FextD.size( ), 1 );
+            auto macroMomentsOfInertia = macroReferenceMomentsOfInertia->find( *macroCellID );
 
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FintQhat( FintQhat.data(), FintQhat.size( ), 1 );
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FextQhat( FextQhat.data(), FextQhat.size( ), 1 );
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FintDhat( FintDhat.data(), FintDhat.size( ), 1 );
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FextDhat( FextDhat.data(), FextDhat.size( ), 1 );
+            if ( macroMomentsOfInertia == macroReferenceMomentsOfInertia->end( ) ){
 
-        //Initialize the force vectors
-        Eigen::MatrixXd _FQ, _FD;
+                return new errorNode( __func__,
+                                      "Macro cell ID " + std::to_string( *macroCellID ) +
+                                      " is not in the macro reference moments of inertia map" );
 
-#ifdef TESTACCESS
+            }
 
-        _test_FintQ = _FintQ;
-        _test_FextQ = _FextQ;
+            if ( macroMomentsOfInertia->second.size( ) != _dim * _dim ){
 
-        _test_FintD = _FintD;
-        _test_FextD = _FextD;
+                return new errorNode( __func__,
+                                      "The macro moments of inertia for macro cell " + std::to_string( *macroCellID ) +
+                                      "Define " + std::to_string( macroDensities->second.size( ) ) +
+                                      " values when only " + std::to_string( _dim * _dim ) + " can be defined" );
 
-        _test_FintQhat = _FintQhat;
-        _test_FextQhat = _FextQhat;
+            }
 
-        _test_FintDhat = _FintDhat;
-        _test_FextDhat = _FextDhat;
+            floatVector densities( element->qrule.size( ), macroDensities->second[ 0 ] );
 
-#endif
+            floatVector momentsOfInertia
+                = vectorTools::appendVectors( floatMatrix( element->qrule.size( ), macroMomentsOfInertia->second ) );
 
-        if ( ( projection_type.compare( "l2_projection" ) == 0 ) ){
-            //Assemble the micro force vector
-            _FQ  = _FextQ;
-            _FQ += _dense_BQhatQ.transpose( ) * _FextQhat;
-            _FQ -= _FintQ;
-            _FQ -= _dense_BQhatQ.transpose( ) * _FintQhat;
-            _FQ -= _dense_BDhatQ.transpose( ) * _FintDhat;
-    
-            //Assemble the macro force vector
-            _FD  = _FextD;
-            _FD += _dense_BDhatD.transpose( ) * _FextDhat;
-            _FD -= _FintD;
-            _FD -= _dense_BQhatD.transpose( ) * _FintQhat;
-            _FD -= _dense_BDhatD.transpose( ) * _FintDhat;
+            //Construct the kinetic energy partitioning coefficient at each quadrature point
+            floatVector res;
+            error = constructKineticEnergyPartitioningCoefficient( *macroCellID, element, res );
 
-        }
-        else if ( ( projection_type.compare( "direct_projection" ) == 0 ) ||
-                  ( projection_type.compare( "averaged_l2_projection" ) == 0 ) ){
+            if ( error ){
 
-            //Assemble the micro force vector
-            _FQ  = _FextQ;
-            _FQ += _sparse_BQhatQ.transpose( ) * _FextQhat;
-            _FQ -= _FintQ;
-            _FQ -= _sparse_BQhatQ.transpose( ) * _FintQhat;
-            _FQ -= _sparse_BDhatQ.transpose( ) * _FintDhat;
-    
-            //Assemble the macro force vector
-            _FD  = _FextD;
-            _FD += _sparse_BDhatD.transpose( ) * _FextDhat;
-            _FD -= _FintD;
-            _FD -= _sparse_BQhatD.transpose( ) * _FintQhat;
-            _FD -= _sparse_BDhatD.transpose( ) * _FintDhat;
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the construction of the kinetic energy partitoning coefficient for macro cell " + std::to_string( *macroCellID ) );
+                result->addNext( error );
+                return result;
 
-        }
-        else{
+            }
 
-            return new errorNode( __func__,
-                                  "The projection type: " + projection_type + " is not recognized" );
+            for ( auto re = res.begin( ); re != res.end( ); re++ ){
 
-        }
+                unsigned int re_indx = re - res.begin( );
 
-        //Assemble the full force vector
-        _FORCE = Eigen::MatrixXd( _FQ.rows( ) + _FD.rows( ), 1 );
-        _FORCE << _FQ, _FD;
+                densities[ re_indx ] *= *re;
 
-//        std::cout << "FintQ:\n";
-//        for ( unsigned int i = 0; i < FintQ.size( ); i++ ){
-//            std::cout << _FintQ( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
-//        std::cout << "FintD:\n";
-//        for ( unsigned int i = 0; i < FintD.size( ); i++ ){
-//            std::cout << _FintD( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
+                for ( auto mOI  = momentsOfInertia.begin( ) + _dim * _dim * re_indx;
+                           mOI != momentsOfInertia.begin( ) + _dim * _dim * ( re_indx + 1 );
+                           mOI++ ){
 
-//        std::cout << "FextQ:\n";
-//        for ( unsigned int i = 0; i < FextQ.size( ); i++ ){
-//            std::cout << _FextQ( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
-//        std::cout << "FextD:\n";
-//        for ( unsigned int i = 0; i < FextD.size( ); i++ ){
-//            std::cout << _FextD( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
+                    unsigned int mOI_indx = mOI - momentsOfInertia.begin( );
+                    momentsOfInertia[ mOI_indx ] *= *re;
 
-//        std::cout << "FextQhat:\n";
-//        for ( unsigned int i = 0; i < FextQhat.size( ); i++ ){
-//            std::cout << _FextQhat( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
-//        std::cout << "FextDhat:\n";
-//        for ( unsigned int i = 0; i < FextDhat.size( ); i++ ){
-//            std::cout << _FextDhat( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
+                }
 
-//        std::cout << "FintQhat:\n";
-//        for ( unsigned int i = 0; i < FintQhat.size( ); i++ ){
-//            std::cout << _FintQhat( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
-//        std::cout << "FintDhat:\n";
-//        for ( unsigned int i = 0; i < FintDhat.size( ); i++ ){
-//            std::cout << _FintDhat( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
+            }
 
-//        std::cout << "FQ:\n";
-//        for ( unsigned int i = 0; i < _FQ.size( ); i++ ){
-//            std::cout << _FQ( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
-//        std::cout << "FD:\n";
-//        for ( unsigned int i = 0; i < _FD.size( ); i++ ){
-//            std::cout << _FD( i, 0 ) << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
-//
-//        floatVector tmpVec( 3, 0 );
-//        for ( unsigned int i = 0; i < _FQ.size( ); i++ ){
-//            tmpVec[ ( i + 1 ) % 3 ] += fabs( _FQ( i, 0 ) );
-//        }
-//        std::cout << "Sum of FQ: "; vectorTools::print( tmpVec );
-//
-//        tmpVec = floatVector( 12, 0 );
-//        for ( unsigned int i = 0; i < _FD.size( ); i++ ){
-//            tmpVec[ ( i + 1 ) % 12 ] += fabs( _FD( i, 0 ) );
-//        }
-//        std::cout << "Sum of FD: "; vectorTools::print( tmpVec );
-//
-//        return new errorNode( __func__, "derp" );
-//
-//        std::cout << "FextQ NORM:    " << _FextQ.norm( ) << "\n";
-//        std::cout << "FextD NORM:    " << _FextD.norm( ) << "\n";
-//        std::cout << "FextQhat NORM: " << _FextQhat.norm( ) << "\n";
-//        std::cout << "FextDhat NORM: " << _FextDhat.norm( ) << "\n";
-//        std::cout << "FintQ NORM:    " << _FintQ.norm( ) << "\n";
-//        std::cout << "FintD NORM:    " << _FintD.norm( ) << "\n";
-//        std::cout << "FintQhat NORM: " << _FintQhat.norm( ) << "\n";
-//        std::cout << "FintDhat NORM: " << _FintDhat.norm( ) << "\n";
-//        std::cout << "FQ NORM:       " << _FQ.norm( ) << "\n";
-//        std::cout << "FD NORM:       " << _FD.norm( ) << "\n";
-//        std::cout << "FORCE NORM:    " << _FORCE.norm( ) << "\n";
+            error = formMicromorphicElementMassMatrix( element, elementDOFVector, momentsOfInertia, densities, 
+                                                       _inputProcessor.getMacroGlobalToLocalDOFMap( ), coefficients,
+                                                       NULL, quantitiesInReference );
+
+            if ( error ){
+
+                std::string outstr  = "Error in the construction of the contributions of the macro element to ";
+                            outstr += "the free micromorphic mass matrix";
+
+                errorOut result = new errorNode( __func__, outstr );
+                result->addNext( error );
+                return result;
+
+            }
+
+
+        }
+
+        const DOFMap *nodeIDToIndex = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+        freeMicromorphicMassMatrix = SparseMatrix( nMacroDOF * nodeIDToIndex->size( ), nMacroDOF * nodeIDToIndex->size( ) );
+        freeMicromorphicMassMatrix.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
 
         return NULL;
     }
 
-    errorOut overlapCoupling::constructPotentialEnergyPartitioningCoefficient( std::unordered_map< uIntType, floatType > &qes ){
+    errorOut overlapCoupling::assembleCouplingMassAndDampingMatrices( ){
         /*!
-         * Construct the potential energy partitioning coefficient ( qe in Regueiro 2012 )
-         *
-         * Currently only volume_fraction is implemented
+         * Assemble the mass matrix for the coupling equations
          *
-         * :param std::unordered_map< uIntType, floatType > &qes: The potential energy partitioning coefficents
-         *     at the free nodes in the free macro cells.
+         * It is assumed that ghost nodes cannot also be free or non-overlapped.
+         * It is assumed that free nodes cannot also be non-overlapped
+         * If a node is defined in multiple locations ( i.e. it is on the boundary ) then:
+         * For the micro-scale the order of preference is:
+         *     non-overlapped > free > ghost ( we assume the open window DNS is the best representation of the PDE )
+         * For the macro-scale the order of preference is:
+         *     ghost > free > non-overlapped ( we assume the micro-scale is the best representation of the PDE )
+         * It is also assumed that the micro-scale can be represented by a diagonal mass matrix while the 
+         * consistent mass matrix is used at the macro-scale.
          */
 
+        //Set the number of displacement degrees of freedom
+        uIntType nMacroDispDOF = _dim + _dim * _dim;
+
+        //Get the configuration of the coupling
         const YAML::Node config = _inputProcessor.getCouplingInitialization( );
-        std::string strategy = config[ "potential_energy_partitioning_coefficient" ][ "type" ].as< std::string >( );
+        floatType rhat = config[ "kinetic_energy_weighting_factor" ].as< floatType >( );
+        floatType aQ = config[ "micro_proportionality_coefficient" ].as< floatType >( );
+        floatType aD = config[ "macro_proportionality_coefficient" ].as< floatType >( );
 
-        if ( strategy.compare( "volume_fraction" ) == 0 ){
+        //Get the fields which store the micro densities and volumes
+        const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+        const floatType *microDensity, *microVolume;
+        uIntType stride;
+        errorOut error;
 
-            const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
-            const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
-            const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
-    
-            //Compute the volumes of the overlaped macro domains
-            std::unordered_map< uIntType, floatType > macroCellNodeTotalVolumes;
-            macroCellNodeTotalVolumes.reserve( freeMacroNodeIds->size( ) + ghostMacroNodeIds->size( ) );
-    
-            qes.reserve( freeMacroNodeIds->size( ) );
-    
-            for ( auto macroCellID  = freeMacroCellIds->begin( );
-                       macroCellID != freeMacroCellIds->end( );
-                       macroCellID++ ){
-    
-                //Construct the macro-domain element
-                std::unique_ptr< elib::Element > element;
-                errorOut error = buildMacroDomainElement( *macroCellID,
-                                                          *_inputProcessor.getMacroNodeReferencePositions( ),
-                                                          *_inputProcessor.getMacroDisplacements( ),
-                                                          *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                                          element );
-    
-                if ( error ){
-    
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the construction of the macro element " + std::to_string( *macroCellID ) );
-                    result->addNext( error );
-                    return result;
-    
-                }
-    
-                //Compute the volume of the macro element
-                floatType elementVolume = 0;
-                floatMatrix jacobian;
-                
-                for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
-    
-                    //Get the Jacobian of transformation
-                    errorOut error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
-    
-                    if ( error ){
-     
-                        errorOut result = new errorNode( __func__,
-                                                         "Error in the computation of the local gradient\n" );
-                        result->addNext( error );
-                        return result;
-    
-                    }
-    
-                    elementVolume += vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
-    
-                }
-    
-                //Compute the volumes of the overlapped micro domains for the macro cell
-                auto microDomainVolumes = homogenizedVolumes.find( *macroCellID );
-                if ( microDomainVolumes == homogenizedVolumes.end( ) ){
-    
-                    return new errorNode( __func__,
-                                          "The macro cell " + std::to_string( *macroCellID ) +
-                                          " is not found in the homogenized volumes map" );
-    
-                }
-    
-                floatType microDomainVolume = 0;
+        //Get the global to local micro node mapping
+        const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
+
+        //Get the IDs of the ghost and free micro nodes
+        const uIntVector *ghostMicroNodeIDs = _inputProcessor.getGhostMicroNodeIds( );
+        const uIntVector *freeMicroNodeIDs = _inputProcessor.getFreeMicroNodeIds( );
+
+        //Get the IDs of the ghost and free macro nodes
+        const uIntVector *ghostMacroNodeIDs = _inputProcessor.getGhostMacroNodeIds( );
+        const uIntVector *freeMacroNodeIDs = _inputProcessor.getFreeMacroNodeIds( );
+
+        //Determine the offset of the free micro nodes
+        const uIntType nFreeMicroNodes = freeMicroNodeIDs->size( );
+
+        //Determine the offset of the free macro nodes
+        const uIntType nFreeMacroNodes = freeMacroNodeIDs->size( );
+        const uIntType nGhostMacroNodes = ghostMacroNodeIDs->size( );
+                
+        //Get the micro mass vectors
+        floatVector ghostMicroMasses( ghostMicroNodeIDs->size( ), 0 );
+        floatVector freeMicroMasses( freeMicroNodeIDs->size( ), 0 );
+
+        //Assemble the free micro mass vector
+        for ( auto microID = freeMicroNodeIDs->begin( ); microID != freeMicroNodeIDs->end( ); microID++ ){
+
+            auto localMicroNodeIDMap = microGlobalToLocalDOFMap->find( *microID );
+
+            if ( localMicroNodeIDMap == microGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "Free micro node: " + std::to_string( *microID ) + " not found in global to local map\n" );
+
+            }
+
+            error = microNodeFields->getNodeValues( "density", *microID, microDensity, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Free micro node " + std::to_string( *microID ) + " was not found in the micro density field" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            error = microNodeFields->getNodeValues( "volume", *microID, microVolume, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Free micro node " + std::to_string( *microID ) + " was not found in the micro volume field" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            freeMicroMasses[ localMicroNodeIDMap->second ] = ( *microVolume ) * ( *microDensity );
+
+        }
+
+#ifdef TESTACCESS
+
+        _test_freeMicroMasses = freeMicroMasses;
+
+#endif
+
+        //Assemble the ghost micro mass vector
+        for ( auto microID = ghostMicroNodeIDs->begin( ); microID != ghostMicroNodeIDs->end( ); microID++ ){
+
+            auto localMicroNodeIDMap = microGlobalToLocalDOFMap->find( *microID );
+
+            if ( localMicroNodeIDMap == microGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "Ghost micro node: " + std::to_string( *microID ) + " not found in global to local map\n" );
+
+            }
+
+            error = microNodeFields->getNodeValues( "density", *microID, microDensity, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Free micro node " + std::to_string( *microID ) + " was not found in the micro density field" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            error = microNodeFields->getNodeValues( "volume", *microID, microVolume, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Free micro node " + std::to_string( *microID ) + " was not found in the micro volume field" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            ghostMicroMasses[ localMicroNodeIDMap->second - nFreeMicroNodes ] = ( *microVolume ) * ( *microDensity );
+
+        }
+
+#ifdef TESTACCESS
+
+        _test_ghostMicroMasses = ghostMicroMasses;
+
+#endif
+
+        //Assemble the mass sub-matrices
+//        Eigen::VectorXd mq( 3 * freeMicroMasses.size( ) );
+//        Eigen::VectorXd mqhat( 3 * ghostMicroMasses.size( ) );
+        tripletVector c1;
+        tripletVector c2;
+
+        c1.reserve( _dim * ghostMicroMasses.size( ) ); 
+        c2.reserve( _dim * freeMicroMasses.size( ) ); 
+
+        uIntType mIndex = 0;
+
+        for ( auto m = ghostMicroMasses.begin( ); m != ghostMicroMasses.end( ); m++, mIndex++ ){
+
+            for ( unsigned int i = 0; i < _dim; i++ ){
+
+                c1.push_back( DOFProjection::T( _dim * mIndex + i, _dim * mIndex + i, ( 1 - rhat ) * ( *m ) ) );
+//                mqhat( _dim * mIndex + i ) = ( 1 - rhat ) * ( *m );
+
+            }
+
+        }
+
+        mIndex = 0;
+
+        for ( auto m = freeMicroMasses.begin( ); m != freeMicroMasses.end( ); m++, mIndex++ ){
+
+            for ( unsigned int i = 0; i < _dim; i++ ){
+
+                c2.push_back( DOFProjection::T( _dim * mIndex + i, _dim * mIndex + i, ( 1 - rhat ) * ( *m ) ) );
+//                mq( _dim * mIndex + i ) = ( 1 - rhat ) * ( *m );
+
+            }
+
+        }
+
+        SparseMatrix MQ( _dim * freeMicroMasses.size( ), _dim * freeMicroMasses.size( ) );
+        MQ.setFromTriplets( c2.begin( ), c2.end( ) );
+
+        SparseMatrix MQhat( _dim * ghostMicroMasses.size( ), _dim * ghostMicroMasses.size( ) );
+        MQhat.setFromTriplets( c1.begin( ), c1.end( ) );
+        SparseMatrix MTildeDBreve = rhat * homogenizedMassMatrix + freeMicromorphicMassMatrix;
+        //Note: kinetic partitioning coefficient applied when the matrix was formed
     
-                for ( auto microVolume  = microDomainVolumes->second.begin( );
-                           microVolume != microDomainVolumes->second.end( );
-                           microVolume++ ){
+        SparseMatrix MD    = MTildeDBreve.block( 0, 0, nMacroDispDOF * nFreeMacroNodes, nMacroDispDOF * nFreeMacroNodes );
+        SparseMatrix MDhat = MTildeDBreve.block( nMacroDispDOF * nFreeMacroNodes, nMacroDispDOF * nFreeMacroNodes,
+                                                 nMacroDispDOF * nGhostMacroNodes, nMacroDispDOF * nGhostMacroNodes );
+
+#ifdef TESTACCESS
+       
+        _test_MQ = MQ;
+        _test_MQhat = MQhat;
+
+#endif
+        //Due to the restrictions in listed in the comment at the beginning of the function, MBar from Regueiro 2012
+        //is an empty matrix as we only handle the coupling domain here.
+       
     
-                    microDomainVolume += microVolume->second;
+        //Assemble Mass matrices for the micro projection equation
+
+        if ( ( config[ "projection_type" ].as< std::string >( ).compare( "l2_projection" ) == 0 ) ){
+
+            //The sparse L2 projectors are truncated when they are formed
+            if ( !_useSparseL2Projectors ){
+
+                //Determine the coefficients where we cut off the projectors
+                floatType tolerance = config[ "l2_projector" ][ "truncation_tolerance" ].as< floatType >( );
+                floatType BQhatQ_coeff = tolerance * ( std::fabs( _dense_BQhatQ.minCoeff( ) ) + std::fabs( _dense_BQhatQ.maxCoeff( ) ) );
+                floatType BQhatD_coeff = tolerance * ( std::fabs( _dense_BQhatD.minCoeff( ) ) + std::fabs( _dense_BQhatD.maxCoeff( ) ) );
+                floatType BDhatQ_coeff = tolerance * ( std::fabs( _dense_BDhatQ.minCoeff( ) ) + std::fabs( _dense_BDhatQ.maxCoeff( ) ) );
+                floatType BDhatD_coeff = tolerance * ( std::fabs( _dense_BDhatD.minCoeff( ) ) + std::fabs( _dense_BDhatD.maxCoeff( ) ) );
+
+                _sparse_BQhatQ = _dense_BQhatQ.sparseView( 1, BQhatQ_coeff );
+                _sparse_BQhatD = _dense_BQhatD.sparseView( 1, BQhatD_coeff );
+                _sparse_BDhatQ = _dense_BDhatQ.sparseView( 1, BDhatQ_coeff );
+                _sparse_BDhatD = _dense_BDhatD.sparseView( 1, BDhatD_coeff );
+
+            }
+
+            //TODO: Improve efficiency
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  ASSEMBLING MQQ\n";
+//            std::cout << "coeffs:\n" << BQhatQ_coeff << " " << BQhatD_coeff << " " << BDhatQ_coeff << " " << BDhatD_coeff << "\n";
+//
+//            std::cout << "Zero ratios\n";
+//            std::cerr << ( ( floatType )_sparse_BQhatQ.nonZeros( ) ) / ( ( floatType )_sparse_BQhatQ.size( ) ) << "\n";
+//            std::cerr << ( ( floatType )_sparse_BQhatD.nonZeros( ) ) / ( ( floatType )_sparse_BQhatD.size( ) ) << "\n";
+//            std::cerr << ( ( floatType )_sparse_BDhatQ.nonZeros( ) ) / ( ( floatType )_sparse_BDhatQ.size( ) ) << "\n";
+//            std::cerr << ( ( floatType )_sparse_BDhatD.nonZeros( ) ) / ( ( floatType )_sparse_BDhatD.size( ) ) << "\n";
+
+            SparseMatrix MQQ = MQ;
+//            std::cerr << "mul1\n";
+            MQQ += _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatQ;
+//            std::cerr << "mul2\n";
+            MQQ += _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatQ;
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  ASSEMBLING MQD\n";
+            SparseMatrix MQD = _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatD;
+            MQD += _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatD;
     
-                }
+            //Assemble Mass matrices for the macro projection equation
+            
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  ASSEMBLING MDQ\n";
+            SparseMatrix MDQ = _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatQ;//MQhat * _dense_BQhatQ;
+            MDQ += _sparse_BDhatD.transpose( ) * MDhat * _sparse_BDhatQ;
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  ASSEMBLING MDD\n";
+            SparseMatrix MDD = MD;
+            MDD += _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatD;//MQhat * _dense_BQhatD;
+            MDD += _sparse_BDhatD.transpose( ) * MDhat * _sparse_BDhatD;
     
-                //Determine the amount of the macro element which is non-overlapped
-                floatType openMacroVolume;
-                if ( elementVolume < _absoluteTolerance ){
-                    openMacroVolume = 0;
-                }
-                else{
-                    openMacroVolume = std::fmax( elementVolume - microDomainVolume, 0. );
-                }
+            //Assemble the damping matrices for the micro projection equation
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  ASSEMBLING CQQ\n";
+            SparseMatrix CQQ = aQ * MQ;
+            CQQ += aQ * _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatQ;//MQhat * _dense_BQhatQ;
+            CQQ += aD * _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatQ;
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  ASSEMBLING CQD\n";
+            SparseMatrix CQD = aQ * _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatD;//MQhat * _dense_BQhatD;
     
-                //Store the contributions of the open macro volume and element volume to the element's free nodes
-                for ( auto nodeID  = element->global_node_ids.begin( );
-                           nodeID != element->global_node_ids.end( );
-                           nodeID++ ){
+            //Assemble the damping matrices for the macro projection equation
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  ASSEMBLING CDQ\n";
+            SparseMatrix CDQ = aQ * _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatQ;//MQhat * _dense_BQhatQ;
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  ASSEMBLING CDD\n";
+            SparseMatrix CDD = aD * MD;
+            CDD += aQ * _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatD;//MQhat * _dense_BQhatD;
+
+//            //Assemble the full mass matrix
+//            std::cerr << "  ASSEMBLING THE FULL MASS MATRIX\n";
+//            _dense_MASS = Eigen::MatrixXd( MQQ.rows( ) + MDQ.rows( ), MQQ.cols( ) + MQD.cols( ) );
+//            _dense_MASS.topLeftCorner(     MQQ.rows( ), MQQ.cols( ) ) = MQQ;
+//            _dense_MASS.topRightCorner(    MQD.rows( ), MQD.cols( ) ) = MQD;
+//            _dense_MASS.bottomLeftCorner(  MDQ.rows( ), MDQ.cols( ) ) = MDQ;
+//            _dense_MASS.bottomRightCorner( MDD.rows( ), MDD.cols( ) ) = MDD;
+//
+//            //Assemble the full damping matrix
+//            std::cerr << "  ASSEMBLING THE FULL DAMPING MATRIX\n";
+//            _dense_DAMPING = Eigen::MatrixXd( CQQ.rows( ) + CDQ.rows( ), CQQ.cols( ) + CQD.cols( ) );
+//            _dense_DAMPING.topLeftCorner(     CQQ.rows( ), CQQ.cols( ) ) = CQQ;
+//            _dense_DAMPING.topRightCorner(    CQD.rows( ), CQD.cols( ) ) = CQD;
+//            _dense_DAMPING.bottomLeftCorner(  CDQ.rows( ), CDQ.cols( ) ) = CDQ;
+//            _dense_DAMPING.bottomRightCorner( CDD.rows( ), CDD.cols( ) ) = CDD;
+
+#ifdef TESTACCESS
+
+            _test_dense_MQQ = MQQ;
+            _test_dense_MQD = MQD;
+            _test_dense_MDQ = MDQ;
+            _test_dense_MDD = MDD;
+
+            _test_dense_CQQ = CQQ;
+            _test_dense_CQD = CQD;
+            _test_dense_CDQ = CDQ;
+            _test_dense_CDD = CDD;
+
+#endif
+            //The sparse matrices are in column major format so we loop over the columns to assemble the matrix
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  ASSEMBLING FULL MASS AND DAMPING MATRICES\n";
+            _sparse_MASS    = SparseMatrix( MQQ.rows( ) + MDQ.rows( ), MQQ.cols( ) + MQD.cols( ) );
+            _sparse_DAMPING = SparseMatrix( CQQ.rows( ) + CDQ.rows( ), CQQ.cols( ) + CQD.cols( ) );
+
+            _sparse_MASS.reserve( MQQ.nonZeros( ) + MQD.nonZeros( ) + MDQ.nonZeros( ) + MDD.nonZeros( ) );
+            _sparse_DAMPING.reserve( CQQ.nonZeros( ) + CQD.nonZeros( ) + CDQ.nonZeros( ) + CDD.nonZeros( ) );
+            for ( uIntType c = 0; c < MQQ.cols( ); ++c ){
+
+                //Add terms to the mass matrix
+                _sparse_MASS.startVec( c );
+                for ( SparseMatrix::InnerIterator itMQQ( MQQ, c ); itMQQ; ++itMQQ )
+                    _sparse_MASS.insertBack( itMQQ.row( ), c ) = itMQQ.value( );
+                for ( SparseMatrix::InnerIterator itMDQ( MDQ, c ); itMDQ; ++itMDQ )
+                    _sparse_MASS.insertBack( itMDQ.row( ) + MQQ.rows( ), c ) = itMDQ.value( );
+
+                //Add terms to the damping matrix
+                _sparse_DAMPING.startVec( c );
+                for ( SparseMatrix::InnerIterator itCQQ( CQQ, c ); itCQQ; ++itCQQ )
+                    _sparse_DAMPING.insertBack( itCQQ.row( ), c ) = itCQQ.value( );
+                for ( SparseMatrix::InnerIterator itCDQ( CDQ, c ); itCDQ; ++itCDQ )
+                    _sparse_DAMPING.insertBack( itCDQ.row( ) + CQQ.rows( ), c ) = itCDQ.value( );
+
+            }
+
+            for ( uIntType c = 0; c < MDD.cols( ); ++c ){
+
+                //Add terms to the mass matrix
+                _sparse_MASS.startVec( c + MQQ.cols( ) );
+                for ( SparseMatrix::InnerIterator itMQD( MQD, c ); itMQD; ++itMQD )
+                    _sparse_MASS.insertBack( itMQD.row( ), c + MQQ.cols( ) ) = itMQD.value( );
+                for ( SparseMatrix::InnerIterator itMDD( MDD, c ); itMDD; ++itMDD )
+                    _sparse_MASS.insertBack( itMDD.row( ) + MQD.rows( ), c + MDQ.cols( ) ) = itMDD.value( );
+
+                //Add terms to the damping matrix
+                _sparse_DAMPING.startVec( c + CQQ.cols( ) );
+                for ( SparseMatrix::InnerIterator itCQD( CQD, c ); itCQD; ++itCQD )
+                    _sparse_DAMPING.insertBack( itCQD.row( ), c + CQQ.cols( ) ) = itCQD.value( );
+                for ( SparseMatrix::InnerIterator itCDD( CDD, c ); itCDD; ++itCDD )
+                    _sparse_DAMPING.insertBack( itCDD.row( ) + CQD.rows( ), c + CDQ.cols( ) ) = itCDD.value( );
+
+            }
+
+        }
+        else if ( ( config[ "projection_type" ].as< std::string >( ).compare( "direct_projection" ) == 0 ) ||
+                  ( config[ "projection_type" ].as< std::string >( ).compare( "averaged_l2_projection" ) == 0 )
+                ){
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "ASSEMBLING MASS BLOCK MATRICES\n";
+            SparseMatrix MQQ  =  MQ;
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  MQQ\n";
+            MQQ += _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatQ;
+            MQQ += _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatQ;
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  MQD\n";
+            SparseMatrix MQD = _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatD;
+            MQD += _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatD;
+    
+            //Assemble Mass matrices for the macro projection equation
+            
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  MDQ\n";
+            SparseMatrix MDQ = _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatQ;
+            MDQ += _sparse_BDhatD.transpose( ) * MDhat * _sparse_BDhatQ;
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  MDD\n";
+            SparseMatrix MDD = MD;
+            MDD += _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatD;
+            MDD += _sparse_BDhatD.transpose( ) * MDhat * _sparse_BDhatD;
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "ASSEMBLING DAMPING BLOCK MATRICES\n";
+    
+            //Assemble the damping matrices for the micro projection equation
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  CQQ\n";
+            SparseMatrix CQQ = aQ * MQ;
+            CQQ += aQ * _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatQ;
+            CQQ += aD * _sparse_BDhatQ.transpose( ) * MDhat * _sparse_BDhatQ;
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  CQD\n";
+            SparseMatrix CQD = aQ * _sparse_BQhatQ.transpose( ) * MQhat * _sparse_BQhatD;
+    
+            //Assemble the damping matrices for the macro projection equation
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  CDQ\n";
+            SparseMatrix CDQ = aQ * _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatQ;
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  CDD\n";
+            SparseMatrix CDD = aD * MD;
+            CDD += aQ * _sparse_BQhatD.transpose( ) * MQhat * _sparse_BQhatD;
+
+#ifdef TESTACCESS
+
+            _test_dense_MQQ = MQQ;
+            _test_dense_MQD = MQD;
+            _test_dense_MDQ = MDQ;
+            _test_dense_MDD = MDD;
+
+            _test_dense_CQQ = CQQ;
+            _test_dense_CQD = CQD;
+            _test_dense_CDQ = CDQ;
+            _test_dense_CDD = CDD;
+
+#endif
+
+            //Assemble the full mass and damping matrices
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "ASSEMBLING FULL MASS AND DAMPING MATRICES\n";
+            _sparse_MASS    = SparseMatrix( MQQ.rows( ) + MDQ.rows( ), MQQ.cols( ) + MQD.cols( ) );
+            _sparse_DAMPING = SparseMatrix( CQQ.rows( ) + CDQ.rows( ), CQQ.cols( ) + CQD.cols( ) );
+
+            //The sparse matrices are in column major format so we loop over the columns to assemble the matrix
+            _sparse_MASS.reserve( MQQ.nonZeros( ) + MQD.nonZeros( ) + MDQ.nonZeros( ) + MDD.nonZeros( ) );
+            _sparse_DAMPING.reserve( CQQ.nonZeros( ) + CQD.nonZeros( ) + CDQ.nonZeros( ) + CDD.nonZeros( ) );
+            for ( uIntType c = 0; c < MQQ.cols( ); ++c ){
+
+                //Add terms to the mass matrix
+                _sparse_MASS.startVec( c );
+                for ( SparseMatrix::InnerIterator itMQQ( MQQ, c ); itMQQ; ++itMQQ )
+                    _sparse_MASS.insertBack( itMQQ.row( ), c ) = itMQQ.value( );
+                for ( SparseMatrix::InnerIterator itMDQ( MDQ, c ); itMDQ; ++itMDQ )
+                    _sparse_MASS.insertBack( itMDQ.row( ) + MQQ.rows( ), c ) = itMDQ.value( );
+
+                //Add terms to the damping matrix
+                _sparse_DAMPING.startVec( c );
+                for ( SparseMatrix::InnerIterator itCQQ( CQQ, c ); itCQQ; ++itCQQ )
+                    _sparse_DAMPING.insertBack( itCQQ.row( ), c ) = itCQQ.value( );
+                for ( SparseMatrix::InnerIterator itCDQ( CDQ, c ); itCDQ; ++itCDQ )
+                    _sparse_DAMPING.insertBack( itCDQ.row( ) + CQQ.rows( ), c ) = itCDQ.value( );
+
+            }
+
+            for ( uIntType c = 0; c < MDD.cols( ); ++c ){
+
+                //Add terms to the mass matrix
+                _sparse_MASS.startVec( c + MQQ.cols( ) );
+                for ( SparseMatrix::InnerIterator itMQD( MQD, c ); itMQD; ++itMQD )
+                    _sparse_MASS.insertBack( itMQD.row( ), c + MQQ.cols( ) ) = itMQD.value( );
+                for ( SparseMatrix::InnerIterator itMDD( MDD, c ); itMDD; ++itMDD )
+                    _sparse_MASS.insertBack( itMDD.row( ) + MQD.rows( ), c + MDQ.cols( ) ) = itMDD.value( );
+
+                //Add terms to the damping matrix
+                _sparse_DAMPING.startVec( c + CQQ.cols( ) );
+                for ( SparseMatrix::InnerIterator itCQD( CQD, c ); itCQD; ++itCQD )
+                    _sparse_DAMPING.insertBack( itCQD.row( ), c + CQQ.cols( ) ) = itCQD.value( );
+                for ( SparseMatrix::InnerIterator itCDD( CDD, c ); itCDD; ++itCDD )
+                    _sparse_DAMPING.insertBack( itCDD.row( ) + CQD.rows( ), c + CDQ.cols( ) ) = itCDD.value( );
+
+            }
+
+        }
+        else{
+
+            return new errorNode( __func__,
+                                  "The projection type " + config[ "projection_type" ].as< std::string >( ) +
+                                  " is not recognized" );
+
+        }
+
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "MASS AND DAMPING MATRICES ASSEMBLED\n";
+
+        return NULL;
+
+    }
+
+    errorOut overlapCoupling::constructKineticEnergyPartitioningCoefficient( const uIntType &macroCellID,
+                                                                             elib::Element *element,
+                                                                             floatVector &res ){
+        /*!
+         * Construct the kinetic energy partitioning coefficient
+         *
+         * :param const uIntType &uIntType: The macro cell's ID number
+         * :param elib::Element *element: The FEA representation of the macro-scale element
+         * :param floatVector &res: The collection of re values at each element quadrature point
+         */
+
+        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
+
+        std::string strategy = config[ "kinetic_energy_partitioning_coefficient" ][ "type" ].as< std::string >( );
+
+        if ( strategy.compare( "volume_fraction" ) == 0 ){
+
+            //Compute the volume of the element
+            
+            floatType elementVolume = 0;
+            floatMatrix jacobian;
+            
+            for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
+
+                //Get the Jacobian of transformation
+                errorOut error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
+
+                if ( error ){
+ 
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the computation of the local gradient\n" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+                elementVolume += vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
+
+            }
+
+            auto microDomainVolumes = homogenizedVolumes.find( macroCellID );
+            if ( microDomainVolumes == homogenizedVolumes.end( ) ){
+
+                return new errorNode( __func__,
+                                      "The macro cell " + std::to_string( macroCellID ) +
+                                      " is not found in the homogenized volumes map" );
+
+            }
+
+            floatType microDomainVolume = 0;
+
+            for ( auto microVolume  = microDomainVolumes->second.begin( );
+                       microVolume != microDomainVolumes->second.end( );
+                       microVolume++ ){
+
+                microDomainVolume += microVolume->second;
+
+            }
+
+            if ( elementVolume < _absoluteTolerance ){
+
+                res = floatVector( element->qrule.size( ), 0 );
+
+            }
+            else{
+
+                res = floatVector( element->qrule.size( ), std::fmax( ( elementVolume - microDomainVolume ) / elementVolume, 0 ) );
+
+            }
+
+        }
+        else{
+
+            return new errorNode( __func__, "Configuration strategy " + strategy + " not recognized" );
+
+        }
+
+        return NULL;
+
+    }
+
+    errorOut overlapCoupling::assembleCouplingForceVector( ){
+        /*!
+         * Assemble the force vector. In Regueiro 2012, the external forces are on the right hand side
+         * and the internal forces are on the left. I will call the, "force vector," the external forces
+         * minus the internal forces. This is distinct from the LHS vector which will include the inertial
+         * and damping forces from the previous increment.
+         *
+         * I also note that, unless we re-compute the micromorphic internal forces, it is not clear how
+         * to get the element-wise contributions for the assembly of the vector. Consequently, we will do
+         * an approximate scheme to handle the potential energy weighting factor.
+         *
+         * Note: If the signs in either the macro ( or micro ) scales are flipped, this can be accounted
+         * for by using the keywords in the coupling initialization section of the configuration file. The
+         * value in "( )" is the default value.
+         *
+         *     macro_internal_force_sign: ( -1 )
+         *     macro_external_force_sign: ( 1 )
+         *     micro_internal_force_sign: ( 1 )
+         *     micro_external_force_sign: ( 1 )
+         */
+
+        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
+        floatType qhat = config[ "potential_energy_weighting_factor" ].as< floatType >( );
+        std::string projection_type = config[ "projection_type" ].as< std::string >( );
+
+        const uIntType nMacroNodeForces = _dim + _dim * _dim;
+
+        //Get the maps from the global to the local degrees of freedom
+        const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
+        const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+
+        //Get the free and ghost node ids
+        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
+        const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
+
+        const uIntVector *freeMicroNodeIds = _inputProcessor.getFreeMicroNodeIds( );
+        const uIntVector *ghostMicroNodeIds = _inputProcessor.getGhostMicroNodeIds( );
+
+        const uIntType nFreeMicroNodes = freeMicroNodeIds->size( );
+        const uIntType nFreeMacroNodes = freeMacroNodeIds->size( );
+
+        //Get the fields which store the internal and external forces
+        const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+        const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
+
+        errorOut error = NULL;
+        uIntType stride;
+
+        //Assemble the micro internal and external forces
+        floatVector FintQhat( _dim * ghostMicroNodeIds->size( ), 0 );
+        floatVector FextQhat( _dim * ghostMicroNodeIds->size( ), 0 );
+        for ( auto microID  = ghostMicroNodeIds->begin( );
+                   microID != ghostMicroNodeIds->end( );
+                   microID++ ){
+
+            //Get the local ID
+            auto idMap = microGlobalToLocalDOFMap->find( *microID );
+
+            if ( idMap == microGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "ghost micro node " + std::to_string( *microID ) +
+                                      " is not found in the local to global DOF map" );
+
+            }
+
+            if ( idMap->second < nFreeMicroNodes ){
+
+                return new errorNode( __func__, "The local index is smaller than the number of free micro nodes" );
+
+            }
+
+            if ( ( _dim * ( idMap->second - nFreeMicroNodes ) + _dim ) > FintQhat.size( ) ){
+
+                return new errorNode( __func__, "Local index is larger than the force vector" );
+
+            }
+
+            const floatType *internalForce = NULL, *externalForce = NULL;
+
+            if ( _inputProcessor.microInternalForceDefined( ) ){
+
+                error = microNodeFields->getNodeValues( "internal_force", *microID, internalForce, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( *microID ) +
+                                                               " not found in internal force vector" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+            }
+
+            if ( _inputProcessor.microExternalForceDefined( ) ){
+
+                error = microNodeFields->getNodeValues( "external_force", *microID, externalForce, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( *microID ) +
+                                                               " not found in external force vector" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+            }
+
+
+            for ( unsigned int i = 0; i < _dim; i++ ){
+
+                if ( _inputProcessor.microInternalForceDefined( ) ){
+
+                    FintQhat[ _dim * ( idMap->second - nFreeMicroNodes ) + i ] = ( 1 - qhat ) * internalForce[ i ];
+
+                }
+
+                if ( _inputProcessor.microExternalForceDefined( ) ){
+
+                    FextQhat[ _dim * ( idMap->second - nFreeMicroNodes ) + i ] = ( 1 - qhat ) * externalForce[ i ];
+
+                }
+
+            }
+
+        }
+
+        floatVector FintQ( _dim * freeMicroNodeIds->size( ), 0 );
+        floatVector FextQ( _dim * freeMicroNodeIds->size( ), 0 );
+        for ( auto microID  = freeMicroNodeIds->begin( );
+                   microID != freeMicroNodeIds->end( );
+                   microID++ ){
+
+            //Get the local ID
+            auto idMap = microGlobalToLocalDOFMap->find( *microID );
+
+            if ( idMap == microGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "free micro node " + std::to_string( *microID ) +
+                                      " is not found in the local to global DOF map" );
+
+            }
+
+            const floatType *internalForce = NULL, *externalForce = NULL;
+
+            if ( _inputProcessor.microInternalForceDefined( ) ){
+
+                error = microNodeFields->getNodeValues( "internal_force", *microID, internalForce, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( *microID ) +
+                                                               " not found in internal force vector" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+            }
+
+            if ( _inputProcessor.microExternalForceDefined( ) ){
+
+                error = microNodeFields->getNodeValues( "external_force", *microID, externalForce, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Micro node " + std::to_string( *microID ) +
+                                                               " not found in external force vector" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+            }
+
+            for ( unsigned int i = 0; i < _dim; i++ ){
+
+                if ( _inputProcessor.microInternalForceDefined( ) ){
+
+                    FintQ[ _dim * idMap->second + i ] = ( 1 - qhat ) * internalForce[ i ];
+
+                }
+
+                if ( _inputProcessor.microExternalForceDefined( ) ){
+
+                    FextQ[ _dim * idMap->second + i ] = ( 1 - qhat ) * externalForce[ i ];
+
+                }
+
+            }
+
+        }
+
+        //Compute the potential energy partitioning coefficients
+        std::unordered_map< uIntType, floatType > qes;
+        error = constructPotentialEnergyPartitioningCoefficient( qes );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__,
+                                             "Error in the construction of the potential energy partitioning coefficients" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        //Assemble the macro internal and external forces
+        floatVector FintDhat( nMacroNodeForces * ghostMacroNodeIds->size( ), 0 );
+        floatVector FextDhat( nMacroNodeForces * ghostMacroNodeIds->size( ), 0 );
+        for ( auto nodeID = ghostMacroNodeIds->begin( ); nodeID != ghostMacroNodeIds->end( ); nodeID++ ){
+
+            //Get the local ID
+            auto idMap = macroGlobalToLocalDOFMap->find( *nodeID );
+
+            if ( idMap == macroGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "ghost macro node " + std::to_string( *nodeID ) +
+                                      " is not found in the local to global DOF map" );
+
+            }
+
+            auto nodeQes = qes.find( *nodeID );
+
+            if ( idMap->second < nFreeMacroNodes ){
+
+                return new errorNode( __func__,
+                                      "ghost macro node " + std::to_string( *nodeID ) +
+                                      " has a local position not consistent with the number of free macro nodes" );
+
+            }
+
+            if ( ( nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + nMacroNodeForces ) > FintDhat.size( ) ){
+
+                return new errorNode( __func__,
+                                      "ghost macro node " + std::to_string( *nodeID ) +
+                                      " has a local position larger than allocated in the coupling force vector" );
+
+            }
+
+            const floatType *internalForce = NULL, *externalForce = NULL;
+
+            if ( _inputProcessor.macroInternalForceDefined( ) ){
+
+                error = macroNodeFields->getNodeValues( "internal_force", *nodeID, internalForce, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Macro node " + std::to_string( *nodeID ) +
+                                                                 " not found in internal force vector" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+            }
+
+            if ( _inputProcessor.macroExternalForceDefined( ) ){
+
+                error = macroNodeFields->getNodeValues( "external_force", *nodeID, externalForce, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Macro node " + std::to_string( *nodeID ) +
+                                                                 " not found in external force vector" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+            }
+
+            for ( unsigned int i = 0; i < nMacroNodeForces; i++ ){
+
+                FintDhat[ nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + i ]
+                    = qhat * homogenizedFINT( nMacroNodeForces * idMap->second + i );
+                FextDhat[ nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + i ]
+                    = qhat * homogenizedFEXT( nMacroNodeForces * idMap->second + i );
+
+                if ( nodeQes != qes.end( ) ){
+
+                    if ( _inputProcessor.macroInternalForceDefined( ) ){
+
+                        FintDhat[ nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + i ]
+                            += nodeQes->second * internalForce[ i ];
+
+                    }
+
+                    if ( _inputProcessor.macroExternalForceDefined( ) ){
+
+                        FintDhat[ nMacroNodeForces * ( idMap->second - nFreeMacroNodes ) + i ]
+                            += nodeQes->second * externalForce[ i ];
+
+                    }
+
+                }
+
+            }
+
+        }
+
+        floatVector FintD( nMacroNodeForces * freeMacroNodeIds->size( ), 0 );
+        floatVector FextD( nMacroNodeForces * freeMacroNodeIds->size( ), 0 );
+        for ( auto nodeID = freeMacroNodeIds->begin( ); nodeID != freeMacroNodeIds->end( ); nodeID++ ){
+
+            //Get the local ID
+            auto idMap = macroGlobalToLocalDOFMap->find( *nodeID );
+
+            if ( idMap == macroGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "free macro node " + std::to_string( *nodeID ) +
+                                      " is not found in the local to global DOF map" );
+
+            }
+
+            auto nodeQes = qes.find( *nodeID );
+
+            const floatType *internalForce = NULL, *externalForce = NULL;
+
+            if ( _inputProcessor.macroInternalForceDefined( ) ){
+
+                error = macroNodeFields->getNodeValues( "internal_force", *nodeID, internalForce, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Macro node " + std::to_string( *nodeID ) +
+                                                                 " not found in internal force vector" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+            }
+
+            if ( _inputProcessor.macroExternalForceDefined( ) ){
+
+                error = macroNodeFields->getNodeValues( "external_force", *nodeID, externalForce, stride );
+
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__, "Macro node " + std::to_string( *nodeID ) +
+                                                                 " not found in external force vector" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+            }
+
+            for ( unsigned int i = 0; i < nMacroNodeForces; i++ ){
+
+                FintD[ nMacroNodeForces * idMap->second + i ]
+                    = qhat * homogenizedFINT( nMacroNodeForces * idMap->second + i );
+                FextD[ nMacroNodeForces * idMap->second + i ]
+                    = qhat * homogenizedFEXT( nMacroNodeForces * idMap->second + i );
+
+                if ( nodeQes != qes.end( ) ){
+
+                    if ( _inputProcessor.macroInternalForceDefined( ) ){
+
+                        FintD[ nMacroNodeForces * idMap->second + i ]
+                            += nodeQes->second * internalForce[ i ];
+
+                    }
+
+                    if ( _inputProcessor.macroExternalForceDefined( ) ){
+
+                        FextD[ nMacroNodeForces * idMap->second + i ]
+                            += nodeQes->second * externalForce[ i ];
+
+                    }
+
+                }
+
+            }
+
+        }
+
+        //Map the forces to Eigen Vectors to allow for easy computation
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FintQ( FintQ.data(), FintQ.size( ), 1 );
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FextQ( FextQ.data(), FextQ.size( ), 1 );
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FintD( FintD.data(), FintD.size( ), 1 );
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FextD( FextD.data(), FextD.size( ), 1 );
+
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FintQhat( FintQhat.data(), FintQhat.size( ), 1 );
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FextQhat( FextQhat.data(), FextQhat.size( ), 1 );
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FintDhat( FintDhat.data(), FintDhat.size( ), 1 );
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _FextDhat( FextDhat.data(), FextDhat.size( ), 1 );
+
+        //Initialize the force vectors
+        Eigen::MatrixXd _FQ, _FD;
+
+#ifdef TESTACCESS
+
+        _test_FintQ = _FintQ;
+        _test_FextQ = _FextQ;
+
+        _test_FintD = _FintD;
+        _test_FextD = _FextD;
+
+        _test_FintQhat = _FintQhat;
+        _test_FextQhat = _FextQhat;
+
+        _test_FintDhat = _FintDhat;
+        _test_FextDhat = _FextDhat;
+
+#endif
+
+        if ( ( projection_type.compare( "l2_projection" ) == 0 ) && _implicitL2Projectors ){
+
+            //Apply the transposes of the projectors implicitly
+            Eigen::MatrixXd FextQhatQ, FextQhatD, FextDhatQ, FextDhatD, FintHatQ, FintHatD;
+
+            error = applyL2ProjectorTransposesImplicitly( _FextQhat, Eigen::MatrixXd::Zero( _FextDhat.rows( ), 1 ),
+                                                          FextQhatQ, FextQhatD );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the projection of the ghost micro external force" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            error = applyL2ProjectorTransposesImplicitly( Eigen::MatrixXd::Zero( _FextQhat.rows( ), 1 ), _FextDhat,
+                                                          FextDhatQ, FextDhatD );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the projection of the ghost macro external force" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            error = applyL2ProjectorTransposesImplicitly( _FintQhat, _FintDhat, FintHatQ, FintHatD );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the projection of the ghost internal forces" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            //Assemble the micro force vector
+            _FQ  = _FextQ;
+            _FQ += FextQhatQ;
+            _FQ -= _FintQ;
+            _FQ -= FintHatQ;
+
+            //Assemble the macro force vector
+            _FD  = _FextD;
+            _FD += FextDhatD;
+            _FD -= _FintD;
+            _FD -= FintHatD;
+
+        }
+        else if ( ( projection_type.compare( "l2_projection" ) == 0 ) && !_useSparseL2Projectors ){
+            //Assemble the micro force vector
+            _FQ  = _FextQ;
+            _FQ += _dense_BQhatQ.transpose( ) * _FextQhat;
+            _FQ -= _FintQ;
+            _FQ -= _dense_BQhatQ.transpose( ) * _FintQhat;
+            _FQ -= _dense_BDhatQ.transpose( ) * _FintDhat;
+    
+            //Assemble the macro force vector
+            _FD  = _FextD;
+            _FD += _dense_BDhatD.transpose( ) * _FextDhat;
+            _FD -= _FintD;
+            _FD -= _dense_BQhatD.transpose( ) * _FintQhat;
+            _FD -= _dense_BDhatD.transpose( ) * _FintDhat;
+
+        }
+        else if ( ( projection_type.compare( "direct_projection" ) == 0 ) ||
+                  ( projection_type.compare( "averaged_l2_projection" ) == 0 ) ||
+                  ( projection_type.compare( "l2_projection" ) == 0 ) ){
+
+            //Assemble the micro force vector
+            _FQ  = _FextQ;
+            _FQ += _sparse_BQhatQ.transpose( ) * _FextQhat;
+            _FQ -= _FintQ;
+            _FQ -= _sparse_BQhatQ.transpose( ) * _FintQhat;
+            _FQ -= _sparse_BDhatQ.transpose( ) * _FintDhat;
+    
+            //Assemble the macro force vector
+            _FD  = _FextD;
+            _FD += _sparse_BDhatD.transpose( ) * _FextDhat;
+            _FD -= _FintD;
+            _FD -= _sparse_BQhatD.transpose( ) * _FintQhat;
+            _FD -= _sparse_BDhatD.transpose( ) * _FintDhat;
+
+        }
+        else{
+
+            return new errorNode( __func__,
+                                  "The projection type: " + projection_type + " is not recognized" );
+
+        }
+
+        //Assemble the full force vector
+        _FORCE = Eigen::MatrixXd( _FQ.rows( ) + _FD.rows( ), 1 );
+        _FORCE << _FQ, _FD;
+
+//        std::cout << "FintQ:\n";
+//        for ( unsigned int i = 0; i < FintQ.size( ); i++ ){
+//            std::cout << _FintQ( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+//        std::cout << "FintD:\n";
+//        for ( unsigned int i = 0; i < FintD.size( ); i++ ){
+//            std::cout << _FintD( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+
+//        std::cout << "FextQ:\n";
+//        for ( unsigned int i = 0; i < FextQ.size( ); i++ ){
+//            std::cout << _FextQ( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+//        std::cout << "FextD:\n";
+//        for ( unsigned int i = 0; i < FextD.size( ); i++ ){
+//            std::cout << _FextD( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+
+//        std::cout << "FextQhat:\n";
+//        for ( unsigned int i = 0; i < FextQhat.size( ); i++ ){
+//            std::cout << _FextQhat( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+//        std::cout << "FextDhat:\n";
+//        for ( unsigned int i = 0; i < FextDhat.size( ); i++ ){
+//            std::cout << _FextDhat( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+
+//        std::cout << "FintQhat:\n";
+//        for ( unsigned int i = 0; i < FintQhat.size( ); i++ ){
+//            std::cout << _FintQhat( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+//        std::cout << "FintDhat:\n";
+//        for ( unsigned int i = 0; i < FintDhat.size( ); i++ ){
+//            std::cout << _FintDhat( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+
+//        std::cout << "FQ:\n";
+//        for ( unsigned int i = 0; i < _FQ.size( ); i++ ){
+//            std::cout << _FQ( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+//        std::cout << "FD:\n";
+//        for ( unsigned int i = 0; i < _FD.size( ); i++ ){
+//            std::cout << _FD( i, 0 ) << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
+//
+//        floatVector tmpVec( 3, 0 );
+//        for ( unsigned int i = 0; i < _FQ.size( ); i++ ){
+//            tmpVec[ ( i + 1 ) % 3 ] += fabs( _FQ( i, 0 ) );
+//        }
+//        std::cout << "Sum of FQ: "; vectorTools::print( tmpVec );
+//
+//        tmpVec = floatVector( 12, 0 );
+//        for ( unsigned int i = 0; i < _FD.size( ); i++ ){
+//            tmpVec[ ( i + 1 ) % 12 ] += fabs( _FD( i, 0 ) );
+//        }
+//        std::cout << "Sum of FD: "; vectorTools::print( tmpVec );
+//
+//        return new errorNode( __func__, "derp" );
+//
+//        std::cout << "FextQ NORM:    " << _FextQ.norm( ) << "\n";
+//        std::cout << "FextD NORM:    " << _FextD.norm( ) << "\n";
+//        std::cout << "FextQhat NORM: " << _FextQhat.norm( ) << "\n";
+//        std::cout << "FextDhat NORM: " << _FextDhat.norm( ) << "\n";
+//        std::cout << "FintQ NORM:    " << _FintQ.norm( ) << "\n";
+//        std::cout << "FintD NORM:    " << _FintD.norm( ) << "\n";
+//        std::cout << "FintQhat NORM: " << _FintQhat.norm( ) << "\n";
+//        std::cout << "FintDhat NORM: " << _FintDhat.norm( ) << "\n";
+//        std::cout << "FQ NORM:       " << _FQ.norm( ) << "\n";
+//        std::cout << "FD NORM:       " << _FD.norm( ) << "\n";
+//        std::cout << "FORCE NORM:    " << _FORCE.norm( ) << "\n";
+
+        return NULL;
+    }
+
+    errorOut overlapCoupling::constructPotentialEnergyPartitioningCoefficient( std::unordered_map< uIntType, floatType > &qes ){
+        /*!
+         * Construct the potential energy partitioning coefficient ( qe in Regueiro 2012 )
+         *
+         * Currently only volume_fraction is implemented
+         *
+         * :param std::unordered_map< uIntType, floatType > &qes: The potential energy partitioning coefficents
+         *     at the free nodes in the free macro cells.
+         */
+
+        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
+        std::string strategy = config[ "potential_energy_partitioning_coefficient" ][ "type" ].as< std::string >( );
+
+        if ( strategy.compare( "volume_fraction" ) == 0 ){
+
+            const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
+            const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
+            const uIntVector *freeMacroCellIds = _inputProcessor.getFreeMacroCellIds( );
+    
+            //Compute the volumes of the overlaped macro domains
+            std::unordered_map< uIntType, floatType > macroCellNodeTotalVolumes;
+            macroCellNodeTotalVolumes.reserve( freeMacroNodeIds->size( ) + ghostMacroNodeIds->size( ) );
+    
+            qes.reserve( freeMacroNodeIds->size( ) );
+    
+            for ( auto macroCellID  = freeMacroCellIds->begin( );
+                       macroCellID != freeMacroCellIds->end( );
+                       macroCellID++ ){
+    
+                //Construct the macro-domain element
+                elib::Element *element;
+                errorOut error = getMacroDomainElement( *macroCellID,
+                                                        *_inputProcessor.getMacroNodeReferencePositions( ),
+                                                        *_inputProcessor.getMacroDisplacements( ),
+                                                        *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                                        element );
+    
+                if ( error ){
+    
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the construction of the macro element " + std::to_string( *macroCellID ) );
+                    result->addNext( error );
+                    return result;
+    
+                }
+    
+                //Compute the volume of the macro element
+                floatType elementVolume = 0;
+                floatMatrix jacobian;
+                
+                for ( auto qpt = element->qrule.begin( ); qpt != element->qrule.end( ); qpt++ ){
+    
+                    //Get the Jacobian of transformation
+                    errorOut error = element->get_local_gradient( element->nodes, qpt->first, jacobian );
+    
+                    if ( error ){
+     
+                        errorOut result = new errorNode( __func__,
+                                                         "Error in the computation of the local gradient\n" );
+                        result->addNext( error );
+                        return result;
+    
+                    }
+    
+                    elementVolume += vectorTools::determinant( vectorTools::appendVectors( jacobian ), _dim, _dim ) * qpt->second;
+    
+                }
+    
+                //Compute the volumes of the overlapped micro domains for the macro cell
+                auto microDomainVolumes = homogenizedVolumes.find( *macroCellID );
+                if ( microDomainVolumes == homogenizedVolumes.end( ) ){
+    
+                    return new errorNode( __func__,
+                                          "The macro cell " + std::to_string( *macroCellID ) +
+                                          " is not found in the homogenized volumes map" );
+    
+                }
+    
+                floatType microDomainVolume = 0;
+    
+                for ( auto microVolume  = microDomainVolumes->second.begin( );
+                           microVolume != microDomainVolumes->second.end( );
+                           microVolume++ ){
+    
+                    microDomainVolume += microVolume->second;
+    
+                }
+    
+                //Determine the amount of the macro element which is non-overlapped
+                floatType openMacroVolume;
+                if ( elementVolume < _absoluteTolerance ){
+                    openMacroVolume = 0;
+                }
+                else{
+                    openMacroVolume = std::fmax( elementVolume - microDomainVolume, 0. );
+                }
+    
+                //Store the contributions of the open macro volume and element volume to the element's free nodes
+                for ( auto nodeID  = element->global_node_ids.begin( );
+                           nodeID != element->global_node_ids.end( );
+                           nodeID++ ){
+    
+                    //Store the contribution to the nodes
+                    if ( qes.find( *nodeID ) != qes.end( ) ){
+    
+                        qes[ *nodeID ] += openMacroVolume;
+                        macroCellNodeTotalVolumes[ *nodeID ] += elementVolume;
+    
+                    }
+                    else{
+
+                        qes.emplace( *nodeID, openMacroVolume );
+                        macroCellNodeTotalVolumes[ *nodeID ] += elementVolume;
+
+                    }
+    
+                }
+    
+            }
+    
+            for ( auto nodeID  = macroCellNodeTotalVolumes.begin( );
+                       nodeID != macroCellNodeTotalVolumes.end( );
+                       nodeID++ ){
+    
+                qes[ nodeID->first ] /= nodeID->second;
+    
+            }
+
+        }
+        else{
+
+            return new errorNode( __func__,
+                                  "The potential energy partitioning strategy: " + strategy + " is not recognized." );
+
+        }
+
+        return NULL;
+    }
+
+    errorOut overlapCoupling::solveFreeDisplacement( const bool updateGhostDOF ){
+        /*!
+         * Solve for the free displacement. This is done using the Newmark-Beta method ( from Wikipedia ):
+         *
+         * u_{ n + 1 } = u_n + \Delta t * \dot{ u }_n + \frac{ \Delta t^2 }{ 2 }\left( \left( 1 - 2 \beta \right) \ddot{ u }_n + 2 \beta \ddot{ u }_{n+1 } \right)
+         * \dot{ u }_{ n + 1 } = \dot{ u }_n + ( 1 - \gamma ) \Delta t \ddot{ u }_n + \gamma \Delta t \ddot{ u }_{n + 1}
+         * M \ddot{ u }_{n + 1} + C \dot{ u }_{n + 1} + f^{int}\left( u_{n + 1} \right) = f^{ext}_{n+1}
+         *
+         * Where the Explicit central difference scheme is obtained by letting $\gamma = 0.5$ and $\beta = 0$
+         *
+         * and
+         *
+         * Average constant acceleration is obtained by setting $\gamma = 0.5$ and $\beta = 0.25$
+         *
+         * NOTE: The current implementation cannot do implicit solves here but it does solve for what the
+         * displacement values *should* be given the current values of the force vectors and those can be
+         * used to construct residual equations. It is hoped that Jacobian Free Newton Krylov will be 
+         * capable of solving the coupled PDEs without having to explicitly form the Jacobian.
+         *
+         * :param const bool updateGhostDOF: A flag for whether the ghost degrees of freedom should be updated as well
+         */
+
+        //Set the configuration
+        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
+
+        std::string projection_type = config[ "projection_type" ].as< std::string >( );
+        const floatType gamma = *_inputProcessor.getNewmarkGamma( );
+        const floatType beta = *_inputProcessor.getNewmarkBeta( );
+
+        //Get the timestep
+        const floatType *dt = _inputProcessor.getDt( );
+
+        //Set the number of displacement degrees of freedom for each scale
+        const uIntType nMicroDispDOF = _dim;
+        const uIntType nMacroDispDOF = _dim + _dim * _dim;
+
+        //Get the maps from the global to the local degrees of freedom
+        const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
+        const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+
+        //Get the free degree of freedom values at both scale
+        const uIntVector *freeMicroNodeIds = _inputProcessor.getFreeMicroNodeIds( );
+        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
+
+        const uIntType microOffset = nMicroDispDOF * freeMicroNodeIds->size( );
+
+        //Get the fields which store the previous values of the degrees of freedom and their velocities and accelerations
+        const inputFileProcessor::nodeFieldContainer *microNodeFields = _inputProcessor.getMicroNodeFields( );
+        const inputFileProcessor::nodeFieldContainer *macroNodeFields = _inputProcessor.getMacroNodeFields( );
+
+        const std::string previousDisplacementName = _inputProcessor.getPreviousFieldName( "displacement" );
+        const std::string previousDispDOFName      = _inputProcessor.getPreviousFieldName( "displacement_dof" );
+        const std::string previousVelocityName     = _inputProcessor.getPreviousFieldName( "velocity" );
+        const std::string previousAccelerationName = _inputProcessor.getPreviousFieldName( "acceleration" );
+
+        errorOut error = NULL;
+        uIntType stride;
+
+        //Set the degree of freedom vectors
+        //To try and save some memory, we will overwrite DOF and DotDOF as the integrated values become available
+        floatVector       FreeDOF( nMicroDispDOF * freeMicroNodeIds->size( ) + nMacroDispDOF * freeMacroNodeIds->size( ), 0 );
+        floatVector        DotDOF( nMicroDispDOF * freeMicroNodeIds->size( ) + nMacroDispDOF * freeMacroNodeIds->size( ), 0 );
+        floatVector   DotDotDOF_t( nMicroDispDOF * freeMicroNodeIds->size( ) + nMacroDispDOF * freeMacroNodeIds->size( ), 0 );
+        floatVector DotDotDOF_tp1( nMicroDispDOF * freeMicroNodeIds->size( ) + nMacroDispDOF * freeMacroNodeIds->size( ), 0 );
+
+        //Extract the micro points
+        for ( auto nodeId = freeMicroNodeIds->begin( ); nodeId != freeMicroNodeIds->end( ); nodeId++ ){
+
+            //Find the map from global to local node ids
+            auto indexMap = microGlobalToLocalDOFMap->find( *nodeId );
+
+            if ( indexMap == microGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "Micro node " + std::to_string( *nodeId ) + " not found in global to local map" );
+
+            }
+
+            const floatType *previousMicroDisp, *previousMicroVel, *previousMicroAccel;
+
+            error = microNodeFields->getNodeValues( previousDisplacementName, *nodeId, previousMicroDisp, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "The micro node " + std::to_string( *nodeId ) +
+                                                 " is not found in the previous micro displacement dof vector" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            error = microNodeFields->getNodeValues( previousVelocityName, *nodeId, previousMicroVel, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "The micro node " + std::to_string( *nodeId ) +
+                                                 " is not found in the previous micro velocities vector" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            error = microNodeFields->getNodeValues( previousAccelerationName, *nodeId, previousMicroAccel, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "The micro node " + std::to_string( *nodeId ) +
+                                                 " is not found in the previous micro accelerations vector" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            //Extract the micro points
+            for ( unsigned int i = 0; i < nMicroDispDOF; i++ ){
+
+                FreeDOF[ nMicroDispDOF * indexMap->second + i ] = previousMicroDisp[ i ];
+
+                if ( _inputProcessor.microVelocitiesDefined( ) ){
+
+                    DotDOF[ nMicroDispDOF * indexMap->second + i ] = previousMicroVel[ i ];
+
+                }
+
+                if ( _inputProcessor.microAccelerationDefined( ) ){
+
+                    DotDotDOF_t[ nMicroDispDOF * indexMap->second + i ] = previousMicroAccel[ i ];
+
+                }
+
+            }
+
+        }
+
+        //Extract macro points
+        for ( auto nodeId = freeMacroNodeIds->begin( ); nodeId != freeMacroNodeIds->end( ); nodeId++ ){
+
+            //Find the map from global to local node ids
+            auto indexMap = macroGlobalToLocalDOFMap->find( *nodeId );
+
+            if ( indexMap == macroGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "Macro node " + std::to_string( *nodeId ) + " not found in global to local map" );
+
+            }
+
+            const floatType *previousMacroDisp, *previousMacroVel, *previousMacroAccel;
+
+            error = macroNodeFields->getNodeValues( previousDispDOFName, *nodeId, previousMacroDisp, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "The macro node " + std::to_string( *nodeId ) +
+                                                 " is not found in the previous macro displacement dof vector" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            error = macroNodeFields->getNodeValues( previousVelocityName, *nodeId, previousMacroVel, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "The macro node " + std::to_string( *nodeId ) +
+                                                 " is not found in the previous macro velocities vector" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            error = macroNodeFields->getNodeValues( previousAccelerationName, *nodeId, previousMacroAccel, stride );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "The macro node " + std::to_string( *nodeId ) +
+                                                 " is not found in the previous macro accelerations vector" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            //Extract the macro points
+            for ( unsigned int i = 0; i < nMacroDispDOF; i++ ){
+
+                FreeDOF[ nMacroDispDOF * indexMap->second + i + microOffset ] = previousMacroDisp[ i ];
+
+                if ( _inputProcessor.macroVelocitiesDefined( ) ){
+
+                    DotDOF[ nMacroDispDOF * indexMap->second + i + microOffset ] = previousMacroVel[ i ];
+
+                }
+
+                if ( _inputProcessor.macroAccelerationDefined( ) ){
+
+                    DotDotDOF_t[ nMacroDispDOF * indexMap->second + i + microOffset ] = previousMacroAccel[ i ];
+
+                }
+
+            }
+
+        }
+
+        //Map the vectors to Eigen matrices
+        Eigen::Map< Eigen::Matrix< floatType, -1,  1 > > _DOF( FreeDOF.data(), FreeDOF.size( ), 1 );
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _DotDOF( DotDOF.data(), DotDOF.size( ), 1 );
+        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _DotDotDOF_t( DotDotDOF_t.data(), DotDotDOF_t.size( ), 1 );
+        Eigen::Map< Eigen::Matrix< floatType, -1,  1 > > _DotDotDOF_tp1( DotDotDOF_tp1.data(), DotDotDOF_tp1.size( ), 1 );
+
+#ifdef TESTACCESS
+
+        _test_DOF_t = _DOF;
+        _test_DotDOF_t = _DotDOF;
+        _test_DotDotDOF_t = _DotDotDOF_t;
+
+#endif
+
+        //Solve for the accelerations
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "Solving the Free DOF system\n";
+
+        Eigen::MatrixXd RHS;
+        if ( ( projection_type.compare( "l2_projection" ) == 0 ) ){
+
+            SparseMatrix LHS( _sparse_MASS.rows( ), _sparse_MASS.cols( ) );
+            LHS = _sparse_MASS;
+            LHS += gamma * ( *dt ) * _sparse_DAMPING;
+            LHS.makeCompressed( );
+
+            RHS = _FORCE;
+            RHS -= _sparse_DAMPING * ( _DotDOF + ( 1 - gamma ) * ( *dt ) * _DotDotDOF_t );
+
+//            _DotDotDOF_tp1 = LHS.colPivHouseholderQr( ).solve( RHS );
+            errorOut error = factorizeFreeDOFLHS( LHS );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the factorization of the free DOF LHS matrix" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            Eigen::MatrixXd solution;
+            error = solveFreeDOFLHS( RHS, _DotDotDOF_t, solution );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the solution of the free DOF system" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            _DotDotDOF_tp1 = solution;
+        }
+        else if ( ( projection_type.compare( "direct_projection" ) == 0 ) ||
+                  ( projection_type.compare( "averaged_l2_projection" ) == 0 ) ){
+
+            SparseMatrix LHS( _sparse_MASS.rows( ), _sparse_MASS.cols( ) );
+            LHS = _sparse_MASS;
+            LHS += gamma * ( *dt ) * _sparse_DAMPING;
+            LHS.makeCompressed( );
+
+            RHS = _FORCE;
+            RHS -= _sparse_DAMPING * ( _DotDOF + ( 1 - gamma ) * ( *dt ) * _DotDotDOF_t );
+
+            errorOut error = factorizeFreeDOFLHS( LHS );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the factorization of the free DOF LHS matrix" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            Eigen::MatrixXd solution;
+            error = solveFreeDOFLHS( RHS, _DotDotDOF_t, solution );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the solution of the free DOF system" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            _DotDotDOF_tp1 = solution;
+
+//            return new errorNode( __func__, "derp3" );
+//
+//            std::cout << "_DotDof:\n";
+//            std::cout << "microscale\n";
+//            for ( unsigned int i = 0; i < microOffset; i++ ){
+//                std::cout << _DotDOF( i, 0 ) << " ";
+//                if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                    std::cout << "\n";
+//                }
+//            }
+//            std::cout << "macroscale\n";
+//            for ( unsigned int i = microOffset; i < _DotDOF.size( ); i++ ){
+//                std::cout << _DotDOF( i, 0 ) << " ";
+//                if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                    std::cout << "\n";
+//                }
+//            }
+//
+//            return new errorNode( __func__, "derp" );
+//
+//            std::cout << "_DotDotDof_t:\n";
+//            std::cout << "microscale\n";
+//            for ( unsigned int i = 0; i < microOffset; i++ ){
+//                std::cout << _DotDotDOF_t( i, 0 ) << " ";
+//                if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                    std::cout << "\n";
+//                }
+//            }
+//            std::cout << "macroscale\n";
+//            for ( unsigned int i = microOffset; i < _DotDotDOF_t.size( ); i++ ){
+//                std::cout << _DotDotDOF_t( i, 0 ) << " ";
+//                if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                    std::cout << "\n";
+//                }
+//            }
+//
+//            std::cout << "_DotDotDof_tp1:\n";
+//            std::cout << "microscale\n";
+//            for ( unsigned int i = 0; i < microOffset; i++ ){
+//                std::cout << _DotDotDOF_tp1( i, 0 ) << " ";
+//                if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                    std::cout << "\n";
+//                }
+//            }
+//            std::cout << "macroscale\n";
+//            for ( unsigned int i = microOffset; i < _DotDotDOF_tp1.size( ); i++ ){
+//                std::cout << _DotDotDOF_tp1( i, 0 ) << " ";
+//                if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                    std::cout << "\n";
+//                }
+//            }
+//
+//            return new errorNode( __func__, "derp2" );
+
+        }
+        else{
+
+            return new errorNode( __func__, "Projection type " + projection_type + " not recognized" );
+
+        }
+
+        //Update the free degrees of freedom
+        _DOF += ( *dt ) * _DotDOF + 0.5 * ( ( *dt ) * ( *dt ) ) * ( ( 1 - 2 * beta ) * _DotDotDOF_t + 2 * beta * _DotDotDOF_tp1 );
+
+#ifdef TESTACCESS
+
+        _test_DOF_tp1 = _DOF;
+        _test_DotDotDOF_tp1 = _DotDotDOF_tp1;
+
+#endif
+
+        //Store the free degrees of freedom
+        _updatedFreeMicroDispDOFValues = floatVector( FreeDOF.begin( ), FreeDOF.begin( ) + microOffset );
+        _updatedFreeMacroDispDOFValues = floatVector( FreeDOF.begin( ) + microOffset, FreeDOF.end( ) );
+        _freeDOFValuesUpdated = true;
+
+        if ( updateGhostDOF ){
+
+            errorOut error = projectDegreesOfFreedom( updateGhostDOF );
+
+            if ( error ){
+    
+                errorOut result = new errorNode( __func__,
+                                                 "Error in the projection of the ghost degrees of freedom" );
+                result->addNext( error );
+                return result;
+    
+            }            
+
+        }
+
+        return NULL;
+
+    }
+
+    errorOut overlapCoupling::factorizeFreeDOFLHS( const SparseMatrix &LHS ){
+        /*!
+         * Factorize the LHS matrix of the free degree of freedom solve using the solver defined by
+         * 'free_dof_solver' in the coupling initialization. The factorization is cached between calls.
+         * The symbolic analysis is only repeated if the sparsity pattern of the matrix changes and the
+         * numeric factorization is only repeated if the values of the matrix change.
+         *
+         * If 'check_spd' is true and the matrix is found not to be symmetric positive definite the
+         * solve falls back to the QR decomposition. For the direct solvers positive definiteness is
+         * checked by the Cholesky factorization. The conjugate gradient solvers never form a complete
+         * factorization so for them only the symmetry and the positivity of the diagonal are checked.
+         *
+         * :param const SparseMatrix &LHS: The compressed LHS matrix
+         */
+
+        if ( !LHS.isCompressed( ) ){
+
+            return new errorNode( __func__, "The LHS matrix must be compressed" );
+
+        }
+
+        //Compare the sparsity pattern of the matrix to the pattern of the stored matrix
+        bool samePattern = ( LHS.rows( ) == _freeDOFLHS.rows( ) ) && ( LHS.cols( ) == _freeDOFLHS.cols( ) )
+                        && ( LHS.nonZeros( ) == _freeDOFLHS.nonZeros( ) )
+                        && std::equal( LHS.outerIndexPtr( ), LHS.outerIndexPtr( ) + LHS.outerSize( ) + 1, _freeDOFLHS.outerIndexPtr( ) )
+                        && std::equal( LHS.innerIndexPtr( ), LHS.innerIndexPtr( ) + LHS.nonZeros( ), _freeDOFLHS.innerIndexPtr( ) );
+
+        if ( _freeDOFLHSAnalyzedSolvers.empty( ) || !samePattern ){
+
+            _freeDOFLHSAnalyzedSolvers.clear( );
+            _freeDOFLHS = LHS;
+            _freeDOFLHSFactorized = false;
+
+        }
+
+        if ( _freeDOFLHSFactorized
+             && std::equal( LHS.valuePtr( ), LHS.valuePtr( ) + LHS.nonZeros( ), _freeDOFLHS.valuePtr( ) ) ){
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  Re-using the factorization of the Free DOF LHS matrix\n";
+            return NULL;
+
+        }
+
+        _freeDOFLHSFactorized = false;
+
+        //Determine the requested solver
+        const YAML::Node solverConfig = _inputProcessor.getCouplingInitialization( )[ "free_dof_solver" ];
+
+        std::string solverName = solverConfig[ "type" ].as< std::string >( );
+
+        if ( solverName.compare( "cg" ) == 0 ){
+
+            solverName += "_" + solverConfig[ "preconditioner" ].as< std::string >( );
+
+        }
+
+        auto requestedSolver = freeDOFSolvers.find( solverName );
+
+        if ( requestedSolver == freeDOFSolvers.end( ) ){
+
+            return new errorNode( __func__, "The free DOF solver " + solverName + " is not recognized" );
+
+        }
+
+        _freeDOFLHSActiveSolver = requestedSolver->second;
+
+        bool checkSPD = solverConfig[ "check_spd" ].as< bool >( );
+
+        //Check the symmetry of the matrix
+        if ( checkSPD && ( _freeDOFLHSActiveSolver != SPARSE_QR ) ){
+
+            SparseMatrix asymmetry = SparseMatrix( LHS.transpose( ) ) - LHS;
+
+            if ( asymmetry.norm( ) > 1e-12 * LHS.norm( ) ){
+
+                COUPLING_LOG( _inputProcessor.getLogger( ), LOG_WARNING ) << "WARNING: The Free DOF LHS matrix is not symmetric. Falling back to the QR decomposition\n";
+                _freeDOFLHSActiveSolver = SPARSE_QR;
+
+            }
+
+        }
+
+        //A positive diagonal is necessary, but not sufficient, for the matrix to be positive definite
+        if ( checkSPD && ( ( _freeDOFLHSActiveSolver == CG_DIAGONAL ) || ( _freeDOFLHSActiveSolver == CG_INCOMPLETE_CHOLESKY ) ) ){
+
+            if ( LHS.diagonal( ).minCoeff( ) <= 0 ){
+
+                COUPLING_LOG( _inputProcessor.getLogger( ), LOG_WARNING ) << "WARNING: The Free DOF LHS matrix has a non-positive diagonal entry. Falling back to the QR decomposition\n";
+                _freeDOFLHSActiveSolver = SPARSE_QR;
+
+            }
+
+        }
+
+        bool analyze = _freeDOFLHSAnalyzedSolvers.find( _freeDOFLHSActiveSolver ) == _freeDOFLHSAnalyzedSolvers.end( );
+
+        if ( analyze ){
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  Analyzing the sparsity pattern of the Free DOF LHS matrix\n";
+#ifdef TESTACCESS
+            _test_freeDOFLHSAnalysisCount++;
+#endif
+
+        }
+        COUPLING_LOG( _inputProcessor.getLogger( ), LOG_DEBUG ) << "  Factorizing the Free DOF LHS matrix\n";
+#ifdef TESTACCESS
+        _test_freeDOFLHSFactorizationCount++;
+#endif
+
+        if ( ( _freeDOFLHSActiveSolver == SIMPLICIAL_LDLT ) || ( _freeDOFLHSActiveSolver == SIMPLICIAL_LLT ) ){
+
+            bool positiveDefinite = true;
+
+            if ( _freeDOFLHSActiveSolver == SIMPLICIAL_LDLT ){
+
+                if ( analyze ){ _freeDOFLHSLDLTSolver.analyzePattern( LHS ); }
+                _freeDOFLHSLDLTSolver.factorize( LHS );
+
+                positiveDefinite = ( _freeDOFLHSLDLTSolver.info( ) == Eigen::Success );
+
+                if ( positiveDefinite && checkSPD ){
+
+                    positiveDefinite = ( _freeDOFLHSLDLTSolver.vectorD( ).minCoeff( ) > 0 );
+
+                }
+
+            }
+            else{
+
+                if ( analyze ){ _freeDOFLHSLLTSolver.analyzePattern( LHS ); }
+                _freeDOFLHSLLTSolver.factorize( LHS );
+
+                positiveDefinite = ( _freeDOFLHSLLTSolver.info( ) == Eigen::Success );
+
+            }
+
+            _freeDOFLHSAnalyzedSolvers.insert( _freeDOFLHSActiveSolver );
+
+            if ( !positiveDefinite ){
+
+                if ( !checkSPD ){
+
+                    return new errorNode( __func__, "The Cholesky factorization of the Free DOF LHS matrix failed" );
+
+                }
+
+                COUPLING_LOG( _inputProcessor.getLogger( ), LOG_WARNING ) << "WARNING: The Free DOF LHS matrix is not positive definite. Falling back to the QR decomposition\n";
+                _freeDOFLHSActiveSolver = SPARSE_QR;
+                analyze = _freeDOFLHSAnalyzedSolvers.find( SPARSE_QR ) == _freeDOFLHSAnalyzedSolvers.end( );
+
+            }
+
+        }
+        else if ( _freeDOFLHSActiveSolver == CG_DIAGONAL ){
+
+            if ( analyze ){ _freeDOFLHSCGDiagonalSolver.analyzePattern( LHS ); }
+            _freeDOFLHSCGDiagonalSolver.factorize( LHS );
+
+            if ( _freeDOFLHSCGDiagonalSolver.info( ) != Eigen::Success ){
+
+                return new errorNode( __func__, "The construction of the diagonal preconditioner of the Free DOF LHS matrix failed" );
+
+            }
+
+            _freeDOFLHSAnalyzedSolvers.insert( _freeDOFLHSActiveSolver );
+
+        }
+        else if ( _freeDOFLHSActiveSolver == CG_INCOMPLETE_CHOLESKY ){
+
+            if ( analyze ){ _freeDOFLHSCGIncompleteCholeskySolver.analyzePattern( LHS ); }
+            _freeDOFLHSCGIncompleteCholeskySolver.factorize( LHS );
+
+            if ( _freeDOFLHSCGIncompleteCholeskySolver.info( ) != Eigen::Success ){
+
+                return new errorNode( __func__, "The construction of the incomplete Cholesky preconditioner of the Free DOF LHS matrix failed" );
+
+            }
+
+            _freeDOFLHSAnalyzedSolvers.insert( _freeDOFLHSActiveSolver );
+
+        }
+
+        if ( _freeDOFLHSActiveSolver == SPARSE_QR ){
+
+            if ( analyze ){ _freeDOFLHSSolver.analyzePattern( LHS ); }
+            _freeDOFLHSSolver.factorize( LHS );
+
+            if ( _freeDOFLHSSolver.info( ) != Eigen::Success ){
+
+                return new errorNode( __func__, "The QR factorization of the Free DOF LHS matrix failed" );
+
+            }
+
+            _freeDOFLHSAnalyzedSolvers.insert( SPARSE_QR );
+
+        }
+
+        _freeDOFLHSFactorized = true;
+        std::copy( LHS.valuePtr( ), LHS.valuePtr( ) + LHS.nonZeros( ), _freeDOFLHS.valuePtr( ) );
+
+        return NULL;
+
+    }
+
+    errorOut overlapCoupling::solveFreeDOFLHS( const Eigen::MatrixXd &RHS, const Eigen::MatrixXd &guess, Eigen::MatrixXd &solution ){
+        /*!
+         * Solve the free degree of freedom system using the factorization computed by factorizeFreeDOFLHS
+         *
+         * :param const Eigen::MatrixXd &RHS: The right hand side of the system
+         * :param const Eigen::MatrixXd &guess: The initial guess for the iterative solvers
+         * :param Eigen::MatrixXd &solution: The solution of the system
+         */
+
+        if ( !_freeDOFLHSFactorized ){
+
+            return new errorNode( __func__, "The Free DOF LHS matrix has not been factorized" );
+
+        }
+
+        if ( ( _freeDOFLHSActiveSolver == CG_DIAGONAL ) || ( _freeDOFLHSActiveSolver == CG_INCOMPLETE_CHOLESKY ) ){
+
+            const YAML::Node solverConfig = _inputProcessor.getCouplingInitialization( )[ "free_dof_solver" ];
+
+            floatType tolerance = solverConfig[ "tolerance" ].as< floatType >( );
+            uIntType maxIterations = solverConfig[ "max_iterations" ].as< uIntType >( );
+
+            Eigen::ComputationInfo info;
+            uIntType iterations;
+            floatType error;
+
+            if ( _freeDOFLHSActiveSolver == CG_DIAGONAL ){
+
+                _freeDOFLHSCGDiagonalSolver.setTolerance( tolerance );
+                if ( maxIterations > 0 ){ _freeDOFLHSCGDiagonalSolver.setMaxIterations( maxIterations ); }
+
+                solution = _freeDOFLHSCGDiagonalSolver.solveWithGuess( RHS, guess );
+
+                info = _freeDOFLHSCGDiagonalSolver.info( );
+                iterations = _freeDOFLHSCGDiagonalSolver.iterations( );
+                error = _freeDOFLHSCGDiagonalSolver.error( );
+
+            }
+            else{
+
+                _freeDOFLHSCGIncompleteCholeskySolver.setTolerance( tolerance );
+                if ( maxIterations > 0 ){ _freeDOFLHSCGIncompleteCholeskySolver.setMaxIterations( maxIterations ); }
+
+                solution = _freeDOFLHSCGIncompleteCholeskySolver.solveWithGuess( RHS, guess );
+
+                info = _freeDOFLHSCGIncompleteCholeskySolver.info( );
+                iterations = _freeDOFLHSCGIncompleteCholeskySolver.iterations( );
+                error = _freeDOFLHSCGIncompleteCholeskySolver.error( );
+
+            }
+
+            COUPLING_LOG( _inputProcessor.getLogger( ), LOG_INFO ) << "  Conjugate gradient iterations: " << iterations << " estimated error: " << error << "\n";
+
+            if ( info != Eigen::Success ){
+
+                return new errorNode( __func__, "The conjugate gradient solve of the Free DOF system did not converge" );
+
+            }
+
+        }
+        else if ( _freeDOFLHSActiveSolver == SIMPLICIAL_LDLT ){
+
+            solution = _freeDOFLHSLDLTSolver.solve( RHS );
+
+        }
+        else if ( _freeDOFLHSActiveSolver == SIMPLICIAL_LLT ){
+
+            solution = _freeDOFLHSLLTSolver.solve( RHS );
+
+        }
+        else{
+
+            solution = _freeDOFLHSSolver.solve( RHS );
+
+        }
+
+        return NULL;
+
+    }
+
+    errorOut overlapCoupling::outputReferenceInformation( ){
+        /*!
+         * Output the reference information to file
+         *
+         * For now, I'm using a XDMF file which may, or may not, be the most 
+         * appropriate file type to use but it does allow me to store the 
+         * data in a binary file ( rather than ASCII ). I want to store the
+         * data in hdf5 ( which XDMF also does ) so the end result of doing
+         * this versus a custom approach is probably not a big deal.
+         */
+
+        //Serialize with any background reads of the data files
+        std::unique_lock< std::recursive_mutex > xdmfLock = dataFileInterface::lockXDMFLibrary( );
+
+        //Get the coupling initialization
+        YAML::Node couplingInitialization = _inputProcessor.getCouplingInitialization( );
+
+        //Initialize the XDMF domain
+        shared_ptr< XdmfDomain > domain = XdmfDomain::New( );
+        std::string domainInfoDescription = "This is not a mesh-based XDMF file and should only be used ";
+        domainInfoDescription += "/ read by overlapCoupling and associated file readers";
+
+        shared_ptr< XdmfInformation > domainInformation = XdmfInformation::New( "REFERENCE_INFORMATION_DOMAIN", domainInfoDescription );
+        domain->insert( domainInformation );
+        shared_ptr< XdmfUnstructuredGrid > grid = XdmfUnstructuredGrid::New( );
+        domain->insert( grid );
+
+        //Get the output filename
+        std::string reference_filename
+            = couplingInitialization[ "output_reference_information" ][ "filename" ].as< std::string >( );
+
+        //Try to remove the files
+        std::string xdmfFilename = reference_filename + ".xdmf";
+        std::string h5Filename = reference_filename + ".h5";
+        remove( xdmfFilename.c_str( ) );
+        remove( h5Filename.c_str( ) );
+
+        //Save the interpolation matrix if required
+        if ( couplingInitialization[ "output_reference_information" ][ "save_interpolation_matrix" ] ){
+
+            errorOut error = writeSparseMatrixToXDMF( _N, "N", reference_filename, domain, grid );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Error when writing out the interpolation matrix N" );
+                result->addNext( error );
+                return result;
+
+            }
+
+
+        }
+
+        errorOut error;
+
+        //Save the projection matrices
+        error = writeSparseMatrixToXDMF( _centerOfMassN, "centerOfMassInterpolator", reference_filename, domain, grid );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__,
+                                             "Error when writing out the center of mass projection matrix" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        error = writeDenseMatrixToXDMF( _centerOfMassProjector, "centerOfMassProjector", reference_filename, domain, grid );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__,
+                                             "Error when writing out the center of mass projection matrix" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        std::string projectionType = couplingInitialization[ "projection_type" ].as< std::string >( );
+        if ( ( projectionType.compare( "l2_projection" ) == 0 ) && !_useSparseL2Projectors ){
+
+            //Initialize the projection matrix attributes
+            shared_ptr< XdmfAttribute > BQhatQ = XdmfAttribute::New( );
+            shared_ptr< XdmfAttribute > BQhatD = XdmfAttribute::New( );
+            shared_ptr< XdmfAttribute > BDhatQ = XdmfAttribute::New( );
+            shared_ptr< XdmfAttribute > BDhatD = XdmfAttribute::New( );
+
+            //Write the matrix type to the output file
+            shared_ptr< XdmfInformation > projectionType = XdmfInformation::New( "EIGEN_MATRIX_TYPE", "DENSE" );
+            grid->insert( projectionType );
+
+            //Write BQhatQ
+            error = writeDenseMatrixToXDMF( _dense_BQhatQ, "BQhatQ", reference_filename, domain, grid );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Error when writing out BQhatQ" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            //Write BQhatD
+            error = writeDenseMatrixToXDMF( _dense_BQhatD, "BQhatD", reference_filename, domain, grid );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Error when writing out BQhatD" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            //Write BDhatQ
+            error = writeDenseMatrixToXDMF( _dense_BDhatQ, "BDhatQ", reference_filename, domain, grid );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Error when writing out BDhatQ" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            //Write BDhatD
+            error = writeDenseMatrixToXDMF( _dense_BDhatD, "BDhatD", reference_filename, domain, grid );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Error when writing out BDhatD" );
+                result->addNext( error );
+                return result;
+
+            }
+
+        }
+        else if ( ( projectionType.compare( "direct_projection" ) == 0 ) || ( projectionType.compare( "averaged_l2_projection" ) == 0 ) ||
+                  ( projectionType.compare( "l2_projection" ) == 0 ) ){
+
+            //Write the matrix type to the output file
+            shared_ptr< XdmfInformation > projectionType = XdmfInformation::New( "EIGEN_MATRIX_TYPE", "SPARSE" );
+            domain->insert( projectionType );
+
+            //Write BQhatD
+            error = writeSparseMatrixToXDMF( _sparse_BQhatD, "BQhatD", reference_filename, domain, grid );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Error when writing out BQhatD" );
+                result->addNext( error );
+                return result;
+
+            }
+
+            //Write BDhatD
+            error = writeSparseMatrixToXDMF( _sparse_BDhatD, "BDhatD", reference_filename, domain, grid );
     
-                    //Store the contribution to the nodes
-                    if ( qes.find( *nodeID ) != qes.end( ) ){
+            if ( error ){
     
-                        qes[ *nodeID ] += openMacroVolume;
-                        macroCellNodeTotalVolumes[ *nodeID ] += elementVolume;
+                errorOut result = new errorNode( __func__,
+                                                 "Error when writing out BDhatD" );
+                result->addNext( error );
+                return result;
     
-                    }
-                    else{
+            }
 
-                        qes.emplace( *nodeID, openMacroVolume );
-                        macroCellNodeTotalVolumes[ *nodeID ] += elementVolume;
+            //Write BQhatQ
+            error = writeSparseMatrixToXDMF( _sparse_BQhatQ, "BQhatQ", reference_filename, domain, grid );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Error when writing out BQhatQ" );
+                result->addNext( error );
+                return result;
 
-                    }
-    
-                }
-    
             }
+
+            //Write BDhatQ
+            error = writeSparseMatrixToXDMF( _sparse_BDhatQ, "BDhatQ", reference_filename, domain, grid );
     
-            for ( auto nodeID  = macroCellNodeTotalVolumes.begin( );
-                       nodeID != macroCellNodeTotalVolumes.end( );
-                       nodeID++ ){
+            if ( error ){
     
-                qes[ nodeID->first ] /= nodeID->second;
+                errorOut result = new errorNode( __func__,
+                                                 "Error when writing out BDhatQ" );
+                result->addNext( error );
+                return result;
     
             }
 
+        }
+        else if ( projectionType.compare( "arlequin" ) == 0 ){
+
+            return NULL;
+
         }
         else{
 
             return new errorNode( __func__,
-                                  "The potential energy partitioning strategy: " + strategy + " is not recognized." );
+                                  "The projection type " + projectionType + " is not recognized" );
 
         }
 
         return NULL;
+
     }
 
-    errorOut overlapCoupling::solveFreeDisplacement( const bool updateGhostDOF ){
+    errorOut writeDenseMatrixToXDMF( const Eigen::MatrixXd &A, const std::string matrixName,
+                                     const std::string &filename, shared_ptr< XdmfDomain > &domain,
+                                     shared_ptr< XdmfUnstructuredGrid > &grid ){
         /*!
-         * Solve for the free displacement. This is done using the Newmark-Beta method ( from Wikipedia ):
-         *
-         * u_{ n + 1 } = u_n + \Delta t * \dot{ u }_n + \frac{ \Delta t^2 }{ 2 }\left( \left( 1 - 2 \beta \right) \ddot{ u }_n + 2 \beta \ddot{ u }_{n+1 } \right)
-         * \dot{ u }_{ n + 1 } = \dot{ u }_n + ( 1 - \gamma ) \Delta t \ddot{ u }_n + \gamma \Delta t \ddot{ u }_{n + 1}
-         * M \ddot{ u }_{n + 1} + C \dot{ u }_{n + 1} + f^{int}\left( u_{n + 1} \right) = f^{ext}_{n+1}
-         *
-         * Where the Explicit central difference scheme is obtained by letting $\gamma = 0.5$ and $\beta = 0$
-         *
-         * and
-         *
-         * Average constant acceleration is obtained by setting $\gamma = 0.5$ and $\beta = 0.25$
-         *
-         * NOTE: The current implementation cannot do implicit solves here but it does solve for what the
-         * displacement values *should* be given the current values of the force vectors and those can be
-         * used to construct residual equations. It is hoped that Jacobian Free Newton Krylov will be 
-         * capable of solving the coupled PDEs without having to explicitly form the Jacobian.
+         * Write a dense matrix to a XDMF file ( not a standard XDMF format )
          *
-         * :param const bool updateGhostDOF: A flag for whether the ghost degrees of freedom should be updated as well
+         * :param const Eigen::MatrixXd &A: The matrix to write
+         * :param const std::string matrixName: The name of the matrix MUST BE UNIQUE IN THE OUTPUT FILE
+         * :param const std::string &filename: The name of the output file
+         * :param shared_ptr< XdmfDomain > &domain: The XDMF domain
+         * :param shared_ptr< XdmfDomain > &grid: The XDMF grid
          */
 
-        //Set the configuration
-        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
-
-        std::string projection_type = config[ "projection_type" ].as< std::string >( );
-        const floatType gamma = *_inputProcessor.getNewmarkGamma( );
-        const floatType beta = *_inputProcessor.getNewmarkBeta( );
-
-        //Get the timestep
-        const floatType *dt = _inputProcessor.getDt( );
-
-        //Set the number of displacement degrees of freedom for each scale
-        const uIntType nMicroDispDOF = _dim;
-        const uIntType nMacroDispDOF = _dim + _dim * _dim;
-
-        //Get the maps from the global to the local degrees of freedom
-        const DOFMap *microGlobalToLocalDOFMap = _inputProcessor.getMicroGlobalToLocalDOFMap( );
-        const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
-
-        //Get the free degree of freedom values at both scale
-        const uIntVector *freeMicroNodeIds = _inputProcessor.getFreeMicroNodeIds( );
-        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
-
-        const uIntType microOffset = nMicroDispDOF * freeMicroNodeIds->size( );
+        //Serialize with any background reads of the data files
+        std::unique_lock< std::recursive_mutex > xdmfLock = dataFileInterface::lockXDMFLibrary( );
 
-        //Get the previous values of the degrees of freedom and their velocities and accelerations
-        const std::unordered_map< uIntType, floatVector > *previousMicroDispDOFVector = _inputProcessor.getPreviousMicroDisplacements( );
-        const std::unordered_map< uIntType, floatVector > *previousMicroVelocities    = _inputProcessor.getPreviousMicroVelocities( );
-        const std::unordered_map< uIntType, floatVector > *previousMicroAccelerations = _inputProcessor.getPreviousMicroAccelerations( );
+        //Initialize the writer
+        shared_ptr< XdmfHDF5Writer > heavyWriter = XdmfHDF5Writer::New( filename + ".h5", false );
+        heavyWriter->setReleaseData( true );
+        shared_ptr< XdmfWriter > writer = XdmfWriter::New( filename + ".xdmf", heavyWriter );
 
-        const std::unordered_map< uIntType, floatVector > *previousMacroDispDOFVector = _inputProcessor.getPreviousMacroDispDOFVector( );
-        const std::unordered_map< uIntType, floatVector > *previousMacroVelocities    = _inputProcessor.getPreviousMacroVelocities( );
-        const std::unordered_map< uIntType, floatVector > *previousMacroAccelerations = _inputProcessor.getPreviousMacroAccelerations( );
+        shared_ptr< XdmfAttribute > _A = XdmfAttribute::New( );
+        _A->setName( matrixName );
 
-        //Set the degree of freedom vectors
-        //To try and save some memory, we will overwrite DOF and DotDOF as the integrated values become available
-        floatVector       FreeDOF( nMicroDispDOF * freeMicroNodeIds->size( ) + nMacroDispDOF * freeMacroNodeIds->size( ), 0 );
-        floatVector        DotDOF( nMicroDispDOF * freeMicroNodeIds->size( ) + nMacroDispDOF * freeMacroNodeIds->size( ), 0 );
-        floatVector   DotDotDOF_t( nMicroDispDOF * freeMicroNodeIds->size( ) + nMacroDispDOF * freeMacroNodeIds->size( ), 0 );
-        floatVector DotDotDOF_tp1( nMicroDispDOF * freeMicroNodeIds->size( ) + nMacroDispDOF * freeMacroNodeIds->size( ), 0 );
+        shared_ptr< XdmfInformation > A_info
+            = XdmfInformation::New( matrixName + "_shape",
+                                    std::to_string( A.rows( ) ) + "," + std::to_string( A.cols( ) ) );
+        _A->insert( A_info );
+        _A->insert( 0, A.data( ), A.size( ), 1, 1 );
+        grid->insert( _A );
 
-        //Extract the micro points
-        for ( auto nodeId = freeMicroNodeIds->begin( ); nodeId != freeMicroNodeIds->end( ); nodeId++ ){
+        domain->accept( writer );
 
-            //Find the map from global to local node ids
-            auto indexMap = microGlobalToLocalDOFMap->find( *nodeId );
+        return NULL;
 
-            if ( indexMap == microGlobalToLocalDOFMap->end( ) ){
+    }
 
-                return new errorNode( __func__,
-                                      "Micro node " + std::to_string( *nodeId ) + " not found in global to local map" );
+    errorOut writeSparseMatrixToXDMF( const SparseMatrix &A, const std::string matrixName,
+                                      const std::string &filename, shared_ptr< XdmfDomain > &domain,
+                                      shared_ptr< XdmfUnstructuredGrid > &grid ){
+        /*!
+         * Write a sparse matrix to a XDMF file ( not a standard XDMF format )
+         *
+         * :param const SparseMatrix &A: The matrix to write
+         * :param const std::string matrixName: The name of the matrix MUST BE UNIQUE IN THE OUTPUT FILE
+         * :param const std::string &filename: The name of the output file
+         * :param shared_ptr< XdmfDomain > &domain: The XDMF domain
+         * :param shared_ptr< XdmfDomain > &grid: The XDMF grid
+         */
 
-            }
+        //Serialize with any background reads of the data files
+        std::unique_lock< std::recursive_mutex > xdmfLock = dataFileInterface::lockXDMFLibrary( );
 
-            auto previousMicroDisp = previousMicroDispDOFVector->find( *nodeId );
+        //Initialize the writer
+        shared_ptr< XdmfHDF5Writer > heavyWriter = XdmfHDF5Writer::New( filename + ".h5", false );
+        heavyWriter->setReleaseData( true );
+        shared_ptr< XdmfWriter > writer = XdmfWriter::New( filename + ".xdmf", heavyWriter );
 
-            if ( previousMicroDisp == previousMicroDispDOFVector->end( ) ){
+        shared_ptr< XdmfAttribute > _A = XdmfAttribute::New( );
+        _A->setName( matrixName );
+        shared_ptr< XdmfInformation > _A_info
+            = XdmfInformation::New( matrixName + "_shape",
+                                    std::to_string( A.rows( ) ) + "," + std::to_string( A.cols( ) ) );
+        _A->insert( _A_info );
+        grid->insert( _A );
 
-                return new errorNode( __func__,
-                                      "The micro node " + std::to_string( *nodeId ) +
-                                      " is not found in the previous micro displacement dof vector" );
+        uIntVector rowIndices, colIndices;
+        uIntType nonZeros = A.nonZeros( );
+        rowIndices.reserve( nonZeros );
+        colIndices.reserve( nonZeros );
 
-            }
+        floatVector values;
+        values.reserve( nonZeros );
 
-            auto previousMicroVel = previousMicroVelocities->find( *nodeId );
+        for (int k=0; k < A.outerSize(); ++k) {
 
-            if ( previousMicroVel == previousMicroVelocities->end( ) ){
+            for (SparseMatrix::InnerIterator it(A,k); it; ++it){
 
-                return new errorNode( __func__,
-                                      "The micro node " + std::to_string( *nodeId ) +
-                                      " is not found in the previous micro velocities vector" );
+                rowIndices.push_back( it.row( ) );
+                colIndices.push_back( it.col( ) );
+                values.push_back( it.value( ) );
 
             }
 
-            auto previousMicroAccel = previousMicroAccelerations->find( *nodeId );
-
-            if ( previousMicroAccel == previousMicroAccelerations->end( ) ){
-
-                return new errorNode( __func__,
-                                      "The micro node " + std::to_string( *nodeId ) +
-                                      " is not found in the previous micro accelerations vector" );
-
-            }
+        }
 
-            //Extract the micro points
-            for ( unsigned int i = 0; i < nMicroDispDOF; i++ ){
+        shared_ptr< XdmfAttribute > _A_rows = XdmfAttribute::New( );
+        _A_rows->setName( matrixName + "_rows" );
+        _A_rows->insert( 0, rowIndices.data( ), rowIndices.size( ), 1, 1 );
+        grid->insert( _A_rows );
 
-                FreeDOF[ nMicroDispDOF * indexMap->second + i ] = previousMicroDisp->second[ i ];
+        shared_ptr< XdmfAttribute > _A_cols = XdmfAttribute::New( );
+        _A_cols->setName( matrixName + "_cols" );
+        _A_cols->insert( 0, colIndices.data( ), colIndices.size( ), 1, 1 );
+        grid->insert( _A_cols );
 
-                if ( _inputProcessor.microVelocitiesDefined( ) ){
+        shared_ptr< XdmfAttribute > _A_values = XdmfAttribute::New( );
+        _A_values->setName( matrixName + "_values" );
+        _A_values->insert( 0, values.data( ), values.size( ), 1, 1 );
+        grid->insert( _A_values );
 
-                    DotDOF[ nMicroDispDOF * indexMap->second + i ] = previousMicroVel->second[ i ];
+        domain->accept( writer );
+        return NULL;
+    }
 
-                }
+    errorOut readDenseMatrixFromXDMF( const shared_ptr< XdmfUnstructuredGrid > &grid, const std::string &matrixName, Eigen::MatrixXd &A ){
+        /*!
+         * Read a dense matrix from a XDMF file attribute. This is not a standard use of a XDMF file.
+         *
+         * NOTE: Assumes default Eigen storage ( column major );
+         *
+         * :param const shared_ptr< XdmfUnstructuredGrid > &grid: The pointer to the grid object that contains the matrix
+         * :param const std::string &matrixName: The name of the matrix
+         * :param Eigen::MatrixXdx &A: The re-constructed matrix
+         */
 
-                if ( _inputProcessor.microAccelerationDefined( ) ){
+        //Serialize with any background reads of the data files
+        std::unique_lock< std::recursive_mutex > xdmfLock = dataFileInterface::lockXDMFLibrary( );
 
-                    DotDotDOF_t[ nMicroDispDOF * indexMap->second + i ] = previousMicroAccel->second[ i ];
+        shared_ptr< XdmfAttribute > _A = grid->getAttribute( matrixName );
 
-                }
+        if ( !_A ){
 
-            }
+            std::string outstr = matrixName;
+            outstr += " does not appear as an attribute in the provided grid\n";
+            return new errorNode( __func__, outstr );
 
         }
 
-        //Extract macro points
-        for ( auto nodeId = freeMacroNodeIds->begin( ); nodeId != freeMacroNodeIds->end( ); nodeId++ ){
-
-            //Find the map from global to local node ids
-            auto indexMap = macroGlobalToLocalDOFMap->find( *nodeId );
+        shared_ptr< XdmfInformation > shapeInfo = _A->getInformation( 0 );
 
-            if ( indexMap == macroGlobalToLocalDOFMap->end( ) ){
+        if ( !shapeInfo ){
 
-                return new errorNode( __func__,
-                                      "Macro node " + std::to_string( *nodeId ) + " not found in global to local map" );
+            std::string outstr = "There is no information defined for the matrix " + matrixName;
+            return new errorNode( __func__, outstr );
 
-            }
+        }
 
-            auto previousMacroDisp = previousMacroDispDOFVector->find( *nodeId );
+        if ( shapeInfo->getKey( ).compare( matrixName + "_shape" ) != 0 ){
 
-            if ( previousMacroDisp == previousMacroDispDOFVector->end( ) ){
+            std::string outstr = matrixName;
+            outstr += "_shape is not in the information key";
+            return new errorNode( __func__, outstr );
 
-                return new errorNode( __func__,
-                                      "The macro node " + std::to_string( *nodeId ) +
-                                      " is not found in the previous macro displacement dof vector" );
+        }
 
-            }
+        std::string matrixDimensionString = shapeInfo->getValue( );
 
-            auto previousMacroVel = previousMacroVelocities->find( *nodeId );
+        //Extract the rows and columns
+        uIntType rows = std::stoi( matrixDimensionString.substr( 0, matrixDimensionString.find( "," ) ) );
+        uIntType cols = std::stoi( matrixDimensionString.substr( matrixDimensionString.find( "," ) + 1, matrixDimensionString.size( ) ) );
 
-            if ( previousMacroVel == previousMacroVelocities->end( ) ){
+        _A->read( );
 
-                return new errorNode( __func__,
-                                      "The macro node " + std::to_string( *nodeId ) +
-                                      " is not found in the previous macro velocities vector" );
+        //Initialize the matrix
+        A = Eigen::MatrixXd( rows, cols );
 
+        for ( unsigned int i = 0; i < cols; i++ ){
+            for ( unsigned int j = 0; j < rows; j++ ){
+                A( j, i ) = _A->getValue< floatType >( rows * i + j );
             }
+        }
 
-            auto previousMacroAccel = previousMacroAccelerations->find( *nodeId );
-
-            if ( previousMacroAccel == previousMacroAccelerations->end( ) ){
-
-                return new errorNode( __func__,
-                                      "The macro node " + std::to_string( *nodeId ) +
-                                      " is not found in the previous macro accelerations vector" );
-
-            }
+        return NULL;
+    }
 
-            //Extract the macro points
-            for ( unsigned int i = 0; i < nMacroDispDOF; i++ ){
+    errorOut readSparseMatrixFromXDMF( const shared_ptr< XdmfUnstructuredGrid > &grid, const std::string &matrixName, SparseMatrix &A ){
+        /*!
+         * Read a sparse matrix from a XDMF file attribute. This is not a standard use of a XDMF file.
+         *
+         * :param const shared_ptr< XdmfUnstructuredGrid > &grid: The pointer to the grid object that contains the matrix
+         * :param const std::string &matrixName: The name of the matrix
+         * :param SparseMatrix &A: The re-constructed sparse matrix
+         */
 
-                FreeDOF[ nMacroDispDOF * indexMap->second + i + microOffset ] = previousMacroDisp->second[ i ];
+        //Serialize with any background reads of the data files
+        std::unique_lock< std::recursive_mutex > xdmfLock = dataFileInterface::lockXDMFLibrary( );
 
-                if ( _inputProcessor.macroVelocitiesDefined( ) ){
+        shared_ptr< XdmfAttribute > _A = grid->getAttribute( matrixName );
 
-                    DotDOF[ nMacroDispDOF * indexMap->second + i + microOffset ] = previousMacroVel->second[ i ];
+        if ( !_A ){
 
-                }
+            std::string outstr = matrixName;
+            outstr += " does not appear as an attribute in the provided grid\n";
+            return new errorNode( __func__, outstr );
 
-                if ( _inputProcessor.macroAccelerationDefined( ) ){
+        }
 
-                    DotDotDOF_t[ nMacroDispDOF * indexMap->second + i + microOffset ] = previousMacroAccel->second[ i ];
+        shared_ptr< XdmfInformation > shapeInfo = _A->getInformation( 0 );
 
-                }
+        if ( !shapeInfo ){
 
-            }
+            std::string outstr = "There is no information defined for the SparseMatrix " + matrixName;
+            return new errorNode( __func__, outstr );
 
         }
 
-        //Map the vectors to Eigen matrices
-        Eigen::Map< Eigen::Matrix< floatType, -1,  1 > > _DOF( FreeDOF.data(), FreeDOF.size( ), 1 );
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _DotDOF( DotDOF.data(), DotDOF.size( ), 1 );
-        Eigen::Map< const Eigen::Matrix< floatType, -1,  1 > > _DotDotDOF_t( DotDotDOF_t.data(), DotDotDOF_t.size( ), 1 );
-        Eigen::Map< Eigen::Matrix< floatType, -1,  1 > > _DotDotDOF_tp1( DotDotDOF_tp1.data(), DotDotDOF_tp1.size( ), 1 );
+        if ( shapeInfo->getKey( ).compare( matrixName + "_shape" ) != 0 ){
 
-#ifdef TESTACCESS
+            std::string outstr = matrixName;
+            outstr += "_shape is not in the information key";
+            return new errorNode( __func__, outstr );
 
-        _test_DOF_t = _DOF;
-        _test_DotDOF_t = _DotDOF;
-        _test_DotDotDOF_t = _DotDotDOF_t;
+        }
 
-#endif
+        std::string matrixDimensionString = shapeInfo->getValue( );
 
-        //Instantiate the QR solver
-        std::cout << "Performing QR decomposition of the Free DOF LHS matrix\n";
+        //Extract the rows and cols
+        uIntType rows = std::stoi( matrixDimensionString.substr( 0, matrixDimensionString.find( "," ) ) );
+        uIntType cols = std::stoi( matrixDimensionString.substr( matrixDimensionString.find( "," ) + 1, matrixDimensionString.size( ) ) );
 
-        Eigen::MatrixXd RHS;
-        if ( ( projection_type.compare( "l2_projection" ) == 0 ) ){
+        //Construct the triplet vector
+        shared_ptr< XdmfAttribute > _rows = grid->getAttribute( matrixName + "_rows" );
 
-            SparseMatrix LHS( _sparse_MASS.rows( ), _sparse_MASS.cols( ) );
-            LHS = _sparse_MASS;
-            LHS += gamma * ( *dt ) * _sparse_DAMPING;
+        if ( !_rows ){
 
-            RHS = _FORCE;
-            RHS -= _sparse_DAMPING * ( _DotDOF + ( 1 - gamma ) * ( *dt ) * _DotDotDOF_t );
+            std::string outstr = matrixName;
+            outstr += "_rows attribute is not found";
+            return new errorNode( __func__, outstr );
 
-//            _DotDotDOF_tp1 = LHS.colPivHouseholderQr( ).solve( RHS );
-            Eigen::SparseQR< SparseMatrix, Eigen::COLAMDOrdering<int> > solver;
-            solver.compute( LHS );
-            _DotDotDOF_tp1 = solver.solve( RHS );
         }
-        else if ( ( projection_type.compare( "direct_projection" ) == 0 ) ||
-                  ( projection_type.compare( "averaged_l2_projection" ) == 0 ) ){
-
-            SparseMatrix LHS( _sparse_MASS.rows( ), _sparse_MASS.cols( ) );
-            LHS = _sparse_MASS;
-            LHS += gamma * ( *dt ) * _sparse_DAMPING;
-            LHS.makeCompressed( );
 
-            RHS = _FORCE;
-            RHS -= _sparse_DAMPING * ( _DotDOF + ( 1 - gamma ) * ( *dt ) * _DotDotDOF_t );
+        shared_ptr< XdmfAttribute > _cols = grid->getAttribute( matrixName + "_cols" );
 
-            Eigen::SparseQR< SparseMatrix, Eigen::COLAMDOrdering<int> > solver;
-            solver.compute( LHS );
-            _DotDotDOF_tp1 = solver.solve( RHS );
+        if ( !_cols ){
 
-//            return new errorNode( __func__, "derp3" );
-//
-//            std::cout << "_DotDof:\n";
-//            std::cout << "microscale\n";
-//            for ( unsigned int i = 0; i < microOffset; i++ ){
-//                std::cout << _DotDOF( i, 0 ) << " ";
-//                if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                    std::cout << "\n";
-//                }
-//            }
-//            std::cout << "macroscale\n";
-//            for ( unsigned int i = microOffset; i < _DotDOF.size( ); i++ ){
-//                std::cout << _DotDOF( i, 0 ) << " ";
-//                if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                    std::cout << "\n";
-//                }
-//            }
-//
-//            return new errorNode( __func__, "derp" );
-//
-//            std::cout << "_DotDotDof_t:\n";
-//            std::cout << "microscale\n";
-//            for ( unsigned int i = 0; i < microOffset; i++ ){
-//                std::cout << _DotDotDOF_t( i, 0 ) << " ";
-//                if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                    std::cout << "\n";
-//                }
-//            }
-//            std::cout << "macroscale\n";
-//            for ( unsigned int i = microOffset; i < _DotDotDOF_t.size( ); i++ ){
-//                std::cout << _DotDotDOF_t( i, 0 ) << " ";
-//                if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                    std::cout << "\n";
-//                }
-//            }
-//
-//            std::cout << "_DotDotDof_tp1:\n";
-//            std::cout << "microscale\n";
-//            for ( unsigned int i = 0; i < microOffset; i++ ){
-//                std::cout << _DotDotDOF_tp1( i, 0 ) << " ";
-//                if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                    std::cout << "\n";
-//                }
-//            }
-//            std::cout << "macroscale\n";
-//            for ( unsigned int i = microOffset; i < _DotDotDOF_tp1.size( ); i++ ){
-//                std::cout << _DotDotDOF_tp1( i, 0 ) << " ";
-//                if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                    std::cout << "\n";
-//                }
-//            }
-//
-//            return new errorNode( __func__, "derp2" );
+            std::string outstr = matrixName;
+            outstr += "_cols attribute is not found";
+            return new errorNode( __func__, outstr );
 
         }
-        else{
 
-            return new errorNode( __func__, "Projection type " + projection_type + " not recognized" );
+        shared_ptr< XdmfAttribute > _vals = grid->getAttribute( matrixName + "_values" );
+
+        if ( !_cols ){
+
+            std::string outstr = matrixName;
+            outstr += "_values attribute is not found";
+            return new errorNode( __func__, outstr );
 
         }
 
-        //Update the free degrees of freedom
-        _DOF += ( *dt ) * _DotDOF + 0.5 * ( ( *dt ) * ( *dt ) ) * ( ( 1 - 2 * beta ) * _DotDotDOF_t + 2 * beta * _DotDotDOF_tp1 );
+        if ( ( _rows->getSize( ) != _cols->getSize( ) ) && ( _rows->getSize( ) != _vals->getSize( ) ) ){
 
-#ifdef TESTACCESS
+            std::string outstr = matrixName;
+            outstr += " attributes rows, cols, and values don't have consistent sizes";
+            return new errorNode( __func__, outstr );
 
-        _test_DOF_tp1 = _DOF;
-        _test_DotDotDOF_tp1 = _DotDotDOF_tp1;
+        }
 
-#endif
+        _rows->read( );
+        _cols->read( );
+        _vals->read( );
 
-        //Store the free degrees of freedom
-        _updatedFreeMicroDispDOFValues = floatVector( FreeDOF.begin( ), FreeDOF.begin( ) + microOffset );
-        _updatedFreeMacroDispDOFValues = floatVector( FreeDOF.begin( ) + microOffset, FreeDOF.end( ) );
-        _freeDOFValuesUpdated = true;
+        tripletVector triplets;
+        triplets.reserve( _rows->getSize( ) );
 
-        if ( updateGhostDOF ){
+        for ( uIntType i = 0; i != _rows->getSize( ); i++ ){
 
-            errorOut error = projectDegreesOfFreedom( updateGhostDOF );
+            uIntType _r = _rows->getValue< uIntType >( i );
+            uIntType _c = _cols->getValue< uIntType >( i );
+            floatType _v = _vals->getValue< floatType >( i );
 
-            if ( error ){
-    
-                errorOut result = new errorNode( __func__,
-                                                 "Error in the projection of the ghost degrees of freedom" );
-                result->addNext( error );
-                return result;
-    
-            }            
+            triplets.push_back( DOFProjection::T( _r, _c, _v ) );
 
         }
 
+        A = SparseMatrix( rows, cols );
+        A.setFromTriplets( triplets.begin( ), triplets.end( ) );
+
         return NULL;
 
     }
 
-    errorOut overlapCoupling::outputReferenceInformation( ){
+    errorOut computeLumpedGramDiagonal( const SparseMatrix &N, const Eigen::VectorXd &scale, const floatType &shift,
+                                        Eigen::VectorXd &lumpedDiagonal ){
         /*!
-         * Output the reference information to file
+         * Compute the row sums of N diag( scale ) N^T + shift I. The row sums are evaluated as
+         * N ( scale * ( N^T 1 ) ) + shift so that only products of N with vectors are required.
          *
-         * For now, I'm using a XDMF file which may, or may not, be the most 
-         * appropriate file type to use but it does allow me to store the 
-         * data in a binary file ( rather than ASCII ). I want to store the
-         * data in hdf5 ( which XDMF also does ) so the end result of doing
-         * this versus a custom approach is probably not a big deal.
+         * :param const SparseMatrix &N: The matrix N
+         * :param const Eigen::VectorXd &scale: The diagonal scaling between N and N^T
+         * :param const floatType &shift: The value added to the diagonal
+         * :param Eigen::VectorXd &lumpedDiagonal: The row sums
          */
 
-        //Get the coupling initialization
-        YAML::Node couplingInitialization = _inputProcessor.getCouplingInitialization( );
+        if ( scale.size( ) != N.cols( ) ){
 
-        //Initialize the XDMF domain
-        shared_ptr< XdmfDomain > domain = XdmfDomain::New( );
-        std::string domainInfoDescription = "This is not a mesh-based XDMF file and should only be used ";
-        domainInfoDescription += "/ read by overlapCoupling and associated file readers";
+            return new errorNode( __func__, "The scaling has " + std::to_string( scale.size( ) ) + " entries but N has "
+                                          + std::to_string( N.cols( ) ) + " columns" );
 
-        shared_ptr< XdmfInformation > domainInformation = XdmfInformation::New( "REFERENCE_INFORMATION_DOMAIN", domainInfoDescription );
-        domain->insert( domainInformation );
-        shared_ptr< XdmfUnstructuredGrid > grid = XdmfUnstructuredGrid::New( );
-        domain->insert( grid );
+        }
+
+        lumpedDiagonal = N * scale.cwiseProduct( N.transpose( ) * Eigen::VectorXd::Ones( N.rows( ) ) );
+        lumpedDiagonal.array( ) += shift;
+
+        return NULL;
 
-        //Get the output filename
-        std::string reference_filename
-            = couplingInitialization[ "output_reference_information" ][ "filename" ].as< std::string >( );
+    }
 
-        //Try to remove the files
-        std::string xdmfFilename = reference_filename + ".xdmf";
-        std::string h5Filename = reference_filename + ".h5";
-        remove( xdmfFilename.c_str( ) );
-        remove( h5Filename.c_str( ) );
+    errorOut overlapCoupling::extractProjectionMatricesFromFile( ){
+        /*!
+         * Extract the projection matrices from the storage file
+         */
 
-        //Save the interpolation matrix if required
-        if ( couplingInitialization[ "output_reference_information" ][ "save_interpolation_matrix" ] ){
+        //Set the filename
+        YAML::Node config = _inputProcessor.getCouplingInitialization( );
+        std::string filename = config[ "reference_filename" ].as< std::string >( );
 
-            errorOut error = writeSparseMatrixToXDMF( _N, "N", reference_filename, domain, grid );
+        //Initialize the XDMF reader serializing with any background reads of the data files
+        std::unique_lock< std::recursive_mutex > xdmfLock = dataFileInterface::lockXDMFLibrary( );
+        shared_ptr< XdmfReader > reader = XdmfReader::New( );
+        shared_ptr< XdmfDomain > _readDomain = shared_dynamic_cast< XdmfDomain >( reader->read( filename ) );
+        shared_ptr< XdmfUnstructuredGrid > _readGrid = _readDomain->getUnstructuredGrid( 0 );
 
-            if ( error ){
+        std::string projectionType = config[ "projection_type" ].as< std::string >( );
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error when writing out the interpolation matrix N" );
-                result->addNext( error );
-                return result;
+        //Determine the storage format of the projectors. Dense projectors are flagged on the grid and sparse
+        //projectors on the domain
+        std::string matrixType = "SPARSE";
+        shared_ptr< XdmfInformation > matrixTypeInformation = _readGrid->getInformation( "EIGEN_MATRIX_TYPE" );
 
-            }
+        if ( !matrixTypeInformation ){
 
+            matrixTypeInformation = _readDomain->getInformation( "EIGEN_MATRIX_TYPE" );
 
         }
 
-        errorOut error;
+        if ( matrixTypeInformation ){
 
-        //Save the projection matrices
-        error = writeSparseMatrixToXDMF( _centerOfMassN, "centerOfMassInterpolator", reference_filename, domain, grid );
+            matrixType = matrixTypeInformation->getValue( );
+
+        }
+
+        errorOut error = readSparseMatrixFromXDMF( _readGrid, "centerOfMassInterpolator", _centerOfMassN );
 
         if ( error ){
 
             errorOut result = new errorNode( __func__,
-                                             "Error when writing out the center of mass projection matrix" );
+                                             "Error in extracting the center of mass interpolation" );
             result->addNext( error );
             return result;
 
         }
 
-        error = writeDenseMatrixToXDMF( _centerOfMassProjector, "centerOfMassProjector", reference_filename, domain, grid );
+        error = readDenseMatrixFromXDMF( _readGrid, "centerOfMassProjector", _centerOfMassProjector );
 
         if ( error ){
 
             errorOut result = new errorNode( __func__,
-                                             "Error when writing out the center of mass projection matrix" );
+                                             "Error in extracting the center of mass projector" );
             result->addNext( error );
             return result;
 
         }
 
-        std::string projectionType = couplingInitialization[ "projection_type" ].as< std::string >( );
-        if ( ( projectionType.compare( "l2_projection" ) == 0 ) ){
-
-            //Initialize the projection matrix attributes
-            shared_ptr< XdmfAttribute > BQhatQ = XdmfAttribute::New( );
-            shared_ptr< XdmfAttribute > BQhatD = XdmfAttribute::New( );
-            shared_ptr< XdmfAttribute > BDhatQ = XdmfAttribute::New( );
-            shared_ptr< XdmfAttribute > BDhatD = XdmfAttribute::New( );
+        if ( ( projectionType.compare( "l2_projection" ) == 0 ) && ( matrixType.compare( "DENSE" ) == 0 ) ){
 
-            //Write the matrix type to the output file
-            shared_ptr< XdmfInformation > projectionType = XdmfInformation::New( "EIGEN_MATRIX_TYPE", "DENSE" );
-            grid->insert( projectionType );
+            _useSparseL2Projectors = false;
 
-            //Write BQhatQ
-            error = writeDenseMatrixToXDMF( _dense_BQhatQ, "BQhatQ", reference_filename, domain, grid );
+            error = readDenseMatrixFromXDMF( _readGrid, "BQhatQ", _dense_BQhatQ );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error when writing out BQhatQ" );
+                errorOut result
+                    = new errorNode( __func__, "Error when extracting BQhatQ from the XDMF file" );
                 result->addNext( error );
                 return result;
 
             }
 
-            //Write BQhatD
-            error = writeDenseMatrixToXDMF( _dense_BQhatD, "BQhatD", reference_filename, domain, grid );
+            error = readDenseMatrixFromXDMF( _readGrid, "BQhatD", _dense_BQhatD );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error when writing out BQhatD" );
+                errorOut result
+                    = new errorNode( __func__, "Error when extracting BQhatD from the XDMF file" );
                 result->addNext( error );
                 return result;
 
             }
 
-            //Write BDhatQ
-            error = writeDenseMatrixToXDMF( _dense_BDhatQ, "BDhatQ", reference_filename, domain, grid );
+            error = readDenseMatrixFromXDMF( _readGrid, "BDhatQ", _dense_BDhatQ );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error when writing out BDhatQ" );
+                errorOut result
+                    = new errorNode( __func__, "Error when extracting BDhatQ from the XDMF file" );
                 result->addNext( error );
                 return result;
 
             }
 
-            //Write BDhatD
-            error = writeDenseMatrixToXDMF( _dense_BDhatD, "BDhatD", reference_filename, domain, grid );
+            error = readDenseMatrixFromXDMF( _readGrid, "BDhatD", _dense_BDhatD );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error when writing out BDhatD" );
+                errorOut result
+                    = new errorNode( __func__, "Error when extracting BDhatD from the XDMF file" );
                 result->addNext( error );
                 return result;
 
             }
 
         }
-        else if ( ( projectionType.compare( "direct_projection" ) == 0 ) || ( projectionType.compare( "averaged_l2_projection" ) == 0 ) ){
+        else if ( ( projectionType.compare( "direct_projection" ) == 0 ) || ( projectionType.compare( "averaged_l2_projection" ) == 0 ) ||
+                  ( projectionType.compare( "l2_projection" ) == 0 ) ){
 
-            //Write the matrix type to the output file
-            shared_ptr< XdmfInformation > projectionType = XdmfInformation::New( "EIGEN_MATRIX_TYPE", "SPARSE" );
-            domain->insert( projectionType );
+            //The sparse L2 projectors are applied explicitly since the factorization of NQDhat is not stored
+            _useSparseL2Projectors = projectionType.compare( "l2_projection" ) == 0;
+            _implicitL2Projectors = false;
 
-            //Write BQhatD
-            error = writeSparseMatrixToXDMF( _sparse_BQhatD, "BQhatD", reference_filename, domain, grid );
+            error = readSparseMatrixFromXDMF( _readGrid, "BQhatQ", _sparse_BQhatQ );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error when writing out BQhatD" );
+                errorOut result
+                    = new errorNode( __func__, "Error when extracting BQhatQ from the XDMF file" );
                 result->addNext( error );
                 return result;
 
             }
 
-            //Write BDhatD
-            error = writeSparseMatrixToXDMF( _sparse_BDhatD, "BDhatD", reference_filename, domain, grid );
-    
+            error = readSparseMatrixFromXDMF( _readGrid, "BQhatD", _sparse_BQhatD );
+
             if ( error ){
-    
-                errorOut result = new errorNode( __func__,
-                                                 "Error when writing out BDhatD" );
+
+                errorOut result
+                    = new errorNode( __func__, "Error when extracting BQhatD from the XDMF file" );
                 result->addNext( error );
                 return result;
-    
+
             }
 
-            //Write BQhatQ
-            error = writeSparseMatrixToXDMF( _sparse_BQhatQ, "BQhatQ", reference_filename, domain, grid );
+            error = readSparseMatrixFromXDMF( _readGrid, "BDhatQ", _sparse_BDhatQ );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error when writing out BQhatQ" );
+                errorOut result
+                    = new errorNode( __func__, "Error when extracting BDhatQ from the XDMF file" );
                 result->addNext( error );
                 return result;
 
             }
 
-            //Write BDhatQ
-            error = writeSparseMatrixToXDMF( _sparse_BDhatQ, "BDhatQ", reference_filename, domain, grid );
-    
+            error = readSparseMatrixFromXDMF( _readGrid, "BDhatD", _sparse_BDhatD );
+
             if ( error ){
-    
-                errorOut result = new errorNode( __func__,
-                                                 "Error when writing out BDhatQ" );
+
+                errorOut result
+                    = new errorNode( __func__, "Error when extracting BDhatD from the XDMF file" );
                 result->addNext( error );
                 return result;
-    
-            }
-
-        }
-        else if ( projectionType.compare( "arlequin" ) == 0 ){
 
-            return NULL;
+            }
 
         }
         else{
 
-            return new errorNode( __func__,
-                                  "The projection type " + projectionType + " is not recognized" );
+            return new errorNode( __func__, "Not implemented" );
 
         }
 
@@ -9953,962 +12073,1119 @@ namespace overlapCoupling{
 
     }
 
-    errorOut writeDenseMatrixToXDMF( const Eigen::MatrixXd &A, const std::string matrixName,
-                                     const std::string &filename, shared_ptr< XdmfDomain > &domain,
-                                     shared_ptr< XdmfUnstructuredGrid > &grid ){
+    errorOut overlapCoupling::outputHomogenizedResponse( const uIntType collectionNumber ){
         /*!
-         * Write a dense matrix to a XDMF file ( not a standard XDMF format )
+         * Output the homogenized response to the data file
          *
-         * :param const Eigen::MatrixXd &A: The matrix to write
-         * :param const std::string matrixName: The name of the matrix MUST BE UNIQUE IN THE OUTPUT FILE
-         * :param const std::string &filename: The name of the output file
-         * :param shared_ptr< XdmfDomain > &domain: The XDMF domain
-         * :param shared_ptr< XdmfDomain > &grid: The XDMF grid
+         * :param const uIntType collectionNumber: The collection to place the reference state in ( defaults to 0 )
+         *
+         * If the output queue is asynchronous the response is recorded in a buffer which is written to the file
+         * by the writer thread while the next increment is processed.
          */
 
-        //Initialize the writer
-        shared_ptr< XdmfHDF5Writer > heavyWriter = XdmfHDF5Writer::New( filename + ".h5", false );
-        heavyWriter->setReleaseData( true );
-        shared_ptr< XdmfWriter > writer = XdmfWriter::New( filename + ".xdmf", heavyWriter );
+        //Get the writer
+        std::shared_ptr< dataFileInterface::dataFileBase > targetWriter;
+        errorOut error = getHomogenizedResponseWriter( targetWriter );
 
-        shared_ptr< XdmfAttribute > _A = XdmfAttribute::New( );
-        _A->setName( matrixName );
+        if ( error ){
 
-        shared_ptr< XdmfInformation > A_info
-            = XdmfInformation::New( matrixName + "_shape",
-                                    std::to_string( A.rows( ) ) + "," + std::to_string( A.cols( ) ) );
-        _A->insert( A_info );
-        _A->insert( 0, A.data( ), A.size( ), 1, 1 );
-        grid->insert( _A );
+            errorOut result = new errorNode( __func__,
+                                             "Error when initializing the writer" );
+            result->addNext( error );
+            return result;
 
-        domain->accept( writer );
+        }
 
-        return NULL;
+        std::shared_ptr< dataFileInterface::bufferedDataFile > buffer;
+        std::shared_ptr< dataFileInterface::dataFileBase > writer = targetWriter;
 
-    }
+        if ( _outputQueue.isAsynchronous( ) ){
 
-    errorOut writeSparseMatrixToXDMF( const SparseMatrix &A, const std::string matrixName,
-                                      const std::string &filename, shared_ptr< XdmfDomain > &domain,
-                                      shared_ptr< XdmfUnstructuredGrid > &grid ){
-        /*!
-         * Write a sparse matrix to a XDMF file ( not a standard XDMF format )
-         *
-         * :param const SparseMatrix &A: The matrix to write
-         * :param const std::string matrixName: The name of the matrix MUST BE UNIQUE IN THE OUTPUT FILE
-         * :param const std::string &filename: The name of the output file
-         * :param shared_ptr< XdmfDomain > &domain: The XDMF domain
-         * :param shared_ptr< XdmfDomain > &grid: The XDMF grid
-         */
+            buffer = std::make_shared< dataFileInterface::bufferedDataFile >( );
+            writer = buffer;
+
+        }
+
+        const floatType *time;
+
+        if ( _inputProcessor.isFiltering( ) ){
+
+            time = _inputProcessor.getMicroTime( );
+
+        }
+        else{
+
+            time = _inputProcessor.getMacroTime( );
+
+        }
+
+        uIntType increment;
+        error = writer->initializeIncrement( *time, _currentReferenceOutputIncrement, collectionNumber, increment );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__,
+                                             "Error in the initialization of the increment for the homogenized output" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        //Write the mesh data to file. This increment references a previous increment for the mesh data so we don't need to do it again
+        error = writer->writeIncrementMeshData( increment, collectionNumber, { }, { { } }, { }, { }, { }, { { } }, { }, { } );
+
+        if ( error ){
+
+            errorOut result = new errorNode( __func__,
+                                             "Error in the initialization of the mesh data for the homogenized output" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        //Assemble the macro-scale cell ids
+        const uIntVector cellIds = vectorTools::appendVectors( { *_inputProcessor.getFreeMacroCellIds( ),
+                                                                 *_inputProcessor.getGhostMacroCellIds( ) } );
+
+        //Determine the maximum number of quadrature points
+        uIntType maxQP = 0;
+        for ( auto cellId = cellIds.begin( ); cellId != cellIds.end( ); cellId++ ){
+
+            maxQP = std::max( ( uIntType )quadraturePointDensities[ *cellId ].size( ), maxQP );
+
+        }
+
+        //Assemble the projected displacement vectors
+        floatVector projectedMacroDisplacement;
+        if ( !_currentReferenceOutputIncrement ){
+
+            projectedMacroDisplacement
+                = vectorTools::appendVectors(
+                    {
+                        floatVector( ( _dim + _dim * _dim ) * _inputProcessor.getFreeMacroNodeIds( )->size( ), 0 ),
+                        _projected_ghost_macro_displacement
+                    } );
+
+        }
+        else{
+
+            projectedMacroDisplacement =
+                vectorTools::appendVectors( { _updatedFreeMacroDispDOFValues, _projected_ghost_macro_displacement } );
+
+        }
+
+        //Loop over the macro displacement degrees of freedom
+        stringVector node_dof_names( _dim + _dim * _dim );
+        for ( unsigned int dof_i = 0; dof_i < ( _dim + _dim * _dim ); dof_i++ ){
+
+            node_dof_names[ dof_i ] = "NODE_DOF_" + std::to_string( dof_i + 1 );
+
+        }
+
+        
+        error = writer->writeSolutionData( increment, collectionNumber, node_dof_names, "Node", projectedMacroDisplacement );
 
-        //Initialize the writer
-        shared_ptr< XdmfHDF5Writer > heavyWriter = XdmfHDF5Writer::New( filename + ".h5", false );
-        heavyWriter->setReleaseData( true );
-        shared_ptr< XdmfWriter > writer = XdmfWriter::New( filename + ".xdmf", heavyWriter );
+        if ( error ){
 
-        shared_ptr< XdmfAttribute > _A = XdmfAttribute::New( );
-        _A->setName( matrixName );
-        shared_ptr< XdmfInformation > _A_info
-            = XdmfInformation::New( matrixName + "_shape",
-                                    std::to_string( A.rows( ) ) + "," + std::to_string( A.cols( ) ) );
-        _A->insert( _A_info );
-        grid->insert( _A );
+            errorOut result = new errorNode( __func__, "Error in writing the nodal DOF solution data" );
+            result->addNext( error );
+            return result;
 
-        uIntVector rowIndices, colIndices;
-        uIntType nonZeros = A.nonZeros( );
-        rowIndices.reserve( nonZeros );
-        colIndices.reserve( nonZeros );
+        }
 
-        floatVector values;
-        values.reserve( nonZeros );
+        //Loop over the quadrature points
+        for ( unsigned int qp = 0; qp < maxQP; qp++ ){
 
-        for (int k=0; k < A.outerSize(); ++k) {
+            floatVector densityOut(                                      cellIds.size( ), 0 );
+            floatVector bodyForceOut(                             _dim * cellIds.size( ), 0 );
+            floatVector positionOut(                              _dim * cellIds.size( ), 0 );
+            floatVector accelerationsOut(                         _dim * cellIds.size( ), 0 );
+            floatVector microInertiasOut(                  _dim * _dim * cellIds.size( ), 0 );
+            floatVector bodyCouplesOut(                    _dim * _dim * cellIds.size( ), 0 );
+            floatVector microSpinInertiasOut(              _dim * _dim * cellIds.size( ), 0 );
+            floatVector symmetricMicroStressOut(           _dim * _dim * cellIds.size( ), 0 );
+            floatVector cauchyStressOut(                   _dim * _dim * cellIds.size( ), 0 );
+            floatVector higherOrderStressOut(       _dim * _dim * _dim * cellIds.size( ), 0 );
+            floatVector dofValuesOut(           ( _dim + _dim * _dim ) * cellIds.size( ), 0 );
+            floatVector dofGradientsOut( _dim * ( _dim + _dim * _dim ) * cellIds.size( ), 0 );
 
-            for (SparseMatrix::InnerIterator it(A,k); it; ++it){
+            floatVector elementDofValuesOut(                      ( _dim + _dim * _dim ), 0 );
+            floatVector elementDofGradientsOut(            _dim * ( _dim + _dim * _dim ), 0 );
 
-                rowIndices.push_back( it.row( ) );
-                colIndices.push_back( it.col( ) );
-                values.push_back( it.value( ) );
+            //Loop over the cells
+            for ( auto cellId = cellIds.begin( ); cellId != cellIds.end( ); cellId++ ){
 
-            }
+                //Set the cell index
+                uIntType index = cellId - cellIds.begin( );
 
-        }
+                //Determine the number of quadrature points for the cell
+                uIntType cellQP = quadraturePointDensities[ *cellId ].size( );
 
-        shared_ptr< XdmfAttribute > _A_rows = XdmfAttribute::New( );
-        _A_rows->setName( matrixName + "_rows" );
-        _A_rows->insert( 0, rowIndices.data( ), rowIndices.size( ), 1, 1 );
-        grid->insert( _A_rows );
+                if ( qp >= cellQP ){
 
-        shared_ptr< XdmfAttribute > _A_cols = XdmfAttribute::New( );
-        _A_cols->setName( matrixName + "_cols" );
-        _A_cols->insert( 0, colIndices.data( ), colIndices.size( ), 1, 1 );
-        grid->insert( _A_cols );
+                    //If the current quadrature point is too big then skip the element
+                    continue;
 
-        shared_ptr< XdmfAttribute > _A_values = XdmfAttribute::New( );
-        _A_values->setName( matrixName + "_values" );
-        _A_values->insert( 0, values.data( ), values.size( ), 1, 1 );
-        grid->insert( _A_values );
+                }
 
-        domain->accept( writer );
-        return NULL;
-    }
+                //Set the outputs for the current quadrature point
+                densityOut[ index ] = quadraturePointDensities[ *cellId ][ qp ];
 
-    errorOut readDenseMatrixFromXDMF( const shared_ptr< XdmfUnstructuredGrid > &grid, const std::string &matrixName, Eigen::MatrixXd &A ){
-        /*!
-         * Read a dense matrix from a XDMF file attribute. This is not a standard use of a XDMF file.
-         *
-         * NOTE: Assumes default Eigen storage ( column major );
-         *
-         * :param const shared_ptr< XdmfUnstructuredGrid > &grid: The pointer to the grid object that contains the matrix
-         * :param const std::string &matrixName: The name of the matrix
-         * :param Eigen::MatrixXdx &A: The re-constructed matrix
-         */
+                for ( unsigned int i = 0; i < _dim; i++ ){
 
-        shared_ptr< XdmfAttribute > _A = grid->getAttribute( matrixName );
+                    bodyForceOut[ _dim * index + i ] 
+                        = quadraturePointBodyForce[     *cellId ][        _dim * qp + i ];
+                    accelerationsOut[ _dim * index + i ] 
+                        = quadraturePointAccelerations[ *cellId ][        _dim * qp + i ];
 
-        if ( !_A ){
+                }
 
-            std::string outstr = matrixName;
-            outstr += " does not appear as an attribute in the provided grid\n";
-            return new errorNode( __func__, outstr );
+                for ( unsigned int i = 0; i < _dim * _dim; i++ ){
 
-        }
+                    microInertiasOut[ _dim * _dim * index + i ]
+                        = quadraturePointMicroInertias[ *cellId ][ _dim * _dim * qp + i ];
+                    bodyCouplesOut[ _dim * _dim * index + i ]
+                        = quadraturePointBodyCouples[        *cellId ][ _dim * _dim * qp + i ];
+                    microSpinInertiasOut[ _dim * _dim * index + i ]
+                        = quadraturePointMicroSpinInertias[ *cellId ][ _dim * _dim * qp + i ];
+                    symmetricMicroStressOut[ _dim * _dim * index + i ]
+                        = quadraturePointSymmetricMicroStress[ *cellId ][ _dim * _dim * qp + i ];
+                    cauchyStressOut[ _dim * _dim * index + i ]
+                        = quadraturePointCauchyStress[ *cellId ][ _dim * _dim * qp + i ];
 
-        shared_ptr< XdmfInformation > shapeInfo = _A->getInformation( 0 );
+                }
 
-        if ( !shapeInfo ){
+                for ( unsigned int i = 0; i < _dim * _dim * _dim; i++ ){
 
-            std::string outstr = "There is no information defined for the matrix " + matrixName;
-            return new errorNode( __func__, outstr );
+                    higherOrderStressOut[ _dim * _dim * _dim * index + i ]
+                        = quadraturePointHigherOrderStress[ *cellId ][ _dim * _dim * _dim * qp + i ];
 
-        }
+                }
 
-        if ( shapeInfo->getKey( ).compare( matrixName + "_shape" ) != 0 ){
+                //Form the element
+                elib::Element *element;
 
-            std::string outstr = matrixName;
-            outstr += "_shape is not in the information key";
-            return new errorNode( __func__, outstr );
+                if ( _inputProcessor.isFiltering( ) ){
+        
+                    std::unordered_map< uIntType, floatVector > projectedMacroDisplacements;
+        
+                    auto cellConnectivity = _inputProcessor.getMacroNodeReferenceConnectivity( )->find( *cellId );
+        
+                    if ( cellConnectivity == _inputProcessor.getMacroNodeReferenceConnectivity( )->end( ) ){
+        
+                        return new errorNode( __func__, "Macro cell " + std::to_string( *cellId ) + " not found in connectivity map" );
+        
+                    }
+    
+                    auto macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+    
+                    unsigned int nMacroDOF = _dim + _dim * _dim;
+    
+                    for ( auto node = cellConnectivity->second.begin( ) + 1; node != cellConnectivity->second.end( ); node++ ){
+    
+                        auto local_node = macroGlobalToLocalDOFMap->find( *node );
+    
+                        if ( local_node == macroGlobalToLocalDOFMap->end( ) ){
+    
+                            return new errorNode( __func__, "Micro node " + std::to_string( *node) + " not found in the global to local map" );
+    
+                        }
+    
+                        projectedMacroDisplacements.emplace( *node, floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second,
+                                                                                 _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second + 3 ) );
+    
+                    }
 
-        }
+                    error = getMacroDomainElement( *cellId,
+                                                   *_inputProcessor.getMacroNodeReferencePositions( ),
+                                                   projectedMacroDisplacements,
+                                                   *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                                   element );
 
-        std::string matrixDimensionString = shapeInfo->getValue( );
+                }
+                else{
 
-        //Extract the rows and columns
-        uIntType rows = std::stoi( matrixDimensionString.substr( 0, matrixDimensionString.find( "," ) ) );
-        uIntType cols = std::stoi( matrixDimensionString.substr( matrixDimensionString.find( "," ) + 1, matrixDimensionString.size( ) ) );
+                    error = getMacroDomainElement( *cellId,
+                                                   *_inputProcessor.getMacroNodeReferencePositions( ),
+                                                   *_inputProcessor.getMacroDisplacements( ),
+                                                   *_inputProcessor.getMacroNodeReferenceConnectivity( ),
+                                                   element );
 
-        _A->read( );
+                }
 
-        //Initialize the matrix
-        A = Eigen::MatrixXd( rows, cols );
+                //Compute the quadrature point position
+                floatVector qpPosition;
+                error = element->interpolate( element->nodes, element->qrule[ qp ].first, qpPosition );
+                
+                if ( error ){
+                
+                    errorOut result = new errorNode( __func__, "Error in the computation of the gauss point location" );
+                    result->addNext( error );
+                    return result;
+                
+                }
+                
+                for ( unsigned int i = 0; i < _dim; i++ ){
+                
+                    positionOut[ _dim * index + i ] = qpPosition[ i ];
+                
+                }
 
-        for ( unsigned int i = 0; i < cols; i++ ){
-            for ( unsigned int j = 0; j < rows; j++ ){
-                A( j, i ) = _A->getValue< floatType >( rows * i + j );
-            }
-        }
+                //Build the DOF vector
+                floatMatrix dofMatrix( element->qrule.size( ), floatVector( _dim + _dim * _dim, 0 ) );
 
-        return NULL;
-    }
+                for ( auto node = element->global_node_ids.begin( ); node != element->global_node_ids.end( ); node++ ){
 
-    errorOut readSparseMatrixFromXDMF( const shared_ptr< XdmfUnstructuredGrid > &grid, const std::string &matrixName, SparseMatrix &A ){
-        /*!
-         * Read a sparse matrix from a XDMF file attribute. This is not a standard use of a XDMF file.
-         *
-         * :param const shared_ptr< XdmfUnstructuredGrid > &grid: The pointer to the grid object that contains the matrix
-         * :param const std::string &matrixName: The name of the matrix
-         * :param SparseMatrix &A: The re-constructed sparse matrix
-         */
+                    auto localNode = _inputProcessor.getMacroGlobalToLocalDOFMap( )->find( *node );
 
-        shared_ptr< XdmfAttribute > _A = grid->getAttribute( matrixName );
+                    if ( localNode == _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( ) ){
 
-        if ( !_A ){
+                        return new errorNode( __func__,
+                                              "Error in finding the global node " + std::to_string( *node ) +
+                                              " in the macro global to local DOF map" );
 
-            std::string outstr = matrixName;
-            outstr += " does not appear as an attribute in the provided grid\n";
-            return new errorNode( __func__, outstr );
+                    }
 
-        }
+                    dofMatrix[ node - element->global_node_ids.begin( ) ] =
+                        floatVector( projectedMacroDisplacement.begin( ) + ( _dim + _dim * _dim ) * localNode->second,
+                                     projectedMacroDisplacement.begin( ) + ( _dim + _dim * _dim ) * ( localNode->second + 1 ) );
 
-        shared_ptr< XdmfInformation > shapeInfo = _A->getInformation( 0 );
+                }
 
-        if ( !shapeInfo ){
+                error = element->interpolate( dofMatrix, element->qrule[ qp ].first, elementDofValuesOut );
 
-            std::string outstr = "There is no information defined for the SparseMatrix " + matrixName;
-            return new errorNode( __func__, outstr );
+                if ( error ){
 
-        }
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the interpolation of the DOF values" );
+                    result->addNext( error );
+                    return result;
 
-        if ( shapeInfo->getKey( ).compare( matrixName + "_shape" ) != 0 ){
+                }
 
-            std::string outstr = matrixName;
-            outstr += "_shape is not in the information key";
-            return new errorNode( __func__, outstr );
+                // Load the Dof values
+                for ( unsigned int i = 0; i < elementDofValuesOut.size( ); i++ ){
 
-        }
+                    dofValuesOut[ elementDofValuesOut.size( ) * index + i ] = elementDofValuesOut[ i ];
 
-        std::string matrixDimensionString = shapeInfo->getValue( );
+                }
 
-        //Extract the rows and cols
-        uIntType rows = std::stoi( matrixDimensionString.substr( 0, matrixDimensionString.find( "," ) ) );
-        uIntType cols = std::stoi( matrixDimensionString.substr( matrixDimensionString.find( "," ) + 1, matrixDimensionString.size( ) ) );
+                floatMatrix qptDOFGradient;
 
-        //Construct the triplet vector
-        shared_ptr< XdmfAttribute > _rows = grid->getAttribute( matrixName + "_rows" );
+                error = element->get_global_gradient( dofMatrix, element->qrule[ qp ].first, element->reference_nodes, qptDOFGradient );
 
-        if ( !_rows ){
+                if ( error ){
+
+                    errorOut result = new errorNode( __func__,
+                                                     "Error in the interpolation of the DOF values" );
+                    result->addNext( error );
+                    return result;
+
+                }
+
+                elementDofGradientsOut = vectorTools::appendVectors( qptDOFGradient );
 
-            std::string outstr = matrixName;
-            outstr += "_rows attribute is not found";
-            return new errorNode( __func__, outstr );
+                // Load the gradients of the DOF values
+                for ( unsigned int i = 0; i < elementDofGradientsOut.size( ); i++ ){
 
-        }
+                    dofGradientsOut[ elementDofGradientsOut.size( ) * index + i ] = elementDofGradientsOut[ i ];
 
-        shared_ptr< XdmfAttribute > _cols = grid->getAttribute( matrixName + "_cols" );
+                }
 
-        if ( !_cols ){
+            }
 
-            std::string outstr = matrixName;
-            outstr += "_cols attribute is not found";
-            return new errorNode( __func__, outstr );
+            //Write quadrature point information to file
+            stringVector outputNames = { "density_" + std::to_string( qp ) };
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", densityOut );
 
-        }
+            if ( error ){
 
-        shared_ptr< XdmfAttribute > _vals = grid->getAttribute( matrixName + "_values" );
+                errorOut result = new errorNode( __func__, "Error in outputting the density" );
+                result->addNext( error );
+                return result;
 
-        if ( !_cols ){
+            }
 
-            std::string outstr = matrixName;
-            outstr += "_values attribute is not found";
-            return new errorNode( __func__, outstr );
+            outputNames = stringVector( _dim );
 
-        }
+            for ( unsigned int i = 0; i < _dim; i++ ){
 
-        if ( ( _rows->getSize( ) != _cols->getSize( ) ) && ( _rows->getSize( ) != _vals->getSize( ) ) ){
+                outputNames[ i ] = "acceleration_" + std::to_string( i + 1 ) + "_" + std::to_string( qp );
 
-            std::string outstr = matrixName;
-            outstr += " attributes rows, cols, and values don't have consistent sizes";
-            return new errorNode( __func__, outstr );
+            }
 
-        }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", accelerationsOut );
 
-        _rows->read( );
-        _cols->read( );
-        _vals->read( );
+            if ( error ){
 
-        tripletVector triplets;
-        triplets.reserve( _rows->getSize( ) );
+                errorOut result = new errorNode( __func__, "Error in outputting the acceleration" );
+                result->addNext( error );
+                return result;
 
-        for ( uIntType i = 0; i != _rows->getSize( ); i++ ){
+            }
 
-            uIntType _r = _rows->getValue< uIntType >( i );
-            uIntType _c = _cols->getValue< uIntType >( i );
-            floatType _v = _vals->getValue< floatType >( i );
+            outputNames = stringVector( _dim );
+            for ( unsigned int i = 0; i < _dim; i++ ){
 
-            triplets.push_back( DOFProjection::T( _r, _c, _v ) );
+                outputNames[ i ] = "body_force_" + std::to_string( i + 1 ) + "_" + std::to_string( qp );
 
-        }
+            }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", bodyForceOut );
 
-        A = SparseMatrix( rows, cols );
-        A.setFromTriplets( triplets.begin( ), triplets.end( ) );
+            if ( error ){
 
-        return NULL;
+                errorOut result = new errorNode( __func__, "Error in outputting the body force" );
+                result->addNext( error );
+                return result;
 
-    }
+            }
 
-    errorOut overlapCoupling::extractProjectionMatricesFromFile( ){
-        /*!
-         * Extract the projection matrices from the storage file
-         */
+            outputNames = stringVector( _dim );
+            for ( unsigned int i = 0; i < _dim; i++ ){
+            
+                outputNames[ i ] = "position_" + std::to_string( i + 1 ) + "_" + std::to_string( qp );
+            
+            }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", positionOut );
+            
+            if ( error ){
+            
+                errorOut result = new errorNode( __func__, "Error in outputting the gauss point position" );
+                result->addNext( error );
+                return result;
+            
+            }
 
-        //Set the filename
-        YAML::Node config = _inputProcessor.getCouplingInitialization( );
-        std::string filename = config[ "reference_filename" ].as< std::string >( );
+            outputNames = stringVector( _dim * _dim );
+            for ( unsigned int i = 0; i < _dim; i++ ){
 
-        //Initialize the XDMF reader
-        shared_ptr< XdmfReader > reader = XdmfReader::New( );
-        shared_ptr< XdmfDomain > _readDomain = shared_dynamic_cast< XdmfDomain >( reader->read( filename ) );
-        shared_ptr< XdmfUnstructuredGrid > _readGrid = _readDomain->getUnstructuredGrid( 0 );
+                for ( unsigned int j = 0; j < _dim; j++ ){
 
-        std::string projectionType = config[ "type" ].as< std::string >( );
+                    outputNames[ _dim * i + j ] = "micro_inertia_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
 
-        errorOut error = readSparseMatrixFromXDMF( _readGrid, "centerOfMassInterpolator", _centerOfMassN );
+                }
 
-        if ( error ){
+            }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", microInertiasOut );
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in extracting the center of mass interpolation" );
-            result->addNext( error );
-            return result;
+            if ( error ){
 
-        }
+                errorOut result = new errorNode( __func__, "Error in outputting the micro inertias" );
+                result->addNext( error );
+                return result;
 
-        error = readDenseMatrixFromXDMF( _readGrid, "centerOfMassProjector", _centerOfMassProjector );
+            }
 
-        if ( error ){
+            outputNames = stringVector( _dim * _dim );
+            for ( unsigned int i = 0; i < _dim; i++ ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in extracting the center of mass projector" );
-            result->addNext( error );
-            return result;
+                for ( unsigned int j = 0; j < _dim; j++ ){
 
-        }
+                    outputNames[ _dim * i + j ] = "body_couple_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
 
-        if ( ( projectionType.compare( "l2_projection" ) ) ) {
+                }
 
-            error = readDenseMatrixFromXDMF( _readGrid, "BQhatQ", _dense_BQhatQ );
+            }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", bodyCouplesOut );
 
             if ( error ){
 
-                errorOut result
-                    = new errorNode( __func__, "Error when extracting BQhatQ from the XDMF file" );
+                errorOut result = new errorNode( __func__, "Error in outputting the body couples" );
                 result->addNext( error );
                 return result;
 
             }
 
-            error = readDenseMatrixFromXDMF( _readGrid, "BQhatD", _dense_BQhatD );
+            outputNames = stringVector( _dim * _dim );
+            for ( unsigned int i = 0; i < _dim; i++ ){
+
+                for ( unsigned int j = 0; j < _dim; j++ ){
+
+                    outputNames[ _dim * i + j ] = "micro_spin_inertia_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+
+                }
+
+            }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", microSpinInertiasOut );
 
             if ( error ){
 
-                errorOut result
-                    = new errorNode( __func__, "Error when extracting BQhatD from the XDMF file" );
+                errorOut result = new errorNode( __func__, "Error in outputting the body couples" );
                 result->addNext( error );
                 return result;
 
             }
 
-            error = readDenseMatrixFromXDMF( _readGrid, "BDhatQ", _dense_BDhatQ );
+            outputNames = stringVector( _dim * _dim );
+            for ( unsigned int i = 0; i < _dim; i++ ){
+
+                for ( unsigned int j = 0; j < _dim; j++ ){
+
+                    outputNames[ _dim * i + j ] = "symmetric_micro_stress_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+
+                }
+
+            }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", symmetricMicroStressOut );
 
             if ( error ){
 
-                errorOut result
-                    = new errorNode( __func__, "Error when extracting BDhatQ from the XDMF file" );
+                errorOut result = new errorNode( __func__, "Error in outputting the symmetric micro stress" );
                 result->addNext( error );
                 return result;
 
             }
 
-            error = readDenseMatrixFromXDMF( _readGrid, "BDhatD", _dense_BDhatD );
+            outputNames = stringVector( _dim * _dim );
+            for ( unsigned int i = 0; i < _dim; i++ ){
+
+                for ( unsigned int j = 0; j < _dim; j++ ){
+
+                    outputNames[ _dim * i + j ] = "cauchy_stress_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+
+                }
+
+            }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", cauchyStressOut );
 
             if ( error ){
 
-                errorOut result
-                    = new errorNode( __func__, "Error when extracting BDhatD from the XDMF file" );
+                errorOut result = new errorNode( __func__, "Error in outputting the cauchy stress" );
                 result->addNext( error );
                 return result;
 
             }
 
-        }
-        else if ( ( projectionType.compare( "direct_projection" ) ) || ( projectionType.compare( "averaged_l2_projection" ) ) ){
+            outputNames = stringVector( _dim * _dim * _dim );
+            for ( unsigned int i = 0; i < _dim; i++ ){
 
-            error = readSparseMatrixFromXDMF( _readGrid, "BQhatQ", _sparse_BQhatQ );
+                for ( unsigned int j = 0; j < _dim; j++ ){
+
+                    for ( unsigned int k = 0; k < _dim; k++ ){
+
+                        outputNames[ _dim * _dim * i + _dim * j + k ] = "higher_order_stress_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + std::to_string( k + 1 ) + "_" + std::to_string( qp );
+
+                    }
+
+                }
+
+            }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", higherOrderStressOut );
 
             if ( error ){
 
-                errorOut result
-                    = new errorNode( __func__, "Error when extracting BQhatQ from the XDMF file" );
+                errorOut result = new errorNode( __func__, "Error in outputting the higher order stress" );
                 result->addNext( error );
                 return result;
 
             }
 
-            error = readSparseMatrixFromXDMF( _readGrid, "BQhatD", _sparse_BQhatD );
+            outputNames = stringVector( _dim + _dim * _dim );
+            for ( unsigned int i = 0; i < ( _dim + _dim * _dim ); i++ ){
+
+                    outputNames[ i ] = "DOF_" + std::to_string( i + 1 ) + "_" + std::to_string( qp );
+
+            }
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", dofValuesOut );
 
             if ( error ){
 
-                errorOut result
-                    = new errorNode( __func__, "Error when extracting BQhatD from the XDMF file" );
+                errorOut result = new errorNode( __func__, "Error in outputting the degree of freedom values" );
                 result->addNext( error );
                 return result;
 
             }
 
-            error = readSparseMatrixFromXDMF( _readGrid, "BDhatQ", _sparse_BDhatQ );
+            outputNames = stringVector( _dim * ( _dim + _dim * _dim ) );
+            for ( unsigned int i = 0; i < ( _dim + _dim * _dim ); i++ ){
 
-            if ( error ){
+                for ( unsigned int j = 0; j < _dim; j++ ){
 
-                errorOut result
-                    = new errorNode( __func__, "Error when extracting BDhatQ from the XDMF file" );
-                result->addNext( error );
-                return result;
+                    outputNames[ _dim * i + j ]
+                        = "DOF_" + std::to_string( i + 1 ) + "," + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+
+                }
 
             }
 
-            error = readSparseMatrixFromXDMF( _readGrid, "BDhatD", _sparse_BDhatD );
+            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", dofGradientsOut );
 
             if ( error ){
 
-                errorOut result
-                    = new errorNode( __func__, "Error when extracting BDhatD from the XDMF file" );
+                errorOut result = new errorNode( __func__, "Error in outputting the degree of freedom values" );
                 result->addNext( error );
                 return result;
 
             }
 
         }
-        else{
 
-            return new errorNode( __func__, "Not implemented" );
+        if ( buffer ){
 
-        }
+            //Hand the buffer over to the writer thread
+            writer.reset( );
+            bool flushEachIncrement
+                = _inputProcessor.getCouplingInitialization( )[ "output_homogenized_response" ][ "flush_each_increment" ].as< bool >( );
 
-        return NULL;
+            error = _outputQueue.push( [ buffer, targetWriter, flushEachIncrement ]( ) -> errorOut{
 
-    }
+                errorOut error = buffer->replay( *targetWriter );
 
-    errorOut overlapCoupling::outputHomogenizedResponse( const uIntType collectionNumber ){
-        /*!
-         * Output the homogenized response to the data file
-         *
-         * :param const uIntType collectionNumber: The collection to place the reference state in ( defaults to 0 )
-         */
+                if ( error ){
 
-        //Get the configuration
-        const YAML::Node config = _inputProcessor.getCouplingInitialization( );
+                    errorOut result = new errorNode( "outputHomogenizedResponse", "Error in writing the buffered homogenized response" );
+                    result->addNext( error );
+                    return result;
 
-        //Form the writer
-        std::shared_ptr< dataFileInterface::dataFileBase > writer
-            = dataFileInterface::dataFileBase( config[ "output_homogenized_response" ] ).create( );
+                }
 
-        if ( writer->_error ){
+                if ( flushEachIncrement ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error when initializing the writer" );
-            result->addNext( writer->_error );
-            return result;
+                    return targetWriter->flush( );
 
-        }
+                }
 
-        const floatType *time;
+                return NULL;
 
-        if ( _inputProcessor.isFiltering( ) ){
+            } );
 
-            time = _inputProcessor.getMicroTime( );
+            if ( error ){
 
-        }
-        else{
+                errorOut result = new errorNode( __func__, "Error in queueing the homogenized response" );
+                result->addNext( error );
+                return result;
 
-            time = _inputProcessor.getMacroTime( );
+            }
+
+            return NULL;
 
         }
 
-        uIntType increment;
-        errorOut error = writer->initializeIncrement( *time, _currentReferenceOutputIncrement, collectionNumber, increment );
+        error = flushHomogenizedResponseWriter( );
 
         if ( error ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the initialization of the increment for the homogenized output" );
+            errorOut result = new errorNode( __func__, "Error in flushing the homogenized response to the file" );
             result->addNext( error );
             return result;
 
         }
+        
+        return NULL;
+    }
 
-        //Write the mesh data to file. This increment references a previous increment for the mesh data so we don't need to do it again
-        error = writer->writeIncrementMeshData( increment, collectionNumber, { }, { { } }, { }, { }, { }, { { } }, { }, { } );
+    errorOut overlapCoupling::getHomogenizedResponseWriter( std::shared_ptr< dataFileInterface::dataFileBase > &writer ){
+        /*!
+         * Get the writer of the homogenized response. The writer is formed the first time it is requested and
+         * is then re-used for every increment so that the existing output is not re-read and re-written.
+         *
+         * :param std::shared_ptr< dataFileInterface::dataFileBase > &writer: The writer of the homogenized response
+         */
 
-        if ( error ){
+        if ( !_homogenizedResponseWriter ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in the initialization of the mesh data for the homogenized output" );
-            result->addNext( error );
-            return result;
+            YAML::Node config = _inputProcessor.getCouplingInitialization( )[ "output_homogenized_response" ];
 
-        }
+            std::shared_ptr< dataFileInterface::dataFileBase > newWriter = dataFileInterface::dataFileBase( config ).create( );
 
-        //Assemble the macro-scale cell ids
-        const uIntVector cellIds = vectorTools::appendVectors( { *_inputProcessor.getFreeMacroCellIds( ),
-                                                                 *_inputProcessor.getGhostMacroCellIds( ) } );
+            if ( newWriter->_error ){
 
-        //Determine the maximum number of quadrature points
-        uIntType maxQP = 0;
-        for ( auto cellId = cellIds.begin( ); cellId != cellIds.end( ); cellId++ ){
+                errorOut result = new errorNode( __func__, "Error in construction of the homogenized response writer" );
+                result->addNext( newWriter->_error );
+                return result;
 
-            maxQP = std::max( ( uIntType )quadraturePointDensities[ *cellId ].size( ), maxQP );
+            }
+
+            _homogenizedResponseWriter = newWriter;
 
         }
 
-        //Assemble the projected displacement vectors
-        floatVector projectedMacroDisplacement;
-        if ( !_currentReferenceOutputIncrement ){
+        writer = _homogenizedResponseWriter;
 
-            projectedMacroDisplacement
-                = vectorTools::appendVectors(
-                    {
-                        floatVector( ( _dim + _dim * _dim ) * _inputProcessor.getFreeMacroNodeIds( )->size( ), 0 ),
-                        _projected_ghost_macro_displacement
-                    } );
+        return NULL;
 
-        }
-        else{
+    }
 
-            projectedMacroDisplacement =
-                vectorTools::appendVectors( { _updatedFreeMacroDispDOFValues, _projected_ghost_macro_displacement } );
+    errorOut overlapCoupling::flushHomogenizedResponseWriter( ){
+        /*!
+         * Write the changes held by the homogenized response writer to the file if the output is to be
+         * flushed every increment. Otherwise the output is written when the writer is destroyed.
+         */
+
+        if ( !_homogenizedResponseWriter ){
+
+            return NULL;
 
         }
 
-        //Loop over the macro displacement degrees of freedom
-        stringVector node_dof_names( _dim + _dim * _dim );
-        for ( unsigned int dof_i = 0; dof_i < ( _dim + _dim * _dim ); dof_i++ ){
+        if ( !_inputProcessor.getCouplingInitialization( )[ "output_homogenized_response" ][ "flush_each_increment" ].as< bool >( ) ){
 
-            node_dof_names[ dof_i ] = "NODE_DOF_" + std::to_string( dof_i + 1 );
+            return NULL;
 
         }
 
-        
-        error = writer->writeSolutionData( increment, collectionNumber, node_dof_names, "Node", projectedMacroDisplacement );
+        return _homogenizedResponseWriter->flush( );
+
+    }
+
+    errorOut overlapCoupling::writeReferenceMeshDataToFile( const uIntType collectionNumber ){
+        /*!
+         * Write the reference mesh data to the output file
+         *
+         * :param const uIntType collectionNumber: The collection to place the reference state in ( defaults to 0 )
+         */
+
+        //Get the writer object
+        std::shared_ptr< dataFileInterface::dataFileBase > writer;
+        errorOut error = getHomogenizedResponseWriter( writer );
 
         if ( error ){
 
-            errorOut result = new errorNode( __func__, "Error in writing the nodal DOF solution data" );
+            errorOut result = new errorNode( __func__, "Error in construction of writer" );
             result->addNext( error );
             return result;
 
         }
 
-        //Loop over the quadrature points
-        for ( unsigned int qp = 0; qp < maxQP; qp++ ){
+        //Get the free and ghost micro nodes global to local map
+        const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
 
-            floatVector densityOut(                                      cellIds.size( ), 0 );
-            floatVector bodyForceOut(                             _dim * cellIds.size( ), 0 );
-            floatVector positionOut(                              _dim * cellIds.size( ), 0 );
-            floatVector accelerationsOut(                         _dim * cellIds.size( ), 0 );
-            floatVector microInertiasOut(                  _dim * _dim * cellIds.size( ), 0 );
-            floatVector bodyCouplesOut(                    _dim * _dim * cellIds.size( ), 0 );
-            floatVector microSpinInertiasOut(              _dim * _dim * cellIds.size( ), 0 );
-            floatVector symmetricMicroStressOut(           _dim * _dim * cellIds.size( ), 0 );
-            floatVector cauchyStressOut(                   _dim * _dim * cellIds.size( ), 0 );
-            floatVector higherOrderStressOut(       _dim * _dim * _dim * cellIds.size( ), 0 );
-            floatVector dofValuesOut(           ( _dim + _dim * _dim ) * cellIds.size( ), 0 );
-            floatVector dofGradientsOut( _dim * ( _dim + _dim * _dim ) * cellIds.size( ), 0 );
+        //Get the macro node ids
+        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
+        const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
 
-            floatVector elementDofValuesOut(                      ( _dim + _dim * _dim ), 0 );
-            floatVector elementDofGradientsOut(            _dim * ( _dim + _dim * _dim ), 0 );
+        //Get the macro cell ids
+        const uIntVector elementIds = vectorTools::appendVectors( { *_inputProcessor.getFreeMacroCellIds( ),
+                                                                    *_inputProcessor.getGhostMacroCellIds( ) } );
 
-            //Loop over the cells
-            for ( auto cellId = cellIds.begin( ); cellId != cellIds.end( ); cellId++ ){
+        //Get the mesh information
+        const std::unordered_map< uIntType, uIntVector > *macroNodeReferenceConnectivity
+            = _inputProcessor.getMacroNodeReferenceConnectivity( );
 
-                //Set the cell index
-                uIntType index = cellId - cellIds.begin( );
+        //Assemble the mesh data
+        const std::unordered_map< uIntType, floatVector > *macroNodeReferencePositions
+            = _inputProcessor.getMacroNodeReferencePositions( );
+        const std::unordered_map< uIntType, floatVector > *macroDisplacements = _inputProcessor.getMacroDisplacements( );
 
-                //Determine the number of quadrature points for the cell
-                uIntType cellQP = quadraturePointDensities[ *cellId ].size( );
+        //Assemble the node ids
+        uIntVector nodeIds( macroGlobalToLocalDOFMap->size( ) );
 
-                if ( qp >= cellQP ){
+        //Assemble the node position vectors
+        floatVector nodePositions( _dim * macroGlobalToLocalDOFMap->size( ) );
 
-                    //If the current quadrature point is too big then skip the element
-                    continue;
+        for ( auto node  = macroGlobalToLocalDOFMap->begin( );
+                   node != macroGlobalToLocalDOFMap->end( );
+                   node++ ){
 
-                }
+            nodeIds[ node->second ] = node->first;
 
-                //Set the outputs for the current quadrature point
-                densityOut[ index ] = quadraturePointDensities[ *cellId ][ qp ];
+            auto referencePosition = macroNodeReferencePositions->find( node->first );
 
-                for ( unsigned int i = 0; i < _dim; i++ ){
+            if ( referencePosition == macroNodeReferencePositions->end( ) ){
 
-                    bodyForceOut[ _dim * index + i ] 
-                        = quadraturePointBodyForce[     *cellId ][        _dim * qp + i ];
-                    accelerationsOut[ _dim * index + i ] 
-                        = quadraturePointAccelerations[ *cellId ][        _dim * qp + i ];
+                return new errorNode( __func__, "The macro node " + std::to_string( node->first ) +
+                                      " was not found in the reference positions vector" );
 
-                }
+            }
 
-                for ( unsigned int i = 0; i < _dim * _dim; i++ ){
+            auto displacement = macroDisplacements->find( node->first );
 
-                    microInertiasOut[ _dim * _dim * index + i ]
-                        = quadraturePointMicroInertias[ *cellId ][ _dim * _dim * qp + i ];
-                    bodyCouplesOut[ _dim * _dim * index + i ]
-                        = quadraturePointBodyCouples[        *cellId ][ _dim * _dim * qp + i ];
-                    microSpinInertiasOut[ _dim * _dim * index + i ]
-                        = quadraturePointMicroSpinInertias[ *cellId ][ _dim * _dim * qp + i ];
-                    symmetricMicroStressOut[ _dim * _dim * index + i ]
-                        = quadraturePointSymmetricMicroStress[ *cellId ][ _dim * _dim * qp + i ];
-                    cauchyStressOut[ _dim * _dim * index + i ]
-                        = quadraturePointCauchyStress[ *cellId ][ _dim * _dim * qp + i ];
+            if ( displacement == macroDisplacements->end( ) ){
 
-                }
+                return new errorNode( __func__, "The macro node " + std::to_string( node->first ) +
+                                      " was not found in the displacements vector" );
 
-                for ( unsigned int i = 0; i < _dim * _dim * _dim; i++ ){
+            }
 
-                    higherOrderStressOut[ _dim * _dim * _dim * index + i ]
-                        = quadraturePointHigherOrderStress[ *cellId ][ _dim * _dim * _dim * qp + i ];
+            for ( unsigned int i = 0; i < _dim; i++ ){
 
-                }
+                nodePositions[ _dim * node->second + i ] = referencePosition->second[ i ] + displacement->second[ i ];
 
-                //Form the element
-                std::unique_ptr< elib::Element > element;
+            }
 
-                if ( _inputProcessor.isFiltering( ) ){
-        
-                    std::unordered_map< uIntType, floatVector > projectedMacroDisplacements;
-        
-                    auto cellConnectivity = _inputProcessor.getMacroNodeReferenceConnectivity( )->find( *cellId );
-        
-                    if ( cellConnectivity == _inputProcessor.getMacroNodeReferenceConnectivity( )->end( ) ){
-        
-                        return new errorNode( __func__, "Macro cell " + std::to_string( *cellId ) + " not found in connectivity map" );
-        
-                    }
-    
-                    auto macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
-    
-                    unsigned int nMacroDOF = _dim + _dim * _dim;
-    
-                    for ( auto node = cellConnectivity->second.begin( ) + 1; node != cellConnectivity->second.end( ); node++ ){
-    
-                        auto local_node = macroGlobalToLocalDOFMap->find( *node );
-    
-                        if ( local_node == macroGlobalToLocalDOFMap->end( ) ){
-    
-                            return new errorNode( __func__, "Micro node " + std::to_string( *node) + " not found in the global to local map" );
-    
-                        }
-    
-                        projectedMacroDisplacements.emplace( *node, floatVector( _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second,
-                                                                                 _projected_ghost_macro_displacement.begin( ) + nMacroDOF * local_node->second + 3 ) );
-    
-                    }
+        }
+
+        //Assemble the node sets
+        stringVector nodeSetNames = { "free_macro_nodes", "ghost_macro_nodes" };
+        uIntMatrix nodeSets( 2 );
+        nodeSets[ 0 ].resize( freeMacroNodeIds->size( ) );
+        nodeSets[ 1 ].resize( ghostMacroNodeIds->size( ) );
 
-                    error = buildMacroDomainElement( *cellId,
-                                                     *_inputProcessor.getMacroNodeReferencePositions( ),
-                                                     projectedMacroDisplacements,
-                                                     *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                                     element );
+        for ( auto node = freeMacroNodeIds->begin( ); node != freeMacroNodeIds->end( ); node++ ){
 
-                }
-                else{
+            auto localNode = macroGlobalToLocalDOFMap->find( *node );
 
-                    error = buildMacroDomainElement( *cellId,
-                                                     *_inputProcessor.getMacroNodeReferencePositions( ),
-                                                     *_inputProcessor.getMacroDisplacements( ),
-                                                     *_inputProcessor.getMacroNodeReferenceConnectivity( ),
-                                                     element );
+            if ( localNode == macroGlobalToLocalDOFMap->end( ) ){
 
-                }
+                return new errorNode( __func__,
+                                      "The free macro node " + std::to_string( *node ) + " was not found in the macro global to local DOF map" );
 
-                //Compute the quadrature point position
-                floatVector qpPosition;
-                error = element->interpolate( element->nodes, element->qrule[ qp ].first, qpPosition );
-                
-                if ( error ){
-                
-                    errorOut result = new errorNode( __func__, "Error in the computation of the gauss point location" );
-                    result->addNext( error );
-                    return result;
-                
-                }
-                
-                for ( unsigned int i = 0; i < _dim; i++ ){
-                
-                    positionOut[ _dim * index + i ] = qpPosition[ i ];
-                
-                }
+            }
 
-                //Build the DOF vector
-                floatMatrix dofMatrix( element->qrule.size( ), floatVector( _dim + _dim * _dim, 0 ) );
+            nodeSets[ 0 ][ node - freeMacroNodeIds->begin( ) ] = localNode->second;
 
-                for ( auto node = element->global_node_ids.begin( ); node != element->global_node_ids.end( ); node++ ){
+        }
 
-                    auto localNode = _inputProcessor.getMacroGlobalToLocalDOFMap( )->find( *node );
+        for ( auto node = ghostMacroNodeIds->begin( ); node != ghostMacroNodeIds->end( ); node++ ){
 
-                    if ( localNode == _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( ) ){
+            auto localNode = macroGlobalToLocalDOFMap->find( *node );
+
+            if ( localNode == macroGlobalToLocalDOFMap->end( ) ){
+
+                return new errorNode( __func__,
+                                      "The ghost macro node " + std::to_string( *node ) + " was not found in the macro global to local DOF map" );
+
+            }
+
+            nodeSets[ 1 ][ node - ghostMacroNodeIds->begin( ) ] = localNode->second;
+
+        }
+
+        //Assemble the element sets
+        stringVector elementSetNames = { "free_macro_elements", "ghost_macro_elements" };
+        uIntMatrix elementSets( 2 );
+        elementSets[ 0 ].resize( _inputProcessor.getFreeMacroCellIds( )->size( ) );
+        elementSets[ 1 ].resize( _inputProcessor.getGhostMacroCellIds( )->size( ) );
+
+        for ( uIntType i = 0; i < elementSets[ 0 ].size( ); i++ ){
+            elementSets[ 0 ][ i ] = i;
+        }
+
+        for ( uIntType i = 0; i < elementSets[ 1 ].size( ); i++ ){
+            elementSets[ 1 ][ i ] = elementSets[ 0 ].size( ) + i;
+        }
+
+        //Assemble the connectivity vector
+        uIntVector connectivity( 0 );
+        for ( auto cell = elementIds.begin( ); cell != elementIds.end( ); cell++ ){
 
-                        return new errorNode( __func__,
-                                              "Error in finding the global node " + std::to_string( *node ) +
-                                              " in the macro global to local DOF map" );
+            elib::Element *element;
 
-                    }
+            errorOut error = getMacroDomainElement( *cell, *macroNodeReferencePositions, *macroDisplacements,
+                                                    *macroNodeReferenceConnectivity, element );
 
-                    dofMatrix[ node - element->global_node_ids.begin( ) ] =
-                        floatVector( projectedMacroDisplacement.begin( ) + ( _dim + _dim * _dim ) * localNode->second,
-                                     projectedMacroDisplacement.begin( ) + ( _dim + _dim * _dim ) * ( localNode->second + 1 ) );
+            if ( error ){
 
-                }
+                errorOut result = new errorNode( __func__,
+                                                 "Error in construction of the micromorphic element" );
+                result->addNext( error );
+                return result;
 
-                error = element->interpolate( dofMatrix, element->qrule[ qp ].first, elementDofValuesOut );
+            }
 
-                if ( error ){
+            //Get the XDMF cell type
+            auto elementConnectivity = macroNodeReferenceConnectivity->find( *cell );
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the interpolation of the DOF values" );
-                    result->addNext( error );
-                    return result;
+            if ( elementConnectivity == macroNodeReferenceConnectivity->end( ) ){
 
-                }
+                return new errorNode( __func__,
+                                      "Macro cell " + std::to_string( *cell ) + " was not found in the macro mesh connectivity" );
 
-                // Load the Dof values
-                for ( unsigned int i = 0; i < elementDofValuesOut.size( ); i++ ){
+            }
 
-                    dofValuesOut[ elementDofValuesOut.size( ) * index + i ] = elementDofValuesOut[ i ];
+            uIntType cellType = elementConnectivity->second[ 0 ];
 
-                }
+            uIntVector localNodeIds( element->global_node_ids.size( ) + 1 );
+            localNodeIds[ 0 ] = cellType;
 
-                floatMatrix qptDOFGradient;
+            for ( auto gN = element->global_node_ids.begin( ); gN != element->global_node_ids.end( ); gN++ ){
 
-                error = element->get_global_gradient( dofMatrix, element->qrule[ qp ].first, element->reference_nodes, qptDOFGradient );
+                auto node = macroGlobalToLocalDOFMap->find( *gN );
 
-                if ( error ){
+                if ( node == macroGlobalToLocalDOFMap->end( ) ){
 
-                    errorOut result = new errorNode( __func__,
-                                                     "Error in the interpolation of the DOF values" );
-                    result->addNext( error );
-                    return result;
+                    return new errorNode( __func__,
+                                          "The global macro node " + std::to_string( *gN ) +
+                                          " can't be found in the global to local map" );
 
                 }
 
-                elementDofGradientsOut = vectorTools::appendVectors( qptDOFGradient );
+                localNodeIds[ gN - element->global_node_ids.begin( ) + 1 ] = node->second;
 
-                // Load the gradients of the DOF values
-                for ( unsigned int i = 0; i < elementDofGradientsOut.size( ); i++ ){
+            }
 
-                    dofGradientsOut[ elementDofGradientsOut.size( ) * index + i ] = elementDofGradientsOut[ i ];
+            connectivity = vectorTools::appendVectors( { connectivity, localNodeIds } );
 
-                }
+        }
 
-            }
+        const floatType *time = _inputProcessor.getMacroTime( );
 
-            //Write quadrature point information to file
-            stringVector outputNames = { "density_" + std::to_string( qp ) };
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", densityOut );
+        uIntType numIncrements;
+        writer->getNumIncrements( numIncrements );
 
-            if ( error ){
+        error = writer->initializeIncrement( *time, numIncrements, collectionNumber, _currentReferenceOutputIncrement ); 
 
-                errorOut result = new errorNode( __func__, "Error in outputting the density" );
-                result->addNext( error );
-                return result;
+        if ( error ){
 
-            }
+            errorOut result = new errorNode( __func__,
+                                             "Error in initialization of the increment in the writer" );
+            result->addNext( error );
+            return result;
 
-            outputNames = stringVector( _dim );
+        }
 
-            for ( unsigned int i = 0; i < _dim; i++ ){
+        error = writer->writeIncrementMeshData( _currentReferenceOutputIncrement, collectionNumber,
+                                                std::move( nodeIds ), std::move( nodeSets ),
+                                                std::move( nodeSetNames ), std::move( nodePositions ),
+                                                std::move( elementIds ), std::move( elementSets ),
+                                                std::move( elementSetNames ), std::move( connectivity ) );
 
-                outputNames[ i ] = "acceleration_" + std::to_string( i + 1 ) + "_" + std::to_string( qp );
+        if ( error ){
 
-            }
+            errorOut result = new errorNode( __func__,
+                                             "Error in writing the mesh data to a file" );
+            result->addNext( error );
+            return result;
 
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", accelerationsOut );
+        }
 
-            if ( error ){
+        error = flushHomogenizedResponseWriter( );
 
-                errorOut result = new errorNode( __func__, "Error in outputting the acceleration" );
-                result->addNext( error );
-                return result;
+        if ( error ){
 
-            }
+            errorOut result = new errorNode( __func__,
+                                             "Error in flushing the mesh data to the file" );
+            result->addNext( error );
+            return result;
 
-            outputNames = stringVector( _dim );
-            for ( unsigned int i = 0; i < _dim; i++ ){
+        }
 
-                outputNames[ i ] = "body_force_" + std::to_string( i + 1 ) + "_" + std::to_string( qp );
+        return NULL;
 
-            }
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", bodyForceOut );
+    }
 
-            if ( error ){
+    errorOut overlapCoupling::writeUpdatedDOFToFile( const uIntType collectionNumber ){
+        /*!
+         * Write the updated degree of freedom information to a output file
+         *
+         * :param const uIntType collectionNumber: The collection to place the reference state in ( defaults to 0 )
+         */
 
-                errorOut result = new errorNode( __func__, "Error in outputting the body force" );
-                result->addNext( error );
-                return result;
+        //Get the configuration for the writer object
+        YAML::Node config = _inputProcessor.getCouplingInitialization( )[ "output_updated_dof" ];
 
-            }
+        if ( !config ){
 
-            outputNames = stringVector( _dim );
-            for ( unsigned int i = 0; i < _dim; i++ ){
-            
-                outputNames[ i ] = "position_" + std::to_string( i + 1 ) + "_" + std::to_string( qp );
-            
-            }
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", positionOut );
-            
-            if ( error ){
-            
-                errorOut result = new errorNode( __func__, "Error in outputting the gauss point position" );
-                result->addNext( error );
-                return result;
-            
-            }
+            return new errorNode( __func__,
+                                  "'output_updated_dof' is not defined in the configuration file" );
 
-            outputNames = stringVector( _dim * _dim );
-            for ( unsigned int i = 0; i < _dim; i++ ){
+        }
 
-                for ( unsigned int j = 0; j < _dim; j++ ){
+        std::string macro_config_string = "filename: ";
+        macro_config_string += config[ "macroscale_filename" ].as< std::string >( ) + "\n";
+        macro_config_string += "mode: write\n";
+        macro_config_string += "filetype: ";
+        macro_config_string += config[ "macroscale_filetype" ].as< std::string >( ) + "\n";
+        macro_config_string += "append_to_existing_file: false\n";
 
-                    outputNames[ _dim * i + j ] = "micro_inertia_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+        std::string micro_config_string = "filename: ";
+        micro_config_string += config[ "microscale_filename" ].as< std::string >( ) + "\n";
+        micro_config_string += "mode: write\n";
+        micro_config_string += "filetype: ";
+        micro_config_string += config[ "microscale_filetype" ].as< std::string >( ) + "\n";
+        micro_config_string += "append_to_existing_file: false\n";
 
-                }
+        YAML::Node macro_config = YAML::Load( macro_config_string.c_str( ) ); 
+        YAML::Node micro_config = YAML::Load( micro_config_string.c_str( ) ); 
 
-            }
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", microInertiasOut );
+        std::shared_ptr< dataFileInterface::dataFileBase > macro_writer;
+        std::shared_ptr< dataFileInterface::dataFileBase > micro_writer;
 
-            if ( error ){
+        //If the output queue is asynchronous the DOF values are recorded and the files are written by the writer thread
+        std::shared_ptr< dataFileInterface::bufferedDataFile > macro_buffer;
+        std::shared_ptr< dataFileInterface::bufferedDataFile > micro_buffer;
 
-                errorOut result = new errorNode( __func__, "Error in outputting the micro inertias" );
-                result->addNext( error );
-                return result;
+        if ( _outputQueue.isAsynchronous( ) ){
 
-            }
+            macro_buffer = std::make_shared< dataFileInterface::bufferedDataFile >( );
+            micro_buffer = std::make_shared< dataFileInterface::bufferedDataFile >( );
 
-            outputNames = stringVector( _dim * _dim );
-            for ( unsigned int i = 0; i < _dim; i++ ){
+            macro_writer = macro_buffer;
+            micro_writer = micro_buffer;
 
-                for ( unsigned int j = 0; j < _dim; j++ ){
+        }
+        else{
 
-                    outputNames[ _dim * i + j ] = "body_couple_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+            //Form the macro writer object
+            macro_writer = dataFileInterface::dataFileBase( macro_config ).create( );
 
-                }
+            if ( macro_writer->_error ){
+
+                errorOut result = new errorNode( __func__, "Error in construction of writer" );
+                result->addNext( macro_writer->_error );
+                return result;
 
             }
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", bodyCouplesOut );
 
-            if ( error ){
+            //Form the micro writer object
+            micro_writer = dataFileInterface::dataFileBase( micro_config ).create( );
 
-                errorOut result = new errorNode( __func__, "Error in outputting the body couples" );
-                result->addNext( error );
+            if ( micro_writer->_error ){
+
+                errorOut result = new errorNode( __func__, "Error in construction of writer" );
+                result->addNext( micro_writer->_error );
                 return result;
 
             }
 
-            outputNames = stringVector( _dim * _dim );
-            for ( unsigned int i = 0; i < _dim; i++ ){
+        }
 
-                for ( unsigned int j = 0; j < _dim; j++ ){
+        //Write out the macro DOF information
+        floatVector outputDOF = vectorTools::appendVectors( { _updatedFreeMacroDispDOFValues, _projected_ghost_macro_displacement } );
 
-                    outputNames[ _dim * i + j ] = "micro_spin_inertia_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+//        std::cout << "Macroscale\n";
+//        for ( unsigned int i = 0; i < outputDOF.size( ); i++ ){
+//            std::cout << outputDOF[ i ] << " ";
+//            if ( ( ( i + 1 ) % 12 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
 
-                }
+        uIntType increment;
+        errorOut error = macro_writer->initializeIncrement( 1.0, 0, collectionNumber, increment );
 
-            }
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", microSpinInertiasOut );
+        if ( error ){
 
-            if ( error ){
+            errorOut result = new errorNode( __func__, "Error in initializating the increment of the macro output file" );
+            result->addNext( error );
+            return result;
 
-                errorOut result = new errorNode( __func__, "Error in outputting the body couples" );
-                result->addNext( error );
-                return result;
+        }
 
-            }
+        error = macro_writer->writeScalarSolutionData( increment, collectionNumber, "updated_DOF", "Node", std::move( outputDOF ) );
+        
+        if ( error ){
 
-            outputNames = stringVector( _dim * _dim );
-            for ( unsigned int i = 0; i < _dim; i++ ){
+            errorOut result = new errorNode( __func__, "Error in outputting the updated macro DOF to the output file" );
+            result->addNext( error );
+            return result;
 
-                for ( unsigned int j = 0; j < _dim; j++ ){
+        }
 
-                    outputNames[ _dim * i + j ] = "symmetric_micro_stress_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+        floatVector nodeIds( _inputProcessor.getMacroGlobalToLocalDOFMap( )->size( ) );
+        for ( auto node  = _inputProcessor.getMacroGlobalToLocalDOFMap( )->begin( );
+                   node != _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( );
+                   node++ ){
 
-                }
+            nodeIds[ node->second ] = node->first;
 
-            }
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", symmetricMicroStressOut );
+        }
 
-            if ( error ){
+        error = macro_writer->writeScalarSolutionData( increment, collectionNumber, "node_ids", "Node", std::move( nodeIds ) );
 
-                errorOut result = new errorNode( __func__, "Error in outputting the symmetric micro stress" );
-                result->addNext( error );
-                return result;
+        if ( error ){
 
-            }
+            errorOut result = new errorNode( __func__, "Error in outputting the updated node ids to the micro output file" );
+            result->addNext( error );
+            return result;
 
-            outputNames = stringVector( _dim * _dim );
-            for ( unsigned int i = 0; i < _dim; i++ ){
+        }
 
-                for ( unsigned int j = 0; j < _dim; j++ ){
+        //Write out the micro DOF information
+        outputDOF = vectorTools::appendVectors( { _updatedFreeMicroDispDOFValues, _projected_ghost_micro_displacement } );
 
-                    outputNames[ _dim * i + j ] = "cauchy_stress_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+//        std::cout << "\nMicroscale\n";
+//        for ( unsigned int i = 0; i < outputDOF.size( ); i++ ){
+//            std::cout << outputDOF[ i ] << " ";
+//            if ( ( ( i + 1 ) % 3 ) == 0 ){
+//                std::cout << "\n";
+//            }
+//        }
 
-                }
+        error = micro_writer->initializeIncrement( 1.0, 0, collectionNumber, increment );
 
-            }
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", cauchyStressOut );
+        if ( error ){
 
-            if ( error ){
+            errorOut result = new errorNode( __func__, "Error in initializating the increment of the micro output file" );
+            result->addNext( error );
+            return result;
 
-                errorOut result = new errorNode( __func__, "Error in outputting the cauchy stress" );
-                result->addNext( error );
-                return result;
+        }
 
-            }
+        error = micro_writer->writeScalarSolutionData( increment, collectionNumber, "updated_DOF", "Node", std::move( outputDOF ) );
+        
+        if ( error ){
 
-            outputNames = stringVector( _dim * _dim * _dim );
-            for ( unsigned int i = 0; i < _dim; i++ ){
+            errorOut result = new errorNode( __func__, "Error in outputting the updated micro DOF to the output file" );
+            result->addNext( error );
+            return result;
 
-                for ( unsigned int j = 0; j < _dim; j++ ){
+        }
 
-                    for ( unsigned int k = 0; k < _dim; k++ ){
+        nodeIds = floatVector( _inputProcessor.getMicroGlobalToLocalDOFMap( )->size( ) );
+        for ( auto node  = _inputProcessor.getMicroGlobalToLocalDOFMap( )->begin( );
+                   node != _inputProcessor.getMicroGlobalToLocalDOFMap( )->end( );
+                   node++ ){
 
-                        outputNames[ _dim * _dim * i + _dim * j + k ] = "higher_order_stress_" + std::to_string( i + 1 )  + std::to_string( j + 1 ) + std::to_string( k + 1 ) + "_" + std::to_string( qp );
+            nodeIds[ node->second ] = node->first;
 
-                    }
+        }
 
-                }
+        error = micro_writer->writeScalarSolutionData( increment, collectionNumber, "node_ids", "Node", std::move( nodeIds ) );
 
-            }
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", higherOrderStressOut );
+        if ( error ){
 
-            if ( error ){
+            errorOut result = new errorNode( __func__, "Error in outputting the updated node ids to the micro output file" );
+            result->addNext( error );
+            return result;
 
-                errorOut result = new errorNode( __func__, "Error in outputting the higher order stress" );
-                result->addNext( error );
-                return result;
+        }
 
-            }
+        if ( macro_buffer ){
 
-            outputNames = stringVector( _dim + _dim * _dim );
-            for ( unsigned int i = 0; i < ( _dim + _dim * _dim ); i++ ){
+            //Hand the buffers over to the writer thread
+            macro_writer.reset( );
+            micro_writer.reset( );
 
-                    outputNames[ i ] = "DOF_" + std::to_string( i + 1 ) + "_" + std::to_string( qp );
+            error = _outputQueue.push( [ macro_config, micro_config, macro_buffer, micro_buffer ]( ) -> errorOut{
 
-            }
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", dofValuesOut );
+                errorOut error = writeBufferedOutput( macro_config, *macro_buffer );
 
-            if ( error ){
+                if ( error ){
 
-                errorOut result = new errorNode( __func__, "Error in outputting the degree of freedom values" );
-                result->addNext( error );
-                return result;
+                    errorOut result = new errorNode( "writeUpdatedDOFToFile", "Error in writing the updated macro DOF" );
+                    result->addNext( error );
+                    return result;
 
-            }
+                }
 
-            outputNames = stringVector( _dim * ( _dim + _dim * _dim ) );
-            for ( unsigned int i = 0; i < ( _dim + _dim * _dim ); i++ ){
+                error = writeBufferedOutput( micro_config, *micro_buffer );
 
-                for ( unsigned int j = 0; j < _dim; j++ ){
+                if ( error ){
 
-                    outputNames[ _dim * i + j ]
-                        = "DOF_" + std::to_string( i + 1 ) + "," + std::to_string( j + 1 ) + "_" + std::to_string( qp );
+                    errorOut result = new errorNode( "writeUpdatedDOFToFile", "Error in writing the updated micro DOF" );
+                    result->addNext( error );
+                    return result;
 
                 }
 
-            }
+                return NULL;
 
-            error = writer->writeSolutionData( increment, collectionNumber, outputNames, "Cell", dofGradientsOut );
+            } );
 
             if ( error ){
 
-                errorOut result = new errorNode( __func__, "Error in outputting the degree of freedom values" );
+                errorOut result = new errorNode( __func__, "Error in queueing the updated DOF output" );
                 result->addNext( error );
                 return result;
 
             }
 
         }
-        
+
         return NULL;
+
     }
 
-    errorOut overlapCoupling::writeReferenceMeshDataToFile( const uIntType collectionNumber ){
+    errorOut overlapCoupling::writeBufferedOutput( const YAML::Node &config, dataFileInterface::bufferedDataFile &buffer ){
         /*!
-         * Write the reference mesh data to the output file
+         * Form a writer from the configuration and write the recorded output to it
          *
-         * :param const uIntType collectionNumber: The collection to place the reference state in ( defaults to 0 )
+         * :param const YAML::Node &config: The configuration of the writer
+         * :param dataFileInterface::bufferedDataFile &buffer: The recorded output
          */
 
-        YAML::Node config = _inputProcessor.getCouplingInitialization( )[ "output_homogenized_response" ]; 
-
-        //Form a writer object
-        std::shared_ptr< dataFileInterface::dataFileBase > writer
-            = dataFileInterface::dataFileBase( config ).create( );
+        std::shared_ptr< dataFileInterface::dataFileBase > writer = dataFileInterface::dataFileBase( config ).create( );
 
         if ( writer->_error ){
 
@@ -10918,409 +13195,471 @@ namespace overlapCoupling{
 
         }
 
-        //Get the free and ghost micro nodes global to local map
-        const DOFMap *macroGlobalToLocalDOFMap = _inputProcessor.getMacroGlobalToLocalDOFMap( );
+        errorOut error = buffer.replay( *writer );
 
-        //Get the macro node ids
-        const uIntVector *freeMacroNodeIds = _inputProcessor.getFreeMacroNodeIds( );
-        const uIntVector *ghostMacroNodeIds = _inputProcessor.getGhostMacroNodeIds( );
+        if ( error ){
 
-        //Get the macro cell ids
-        const uIntVector elementIds = vectorTools::appendVectors( { *_inputProcessor.getFreeMacroCellIds( ),
-                                                                    *_inputProcessor.getGhostMacroCellIds( ) } );
+            errorOut result = new errorNode( __func__, "Error in writing the recorded output" );
+            result->addNext( error );
+            return result;
 
-        //Get the mesh information
-        const std::unordered_map< uIntType, uIntVector > *macroNodeReferenceConnectivity
-            = _inputProcessor.getMacroNodeReferenceConnectivity( );
+        }
 
-        //Assemble the mesh data
-        const std::unordered_map< uIntType, floatVector > *macroNodeReferencePositions
-            = _inputProcessor.getMacroNodeReferencePositions( );
-        const std::unordered_map< uIntType, floatVector > *macroDisplacements = _inputProcessor.getMacroDisplacements( );
+        return writer->flush( );
 
-        //Assemble the node ids
-        uIntVector nodeIds( macroGlobalToLocalDOFMap->size( ) );
+    }
 
-        //Assemble the node position vectors
-        floatVector nodePositions( _dim * macroGlobalToLocalDOFMap->size( ) );
+    DOFMap overlapCoupling::getMicroGlobalLocalNodeMap( ){
+        /*!
+         * Return a copy of the micro global to local node map
+         */
 
-        for ( auto node  = macroGlobalToLocalDOFMap->begin( );
-                   node != macroGlobalToLocalDOFMap->end( );
-                   node++ ){
+        return *_inputProcessor.getMicroGlobalToLocalDOFMap( );
+    }
 
-            nodeIds[ node->second ] = node->first;
+    DOFMap overlapCoupling::getMacroGlobalLocalNodeMap( ){
+        /*!
+         * Return a copy of the macro global to local node map
+         */
 
-            auto referencePosition = macroNodeReferencePositions->find( node->first );
+        return *_inputProcessor.getMacroGlobalToLocalDOFMap( );
+    }
 
-            if ( referencePosition == macroNodeReferencePositions->end( ) ){
+    floatVector overlapCoupling::getUpdatedMicroDisplacementDOF( ){
+        /*!
+         * Return a copy of the micro displacement dof vector
+         */
 
-                return new errorNode( __func__, "The macro node " + std::to_string( node->first ) +
-                                      " was not found in the reference positions vector" );
+        return vectorTools::appendVectors( { _updatedFreeMicroDispDOFValues, _projected_ghost_micro_displacement } );
+    }
 
-            }
+    floatVector overlapCoupling::getMicroAugmentedLagrangianForce( ){
+        /*!
+         * Get the micro augmented lagrangian force vector
+         */
 
-            auto displacement = macroDisplacements->find( node->first );
+        return FALQ;
+    }
 
-            if ( displacement == macroDisplacements->end( ) ){
+    floatVector overlapCoupling::getMacroAugmentedLagrangianForce( ){
+        /*!
+         * Get the macro augmented lagrangian force vector
+         */
 
-                return new errorNode( __func__, "The macro node " + std::to_string( node->first ) +
-                                      " was not found in the displacements vector" );
+        return FALD;
+    }
 
-            }
+    floatVector overlapCoupling::getUpdatedMacroDisplacementDOF( ){
+        /*!
+         * Return a copy of the macro displacement dof vector
+         */
 
-            for ( unsigned int i = 0; i < _dim; i++ ){
+        return vectorTools::appendVectors( { _updatedFreeMacroDispDOFValues, _projected_ghost_macro_displacement } );
+    }
 
-                nodePositions[ _dim * node->second + i ] = referencePosition->second[ i ] + displacement->second[ i ];
+    outputQueue::outputQueue( ){
+        /*!
+         * The default constructor. The queue is synchronous until a capacity is set.
+         */
 
-            }
+        return;
+    }
 
-        }
+    outputQueue::~outputQueue( ){
+        /*!
+         * The destructor. All of the queued jobs are run before the writer thread is stopped.
+         */
 
-        //Assemble the node sets
-        stringVector nodeSetNames = { "free_macro_nodes", "ghost_macro_nodes" };
-        uIntMatrix nodeSets( 2 );
-        nodeSets[ 0 ].resize( freeMacroNodeIds->size( ) );
-        nodeSets[ 1 ].resize( ghostMacroNodeIds->size( ) );
+        std::unique_ptr< errorNode > error( flush( ) );
 
-        for ( auto node = freeMacroNodeIds->begin( ); node != freeMacroNodeIds->end( ); node++ ){
+        if ( error ){
 
-            auto localNode = macroGlobalToLocalDOFMap->find( *node );
+            error->print( );
 
-            if ( localNode == macroGlobalToLocalDOFMap->end( ) ){
+        }
 
-                return new errorNode( __func__,
-                                      "The free macro node " + std::to_string( *node ) + " was not found in the macro global to local DOF map" );
+        {
 
-            }
+            std::lock_guard< std::mutex > lock( _mutex );
 
-            nodeSets[ 0 ][ node - freeMacroNodeIds->begin( ) ] = localNode->second;
+            _stop = true;
 
         }
 
-        for ( auto node = ghostMacroNodeIds->begin( ); node != ghostMacroNodeIds->end( ); node++ ){
+        _jobAvailable.notify_all( );
 
-            auto localNode = macroGlobalToLocalDOFMap->find( *node );
+        if ( _thread.joinable( ) ){
 
-            if ( localNode == macroGlobalToLocalDOFMap->end( ) ){
+            _thread.join( );
 
-                return new errorNode( __func__,
-                                      "The ghost macro node " + std::to_string( *node ) + " was not found in the macro global to local DOF map" );
+        }
 
-            }
+    }
 
-            nodeSets[ 1 ][ node - ghostMacroNodeIds->begin( ) ] = localNode->second;
+    errorOut outputQueue::setCapacity( const uIntType &capacity ){
+        /*!
+         * Set the number of jobs which may be waiting in the queue. The queue is flushed first.
+         *
+         * :param const uIntType &capacity: The capacity of the queue. Zero runs the jobs synchronously.
+         */
+
+        errorOut error = flush( );
+
+        if ( error ){
+
+            errorOut result = new errorNode( "setCapacity", "Error in flushing the output queue" );
+            result->addNext( error );
+            return result;
 
         }
 
-        //Assemble the element sets
-        stringVector elementSetNames = { "free_macro_elements", "ghost_macro_elements" };
-        uIntMatrix elementSets( 2 );
-        elementSets[ 0 ].resize( _inputProcessor.getFreeMacroCellIds( )->size( ) );
-        elementSets[ 1 ].resize( _inputProcessor.getGhostMacroCellIds( )->size( ) );
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _capacity = capacity;
+
+        return NULL;
+
+    }
+
+    bool outputQueue::isAsynchronous( ) const{
+        /*!
+         * Whether the jobs are run by the writer thread
+         */
+
+        return _capacity > 0;
+
+    }
+
+    errorOut outputQueue::push( std::function< errorOut( ) > &&job ){
+        /*!
+         * Add a job to the queue. If the queue is full this blocks until the writer thread has finished a job.
+         *
+         * :param std::function< errorOut( ) > &&job: The job. Any data the job requires should be moved into it.
+         */
+
+        if ( !isAsynchronous( ) ){
+
+            return job( );
 
-        for ( uIntType i = 0; i < elementSets[ 0 ].size( ); i++ ){
-            elementSets[ 0 ][ i ] = i;
         }
 
-        for ( uIntType i = 0; i < elementSets[ 1 ].size( ); i++ ){
-            elementSets[ 1 ][ i ] = elementSets[ 0 ].size( ) + i;
+        std::unique_lock< std::mutex > lock( _mutex );
+
+        if ( !_thread.joinable( ) ){
+
+            _thread = std::thread( &outputQueue::run, this );
+
         }
 
-        //Assemble the connectivity vector
-        uIntVector connectivity( 0 );
-        for ( auto cell = elementIds.begin( ); cell != elementIds.end( ); cell++ ){
+        _jobFinished.wait( lock, [ this ]{ return ( _jobs.size( ) < _capacity ) || _error; } );
 
-            std::unique_ptr< elib::Element > element;
+        if ( _error ){
 
-            errorOut error = buildMacroDomainElement( *cell, *macroNodeReferencePositions, *macroDisplacements,
-                                                      *macroNodeReferenceConnectivity, element );
+            errorOut result = new errorNode( "push", "A previous output job failed" );
+            result->addNext( copyError( ) );
+            return result;
 
-            if ( error ){
+        }
 
-                errorOut result = new errorNode( __func__,
-                                                 "Error in construction of the micromorphic element" );
-                result->addNext( error );
-                return result;
+        _jobs.push_back( std::move( job ) );
 
-            }
+        _jobAvailable.notify_one( );
 
-            //Get the XDMF cell type
-            auto elementConnectivity = macroNodeReferenceConnectivity->find( *cell );
+        return NULL;
 
-            if ( elementConnectivity == macroNodeReferenceConnectivity->end( ) ){
+    }
 
-                return new errorNode( __func__,
-                                      "Macro cell " + std::to_string( *cell ) + " was not found in the macro mesh connectivity" );
+    errorOut outputQueue::flush( ){
+        /*!
+         * Wait until all of the queued jobs have been run. Returns the error of the first failed job.
+         */
 
-            }
+        std::unique_lock< std::mutex > lock( _mutex );
 
-            uIntType cellType = elementConnectivity->second[ 0 ];
+        _jobFinished.wait( lock, [ this ]{ return _jobs.empty( ) && !_busy; } );
 
-            uIntVector localNodeIds( element->global_node_ids.size( ) + 1 );
-            localNodeIds[ 0 ] = cellType;
+        if ( _error ){
 
-            for ( auto gN = element->global_node_ids.begin( ); gN != element->global_node_ids.end( ); gN++ ){
+            errorOut result = new errorNode( "flush", "An output job failed" );
+            result->addNext( copyError( ) );
+            return result;
 
-                auto node = macroGlobalToLocalDOFMap->find( *gN );
+        }
 
-                if ( node == macroGlobalToLocalDOFMap->end( ) ){
+        return NULL;
 
-                    return new errorNode( __func__,
-                                          "The global macro node " + std::to_string( *gN ) +
-                                          " can't be found in the global to local map" );
+    }
 
-                }
+    void outputQueue::resetError( ){
+        /*!
+         * Clear the error of a failed job so that new jobs can be pushed
+         */
+
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _error.reset( );
+
+    }
 
-                localNodeIds[ gN - element->global_node_ids.begin( ) + 1 ] = node->second;
+    errorOut copyErrorChain( const errorNode *error ){
+        /*!
+         * Copy an error chain so that the copy can be adopted by another chain while the original keeps its owner
+         *
+         * :param const errorNode *error: The first node of the chain to copy
+         */
 
-            }
+        if ( !error ){
 
-            connectivity = vectorTools::appendVectors( { connectivity, localNodeIds } );
+            return NULL;
 
         }
 
-        const floatType *time = _inputProcessor.getMacroTime( );
-
-        uIntType numIncrements;
-        writer->getNumIncrements( numIncrements );
+        errorOut result = new errorNode( error->_functionName, error->_error );
 
-        errorOut error = writer->initializeIncrement( *time, numIncrements, collectionNumber, _currentReferenceOutputIncrement ); 
+        errorOut tail = result;
 
-        if ( error ){
+        for ( auto node = error->_next.get( ); node; node = node->_next.get( ) ){
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in initialization of the increment in the writer" );
-            result->addNext( error );
-            return result;
+            errorOut next = new errorNode( node->_functionName, node->_error );
+            tail->addNext( next );
+            tail = next;
 
         }
 
-        error = writer->writeIncrementMeshData( _currentReferenceOutputIncrement, collectionNumber,
-                                                nodeIds, nodeSets, nodeSetNames, nodePositions,
-                                                elementIds, elementSets, elementSetNames, connectivity );
-
-        if ( error ){
+        return result;
 
-            errorOut result = new errorNode( __func__,
-                                             "Error in writing the mesh data to a file" );
-            result->addNext( error );
-            return result;
+    }
 
-        }
+    errorOut outputQueue::copyError( ) const{
+        /*!
+         * Copy the stored error chain. The queue's mutex must be held by the caller.
+         */
 
-        return NULL;
+        return copyErrorChain( _error.get( ) );
 
     }
 
-    errorOut overlapCoupling::writeUpdatedDOFToFile( const uIntType collectionNumber ){
+    void outputQueue::run( ){
         /*!
-         * Write the updated degree of freedom information to a output file
-         *
-         * :param const uIntType collectionNumber: The collection to place the reference state in ( defaults to 0 )
+         * The loop of the writer thread
          */
 
-        //Get the configuration for the writer object
-        YAML::Node config = _inputProcessor.getCouplingInitialization( )[ "output_updated_dof" ];
+        std::unique_lock< std::mutex > lock( _mutex );
 
-        if ( !config ){
+        while ( true ){
 
-            return new errorNode( __func__,
-                                  "'output_updated_dof' is not defined in the configuration file" );
+            _jobAvailable.wait( lock, [ this ]{ return _stop || !_jobs.empty( ); } );
 
-        }
+            if ( _jobs.empty( ) ){
 
-        std::string macro_config_string = "filename: ";
-        macro_config_string += config[ "macroscale_filename" ].as< std::string >( ) + "\n";
-        macro_config_string += "mode: write\n";
-        macro_config_string += "filetype: ";
-        macro_config_string += config[ "macroscale_filetype" ].as< std::string >( ) + "\n";
-        macro_config_string += "append_to_existing_file: false\n";
+                return;
 
-        std::string micro_config_string = "filename: ";
-        micro_config_string += config[ "microscale_filename" ].as< std::string >( ) + "\n";
-        micro_config_string += "mode: write\n";
-        micro_config_string += "filetype: ";
-        micro_config_string += config[ "microscale_filetype" ].as< std::string >( ) + "\n";
-        micro_config_string += "append_to_existing_file: false\n";
+            }
 
-        YAML::Node macro_config = YAML::Load( macro_config_string.c_str( ) ); 
-        YAML::Node micro_config = YAML::Load( micro_config_string.c_str( ) ); 
+            std::function< errorOut( ) > job = std::move( _jobs.front( ) );
+            _jobs.pop_front( );
+            _busy = true;
 
-        //Form the macro writer object
-        std::shared_ptr< dataFileInterface::dataFileBase > macro_writer
-            = dataFileInterface::dataFileBase( macro_config ).create( );
+            lock.unlock( );
 
-        if ( macro_writer->_error ){
+            std::unique_ptr< errorNode > error;
 
-            errorOut result = new errorNode( __func__, "Error in construction of writer" );
-            result->addNext( macro_writer->_error );
-            return result;
+            try{
 
-        }
+                error.reset( job( ) );
 
-        //Form the micro writer object
-        std::shared_ptr< dataFileInterface::dataFileBase > micro_writer
-            = dataFileInterface::dataFileBase( micro_config ).create( );
+            }
+            catch( std::exception &e ){
 
-        if ( micro_writer->_error ){
+                error.reset( new errorNode( "run", e.what( ) ) );
 
-            errorOut result = new errorNode( __func__, "Error in construction of writer" );
-            result->addNext( micro_writer->_error );
-            return result;
+            }
 
-        }
+            //Release the data held by the job before the next one is started
+            job = nullptr;
 
-        //Write out the macro DOF information
-        floatVector outputDOF = vectorTools::appendVectors( { _updatedFreeMacroDispDOFValues, _projected_ghost_macro_displacement } );
+            lock.lock( );
 
-//        std::cout << "Macroscale\n";
-//        for ( unsigned int i = 0; i < outputDOF.size( ); i++ ){
-//            std::cout << outputDOF[ i ] << " ";
-//            if ( ( ( i + 1 ) % 12 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
+            _busy = false;
 
-        uIntType increment;
-        errorOut error = macro_writer->initializeIncrement( 1.0, 0, collectionNumber, increment );
+            if ( error && !_error ){
 
-        if ( error ){
+                //The jobs after a failed one are discarded
+                _error = std::move( error );
+                _jobs.clear( );
 
-            errorOut result = new errorNode( __func__, "Error in initializating the increment of the macro output file" );
-            result->addNext( error );
-            return result;
+            }
+
+            _jobFinished.notify_all( );
 
         }
 
-        error = macro_writer->writeScalarSolutionData( increment, collectionNumber, "updated_DOF", "Node", outputDOF ); 
-        
-        if ( error ){
+    }
 
-            errorOut result = new errorNode( __func__, "Error in outputting the updated macro DOF to the output file" );
-            result->addNext( error );
-            return result;
+    couplingSession::couplingSession( const std::string &filename ){
+        /*!
+         * Construct the coupling session and initialize the coupling
+         *
+         * :param const std::string &filename: The name of the input YAML file
+         */
 
-        }
+        //Construct the overlap coupling object
+        _overlapCoupling.reset( new overlapCoupling( filename ) );
 
-        floatVector nodeIds( _inputProcessor.getMacroGlobalToLocalDOFMap( )->size( ) );
-        for ( auto node  = _inputProcessor.getMacroGlobalToLocalDOFMap( )->begin( );
-                   node != _inputProcessor.getMacroGlobalToLocalDOFMap( )->end( );
-                   node++ ){
+        if ( _overlapCoupling->getConstructorError( ) ){
 
-            nodeIds[ node->second ] = node->first;
+            _error.reset( new errorNode( __func__, "Error in construction of overlapCoupling object" ) );
+            _error->addNext( _overlapCoupling->getConstructorError( ) );
+            return;
 
         }
 
-        error = macro_writer->writeScalarSolutionData( increment, collectionNumber, "node_ids", "Node", nodeIds );
+        //Initialize the overlap coupling object
+        COUPLING_LOG( _overlapCoupling->getLogger( ), LOG_INFO ) << "INITIALIZE COUPLING\n";
+        errorOut error = _overlapCoupling->initializeCoupling( );
 
         if ( error ){
 
-            errorOut result = new errorNode( __func__, "Error in outputting the updated node ids to the micro output file" );
-            result->addNext( error );
-            return result;
+            _error.reset( new errorNode( __func__, "Error in the initialization of the overlapCoupling object" ) );
+            _error->addNext( error );
+            return;
 
         }
 
-        //Write out the micro DOF information
-        outputDOF = vectorTools::appendVectors( { _updatedFreeMicroDispDOFValues, _projected_ghost_micro_displacement } );
+        return;
 
-//        std::cout << "\nMicroscale\n";
-//        for ( unsigned int i = 0; i < outputDOF.size( ); i++ ){
-//            std::cout << outputDOF[ i ] << " ";
-//            if ( ( ( i + 1 ) % 3 ) == 0 ){
-//                std::cout << "\n";
-//            }
-//        }
+    }
 
-        error = micro_writer->initializeIncrement( 1.0, 0, collectionNumber, increment );
+    errorOut couplingSession::getError( ){
+        /*!
+         * Return the error from the construction and initialization of the session. The error is owned by the
+         * session so it must be copied before it is added to another error chain.
+         */
 
-        if ( error ){
+        return _error.get( );
 
-            errorOut result = new errorNode( __func__, "Error in initializating the increment of the micro output file" );
-            result->addNext( error );
-            return result;
+    }
 
-        }
+    errorOut couplingSession::step( DOFMap &microGlobalLocalNodeMap, floatVector &updatedMicroDisplacementDOF,
+                                    floatVector &Lagrangian_FALQ,
+                                    DOFMap &macroGlobalLocalNodeMap, floatVector &updatedMacroDisplacementDOF,
+                                    floatVector &Lagrangian_FALD ){
+        /*!
+         * Perform a coupling step using the final increments of the macro and micro data files. After the
+         * first step the data files are re-opened so that the newly written increments are processed.
+         *
+         * :param DOFMap &microGlobalLocalNodeMap: The map from global to local node numbers for the micro nodes
+         * :param floatVector &updatedMicroDisplacementDOF: The updated micro displacement degrees of freedom
+         * :param floatVector &Lagrangian_FALQ: The augmented lagrangian force for the micro domain
+         * :param DOFMap &macroGlobalLocalNodeMap: The map from global to local node numbers for the macro nodes
+         * :param floatVector &updatedMacroDisplacementDOF: The updated macro displacement degrees of freedom
+         * :param floatVector &Lagrangian_FALD: The augmented lagrangian force for the macro domain
+         */
 
-        error = micro_writer->writeScalarSolutionData( increment, collectionNumber, "updated_DOF", "Node", outputDOF ); 
-        
-        if ( error ){
+        if ( _error ){
 
-            errorOut result = new errorNode( __func__, "Error in outputting the updated micro DOF to the output file" );
-            result->addNext( error );
+            errorOut result = new errorNode( __func__, "The coupling session was not initialized successfully" );
             return result;
 
         }
 
-        nodeIds = floatVector( _inputProcessor.getMicroGlobalToLocalDOFMap( )->size( ) );
-        for ( auto node  = _inputProcessor.getMicroGlobalToLocalDOFMap( )->begin( );
-                   node != _inputProcessor.getMicroGlobalToLocalDOFMap( )->end( );
-                   node++ ){
+        errorOut error = NULL;
 
-            nodeIds[ node->second ] = node->first;
+        if ( _stepCount > 0 ){
+
+            COUPLING_LOG( _overlapCoupling->getLogger( ), LOG_INFO ) << "RELOAD DATA FILES\n";
+            error = _overlapCoupling->reloadDataFiles( );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in reloading the data files" );
+                result->addNext( error );
+                return result;
+
+            }
 
         }
 
-        error = micro_writer->writeScalarSolutionData( increment, collectionNumber, "node_ids", "Node", nodeIds );
+        //Process the final increments of both the macro and micro-scales
+        COUPLING_LOG( _overlapCoupling->getLogger( ), LOG_INFO ) << "PROCESS LAST INCREMENTS\n";
+        error = _overlapCoupling->processLastIncrements( );
 
         if ( error ){
 
-            errorOut result = new errorNode( __func__, "Error in outputting the updated node ids to the micro output file" );
+            errorOut result = new errorNode( __func__, "Error in processing the data" );
             result->addNext( error );
+
+            //Complete the output of the previous steps
+            errorOut outputError = flushOutput( );
+
+            if ( outputError ){
+
+                result->addNext( outputError );
+
+            }
+
             return result;
 
         }
 
+        _stepCount++;
+
+        //Return the updated DOF values
+        COUPLING_LOG( _overlapCoupling->getLogger( ), LOG_INFO ) << "RETURN DOF VALUES\n";
+        microGlobalLocalNodeMap = _overlapCoupling->getMicroGlobalLocalNodeMap( );
+        updatedMicroDisplacementDOF = _overlapCoupling->getUpdatedMicroDisplacementDOF( );
+        Lagrangian_FALQ = _overlapCoupling->getMicroAugmentedLagrangianForce( );
+
+        macroGlobalLocalNodeMap = _overlapCoupling->getMacroGlobalLocalNodeMap( );
+        updatedMacroDisplacementDOF = _overlapCoupling->getUpdatedMacroDisplacementDOF( );
+        Lagrangian_FALD = _overlapCoupling->getMacroAugmentedLagrangianForce( );
+
         return NULL;
 
     }
 
-    DOFMap overlapCoupling::getMicroGlobalLocalNodeMap( ){
+    errorOut couplingSession::flushOutput( ){
         /*!
-         * Return a copy of the micro global to local node map
+         * Wait until the output of the completed coupling steps has been written. The output is written in the
+         * background so errors in writing it are only returned by this function.
          */
 
-        return *_inputProcessor.getMicroGlobalToLocalDOFMap( );
-    }
+        if ( !_overlapCoupling ){
 
-    DOFMap overlapCoupling::getMacroGlobalLocalNodeMap( ){
-        /*!
-         * Return a copy of the macro global to local node map
-         */
+            return NULL;
 
-        return *_inputProcessor.getMacroGlobalToLocalDOFMap( );
-    }
+        }
 
-    floatVector overlapCoupling::getUpdatedMicroDisplacementDOF( ){
-        /*!
-         * Return a copy of the micro displacement dof vector
-         */
+        errorOut error = _overlapCoupling->flushOutput( );
 
-        return vectorTools::appendVectors( { _updatedFreeMicroDispDOFValues, _projected_ghost_micro_displacement } );
-    }
+        if ( error ){
 
-    floatVector overlapCoupling::getMicroAugmentedLagrangianForce( ){
-        /*!
-         * Get the micro augmented lagrangian force vector
-         */
+            errorOut result = new errorNode( __func__, "Error in the output of the coupling session" );
+            result->addNext( error );
+            return result;
+
+        }
+
+        return NULL;
 
-        return FALQ;
     }
 
-    floatVector overlapCoupling::getMacroAugmentedLagrangianForce( ){
+    uIntType couplingSession::getStepCount( ){
         /*!
-         * Get the macro augmented lagrangian force vector
+         * Get the number of coupling steps which have been completed
          */
 
-        return FALD;
+        return _stepCount;
+
     }
 
-    floatVector overlapCoupling::getUpdatedMacroDisplacementDOF( ){
+    overlapCoupling *couplingSession::getOverlapCoupling( ){
         /*!
-         * Return a copy of the macro displacement dof vector
+         * Get the overlap coupling object of the session
          */
 
-        return vectorTools::appendVectors( { _updatedFreeMacroDispDOFValues, _projected_ghost_macro_displacement } );
+        return _overlapCoupling.get( );
+
     }
 
     errorOut runOverlapCoupling( const std::string &filename,
@@ -11330,7 +13669,8 @@ namespace overlapCoupling{
                                  floatVector &Lagrangian_FALD
                                ){
         /*!
-         * Run the overlap coupling method
+         * Run the overlap coupling method. This is a single step of a couplingSession. Codes which couple
+         * repeatedly should hold a couplingSession so the coupling is only initialized once.
          *
          * :param const std::string &filename: The name of the input YAML file
          * :param DOFMap &microGlobalLocalNodeMap: The map from global to local node numbers for the micro nodes
@@ -11341,59 +13681,46 @@ namespace overlapCoupling{
          * :param floatVector &Lagrangian_FALD: The augmented lagrangian force for the macro domain
          */
 
-        //Construct the overlap coupling object
-        overlapCoupling oc( filename );
+        couplingSession session( filename );
 
-        if ( oc.getConstructorError( ) ){
+        if ( session.getError( ) ){
 
             errorOut result
-                = new errorNode( __func__, "Error in construction of overlapCoupling object" );
+                = new errorNode( __func__, "Error in the initialization of the coupling session" );
 
-            result->addNext( oc.getConstructorError( ) );
+            result->addNext( copyErrorChain( session.getError( ) ) );
 
             return result;
 
         }
 
-        //Initialize the overlap coupling object
-        std::cerr << "INITIALIZE COUPLING\n";
-        errorOut error = oc.initializeCoupling( );
+        errorOut error = session.step( microGlobalLocalNodeMap, updatedMicroDisplacementDOF, Lagrangian_FALQ,
+                                       macroGlobalLocalNodeMap, updatedMacroDisplacementDOF, Lagrangian_FALD );
 
         if ( error ){
-    
+
             errorOut result
-                = new errorNode( __func__, "Error in the initialization of the overlapCoupling object" );
-    
+                = new errorNode( __func__, "Error in the coupling step" );
+
             result->addNext( error );
 
             return result;
-    
+
         }
 
-        //Process the final increments of both the macro and micro-scales
-        std::cerr << "PROCESS LAST INCREMENTS\n";
-        error = oc.processLastIncrements( );
-    
+        //Wait for the output to be written so that errors in writing it are returned
+        error = session.flushOutput( );
+
         if ( error ){
-    
+
             errorOut result
-                = new errorNode( __func__, "Error in processing the data" );
-    
+                = new errorNode( __func__, "Error in writing the output of the coupling step" );
+
             result->addNext( error );
 
             return result;
-    
-        }
-
-        //Return the updated DOF values
-        std::cerr << "RETURN DOF VALUES\n";
-        microGlobalLocalNodeMap = oc.getMicroGlobalLocalNodeMap( );
-        updatedMicroDisplacementDOF = oc.getUpdatedMicroDisplacementDOF( );
-        Lagrangian_FALQ = oc.getMicroAugmentedLagrangianForce( );
 
-        macroGlobalLocalNodeMap = oc.getMacroGlobalLocalNodeMap( );
-        updatedMacroDisplacementDOF = oc.getUpdatedMacroDisplacementDOF( );
-        Lagrangian_FALD = oc.getMacroAugmentedLagrangianForce( );
+        }
 
         return NULL;
 
@@ -11488,6 +13815,67 @@ namespace overlapCoupling{
 
         return &_homogenizationMatrix;
 
+    }
+    errorOut overlapCoupling::_test_factorizeFreeDOFLHS( const SparseMatrix &LHS ){
+        /*!
+         * Factorize the free degree of freedom LHS matrix using the cached factorization
+         *
+         * :param const SparseMatrix &LHS: The compressed LHS matrix
+         */
+
+        return factorizeFreeDOFLHS( LHS );
+
+    }
+
+    freeDOFSolver overlapCoupling::_test_getFreeDOFLHSActiveSolver( ){
+        /*!
+         * Get the solver which was used for the last factorization of the free degree of freedom LHS matrix
+         */
+
+        return _freeDOFLHSActiveSolver;
+
+    }
+
+    inputFileProcessor::inputFileProcessor *overlapCoupling::_test_getInputProcessor( ){
+        /*!
+         * Get the input processor of the coupling
+         */
+
+        return &_inputProcessor;
+
+    }
+
+    const SparseMatrix *overlapCoupling::getSparseBQhatQ( ){
+        /*!
+         * Get a constant reference to the sparse form of BQhatQ
+         */
+
+        return &_sparse_BQhatQ;
+
+    }
+    const SparseMatrix *overlapCoupling::getSparseBQhatD( ){
+        /*!
+         * Get a constant reference to the sparse form of BQhatD
+         */
+
+        return &_sparse_BQhatD;
+
+    }
+    const SparseMatrix *overlapCoupling::getSparseBDhatQ( ){
+        /*!
+         * Get a constant reference to the sparse form of BDhatQ
+         */
+
+        return &_sparse_BDhatQ;
+
+    }
+    const SparseMatrix *overlapCoupling::getSparseBDhatD( ){
+        /*!
+         * Get a constant reference to the sparse form of BDhatD
+         */
+
+        return &_sparse_BDhatD;
+
     }
 
     const cellDomainFloatMap* overlapCoupling::getHomogenizedVolumes( ){
@@ -11,6 +11,15 @@
 #include<inputFileProcessor.h>
 #include<element.h>
 #include<volumeReconstruction.h>
+#include<Eigen/SparseQR>
+#include<Eigen/SparseCholesky>
+#include<Eigen/IterativeLinearSolvers>
+#include<set>
+#include<deque>
+#include<functional>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
 
 namespace overlapCoupling{
 
@@ -30,6 +39,12 @@ namespace overlapCoupling{
     typedef inputFileProcessor::DOFMap DOFMap;
     typedef DOFProjection::SparseMatrix SparseMatrix;
     typedef std::vector< DOFProjection::T > tripletVector;
+    typedef inputFileProcessor::couplingLogger couplingLogger;
+
+    using inputFileProcessor::LOG_ERROR;
+    using inputFileProcessor::LOG_WARNING;
+    using inputFileProcessor::LOG_INFO;
+    using inputFileProcessor::LOG_DEBUG;
 
     typedef std::unordered_map< std::string, uIntVector > domainUIntVectorMap;
     typedef std::unordered_map< std::string, floatType > domainFloatMap;
@@ -49,6 +64,108 @@ namespace overlapCoupling{
             { "volume_fraction", VOLUME_FRACTION }
         };
 
+    //!The different solvers for the free degree of freedom LHS matrix
+    enum freeDOFSolver { SPARSE_QR, SIMPLICIAL_LDLT, SIMPLICIAL_LLT, CG_DIAGONAL, CG_INCOMPLETE_CHOLESKY };
+    const std::map< std::string, freeDOFSolver > freeDOFSolvers =
+        {
+            { "qr", SPARSE_QR },
+            { "ldlt", SIMPLICIAL_LDLT },
+            { "llt", SIMPLICIAL_LLT },
+            { "cg_diagonal", CG_DIAGONAL },
+            { "cg_incomplete_cholesky", CG_INCOMPLETE_CHOLESKY }
+        };
+
+    struct homogenizedDomainValues{
+        /*!
+         * The homogenized values of a collection of micro domains. Used to hold the results
+         * of the homogenization of the micro domains before they are merged into the
+         * overlap coupling object.
+         */
+
+        cellDomainFloatMap homogenizedVolumes;
+        cellDomainFloatMap homogenizedSurfaceAreas;
+        cellDomainFloatMap homogenizedDensities;
+        cellDomainFloatVectorMap homogenizedMicroInertias;
+        cellDomainFloatVectorMap homogenizedCentersOfMass;
+        cellDomainFloatVectorMap homogenizedBodyForces;
+        cellDomainFloatVectorMap homogenizedBodyForceCouples;
+        cellDomainFloatVectorMap homogenizedAccelerations;
+        cellDomainFloatVectorMap homogenizedMicroSpinInertias;
+        cellDomainFloatVectorMap homogenizedSymmetricMicroStresses;
+        cellDomainFloatVectorMap homogenizedSurfaceRegionAreas;
+        cellDomainFloatVectorMap homogenizedSurfaceRegionCentersOfMass;
+        cellDomainFloatVectorMap homogenizedSurfaceRegionProjectedLocalCentersOfMass;
+        cellDomainFloatVectorMap homogenizedSurfaceRegionProjectedCentersOfMass;
+        cellDomainFloatVectorMap homogenizedSurfaceRegionTractions;
+        cellDomainFloatVectorMap homogenizedSurfaceRegionCouples;
+        cellDomainUIntVectorMap cellDomainMacroSurfaces;
+    };
+
+    struct homogenizationTask{
+        /*!
+         * The information required to homogenize a single micro domain. Everything which
+         * requires access to the data files is collected before the task is processed so
+         * that the tasks may be processed concurrently.
+         */
+
+        uIntType macroCellID;
+        uIntType elementIndex;
+        std::string microDomainName;
+        const floatVector *microDomainCenterOfMass;
+        uIntType microDomainSurfaceDecompositionCount;
+        uIntVector microDomainNodeIDs;
+        YAML::Node volumeReconstructionConfig;
+    };
+
+    class outputQueue{
+        /*!
+         * A bounded queue of output jobs which are run, in the order they were pushed, by a
+         * dedicated writer thread. A capacity of zero runs each job immediately on the calling thread.
+         *
+         * The first error returned by a job is kept and the jobs queued after it are discarded. A copy
+         * of the error is returned by every call to push or flush until resetError is called.
+         */
+
+        public:
+            outputQueue( );
+
+            ~outputQueue( );
+
+            errorOut setCapacity( const uIntType &capacity );
+
+            bool isAsynchronous( ) const;
+
+            errorOut push( std::function< errorOut( ) > &&job );
+
+            errorOut flush( );
+
+            void resetError( );
+
+        private:
+
+            void run( );
+
+            errorOut copyError( ) const;
+
+            uIntType _capacity = 0;
+
+            std::deque< std::function< errorOut( ) > > _jobs;
+
+            bool _busy = false;
+
+            bool _stop = false;
+
+            std::unique_ptr< errorNode > _error;
+
+            std::mutex _mutex;
+
+            std::condition_variable _jobAvailable;
+
+            std::condition_variable _jobFinished;
+
+            std::thread _thread;
+    };
+
     class overlapCoupling{
         /*!
          * The implementation of the overlap coupling
@@ -66,11 +183,17 @@ namespace overlapCoupling{
 
             errorOut getConstructorError( );
 
+            couplingLogger &getLogger( );
+
+            errorOut flushOutput( );
+
             errorOut initializeCoupling( );
 
             errorOut processIncrement( const unsigned int &microIncrement,
                                        const unsigned int &macroIncrement );
 
+            errorOut reloadDataFiles( );
+
             errorOut processLastIncrements( );
 
             //Access functions
@@ -129,6 +252,11 @@ namespace overlapCoupling{
             const Eigen::MatrixXd *getCenterOfMassProjector( );
             const SparseMatrix *getHomogenizationMatrix( );
 
+            const SparseMatrix *getSparseBQhatQ( );
+            const SparseMatrix *getSparseBQhatD( );
+            const SparseMatrix *getSparseBDhatQ( );
+            const SparseMatrix *getSparseBDhatD( );
+
             const cellDomainFloatMap* getHomogenizedVolumes( );
             const cellDomainFloatMap* getHomogenizedDensities( );
             const cellDomainFloatVectorMap* getHomogenizedSymmetricMicroStresses( );
@@ -166,6 +294,15 @@ namespace overlapCoupling{
 
             std::unordered_map< uIntType, Eigen::MatrixXd > _test_stressProjectionLHS;
 
+            uIntType _test_freeDOFLHSAnalysisCount = 0;
+            uIntType _test_freeDOFLHSFactorizationCount = 0;
+
+            errorOut _test_factorizeFreeDOFLHS( const SparseMatrix &LHS );
+
+            freeDOFSolver _test_getFreeDOFLHSActiveSolver( );
+
+            inputFileProcessor::inputFileProcessor *_test_getInputProcessor( );
+
             const std::unordered_map< uIntType, floatVector > *getQuadraturePointCauchyStress( );
             const std::unordered_map< uIntType, floatVector > *getQuadraturePointHigherOrderStress( );
             const std::unordered_map< uIntType, floatVector > *getQuadraturePointDensities( );
@@ -279,6 +416,15 @@ namespace overlapCoupling{
             std::unordered_map< uIntType, floatVector > _macroReferencePositions;
             std::unordered_map< uIntType, floatVector > _microReferencePositions;
 
+            //The macro elements built for each cell. The elements are re-used as long as the connectivity
+            //and nodal positions they were built with remain unchanged.
+            std::unordered_map< uIntType, std::unique_ptr< elib::Element > > _macroReferenceElementCache;
+            std::unordered_map< uIntType, std::unique_ptr< elib::Element > > _macroElementCache;
+
+            //The writer of the homogenized response. The writer is kept open for the whole run so that each
+            //increment only appends its own grid and datasets to the output file.
+            std::shared_ptr< dataFileInterface::dataFileBase > _homogenizedResponseWriter;
+
             //Private functions
             errorOut processDomainMassData( const unsigned int &microIncrement, const std::string &domainName,
                                             domainFloatMap &domainMass, domainFloatVectorMap &domainCenterOfMass,
@@ -306,6 +452,17 @@ namespace overlapCoupling{
                                               const std::unordered_map< uIntType, uIntVector > &connectivity,
                                               std::unique_ptr< elib::Element > &element );            
 
+            errorOut getMacroDomainElement( const unsigned int cellID,
+                                            const std::unordered_map< uIntType, floatVector > &nodeLocations,
+                                            const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                            elib::Element *&element );
+
+            errorOut getMacroDomainElement( const unsigned int cellID,
+                                            const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
+                                            const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
+                                            const std::unordered_map< uIntType, uIntVector > &connectivity,
+                                            elib::Element *&element );
+
             errorOut computeShapeFunctionsAtPoint( const unsigned int cellID,
                                                    const std::unordered_map< uIntType, floatVector > &nodeLocations,
                                                    const std::unordered_map< uIntType, uIntVector >  &connectivity,
@@ -332,6 +489,10 @@ namespace overlapCoupling{
                                                     uIntVector &macroNodes,
                                                     std::unordered_map< uIntType, floatVector > &shapeFunctions );
 
+            errorOut computeElementShapeFunctionsAtPoints( elib::Element *element,
+                                                           const std::unordered_map< uIntType, floatVector > &points,
+                                                           std::unordered_map< uIntType, floatVector > &shapeFunctions );
+
             errorOut computeShapeFunctionGradientsAtPoints( const unsigned int cellID,
                                                             const std::unordered_map< uIntType, floatVector > &nodeReferenceLocations,
                                                             const std::unordered_map< uIntType, floatVector > &nodeDisplacements,
@@ -375,6 +536,19 @@ namespace overlapCoupling{
 
             errorOut formL2Projectors( );
 
+            errorOut formSparseL2Projectors( const uIntType &nFreeMicroDOF, const uIntType &nGhostMicroDOF,
+                                             const uIntType &nFreeMacroDOF, const uIntType &nGhostMacroDOF );
+
+            errorOut applyL2ProjectorsImplicitly( const Eigen::MatrixXd &Q, const Eigen::MatrixXd &D,
+                                                  Eigen::MatrixXd &Qhat, Eigen::MatrixXd &Dhat );
+
+            errorOut applyL2ProjectorTransposesImplicitly( const Eigen::MatrixXd &FQhat, const Eigen::MatrixXd &FDhat,
+                                                           Eigen::MatrixXd &FQ, Eigen::MatrixXd &FD );
+
+            errorOut applyPseudoInverse( const SparseMatrix &v, Eigen::MatrixXd &result );
+
+            errorOut applyPseudoInverseTranspose( const Eigen::MatrixXd &w, Eigen::MatrixXd &result );
+
             errorOut formAveragedL2Projectors( );
 
             errorOut formDirectProjectionProjectors( const unsigned int &microIncrement, const unsigned int &macroIncrement );
@@ -388,21 +562,40 @@ namespace overlapCoupling{
 
             errorOut homogenizeMicroScale( const unsigned int &microIncrement );
 
+            errorOut homogenizeMicroDomains( const unsigned int &microIncrement, const std::vector< homogenizationTask > &tasks,
+                                             const std::vector< std::unique_ptr< elib::Element > > &elements,
+                                             std::vector< homogenizedDomainValues > &taskValues );
+
+            errorOut homogenizeMicroDomain( const unsigned int &microIncrement, const homogenizationTask &task,
+                                            const std::unique_ptr< elib::Element > &element,
+                                            homogenizedDomainValues &values );
+
             errorOut reconstructDomain( const unsigned int &microIncrement, const std::string &microDomainName,
                                         uIntVector &microDomainNodeIds, floatVector &microNodePositions,
                                         const std::unique_ptr< elib::Element > &element,
                                         std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume );
 
+            errorOut reconstructDomain( const unsigned int &microIncrement, const std::string &microDomainName,
+                                        YAML::Node &volumeReconstructionConfig,
+                                        uIntVector &microDomainNodeIds, floatVector &microNodePositions,
+                                        const std::unique_ptr< elib::Element > &element,
+                                        std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume );
+
             errorOut computeDomainVolumeAverages( const uIntType &macroCellID, const std::string &microDomainName,
                                                   const uIntVector &microDomainNodeIDs,
                                                   std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume, 
+                                                  homogenizedDomainValues &values,
                                                   const floatVector *microDomainCenterOfMass = NULL );
 
             errorOut computeDomainSurfaceAverages( const uIntType &macroCellID, const std::string &microDomainName,
                                                    const uIntVector &microDomainNodeIDs,
                                                    const uIntType &microDomainSurfaceDecompositionCount,
                                                    std::shared_ptr< volumeReconstruction::volumeReconstructionBase > &reconstructedVolume,
-                                                   std::unique_ptr< elib::Element > &element );
+                                                   const std::unique_ptr< elib::Element > &element,
+                                                   const YAML::Node &volumeReconstructionConfig,
+                                                   homogenizedDomainValues &values );
+
+            void mergeHomogenizedDomainValues( homogenizedDomainValues &values );
 
             errorOut computeHomogenizedStresses( const uIntType &macroCellName );
 
@@ -422,8 +615,12 @@ namespace overlapCoupling{
 
             errorOut solveFreeDisplacement( const bool updateGhostDOF );
 
+            errorOut factorizeFreeDOFLHS( const SparseMatrix &LHS );
+
+            errorOut solveFreeDOFLHS( const Eigen::MatrixXd &RHS, const Eigen::MatrixXd &guess, Eigen::MatrixXd &solution );
+
             errorOut constructKineticEnergyPartitioningCoefficient( const uIntType &macroCellID,
-                                                                    const std::unique_ptr< elib::Element > &element,
+                                                                    elib::Element *element,
                                                                     floatVector &res );
 
             errorOut constructPotentialEnergyPartitioningCoefficient( std::unordered_map< uIntType, floatType > &qes );
@@ -434,6 +631,12 @@ namespace overlapCoupling{
 
             errorOut extractProjectionMatricesFromFile( );
 
+            errorOut getHomogenizedResponseWriter( std::shared_ptr< dataFileInterface::dataFileBase > &writer );
+
+            errorOut flushHomogenizedResponseWriter( );
+
+            static errorOut writeBufferedOutput( const YAML::Node &config, dataFileInterface::bufferedDataFile &buffer );
+
             errorOut writeReferenceMeshDataToFile( const uIntType collectionNumber = 0 );
 
             errorOut writeUpdatedDOFToFile( const uIntType collectionNumber = 0 );
@@ -451,6 +654,9 @@ namespace overlapCoupling{
             errorOut computeArlequinForceAndErrorVectors( );
             errorOut computeArlequinDeformationUpdate( );
 
+            void writeArlequinMicroDebugTable( const std::string &tableName, const Eigen::VectorXd &MQ,
+                                               const Eigen::Ref< const Eigen::VectorXd > &values );
+
             //The interpolation matrix
             SparseMatrix _N;
 
@@ -466,6 +672,17 @@ namespace overlapCoupling{
             SparseMatrix _sparse_BDhatQ;
             SparseMatrix _sparse_BDhatD;
 
+            //The implicit form of the L2 projection. The pseudo-inverse of NQDhat is applied through its QR factorization
+            //which is only available when the projectors were formed rather than read from a file
+            bool _useSparseL2Projectors = false;
+            bool _implicitL2Projectors = false;
+            Eigen::SparseQR< SparseMatrix, Eigen::COLAMDOrdering< int > > _L2ProjectorSolver;
+            SparseMatrix _L2ProjectorR;
+            SparseMatrix _L2ProjectorNQD;
+            SparseMatrix _L2ProjectorNQDhat;
+            SparseMatrix _L2ProjectorNQhatD;
+            SparseMatrix _L2ProjectorNQhatDhat;
+
             //The homogenized values
             cellDomainFloatMap homogenizedVolumes;
             cellDomainFloatMap homogenizedSurfaceAreas;
@@ -515,6 +732,19 @@ namespace overlapCoupling{
 
             Eigen::MatrixXd _FORCE;
 
+            //The cached factorization of the free degree of freedom LHS matrix
+            Eigen::SparseQR< SparseMatrix, Eigen::COLAMDOrdering< int > > _freeDOFLHSSolver;
+            Eigen::SimplicialLDLT< SparseMatrix > _freeDOFLHSLDLTSolver;
+            Eigen::SimplicialLLT< SparseMatrix > _freeDOFLHSLLTSolver;
+            Eigen::ConjugateGradient< SparseMatrix, Eigen::Lower | Eigen::Upper,
+                                      Eigen::DiagonalPreconditioner< floatType > > _freeDOFLHSCGDiagonalSolver;
+            Eigen::ConjugateGradient< SparseMatrix, Eigen::Lower | Eigen::Upper,
+                                      Eigen::IncompleteCholesky< floatType > > _freeDOFLHSCGIncompleteCholeskySolver;
+            freeDOFSolver _freeDOFLHSActiveSolver = SPARSE_QR;
+            std::set< freeDOFSolver > _freeDOFLHSAnalyzedSolvers;
+            bool _freeDOFLHSFactorized = false;
+            SparseMatrix _freeDOFLHS; //A copy of the factorized matrix used to detect changes in its pattern and values
+
             floatVector _updatedFreeMicroDispDOFValues;
             floatVector _updatedFreeMacroDispDOFValues;
             bool _freeDOFValuesUpdated;
@@ -535,11 +765,24 @@ namespace overlapCoupling{
 
             floatVector FALD, FALQ;
 
+            //The queue of the output jobs. This is declared last so that the queued jobs are completed before
+            //any of the other members are destroyed.
+            outputQueue _outputQueue;
+
     };
 
     errorOut MADOutlierDetection( const floatVector &x, uIntVector &outliers, const floatType threshold = 10,
                                   const floatType eps = 1e-9 );
 
+    errorOut formMicromorphicElementMassMatrix( elib::Element *element,
+                                                const floatVector &degreeOfFreedomValues,
+                                                const floatVector &momentOfInertia,
+                                                const floatVector &density,
+                                                const DOFMap *nodeIDToIndex,
+                                                std::vector< DOFProjection::T > &coefficients,
+                                                const floatVector *arlequinNodalWeights = NULL,
+                                                const bool quantitiesInReference = false );
+
     errorOut formMicromorphicElementMassMatrix( const std::unique_ptr< elib::Element > &element,
                                                 const floatVector &degreeOfFreedomValues,
                                                 const floatVector &momentOfInertia,
@@ -549,6 +792,14 @@ namespace overlapCoupling{
                                                 const floatVector *arlequinNodalWeights = NULL,
                                                 const bool quantitiesInReference = false );
 
+    errorOut formMicromorphicElementInternalForceVector( elib::Element *element,
+                                                         const floatVector &degreeOfFreedomValues,
+                                                         const floatVector &cauchyStress,
+                                                         const floatVector &symmetricMicroStress,
+                                                         const floatVector &higherOrderStress,
+                                                         const DOFMap *nodeIDToIndex,
+                                                         Eigen::MatrixXd &internalForceVector );
+
     errorOut formMicromorphicElementInternalForceVector( const std::unique_ptr< elib::Element > &element,
                                                          const floatVector &degreeOfFreedomValues,
                                                          const floatVector &cauchyStress,
@@ -557,6 +808,17 @@ namespace overlapCoupling{
                                                          const DOFMap *nodeIDToIndex,
                                                          Eigen::MatrixXd &internalForceVector );
 
+    errorOut computeMicromorphicElementRequiredValues( elib::Element *element,
+                                                       const elib::quadrature_rule::iterator &qpt,
+                                                       const uIntType dim,
+                                                       const floatMatrix &reshapedDOFValues,
+                                                       const bool useReference,
+                                                       floatVector &shapeFunctions,
+                                                       floatMatrix &gradShapeFunctions,
+                                                       floatVector &deformationGradient,
+                                                       floatType &J, floatType &Jxw,
+                                                       floatVector &uQpt, floatVector &XiQpt );
+
     errorOut computeMicromorphicElementRequiredValues( const std::unique_ptr< elib::Element > &element,
                                                        const elib::quadrature_rule::iterator &qpt,
                                                        const uIntType dim,
@@ -580,6 +842,50 @@ namespace overlapCoupling{
 
     errorOut readSparseMatrixFromXDMF( const shared_ptr< XdmfUnstructuredGrid > &grid, const std::string &matrixName, SparseMatrix &A );
 
+    errorOut computeLumpedGramDiagonal( const SparseMatrix &N, const Eigen::VectorXd &scale, const floatType &shift,
+                                        Eigen::VectorXd &lumpedDiagonal );
+
+    errorOut copyErrorChain( const errorNode *error );
+
+    class couplingSession{
+        /*!
+         * A long-lived overlap coupling session. The coupling is initialized once when the session
+         * is constructed so the reference state, the interpolation matrix, and the projectors are
+         * retained between the coupling steps.
+         *
+         * Use of the session entails the following:
+         * session = couplingSession( YAML_filename );
+         * session.step( ... ); //Repeated for each coupling step
+         * session.flushOutput( ); //Collect the errors of the output which is written in the background
+         */
+
+        public:
+
+            couplingSession( const std::string &filename );
+
+            errorOut getError( );
+
+            errorOut step( DOFMap &microGlobalLocalNodeMap, floatVector &updatedMicroDisplacementDOF,
+                           floatVector &Lagrangian_FALQ,
+                           DOFMap &macroGlobalLocalNodeMap, floatVector &updatedMacroDisplacementDOF,
+                           floatVector &Lagrangian_FALD );
+
+            errorOut flushOutput( );
+
+            uIntType getStepCount( );
+
+            overlapCoupling *getOverlapCoupling( );
+
+        private:
+
+            std::unique_ptr< overlapCoupling > _overlapCoupling;
+
+            std::unique_ptr< errorNode > _error;
+
+            uIntType _stepCount = 0;
+
+    };
+
     errorOut runOverlapCoupling( const std::string &filename,
                                  DOFMap &microGlobalLocalNodeMap, floatVector &updatedMicroDisplacementDOF,
                                  floatVector &Lagrangian_FALQ,
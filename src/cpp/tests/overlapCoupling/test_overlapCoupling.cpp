@@ -3,6 +3,7 @@
 #include<iostream>
 #include<vector>
 #include<fstream>
+#include<random>
 #include<math.h>
 #include <boost/algorithm/string.hpp>
 #define USE_EIGEN
@@ -6080,6 +6081,508 @@ int test_overlapCoupling_processIncrement( std::ofstream &results ){
     return 0;
 }
 
+int test_overlapCoupling_processIncrement_sparse_l2_projection( std::ofstream &results ){
+    /*!
+     * Test that the implicit sparse L2 projectors give the same projected degrees of freedom
+     * and force vector as the dense L2 projectors and that the truncated projectors, which are
+     * formed in blocks of columns, are the same as the truncated dense projectors
+     *
+     * :param std::ofstream &results: The output file.
+     */
+
+    std::string testName = "overlapCoupling_processIncrement_sparse_l2_projection";
+
+    //Use the dense L2 projection configuration with only the form of the projectors changed
+    YAML::Node config = YAML::LoadFile( "testConfig_l2_projection.yaml" );
+    config[ "coupling_initialization" ][ "l2_projector" ][ "type" ] = "sparse";
+
+    std::ofstream configFile( "testConfig_l2_projection_sparse.yaml" );
+    configFile << config;
+    configFile.close( );
+
+    std::vector< std::string > filenames = { "testConfig_l2_projection.yaml", "testConfig_l2_projection_sparse.yaml" };
+
+    floatVector projectedGhostMicroDisplacements[ 2 ];
+    floatVector projectedGhostMacroDisplacements[ 2 ];
+    Eigen::MatrixXd forces[ 2 ];
+    Eigen::MatrixXd projectors[ 2 ][ 4 ];
+
+    for ( uIntType i = 0; i < 2; i++ ){
+
+        remove( "reference_information.xdmf" );
+        remove( "reference_information.h5" );
+
+        remove( "homogenized_response.xdmf" );
+        remove( "homogenized_response.h5" );
+
+        overlapCoupling::overlapCoupling oc( filenames[ i ] );
+
+        if ( oc.getConstructorError( ) ){
+            oc.getConstructorError( )->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        errorOut error = oc.initializeCoupling( );
+
+        if ( error ){
+            error->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        error = oc.processIncrement( 1, 1 );
+
+        if ( error ){
+            error->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        projectedGhostMicroDisplacements[ i ] = oc._test_initial_projected_ghost_micro_displacement;
+        projectedGhostMacroDisplacements[ i ] = oc._test_initial_projected_ghost_macro_displacement;
+        forces[ i ] = *oc.getFORCE( );
+
+        projectors[ i ][ 0 ] = oc.getSparseBQhatQ( )->toDense( );
+        projectors[ i ][ 1 ] = oc.getSparseBQhatD( )->toDense( );
+        projectors[ i ][ 2 ] = oc.getSparseBDhatQ( )->toDense( );
+        projectors[ i ][ 3 ] = oc.getSparseBDhatD( )->toDense( );
+
+    }
+
+    if ( !vectorTools::fuzzyEquals( projectedGhostMicroDisplacements[ 0 ], projectedGhostMicroDisplacements[ 1 ] ) ){
+
+        results << testName + " (test 1) & False\n";
+        return 1;
+
+    }
+
+    if ( !vectorTools::fuzzyEquals( projectedGhostMacroDisplacements[ 0 ], projectedGhostMacroDisplacements[ 1 ] ) ){
+
+        results << testName + " (test 2) & False\n";
+        return 1;
+
+    }
+
+    if ( !forces[ 0 ].isApprox( forces[ 1 ], 1e-6 ) ){
+
+        results << testName + " (test 3) & False\n";
+        return 1;
+
+    }
+
+    for ( uIntType p = 0; p < 4; p++ ){
+
+        if ( ( projectors[ 0 ][ p ].rows( ) != projectors[ 1 ][ p ].rows( ) ) ||
+             ( projectors[ 0 ][ p ].cols( ) != projectors[ 1 ][ p ].cols( ) ) ||
+             !projectors[ 0 ][ p ].isApprox( projectors[ 1 ][ p ], 1e-6 ) ){
+
+            results << testName + " (test 4) & False\n";
+            return 1;
+
+        }
+
+    }
+
+    remove( "reference_information.xdmf" );
+    remove( "reference_information.h5" );
+
+    remove( "homogenized_response.xdmf" );
+    remove( "homogenized_response.h5" );
+
+    remove( "testConfig_l2_projection_sparse.yaml" );
+
+    results << testName + " & True\n";
+    return 0;
+}
+
+int test_overlapCoupling_freeDOFSolvers( std::ofstream &results ){
+    /*!
+     * Test that the Cholesky and conjugate gradient solvers of the free degree of freedom system give the same
+     * updated free degrees of freedom as the default QR decomposition
+     *
+     * :param std::ofstream &results: The output file.
+     */
+
+    std::string testName = "overlapCoupling_freeDOFSolvers";
+
+    std::vector< std::pair< std::string, std::string > > solvers = { { "qr", "diagonal" },
+                                                                     { "ldlt", "diagonal" },
+                                                                     { "llt", "diagonal" },
+                                                                     { "cg", "diagonal" },
+                                                                     { "cg", "incomplete_cholesky" } };
+
+    std::string filename = "testConfig_l2_projection_free_dof_solver.yaml";
+
+    floatVector answerMicroDOF, answerMacroDOF;
+
+    for ( auto solver = solvers.begin( ); solver != solvers.end( ); solver++ ){
+
+        YAML::Node config = YAML::LoadFile( "testConfig_l2_projection.yaml" );
+        config[ "coupling_initialization" ][ "free_dof_solver" ][ "type" ] = solver->first;
+        config[ "coupling_initialization" ][ "free_dof_solver" ][ "preconditioner" ] = solver->second;
+        config[ "coupling_initialization" ][ "free_dof_solver" ][ "tolerance" ] = 1e-12;
+        config[ "coupling_initialization" ][ "free_dof_solver" ][ "max_iterations" ] = 1000;
+
+        std::ofstream configFile( filename );
+        configFile << config;
+        configFile.close( );
+
+        remove( "reference_information.xdmf" );
+        remove( "reference_information.h5" );
+
+        remove( "homogenized_response.xdmf" );
+        remove( "homogenized_response.h5" );
+
+        overlapCoupling::overlapCoupling oc( filename );
+
+        if ( oc.getConstructorError( ) ){
+            oc.getConstructorError( )->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        errorOut error = oc.initializeCoupling( );
+
+        if ( error ){
+            error->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        error = oc.processIncrement( 1, 1 );
+
+        if ( error ){
+            error->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        if ( solver == solvers.begin( ) ){
+
+            answerMicroDOF = *oc.getUpdatedFreeMicroDispDOFValues( );
+            answerMacroDOF = *oc.getUpdatedFreeMacroDispDOFValues( );
+
+            continue;
+
+        }
+
+        if ( !vectorTools::fuzzyEquals( *oc.getUpdatedFreeMicroDispDOFValues( ), answerMicroDOF ) ){
+
+            std::cerr << "ERROR: The free micro DOF of the " + solver->first + " solver do not match the QR solver\n";
+            results << testName + " & False\n";
+            return 1;
+
+        }
+
+        if ( !vectorTools::fuzzyEquals( *oc.getUpdatedFreeMacroDispDOFValues( ), answerMacroDOF ) ){
+
+            std::cerr << "ERROR: The free macro DOF of the " + solver->first + " solver do not match the QR solver\n";
+            results << testName + " & False\n";
+            return 1;
+
+        }
+
+    }
+
+    remove( "reference_information.xdmf" );
+    remove( "reference_information.h5" );
+
+    remove( "homogenized_response.xdmf" );
+    remove( "homogenized_response.h5" );
+
+    remove( filename.c_str( ) );
+
+    results << testName + " & True\n";
+    return 0;
+}
+
+bool compareCellDomainValues( const overlapCoupling::cellDomainFloatMap &a, const overlapCoupling::cellDomainFloatMap &b ){
+    /*!
+     * Check that the values of two cell domain maps are equal
+     *
+     * :param const overlapCoupling::cellDomainFloatMap &a: The first map
+     * :param const overlapCoupling::cellDomainFloatMap &b: The second map
+     */
+
+    if ( a.size( ) != b.size( ) ){ return false; }
+
+    for ( auto cell = a.begin( ); cell != a.end( ); cell++ ){
+
+        auto otherCell = b.find( cell->first );
+        if ( ( otherCell == b.end( ) ) || ( otherCell->second.size( ) != cell->second.size( ) ) ){ return false; }
+
+        for ( auto domain = cell->second.begin( ); domain != cell->second.end( ); domain++ ){
+
+            auto otherDomain = otherCell->second.find( domain->first );
+            if ( ( otherDomain == otherCell->second.end( ) ) || !vectorTools::fuzzyEquals( domain->second, otherDomain->second ) ){ return false; }
+
+        }
+
+    }
+
+    return true;
+}
+
+bool compareCellDomainValues( const overlapCoupling::cellDomainFloatVectorMap &a, const overlapCoupling::cellDomainFloatVectorMap &b ){
+    /*!
+     * Check that the values of two cell domain maps are equal
+     *
+     * :param const overlapCoupling::cellDomainFloatVectorMap &a: The first map
+     * :param const overlapCoupling::cellDomainFloatVectorMap &b: The second map
+     */
+
+    if ( a.size( ) != b.size( ) ){ return false; }
+
+    for ( auto cell = a.begin( ); cell != a.end( ); cell++ ){
+
+        auto otherCell = b.find( cell->first );
+        if ( ( otherCell == b.end( ) ) || ( otherCell->second.size( ) != cell->second.size( ) ) ){ return false; }
+
+        for ( auto domain = cell->second.begin( ); domain != cell->second.end( ); domain++ ){
+
+            auto otherDomain = otherCell->second.find( domain->first );
+            if ( ( otherDomain == otherCell->second.end( ) ) || !vectorTools::fuzzyEquals( domain->second, otherDomain->second ) ){ return false; }
+
+        }
+
+    }
+
+    return true;
+}
+
+int test_overlapCoupling_homogenizationThreadCount( std::ofstream &results ){
+    /*!
+     * Test that the homogenized values and the force vector do not depend on the number of threads
+     * used in the homogenization of the micro domains
+     *
+     * :param std::ofstream &results: The output file.
+     */
+
+    std::string testName = "overlapCoupling_homogenizationThreadCount";
+
+    std::string filename = "testConfig_l2_projection_threads.yaml";
+
+    std::vector< uIntType > threadCounts = { 1, 4 };
+
+    overlapCoupling::cellDomainFloatMap volumes[ 2 ], densities[ 2 ], surfaceAreas[ 2 ];
+    overlapCoupling::cellDomainFloatVectorMap centersOfMass[ 2 ], stresses[ 2 ], tractions[ 2 ];
+    Eigen::MatrixXd forces[ 2 ];
+
+    for ( uIntType i = 0; i < threadCounts.size( ); i++ ){
+
+        YAML::Node config = YAML::LoadFile( "testConfig_l2_projection.yaml" );
+        config[ "coupling_initialization" ][ "homogenization_thread_count" ] = threadCounts[ i ];
+
+        std::ofstream configFile( filename );
+        configFile << config;
+        configFile.close( );
+
+        remove( "reference_information.xdmf" );
+        remove( "reference_information.h5" );
+
+        remove( "homogenized_response.xdmf" );
+        remove( "homogenized_response.h5" );
+
+        overlapCoupling::overlapCoupling oc( filename );
+
+        if ( oc.getConstructorError( ) ){
+            oc.getConstructorError( )->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        errorOut error = oc.initializeCoupling( );
+
+        if ( error ){
+            error->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        error = oc.processIncrement( 1, 1 );
+
+        if ( error ){
+            error->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        volumes[ i ] = *oc.getHomogenizedVolumes( );
+        densities[ i ] = *oc.getHomogenizedDensities( );
+        surfaceAreas[ i ] = *oc.getHomogenizedSurfaceAreas( );
+        centersOfMass[ i ] = *oc.getHomogenizedCentersOfMass( );
+        stresses[ i ] = *oc.getHomogenizedSymmetricMicroStresses( );
+        tractions[ i ] = *oc.getHomogenizedSurfaceRegionTractions( );
+        forces[ i ] = *oc.getFORCE( );
+
+    }
+
+    if ( ( volumes[ 0 ].size( ) == 0 ) || !compareCellDomainValues( volumes[ 0 ], volumes[ 1 ] ) ){
+
+        results << testName + " (test 1) & False\n";
+        return 1;
+
+    }
+
+    if ( !compareCellDomainValues( densities[ 0 ], densities[ 1 ] ) ){
+
+        results << testName + " (test 2) & False\n";
+        return 1;
+
+    }
+
+    if ( !compareCellDomainValues( surfaceAreas[ 0 ], surfaceAreas[ 1 ] ) ){
+
+        results << testName + " (test 3) & False\n";
+        return 1;
+
+    }
+
+    if ( !compareCellDomainValues( centersOfMass[ 0 ], centersOfMass[ 1 ] ) ){
+
+        results << testName + " (test 4) & False\n";
+        return 1;
+
+    }
+
+    if ( !compareCellDomainValues( stresses[ 0 ], stresses[ 1 ] ) ){
+
+        results << testName + " (test 5) & False\n";
+        return 1;
+
+    }
+
+    if ( !compareCellDomainValues( tractions[ 0 ], tractions[ 1 ] ) ){
+
+        results << testName + " (test 6) & False\n";
+        return 1;
+
+    }
+
+    if ( !forces[ 0 ].isApprox( forces[ 1 ], 1e-12 ) ){
+
+        results << testName + " (test 7) & False\n";
+        return 1;
+
+    }
+
+    remove( "reference_information.xdmf" );
+    remove( "reference_information.h5" );
+
+    remove( "homogenized_response.xdmf" );
+    remove( "homogenized_response.h5" );
+
+    remove( filename.c_str( ) );
+
+    results << testName + " & True\n";
+    return 0;
+}
+
+int test_overlapCoupling_sparse_l2_projection_from_file( std::ofstream &results ){
+    /*!
+     * Test that the sparse L2 projectors written to the reference information file
+     * are recovered when the coupling is initialized from the file
+     *
+     * :param std::ofstream &results: The output file.
+     */
+
+    std::string testName = "overlapCoupling_sparse_l2_projection_from_file";
+
+    remove( "reference_information.xdmf" );
+    remove( "reference_information.h5" );
+
+    remove( "homogenized_response.xdmf" );
+    remove( "homogenized_response.h5" );
+
+    //Form the sparse projectors and write them to the reference information file
+    YAML::Node config = YAML::LoadFile( "testConfig_l2_projection.yaml" );
+    config[ "coupling_initialization" ][ "l2_projector" ][ "type" ] = "sparse";
+
+    std::ofstream configFile( "testConfig_l2_projection_sparse.yaml" );
+    configFile << config;
+    configFile.close( );
+
+    //Read the projectors from the reference information file
+    config[ "coupling_initialization" ][ "type" ] = "from_file";
+    config[ "coupling_initialization" ].remove( "output_reference_information" );
+    config[ "coupling_initialization" ].remove( "output_homogenized_response" );
+    config[ "coupling_initialization" ][ "reference_filename" ] = "reference_information.xdmf";
+
+    configFile.open( "testConfig_l2_projection_from_file.yaml" );
+    configFile << config;
+    configFile.close( );
+
+    std::vector< std::string > filenames = { "testConfig_l2_projection_sparse.yaml", "testConfig_l2_projection_from_file.yaml" };
+
+    SparseMatrix BQhatQ[ 2 ], BQhatD[ 2 ], BDhatQ[ 2 ], BDhatD[ 2 ];
+
+    for ( uIntType i = 0; i < 2; i++ ){
+
+        overlapCoupling::overlapCoupling oc( filenames[ i ] );
+
+        if ( oc.getConstructorError( ) ){
+            oc.getConstructorError( )->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        errorOut error = oc.initializeCoupling( );
+
+        if ( error ){
+            error->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        BQhatQ[ i ] = *oc.getSparseBQhatQ( );
+        BQhatD[ i ] = *oc.getSparseBQhatD( );
+        BDhatQ[ i ] = *oc.getSparseBDhatQ( );
+        BDhatD[ i ] = *oc.getSparseBDhatD( );
+
+    }
+
+    if ( ( BQhatQ[ 0 ].nonZeros( ) == 0 ) || !BQhatQ[ 0 ].toDense( ).isApprox( BQhatQ[ 1 ].toDense( ) ) ){
+
+        results << testName + " (test 1) & False\n";
+        return 1;
+
+    }
+
+    if ( ( BQhatD[ 0 ].nonZeros( ) == 0 ) || !BQhatD[ 0 ].toDense( ).isApprox( BQhatD[ 1 ].toDense( ) ) ){
+
+        results << testName + " (test 2) & False\n";
+        return 1;
+
+    }
+
+    if ( ( BDhatQ[ 0 ].nonZeros( ) == 0 ) || !BDhatQ[ 0 ].toDense( ).isApprox( BDhatQ[ 1 ].toDense( ) ) ){
+
+        results << testName + " (test 3) & False\n";
+        return 1;
+
+    }
+
+    if ( ( BDhatD[ 0 ].nonZeros( ) == 0 ) || !BDhatD[ 0 ].toDense( ).isApprox( BDhatD[ 1 ].toDense( ) ) ){
+
+        results << testName + " (test 4) & False\n";
+        return 1;
+
+    }
+
+    remove( "reference_information.xdmf" );
+    remove( "reference_information.h5" );
+
+    remove( "homogenized_response.xdmf" );
+    remove( "homogenized_response.h5" );
+
+    remove( "testConfig_l2_projection_sparse.yaml" );
+    remove( "testConfig_l2_projection_from_file.yaml" );
+
+    results << testName + " & True\n";
+    return 0;
+}
+
 int test_overlapCoupling_processIncrement_Arlequin( std::ofstream &results ){
     /*!
      * Test processing an increment using the Arlequin method
@@ -9112,15 +9615,240 @@ int test_overlapCoupling_runOverlapCoupling_Arlequin_realistic( std::ofstream &r
 
     if ( error ){
         error->print( );
-        results << "test_overlapCoupling_runOverlapCoupling_Arlequin_realistic & False\n";
+        results << "test_overlapCoupling_runOverlapCoupling_Arlequin_realistic & False\n";
+        return 1;
+    }
+
+    std::cout << "updated micro displacement DOF Result:\n";
+    vectorTools::print(updatedMicroDisplacementDOFResult);
+    std::cout << "\n";
+    std::cout << "updated macro displacement DOF Result:\n";
+    vectorTools::print(updatedMacroDisplacementDOFResult);
+
+    remove( "macroscale_dof.xdmf" );
+    remove( "macroscale_dof.h5" );
+
+    remove( "microscale_dof.xdmf" );
+    remove( "microscale_dof.h5" );
+
+    results << "test_overlapCoupling_runOverlapCoupling_Arlequin_realistic & True\n";
+    return 0;
+}
+
+int test_overlapCoupling_couplingSession( std::ofstream &results ){
+    /*!
+     * Test the persistent coupling session. Repeated steps on unchanged data files should
+     * give the same result as the one-shot runOverlapCoupling.
+     *
+     * :param std::ofstream &results: The output file
+     */
+
+    remove( "reference_information.xdmf" );
+    remove( "reference_information.h5" );
+
+    remove( "homogenized_response.xdmf" );
+    remove( "homogenized_response.h5" );
+
+    remove( "macroscale_dof.xdmf" );
+    remove( "macroscale_dof.h5" );
+
+    remove( "microscale_dof.xdmf" );
+    remove( "microscale_dof.h5" );
+
+    //Use the sparse L2 projection configuration which has the updated DOF output enabled
+    YAML::Node config = YAML::LoadFile( "testConfig_l2_projection.yaml" );
+    config[ "coupling_initialization" ][ "l2_projector" ][ "type" ] = "sparse";
+
+    std::ofstream configFile( "testConfig_l2_projection_sparse.yaml" );
+    configFile << config;
+    configFile.close( );
+
+    std::string filename = "testConfig_l2_projection_sparse.yaml";
+
+    std::unordered_map< uIntType, uIntType > microGlobalLocalNodeMapAnswer, microGlobalLocalNodeMapResult;
+    std::unordered_map< uIntType, uIntType > macroGlobalLocalNodeMapAnswer, macroGlobalLocalNodeMapResult;
+
+    floatVector updatedMicroDisplacementDOFAnswer, updatedMicroDisplacementDOFResult;
+    floatVector updatedMacroDisplacementDOFAnswer, updatedMacroDisplacementDOFResult;
+
+    floatVector microAugmentedLagrangianForceAnswer, microAugmentedLagrangianForceResult;
+    floatVector macroAugmentedLagrangianForceAnswer, macroAugmentedLagrangianForceResult;
+
+    errorOut error = overlapCoupling::runOverlapCoupling( filename,
+                                                          microGlobalLocalNodeMapAnswer, updatedMicroDisplacementDOFAnswer,
+                                                          microAugmentedLagrangianForceAnswer,
+                                                          macroGlobalLocalNodeMapAnswer, updatedMacroDisplacementDOFAnswer,
+                                                          macroAugmentedLagrangianForceAnswer
+                                                        );
+
+    if ( error ){
+        error->print( );
+        results << "test_overlapCoupling_couplingSession & False\n";
+        return 1;
+    }
+
+    overlapCoupling::couplingSession session( filename );
+
+    if ( session.getError( ) ){
+        session.getError( )->print( );
+        results << "test_overlapCoupling_couplingSession & False\n";
+        return 1;
+    }
+
+    for ( uIntType i = 0; i < 2; i++ ){
+
+        error = session.step( microGlobalLocalNodeMapResult, updatedMicroDisplacementDOFResult,
+                              microAugmentedLagrangianForceResult,
+                              macroGlobalLocalNodeMapResult, updatedMacroDisplacementDOFResult,
+                              macroAugmentedLagrangianForceResult );
+
+        if ( error ){
+            error->print( );
+            results << "test_overlapCoupling_couplingSession (" + std::to_string( i + 1 ) + ") & False\n";
+            return 1;
+        }
+
+        if ( microGlobalLocalNodeMapResult != microGlobalLocalNodeMapAnswer ){
+            results << "test_overlapCoupling_couplingSession (" + std::to_string( i + 1 ) + ") & False\n";
+            return 1;
+        }
+
+        if ( macroGlobalLocalNodeMapResult != macroGlobalLocalNodeMapAnswer ){
+            results << "test_overlapCoupling_couplingSession (" + std::to_string( i + 1 ) + ") & False\n";
+            return 1;
+        }
+
+        if ( !vectorTools::fuzzyEquals( updatedMicroDisplacementDOFResult, updatedMicroDisplacementDOFAnswer ) ){
+            results << "test_overlapCoupling_couplingSession (" + std::to_string( i + 1 ) + ") & False\n";
+            return 1;
+        }
+
+        if ( !vectorTools::fuzzyEquals( updatedMacroDisplacementDOFResult, updatedMacroDisplacementDOFAnswer ) ){
+            results << "test_overlapCoupling_couplingSession (" + std::to_string( i + 1 ) + ") & False\n";
+            return 1;
+        }
+
+        if ( !vectorTools::fuzzyEquals( microAugmentedLagrangianForceResult, microAugmentedLagrangianForceAnswer ) ){
+            results << "test_overlapCoupling_couplingSession (" + std::to_string( i + 1 ) + ") & False\n";
+            return 1;
+        }
+
+        if ( !vectorTools::fuzzyEquals( macroAugmentedLagrangianForceResult, macroAugmentedLagrangianForceAnswer ) ){
+            results << "test_overlapCoupling_couplingSession (" + std::to_string( i + 1 ) + ") & False\n";
+            return 1;
+        }
+
+    }
+
+    if ( session.getStepCount( ) != 2 ){
+        results << "test_overlapCoupling_couplingSession (3) & False\n";
+        return 1;
+    }
+
+    //Reloading the data files and initializing the increment re-uses the cached micro domain membership
+    inputFileProcessor::inputFileProcessor *inputProcessor = session.getOverlapCoupling( )->_test_getInputProcessor( );
+
+    uIntVector membershipOffsets = *inputProcessor->getMicroDomainMembershipOffsets( );
+    uIntVector membershipNodes = *inputProcessor->getMicroDomainMembershipNodes( );
+    const uIntType *membershipData = inputProcessor->getMicroDomainMembershipNodes( )->data( );
+
+    error = session.getOverlapCoupling( )->reloadDataFiles( );
+
+    if ( error ){
+        error->print( );
+        results << "test_overlapCoupling_couplingSession (4) & False\n";
+        return 1;
+    }
+
+    uIntType numMicroIncrements, numMacroIncrements;
+
+    error = inputProcessor->_microscale->getNumIncrements( numMicroIncrements );
+
+    if ( error ){
+        error->print( );
+        results << "test_overlapCoupling_couplingSession (5) & False\n";
+        return 1;
+    }
+
+    error = inputProcessor->_macroscale->getNumIncrements( numMacroIncrements );
+
+    if ( error ){
+        error->print( );
+        results << "test_overlapCoupling_couplingSession (6) & False\n";
+        return 1;
+    }
+
+    error = inputProcessor->initializeIncrement( numMicroIncrements - 1, numMacroIncrements - 1 );
+
+    if ( error ){
+        error->print( );
+        results << "test_overlapCoupling_couplingSession (7) & False\n";
+        return 1;
+    }
+
+    if ( ( *inputProcessor->getMicroDomainMembershipOffsets( ) != membershipOffsets ) ||
+         ( *inputProcessor->getMicroDomainMembershipNodes( ) != membershipNodes ) ||
+         ( inputProcessor->getMicroDomainMembershipNodes( )->data( ) != membershipData ) ){
+        results << "test_overlapCoupling_couplingSession (8) & False\n";
+        return 1;
+    }
+
+    uIntVector domainNodesAnswer, domainNodesResult;
+    for ( auto domainNames : { inputProcessor->getFreeMicroDomainNames( ), inputProcessor->getGhostMicroDomainNames( ) } ){
+
+        for ( auto domain = domainNames->begin( ); domain != domainNames->end( ); domain++ ){
+
+            error = inputProcessor->_microscale->getSubDomainNodes( numMicroIncrements - 1, *domain, domainNodesAnswer );
+
+            if ( error ){
+                error->print( );
+                results << "test_overlapCoupling_couplingSession (9) & False\n";
+                return 1;
+            }
+
+            error = inputProcessor->getMicroDomainNodes( numMicroIncrements - 1, *domain, domainNodesResult );
+
+            if ( error || ( domainNodesResult != domainNodesAnswer ) ){
+                results << "test_overlapCoupling_couplingSession (10) & False\n";
+                return 1;
+            }
+
+        }
+
+    }
+
+    //A step after the reload gives the same result
+    error = session.step( microGlobalLocalNodeMapResult, updatedMicroDisplacementDOFResult,
+                          microAugmentedLagrangianForceResult,
+                          macroGlobalLocalNodeMapResult, updatedMacroDisplacementDOFResult,
+                          macroAugmentedLagrangianForceResult );
+
+    if ( error ){
+        error->print( );
+        results << "test_overlapCoupling_couplingSession (11) & False\n";
+        return 1;
+    }
+
+    if ( !vectorTools::fuzzyEquals( updatedMicroDisplacementDOFResult, updatedMicroDisplacementDOFAnswer ) ||
+         !vectorTools::fuzzyEquals( updatedMacroDisplacementDOFResult, updatedMacroDisplacementDOFAnswer ) ){
+        results << "test_overlapCoupling_couplingSession (12) & False\n";
+        return 1;
+    }
+
+    //The output of all of the steps is written without error
+    error = session.flushOutput( );
+
+    if ( error ){
+        error->print( );
+        results << "test_overlapCoupling_couplingSession (13) & False\n";
         return 1;
     }
 
-    std::cout << "updated micro displacement DOF Result:\n";
-    vectorTools::print(updatedMicroDisplacementDOFResult);
-    std::cout << "\n";
-    std::cout << "updated macro displacement DOF Result:\n";
-    vectorTools::print(updatedMacroDisplacementDOFResult);
+    remove( "reference_information.xdmf" );
+    remove( "reference_information.h5" );
+
+    remove( "homogenized_response.xdmf" );
+    remove( "homogenized_response.h5" );
 
     remove( "macroscale_dof.xdmf" );
     remove( "macroscale_dof.h5" );
@@ -9128,7 +9856,9 @@ int test_overlapCoupling_runOverlapCoupling_Arlequin_realistic( std::ofstream &r
     remove( "microscale_dof.xdmf" );
     remove( "microscale_dof.h5" );
 
-    results << "test_overlapCoupling_runOverlapCoupling_Arlequin_realistic & True\n";
+    remove( "testConfig_l2_projection_sparse.yaml" );
+
+    results << "test_overlapCoupling_couplingSession & True\n";
     return 0;
 }
 
@@ -9813,6 +10543,416 @@ int test_overlapCoupling_filterMode( std::ofstream &results ){
     return 0;
 }
 
+int test_overlapCoupling_factorizeFreeDOFLHS( std::ofstream &results ){
+    /*!
+     * Test that the factorization of the free degree of freedom LHS matrix is re-used when the
+     * matrix is unchanged and recomputed when its values or pattern change
+     *
+     * :param std::ofstream &results: The output file
+     */
+
+    std::string testName = "overlapCoupling_factorizeFreeDOFLHS";
+
+    overlapCoupling::overlapCoupling oc( "testConfig_l2_projection.yaml" );
+
+    if ( oc.getConstructorError( ) ){
+        oc.getConstructorError( )->print( );
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    std::vector< Eigen::Triplet< floatType > > coefficients;
+    for ( int i = 0; i < 4; i++ ){
+
+        coefficients.push_back( Eigen::Triplet< floatType >( i, i, 4. ) );
+
+        if ( i > 0 ){
+
+            coefficients.push_back( Eigen::Triplet< floatType >( i, i - 1, -1. ) );
+            coefficients.push_back( Eigen::Triplet< floatType >( i - 1, i, -1. ) );
+
+        }
+
+    }
+
+    SparseMatrix LHS( 4, 4 );
+    LHS.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
+    LHS.makeCompressed( );
+
+    errorOut error = oc._test_factorizeFreeDOFLHS( LHS );
+
+    if ( error ){
+        error->print( );
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    //An identical matrix re-uses the factorization
+    SparseMatrix sameLHS = LHS;
+
+    error = oc._test_factorizeFreeDOFLHS( sameLHS );
+
+    if ( error ){
+        error->print( );
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    if ( ( oc._test_freeDOFLHSAnalysisCount != 1 ) || ( oc._test_freeDOFLHSFactorizationCount != 1 ) ){
+        std::cerr << "ERROR: The factorization of an identical matrix was not re-used\n";
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    //A change in the values repeats the numeric factorization only
+    SparseMatrix changedLHS = LHS;
+    changedLHS.coeffRef( 2, 2 ) += 1e-12;
+
+    error = oc._test_factorizeFreeDOFLHS( changedLHS );
+
+    if ( error ){
+        error->print( );
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    if ( ( oc._test_freeDOFLHSAnalysisCount != 1 ) || ( oc._test_freeDOFLHSFactorizationCount != 2 ) ){
+        std::cerr << "ERROR: The matrix was not refactorized after its values changed\n";
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    //A change in the pattern repeats the analysis
+    coefficients.push_back( Eigen::Triplet< floatType >( 0, 3, 0.5 ) );
+    coefficients.push_back( Eigen::Triplet< floatType >( 3, 0, 0.5 ) );
+
+    SparseMatrix newPatternLHS( 4, 4 );
+    newPatternLHS.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
+    newPatternLHS.makeCompressed( );
+
+    error = oc._test_factorizeFreeDOFLHS( newPatternLHS );
+
+    if ( error ){
+        error->print( );
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    if ( ( oc._test_freeDOFLHSAnalysisCount != 2 ) || ( oc._test_freeDOFLHSFactorizationCount != 3 ) ){
+        std::cerr << "ERROR: The matrix was not re-analyzed after its pattern changed\n";
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    results << testName + " & True\n";
+    return 0;
+}
+
+int test_overlapCoupling_factorizeFreeDOFLHS_checkSPD( std::ofstream &results ){
+    /*!
+     * Test that the conjugate gradient solvers fall back to the QR decomposition when 'check_spd' is set and
+     * the LHS matrix has a non-positive diagonal entry
+     *
+     * :param std::ofstream &results: The output file
+     */
+
+    std::string testName = "overlapCoupling_factorizeFreeDOFLHS_checkSPD";
+
+    std::vector< std::string > preconditioners = { "diagonal", "incomplete_cholesky" };
+
+    std::string filename = "testConfig_l2_projection_check_spd.yaml";
+
+    for ( auto preconditioner = preconditioners.begin( ); preconditioner != preconditioners.end( ); preconditioner++ ){
+
+        YAML::Node config = YAML::LoadFile( "testConfig_l2_projection.yaml" );
+        config[ "coupling_initialization" ][ "free_dof_solver" ][ "type" ] = "cg";
+        config[ "coupling_initialization" ][ "free_dof_solver" ][ "preconditioner" ] = *preconditioner;
+        config[ "coupling_initialization" ][ "free_dof_solver" ][ "check_spd" ] = true;
+
+        std::ofstream configFile( filename );
+        configFile << config;
+        configFile.close( );
+
+        overlapCoupling::overlapCoupling oc( filename );
+
+        if ( oc.getConstructorError( ) ){
+            oc.getConstructorError( )->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        overlapCoupling::freeDOFSolver cgSolver = overlapCoupling::freeDOFSolvers.at( "cg_" + *preconditioner );
+
+        std::vector< Eigen::Triplet< floatType > > coefficients;
+        for ( int i = 0; i < 4; i++ ){
+
+            coefficients.push_back( Eigen::Triplet< floatType >( i, i, 4. ) );
+
+            if ( i > 0 ){
+
+                coefficients.push_back( Eigen::Triplet< floatType >( i, i - 1, -1. ) );
+                coefficients.push_back( Eigen::Triplet< floatType >( i - 1, i, -1. ) );
+
+            }
+
+        }
+
+        SparseMatrix LHS( 4, 4 );
+        LHS.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
+        LHS.makeCompressed( );
+
+        //A symmetric positive definite matrix uses the requested solver
+        errorOut error = oc._test_factorizeFreeDOFLHS( LHS );
+
+        if ( error ){
+            error->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        if ( oc._test_getFreeDOFLHSActiveSolver( ) != cgSolver ){
+            results << testName + " (test 1) & False\n";
+            return 1;
+        }
+
+        //A symmetric matrix with a negative diagonal entry falls back to the QR decomposition
+        SparseMatrix indefiniteLHS = LHS;
+        indefiniteLHS.coeffRef( 1, 1 ) = -4.;
+
+        error = oc._test_factorizeFreeDOFLHS( indefiniteLHS );
+
+        if ( error ){
+            error->print( );
+            results << testName + " & False\n";
+            return 1;
+        }
+
+        if ( oc._test_getFreeDOFLHSActiveSolver( ) != overlapCoupling::SPARSE_QR ){
+            results << testName + " (test 2) & False\n";
+            return 1;
+        }
+
+    }
+
+    results << testName + " & True\n";
+    return 0;
+}
+
+int test_computeLumpedGramDiagonal( std::ofstream &results ){
+    /*!
+     * Test the computation of the row sums of N diag( scale ) N^T + shift I without forming the product
+     *
+     * :param std::ofstream &results: The output file
+     */
+
+    std::string testName = "computeLumpedGramDiagonal";
+
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution< floatType > value( -1, 1 );
+    std::uniform_real_distribution< floatType > fill( 0, 1 );
+
+    //Form a small random sparse matrix with roughly a third of the entries filled
+    std::vector< Eigen::Triplet< floatType > > coefficients;
+    for ( int i = 0; i < 7; i++ ){
+
+        for ( int j = 0; j < 5; j++ ){
+
+            if ( fill( generator ) < 0.35 ){
+
+                coefficients.push_back( Eigen::Triplet< floatType >( i, j, value( generator ) ) );
+
+            }
+
+        }
+
+    }
+
+    SparseMatrix N( 7, 5 );
+    N.setFromTriplets( coefficients.begin( ), coefficients.end( ) );
+    N.makeCompressed( );
+
+    Eigen::VectorXd AD( 5 );
+    for ( int j = 0; j < AD.size( ); j++ ){
+
+        AD( j ) = 1 + fill( generator );
+
+    }
+
+    //The row sums of N diag( AD ) N^T
+    Eigen::VectorXd answer = ( N * AD.asDiagonal( ) * N.transpose( ) ) * Eigen::VectorXd::Ones( N.rows( ) );
+
+    Eigen::VectorXd result;
+    errorOut error = overlapCoupling::computeLumpedGramDiagonal( N, AD, 0, result );
+
+    if ( error ){
+        error->print( );
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    if ( !result.isApprox( answer ) ){
+        results << testName + " (test 1) & False\n";
+        return 1;
+    }
+
+    //The row sums of N N^T + I
+    SparseMatrix I( N.rows( ), N.rows( ) );
+    I.setIdentity( );
+
+    answer = ( SparseMatrix( N * N.transpose( ) ) + I ) * Eigen::VectorXd::Ones( N.rows( ) );
+
+    error = overlapCoupling::computeLumpedGramDiagonal( N, Eigen::VectorXd::Ones( N.cols( ) ), 1, result );
+
+    if ( error ){
+        error->print( );
+        results << testName + " & False\n";
+        return 1;
+    }
+
+    if ( !result.isApprox( answer ) ){
+        results << testName + " (test 2) & False\n";
+        return 1;
+    }
+
+    //A scaling of the wrong size is an error
+    error = overlapCoupling::computeLumpedGramDiagonal( N, Eigen::VectorXd::Ones( N.rows( ) ), 0, result );
+
+    if ( !error ){
+        results << testName + " (test 3) & False\n";
+        return 1;
+    }
+
+    results << testName + " & True\n";
+    return 0;
+}
+
+int test_outputQueue( std::ofstream &results ){
+    /*!
+     * Test the queue of the output jobs
+     *
+     * :param std::ofstream &results: The output file
+     */
+
+    overlapCoupling::outputQueue queue;
+
+    std::vector< uIntType > order;
+
+    //The jobs of a synchronous queue are run immediately
+    errorOut error = queue.push( [ &order ]( ) -> errorOut{ order.push_back( 0 ); return NULL; } );
+
+    if ( error ){
+        error->print( );
+        results << "test_outputQueue (test 1) & False\n";
+        return 1;
+    }
+
+    if ( queue.isAsynchronous( ) || ( order.size( ) != 1 ) ){
+        results << "test_outputQueue (test 2) & False\n";
+        return 1;
+    }
+
+    error = queue.setCapacity( 2 );
+
+    if ( error ){
+        error->print( );
+        results << "test_outputQueue (test 3) & False\n";
+        return 1;
+    }
+
+    //The jobs of an asynchronous queue are run in order
+    for ( uIntType i = 1; i < 10; i++ ){
+
+        std::vector< floatType > data( 100, i );
+
+        error = queue.push( [ &order, data ]( ) -> errorOut{ order.push_back( ( uIntType )data[ 0 ] ); return NULL; } );
+
+        if ( error ){
+            error->print( );
+            results << "test_outputQueue (test 4) & False\n";
+            return 1;
+        }
+
+    }
+
+    error = queue.flush( );
+
+    if ( error ){
+        error->print( );
+        results << "test_outputQueue (test 5) & False\n";
+        return 1;
+    }
+
+    for ( uIntType i = 0; i < 10; i++ ){
+
+        if ( ( order.size( ) != 10 ) || ( order[ i ] != i ) ){
+            results << "test_outputQueue (test 6) & False\n";
+            return 1;
+        }
+
+    }
+
+    //The first error is returned by the fence and the jobs after it are discarded
+    error = queue.push( [ ]( ) -> errorOut{ return new errorNode( "job", "Expected failure" ); } );
+
+    if ( error ){
+        error->print( );
+        results << "test_outputQueue (test 7) & False\n";
+        return 1;
+    }
+
+    std::unique_ptr< errorNode > flushError( queue.flush( ) );
+
+    if ( !flushError ){
+        results << "test_outputQueue (test 8) & False\n";
+        return 1;
+    }
+
+    //The error is returned until it is reset
+    for ( uIntType i = 0; i < 2; i++ ){
+
+        std::unique_ptr< errorNode > pushError( queue.push( [ &order ]( ) -> errorOut{ order.push_back( 100 ); return NULL; } ) );
+
+        if ( !pushError || !pushError->_next || ( pushError->_next->_error != "Expected failure" ) ){
+            results << "test_outputQueue (test 11) & False\n";
+            return 1;
+        }
+
+        flushError.reset( queue.flush( ) );
+
+        if ( !flushError || !flushError->_next || ( flushError->_next->_error != "Expected failure" ) ){
+            results << "test_outputQueue (test 12) & False\n";
+            return 1;
+        }
+
+    }
+
+    if ( order.size( ) != 10 ){
+        results << "test_outputQueue (test 13) & False\n";
+        return 1;
+    }
+
+    //The queue may be used again once the error has been reset
+    queue.resetError( );
+
+    error = queue.push( [ &order ]( ) -> errorOut{ order.push_back( 10 ); return NULL; } );
+
+    if ( error ){
+        error->print( );
+        results << "test_outputQueue (test 9) & False\n";
+        return 1;
+    }
+
+    error = queue.flush( );
+
+    if ( error || ( order.size( ) != 11 ) ){
+        results << "test_outputQueue (test 10) & False\n";
+        return 1;
+    }
+
+    results << "test_outputQueue & True\n";
+    return 0;
+}
+
 int main(){
     /*!
     The main loop which runs the tests defined in the 
@@ -9841,6 +10981,10 @@ int main(){
 //    test_overlapCoupling_initializeCoupling_Arlequin( results );
 //    test_overlapCoupling_initializeCoupling_Arlequin_reconstructed( results );
 //    test_overlapCoupling_processIncrement( results );
+    test_overlapCoupling_processIncrement_sparse_l2_projection( results );
+    test_overlapCoupling_sparse_l2_projection_from_file( results );
+    test_overlapCoupling_freeDOFSolvers( results );
+    test_overlapCoupling_homogenizationThreadCount( results );
 //    test_overlapCoupling_processIncrement_Arlequin( results );
 //    test_overlapCoupling_processLastIncrements( results );
 ////    test_overlapCoupling_getReferenceFreeMicroDomainMasses( results );
@@ -9850,7 +10994,12 @@ int main(){
 //////    test_overlapCoupling_getReferenceFreeMicroDomainCenterOfMassShapeFunctions( results );
 //////    test_overlapCoupling_getReferenceGhostMicroDomainCenterOfMassShapeFunctions( results );
 //    test_overlapCoupling_runOverlapCoupling_Arlequin_realistic( results );
+    test_overlapCoupling_couplingSession( results );
     test_overlapCoupling_filterMode( results );
+    test_overlapCoupling_factorizeFreeDOFLHS( results );
+    test_overlapCoupling_factorizeFreeDOFLHS_checkSPD( results );
+    test_computeLumpedGramDiagonal( results );
+    test_outputQueue( results );
 //    test_MADOutlierDetection( results );
 //    test_formMicromorphicElementMassMatrix( results );
 //    test_computeMicromorphicElementRequiredValues( results );
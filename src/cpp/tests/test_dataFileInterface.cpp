@@ -4,6 +4,9 @@
 #include<vector>
 #include<fstream>
 #include<math.h>
+#include<thread>
+#include<atomic>
+#include<chrono>
 #define USE_EIGEN
 #include<vector_tools.h>
 
@@ -386,6 +389,175 @@ BOOST_AUTO_TEST_CASE( testXDMFDataFile_getSolutionVectorDataFromComponents ){
 
 }
 
+BOOST_AUTO_TEST_CASE( testXDMFDataFile_getSolutionData_bulk ){
+    /*!
+     * Test the extraction of several solution data in one call
+     *
+     */
+
+    YAML::Node yf = YAML::LoadFile( "dataFileInterface_testConfig.yaml" );
+    dataFileInterface::XDMFDataFile xdmf( yf[ "filetest1" ] );
+
+    stringVector dataNames = { "disp_z", "disp_x" };
+
+    floatVector disp_x, disp_z;
+    std::unique_ptr< errorNode > error;
+
+    error.reset( xdmf.getSolutionData( 1, "disp_x", "Node", disp_x ) );
+
+    BOOST_CHECK( !error );
+
+    error.reset( xdmf.getSolutionData( 1, "disp_z", "Node", disp_z ) );
+
+    BOOST_CHECK( !error );
+
+    floatVector result;
+    error.reset( xdmf.getSolutionData( 1, dataNames, "Node", result ) );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( result.size( ) == 2 * disp_x.size( ) );
+
+    for ( unsigned int i = 0; i < disp_x.size( ); i++ ){
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( result[ 2 * i + 0 ], disp_z[ i ] ) );
+        BOOST_CHECK( vectorTools::fuzzyEquals( result[ 2 * i + 1 ], disp_x[ i ] ) );
+
+    }
+
+    //The index of the grid is re-used for a second request
+    error.reset( xdmf.getSolutionData( 1, stringVector( { "disp_x" } ), "Node", result ) );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( result, disp_x ) );
+
+    //Missing names and centers are errors
+    error.reset( xdmf.getSolutionData( 1, stringVector( { "disp_x", "not_a_variable" } ), "Node", result ) );
+
+    BOOST_CHECK( error );
+
+    error.reset( xdmf.getSolutionData( 1, dataNames, "Cell", result ) );
+
+    BOOST_CHECK( error );
+
+    error.reset( xdmf.getSolutionData( 1, dataNames, "Edge", result ) );
+
+    BOOST_CHECK( error );
+
+}
+
+BOOST_AUTO_TEST_CASE( testXDMFDataFile_heavyDataPolicy ){
+    /*!
+     * Test that the data read with the heavy data released after copying is the same as when it is kept
+     *
+     */
+
+    YAML::Node yf = YAML::LoadFile( "dataFileInterface_testConfig.yaml" );
+
+    YAML::Node keepConfig = YAML::Clone( yf[ "filetest1" ] );
+    keepConfig[ "heavy_data_policy" ] = "keep";
+
+    YAML::Node releaseConfig = YAML::Clone( yf[ "filetest1" ] );
+    releaseConfig[ "heavy_data_policy" ] = "release";
+
+    YAML::Node badConfig = YAML::Clone( yf[ "filetest1" ] );
+    badConfig[ "heavy_data_policy" ] = "sometimes";
+
+    dataFileInterface::XDMFDataFile keep( keepConfig );
+    dataFileInterface::XDMFDataFile release( releaseConfig );
+    dataFileInterface::XDMFDataFile bad( badConfig );
+
+    BOOST_CHECK( !keep._error );
+    BOOST_CHECK( !release._error );
+    BOOST_CHECK( bad._error );
+
+    std::unique_ptr< errorNode > error;
+
+    //Read everything twice to make sure that released data is read again
+    for ( unsigned int i = 0; i < 2; i++ ){
+
+        floatVector keepPositions, releasePositions;
+
+        error.reset( keep.readMesh( 1, keepPositions ) );
+        BOOST_CHECK( !error );
+
+        error.reset( release.readMesh( 1, releasePositions ) );
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( keepPositions.size( ) > 0 );
+        BOOST_CHECK( vectorTools::fuzzyEquals( keepPositions, releasePositions ) );
+
+        floatVector keepData, releaseData;
+
+        error.reset( keep.getSolutionData( 1, "disp_z", "Node", keepData ) );
+        BOOST_CHECK( !error );
+
+        error.reset( release.getSolutionData( 1, "disp_z", "Node", releaseData ) );
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( keepData.size( ) > 0 );
+        BOOST_CHECK( vectorTools::fuzzyEquals( keepData, releaseData ) );
+
+        //Alternating between increments uses the index of each increment
+        floatVector keepData0, releaseData0;
+
+        error.reset( keep.getSolutionData( 0, "disp_z", "Node", keepData0 ) );
+        BOOST_CHECK( !error );
+
+        error.reset( release.getSolutionData( 0, "disp_z", "Node", releaseData0 ) );
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( keepData0.size( ) > 0 );
+        BOOST_CHECK( vectorTools::fuzzyEquals( keepData0, releaseData0 ) );
+
+        floatVector releaseData1;
+
+        error.reset( release.getSolutionData( 1, "disp_z", "Node", releaseData1 ) );
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( releaseData1, keepData ) );
+
+        floatVector keepNodePositions, releaseNodePositions;
+        uIntVector keepConnectivity, releaseConnectivity, keepCellIndices, releaseCellIndices;
+        uIntType keepCellCounts, releaseCellCounts;
+
+        error.reset( keep.getMeshData( 1, keepNodePositions, keepConnectivity, keepCellIndices, keepCellCounts ) );
+        BOOST_CHECK( !error );
+
+        error.reset( release.getMeshData( 1, releaseNodePositions, releaseConnectivity, releaseCellIndices, releaseCellCounts ) );
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( keepNodePositions, releaseNodePositions ) );
+        BOOST_CHECK( keepConnectivity == releaseConnectivity );
+        BOOST_CHECK( keepCellIndices == releaseCellIndices );
+        BOOST_CHECK( keepCellCounts == releaseCellCounts );
+
+        uIntVector keepNodeIds, releaseNodeIds;
+
+        error.reset( keep.getNodeIds( 1, "NODEID", keepNodeIds ) );
+        BOOST_CHECK( !error );
+
+        error.reset( release.getNodeIds( 1, "NODEID", releaseNodeIds ) );
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( keepNodeIds == releaseNodeIds );
+
+        uIntVector keepDomainNodes, releaseDomainNodes;
+
+        error.reset( keep.getSubDomainNodes( 0, "left", keepDomainNodes ) );
+        BOOST_CHECK( !error );
+
+        error.reset( release.getSubDomainNodes( 0, "left", releaseDomainNodes ) );
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( keepDomainNodes.size( ) > 0 );
+        BOOST_CHECK( keepDomainNodes == releaseDomainNodes );
+
+    }
+
+}
+
 BOOST_AUTO_TEST_CASE( testXDMFDataFile_getIncrementTime ){
     /*!
      * Test the extraction of the timestamp for a given increment
@@ -982,3 +1154,264 @@ BOOST_AUTO_TEST_CASE( testXDMFDataFile_writeSolutionData ){
     std::remove( "test_output.h5" );
 
 }
+
+BOOST_AUTO_TEST_CASE( testXDMFDataFile_flush ){
+    /*!
+     * Test flushing a long-lived writer after each increment
+     *
+     */
+
+    std::remove( "test_output.xdmf" );
+    std::remove( "test_output.h5" );
+
+    uIntVector nodeIds = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    floatVector nodePositions = { 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0,
+                                  0, 0, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1 };
+
+    uIntVector elementIds = { 1 };
+
+    uIntVector connectivity = { 9, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    floatVector nodeDataAnswer1 = { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7 };
+
+    floatVector nodeDataAnswer2 = { 1.0, 1.1, 1.2, 1.3, 1.4, 1.5, 1.6, 1.7 };
+
+    YAML::Node yf = YAML::LoadFile( "dataFileInterface_testConfig.yaml" );
+    dataFileInterface::XDMFDataFile xdmf( yf[ "filetest3" ] );
+
+    BOOST_CHECK( !xdmf._error );
+
+    uIntType increment1, increment2;
+
+    errorOut error = xdmf.initializeIncrement( 0.0, 0, 0, increment1 );
+
+    BOOST_CHECK( !error );
+
+    error = xdmf.writeIncrementMeshData( increment1, 0, nodeIds, { { } }, { { } }, nodePositions,
+                                         elementIds, { { } }, { { } }, connectivity );
+
+    BOOST_CHECK( !error );
+
+    error = xdmf.writeScalarSolutionData( increment1, 0, "TEST_DATA", "NODE", nodeDataAnswer1 );
+
+    BOOST_CHECK( !error );
+
+    error = xdmf.flush( );
+
+    BOOST_CHECK( !error );
+
+    //The first increment must be readable while the writer is still open
+    YAML::Node af = YAML::Load( "mode: read\nfilename: test_output.xdmf\n" );
+
+    {
+
+        dataFileInterface::XDMFDataFile xdmf_result( af );
+
+        BOOST_CHECK( !xdmf_result._error );
+
+        uIntType numIncrements;
+        error = xdmf_result.getNumIncrements( numIncrements );
+
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( numIncrements == 1 );
+
+        floatVector nodeDataResult;
+        error = xdmf_result.getSolutionData( increment1, "TEST_DATA", "Node", nodeDataResult );
+
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( nodeDataResult, nodeDataAnswer1 ) );
+
+    }
+
+    //Append a second increment which references the mesh of the first
+    error = xdmf.initializeIncrement( 0.1, increment1, 0, increment2 );
+
+    BOOST_CHECK( !error );
+
+    error = xdmf.writeIncrementMeshData( increment2, 0, { }, { { } }, { }, { }, { }, { { } }, { }, { } );
+
+    BOOST_CHECK( !error );
+
+    error = xdmf.writeScalarSolutionData( increment2, 0, "TEST_DATA", "NODE", nodeDataAnswer2 );
+
+    BOOST_CHECK( !error );
+
+    error = xdmf.flush( );
+
+    BOOST_CHECK( !error );
+
+    //Flushing without any changes is a no-op
+    error = xdmf.flush( );
+
+    BOOST_CHECK( !error );
+
+    {
+
+        dataFileInterface::XDMFDataFile xdmf_result( af );
+
+        BOOST_CHECK( !xdmf_result._error );
+
+        uIntType numIncrements;
+        error = xdmf_result.getNumIncrements( numIncrements );
+
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( numIncrements == 2 );
+
+        floatVector nodeDataResult;
+        error = xdmf_result.getSolutionData( increment1, "TEST_DATA", "Node", nodeDataResult );
+
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( nodeDataResult, nodeDataAnswer1 ) );
+
+        error = xdmf_result.getSolutionData( increment2, "TEST_DATA", "Node", nodeDataResult );
+
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( nodeDataResult, nodeDataAnswer2 ) );
+
+    }
+
+    std::remove( "test_output.xdmf" );
+    std::remove( "test_output.h5" );
+
+}
+
+BOOST_AUTO_TEST_CASE( testBufferedDataFile ){
+    /*!
+     * Test recording output in a buffer and replaying it into an XDMF file
+     *
+     */
+
+    std::remove( "test_output.xdmf" );
+    std::remove( "test_output.h5" );
+
+    uIntVector nodeIds = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    floatVector nodePositions = { 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0,
+                                  0, 0, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1 };
+
+    uIntVector elementIds = { 1 };
+
+    uIntVector connectivity = { 9, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    floatVector nodeDataAnswer = { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7 };
+
+    dataFileInterface::bufferedDataFile buffer;
+
+    BOOST_CHECK( !buffer._error );
+
+    uIntType increment;
+
+    errorOut error = buffer.initializeIncrement( 0.0, 0, 0, increment );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( increment == 0 );
+
+    error = buffer.writeIncrementMeshData( increment, 0, nodeIds, { { } }, { { } }, nodePositions,
+                                           elementIds, { { } }, { { } }, connectivity );
+
+    BOOST_CHECK( !error );
+
+    error = buffer.writeScalarSolutionData( increment, 0, "TEST_DATA", "NODE", nodeDataAnswer );
+
+    BOOST_CHECK( !error );
+
+    //Data passed as an rvalue is moved into the buffer
+    floatVector movedData = nodeDataAnswer;
+
+    error = buffer.writeScalarSolutionData( increment, 0, "MOVED_DATA", "NODE", std::move( movedData ) );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( buffer.getNumOperations( ) == 4 );
+
+    //Writing to an increment which was not initialized in the buffer is an error
+    std::unique_ptr< errorNode > badError( buffer.writeScalarSolutionData( increment + 1, 0, "TEST_DATA", "NODE", nodeDataAnswer ) );
+
+    BOOST_CHECK( badError );
+
+    BOOST_CHECK( buffer.getNumOperations( ) == 4 );
+
+    YAML::Node yf = YAML::LoadFile( "dataFileInterface_testConfig.yaml" );
+
+    {
+
+        dataFileInterface::XDMFDataFile xdmf( yf[ "filetest3" ] );
+
+        BOOST_CHECK( !xdmf._error );
+
+        error = buffer.replay( xdmf );
+
+        BOOST_CHECK( !error );
+
+    }
+
+    YAML::Node af = YAML::Load( "mode: read\nfilename: test_output.xdmf\n" );
+    dataFileInterface::XDMFDataFile xdmf_result( af );
+
+    BOOST_CHECK( !xdmf_result._error );
+
+    uIntType numIncrements;
+    error = xdmf_result.getNumIncrements( numIncrements );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( numIncrements == 1 );
+
+    floatVector nodeDataResult;
+    error = xdmf_result.getSolutionData( 0, "TEST_DATA", "Node", nodeDataResult );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( nodeDataResult, nodeDataAnswer ) );
+
+    error = xdmf_result.getSolutionData( 0, "MOVED_DATA", "Node", nodeDataResult );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( nodeDataResult, nodeDataAnswer ) );
+
+    std::remove( "test_output.xdmf" );
+    std::remove( "test_output.h5" );
+
+}
+
+BOOST_AUTO_TEST_CASE( testLockXDMFLibrary ){
+    /*!
+     * Test that the XDMF library lock excludes other threads while it is held
+     */
+
+    std::unique_lock< std::recursive_mutex > lock = dataFileInterface::lockXDMFLibrary( );
+
+    BOOST_CHECK( lock.owns_lock( ) );
+
+    //The lock is recursive so the owning thread may take it again
+    {
+        std::unique_lock< std::recursive_mutex > nested = dataFileInterface::lockXDMFLibrary( );
+
+        BOOST_CHECK( nested.owns_lock( ) );
+    }
+
+    std::atomic< bool > acquired( false );
+    std::thread other( [ &acquired ]( ){
+        std::unique_lock< std::recursive_mutex > otherLock = dataFileInterface::lockXDMFLibrary( );
+        acquired = true;
+    } );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+    BOOST_CHECK( !acquired );
+
+    lock.unlock( );
+
+    other.join( );
+
+    BOOST_CHECK( acquired );
+
+}
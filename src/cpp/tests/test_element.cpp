@@ -1025,3 +1025,188 @@ BOOST_AUTO_TEST_CASE( testHex8_transform_local_vector ){
 
     BOOST_CHECK( vectorTools::fuzzyEquals( answer4, result4 ) );
 }
+
+BOOST_AUTO_TEST_CASE( testHex8_fixedSizeKernels ){
+    /*!
+     * Test that the fixed size Hex8 kernels reproduce the dynamically sized element implementation
+     */
+
+    elib::vecOfvec nodes = {{0.516905, 0.391528, 0.293894 },
+                            {0.86161, 0.442245, 0.178099 },
+                            {1.10153, 0.877418, 0.274955 },
+                            {0.846862, 0.78123, 0.445236 },
+                            {0.315421, 0.42434, 0.676207 },
+                            {0.720471, 0.459122, 0.606603 },
+                            {0.869162, 0.915384, 0.665252 },
+                            {0.52575, 0.848709, 0.771187}};
+
+    std::vector< uitype > node_ids = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    elib::quadrature_rule qrule;
+    define_hex8_fully_integrated_quadrature(qrule);
+
+    std::unique_ptr< elib::Element > element = elib::build_element_from_string( "Hex8", node_ids, nodes, qrule );
+
+    elib::vec xi = { 0.3, -0.2, 0.7 };
+
+    elib::vec scalar_values = { 1, -2, 3, 0.5, 4, -1, 2, 0.25 };
+
+    double value_fixed, value_dynamic;
+    BOOST_CHECK( !element->interpolate( scalar_values, xi, value_fixed ) );
+    BOOST_CHECK( !element->elib::Element::interpolate( scalar_values, xi, value_dynamic ) );
+    BOOST_CHECK( fuzzy_equals( value_fixed, value_dynamic ) );
+
+    elib::vec x_fixed, x_dynamic;
+    BOOST_CHECK( !element->interpolate( nodes, xi, x_fixed ) );
+    BOOST_CHECK( !element->elib::Element::interpolate( nodes, xi, x_dynamic ) );
+    BOOST_CHECK( fuzzy_equals( x_fixed, x_dynamic ) );
+
+    elib::vec gradient_fixed, gradient_dynamic;
+    BOOST_CHECK( !element->get_local_gradient( scalar_values, xi, gradient_fixed ) );
+    BOOST_CHECK( !element->elib::Element::get_local_gradient( scalar_values, xi, gradient_dynamic ) );
+    BOOST_CHECK( fuzzy_equals( gradient_fixed, gradient_dynamic ) );
+
+    elib::vecOfvec jacobian_fixed, jacobian_dynamic;
+    BOOST_CHECK( !element->get_local_gradient( nodes, xi, jacobian_fixed ) );
+    BOOST_CHECK( !element->elib::Element::get_local_gradient( nodes, xi, jacobian_dynamic ) );
+    BOOST_CHECK( fuzzy_equals( jacobian_fixed, jacobian_dynamic ) );
+
+    elib::vec xi_fixed, xi_dynamic;
+    BOOST_CHECK( !element->compute_local_coordinates( x_fixed, xi_fixed ) );
+    BOOST_CHECK( !element->elib::Element::compute_local_coordinates( x_fixed, xi_dynamic ) );
+    BOOST_CHECK( fuzzy_equals( xi_fixed, xi ) );
+    BOOST_CHECK( fuzzy_equals( xi_fixed, xi_dynamic ) );
+
+}
+
+BOOST_AUTO_TEST_CASE( testHex8_compute_local_coordinates_at_points ){
+    /*!
+     * Test the computation of the local coordinates and shape functions at a batch of points
+     */
+
+    elib::vecOfvec nodes = {{0.516905, 0.391528, 0.293894 },
+                            {0.86161, 0.442245, 0.178099 },
+                            {1.10153, 0.877418, 0.274955 },
+                            {0.846862, 0.78123, 0.445236 },
+                            {0.315421, 0.42434, 0.676207 },
+                            {0.720471, 0.459122, 0.606603 },
+                            {0.869162, 0.915384, 0.665252 },
+                            {0.52575, 0.848709, 0.771187}};
+
+    std::vector< uitype > node_ids = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    elib::quadrature_rule qrule;
+    define_hex8_fully_integrated_quadrature(qrule);
+
+    std::unique_ptr< elib::Element > element = elib::build_element_from_string( "Hex8", node_ids, nodes, qrule );
+
+    elib::vecOfvec local_answers = { { 0.3, -0.2, 0.7 },
+                                     { 0.31, -0.18, 0.65 },
+                                     { -0.9, 0.8, 0.1 },
+                                     { 1.5, 0.2, -0.3 },
+                                     { 0.0, 0.0, 0.0 } };
+
+    std::vector< bool > inside_answers = { true, true, true, false, true };
+
+    elib::vec global_points;
+    for ( auto xi = local_answers.begin( ); xi != local_answers.end( ); xi++ ){
+        elib::vec x;
+        element->interpolate( nodes, *xi, x );
+        global_points.insert( global_points.end( ), x.begin( ), x.end( ) );
+    }
+
+    elib::vec local_points, shape_functions;
+    std::vector< bool > inside;
+
+    errorOut error = element->compute_local_coordinates_at_points( global_points, local_points, inside, shape_functions );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( local_points.size( ) == 3 * local_answers.size( ) );
+    BOOST_CHECK( shape_functions.size( ) == 8 * local_answers.size( ) );
+    BOOST_CHECK( inside == inside_answers );
+
+    for ( uitype p = 0; p < local_answers.size( ); p++ ){
+
+        elib::vec xi( local_points.begin( ) + 3 * p, local_points.begin( ) + 3 * ( p + 1 ) );
+        BOOST_CHECK( fuzzy_equals( xi, local_answers[ p ] ) );
+
+        elib::vec N( shape_functions.begin( ) + 8 * p, shape_functions.begin( ) + 8 * ( p + 1 ) );
+        elib::vec N_answer( 8, 0 );
+        if ( inside_answers[ p ] ){
+            element->get_shape_functions( local_answers[ p ], N_answer );
+        }
+        BOOST_CHECK( fuzzy_equals( N, N_answer ) );
+
+    }
+
+    //The dynamically sized implementation must give the same result
+    elib::vec local_points_dynamic, shape_functions_dynamic;
+    std::vector< bool > inside_dynamic;
+
+    error = element->elib::Element::compute_local_coordinates_at_points( global_points, local_points_dynamic,
+                                                                         inside_dynamic, shape_functions_dynamic );
+
+    BOOST_CHECK( !error );
+    BOOST_CHECK( inside_dynamic == inside );
+    BOOST_CHECK( fuzzy_equals( local_points_dynamic, local_points ) );
+    BOOST_CHECK( fuzzy_equals( shape_functions_dynamic, shape_functions ) );
+
+    //A point whose local coordinates do not converge to a point inside of the element is an error
+    elib::vec unconverged_point( global_points.begin( ), global_points.begin( ) + 3 );
+
+    std::unique_ptr< errorNode > unconverged_error;
+    unconverged_error.reset( element->compute_local_coordinates_at_points( unconverged_point, local_points, inside,
+                                                                            shape_functions, 1e-14, 1e-14, 1, 0 ) );
+    BOOST_CHECK( unconverged_error );
+
+    unconverged_error.reset( element->elib::Element::compute_local_coordinates_at_points( unconverged_point, local_points,
+                                                                                          inside, shape_functions,
+                                                                                          1e-14, 1e-14, 1, 0 ) );
+    BOOST_CHECK( unconverged_error );
+
+    //A distant point whose local coordinates do not converge is outside of the element
+    elib::vec distant_point = { 10., -10., 10. };
+
+    unconverged_error.reset( element->compute_local_coordinates_at_points( distant_point, local_points, inside,
+                                                                            shape_functions, 1e-14, 1e-14, 1, 0 ) );
+    BOOST_CHECK( !unconverged_error );
+    BOOST_CHECK( !inside[ 0 ] );
+
+    unconverged_error.reset( element->elib::Element::compute_local_coordinates_at_points( distant_point, local_points,
+                                                                                          inside, shape_functions,
+                                                                                          1e-14, 1e-14, 1, 0 ) );
+    BOOST_CHECK( !unconverged_error );
+    BOOST_CHECK( !inside[ 0 ] );
+
+    //A point outside of a skewed element but inside of its bounding box whose local coordinates do not converge
+    //is outside of the element
+    elib::vecOfvec skewed_nodes = { { 0.0, 0.0, 0.0 },
+                                    { 1.0, 0.0, 0.0 },
+                                    { 1.0, 1.0, 0.0 },
+                                    { 0.0, 1.0, 0.0 },
+                                    { 3.0, 0.0, 1.0 },
+                                    { 4.0, 0.0, 1.0 },
+                                    { 4.2, 1.0, 1.0 },
+                                    { 3.0, 1.0, 1.0 } };
+
+    std::unique_ptr< elib::Element > skewed_element = elib::build_element_from_string( "Hex8", node_ids, skewed_nodes, qrule );
+
+    elib::vec exterior_point = { 3.5, 0.5, 0.1 };
+
+    BOOST_CHECK( skewed_element->bounding_box_contains_point( exterior_point ) );
+
+    unconverged_error.reset( skewed_element->compute_local_coordinates_at_points( exterior_point, local_points, inside,
+                                                                                   shape_functions, 1e-14, 1e-14, 1, 0 ) );
+    BOOST_CHECK( !unconverged_error );
+    BOOST_CHECK( !inside[ 0 ] );
+    BOOST_CHECK( fuzzy_equals( shape_functions, elib::vec( 8, 0 ) ) );
+
+    unconverged_error.reset( skewed_element->elib::Element::compute_local_coordinates_at_points( exterior_point, local_points,
+                                                                                                 inside, shape_functions,
+                                                                                                 1e-14, 1e-14, 1, 0 ) );
+    BOOST_CHECK( !unconverged_error );
+    BOOST_CHECK( !inside[ 0 ] );
+    BOOST_CHECK( fuzzy_equals( shape_functions, elib::vec( 8, 0 ) ) );
+
+}
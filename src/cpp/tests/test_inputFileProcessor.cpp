@@ -20,6 +20,7 @@ typedef inputFileProcessor::uIntType uIntType; //!Define an unsigned integer typ
 typedef inputFileProcessor::uIntVector uIntVector; //!Define a vector of unsigned ints
 typedef inputFileProcessor::stringVector stringVector; //!Define a vector of strings
 typedef inputFileProcessor::DOFMap DOFMap; //!Define the map between DOF values
+typedef inputFileProcessor::boolVector boolVector; //!Define a vector of bools
 
 errorOut _createXDMFDatafiles( ){
 
@@ -739,6 +740,19 @@ BOOST_AUTO_TEST_CASE( testInitializeIncrement ){
 
     }
 
+    const inputFileProcessor::nodeFieldContainer *microNodeFields = reader.getMicroNodeFields( );
+
+    for ( auto it = microDisplacementAnswer.begin( ); it != microDisplacementAnswer.end( ); it++ ){
+
+        const floatType *values;
+        uIntType stride;
+
+        BOOST_CHECK( !microNodeFields->getNodeValues( "displacement", it->first, values, stride ) );
+        BOOST_CHECK( stride == it->second.size( ) );
+        BOOST_CHECK( vectorTools::fuzzyEquals( floatVector( values, values + stride ), it->second ) );
+
+    }
+
 
     const uIntVector freeMacroCellIdsAnswer = { 1 };
     const uIntVector ghostMacroCellIdsAnswer = { 2 };
@@ -1496,6 +1510,19 @@ BOOST_AUTO_TEST_CASE( testInitializeIncrement ){
 
     }
 
+    const inputFileProcessor::nodeFieldContainer *macroNodeFields = reader.getMacroNodeFields( );
+
+    for ( auto it = macroDispDOFVectorAnswer.begin( ); it != macroDispDOFVectorAnswer.end( ); it++ ){
+
+        const floatType *values;
+        uIntType stride;
+
+        BOOST_CHECK( !macroNodeFields->getNodeValues( "displacement_dof", it->first, values, stride ) );
+        BOOST_CHECK( stride == it->second.size( ) );
+        BOOST_CHECK( vectorTools::fuzzyEquals( floatVector( values, values + stride ), it->second ) );
+
+    }
+
     const std::unordered_map< uIntType, floatVector > macroVelocitiesAnswer
         =
             {
@@ -1820,6 +1847,36 @@ BOOST_AUTO_TEST_CASE( testInitializeIncrement ){
 
     }
 
+    //The domain membership index must agree with the data file
+    const std::unordered_map< std::string, uIntType > *membershipIndex = reader.getMicroDomainMembershipIndex( );
+    const uIntVector *membershipOffsets = reader.getMicroDomainMembershipOffsets( );
+    const uIntVector *membershipNodes = reader.getMicroDomainMembershipNodes( );
+
+    BOOST_CHECK( membershipIndex->size( ) == freeMicroDomainNames->size( ) + ghostMicroDomainNames->size( ) );
+
+    BOOST_CHECK( membershipOffsets->size( ) == membershipIndex->size( ) + 1 );
+
+    BOOST_CHECK( membershipOffsets->back( ) == membershipNodes->size( ) );
+
+    uIntVector membershipResult;
+    for ( auto domainNames : { freeMicroDomainNames, ghostMicroDomainNames } ){
+
+        for ( auto domain  = domainNames->begin( );
+                   domain != domainNames->end( );
+                   domain++ ){
+
+            reader._microscale->getSubDomainNodes( 0, *domain, nodes );
+
+            BOOST_CHECK( !reader.getMicroDomainNodes( 0, *domain, membershipResult ) );
+
+            BOOST_CHECK( vectorTools::fuzzyEquals( membershipResult, nodes ) );
+
+            BOOST_CHECK( membershipIndex->find( *domain ) != membershipIndex->end( ) );
+
+        }
+
+    }
+
     const uIntVector *freeMacroNodeIds = reader.getFreeMacroNodeIds( );
     const uIntVector *ghostMacroNodeIds = reader.getGhostMacroNodeIds( );
 
@@ -1964,6 +2021,8 @@ BOOST_AUTO_TEST_CASE( testInitializeIncrement ){
 
     BOOST_CHECK( reader.extractPreviousDOFValues( ) );
 
+    BOOST_CHECK( reader.getPreviousFieldName( "displacement_dof" ).compare( "previous_displacement_dof" ) == 0 );
+
     const floatType DtAnswer = 1.;
     const floatType* DtResult = reader.getDt( );
 
@@ -3968,6 +4027,57 @@ BOOST_AUTO_TEST_CASE( testInitializeIncrement_Arlequin ){
 }
 
 
+BOOST_AUTO_TEST_CASE( testSetConfigurationFilename_domainMembership ){
+    /*!
+     * Test that the micro domain membership is rebuilt when the configuration is changed
+     *
+     */
+
+    inputFileProcessor::inputFileProcessor reader( "inputFileProcessor_testConfig.yaml" );
+
+    BOOST_CHECK( !reader.getError( ) );
+
+    std::unique_ptr< errorNode > error;
+    error.reset( reader.initializeIncrement( 1, 1 ) );
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( reader.getMicroDomainMembershipIndex( )->size( ) > 0 );
+
+    //Switching the configuration must drop the membership of the previous configuration
+    error.reset( reader.setConfigurationFilename( "inputFileProcessor_testConfig_Arlequin.yaml" ) );
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( reader.getMicroDomainMembershipIndex( )->size( ) == 0 );
+    BOOST_CHECK( reader.getMicroDomainMembershipOffsets( )->size( ) == 0 );
+    BOOST_CHECK( reader.getMicroDomainMembershipNodes( )->size( ) == 0 );
+
+    error.reset( reader.initializeIncrement( 1, 1 ) );
+    BOOST_CHECK( !error );
+
+    //The rebuilt membership must agree with the data file of the new configuration
+    const std::unordered_map< std::string, uIntType > *membershipIndex = reader.getMicroDomainMembershipIndex( );
+
+    BOOST_CHECK( membershipIndex->size( ) == reader.getFreeMicroDomainNames( )->size( ) + reader.getGhostMicroDomainNames( )->size( ) );
+
+    uIntVector nodes, membershipResult;
+    for ( auto domainNames : { reader.getFreeMicroDomainNames( ), reader.getGhostMicroDomainNames( ) } ){
+
+        for ( auto domain  = domainNames->begin( );
+                   domain != domainNames->end( );
+                   domain++ ){
+
+            reader._microscale->getSubDomainNodes( 1, *domain, nodes );
+
+            BOOST_CHECK( !reader.getMicroDomainNodes( 1, *domain, membershipResult ) );
+
+            BOOST_CHECK( vectorTools::fuzzyEquals( membershipResult, nodes ) );
+
+        }
+
+    }
+
+}
+
 BOOST_AUTO_TEST_CASE( testGetFreeMicroDomainNames ){
     /*!
      * Test getting a pointer to the free micro domain names
@@ -4123,6 +4233,8 @@ BOOST_AUTO_TEST_CASE( testGetCouplingInitialization ){
 
     BOOST_CHECK( couplingInitialization[ "output_homogenized_response" ][ "mode" ].as< std::string >( ).compare( "write" ) == 0 );
 
+    BOOST_CHECK( couplingInitialization[ "output_homogenized_response" ][ "flush_each_increment" ].as< bool >( ) );
+
     BOOST_CHECK( couplingInitialization[ "output_updated_dof" ][ "macroscale_filetype" ].as< std::string >( ).compare( "XDMF" ) == 0 );
 
     BOOST_CHECK( couplingInitialization[ "output_updated_dof" ][ "microscale_filetype" ].as< std::string >( ).compare( "XDMF" ) == 0 );
@@ -4157,6 +4269,90 @@ BOOST_AUTO_TEST_CASE( testGetCouplingInitialization ){
 
     BOOST_CHECK( reader.useReconstructedVolumeForMassMatrix( ) );
 
+    BOOST_CHECK( !reader.useReconstructedMassCenters( ) );
+
+    BOOST_CHECK( couplingInitialization[ "homogenization_thread_count" ].as< uIntType >( ) == 1 );
+
+    BOOST_CHECK( reader.getHomogenizationThreadCount( ) == 1 );
+
+    BOOST_CHECK( couplingInitialization[ "output_queue_size" ].as< uIntType >( ) == 0 );
+
+    BOOST_CHECK( reader.getOutputQueueSize( ) == 0 );
+
+    BOOST_CHECK( !couplingInitialization[ "prefetch_next_increment" ].as< bool >( ) );
+
+    BOOST_CHECK( !reader.prefetchesNextIncrement( ) );
+
+    BOOST_CHECK( couplingInitialization[ "free_dof_solver" ][ "type" ].as< std::string >( ).compare( "qr" ) == 0 );
+
+    BOOST_CHECK( couplingInitialization[ "free_dof_solver" ][ "preconditioner" ].as< std::string >( ).compare( "diagonal" ) == 0 );
+
+    BOOST_CHECK( couplingInitialization[ "free_dof_solver" ][ "check_spd" ].as< bool >( ) );
+
+    BOOST_CHECK( couplingInitialization[ "l2_projector" ][ "type" ].as< std::string >( ).compare( "dense" ) == 0 );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( couplingInitialization[ "l2_projector" ][ "truncation_tolerance" ].as< floatType >( ), 1e-4 ) );
+
+    BOOST_CHECK( !couplingInitialization[ "revalidate_domain_membership" ].as< bool >( ) );
+
+    BOOST_CHECK( couplingInitialization[ "logging" ][ "level" ].as< std::string >( ).compare( "info" ) == 0 );
+
+    BOOST_CHECK( couplingInitialization[ "logging" ][ "debug_file_format" ].as< std::string >( ).compare( "csv" ) == 0 );
+
+    BOOST_CHECK( reader.getLogger( ).getLevel( ) == inputFileProcessor::LOG_INFO );
+
+    BOOST_CHECK( !reader.getLogger( ).writesDebugTables( ) );
+
+}
+
+BOOST_AUTO_TEST_CASE( testCheckCouplingInitialization_freeDOFSolver ){
+    /*!
+     * Test the validation of the free degree of freedom solver configuration
+     *
+     */
+
+    std::vector< std::pair< std::string, std::string > > badValues = { { "type", "lu" },
+                                                                       { "preconditioner", "jacobi" },
+                                                                       { "tolerance", "-1e-9" },
+                                                                       { "tolerance", "small" },
+                                                                       { "max_iterations", "-5" },
+                                                                       { "max_iterations", "many" },
+                                                                       { "check_spd", "maybe" } };
+
+    std::string filename = "inputFileProcessor_testConfig_freeDOFSolver.yaml";
+
+    for ( auto badValue = badValues.begin( ); badValue != badValues.end( ); badValue++ ){
+
+        YAML::Node config = YAML::LoadFile( "inputFileProcessor_testConfig.yaml" );
+        config[ "coupling_initialization" ][ "free_dof_solver" ][ badValue->first ] = badValue->second;
+
+        std::ofstream configFile( filename );
+        configFile << config;
+        configFile.close( );
+
+        inputFileProcessor::inputFileProcessor reader( filename );
+
+        BOOST_CHECK( reader.getError( ) );
+
+    }
+
+    YAML::Node config = YAML::LoadFile( "inputFileProcessor_testConfig.yaml" );
+    config[ "coupling_initialization" ][ "free_dof_solver" ][ "type" ] = "cg";
+    config[ "coupling_initialization" ][ "free_dof_solver" ][ "preconditioner" ] = "incomplete_cholesky";
+    config[ "coupling_initialization" ][ "free_dof_solver" ][ "tolerance" ] = 1e-9;
+    config[ "coupling_initialization" ][ "free_dof_solver" ][ "max_iterations" ] = 100;
+    config[ "coupling_initialization" ][ "free_dof_solver" ][ "check_spd" ] = false;
+
+    std::ofstream configFile( filename );
+    configFile << config;
+    configFile.close( );
+
+    inputFileProcessor::inputFileProcessor reader( filename );
+
+    BOOST_CHECK( !reader.getError( ) );
+
+    remove( filename.c_str( ) );
+
 }
 
 BOOST_AUTO_TEST_CASE( testGetVolumeReconstructionConfig ){
@@ -4382,3 +4578,370 @@ BOOST_AUTO_TEST_CASE( testOutputUpdatedDOF ){
     BOOST_CHECK( reader.outputUpdatedDOF( ) );
 
 }
+
+BOOST_AUTO_TEST_CASE( testNodeFieldContainer ){
+    /*!
+     * Test the contiguous storage of the node fields
+     *
+     */
+
+    DOFMap index = { { 10, 2 }, { 4, 0 }, { 7, 1 } };
+
+    floatVector displacements = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    floatVector bodyForces = { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9 };
+
+    inputFileProcessor::nodeFieldContainer fields;
+
+    const floatType *values;
+    uIntType stride;
+
+    BOOST_CHECK( fields.getNodeValues( "displacement", 10, values, stride ) );
+
+    fields.setIndex( &index );
+    BOOST_CHECK( fields.getNodeCount( ) == 3 );
+    BOOST_CHECK( !fields.setField( "displacement", 3, displacements ) );
+    BOOST_CHECK( !fields.setField( "body_force", 3, bodyForces, -2 ) );
+    BOOST_CHECK( fields.setField( "velocity", 4, displacements ) );
+
+    BOOST_CHECK( fields.getIndex( ) == &index );
+    BOOST_CHECK( fields.hasField( "displacement" ) );
+    BOOST_CHECK( !fields.hasField( "velocity" ) );
+
+    BOOST_CHECK( !fields.getNodeValues( "displacement", 10, values, stride ) );
+    BOOST_CHECK( stride == 3 );
+    BOOST_CHECK( vectorTools::fuzzyEquals( floatVector( values, values + stride ), { 7, 8, 9 } ) );
+
+    BOOST_CHECK( !fields.getNodeValues( "body_force", 7, values, stride ) );
+    BOOST_CHECK( vectorTools::fuzzyEquals( floatVector( values, values + stride ), { -0.8, -1.0, -1.2 } ) );
+
+    BOOST_CHECK( fields.getNodeValues( "displacement", 3, values, stride ) );
+    BOOST_CHECK( fields.getNodeValues( "velocity", 10, values, stride ) );
+
+    const std::unordered_map< uIntType, floatVector > *displacementMap = fields.getNodeMap( "displacement" );
+    BOOST_CHECK( displacementMap->size( ) == 3 );
+    BOOST_CHECK( vectorTools::fuzzyEquals( displacementMap->at( 4 ), { 1, 2, 3 } ) );
+    BOOST_CHECK( vectorTools::fuzzyEquals( displacementMap->at( 10 ), { 7, 8, 9 } ) );
+    BOOST_CHECK( fields.getNodeMap( "displacement" ) == displacementMap );
+    BOOST_CHECK( fields.getNodeMap( "velocity" )->empty( ) );
+
+    floatVector densities = { 1.5, 2.5, 3.5 };
+    BOOST_CHECK( !fields.setField( "density", 1, densities ) );
+    const std::unordered_map< uIntType, floatType > *densityMap = fields.getScalarNodeMap( "density" );
+    BOOST_CHECK( densityMap->size( ) == 3 );
+    BOOST_CHECK( vectorTools::fuzzyEquals( densityMap->at( 7 ), 2.5 ) );
+
+    //Replacing a field must rebuild its map in place
+    BOOST_CHECK( !fields.setField( "displacement", 3, bodyForces ) );
+    BOOST_CHECK( fields.getNodeMap( "displacement" ) == displacementMap );
+    BOOST_CHECK( vectorTools::fuzzyEquals( displacementMap->at( 10 ), { 0.7, 0.8, 0.9 } ) );
+    BOOST_CHECK( !fields.setField( "displacement", 3, displacements ) );
+    BOOST_CHECK( vectorTools::fuzzyEquals( displacementMap->at( 10 ), { 7, 8, 9 } ) );
+
+    densities = { 4.5, 5.5, 6.5 };
+    BOOST_CHECK( !fields.setField( "density", 1, densities ) );
+    BOOST_CHECK( fields.getScalarNodeMap( "density" ) == densityMap );
+    BOOST_CHECK( vectorTools::fuzzyEquals( densityMap->at( 7 ), 5.5 ) );
+
+    //Changing the index must rebuild the maps in place
+    DOFMap reorderedIndex = { { 10, 0 }, { 4, 2 }, { 7, 1 } };
+    fields.setIndex( &reorderedIndex );
+    BOOST_CHECK( vectorTools::fuzzyEquals( displacementMap->at( 10 ), { 1, 2, 3 } ) );
+    BOOST_CHECK( vectorTools::fuzzyEquals( densityMap->at( 4 ), 6.5 ) );
+    fields.setIndex( &index );
+
+    BOOST_CHECK( !fields.setFieldFromSum( "external_force", { "displacement", "body_force" } ) );
+
+    const floatVector *externalForces;
+    BOOST_CHECK( !fields.getField( "external_force", externalForces, stride ) );
+    BOOST_CHECK( vectorTools::fuzzyEquals( *externalForces, displacements - 2 * bodyForces ) );
+
+    BOOST_CHECK( fields.setFieldFromSum( "external_force", { "displacement", "velocity" } ) );
+
+    fields.clearField( "displacement" );
+    BOOST_CHECK( !fields.hasField( "displacement" ) );
+    BOOST_CHECK( displacementMap->empty( ) );
+
+    fields.clear( );
+    BOOST_CHECK( !fields.hasField( "body_force" ) );
+    BOOST_CHECK( densityMap->empty( ) );
+
+}
+
+BOOST_AUTO_TEST_CASE( testSolutionDataPrefetcher ){
+    /*!
+     * Test the read-ahead of the solution data of the next increment
+     *
+     */
+
+    std::string filename = "inputFileProcessor_testConfig.yaml";
+    inputFileProcessor::inputFileProcessor reader( filename );
+
+    BOOST_CHECK( !reader.getError( ) );
+
+    BOOST_CHECK( !reader.prefetchesNextIncrement( ) );
+
+    BOOST_CHECK( reader.getSolutionDataPrefetcher( reader._microscale ) );
+
+    BOOST_CHECK( reader.getSolutionDataPrefetcher( reader._macroscale ) );
+
+    BOOST_CHECK( !reader.getSolutionDataPrefetcher( std::shared_ptr< dataFileInterface::dataFileBase >( ) ) );
+
+    stringVector componentNames = { "u1", "u2", "u3" };
+
+    floatVector answer0, answer1;
+
+    std::unique_ptr< errorNode > error;
+
+    error.reset( reader._microscale->getSolutionVectorDataFromComponents( 0, componentNames, "Node", answer0 ) );
+
+    BOOST_CHECK( !error );
+
+    error.reset( reader._microscale->getSolutionVectorDataFromComponents( 1, componentNames, "Node", answer1 ) );
+
+    BOOST_CHECK( !error );
+
+    inputFileProcessor::solutionDataPrefetcher prefetcher;
+
+    floatVector result;
+
+    error.reset( prefetcher.getSolutionData( 0, componentNames, "Node", result ) );
+
+    BOOST_CHECK( error );
+
+    prefetcher.setDataFile( reader._microscale );
+    prefetcher.setEnabled( true );
+
+    BOOST_CHECK( prefetcher.isEnabled( ) );
+
+    //The first increment is read directly from the data file
+    prefetcher.beginIncrement( );
+
+    error.reset( prefetcher.getSolutionData( 0, componentNames, "Node", result ) );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( result, answer0 ) );
+
+    BOOST_CHECK( prefetcher.getNumPrefetchedReads( ) == 0 );
+
+    //The requests of the first increment are repeated for the second
+    prefetcher.prefetch( 0, 1 );
+
+    prefetcher.beginIncrement( );
+
+    error.reset( prefetcher.getSolutionData( 1, componentNames, "Node", result ) );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( result, answer1 ) );
+
+    BOOST_CHECK( prefetcher.getNumPrefetchedReads( ) == 1 );
+
+    //Nothing is read past the end of the data file
+    prefetcher.prefetch( 1, 2 );
+
+    prefetcher.beginIncrement( );
+
+    error.reset( prefetcher.getSolutionData( 1, componentNames, "Node", result ) );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( result, answer1 ) );
+
+    BOOST_CHECK( prefetcher.getNumPrefetchedReads( ) == 1 );
+
+}
+
+BOOST_AUTO_TEST_CASE( testCouplingLogger ){
+    /*!
+     * Test the level gating and the debug file of the coupling logger
+     *
+     */
+
+    inputFileProcessor::couplingLogger logger;
+
+    BOOST_CHECK( logger.getLevel( ) == inputFileProcessor::LOG_INFO );
+    BOOST_CHECK( logger.isEnabled( inputFileProcessor::LOG_WARNING ) );
+    BOOST_CHECK( logger.isEnabled( inputFileProcessor::LOG_INFO ) );
+    BOOST_CHECK( !logger.isEnabled( inputFileProcessor::LOG_DEBUG ) );
+    BOOST_CHECK( !logger.isEnabled( inputFileProcessor::LOG_NONE ) );
+
+    //The message must not be evaluated when the level is disabled
+    uIntType evaluations = 0;
+    COUPLING_LOG( logger, inputFileProcessor::LOG_DEBUG ) << ( evaluations++ );
+    BOOST_CHECK( evaluations == 0 );
+
+    logger.setLevel( inputFileProcessor::LOG_NONE );
+    COUPLING_LOG( logger, inputFileProcessor::LOG_ERROR ) << ( evaluations++ );
+    BOOST_CHECK( evaluations == 0 );
+
+    std::unique_ptr< errorNode > error;
+    error.reset( logger.openDebugFile( "couplingLogger_debug.csv", "json" ) );
+    BOOST_CHECK( error );
+
+    error.reset( logger.openDebugFile( "couplingLogger_debug.csv", "csv" ) );
+    BOOST_CHECK( !error );
+
+    //Rows are only written when the debug level is enabled
+    logger.writeDebugTableRow( "lagrange", 4, 0, { 1, 2 } );
+    BOOST_CHECK( !logger.writesDebugTables( ) );
+
+    logger.setLevel( inputFileProcessor::LOG_DEBUG );
+    BOOST_CHECK( logger.writesDebugTables( ) );
+    logger.writeDebugTableRow( "lagrange", 7, 1, { 0.5, -2 } );
+    logger.closeDebugFile( );
+    BOOST_CHECK( !logger.writesDebugTables( ) );
+
+    std::ifstream csv( "couplingLogger_debug.csv" );
+    std::string line;
+    std::vector< std::string > lines;
+    while ( std::getline( csv, line ) ){
+
+        lines.push_back( line );
+
+    }
+    csv.close( );
+
+    BOOST_CHECK( lines.size( ) == 1 );
+    BOOST_CHECK( lines[ 0 ].compare( "lagrange,7,1,0.5,-2" ) == 0 );
+
+    error.reset( logger.openDebugFile( "couplingLogger_debug.bin", "binary" ) );
+    BOOST_CHECK( !error );
+
+    logger.writeDebugTableRow( "FALQ", 3, 2, { 1.5 } );
+    logger.closeDebugFile( );
+
+    std::ifstream bin( "couplingLogger_debug.bin", std::ios::binary );
+    uint32_t nameLength, ids[ 3 ];
+    bin.read( reinterpret_cast< char* >( &nameLength ), sizeof( uint32_t ) );
+    std::string name( nameLength, ' ' );
+    bin.read( &name[ 0 ], nameLength );
+    bin.read( reinterpret_cast< char* >( ids ), 3 * sizeof( uint32_t ) );
+    floatType value;
+    bin.read( reinterpret_cast< char* >( &value ), sizeof( floatType ) );
+    bin.close( );
+
+    BOOST_CHECK( name.compare( "FALQ" ) == 0 );
+    BOOST_CHECK( ( ids[ 0 ] == 3 ) && ( ids[ 1 ] == 2 ) && ( ids[ 2 ] == 1 ) );
+    BOOST_CHECK( vectorTools::fuzzyEquals( value, 1.5 ) );
+
+    std::remove( "couplingLogger_debug.csv" );
+    std::remove( "couplingLogger_debug.bin" );
+
+    //The messages of a buffered thread are held until they are released
+    logger.setLevel( inputFileProcessor::LOG_INFO );
+
+    std::string workerMessages;
+    std::thread worker( [ & ]( ){
+
+        logger.bufferThreadMessages( );
+        COUPLING_LOG( logger, inputFileProcessor::LOG_INFO ) << "worker message\n";
+        workerMessages = logger.releaseThreadMessages( );
+
+    } );
+    worker.join( );
+
+    BOOST_CHECK( workerMessages.compare( "worker message\n" ) == 0 );
+    BOOST_CHECK( &logger.getStream( ) == &std::cerr );
+    BOOST_CHECK( logger.releaseThreadMessages( ).empty( ) );
+
+}
+
+BOOST_AUTO_TEST_CASE( testAppendUniqueIds ){
+    /*!
+     * Test the construction of the unique ids of a collection of domains
+     *
+     */
+
+    uIntVector domain1 = { 5, 2, 9, 2, 0 };
+    uIntVector domain2 = { 9, 12, 5, 1, 12 };
+
+    uIntVector answer = { 5, 2, 9, 0, 12, 1 };
+
+    boolVector seen;
+    std::unordered_set< uIntType > sparseSeen;
+    uIntVector uniqueIds;
+
+    inputFileProcessor::appendUniqueIds( domain1, seen, sparseSeen, uniqueIds );
+    inputFileProcessor::appendUniqueIds( domain2, seen, sparseSeen, uniqueIds );
+
+    BOOST_CHECK( uniqueIds == answer );
+
+    BOOST_CHECK( sparseSeen.empty( ) );
+
+    //Every node appears in two overlapping domains in a scrambled order
+    uIntType n = 100000;
+
+    domain1 = uIntVector( n );
+    domain2 = uIntVector( n );
+
+    for ( uIntType i = 0; i < n; i++ ){
+
+        domain1[ i ] = ( uIntType )( ( 7919ULL * i ) % n );
+        domain2[ i ] = ( uIntType )( ( 104729ULL * i ) % n );
+
+    }
+
+    seen.clear( );
+    uniqueIds.clear( );
+
+    inputFileProcessor::appendUniqueIds( domain1, seen, sparseSeen, uniqueIds );
+    inputFileProcessor::appendUniqueIds( domain2, seen, sparseSeen, uniqueIds );
+
+    BOOST_CHECK( uniqueIds == domain1 );
+
+    BOOST_CHECK( sparseSeen.empty( ) );
+
+    BOOST_CHECK( seen.size( ) >= n );
+
+}
+
+BOOST_AUTO_TEST_CASE( testAppendUniqueIds_sparse ){
+    /*!
+     * Test the construction of the unique ids when the ids are sparse so that a hash set is
+     * used in place of the bitmap
+     *
+     */
+
+    //Very large ids are tracked by the hash set
+    uIntVector domain1 = { 4000000000, 7, 3000000000, 7 };
+    uIntVector domain2 = { 3000000000, 12, 4000000000 };
+
+    uIntVector answer = { 4000000000, 7, 3000000000, 12 };
+
+    boolVector seen;
+    std::unordered_set< uIntType > sparseSeen;
+    uIntVector uniqueIds;
+
+    inputFileProcessor::appendUniqueIds( domain1, seen, sparseSeen, uniqueIds );
+    inputFileProcessor::appendUniqueIds( domain2, seen, sparseSeen, uniqueIds );
+
+    BOOST_CHECK( uniqueIds == answer );
+
+    BOOST_CHECK( seen.empty( ) );
+
+    BOOST_CHECK( sparseSeen.size( ) == 4 );
+
+    //The ids which were tracked by the bitmap are moved to the hash set when a sparse id appears
+    domain1 = { 5, 2, 9, 2, 0 };
+    domain2 = { 9, 2000000000, 5, 1, 2000000000 };
+
+    answer = { 5, 2, 9, 0, 2000000000, 1 };
+
+    seen.clear( );
+    sparseSeen.clear( );
+    uniqueIds.clear( );
+
+    inputFileProcessor::appendUniqueIds( domain1, seen, sparseSeen, uniqueIds );
+
+    BOOST_CHECK( sparseSeen.empty( ) );
+
+    inputFileProcessor::appendUniqueIds( domain2, seen, sparseSeen, uniqueIds );
+
+    BOOST_CHECK( uniqueIds == answer );
+
+    BOOST_CHECK( seen.empty( ) );
+
+    BOOST_CHECK( sparseSeen.size( ) == 6 );
+
+}
@@ -21,6 +21,21 @@ typedef volumeReconstruction::intMatrix intMatrix; //!Define a matrix of ints
 typedef volumeReconstruction::uIntType uIntType; //!Define the unsigned int type
 typedef volumeReconstruction::uIntVector uIntVector; //!Define a vector of unsigned ints
 
+class dualContouringTester : public volumeReconstruction::dualContouring {
+    /*!
+     * Expose the protected radial basis functions of dualContouring for testing
+     */
+
+    public:
+
+        dualContouringTester( const YAML::Node &configuration ) : volumeReconstruction::dualContouring( configuration ){ }
+
+        using volumeReconstruction::dualContouring::rbf;
+
+        using volumeReconstruction::dualContouring::grad_rbf;
+
+};
+
 BOOST_AUTO_TEST_CASE( testDualContouring_constructor ){
     /*!
      * Tests for the constructors of dualContouring
@@ -39,6 +54,39 @@ BOOST_AUTO_TEST_CASE( testDualContouring_constructor ){
 
 }
 
+BOOST_AUTO_TEST_CASE( testDualContouring_queryThreadCount ){
+    /*!
+     * Test that malformed query thread counts are reported as errors when the
+     * configuration is processed
+     *
+     */
+
+    floatVector points = { 1, 2, 3, 4, 5, 6 };
+
+    std::vector< YAML::Node > badValues = { YAML::Node( -1 ), YAML::Node( "many" ) };
+
+    for ( auto value = badValues.begin( ); value != badValues.end( ); value++ ){
+
+        YAML::Node yf = YAML::LoadFile( "volumeReconstruction_dualContouring.yaml" );
+        yf[ "interpolation" ][ "query_thread_count" ] = *value;
+
+        volumeReconstruction::dualContouring dc( yf );
+
+        BOOST_CHECK( !dc.getError( ) );
+
+        std::unique_ptr< errorNode > error;
+        error.reset( dc.loadPoints( &points ) );
+
+        BOOST_CHECK( !error );
+
+        error.reset( dc.evaluate( ) );
+
+        BOOST_CHECK( error );
+
+    }
+
+}
+
 BOOST_AUTO_TEST_CASE( testDualContouring_loadPoints ){
     /*!
      * Test for loading the points into the object
@@ -624,6 +672,303 @@ BOOST_AUTO_TEST_CASE( testKDNode_getPointsWithinRadiusOfOrigin ){
 
 }
 
+BOOST_AUTO_TEST_CASE( testKDNode_getPointsWithinRadiusOfOrigins ){
+    /*!
+     * Get all of the points within a given radius of a collection of origins
+     *
+     */
+
+    floatVector points = { 1, 10, 50, 50, 10, 30, 35, 90, 55, 1, 60, 80, 25, 40, 70, 70, 51, 75 };
+    uIntVector ownedIndices = { 0, 2, 4, 6, 8, 10, 12, 14, 16 };
+    unsigned int dim = 2;
+
+    volumeReconstruction::KDNode tree( &points, ownedIndices, 0, dim, 2 );
+
+    floatVector origins = { 4.5, 2.1, 50, 60, 1000, 1000, 30, 35 };
+    floatType radius = 20.;
+
+    uIntVector offsetsAnswer = { 0 };
+    uIntVector indicesAnswer;
+
+    for ( uIntType i = 0; i < origins.size( ) / dim; i++ ){
+
+        floatVector origin( origins.begin( ) + dim * i, origins.begin( ) + dim * ( i + 1 ) );
+
+        tree.getPointsWithinRadiusOfOrigin( origin, radius, indicesAnswer );
+
+        offsetsAnswer.push_back( indicesAnswer.size( ) );
+
+    }
+
+    for ( uIntType threadCount = 1; threadCount < 4; threadCount++ ){
+
+        uIntVector offsetsResult, indicesResult;
+
+        tree.getPointsWithinRadiusOfOrigins( origins, radius, offsetsResult, indicesResult, threadCount );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( offsetsResult, offsetsAnswer ) );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( indicesResult, indicesAnswer ) );
+
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE( testKDNode_getKNearestNeighbors ){
+    /*!
+     * Get the k nearest neighbors of a point
+     *
+     */
+
+    floatVector points = { 2, 3, 5, 4, 9, 6, 4, 7, 8, 1, 7, 2 };
+    uIntVector  ownedIndices = { 0, 2, 4, 6, 8, 10 };
+    unsigned int dim = 2;
+    floatVector origin = { 4.5, 2.1 };
+
+    volumeReconstruction::KDNode tree( &points, ownedIndices, 0, dim );
+
+    uIntVector indicesAnswer = { 2, 10, 0 };
+
+    uIntVector indicesResult;
+    floatVector distancesResult;
+
+    tree.getKNearestNeighbors( origin, 3, indicesResult, distancesResult );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( indicesResult, indicesAnswer ) );
+
+    BOOST_CHECK( distancesResult.size( ) == indicesAnswer.size( ) );
+
+    for ( uIntType i = 0; i < indicesAnswer.size( ); i++ ){
+
+        floatVector xi( points.begin( ) + indicesAnswer[ i ], points.begin( ) + indicesAnswer[ i ] + dim );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( distancesResult[ i ], vectorTools::l2norm( xi - origin ) ) );
+
+    }
+
+    //Requesting more points than are in the tree returns all of them
+    tree.getKNearestNeighbors( origin, 10, indicesResult, distancesResult );
+
+    BOOST_CHECK( indicesResult.size( ) == ownedIndices.size( ) );
+
+    BOOST_CHECK( std::is_sorted( distancesResult.begin( ), distancesResult.end( ) ) );
+
+    //Compare against a brute force search on a larger point set
+    dim = 3;
+    uIntType nPoints = 200;
+    uIntType k = 7;
+
+    floatVector points2( dim * nPoints );
+    uIntVector ownedIndices2( nPoints );
+
+    for ( uIntType i = 0; i < nPoints; i++ ){
+
+        for ( uIntType j = 0; j < dim; j++ ){
+
+            points2[ dim * i + j ] = std::sin( 1.3 * i + 0.7 * j * j + 0.1 * i * j );
+
+        }
+
+        ownedIndices2[ i ] = dim * i;
+
+    }
+
+    volumeReconstruction::KDNode tree2( &points2, ownedIndices2, 0, dim );
+
+    for ( uIntType i = 0; i < nPoints; i += 17 ){
+
+        floatVector x0( points2.begin( ) + dim * i, points2.begin( ) + dim * i + dim );
+        x0 += 0.05;
+
+        floatVector bruteForceDistances( nPoints );
+
+        for ( uIntType j = 0; j < nPoints; j++ ){
+
+            floatVector xj( points2.begin( ) + dim * j, points2.begin( ) + dim * j + dim );
+
+            bruteForceDistances[ j ] = vectorTools::l2norm( xj - x0 );
+
+        }
+
+        std::sort( bruteForceDistances.begin( ), bruteForceDistances.end( ) );
+
+        tree2.getKNearestNeighbors( x0, k, indicesResult, distancesResult );
+
+        BOOST_CHECK( indicesResult.size( ) == k );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( distancesResult,
+                                               floatVector( bruteForceDistances.begin( ), bruteForceDistances.begin( ) + k ) ) );
+
+        for ( uIntType j = 0; j < k; j++ ){
+
+            floatVector xj( points2.begin( ) + indicesResult[ j ], points2.begin( ) + indicesResult[ j ] + dim );
+
+            BOOST_CHECK( vectorTools::fuzzyEquals( distancesResult[ j ], vectorTools::l2norm( xj - x0 ) ) );
+
+        }
+
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE( testKDNode_bucketSize ){
+    /*!
+     * Test that the queries are independent of the number of points stored in the leaves
+     *
+     */
+
+    unsigned int dim = 3;
+    uIntType nPoints = 150;
+
+    floatVector points( dim * nPoints );
+    uIntVector ownedIndices( nPoints );
+
+    for ( uIntType i = 0; i < nPoints; i++ ){
+
+        for ( uIntType j = 0; j < dim; j++ ){
+
+            points[ dim * i + j ] = std::cos( 2.1 * i + 0.3 * j + 0.05 * i * j );
+
+        }
+
+        ownedIndices[ i ] = dim * i;
+
+    }
+
+    floatVector origin = { 0.1, -0.2, 0.3 };
+    floatType radius = 0.6;
+
+    floatVector upperBounds = { 0.5, 0.4, 0.9 };
+    floatVector lowerBounds = { -0.3, -0.7, -0.1 };
+
+    uIntVector radiusAnswer;
+    uIntVector rangeAnswer;
+
+    for ( uIntType i = 0; i < nPoints; i++ ){
+
+        floatVector xi( points.begin( ) + dim * i, points.begin( ) + dim * i + dim );
+
+        if ( vectorTools::l2norm( xi - origin ) <= radius ){
+
+            radiusAnswer.push_back( dim * i );
+
+        }
+
+        bool inside = true;
+
+        for ( uIntType j = 0; j < dim; j++ ){
+
+            inside = inside && ( xi[ j ] <= upperBounds[ j ] ) && ( xi[ j ] >= lowerBounds[ j ] );
+
+        }
+
+        if ( inside ){
+
+            rangeAnswer.push_back( dim * i );
+
+        }
+
+    }
+
+    for ( uIntType bucketSize : { 1, 4, 16, 1000 } ){
+
+        volumeReconstruction::KDNode tree( &points, ownedIndices, 0, dim, bucketSize );
+
+        uIntVector result;
+
+        tree.getPointsWithinRadiusOfOrigin( origin, radius, result );
+
+        std::sort( result.begin( ), result.end( ) );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( result, radiusAnswer ) );
+
+        result.clear( );
+
+        tree.getPointsInRange( upperBounds, lowerBounds, result );
+
+        std::sort( result.begin( ), result.end( ) );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( result, rangeAnswer ) );
+
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE( testKDNode_removePointsWithinRadiusOfOrigin ){
+    /*!
+     * Remove the points within a given radius of the origin from the tree
+     *
+     */
+
+    floatVector points = { 2, 3, 5, 4, 9, 6, 4, 7, 8, 1, 7, 2 };
+    uIntVector  ownedIndices = { 0, 2, 4, 6, 8, 10 };
+    unsigned int dim = 2;
+    floatVector origin = { 4.5, 2.1 };
+    floatType radius = 3.0;
+
+    volumeReconstruction::KDNode tree( &points, ownedIndices, 0, dim );
+
+    BOOST_CHECK( *tree.getLiveCount( ) == 6 );
+
+    uIntVector answer = { 0, 2, 10 };
+
+    uIntVector result;
+
+    tree.removePointsWithinRadiusOfOrigin( origin, radius, result );
+
+    std::sort( result.begin( ), result.end( ) );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( result, answer ) );
+
+    BOOST_CHECK( *tree.getLiveCount( ) == 3 );
+
+    //Removed points are no longer found by the queries
+    result.clear( );
+
+    tree.getPointsWithinRadiusOfOrigin( origin, radius, result );
+
+    BOOST_CHECK( result.size( ) == 0 );
+
+    result.clear( );
+
+    tree.getPointsInRange( { 10, 10 }, { 0, 0 }, result );
+
+    std::sort( result.begin( ), result.end( ) );
+
+    answer = { 4, 6, 8 };
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( result, answer ) );
+
+    floatVector distances;
+
+    tree.getKNearestNeighbors( origin, 1, result, distances );
+
+    answer = { 8 };
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( result, answer ) );
+
+    //Removing the same region again removes nothing
+    result.clear( );
+
+    tree.removePointsWithinRadiusOfOrigin( origin, radius, result );
+
+    BOOST_CHECK( result.size( ) == 0 );
+
+    BOOST_CHECK( *tree.getLiveCount( ) == 3 );
+
+    //Remove the remaining points
+    tree.removePointsWithinRadiusOfOrigin( origin, 100., result );
+
+    std::sort( result.begin( ), result.end( ) );
+
+    answer = { 4, 6, 8 };
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( result, answer ) );
+
+    BOOST_CHECK( *tree.getLiveCount( ) == 0 );
+
+}
+
 BOOST_AUTO_TEST_CASE( testDualContouring_evaluate ){
     /*!
      * Test the dualContouring evaluate function. This prepares the 
@@ -925,6 +1270,44 @@ BOOST_AUTO_TEST_CASE( testDualContouring_performVolumeIntegration ){
 
     BOOST_CHECK( vectorTools::fuzzyEquals( integratedVolumeResult, integratedVolumeAnswer ) );
 
+    //Integrate a second function which re-uses the interpolation operator
+    floatType volume = integratedVolumeResult[ 0 ];
+
+    floatVector functionValues2( points.size( ) / 3 * 2 );
+    for ( unsigned int i = 0; i < functionValues2.size( ); i+=2 ){
+
+        functionValues2[ i + 0 ] = -2;
+        functionValues2[ i + 1 ] = 4;
+
+    }
+
+    floatVector integratedVolumeAnswer2 = { -2 * volume, 4 * volume };
+
+    error = dc.performVolumeIntegration( functionValues2, 2, integratedVolumeResult );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( integratedVolumeResult, integratedVolumeAnswer2 ) );
+
+    //The multithreaded reconstruction must be identical to the serial one
+    YAML::Node yfThreaded = YAML::LoadFile( "volumeReconstruction_dualContouring.yaml" );
+    yfThreaded[ "interpolation" ][ "query_thread_count" ] = 3;
+    volumeReconstruction::dualContouring dcThreaded( yfThreaded );
+
+    BOOST_CHECK( !dcThreaded.getError( ) );
+
+    error = dcThreaded.loadPoints( &points );
+
+    BOOST_CHECK( !error );
+
+    floatVector integratedVolumeThreaded;
+
+    error = dcThreaded.performVolumeIntegration( functionValues2, 2, integratedVolumeThreaded );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( integratedVolumeThreaded == integratedVolumeResult );
+
 }
 
 BOOST_AUTO_TEST_CASE( testDualContouring_performRelativePositionVolumeIntegration ){
@@ -2290,3 +2673,129 @@ BOOST_AUTO_TEST_CASE( testDualContouring_localBoundary ){
     BOOST_CHECK( vectorTools::fuzzyEquals( areaResult[ 0 ], areaAnswer ) );
 
 }
+
+BOOST_AUTO_TEST_CASE( testDualContouring_blockRBF ){
+    /*!
+     * Test that the block radial basis functions and their gradients are the same as
+     * the single point versions including when the point coincides with a data point
+     */
+
+    floatVector points = { 0.0, 0.0, 0.0,
+                           1.0, 0.5, 0.2,
+                           0.3, 0.1, 0.4,
+                          -0.2, 0.8, 0.6 };
+
+    uIntVector pointIndices = { 9, 0, 6, 3 };
+
+    floatType ls = 0.7;
+
+    YAML::Node yf = YAML::LoadFile( "volumeReconstruction_dualContouring.yaml" );
+    dualContouringTester dc( yf );
+
+    BOOST_CHECK( !dc.getError( ) );
+
+    std::unique_ptr< errorNode > error;
+    error.reset( dc.loadPoints( &points ) );
+
+    BOOST_CHECK( !error );
+
+    //The first point is away from the data points and the second coincides with one of them
+    floatMatrix xs = { { 0.25, -0.1, 0.3 }, { 0.3, 0.1, 0.4 } };
+
+    //The workspace of the differences is re-used between the calls
+    floatVector differences;
+
+    for ( auto x = xs.begin( ); x != xs.end( ); x++ ){
+
+        floatVector values, gradValues, gradients;
+
+        error.reset( dc.rbf( *x, pointIndices.data( ), pointIndices.size( ), ls, differences, values ) );
+
+        BOOST_CHECK( !error );
+
+        error.reset( dc.grad_rbf( *x, pointIndices.data( ), pointIndices.size( ), ls, differences, gradValues, gradients ) );
+
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( values.size( ) == pointIndices.size( ) );
+
+        BOOST_CHECK( gradients.size( ) == 3 * pointIndices.size( ) );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( gradValues, values ) );
+
+        for ( uIntType i = 0; i < pointIndices.size( ); i++ ){
+
+            floatVector x0( points.begin( ) + pointIndices[ i ], points.begin( ) + pointIndices[ i ] + 3 );
+
+            floatType value;
+            floatVector gradient;
+
+            error.reset( dc.rbf( *x, x0, ls, value ) );
+
+            BOOST_CHECK( !error );
+
+            error.reset( dc.grad_rbf( *x, x0, ls, gradient ) );
+
+            BOOST_CHECK( !error );
+
+            BOOST_CHECK( vectorTools::fuzzyEquals( values[ i ], value ) );
+
+            BOOST_CHECK( vectorTools::fuzzyEquals( floatVector( gradients.begin( ) + 3 * i, gradients.begin( ) + 3 * ( i + 1 ) ), gradient ) );
+
+        }
+
+    }
+
+    //The gradient at a data point is zero
+    floatVector values, gradients;
+
+    error.reset( dc.grad_rbf( xs[ 1 ], pointIndices.data( ) + 2, 1, ls, differences, values, gradients ) );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( values, { 1. } ) );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( gradients, { 0., 0., 0. } ) );
+
+    //Outside of the bounding planes the values are zero and the gradients point inwards
+    floatMatrix planePoints = { { 0.2, 0.0, 0.0 } };
+    floatMatrix planeNormals = { { 1.0, 0.0, 0.0 } };
+
+    error.reset( dc.addBoundingPlanes( planePoints, planeNormals ) );
+
+    BOOST_CHECK( !error );
+
+    error.reset( dc.rbf( xs[ 0 ], pointIndices.data( ), pointIndices.size( ), ls, differences, values ) );
+
+    BOOST_CHECK( !error );
+
+    BOOST_CHECK( vectorTools::fuzzyEquals( values, floatVector( pointIndices.size( ), 0 ) ) );
+
+    error.reset( dc.grad_rbf( xs[ 0 ], pointIndices.data( ), pointIndices.size( ), ls, differences, values, gradients ) );
+
+    BOOST_CHECK( !error );
+
+    for ( uIntType i = 0; i < pointIndices.size( ); i++ ){
+
+        floatVector x0( points.begin( ) + pointIndices[ i ], points.begin( ) + pointIndices[ i ] + 3 );
+
+        floatType value;
+        floatVector gradient;
+
+        error.reset( dc.rbf( xs[ 0 ], x0, ls, value ) );
+
+        BOOST_CHECK( !error );
+
+        error.reset( dc.grad_rbf( xs[ 0 ], x0, ls, gradient ) );
+
+        BOOST_CHECK( !error );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( values[ i ], value ) );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( floatVector( gradients.begin( ) + 3 * i, gradients.begin( ) + 3 * ( i + 1 ) ), gradient ) );
+
+        BOOST_CHECK( vectorTools::fuzzyEquals( gradient, { -1., 0., 0. } ) );
+
+    }
+
+}
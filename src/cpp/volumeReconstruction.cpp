@@ -6,6 +6,7 @@
 
 #include<volumeReconstruction.h>
 #include<solver_tools.h>
+#include<thread>
 
 #include "Xdmf.hpp"
 
@@ -30,144 +31,193 @@ namespace volumeReconstruction{
     }
 
     KDNode::KDNode( const floatVector *points, const uIntVector &ownedIndices,
-                    const uIntType &depth, const uIntType &dim ){
+                    const uIntType &depth, const uIntType &dim, const uIntType &bucketSize ){
 
         /*!
          * The constructor for the KD tree
          *
          * :param const floatVector *points: The points to be sorted into the tree
          * :param const uIntVector &ownedIndices: The indices of the points which this
-         *     node is dividing. These are indices to the first values of the 
+         *     tree is dividing. These are indices to the first values of the 
          *     points in the 'points' vector.
-         * :param const uIntType &depth: The depth of the current node
+         * :param const uIntType &depth: The depth of the root of the tree
          * :param const uIntType &dim: The dimension of the points
+         * :param const uIntType &bucketSize: The maximum number of points stored in a leaf
          */
 
         //Set the points
         _points = points;
+        _dim = dim;
 
         //Set the depth of the node
         _depth = depth;
 
-        //Determine if this is the last node in the chain
-        if ( ownedIndices.size( ) == 1 ){
-            _index = ownedIndices[ 0 ];
-            _axis = 0;
+        _bucketSize = std::max( bucketSize, ( uIntType )1 );
+
+        //All of the points start out live
+        _permutation = ownedIndices;
+        _deleted = std::vector< bool >( _permutation.size( ), false );
+        _liveCount = _permutation.size( );
+
+        if ( _permutation.size( ) == 0 ){
+
             return;
+
         }
 
         //Determine the bounding box of the points
-        floatVector lowerBound( _points->begin( ) + ownedIndices[ 0 ],
-                                _points->begin( ) + ownedIndices[ 0 ] + dim );
+        _lowerBounds = floatVector( _points->begin( ) + _permutation[ 0 ],
+                                    _points->begin( ) + _permutation[ 0 ] + _dim );
 
-        floatVector upperBound( _points->begin( ) + ownedIndices[ 0 ],
-                                _points->begin( ) + ownedIndices[ 0 ] + dim );
+        _upperBounds = _lowerBounds;
 
-        for ( auto index = ownedIndices.begin( ) + 1; index != ownedIndices.end( ); index++ ){
+        for ( auto index = _permutation.begin( ) + 1; index != _permutation.end( ); index++ ){
+
+            for ( uIntType i = 0; i < _dim; i++ ){
+
+                _lowerBounds[ i ] = std::fmin( _lowerBounds[ i ], ( *_points )[ *index + i ] );
+                _upperBounds[ i ] = std::fmax( _upperBounds[ i ], ( *_points )[ *index + i ] );
 
-            //Compare the current point against the bounds
-            for ( uIntType i = 0; i < dim; i++ ){
-                if ( ( *_points )[ *index + i ] > upperBound[ i ] ){
-                    upperBound[ i ] = ( *_points )[ *index + i ];
-                }
-                else if ( ( *_points )[ *index + i ] < lowerBound[ i ] ){
-                    lowerBound[ i ] = ( *_points )[ *index + i ];
-                }
             }
 
         }
 
-        //Determine which dimension has the largest variation. That is the axis
-        //we want to split our domain by
-        floatVector delta = upperBound - lowerBound;
-        _axis = 0;
-        floatType deltaMax = delta[ _axis ];
-
-        uIntType a = 0;
+        //Form the nodes of the tree
+        _nodes.reserve( 2 * ( _permutation.size( ) / _bucketSize + 1 ) );
 
-        for ( auto v = delta.begin( ) + 1; v != delta.end( ); v++ ){
+        buildNode( 0, _permutation.size( ) );
 
-            if ( deltaMax < *v ){
+        //The index of the tree is the point which splits the root
+        _index = _permutation[ _nodes[ 0 ].middle ];
 
-                _axis = a;
-                deltaMax = *v;
+        return;
+    }
 
-            }
+    uIntType KDNode::buildNode( const uIntType &begin, const uIntType &end ){
+        /*!
+         * Form the node which owns the points in the range [ begin, end ) of the permutation
+         * and all of its children.
+         *
+         * :param const uIntType &begin: The start of the node's range in the permutation
+         * :param const uIntType &end: The end of the node's range in the permutation
+         *
+         * returns the location of the node in the node vector
+         */
 
-            a++;
+        uIntType nodeIndex = _nodes.size( );
+        _nodes.push_back( treeNode( ) );
 
-        }
+        uIntType middle = begin + ( end - begin ) / 2;
 
-        //Accumulate the dimension indicated by axis
-        typedef std::pair< const uIntType*, const floatType* > valueMap;
-        
-        std::vector< valueMap > values;
-        values.reserve( _points->size( ) / dim );
+        _nodes[ nodeIndex ].begin = begin;
+        _nodes[ nodeIndex ].end = end;
+        _nodes[ nodeIndex ].middle = middle;
+        _nodes[ nodeIndex ].axis = 0;
+        _nodes[ nodeIndex ].liveCount = end - begin;
 
-        for ( auto index = ownedIndices.begin( ); index != ownedIndices.end( ); index++ ){
+        if ( ( end - begin ) <= _bucketSize ){
 
-            values.push_back( valueMap( &( *index), &( *_points )[ *index + _axis ] ) );
+            //This node is a leaf
+            _nodes[ nodeIndex ].split = ( *_points )[ _permutation[ middle ] ];
+            return nodeIndex;
 
         }
 
-        //Sort the value vector
-        sort( values.begin( ), values.end( ),
-              []( const valueMap &a,
-                  const valueMap &b ){
-                  return *a.second < *b.second;
-              }
-            );
+        //Determine the bounding box of the node's points
+        floatVector lowerBound( _points->begin( ) + _permutation[ begin ],
+                                _points->begin( ) + _permutation[ begin ] + _dim );
 
-        //Get the index of the current node
-        _index = *values[ values.size( ) / 2 ].first;
+        floatVector upperBound = lowerBound;
 
-        //Split the indices into left and right indices
-        uIntVector left_indices;
-        left_indices.reserve( values.size( ) / 2 );
+        for ( uIntType p = begin + 1; p < end; p++ ){
 
-        uIntVector right_indices;
-        right_indices.reserve( values.size( ) - ( values.size( ) / 2 + 1 ) );
+            for ( uIntType i = 0; i < _dim; i++ ){
 
-        for ( auto v = values.begin( ); v < values.begin( ) + values.size( ) / 2; v++ ){
+                lowerBound[ i ] = std::fmin( lowerBound[ i ], ( *_points )[ _permutation[ p ] + i ] );
+                upperBound[ i ] = std::fmax( upperBound[ i ], ( *_points )[ _permutation[ p ] + i ] );
 
-            left_indices.push_back( *v->first );
+            }
 
         }
 
-        for ( auto v = values.begin( ) + values.size( ) /2 + 1; v != values.end( ); v++ ){
+        //Determine which dimension has the largest variation. That is the axis
+        //we want to split our domain by
+        uIntType axis = 0;
 
-            right_indices.push_back( *v->first );
+        for ( uIntType i = 1; i < _dim; i++ ){
+
+            if ( ( upperBound[ i ] - lowerBound[ i ] ) > ( upperBound[ axis ] - lowerBound[ axis ] ) ){
+
+                axis = i;
+
+            }
 
         }
 
+        //Partition the points about the median of the axis
+        const floatVector *points = _points;
+
+        std::nth_element( _permutation.begin( ) + begin, _permutation.begin( ) + middle, _permutation.begin( ) + end,
+                          [ & ]( const uIntType &a, const uIntType &b ){
+                              return ( *points )[ a + axis ] < ( *points )[ b + axis ];
+                          }
+                        );
+
+        _nodes[ nodeIndex ].axis = axis;
+        _nodes[ nodeIndex ].split = ( *_points )[ _permutation[ middle ] + axis ];
+
         //Form the left and right nodes
-        if ( left_indices.size( ) > 0 ){
+        intType left  = buildNode( begin, middle );
+        intType right = buildNode( middle, end );
 
-            left_child  = std::unique_ptr< KDNode >( new KDNode( _points, left_indices, depth + 1, dim ) );
+        _nodes[ nodeIndex ].left  = left;
+        _nodes[ nodeIndex ].right = right;
 
-        }
+        return nodeIndex;
+
+    }
+
+    floatType KDNode::squaredDistance( const floatType *origin, const uIntType &index ){
+        /*!
+         * Compute the squared distance between the origin and a point in the tree
+         *
+         * :param const floatType *origin: The first value of the origin
+         * :param const uIntType &index: The index of the first value of the point
+         */
+
+        floatType distanceSquared = 0;
 
-        if ( right_indices.size( ) > 0 ){
+        for ( uIntType i = 0; i < _dim; i++ ){
 
-            right_child = std::unique_ptr< KDNode >( new KDNode( _points, right_indices, depth + 1, dim ) );
+            floatType delta = ( *_points )[ index + i ] - origin[ i ];
+            distanceSquared += delta * delta;
 
         }
 
-        return;
+        return distanceSquared;
+
     }
 
     const uIntType* KDNode::getIndex( ){
         /*!
-         * Get the index associated with this KD node
+         * Get the index of the point which splits the root of the tree
          */
 
         return &_index;
     }
 
+    const uIntType* KDNode::getLiveCount( ){
+        /*!
+         * Get the number of points in the tree which have not been removed
+         */
+
+        return &_liveCount;
+    }
+
     void KDNode::getPointsInRange( const floatVector &upperBounds, const floatVector &lowerBounds,
                                    uIntVector &indices,
-                                   floatVector *domainUpperBounds,
-                                   floatVector *domainLowerBounds ){
+                                   floatVector * /*domainUpperBounds*/,
+                                   floatVector * /*domainLowerBounds*/ ){
         /*!
          * Get all of the points within the range specified by the rectangular boundary defined by the bounds
          *
@@ -175,80 +225,89 @@ namespace volumeReconstruction{
          * :param const floatVector &lowerBounds: The lower bounds of the boundary
          * :param uIntVector &indices: The indices of the points ( or rather their first index in the point vector )
          *     of the points contained within the boundary
-         * :param floatVector *domainUpperBounds: The upper boundary of the current domain. If NULL it will be
-         *     calculated
-         * :param floatVector &domainLowerBounds: The lower boundary of the current domain. If NULL it will be
-         *     calculated
+         * :param floatVector *domainUpperBounds: The upper boundary of the current domain. Retained for
+         *     compatibility. The tree's splitting planes are used to prune the search.
+         * :param floatVector *domainLowerBounds: The lower boundary of the current domain. Retained for
+         *     compatibility. The tree's splitting planes are used to prune the search.
          */
 
-        //Get the dimension
-        uIntType dim = upperBounds.size( );
+        if ( _nodes.size( ) == 0 ){
 
-        floatVector _domainUpperBounds;
-        floatVector _domainLowerBounds;
+            return;
 
-        //Assemble the current point
-        floatVector median( _points->begin( ) + _index,
-                            _points->begin( ) + _index + dim );
+        }
 
-        floatVector upperDelta, lowerDelta;
+        getPointsInRange( 0, upperBounds, lowerBounds, indices );
 
-        if( !domainUpperBounds ){
-            
-            _domainUpperBounds = floatVector( dim );
-            _domainLowerBounds = floatVector( dim );
+    }
 
-            for ( uIntType i = 0; i < dim; i++ ){
+    void KDNode::getPointsInRange( const uIntType &node, const floatVector &upperBounds,
+                                   const floatVector &lowerBounds, uIntVector &indices ){
+        /*!
+         * Get all of the points owned by a node within the range specified by the rectangular boundary
+         *
+         * :param const uIntType &node: The node to search
+         * :param const floatVector &upperBounds: The upper bounds of the boundary
+         * :param const floatVector &lowerBounds: The lower bounds of the boundary
+         * :param uIntVector &indices: The indices of the points contained within the boundary
+         */
 
-                _domainUpperBounds[ i ] = getMaximumValueDimension( i );
-                _domainLowerBounds[ i ] = getMinimumValueDimension( i );
+        const treeNode &current = _nodes[ node ];
 
-            }
+        if ( current.liveCount == 0 ){
 
-            //Reassign the pointers
-            domainUpperBounds = &_domainUpperBounds;
-            domainLowerBounds = &_domainLowerBounds;
+            return;
 
         }
 
-        //Check if the current point is within the range
-        upperDelta = upperBounds - median;
-        lowerDelta = median - lowerBounds;
+        if ( current.left < 0 ){
 
-        if ( ( std::all_of( upperDelta.begin( ),
-                            upperDelta.end( ),
-                            [&]( floatType v ){ return v >= 0; } ) ) &&
-               std::all_of( lowerDelta.begin( ),
-                            lowerDelta.end( ),
-                            [&]( floatType v ){ return v >= 0; } ) ){
+            for ( uIntType p = current.begin; p < current.end; p++ ){
 
-            indices.push_back( _index );
+                if ( _deleted[ p ] ){
 
-        }
+                    continue;
+
+                }
+
+                bool inside = true;
+
+                for ( uIntType i = 0; i < upperBounds.size( ); i++ ){
+
+                    floatType value = ( *_points )[ _permutation[ p ] + i ];
+
+                    if ( ( value > upperBounds[ i ] ) || ( value < lowerBounds[ i ] ) ){
+
+                        inside = false;
+                        break;
+
+                    }
+
+                }
+
+                if ( inside ){
 
-        //Check the left child exists and is within range for the current axis
-        if ( ( left_child ) &&
-             lowerDelta[ _axis ] >= 0 ){
+                    indices.push_back( _permutation[ p ] );
 
-             floatVector newDomainUpperBounds = *domainUpperBounds;
-             newDomainUpperBounds[ _axis ] = median[ _axis ];
+                }
+
+            }
 
-             left_child->getPointsInRange( upperBounds, lowerBounds,
-                                           indices,
-                                           &newDomainUpperBounds, domainLowerBounds );
+            return;
 
         }
 
-        //Check the right child exists and is within range
-        if ( ( right_child ) &&
-             upperDelta[ _axis ] >= 0 ){
+        //The left child only contains points with values less than or equal to the split on the axis
+        if ( lowerBounds[ current.axis ] <= current.split ){
+
+            getPointsInRange( current.left, upperBounds, lowerBounds, indices );
+
+        }
 
-             floatVector newDomainLowerBounds = *domainLowerBounds;
-             newDomainLowerBounds[ _axis ] = median[ _axis ];
+        //The right child only contains points with values greater than or equal to the split on the axis
+        if ( upperBounds[ current.axis ] >= current.split ){
 
-             right_child->getPointsInRange( upperBounds, lowerBounds,
-                                            indices,
-                                            domainUpperBounds, &newDomainLowerBounds );
+            getPointsInRange( current.right, upperBounds, lowerBounds, indices );
 
         }
 
@@ -256,141 +315,194 @@ namespace volumeReconstruction{
 
     void KDNode::getPointsWithinRadiusOfOrigin( const floatVector &origin, const floatType &radius,
                                                 uIntVector &indices,
-                                                floatVector *domainUpperBounds,
-                                                floatVector *domainLowerBounds ){
+                                                floatVector * /*domainUpperBounds*/,
+                                                floatVector * /*domainLowerBounds*/ ){
         /*!
          * Find all of the points within a given radius of the origin
          *
          * :param const floatVector &origin: The origin to use as the reference point for the origin
          * :param const floatType &radius: The radius to use as the bound
          * :param uIntVector &indices: The indices contained within the radius
-         * :param floatVector *domainUpperBounds: The upper bounds of the domain associated with the node
-         * :param floatVector *domainLowerBounds: The lower bounds of the domain associated with the node
+         * :param floatVector *domainUpperBounds: The upper bounds of the domain. Retained for
+         *     compatibility. The tree's splitting planes are used to prune the search.
+         * :param floatVector *domainLowerBounds: The lower bounds of the domain. Retained for
+         *     compatibility. The tree's splitting planes are used to prune the search.
          */
 
-        //Get the dimension
-        uIntType dim = origin.size( );
+        uIntVector stack;
 
-        floatVector _domainUpperBounds;
-        floatVector _domainLowerBounds;
+        getPointsWithinRadiusOfOrigin( origin.data( ), radius * radius, indices, stack );
 
-        //Assemble the current point
-        floatVector median( _points->begin( ) + _index,
-                            _points->begin( ) + _index + dim );
+    }
 
-        if( !domainUpperBounds ){
-            
-            _domainUpperBounds = floatVector( dim );
-            _domainLowerBounds = floatVector( dim );
+    void KDNode::getPointsWithinRadiusOfOrigins( const floatVector &origins, const floatType &radius,
+                                                 uIntVector &offsets, uIntVector &indices,
+                                                 const uIntType &threadCount ){
+        /*!
+         * Find all of the points within a given radius of each of a collection of origins. The
+         * results are stored in compressed row format where the points near origin i are
+         * indices[ offsets[ i ] ], ..., indices[ offsets[ i + 1 ] - 1 ]. The results do not depend
+         * on the number of threads.
+         *
+         * :param const floatVector &origins: The origins stored as [ x1, y1, z1, x2, y2, z2, ... ]
+         * :param const floatType &radius: The radius to use as the bound
+         * :param uIntVector &offsets: The offsets of each origin's points in the indices vector
+         * :param uIntVector &indices: The indices of the points within the radius of the origins
+         * :param const uIntType &threadCount: The number of threads to use for the queries
+         */
+
+        uIntType nOrigins = ( _dim > 0 ) ? origins.size( ) / _dim : 0;
+
+        offsets = uIntVector( nOrigins + 1, 0 );
+        indices.clear( );
+
+        floatType radiusSquared = radius * radius;
+
+        uIntType nThreads = std::max( std::min( threadCount, nOrigins ), ( uIntType )1 );
+
+        if ( nThreads == 1 ){
 
-            for ( uIntType i = 0; i < dim; i++ ){
+            uIntVector stack;
 
-                _domainUpperBounds[ i ] = getMaximumValueDimension( i );
-                _domainLowerBounds[ i ] = getMinimumValueDimension( i );
+            for ( uIntType i = 0; i < nOrigins; i++ ){
+
+                getPointsWithinRadiusOfOrigin( origins.data( ) + _dim * i, radiusSquared, indices, stack );
+
+                offsets[ i + 1 ] = indices.size( );
 
             }
 
-            //Reassign the pointers
-            domainUpperBounds = &_domainUpperBounds;
-            domainLowerBounds = &_domainLowerBounds;
+            return;
 
         }
 
-        //Check if the current point is within the range
-        floatVector deltaVec = median - origin;
-        floatType deltaRadiusSquared = vectorTools::dot( deltaVec, deltaVec );
+        //Each thread queries a contiguous block of the origins
+        std::vector< uIntVector > threadIndices( nThreads );
+        uIntType blockSize = ( nOrigins + nThreads - 1 ) / nThreads;
+
+        auto queryBlock = [ & ]( const uIntType thread ){
+
+            uIntVector stack;
+
+            uIntType begin = std::min( thread * blockSize, nOrigins );
+            uIntType end   = std::min( begin + blockSize, nOrigins );
 
-        bool medianInside = deltaRadiusSquared <= ( radius * radius );
+            for ( uIntType i = begin; i < end; i++ ){
 
-        if ( medianInside ){
+                getPointsWithinRadiusOfOrigin( origins.data( ) + _dim * i, radiusSquared, threadIndices[ thread ], stack );
 
-            indices.push_back( _index );
+                //Store the number of points found for the origin
+                offsets[ i + 1 ] = threadIndices[ thread ].size( );
+
+            }
+
+        };
+
+        std::vector< std::thread > threads;
+        threads.reserve( nThreads - 1 );
+
+        for ( uIntType thread = 1; thread < nThreads; thread++ ){
+
+            threads.push_back( std::thread( queryBlock, thread ) );
 
         }
 
-        //Check the left child exists and is within range for the current axis
-        if ( ( left_child ) &&
-             ( ( std::fabs( median[ _axis ] - origin[ _axis ] ) <= radius ) ||
-               ( std::fabs( ( *domainLowerBounds )[ _axis ] - origin[ _axis ] ) <= radius ) ||
-               ( ( median[ _axis ] >= origin[ _axis ] ) && ( origin[ _axis ] >= ( *domainLowerBounds )[ _axis ] ) )
-             )
-           ){
+        queryBlock( 0 );
+
+        for ( auto thread = threads.begin( ); thread != threads.end( ); thread++ ){
+
+            thread->join( );
+
+        }
+
+        //Assemble the blocks in order
+        uIntType total = 0;
+
+        for ( uIntType thread = 0; thread < nThreads; thread++ ){
 
-             floatVector newDomainUpperBounds = *domainUpperBounds;
-             newDomainUpperBounds[ _axis ] = median[ _axis ];
+            uIntType begin = std::min( thread * blockSize, nOrigins );
+            uIntType end   = std::min( begin + blockSize, nOrigins );
 
-             left_child->getPointsWithinRadiusOfOrigin( origin, radius, indices,
-                                                        &newDomainUpperBounds, domainLowerBounds );
+            for ( uIntType i = begin; i < end; i++ ){
+
+                offsets[ i + 1 ] += total;
+
+            }
+
+            total += threadIndices[ thread ].size( );
 
         }
 
-        //Check the right child exists and is within range
-        if ( ( right_child ) &&
-             ( ( std::fabs( median[ _axis ] - origin[ _axis ] ) <= radius ) ||
-               ( std::fabs( ( *domainUpperBounds )[ _axis ] - origin[ _axis ] ) <= radius ) ||
-               ( ( ( *domainUpperBounds )[ _axis ] >= origin[ _axis ] ) && ( origin[ _axis ] >= median[ _axis ] ) ) 
-             )
-           ){
+        indices.reserve( total );
 
-             floatVector newDomainLowerBounds = *domainLowerBounds;
-             newDomainLowerBounds[ _axis ] = median[ _axis ];
+        for ( auto block = threadIndices.begin( ); block != threadIndices.end( ); block++ ){
 
-             right_child->getPointsWithinRadiusOfOrigin( origin, radius, indices,
-                                                         domainUpperBounds, &newDomainLowerBounds );
+            indices.insert( indices.end( ), block->begin( ), block->end( ) );
 
         }
 
     }
 
-    floatType KDNode::getMinimumValueDimension( const uIntType &d ){
+    void KDNode::getPointsWithinRadiusOfOrigin( const floatType *origin, const floatType &radiusSquared,
+                                                uIntVector &indices, uIntVector &stack ){
         /*!
-         * Get the minimum value of a given dimension in the tree
+         * Find all of the points within a given radius of the origin by traversing the tree
+         * with an explicit stack. The indices are appended to the output.
          *
-         * :param const uIntType &d: The dimension ( starting at zero ) of each point to search
+         * :param const floatType *origin: The first value of the origin
+         * :param const floatType &radiusSquared: The square of the radius to use as the bound
+         * :param uIntVector &indices: The indices contained within the radius
+         * :param uIntVector &stack: Workspace for the nodes remaining to be searched
          */
 
-        floatType currentValue = ( *_points )[ _index + d ];
+        if ( _nodes.size( ) == 0 ){
 
-        if ( _axis == d ){
+            return;
 
-            if ( left_child ){
+        }
 
-                return std::fmin( left_child->getMinimumValueDimension( d ),
-                                  currentValue );
+        stack.clear( );
+        stack.push_back( 0 );
 
-            }
-            else{
+        while ( stack.size( ) > 0 ){
 
-                return currentValue;
+            const treeNode &current = _nodes[ stack.back( ) ];
+            stack.pop_back( );
+
+            if ( current.liveCount == 0 ){
+
+                continue;
 
             }
 
-        }
-        else{
+            if ( current.left < 0 ){
 
-            if ( ( left_child ) && ( !right_child ) ){
+                for ( uIntType p = current.begin; p < current.end; p++ ){
 
-                return std::fmin( left_child->getMinimumValueDimension( d ),
-                                  currentValue );
+                    if ( ( !_deleted[ p ] ) && ( squaredDistance( origin, _permutation[ p ] ) <= radiusSquared ) ){
 
-            }
-            else if ( ( !left_child ) && ( right_child ) ){
+                        indices.push_back( _permutation[ p ] );
+
+                    }
+
+                }
 
-                return std::fmin( right_child->getMinimumValueDimension( d ),
-                                  currentValue );
+                continue;
 
             }
-            else if ( ( left_child ) && ( right_child ) ){
 
-                return std::fmin( std::fmin( left_child->getMinimumValueDimension( d ),
-                                             right_child->getMinimumValueDimension( d ) ),
-                                  currentValue );
+            floatType axisDelta = origin[ current.axis ] - current.split;
 
+            //Push the right child first so the left child is searched first
+            if ( ( axisDelta >= 0 ) || ( axisDelta * axisDelta <= radiusSquared ) ){
+
+                stack.push_back( current.right );
 
             }
-            else{
 
-                return currentValue;
+            if ( ( axisDelta <= 0 ) || ( axisDelta * axisDelta <= radiusSquared ) ){
+
+                stack.push_back( current.left );
 
             }
 
@@ -398,96 +510,293 @@ namespace volumeReconstruction{
 
     }
 
-    floatType KDNode::getMaximumValueDimension( const uIntType &d ){
+    void KDNode::getKNearestNeighbors( const floatVector &origin, const uIntType &k,
+                                       uIntVector &indices, floatVector &distances ){
         /*!
-         * Get the maximum value of a given dimension in the tree
+         * Find the k points in the tree closest to the origin. The results are
+         * sorted by increasing distance. If the tree contains fewer than k points
+         * all of the points are returned.
          *
-         * :param const uIntType &d: The dimension ( starting at zero ) of each point to search
+         * :param const floatVector &origin: The origin to use as the reference point
+         * :param const uIntType &k: The number of neighbors to find
+         * :param uIntVector &indices: The indices of the nearest points
+         * :param floatVector &distances: The distances from the origin to the nearest points
          */
 
+        indices.clear( );
+        distances.clear( );
 
-        floatType currentValue = ( *_points )[ _index + d ];
+        if ( ( k == 0 ) || ( _nodes.size( ) == 0 ) ){
 
-        if ( _axis == d ){
+            return;
 
-            if ( right_child ){
+        }
 
-                return std::fmax( right_child->getMaximumValueDimension( d ),
-                                  currentValue );
+        //The bounded max-heap of the closest points found so far
+        std::priority_queue< neighbor > neighbors;
 
-            }
-            else{
+        searchKNearestNeighbors( 0, origin, k, neighbors );
 
-                return currentValue;
+        //Unload the heap from the farthest to the closest point
+        indices.resize( neighbors.size( ) );
+        distances.resize( neighbors.size( ) );
 
-            }
+        for ( uIntType i = neighbors.size( ); i > 0; i-- ){
+
+            distances[ i - 1 ] = std::sqrt( neighbors.top( ).first );
+            indices[ i - 1 ] = neighbors.top( ).second;
+            neighbors.pop( );
 
         }
-        else{
 
-            if ( ( left_child ) && ( !right_child ) ){
+        return;
+
+    }
 
-                return std::fmax( left_child->getMaximumValueDimension( d ),
-                                  currentValue );
+    void KDNode::searchKNearestNeighbors( const uIntType &node, const floatVector &origin, const uIntType &k,
+                                          std::priority_queue< neighbor > &neighbors ){
+        /*!
+         * Recursively search the tree for the k points closest to the origin
+         *
+         * :param const uIntType &node: The node to search
+         * :param const floatVector &origin: The origin to use as the reference point
+         * :param const uIntType &k: The number of neighbors to find
+         * :param std::priority_queue< neighbor > &neighbors: The max-heap of the squared
+         *     distances and indices of the closest points found so far
+         */
 
-            }
-            else if ( ( !left_child ) && ( right_child ) ){
+        const treeNode &current = _nodes[ node ];
 
-                return std::fmax( right_child->getMaximumValueDimension( d ),
-                                  currentValue );
+        //Skip subtrees where every point has been removed
+        if ( current.liveCount == 0 ){
 
-            }
-            else if ( ( left_child ) && ( right_child ) ){
+            return;
 
-                return std::fmax( std::fmax( left_child->getMaximumValueDimension( d ),
-                                             right_child->getMaximumValueDimension( d ) ),
-                                  currentValue );
+        }
 
-            }
-            else{
+        if ( current.left < 0 ){
+
+            for ( uIntType p = current.begin; p < current.end; p++ ){
+
+                if ( _deleted[ p ] ){
 
-                return currentValue;
+                    continue;
+
+                }
+
+                floatType distanceSquared = squaredDistance( origin.data( ), _permutation[ p ] );
+
+                if ( neighbors.size( ) < k ){
+
+                    neighbors.push( neighbor( distanceSquared, _permutation[ p ] ) );
+
+                }
+                else if ( distanceSquared < neighbors.top( ).first ){
+
+                    neighbors.pop( );
+                    neighbors.push( neighbor( distanceSquared, _permutation[ p ] ) );
+
+                }
 
             }
 
+            return;
+
+        }
+
+        //Search the side of the splitting plane containing the origin first
+        floatType axisDelta = origin[ current.axis ] - current.split;
+
+        intType nearChild = current.left;
+        intType farChild  = current.right;
+
+        if ( axisDelta > 0 ){
+
+            nearChild = current.right;
+            farChild  = current.left;
+
+        }
+
+        searchKNearestNeighbors( nearChild, origin, k, neighbors );
+
+        //Only search the far side if it could contain a closer point
+        if ( ( neighbors.size( ) < k ) || ( axisDelta * axisDelta <= neighbors.top( ).first ) ){
+
+            searchKNearestNeighbors( farChild, origin, k, neighbors );
+
         }
 
+        return;
+
     }
 
-    void KDNode::printData( const uIntType &dim ){
+    void KDNode::removePointsWithinRadiusOfOrigin( const floatVector &origin, const floatType &radius,
+                                                   uIntVector &indices ){
         /*!
-         * Print the data associated with this node to the terminal
+         * Remove all of the points within a given radius of the origin from the tree. The points
+         * are marked as deleted rather than restructuring the tree so subsequent queries ignore
+         * them and subtrees with no remaining points are skipped entirely.
+         *
+         * :param const floatVector &origin: The origin to use as the reference point
+         * :param const floatType &radius: The radius to use as the bound
+         * :param uIntVector &indices: The indices of the removed points. The newly removed
+         *     points are appended.
          */
 
-        std::cout << "NODE: " << _index << "\n";
-        std::cout << "  depth: " << _depth << "\n";
-        std::cout << "  value: "; vectorTools::print( floatVector( _points->begin( ) + _index,
-                                                                   _points->begin( ) + _index + dim ) );
-        std::cout << "  left: ";
-        if ( left_child ){
-            std::cout << *left_child->getIndex( ) << "\n";
+        if ( _nodes.size( ) == 0 ){
+
+            return;
+
         }
-        else{
-            std::cout << "NULL\n";
+
+        _liveCount -= removePointsWithinRadiusOfOrigin( 0, origin, radius * radius, indices );
+
+        return;
+
+    }
+
+    uIntType KDNode::removePointsWithinRadiusOfOrigin( const uIntType &node, const floatVector &origin,
+                                                       const floatType &radiusSquared, uIntVector &indices ){
+        /*!
+         * Remove all of the points owned by a node within a given radius of the origin
+         *
+         * :param const uIntType &node: The node to search
+         * :param const floatVector &origin: The origin to use as the reference point
+         * :param const floatType &radiusSquared: The square of the radius to use as the bound
+         * :param uIntVector &indices: The indices of the removed points
+         *
+         * returns the number of points removed
+         */
+
+        if ( _nodes[ node ].liveCount == 0 ){
+
+            return 0;
+
         }
-        std::cout << "  right: ";
-        if ( right_child ){
-            std::cout << *right_child->getIndex( ) << "\n";
+
+        uIntType removed = 0;
+
+        if ( _nodes[ node ].left < 0 ){
+
+            for ( uIntType p = _nodes[ node ].begin; p < _nodes[ node ].end; p++ ){
+
+                if ( ( !_deleted[ p ] ) && ( squaredDistance( origin.data( ), _permutation[ p ] ) <= radiusSquared ) ){
+
+                    _deleted[ p ] = true;
+                    indices.push_back( _permutation[ p ] );
+                    removed++;
+
+                }
+
+            }
+
         }
         else{
-            std::cout << "NULL\n";
-        }
-        std::cout << "\n";
 
-        if ( left_child ){
-            left_child->printData( dim );
+            floatType axisDelta = origin[ _nodes[ node ].axis ] - _nodes[ node ].split;
+
+            if ( ( axisDelta <= 0 ) || ( axisDelta * axisDelta <= radiusSquared ) ){
+
+                removed += removePointsWithinRadiusOfOrigin( _nodes[ node ].left, origin, radiusSquared, indices );
+
+            }
+
+            if ( ( axisDelta >= 0 ) || ( axisDelta * axisDelta <= radiusSquared ) ){
+
+                removed += removePointsWithinRadiusOfOrigin( _nodes[ node ].right, origin, radiusSquared, indices );
+
+            }
+
         }
 
-        if ( right_child ){
-            right_child->printData( dim );
+        _nodes[ node ].liveCount -= removed;
+
+        return removed;
+
+    }
+
+    floatType KDNode::getMinimumValueDimension( const uIntType &d ){
+        /*!
+         * Get the minimum value of a given dimension in the tree
+         *
+         * :param const uIntType &d: The dimension ( starting at zero ) of each point to search
+         */
+
+        return _lowerBounds[ d ];
+
+    }
+
+    floatType KDNode::getMaximumValueDimension( const uIntType &d ){
+        /*!
+         * Get the maximum value of a given dimension in the tree
+         *
+         * :param const uIntType &d: The dimension ( starting at zero ) of each point to search
+         */
+
+        return _upperBounds[ d ];
+
+    }
+
+    void KDNode::printData( const uIntType & /*dim*/ ){
+        /*!
+         * Print the data associated with the tree to the terminal
+         *
+         * :param const uIntType &dim: The dimension of the points. Retained for compatibility. The
+         *     dimension of the tree is used.
+         */
+
+        if ( _nodes.size( ) == 0 ){
+
+            return;
+
         }
+
+        printData( 0, _depth );
+
     }
 
+    void KDNode::printData( const uIntType &node, const uIntType &depth ){
+        /*!
+         * Print the data associated with a node of the tree to the terminal
+         *
+         * :param const uIntType &node: The node to print
+         * :param const uIntType &depth: The depth of the node
+         */
+
+        const treeNode &current = _nodes[ node ];
+
+        std::cout << "NODE: " << node << "\n";
+        std::cout << "  depth: " << depth << "\n";
+        std::cout << "  live points: " << current.liveCount << "\n";
+
+        if ( current.left < 0 ){
+
+            std::cout << "  points:\n";
+
+            for ( uIntType p = current.begin; p < current.end; p++ ){
+
+                std::cout << "    " << _permutation[ p ] << ": ";
+                vectorTools::print( floatVector( _points->begin( ) + _permutation[ p ],
+                                                 _points->begin( ) + _permutation[ p ] + _dim ) );
+
+            }
+
+            std::cout << "\n";
+
+            return;
+
+        }
+
+        std::cout << "  axis: " << current.axis << "\n";
+        std::cout << "  split: " << current.split << "\n";
+        std::cout << "  left: " << current.left << "\n";
+        std::cout << "  right: " << current.right << "\n";
+        std::cout << "\n";
+
+        printData( current.left, depth + 1 );
+        printData( current.right, depth + 1 );
+
+    }
 
     volumeReconstructionBase::volumeReconstructionBase( ){
         /*!
@@ -639,44 +948,25 @@ namespace volumeReconstruction{
          * of the closest n points for each incoming point
          */
 
-        floatVector distances( 0, 0 );
+        floatVector distances;
+        distances.reserve( _nPoints * _nNeighborhoodPoints );
+
+        uIntVector closestIndices;
+        floatVector closestDistances;
 
         for ( uIntType i = 0; i < _dim * _nPoints; i += _dim ){
 
-            // Compute the n closest distances from the point
+            // Compute the n closest distances from the point. The closest point is the point itself.
             floatVector x0( _points->begin( ) + i, _points->begin( ) + i + _dim );
 
-            floatVector closestDistances( _nNeighborhoodPoints + 1, 0 );
-
-            floatVector xi( _dim, 0 );
-
-            for ( uIntType j = 0; j < _dim * ( _nNeighborhoodPoints + 1 ); j += _dim ){
-
-                xi = floatVector( _points->begin( ) + j, _points->begin( ) + j + _dim );
-
-                closestDistances[ j / _dim ] = vectorTools::l2norm( xi - x0 );
-
-            }
-
-            std::sort( closestDistances.begin( ), closestDistances.end( ) );
-
-            for ( uIntType j = _dim * ( _nNeighborhoodPoints + 1 ); j < _dim * _nPoints; j += _dim ){
-
-                xi = floatVector( _points->begin( ) + j, _points->begin( ) + j + _dim );
-
-                floatType d = vectorTools::l2norm( xi - x0 );
-
-                if ( d < closestDistances[ _nNeighborhoodPoints ] ){
+            _pointTree.getKNearestNeighbors( x0, _nNeighborhoodPoints + 1, closestIndices, closestDistances );
 
-                    closestDistances[ _nNeighborhoodPoints ] = d;
-                    std::sort( closestDistances.begin( ), closestDistances.end( ) );
+            if ( closestDistances.size( ) > 1 ){
 
-                }
+                distances.insert( distances.end( ), closestDistances.begin( ) + 1, closestDistances.end( ) );
 
             }
 
-            distances.insert( distances.end(), closestDistances.begin() + 1, closestDistances.end( ) );
-
         }
 
         _medianNeighborhoodDistance = vectorTools::median( distances );
@@ -1599,6 +1889,41 @@ namespace volumeReconstruction{
 
         }
 
+        if ( _config[ "interpolation" ][ "query_thread_count" ] ){
+
+            try{
+
+                int threadCount = _config[ "interpolation" ][ "query_thread_count" ].as< int >( );
+
+                if ( threadCount < 0 ){
+
+                    return new errorNode( "processConfigFile", "'query_thread_count' must be zero or a positive integer" );
+
+                }
+
+                _queryThreadCount = ( uIntType )threadCount;
+
+            }
+            catch( ... ){
+
+                return new errorNode( "processConfigFile", "'query_thread_count' must be an integer" );
+
+            }
+
+        }
+        else{
+
+            _config[ "interpolation" ][ "query_thread_count" ] = _queryThreadCount;
+
+        }
+
+        if ( _queryThreadCount == 0 ){
+
+            //Use all of the available hardware threads
+            _queryThreadCount = std::max( std::thread::hardware_concurrency( ), ( unsigned int )1 );
+
+        }
+
         if ( _config[ "write_xdmf_output" ] ){
             
             _writeOutput = true;
@@ -1625,6 +1950,9 @@ namespace volumeReconstruction{
          * Evaluate the dual contouring volume reconstruction
          */
 
+        //The background grid interpolation operator depends on the geometry
+        _gridInterpolationOperatorFormed = false;
+
         //Preserve the base class evaluate
         errorOut error = volumeReconstructionBase::evaluate( );
 
@@ -1730,79 +2058,178 @@ namespace volumeReconstruction{
         _length_scale = *getMedianNeighborhoodDistance( ) / ( 2 * std::sqrt( -std::log( 1. / _nNeighborhoodPoints ) ) );
         _critical_radius = std::sqrt( -std::log( 1e-3 ) ) * 2 * _length_scale;
 
-        //Loop over the elements
+        //Project the function one plane of constant i at a time. Each node of the grid belongs to exactly
+        //one plane and the contributions to a node are summed in the order returned by the KD tree so the
+        //result is identical to the serial projection regardless of the number of threads.
+        uIntType ngx = _gridLocations[ 0 ].size( );
+        uIntType nPlanes = ngx > 2 ? ngx - 2 : 0;
+
+        uIntType nThreads = std::min( _queryThreadCount, nPlanes );
+
+        if ( nThreads <= 1 ){
+
+            errorOut error = projectImplicitFunctionToBackgroundGridPlanes( 1, ngx - 1, _queryThreadCount );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the projection of the implicit function to the grid" );
+                result->addNext( error );
+                return result;
+
+            }
+
+        }
+        else{
+
+            //Each thread works on a contiguous block of planes with its own scratch buffers
+            std::vector< errorOut > threadErrors( nThreads, NULL );
+            std::vector< std::thread > threads;
+            threads.reserve( nThreads );
+
+            uIntType blockSize = nPlanes / nThreads;
+            uIntType remainder = nPlanes % nThreads;
+            uIntType iBegin = 1;
+
+            for ( uIntType t = 0; t < nThreads; t++ ){
+
+                uIntType iEnd = iBegin + blockSize + ( t < remainder ? 1 : 0 );
+
+                threads.push_back( std::thread( [ this, &threadErrors, t, iBegin, iEnd ]( ){
+
+                    threadErrors[ t ] = projectImplicitFunctionToBackgroundGridPlanes( iBegin, iEnd, 1 );
+
+                } ) );
+
+                iBegin = iEnd;
+
+            }
+
+            for ( auto thread = threads.begin( ); thread != threads.end( ); thread++ ){
+
+                thread->join( );
+
+            }
+
+            for ( auto error = threadErrors.begin( ); error != threadErrors.end( ); error++ ){
+
+                if ( *error ){
+
+                    errorOut result = new errorNode( __func__, "Error in the projection of the implicit function to the grid" );
+                    result->addNext( *error );
+                    return result;
+
+                }
+
+            }
+
+        }
+
+        _implicitFunctionValues -= _isosurfaceCutoff;
+
+        return NULL;
+
+    }
+
+    errorOut dualContouring::projectImplicitFunctionToBackgroundGridPlanes( const uIntType &iBegin, const uIntType &iEnd,
+                                                                            const uIntType &queryThreadCount ){
+        /*!
+         * Project the implicit function to the nodes of the background grid which lie on the planes of constant
+         * i in the range [ iBegin, iEnd ). The values of the nodes on the planes are over-written.
+         *
+         * All of the scratch storage is local so that several ranges of planes may be projected at the same time.
+         *
+         * :param const uIntType &iBegin: The first plane to project to
+         * :param const uIntType &iEnd: The plane after the last plane to project to
+         * :param const uIntType &queryThreadCount: The number of threads to use in the KD tree queries
+         */
 
         errorOut error;
-        uIntVector elementIndices;
-        floatVector elementNodalContributions;
-        uIntVector globalNodeIds;
-        uIntVector pointCounts;
 
-        uIntType ngx = _gridLocations[ 0 ].size( );
         uIntType ngy = _gridLocations[ 1 ].size( );
         uIntType ngz = _gridLocations[ 2 ].size( );
         uIntType nodeID;
+        uIntVector pointOffsets;
         uIntVector pointIndices;
+        floatVector rbfDifferences, rbfValues;
 
         floatVector node_xi( _dim, 0 );
         floatVector node_x( _dim, 0 );
 
-        for ( uIntType i = 1; i < ngx - 1; i++ ){
+        floatVector planeNodes;
+        planeNodes.reserve( _dim * ( ngy - 2 ) * ( ngz - 2 ) );
+
+        for ( uIntType i = iBegin; i < iEnd; i++ ){
+
+            planeNodes.clear( );
 
             for ( uIntType j = 1; j < ngy - 1; j++ ){
 
                 for ( uIntType k = 1; k < ngz - 1; k++ ){
 
-                    // Get the node ID
-                    nodeID = ngy * ngz * i + ngz * j + k;
-
                     if ( _localDomain ){
 
-                        node_xi = { _gridLocations[ 0 ][ i ], _gridLocations[ 1 ][ j ], _gridLocations[ 2 ][ k ] };
+                        node_xi = { _gridLocations[ 0 ][ i ], _gridLocations[ 1 ][ j ], _gridLocations[ 2 ][ k ] };
+
+                        _localDomain->interpolate( _localDomain->nodes, node_xi, node_x );
+
+                    }
+                    else{
+
+                        node_x = { _gridLocations[ 0 ][ i ], _gridLocations[ 1 ][ j ], _gridLocations[ 2 ][ k ] };
+
+                    }
+
+                    planeNodes.insert( planeNodes.end( ), node_x.begin( ), node_x.end( ) );
+
+                }
+
+            }
 
-                        _localDomain->interpolate( _localDomain->nodes, node_xi, node_x );
+            // Find the points within the critical radius of the nodes
+            _pointTree.getPointsWithinRadiusOfOrigins( planeNodes, _critical_radius, pointOffsets, pointIndices, queryThreadCount );
 
-                    }
-                    else{
+            uIntType n = 0;
 
-                        node_x = { _gridLocations[ 0 ][ i ], _gridLocations[ 1 ][ j ], _gridLocations[ 2 ][ k ] };
+            for ( uIntType j = 1; j < ngy - 1; j++ ){
 
-                    }
+                for ( uIntType k = 1; k < ngz - 1; k++ ){
 
-                    // Find the points within the critical radius
-                    pointIndices.clear( );
-                    _pointTree.getPointsWithinRadiusOfOrigin( node_x, _critical_radius, pointIndices );
+                    // Get the node ID
+                    nodeID = ngy * ngz * i + ngz * j + k;
 
-                    for ( auto pI = pointIndices.begin( ); pI != pointIndices.end( ); pI++ ){
+                    node_x = floatVector( planeNodes.begin( ) + _dim * n, planeNodes.begin( ) + _dim * ( n + 1 ) );
 
-                        floatType value;
+                    error = rbf( node_x, pointIndices.data( ) + pointOffsets[ n ], pointOffsets[ n + 1 ] - pointOffsets[ n ],
+                                 _length_scale, rbfDifferences, rbfValues );
 
-                        floatVector xi( getPoints( )->begin( ) + *pI, getPoints( )->begin( ) + *pI + _dim );
+                    if ( error ){
 
-                        error = rbf( node_x, xi, _length_scale, value );
+                        errorOut result = new errorNode( __func__, "Error in the computation of the radial basis function" );
 
-                        if ( error ){
+                        result->addNext( error );
 
-                            errorOut result = new errorNode( __func__, "Error in the computation of the radial basis function" );
+                        return result;
 
-                            result->addNext( error );
+                    }
 
-                            return result;
+                    floatType value = 0;
 
-                        }
+                    for ( auto v = rbfValues.begin( ); v != rbfValues.end( ); v++ ){
 
-                        _implicitFunctionValues[ nodeID ] += value;
+                        value += *v;
 
                     }
 
+                    _implicitFunctionValues[ nodeID ] = value;
+
+                    n++;
+
                 }
 
             }
 
         }
 
-        _implicitFunctionValues -= _isosurfaceCutoff;
-
         return NULL;
 
     }
@@ -1958,14 +2385,6 @@ namespace volumeReconstruction{
          * :param floatVector &grad: The gradient of the radial basis function w.r.t. x
          */
 
-        floatType r = vectorTools::l2norm( x - x0 );
-
-        if ( r < _absoluteTolerance ){
-
-            grad = floatVector( x.size( ), 0 );
-
-        }
-
         floatType val;
 
         errorOut error = rbf( x, x0, ls, val );
@@ -1980,7 +2399,8 @@ namespace volumeReconstruction{
 
         }
 
-        grad = -( r / ( 2 * std::pow( ls, 2 ) ) ) * val * ( x - x0 ) / r;
+        //The r terms cancel so the gradient is also defined when x coincides with x0
+        grad = -val * ( x - x0 ) / ( 2 * std::pow( ls, 2 ) );
 
         if ( _boundingSurfaces ){
 
@@ -2015,6 +2435,211 @@ namespace volumeReconstruction{
 
     }
 
+    bool dualContouring::isOutsideBoundingPlanes( const floatVector &x, floatVector *outwardNormalSum ){
+        /*!
+         * Determine if a point is on or outside of any of the bounding planes
+         *
+         * :param const floatVector &x: The point
+         * :param floatVector *outwardNormalSum: The sum of the normals of the planes the point is outside of.
+         *     Only computed if provided.
+         */
+
+        if ( outwardNormalSum ){
+
+            *outwardNormalSum = floatVector( x.size( ), 0 );
+
+        }
+
+        if ( !_boundingSurfaces ){
+
+            return false;
+
+        }
+
+        bool isOutside = false;
+
+        for ( auto plane = _boundingPlanes.begin( ); plane != _boundingPlanes.end( ); plane++ ){
+
+            floatType d = vectorTools::dot( plane->second, x - plane->first );
+
+            if ( d >= 0 ){
+
+                isOutside = true;
+
+                if ( !outwardNormalSum ){
+
+                    return true;
+
+                }
+
+                *outwardNormalSum += plane->second;
+
+            }
+
+        }
+
+        return isOutside;
+
+    }
+
+    void dualContouring::computeRBFDifferences( const floatVector &x, const uIntType *pointIndices, const uIntType &nPoints,
+                                                const floatType &ls, floatVector &differences, floatVector &values ){
+        /*!
+         * Compute the differences between the point and a block of the data points and the values of
+         * the radial basis functions. The differences are stored by component i.e.
+         * [ dx_1, dx_2, ..., dy_1, dy_2, ..., dz_1, ... ] so that each of the loops runs over contiguous
+         * memory without any temporary vectors.
+         *
+         * :param const floatVector &x: The point at which to compute the radial basis functions
+         * :param const uIntType *pointIndices: The indices of the first values of the data points
+         * :param const uIntType &nPoints: The number of data points
+         * :param const floatType &ls: The length scale
+         * :param floatVector &differences: The differences x - x0 for each data point
+         * :param floatVector &values: The values of the radial basis functions
+         */
+
+        differences.resize( _dim * nPoints );
+        values.assign( nPoints, 0 );
+
+        const floatType *points = _points->data( );
+
+        for ( uIntType d = 0; d < _dim; d++ ){
+
+            const floatType xd = x[ d ];
+            floatType *delta = differences.data( ) + d * nPoints;
+
+            for ( uIntType i = 0; i < nPoints; i++ ){
+
+                delta[ i ] = xd - points[ pointIndices[ i ] + d ];
+
+            }
+
+            for ( uIntType i = 0; i < nPoints; i++ ){
+
+                values[ i ] += delta[ i ] * delta[ i ];
+
+            }
+
+        }
+
+        const floatType scale = -1. / ( 4 * ls * ls );
+
+        for ( uIntType i = 0; i < nPoints; i++ ){
+
+            values[ i ] = std::exp( scale * values[ i ] );
+
+        }
+
+    }
+
+    errorOut dualContouring::rbf( const floatVector &x, const uIntType *pointIndices, const uIntType &nPoints,
+                                  const floatType &ls, floatVector &differences, floatVector &values ){
+        /*!
+         * Compute the radial basis functions of a block of the data points at the provided point.
+         * The form of the functions are the same as the single point version.
+         *
+         * :param const floatVector &x: The point at which to compute the radial basis functions
+         * :param const uIntType *pointIndices: The indices of the first values of the data points
+         *     e.g. the output of the KD tree queries
+         * :param const uIntType &nPoints: The number of data points
+         * :param const floatType &ls: The lengthscale
+         * :param floatVector &differences: The workspace for the differences between x and the data points.
+         *     It is owned by the caller so that it can be re-used between calls.
+         * :param floatVector &values: The values of the radial basis functions
+         */
+
+        if ( x.size( ) != _dim ){
+
+            return new errorNode( __func__, "The size of x (" + std::to_string( x.size( ) ) + ") is not the dimension ( " + std::to_string( _dim ) + ")" );
+
+        }
+
+        if ( isOutsideBoundingPlanes( x ) ){
+
+            values.assign( nPoints, 0 );
+
+            return NULL;
+
+        }
+
+        computeRBFDifferences( x, pointIndices, nPoints, ls, differences, values );
+
+        return NULL;
+
+    }
+
+    errorOut dualContouring::grad_rbf( const floatVector &x, const uIntType *pointIndices, const uIntType &nPoints,
+                                       const floatType &ls, floatVector &differences, floatVector &values,
+                                       floatVector &gradients ){
+        /*!
+         * Compute the radial basis functions of a block of the data points and their gradients at the
+         * provided point. The form of the functions are the same as the single point version. Since
+         *
+         * dvdx = -( r / ( 2 * ls**2 ) ) * v * ( x - x0 ) / r = -v * ( x - x0 ) / ( 2 * ls**2 )
+         *
+         * the gradient is well defined when x coincides with a data point.
+         *
+         * :param const floatVector &x: The point at which to compute the radial basis functions
+         * :param const uIntType *pointIndices: The indices of the first values of the data points
+         *     e.g. the output of the KD tree queries
+         * :param const uIntType &nPoints: The number of data points
+         * :param const floatType &ls: The lengthscale
+         * :param floatVector &differences: The workspace for the differences between x and the data points.
+         *     It is owned by the caller so that it can be re-used between calls.
+         * :param floatVector &values: The values of the radial basis functions
+         * :param floatVector &gradients: The gradients of the radial basis functions w.r.t. x stored as
+         *     [ dv1dx, dv1dy, dv1dz, dv2dx, ... ]
+         */
+
+        if ( x.size( ) != _dim ){
+
+            return new errorNode( __func__, "The size of x (" + std::to_string( x.size( ) ) + ") is not the dimension ( " + std::to_string( _dim ) + ")" );
+
+        }
+
+        computeRBFDifferences( x, pointIndices, nPoints, ls, differences, values );
+
+        gradients.resize( _dim * nPoints );
+
+        floatVector outwardNormalSum;
+
+        if ( isOutsideBoundingPlanes( x, &outwardNormalSum ) ){
+
+            //Outside of the bounding planes the functions are zero and the gradients point inwards
+            values.assign( nPoints, 0 );
+
+            for ( uIntType i = 0; i < nPoints; i++ ){
+
+                for ( uIntType d = 0; d < _dim; d++ ){
+
+                    gradients[ _dim * i + d ] = -outwardNormalSum[ d ];
+
+                }
+
+            }
+
+            return NULL;
+
+        }
+
+        const floatType scale = -1. / ( 2 * ls * ls );
+
+        for ( uIntType d = 0; d < _dim; d++ ){
+
+            const floatType *delta = differences.data( ) + d * nPoints;
+
+            for ( uIntType i = 0; i < nPoints; i++ ){
+
+                gradients[ _dim * i + d ] = scale * values[ i ] * delta[ i ];
+
+            }
+
+        }
+
+        return NULL;
+
+    }
+
     errorOut dualContouring::processBackgroundGridElementImplicitFunction( const uIntVector &indices,
                                                                            floatVector &implicitFunctionNodalValues,
                                                                            uIntVector  &globalNodeIDs,
@@ -2271,6 +2896,7 @@ namespace volumeReconstruction{
         _boundaryEdges_z.reserve( 8 * _boundaryCells.size( ) ); //This is a worst case scenario
 
         floatMatrix points, normals, localNormals;
+        floatVector rbfDifferences, rbfValues, rbfGradients;
         floatType m, b;
 
         floatVector rootNode;
@@ -2475,35 +3101,37 @@ namespace volumeReconstruction{
 
                 floatVector gradient( _dim, 0 );
 
-                for ( auto sP = supportingPoints.begin( ); sP != supportingPoints.end( ); sP++ ){
+                if ( _localDomain ){
+
+                    error = grad_rbf( _lD_intersectionPoint, supportingPoints.data( ), supportingPoints.size( ), _length_scale,
+                                      rbfDifferences, rbfValues, rbfGradients );
 
-                    floatVector _grad;
+                }
+                else{
 
-                    floatVector pi( getPoints( )->begin( ) + *sP, getPoints( )->begin( ) + *sP + _dim );
+                    error = grad_rbf( intersectionPoint, supportingPoints.data( ), supportingPoints.size( ), _length_scale,
+                                      rbfDifferences, rbfValues, rbfGradients );
 
-                    if ( _localDomain ){
+                }
 
-                        error = grad_rbf( _lD_intersectionPoint, pi, _length_scale, _grad );
+                if ( error ){
 
-                    }
-                    else{
+                    errorOut result = new errorNode( __func__, "Error in computation of RBF gradient" );
 
-                        error = grad_rbf( intersectionPoint, pi, _length_scale, _grad );
+                    result->addNext( error );
 
-                    }
+                    return result;
 
-                    if ( error ){
+                }
 
-                        errorOut result = new errorNode( __func__, "Error in computation of RBF gradient" );
+                for ( uIntType sP = 0; sP < supportingPoints.size( ); sP++ ){
 
-                        result->addNext( error );
+                    for ( uIntType d = 0; d < _dim; d++ ){
 
-                        return result;
+                        gradient[ d ] += rbfGradients[ _dim * sP + d ];
 
                     }
 
-                    gradient += _grad;
-
                 }
 
                 normals.push_back( -gradient / vectorTools::l2norm( gradient ) );
@@ -3191,6 +3819,9 @@ namespace volumeReconstruction{
                                                                 ){ 
         /*!
          * Interpolate a function defined at the data points to the given element in the background grid.
+         *
+         * The interpolation operator is formed the first time a function is interpolated after the
+         * volume has been evaluated and is re-used for all subsequent functions.
          * 
          * :param const floatVector &functionValuesAtPoints: The value of the function at the data points
          * :param const uIntType &functionDim: The dimensionality of the function e.g. a function defined by four scalar values
@@ -3205,14 +3836,75 @@ namespace volumeReconstruction{
                                   "The points vector and the function values at points vector are not of compatible sizes" );
         }
 
-        bool usePointwiseProjection = false;
+        if ( !_gridInterpolationOperatorFormed ){
 
-        //Reserve memory for the function at the grid. This will be a worst case.
+            errorOut error = formGridInterpolationOperator( );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__,
+                                                 "Error in forming the background grid interpolation operator" );
+                result->addNext( error );
+                return result;
+
+            }
+
+        }
+
+        //Apply the interpolation operator to the function
         functionAtGrid.clear( );
-        functionAtGrid.reserve( 8 * functionDim * _internalCells.size( ) );
+        functionAtGrid.reserve( _gridInterpolationNodeIDs.size( ) );
+
+        for ( uIntType row = 0; row < _gridInterpolationNodeIDs.size( ); row++ ){
+
+            floatVector functionValue( functionDim, 0 );
+
+            for ( uIntType entry = _gridInterpolationRowPointers[ row ]; entry < _gridInterpolationRowPointers[ row + 1 ]; entry++ ){
+
+                uIntType offset = functionDim * _gridInterpolationPointIndices[ entry ];
+
+                for ( uIntType i = 0; i < functionDim; i++ ){
+
+                    functionValue[ i ] += _gridInterpolationWeights[ entry ] * functionValuesAtPoints[ offset + i ];
+
+                }
+
+            }
+
+            functionAtGrid.emplace( _gridInterpolationNodeIDs[ row ], functionValue );
+
+        }
+
+        return NULL;
+
+    }
+
+    errorOut dualContouring::formGridInterpolationOperator( ){
+        /*!
+         * Form the sparse operator which interpolates a function at the data points to the nodes of the
+         * internal cells of the background grid. Each row of the operator corresponds to a grid node and
+         * contains the normalized radial basis function weights of the points within the critical radius.
+         */
+
+        _gridInterpolationOperatorFormed = false;
 
-        std::unordered_map< uIntType, floatType > weights;
-        weights.reserve( 8 * _internalCells.size( ) );
+        _gridInterpolationNodeIDs.clear( );
+        _gridInterpolationRowPointers.clear( );
+        _gridInterpolationPointIndices.clear( );
+        _gridInterpolationWeights.clear( );
+
+        //The row of each grid node and the number of internal cells which contain it
+        std::unordered_map< uIntType, uIntType > nodeRows;
+        nodeRows.reserve( 8 * _internalCells.size( ) );
+
+        uIntVector nodeOccurrences;
+        nodeOccurrences.reserve( 8 * _internalCells.size( ) );
+
+        _gridInterpolationNodeIDs.reserve( 8 * _internalCells.size( ) );
+
+        //The locations of the grid nodes in the order of the rows
+        floatVector nodeLocations;
+        nodeLocations.reserve( 8 * _dim * _internalCells.size( ) );
 
         //Get the number of values in the different directions
         uIntType ngy = _gridLocations[ 1 ].size( );
@@ -3220,20 +3912,11 @@ namespace volumeReconstruction{
 
         uIntType i, j, k;
         uIntVector indices;
-        uIntVector internalPoints;
 
         std::unique_ptr< elib::Element > element;
 
-        floatVector pointPosition;
-        floatVector localCoordinates;
-        floatVector shapeFunctions;
-        floatVector functionValue;
-
         errorOut error;
 
-        floatVector upperBounds;
-        floatVector lowerBounds;
-
         for ( auto cell = _internalCells.begin( ); cell != _internalCells.end( ); cell++ ){
 
             //Get the bottom corner node IDs from the cell id
@@ -3255,22 +3938,23 @@ namespace volumeReconstruction{
 
             }
 
-            //Add the global node ids to the map if required
-            for ( auto nID = element->global_node_ids.begin( ); nID  != element->global_node_ids.end( ); nID++ ){
+            for ( auto node = element->nodes.begin( ); node != element->nodes.end( ); node++ ){
 
-                if ( weights.find( *nID ) == weights.end( ) ){
+                uIntType globalNodeID = element->global_node_ids[ node - element->nodes.begin( ) ];
 
-                    functionAtGrid.emplace( *nID, floatVector( functionDim, 0 ) );
-                    weights.emplace( *nID, 0 );
+                //The weights of nodes shared between cells only need to be computed once
+                auto nodeRow = nodeRows.find( globalNodeID );
 
-                }
+                if ( nodeRow != nodeRows.end( ) ){
 
-            }
+                    nodeOccurrences[ nodeRow->second ]++;
+                    continue;
 
-            for ( auto node = element->nodes.begin( ); node != element->nodes.end( ); node++ ){
+                }
 
-                uIntType   globalNodeID = element->global_node_ids[ node - element->nodes.begin( ) ];
-                uIntVector internalNodes;
+                nodeRows.emplace( globalNodeID, _gridInterpolationNodeIDs.size( ) );
+                nodeOccurrences.push_back( 1 );
+                _gridInterpolationNodeIDs.push_back( globalNodeID );
 
                 floatVector xn;
 
@@ -3285,40 +3969,78 @@ namespace volumeReconstruction{
 
                 }
 
-                _pointTree.getPointsWithinRadiusOfOrigin( xn, _critical_radius, internalNodes );
+                nodeLocations.insert( nodeLocations.end( ), xn.begin( ), xn.end( ) );
 
-                for ( auto iN = internalNodes.begin( ); iN != internalNodes.end( ); iN++ ){
+            }
 
-                    functionValue = floatVector( functionValuesAtPoints.begin( ) + ( *iN / _dim + 0 ) * functionDim,
-                                                 functionValuesAtPoints.begin( ) + ( *iN / _dim + 1 ) * functionDim );
+        }
 
-                    pointPosition = floatVector( _points->begin( ) + *iN,
-                                                 _points->begin( ) + *iN + _dim );
+        //Find the points within the critical radius of all of the nodes
+        _pointTree.getPointsWithinRadiusOfOrigins( nodeLocations, _critical_radius,
+                                                   _gridInterpolationRowPointers, _gridInterpolationPointIndices,
+                                                   _queryThreadCount );
 
-                    floatType value;
-                    rbf( xn, pointPosition, _length_scale, value );
+        _gridInterpolationWeights = floatVector( _gridInterpolationPointIndices.size( ), 0 );
 
-                    functionAtGrid[ globalNodeID ] += value * functionValue;
+        floatVector rbfDifferences, rbfValues;
 
-                    weights[ globalNodeID ] += value;
+        for ( uIntType row = 0; row < _gridInterpolationNodeIDs.size( ); row++ ){
 
-                }
+            floatVector xn( nodeLocations.begin( ) + _dim * row, nodeLocations.begin( ) + _dim * ( row + 1 ) );
+
+            uIntType rowBegin = _gridInterpolationRowPointers[ row ];
+            uIntType rowEnd   = _gridInterpolationRowPointers[ row + 1 ];
+
+            error = rbf( xn, _gridInterpolationPointIndices.data( ) + rowBegin, rowEnd - rowBegin, _length_scale, rbfDifferences, rbfValues );
+
+            if ( error ){
+
+                errorOut result = new errorNode( __func__, "Error in the computation of the radial basis function" );
+                result->addNext( error );
+                return result;
 
             }
 
+            std::copy( rbfValues.begin( ), rbfValues.end( ), _gridInterpolationWeights.begin( ) + rowBegin );
+
         }
 
-        //Normalize the weights by the shape function values
-        for ( auto node = functionAtGrid.begin( ); node != functionAtGrid.end( ); node++ ){
+        //Store the number of the point rather than the index of its first value
+        for ( auto pI = _gridInterpolationPointIndices.begin( ); pI != _gridInterpolationPointIndices.end( ); pI++ ){
+
+            *pI /= _dim;
+
+        }
+
+        //Normalize the weights. The weight of a node accumulates over every internal cell which contains it.
+        for ( uIntType row = 0; row < _gridInterpolationNodeIDs.size( ); row++ ){
+
+            floatType weight = 0;
+
+            for ( uIntType entry = _gridInterpolationRowPointers[ row ]; entry < _gridInterpolationRowPointers[ row + 1 ]; entry++ ){
+
+                weight += _gridInterpolationWeights[ entry ];
+
+            }
+
+            floatType scale = nodeOccurrences[ row ];
+
+            if ( nodeOccurrences[ row ] * weight > _absoluteTolerance ){
+
+                scale = 1. / weight;
 
-            if ( weights[ node->first ] > _absoluteTolerance ){
+            }
+
+            for ( uIntType entry = _gridInterpolationRowPointers[ row ]; entry < _gridInterpolationRowPointers[ row + 1 ]; entry++ ){
 
-                functionAtGrid[ node->first ] = node->second / weights[ node->first ];
+                _gridInterpolationWeights[ entry ] *= scale;
 
             }
 
         }
 
+        _gridInterpolationOperatorFormed = true;
+
         return NULL;
 
     }
@@ -3803,32 +4525,51 @@ namespace volumeReconstruction{
 
         }
 
+        // Find the points near each of the boundary points
+        floatVector subdomainPoints;
+        subdomainPoints.reserve( _dim * subdomainIndices.size( ) );
+
+        for ( auto index = subdomainIndices.begin( ); index != subdomainIndices.end( ); index++ ){
+
+            subdomainPoints.insert( subdomainPoints.end( ), _boundaryPoints.begin( ) + _dim * ( *index ),
+                                    _boundaryPoints.begin( ) + _dim * ( *index + 1 ) );
+
+        }
+
+        uIntVector nearbyPointOffsets;
+        uIntVector nearbyPoints;
+        floatVector rbfDifferences, rbfValues;
+        _pointTree.getPointsWithinRadiusOfOrigins( subdomainPoints, _critical_radius, nearbyPointOffsets, nearbyPoints,
+                                                   _queryThreadCount );
+
         for ( auto index = subdomainIndices.begin( ); index != subdomainIndices.end( ); index++ ){
 
             // Get the boundary point
             floatVector boundaryPoint( _boundaryPoints.begin( ) + _dim * ( *index ), _boundaryPoints.begin( ) + _dim * ( *index + 1 ) );
 
-            // Find the nearest points
-            uIntVector nearbyPoints;
-            _pointTree.getPointsWithinRadiusOfOrigin( boundaryPoint, _critical_radius, nearbyPoints );
-
             // Interpolate the function value to the point
 
             floatVector functionValueAtBoundaryPoint( valueSize, 0 );
 
             floatType totalValue = 0;
 
-            for ( auto nP = nearbyPoints.begin( ); nP != nearbyPoints.end( ); nP++ ){
+            uIntType row = index - subdomainIndices.begin( );
+            uIntType rowBegin = nearbyPointOffsets[ row ];
+            uIntType rowEnd   = nearbyPointOffsets[ row + 1 ];
+
+            rbf( boundaryPoint, nearbyPoints.data( ) + rowBegin, rowEnd - rowBegin, _length_scale, rbfDifferences, rbfValues );
 
-                floatVector pi( getPoints( )->begin( ) + *nP, getPoints( )->begin( ) + *nP + _dim );
+            for ( uIntType nP = rowBegin; nP < rowEnd; nP++ ){
 
-                floatVector fi( valuesAtPoints.begin( ) + valueSize * ( *nP ) / _dim, valuesAtPoints.begin( ) + valueSize * ( ( *nP ) / _dim + 1 ) );
+                floatType v = rbfValues[ nP - rowBegin ];
 
-                floatType v;
+                uIntType offset = valueSize * ( nearbyPoints[ nP ] / _dim );
 
-                rbf( boundaryPoint, pi, _length_scale, v );
+                for ( uIntType i = 0; i < valueSize; i++ ){
 
-                functionValueAtBoundaryPoint += v * fi;
+                    functionValueAtBoundaryPoint[ i ] += v * valuesAtPoints[ offset + i ];
+
+                }
 
                 totalValue += v;
 
@@ -3935,15 +4676,25 @@ namespace volumeReconstruction{
         =====================================================================*/
 
         uIntVector remainingNodes( _boundaryPoints.size( ) / _dim, 0 ); //Copy over the boundary cells
+        uIntVector remainingNodePositions( remainingNodes.size( ), 0 ); //The location of each node in remainingNodes
+
+        uIntVector ownedIndices( remainingNodes.size( ), 0 );
 
         for ( unsigned int i = 0; i < remainingNodes.size( ); i++ ){
 
             remainingNodes[ i ] = i;
+            remainingNodePositions[ i ] = i;
+            ownedIndices[ i ] = _dim * i;
 
         }
 
+        //Form a KD tree of the boundary points. Nodes are removed from the tree as they are claimed by a seed
+        KDNode remainingTree( &_boundaryPoints, ownedIndices, 0, _dim );
+
         //Begin seed node loop
         uIntVector seedNodeIDs;
+        uIntVector internalNodes;
+        uIntVector internalPositions;
         while ( remainingNodes.size( ) > 0 ){ 
 
             //Store a new subdomain seed node
@@ -3951,44 +4702,32 @@ namespace volumeReconstruction{
             floatVector currentSeedPoint( _boundaryPoints.begin( ) + _dim * seedNodeIDs.back( ),
                                           _boundaryPoints.begin( ) + _dim * ( seedNodeIDs.back( ) + 1 ) );
 
-            //Form a KD tree of the remaining nodes
-            floatVector remainingNodeCoords;
-            remainingNodeCoords.reserve( _dim * remainingNodes.size( ) );
-            uIntVector ownedIndices;
-            ownedIndices.reserve( remainingNodes.size( ) );
+            //Find and remove the nodes that are within the min-distance radius of the most recently added seed point
+            internalNodes.clear( );
+            remainingTree.removePointsWithinRadiusOfOrigin( currentSeedPoint, minDistance, internalNodes );
 
-            for ( auto rN = remainingNodes.begin( ); rN != remainingNodes.end( ); rN++ ){
-
-                for ( unsigned int i = 0; i < _dim; i++ ){
+            //TODO: This is just the Euclidean distance. If there are multiple surfaces this approximation will fail
+            //      This does help to winnow the cells down for a true Geometric distance to be computed using Dijkstra's
+            //      algorithm or similar to eliminate nodes that cannot be reached from the seed node
 
-                    remainingNodeCoords.push_back( _boundaryPoints[ _dim * ( *rN ) + i ] );
+            //Remove those nodes from the remaining nodes
+            internalPositions.clear( );
+            internalPositions.reserve( internalNodes.size( ) );
 
-                }
+            for ( auto iN = internalNodes.begin( ); iN != internalNodes.end( ); iN++ ){
 
-                ownedIndices.push_back( _dim * ( rN - remainingNodes.begin( ) ) );
+                internalPositions.push_back( remainingNodePositions[ *iN / _dim ] );
 
             }
 
-            //TODO: Change this to delete the nodes from the tree rather than rebuilding the tree
-            KDNode remainingTree( &remainingNodeCoords, ownedIndices, 0, _dim );
-
-            //Find the nodes that are within the min-distance radius of the most recently added seed point
-            uIntVector internalNodes;
-            remainingTree.getPointsWithinRadiusOfOrigin( currentSeedPoint, minDistance, internalNodes );
-
-            //TODO: This is just the Euclidean distance. If there are multiple surfaces this approximation will fail
-            //      This does help to winnow the cells down for a true Geometric distance to be computed using Dijkstra's
-            //      algorithm or similar to eliminate nodes that cannot be reached from the seed node
-
-            //Remove those nodes from the remaining node coords
-            internalNodes /= _dim;
-            std::sort( internalNodes.begin( ), internalNodes.end( ) );
+            std::sort( internalPositions.begin( ), internalPositions.end( ) );
 
-            for ( auto iN = internalNodes.rbegin( ); iN != internalNodes.rend( ); iN++ ){
+            for ( auto iP = internalPositions.rbegin( ); iP != internalPositions.rend( ); iP++ ){
 
-                if ( *iN < ( remainingNodes.size( ) - 1 ) ){
+                if ( *iP < ( remainingNodes.size( ) - 1 ) ){
                     //Swap the element to the end
-                    std::swap( remainingNodes[ *iN ], remainingNodes.back( ) );
+                    std::swap( remainingNodes[ *iP ], remainingNodes.back( ) );
+                    remainingNodePositions[ remainingNodes[ *iP ] ] = *iP;
                 }
                 remainingNodes.pop_back( );
 
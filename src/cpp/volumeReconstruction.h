@@ -12,6 +12,7 @@
 #include<error_tools.h>
 #include<yaml-cpp/yaml.h>
 #include<unordered_map>
+#include<queue>
 #include<element.h>
 
 namespace volumeReconstruction{
@@ -40,7 +41,10 @@ namespace volumeReconstruction{
     //KD tree definitions
     class KDNode{
         /*!
-         * Node which forms a simple KD tree
+         * A KD tree stored implicitly in flat arrays. The points are never copied. The tree
+         * holds a permutation of the point indices where every node of the tree owns a
+         * contiguous range of the permutation. Internal nodes split their range at the median
+         * of the axis with the largest extent and leaves hold buckets of up to bucketSize points.
          */
 
         public:
@@ -48,7 +52,7 @@ namespace volumeReconstruction{
             //Constructor
             KDNode( );
             KDNode( const floatVector *points, const uIntVector &ownedIndices,
-                    const uIntType &depth, const uIntType &dim );
+                    const uIntType &depth, const uIntType &dim, const uIntType &bucketSize = 8 );
 
             const uIntType* getIndex( );
 
@@ -66,16 +70,72 @@ namespace volumeReconstruction{
                                                 floatVector *domainUpperBounds = NULL,
                                                 floatVector *domainLowerBounds = NULL );
 
+            void getPointsWithinRadiusOfOrigins( const floatVector &origins, const floatType &radius,
+                                                 uIntVector &offsets, uIntVector &indices,
+                                                 const uIntType &threadCount = 1 );
+
+            void getKNearestNeighbors( const floatVector &origin, const uIntType &k,
+                                       uIntVector &indices, floatVector &distances );
+
+            void removePointsWithinRadiusOfOrigin( const floatVector &origin, const floatType &radius,
+                                                   uIntVector &indices );
+
+            const uIntType* getLiveCount( );
+
             void printData( const uIntType &dim );
 
         private:
-            const floatVector *_points;
-            uIntType _index;
-            uIntType _depth;
-            uIntType _axis;
 
-            std::unique_ptr< KDNode > left_child = NULL;
-            std::unique_ptr< KDNode > right_child = NULL;
+            struct treeNode{
+                /*!
+                 * A node of the tree. The node owns the points in [ begin, end ) of the permutation.
+                 * Internal nodes send [ begin, middle ) to the left child and [ middle, end ) to
+                 * the right child.
+                 */
+
+                uIntType begin;
+                uIntType end;
+                uIntType middle;
+                uIntType axis;
+                floatType split; //!The value on the axis of the point at the middle of the range
+                intType left = -1;
+                intType right = -1;
+                uIntType liveCount;
+            };
+
+            const floatVector *_points = NULL;
+            uIntType _dim = 0;
+            uIntType _depth = 0;
+            uIntType _bucketSize = 8;
+            uIntType _index = 0;
+            uIntType _liveCount = 0; //!The number of points in the tree which have not been removed
+
+            uIntVector _permutation; //!The indices of the points ordered by the tree
+            std::vector< bool > _deleted; //!Flags indicating the point at the permutation location has been removed
+            std::vector< treeNode > _nodes;
+
+            floatVector _lowerBounds;
+            floatVector _upperBounds;
+
+            uIntType buildNode( const uIntType &begin, const uIntType &end );
+
+            floatType squaredDistance( const floatType *origin, const uIntType &index );
+
+            void getPointsInRange( const uIntType &node, const floatVector &upperBounds,
+                                   const floatVector &lowerBounds, uIntVector &indices );
+
+            void getPointsWithinRadiusOfOrigin( const floatType *origin, const floatType &radiusSquared,
+                                                uIntVector &indices, uIntVector &stack );
+
+            typedef std::pair< floatType, uIntType > neighbor; //!The squared distance and index of a neighbor
+
+            void searchKNearestNeighbors( const uIntType &node, const floatVector &origin, const uIntType &k,
+                                          std::priority_queue< neighbor > &neighbors );
+
+            uIntType removePointsWithinRadiusOfOrigin( const uIntType &node, const floatVector &origin,
+                                                       const floatType &radiusSquared, uIntVector &indices );
+
+            void printData( const uIntType &node, const uIntType &depth );
 
     };
 
@@ -266,6 +326,8 @@ namespace volumeReconstruction{
             errorOut interpolateFunctionToBackgroundGrid( const floatVector &functionValuesAtPoints, const uIntType &functionDim,
                                                           std::unordered_map< uIntType, floatVector > &functionAtGrid );
 
+            errorOut formGridInterpolationOperator( );
+
             errorOut performSurfaceIntegralMethods( const floatVector &valuesAtPoints, const uIntType valueSize,
                                                     const floatVector &origin, floatVector &integratedValue,
                                                     bool computeFlux, bool positionWeightedIntegral, bool dyadWithOrigin, const uIntVector *subdomainIDs = NULL,
@@ -276,6 +338,13 @@ namespace volumeReconstruction{
 
             errorOut grad_rbf( const floatVector &x, const floatVector &x0, const floatType &ls, floatVector &grad );
 
+            errorOut rbf( const floatVector &x, const uIntType *pointIndices, const uIntType &nPoints,
+                          const floatType &ls, floatVector &differences, floatVector &values );
+
+            errorOut grad_rbf( const floatVector &x, const uIntType *pointIndices, const uIntType &nPoints,
+                               const floatType &ls, floatVector &differences, floatVector &values,
+                               floatVector &gradients );
+
         private:
 
             uIntVector _domainDiscretization;
@@ -284,6 +353,8 @@ namespace volumeReconstruction{
 
             floatType _absoluteTolerance = 1e-9;
 
+            uIntType _queryThreadCount = 1;
+
             uIntType _minPointsPerCell = 2;
             uIntType _minNormalApproximationCount = 5;
             bool _useMaterialPointsForNormals = false;
@@ -293,6 +364,11 @@ namespace volumeReconstruction{
 
             errorOut processConfigurationFile( );
 
+            bool isOutsideBoundingPlanes( const floatVector &x, floatVector *outwardNormalSum = NULL );
+
+            void computeRBFDifferences( const floatVector &x, const uIntType *pointIndices, const uIntType &nPoints,
+                                        const floatType &ls, floatVector &differences, floatVector &values );
+
             errorOut processBackgroundGridElementImplicitFunction( const uIntVector &indices,
                                                                    floatVector &implicitFunctionNodalValues,
                                                                    uIntVector &globalNodeIds,
@@ -302,6 +378,9 @@ namespace volumeReconstruction{
 
             errorOut projectImplicitFunctionToBackgroundGrid( );
 
+            errorOut projectImplicitFunctionToBackgroundGridPlanes( const uIntType &iBegin, const uIntType &iEnd,
+                                                                    const uIntType &queryThreadCount );
+
             errorOut initializeInternalAndBoundaryCells( );
 
             errorOut findInternalAndBoundaryCells( );
@@ -314,6 +393,15 @@ namespace volumeReconstruction{
             floatType _isosurfaceCutoff = 0.5;
             floatVector _implicitFunctionValues;
 
+            //The sparse operator which interpolates functions at the points to the background grid nodes
+            //stored in compressed row format. The weights only depend on the geometry so they are
+            //re-used for every function interpolated after the volume is evaluated.
+            bool _gridInterpolationOperatorFormed = false;
+            uIntVector _gridInterpolationNodeIDs;
+            uIntVector _gridInterpolationRowPointers;
+            uIntVector _gridInterpolationPointIndices;
+            floatVector _gridInterpolationWeights;
+
             uIntVector _internalCells;
             uIntVector _boundaryCells;
 